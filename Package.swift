@@ -113,6 +113,7 @@ let conduitMLXTestSources: [String] = [
     "ImageGeneration/DiffusionModelRegistryTests.swift",
     "ImageGeneration/DiffusionVariantTests.swift",
     "MLXModelCacheTests.swift",
+    "MLXModelResidencyTests.swift",
     "Providers/MLX/MLXConfigurationApplicationTests.swift",
     "Providers/MLX/MLXLocalModelSupportTests.swift",
     "Providers/MLX/MLXRuntimeFeaturesTests.swift",
@@ -226,6 +227,17 @@ let package = Package(
                 .enableExperimentalFeature("StrictConcurrency")
             ]
         ),
+        .executableTarget(
+            name: "ConduitBenchmark",
+            dependencies: [
+                "ConduitAdvanced"
+            ],
+            path: "Sources/ConduitBenchmark",
+            swiftSettings: [
+                .define("CONDUIT_TRAIT_MLX", .when(traits: ["MLX"])),
+                .enableExperimentalFeature("StrictConcurrency")
+            ]
+        ),
         .testTarget(
             name: "ConduitTests",
             dependencies: conduitTestDependencies,
@@ -76,6 +76,17 @@ import Observation
 /// )
 /// ```
 ///
+/// ### Background Warmup
+///
+/// ```swift
+/// // Returns immediately; the first message waits for whatever warmup remains
+/// let session = try await ChatSession(
+///     provider: provider,
+///     model: .llama3_2_1b,
+///     warmup: .progressive
+/// )
+/// ```
+///
 /// ## Properties
 ///
 /// - `warmupOnInit`: If `true`, performs warmup during session initialization.
@@ -83,12 +94,31 @@ import Observation
 ///   size of the attention cache that gets warmed up. Default: 50.
 /// - `warmupTokens`: Number of tokens to generate during warmup. Higher values
 ///   warm up longer generation sequences but take longer. Default: 5.
+/// - `mode`: Whether warmup blocks the caller or runs in the background. Default: `.blocking`.
 ///
 /// ## Static Presets
 ///
 /// - `.default`: No automatic warmup (`warmupOnInit: false`)
 /// - `.eager`: Automatic warmup with default parameters (`warmupOnInit: true`)
+/// - `.background`: Automatic warmup that does not block initialization
+/// - `.progressive`: A quick background pass, then the full pass
 public struct WarmupConfig: Sendable {
+
+    /// How warmup is scheduled relative to the caller.
+    public enum Mode: Sendable, Hashable {
+        /// Warmup finishes before the initializer or `prepare` call returns.
+        case blocking
+
+        /// Warmup runs in the background. The first request waits for it to
+        /// finish instead of competing with it.
+        case background
+
+        /// A single-token pass runs in the background, followed by the full
+        /// pass. The first request waits only for the quick pass, which loads
+        /// the weights, and cancels the full pass if it is still running.
+        case progressive
+    }
+
     /// Whether to perform warmup during session initialization.
     ///
     /// If `true`, the session initializer will call the provider's `warmUp()`
@@ -112,20 +142,37 @@ public struct WarmupConfig: Sendable {
     /// Default: 5 tokens
     public var warmupTokens: Int
 
+    /// Whether warmup blocks the caller or runs in the background.
+    ///
+    /// Background warmup errors are not reported; the first request surfaces
+    /// them instead.
+    ///
+    /// Default: `.blocking`
+    public var mode: Mode
+
     /// Creates a custom warmup configuration.
     ///
     /// - Parameters:
     ///   - warmupOnInit: Whether to warmup on session init. Default: `false`.
     ///   - prefillChars: Number of warmup prompt characters. Default: `50`.
     ///   - warmupTokens: Number of tokens to generate. Default: `5`.
+    ///   - mode: How warmup is scheduled. Default: `.blocking`.
     public init(
         warmupOnInit: Bool = false,
         prefillChars: Int = 50,
-        warmupTokens: Int = 5
+        warmupTokens: Int = 5,
+        mode: Mode = .blocking
     ) {
         self.warmupOnInit = warmupOnInit
         self.prefillChars = prefillChars
         self.warmupTokens = warmupTokens
+        self.mode = mode
+    }
+
+    /// The warmup prompt, `prefillChars` characters long.
+    var prefillText: String {
+        let text = String(repeating: "Hi! ", count: max(1, prefillChars / 4))
+        return String(text.prefix(prefillChars))
     }
 
     /// Default configuration with no automatic warmup.
@@ -139,6 +186,150 @@ public struct WarmupConfig: Sendable {
     /// Performs warmup during session initialization. First message will be
     /// fast (~100-300ms), but session creation takes longer (~1-2s).
     public static let eager = WarmupConfig(warmupOnInit: true)
+
+    /// Background warmup configuration.
+    ///
+    /// Session creation returns immediately and warmup runs behind it. If the
+    /// first message arrives early, it waits for warmup to finish.
+    public static let background = WarmupConfig(warmupOnInit: true, mode: .background)
+
+    /// Progressive warmup configuration.
+    ///
+    /// Session creation returns immediately. A single-token pass loads the
+    /// model first, then the full pass compiles kernels for longer prompts.
+    /// The first message only waits for the single-token pass.
+    public static let progressive = WarmupConfig(warmupOnInit: true, mode: .progressive)
+}
+
+extension TextGenerator {
+    /// Runs the warmup passes `warmup` describes and waits for them.
+    ///
+    /// Progressive warmup runs a single-token pass before the full pass.
+    /// Callers that want background scheduling wrap this in a task.
+    func warmUp(model: ModelID, using warmup: WarmupConfig) async throws {
+        if warmup.mode == .progressive {
+            try await warmUp(model: model, prefillText: "Hi", maxTokens: 1)
+            try Task.checkCancellation()
+        }
+        try await warmUp(model: model, prefillText: warmup.prefillText, maxTokens: warmup.warmupTokens)
+    }
+}
+
+// MARK: - ContextWindowPolicy
+
+/// Limits how much conversation history ``ChatSession`` sends with each turn.
+///
+/// Without a policy, every turn sends the full history, so long sessions
+/// eventually overflow the model's context and each turn costs more prefill
+/// than the last. With a policy, the session sends the system prompt, an
+/// optional running summary, and the most recent turns that fit in
+/// ``maxTokens``. ``ChatSession/messages`` still holds the full history.
+///
+/// ## Token Counting
+///
+/// Each message is counted once and the count is cached in
+/// ``MessageMetadata/tokenCount``, so a turn only counts the messages added
+/// since the previous one. Counts come from ``tokenCounter`` when set, then
+/// from the provider when it conforms to ``TokenCounter``, and otherwise from
+/// a four-characters-per-token estimate. Assistant messages reuse the token
+/// count reported by generation.
+///
+/// ## Eviction
+///
+/// History is evicted oldest first, one turn at a time. A turn starts at a
+/// user message and includes the assistant and tool messages that follow,
+/// so tool calls are never separated from their results. The system prompt
+/// and the current turn are always sent, even if together they exceed the
+/// budget.
+///
+/// ## Usage
+/// ```swift
+/// // Keep the most recent history within 8K tokens
+/// session.contextWindow = .slidingWindow(maxTokens: 8_000)
+///
+/// // Fold evicted turns into a running summary instead of dropping them
+/// session.contextWindow = ContextWindowPolicy(maxTokens: 8_000, overflow: .summarize({ summary, evicted in
+///     let text = try await summarizer.summarize(previous: summary, adding: evicted)
+///     return .system("Summary of the earlier conversation: \(text)")
+/// }))
+/// ```
+public struct ContextWindowPolicy: Sendable {
+
+    /// Counts tokens in a batch of messages, returning one count per message.
+    public typealias TokenCounting = @Sendable (_ messages: [Message]) async throws -> [Int]
+
+    /// Folds evicted turns into a running summary.
+    ///
+    /// Called with the current summary, if any, and the messages just evicted.
+    /// Returns the message that replaces both in subsequent turns.
+    public typealias Summarizer = @Sendable (_ summary: Message?, _ evicted: [Message]) async throws -> Message
+
+    /// What happens to turns that no longer fit in the budget.
+    public enum Overflow: Sendable {
+
+        /// Evicted turns are no longer sent.
+        case slidingWindow
+
+        /// Evicted turns are folded into a running summary sent after the system prompt.
+        ///
+        /// If the summarizer throws, the evicted turns are dropped and the
+        /// previous summary is kept.
+        case summarize(Summarizer)
+    }
+
+    /// Maximum tokens of history sent with each turn.
+    public var maxTokens: Int
+
+    /// Tokens held back from ``maxTokens`` for the response.
+    ///
+    /// `nil` reserves ``GenerateConfig/maxTokens`` from the session's config.
+    public var reservedResponseTokens: Int?
+
+    /// Tokens added per message for chat formatting.
+    public var tokensPerMessage: Int
+
+    /// How evicted turns are handled.
+    public var overflow: Overflow
+
+    /// Custom token counter, or `nil` to use the provider or an estimate.
+    public var tokenCounter: TokenCounting?
+
+    /// Creates a context window policy.
+    ///
+    /// - Parameters:
+    ///   - maxTokens: History token budget per turn.
+    ///   - reservedResponseTokens: Tokens held back for the response. Default: the config's `maxTokens`.
+    ///   - tokensPerMessage: Formatting overhead per message. Default: 4
+    ///   - overflow: How evicted turns are handled. Default: `.slidingWindow`
+    ///   - tokenCounter: Custom token counter. Default: `nil`
+    public init(
+        maxTokens: Int,
+        reservedResponseTokens: Int? = nil,
+        tokensPerMessage: Int = 4,
+        overflow: Overflow = .slidingWindow,
+        tokenCounter: TokenCounting? = nil
+    ) {
+        self.maxTokens = max(0, maxTokens)
+        self.reservedResponseTokens = reservedResponseTokens
+        self.tokensPerMessage = max(0, tokensPerMessage)
+        self.overflow = overflow
+        self.tokenCounter = tokenCounter
+    }
+
+    /// A sliding window over the most recent turns that fit in `maxTokens`.
+    public static func slidingWindow(maxTokens: Int) -> ContextWindowPolicy {
+        ContextWindowPolicy(maxTokens: maxTokens)
+    }
+
+    /// Estimated content tokens in `message`, at about four characters per token.
+    public static func estimatedTokens(in message: Message) -> Int {
+        max(1, message.content.textValue.count / 4)
+    }
+
+    /// The history budget after reserving space for the response.
+    func historyBudget(for config: GenerateConfig) -> Int {
+        max(0, maxTokens - (reservedResponseTokens ?? config.maxTokens ?? 0))
+    }
 }
 
 // MARK: - ChatSession
@@ -147,13 +338,17 @@ public struct WarmupConfig: Sendable {
 ///
 /// `ChatSession` provides a high-level interface for managing conversational
 /// AI interactions. It handles message history, generation state, and provides
-/// thread-safe access to session data using `NSLock` for synchronization.
+/// thread-safe access to session data from any task.
 ///
 /// ## Thread Safety
 ///
-/// This class uses `NSLock` for thread-safe access to mutable state. The lock
-/// is never held across `await` points to prevent deadlocks. State is captured
-/// before async operations begin.
+/// Conversation state is an immutable snapshot that is replaced as a whole.
+/// The history inside it is persistent: a snapshot shares storage with the
+/// session, and appending a message copies at most a few dozen references,
+/// never the conversation. A lock guards only the swap of one snapshot for
+/// the next, so it is never held across `await` points and never for longer
+/// than an append. Each `send(_:)` and `stream(_:)` call works from the
+/// snapshot taken when it started.
 ///
 /// ## Usage
 ///
@@ -230,7 +425,8 @@ public struct WarmupConfig: Sendable {
 /// ```
 ///
 /// - Note: This class is marked as `@unchecked Sendable` because thread safety
-///   is enforced manually using `NSLock`. The lock is never held across await points.
+///   is enforced manually: state snapshots are swapped under an `NSLock` that
+///   is never held across await points.
 #if canImport(Observation)
 @Observable
 #endif
@@ -248,32 +444,43 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     ///
     /// Messages are stored in chronological order. Use factory methods
     /// like `send(_:)` to add messages rather than modifying directly.
-    public private(set) var messages: [Message] = []
+    ///
+    /// Each read builds an array from the current snapshot. Prefer
+    /// ``messageCount`` or ``systemPrompt`` when only those are needed.
+    public var messages: [Message] {
+        withLock { state.history }.elements
+    }
 
     /// Whether a generation is currently in progress.
     ///
     /// Use this to show loading indicators in your UI.
-    public private(set) var isGenerating: Bool = false
+    public var isGenerating: Bool {
+        withLock { state.isGenerating }
+    }
 
     /// Configuration for text generation.
     ///
     /// Can be modified between calls to `send(_:)` or `stream(_:)`.
     public var config: GenerateConfig
 
-    /// Optional tool executor used for tool-call continuation in `send(_:)`.
+    /// Optional tool executor used for tool-call continuation in `send(_:)` and `stream(_:)`.
     ///
     /// When set, `send(_:)` will execute `GenerationResult.toolCalls` and continue
     /// generation by appending tool output messages until the model returns no tool calls.
-    /// If `nil`, tool-call responses are treated as invalid input errors.
+    /// If `nil`, tool-call responses are treated as invalid input errors by `send(_:)`
+    /// and left unexecuted by `stream(_:)`.
+    ///
+    /// `stream(_:)` starts each tool as soon as the model finishes streaming
+    /// its arguments, so tools run while the rest of the response arrives.
     public var toolExecutor: ToolExecutor?
 
-    /// Retry policy for tool execution in `send(_:)`.
+    /// Retry policy for tool execution in `send(_:)` and `stream(_:)`.
     ///
     /// This policy is applied to each tool call in the tool loop. The default
     /// is `.none`, preserving single-attempt behavior.
     public var toolCallRetryPolicy: ToolExecutor.RetryPolicy = .none
 
-    /// Maximum number of tool-call rounds allowed in a single `send(_:)` request.
+    /// Maximum number of tool-call rounds allowed in a single `send(_:)` or `stream(_:)` request.
     ///
     /// A "round" is one model response containing at least one tool call followed by
     /// executing those calls. This bounds continuation loops and prevents runaway cycles.
@@ -281,21 +488,82 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     /// Values less than zero are treated as zero during execution.
     public var maxToolCallRounds: Int = 8
 
+    /// Limits the history sent with each turn.
+    ///
+    /// `nil` (the default) sends the full history every turn. Set a
+    /// ``ContextWindowPolicy`` to cap the history at a token budget, keeping
+    /// the system prompt and the most recent turns. The window only moves
+    /// forward: raising the budget later does not bring back evicted turns
+    /// until the history is cleared or replaced.
+    public var contextWindow: ContextWindowPolicy?
+
     /// The most recent error that occurred during generation.
     ///
     /// Reset to `nil` at the start of each new generation attempt.
-    public private(set) var lastError: Error?
+    public var lastError: Error? {
+        withLock { state.lastError }
+    }
 
     /// The current generation task for cancellation support.
     private var generationTask: Task<Void, Never>?
 
-    /// Cancellation flag used by non-streaming send loops.
+    /// Background warmup the next request waits for, if any.
+    private var pendingWarmup: Task<Void, Never>?
+
+    /// The full pass of a progressive warmup, cancelled by the next request.
+    private var pendingWarmupRefinement: Task<Void, Never>?
+
+    /// Incrementally maintained window over `messages`, used when `contextWindow` is set.
+    private struct ContextWindowState {
+        /// Index of the oldest non-system message still sent.
+        var start = 0
+
+        /// Messages before this index are included in `tokens`.
+        var accountedThrough = 0
+
+        /// ID of the message at `accountedThrough - 1`, to detect edits to the history.
+        var lastAccountedID: UUID?
+
+        /// Tokens in `messages[start..<accountedThrough]`, including per-message overhead.
+        var tokens = 0
+
+        /// Running summary of evicted turns.
+        var summary: Message?
+    }
+
+    /// Conversation state, replaced as a whole under `lock`.
     ///
-    /// `cancel()` can be invoked from a different task than `send(_:)`, so
-    /// `send(_:)` polls this flag between awaits to stop promptly.
-    private var cancellationRequested: Bool = false
+    /// Every field is a value and the history is a persistent
+    /// ``MessageHistory``, so a snapshot costs a few references and an
+    /// update never copies the conversation while the lock is held.
+    private struct State {
+        /// The conversation history.
+        var history = MessageHistory()
+
+        /// Whether a generation is in progress.
+        var isGenerating = false
+
+        /// The most recent generation error.
+        var lastError: Error?
+
+        /// Set by `cancel()`, which can run on a different task than the
+        /// request it stops; tool loops poll it between awaits.
+        var cancellationRequested = false
 
-    /// Lock for thread-safe access to mutable state.
+        /// The window over `history` used when `contextWindow` is set.
+        var contextWindow = ContextWindowState()
+
+        /// Removes the message with `id`, searching from the end.
+        mutating func removeMessage(id: UUID) {
+            if let index = history.lastIndex(where: { $0.id == id }) {
+                history.remove(at: index)
+            }
+        }
+    }
+
+    private var state = State()
+
+    /// Lock guarding `state` and the task handles.
     private let lock = NSLock()
 
     // MARK: - Initialization
@@ -379,7 +647,12 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     ///   - config: Configuration for generation. Defaults to `.default`.
     ///   - warmup: Warmup configuration. Defaults to `.default` (no warmup).
     ///
-    /// - Throws: `AIError` if warmup fails (only when `warmup.warmupOnInit` is `true`).
+    /// With `.background` or `.progressive` warmup, the initializer returns
+    /// immediately and the first `send(_:)` or `stream(_:)` waits for the
+    /// remaining warmup before generating.
+    ///
+    /// - Throws: `AIError` if warmup fails (only when `warmup.warmupOnInit` is `true`
+    ///   and `warmup.mode` is `.blocking`).
     public init(
         provider: Provider,
         model: Provider.ModelID,
@@ -391,19 +664,39 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
         self.config = config
 
         // Perform warmup if requested
-        if warmup.warmupOnInit {
-            // Generate warmup text from prefillChars count
-            let warmupText = String(repeating: "Hi! ", count: max(1, warmup.prefillChars / 4))
+        guard warmup.warmupOnInit else { return }
+        switch warmup.mode {
+        case .blocking:
             try await provider.warmUp(
                 model: model,
-                prefillText: String(warmupText.prefix(warmup.prefillChars)),
+                prefillText: warmup.prefillText,
                 maxTokens: warmup.warmupTokens
             )
+        case .background:
+            pendingWarmup = Task {
+                try? await provider.warmUp(model: model, using: warmup)
+            }
+        case .progressive:
+            let quickPass = Task {
+                try? await provider.warmUp(model: model, prefillText: "Hi", maxTokens: 1)
+            }
+            pendingWarmup = quickPass
+            pendingWarmupRefinement = Task {
+                await quickPass.value
+                guard !Task.isCancelled else { return }
+                try? await provider.warmUp(
+                    model: model,
+                    prefillText: warmup.prefillText,
+                    maxTokens: warmup.warmupTokens
+                )
+            }
         }
     }
 
     deinit {
         generationTask?.cancel()
+        pendingWarmup?.cancel()
+        pendingWarmupRefinement?.cancel()
     }
 
     // MARK: - Thread-Safe State Access
@@ -421,9 +714,25 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
         return try body()
     }
 
+    /// Waits for background warmup started by the initializer.
+    ///
+    /// The full pass of a progressive warmup is cancelled rather than awaited,
+    /// so the request does not compete with it for the model.
+    private func finishPendingWarmup() async {
+        let (warmup, refinement) = withLock {
+            defer {
+                pendingWarmup = nil
+                pendingWarmupRefinement = nil
+            }
+            return (pendingWarmup, pendingWarmupRefinement)
+        }
+        refinement?.cancel()
+        await warmup?.value
+    }
+
     /// Throws `AIError.cancelled` when cancellation has been requested.
     private func throwIfCancelled() throws {
-        if withLock({ cancellationRequested }) {
+        if withLock({ state.cancellationRequested }) {
             throw AIError.cancelled
         }
     }
@@ -450,10 +759,14 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
         withLock {
             let systemMessage = Message.system(prompt)
 
-            if !messages.isEmpty, messages[0].role == .system {
-                messages[0] = systemMessage
+            if state.history.first?.role == .system {
+                state.history.replace(at: 0, with: systemMessage)
             } else {
-                messages.insert(systemMessage, at: 0)
+                state.history.insert(systemMessage, at: 0)
+                if state.contextWindow.lastAccountedID != nil {
+                    state.contextWindow.start += 1
+                    state.contextWindow.accountedThrough += 1
+                }
             }
         }
     }
@@ -495,37 +808,24 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
         // Create user message and prepare state
         let userMessage = Message.user(content)
 
-        // Capture state and add user message under lock
-        let capturedState: (
-            messages: [Message],
-            config: GenerateConfig,
-            toolExecutor: ToolExecutor?,
-            toolCallRetryPolicy: ToolExecutor.RetryPolicy,
-            maxToolCallRounds: Int
-        ) = withLock {
-            lastError = nil
-            isGenerating = true
-            cancellationRequested = false
-            messages.append(userMessage)
-            return (
-                messages,
-                config,
-                toolExecutor,
-                toolCallRetryPolicy,
-                max(0, maxToolCallRounds)
-            )
-        }
+        // Add the user message and take a snapshot under lock
+        let capturedState = beginTurn(with: userMessage)
 
         // Capture model outside lock (immutable after initialization)
         let currentModel = model
-        let currentMessages = capturedState.messages
         let currentConfig = capturedState.config
         let currentToolExecutor = capturedState.toolExecutor
         let currentToolCallRetryPolicy = capturedState.toolCallRetryPolicy
         let currentMaxToolCallRounds = capturedState.maxToolCallRounds
 
         do {
-            var loopMessages = currentMessages
+            await finishPendingWarmup()
+            var loopMessages: [Message]
+            if let policy = capturedState.contextWindow {
+                loopMessages = await contextMessages(for: policy, config: currentConfig)
+            } else {
+                loopMessages = capturedState.history.elements
+            }
             var turnMessages: [Message] = []
             var toolRoundCount = 0
             var finalResponseText = ""
@@ -593,31 +893,64 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
                 toolRoundCount += 1
             }
 
-            // Update state under lock
-            withLock {
-                messages.append(contentsOf: turnMessages)
-                isGenerating = false
-                cancellationRequested = false
-            }
-
+            endTurn(appending: turnMessages)
             return finalResponseText
 
         } catch {
-            // On error, remove user message and store error
-            withLock {
-                // Remove the user message we just added
-                if let index = messages.lastIndex(where: { $0.id == userMessage.id }) {
-                    messages.remove(at: index)
-                }
-                lastError = error
-                isGenerating = false
-                cancellationRequested = false
-            }
-
+            // On error, remove the user message and store the error
+            endTurn(rollingBack: userMessage, error: error)
             throw error
         }
     }
 
+    /// Captured settings and history for one `send(_:)` or `stream(_:)` call.
+    private struct TurnSnapshot {
+        let history: MessageHistory
+        let config: GenerateConfig
+        let toolExecutor: ToolExecutor?
+        let toolCallRetryPolicy: ToolExecutor.RetryPolicy
+        let maxToolCallRounds: Int
+        let contextWindow: ContextWindowPolicy?
+    }
+
+    /// Appends `userMessage`, marks the session as generating, and returns
+    /// a snapshot of the history and settings for the turn.
+    private func beginTurn(with userMessage: Message) -> TurnSnapshot {
+        withLock {
+            state.lastError = nil
+            state.isGenerating = true
+            state.cancellationRequested = false
+            state.history.append(userMessage)
+            return TurnSnapshot(
+                history: state.history,
+                config: config,
+                toolExecutor: toolExecutor,
+                toolCallRetryPolicy: toolCallRetryPolicy,
+                maxToolCallRounds: max(0, maxToolCallRounds),
+                contextWindow: contextWindow
+            )
+        }
+    }
+
+    /// Records a finished turn's messages.
+    private func endTurn(appending turnMessages: [Message]) {
+        withLock {
+            state.history.append(contentsOf: turnMessages)
+            state.isGenerating = false
+            state.cancellationRequested = false
+        }
+    }
+
+    /// Removes a failed turn's user message and records `error`.
+    private func endTurn(rollingBack userMessage: Message, error: Error) {
+        withLock {
+            state.removeMessage(id: userMessage.id)
+            state.lastError = error
+            state.isGenerating = false
+            state.cancellationRequested = false
+        }
+    }
+
     // MARK: - Stream Message
 
     /// Sends a message and streams the response tokens.
@@ -657,18 +990,9 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     public func stream(_ content: String) -> AsyncThrowingStream<String, Error> {
         let userMessage = Message.user(content)
 
-        // Prepare state and capture messages under lock
-        let currentMessages: [Message] = withLock {
-            lastError = nil
-            isGenerating = true
-            cancellationRequested = false
-            messages.append(userMessage)
-            return messages
-        }
-
-        // Capture model and config for the async operation
+        // Add the user message and take a snapshot under lock
+        let capturedState = beginTurn(with: userMessage)
         let currentModel = model
-        let currentConfig = config
 
         return AsyncThrowingStream { continuation in
             let task = Task { [weak self] in
@@ -677,27 +1001,63 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
                     return
                 }
 
-                var fullText = ""
+                var turnMessages: [Message] = []
                 var streamError: Error?
 
                 do {
-                    // Get the stream from provider using streamWithMetadata
-                    // which accepts messages array
-                    let providerStream = self.provider.streamWithMetadata(
-                        messages: currentMessages,
-                        model: currentModel,
-                        config: currentConfig
-                    )
+                    await self.finishPendingWarmup()
+                    var requestMessages: [Message]
+                    if let policy = capturedState.contextWindow {
+                        requestMessages = await self.contextMessages(for: policy, config: capturedState.config)
+                    } else {
+                        requestMessages = capturedState.history.elements
+                    }
+                    var toolRoundCount = 0
 
-                    // Iterate and yield tokens
-                    for try await chunk in providerStream {
-                        // Check for cancellation
+                    while true {
                         try Task.checkCancellation()
+                        try self.throwIfCancelled()
+
+                        // Tools only start while rounds remain
+                        let canRunTools = toolRoundCount < capturedState.maxToolCallRounds
+                        let round = try await self.streamRound(
+                            messages: requestMessages,
+                            config: capturedState.config,
+                            toolExecutor: canRunTools ? capturedState.toolExecutor : nil,
+                            retryPolicy: capturedState.toolCallRetryPolicy
+                        ) { text in
+                            continuation.yield(text)
+                        }
+
+                        // Calls are only recorded when their outputs follow; providers reject
+                        // an assistant tool call with no matching tool result in later requests.
+                        let runsTools = !round.toolCalls.isEmpty && capturedState.toolExecutor != nil
+                        let assistantMessage = Message(
+                            role: .assistant,
+                            content: .text(round.text),
+                            metadata: MessageMetadata(
+                                model: currentModel.rawValue,
+                                toolCalls: runsTools ? round.toolCalls : nil
+                            )
+                        )
+                        turnMessages.append(assistantMessage)
+                        requestMessages.append(assistantMessage)
+
+                        // Without an executor, the streamed text is kept and the calls are dropped
+                        guard runsTools else { break }
+                        guard canRunTools else {
+                            throw AIError.invalidInput(
+                                "Tool-call loop exceeded maxToolCallRounds (\(capturedState.maxToolCallRounds))."
+                            )
+                        }
 
-                        // Yield the token (text is non-optional in GenerationChunk)
-                        let tokenText = chunk.text
-                        continuation.yield(tokenText)
-                        fullText += tokenText
+                        try self.throwIfCancelled()
+                        for output in round.toolOutputs {
+                            let toolMessage = Message.toolOutput(output)
+                            turnMessages.append(toolMessage)
+                            requestMessages.append(toolMessage)
+                        }
+                        toolRoundCount += 1
                     }
 
                 } catch is CancellationError {
@@ -708,29 +1068,11 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
                 }
 
                 // Finalize state under lock
-                self.withLock {
-                    if let error = streamError {
-                        // Remove user message on error
-                        if let index = self.messages.lastIndex(where: { $0.id == userMessage.id }) {
-                            self.messages.remove(at: index)
-                        }
-                        self.lastError = error
-                    } else {
-                        // Add assistant message on success
-                        let assistantMessage = Message(
-                            role: .assistant,
-                            content: .text(fullText),
-                            metadata: MessageMetadata(model: currentModel.rawValue)
-                        )
-                        self.messages.append(assistantMessage)
-                    }
-                    self.isGenerating = false
-                }
-
-                // Finish the stream
                 if let error = streamError {
+                    self.endTurn(rollingBack: userMessage, error: error)
                     continuation.finish(throwing: error)
                 } else {
+                    self.endTurn(appending: turnMessages)
                     continuation.finish()
                 }
             }
@@ -753,6 +1095,100 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
         }
     }
 
+    /// One streamed model response and the tools it called.
+    private struct StreamedRound {
+        /// The response text.
+        var text = ""
+
+        /// The tool calls the model made, in response order.
+        var toolCalls: [Transcript.ToolCall] = []
+
+        /// One output per tool call, in the same order, when tools ran.
+        var toolOutputs: [Transcript.ToolOutput] = []
+    }
+
+    /// Streams one model response, running its tool calls as they arrive.
+    ///
+    /// A tool starts as soon as its call is complete: when a
+    /// ``PartialToolCall`` reports ``PartialToolCall/isArgumentsComplete``,
+    /// or when the call appears in ``GenerationChunk/completedToolCalls``,
+    /// whichever comes first. Tools therefore run while the model is still
+    /// streaming text or later calls, and the round waits only for whatever
+    /// is still running when the response ends.
+    ///
+    /// The response's final ``GenerationChunk/completedToolCalls`` decide
+    /// which calls are kept; a call started from a partial update that the
+    /// provider later discards is ignored.
+    ///
+    /// - Parameters:
+    ///   - messages: The request history.
+    ///   - config: Generation settings.
+    ///   - toolExecutor: Runs the tools, or `nil` to only collect the calls.
+    ///   - retryPolicy: Retry behavior for each tool call.
+    ///   - yield: Receives each chunk's text as it arrives.
+    private func streamRound(
+        messages: [Message],
+        config: GenerateConfig,
+        toolExecutor: ToolExecutor?,
+        retryPolicy: ToolExecutor.RetryPolicy,
+        yield: (String) -> Void
+    ) async throws -> StreamedRound {
+        let providerStream = provider.streamWithMetadata(messages: messages, model: model, config: config)
+
+        return try await withThrowingTaskGroup(of: (String, Transcript.ToolOutput).self) { group in
+            var round = StreamedRound()
+            var startedCalls: [Transcript.ToolCall] = []
+            var startedIDs: Set<String> = []
+            var completedCalls: [Transcript.ToolCall]?
+
+            for try await chunk in providerStream {
+                try Task.checkCancellation()
+                yield(chunk.text)
+                round.text += chunk.text
+
+                var finishedCalls = chunk.completedToolCalls ?? []
+                if let completed = chunk.completedToolCalls {
+                    completedCalls = (completedCalls ?? []) + completed
+                }
+                if let partial = chunk.partialToolCall, partial.isArgumentsComplete,
+                   let arguments = partial.partialArguments {
+                    finishedCalls.append(
+                        Transcript.ToolCall(id: partial.id, toolName: partial.toolName, arguments: arguments)
+                    )
+                }
+
+                guard let toolExecutor else { continue }
+                for call in finishedCalls where startedIDs.insert(call.id).inserted {
+                    startedCalls.append(call)
+                    group.addTask {
+                        (call.id, try await toolExecutor.execute(toolCall: call, retryPolicy: retryPolicy))
+                    }
+                }
+            }
+
+            // Providers may repeat completed calls across chunks; keep the first of each
+            var seenIDs: Set<String> = []
+            round.toolCalls = (completedCalls ?? startedCalls).filter { seenIDs.insert($0.id).inserted }
+            guard let toolExecutor, !round.toolCalls.isEmpty else {
+                group.cancelAll()
+                return round
+            }
+
+            for call in round.toolCalls where startedIDs.insert(call.id).inserted {
+                group.addTask {
+                    (call.id, try await toolExecutor.execute(toolCall: call, retryPolicy: retryPolicy))
+                }
+            }
+
+            var outputs: [String: Transcript.ToolOutput] = [:]
+            for try await (id, output) in group {
+                outputs[id] = output
+            }
+            round.toolOutputs = round.toolCalls.compactMap { outputs[$0.id] }
+            return round
+        }
+    }
+
     // MARK: - History Management
 
     /// Clears all messages except the system prompt.
@@ -768,11 +1204,12 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     /// ```
     public func clearHistory() {
         withLock {
-            if let systemMessage = messages.first, systemMessage.role == .system {
-                messages = [systemMessage]
+            if let systemMessage = state.history.first, systemMessage.role == .system {
+                state.history = MessageHistory([systemMessage])
             } else {
-                messages = []
+                state.history = MessageHistory()
             }
+            state.contextWindow = ContextWindowState()
         }
     }
 
@@ -794,16 +1231,16 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     /// ```
     public func undoLastExchange() {
         withLock {
-            guard !messages.isEmpty else { return }
+            guard !state.history.isEmpty else { return }
 
             // Remove assistant message if it's the last one
-            if messages.last?.role == .assistant {
-                messages.removeLast()
+            if state.history.last?.role == .assistant {
+                state.history.removeLast()
             }
 
             // Remove user message if it's now the last one
-            if messages.last?.role == .user {
-                messages.removeLast()
+            if state.history.last?.role == .user {
+                state.history.removeLast()
             }
         }
     }
@@ -828,8 +1265,8 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     public func injectHistory(_ history: [Message]) {
         withLock {
             // Check for existing system prompt
-            let existingSystemPrompt: Message? = messages.first?.role == .system
-                ? messages.first
+            let existingSystemPrompt: Message? = state.history.first?.role == .system
+                ? state.history.first
                 : nil
 
             // Filter out system messages from injected history
@@ -841,17 +1278,204 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
             // Build new message list
             if let existingPrompt = existingSystemPrompt {
                 // Keep existing system prompt
-                messages = [existingPrompt] + nonSystemMessages
+                state.history = MessageHistory([existingPrompt] + nonSystemMessages)
             } else if let injectedPrompt = injectedSystemPrompt {
                 // Use injected system prompt
-                messages = [injectedPrompt] + nonSystemMessages
+                state.history = MessageHistory([injectedPrompt] + nonSystemMessages)
             } else {
                 // No system prompt
-                messages = nonSystemMessages
+                state.history = MessageHistory(nonSystemMessages)
             }
+            state.contextWindow = ContextWindowState()
         }
     }
 
+    // MARK: - Context Window
+
+    /// The running summary of turns evicted by a summarizing ``contextWindow``.
+    ///
+    /// Persist it alongside ``messages`` to restore a long session; it is
+    /// cleared by ``clearHistory()`` and ``injectHistory(_:)``.
+    public var contextSummary: Message? {
+        withLock { state.contextWindow.summary }
+    }
+
+    /// Returns the messages to send for the current turn under `policy`.
+    ///
+    /// Counts only messages without a cached ``MessageMetadata/tokenCount``,
+    /// then moves the window past the oldest turns until the rest fit.
+    /// Called after the turn's user message has been appended.
+    private func contextMessages(for policy: ContextWindowPolicy, config: GenerateConfig) async -> [Message] {
+        // Count the messages added since the previous turn
+        let uncounted: [(index: Int, message: Message)] = withLock {
+            reconcileContextWindow()
+            let history = state.history
+            var pending: [(index: Int, message: Message)] = []
+            if let first = history.first, first.role == .system, Self.needsTokenCount(first) {
+                pending.append((0, first))
+            }
+            for index in state.contextWindow.accountedThrough..<history.count
+            where Self.needsTokenCount(history[index]) {
+                pending.append((index, history[index]))
+            }
+            return pending
+        }
+
+        if !uncounted.isEmpty {
+            let counts = await countTokens(in: uncounted.map(\.message), policy: policy)
+            withLock {
+                for (entry, count) in zip(uncounted, counts)
+                where entry.index < state.history.count && state.history[entry.index].id == entry.message.id {
+                    state.history.replace(at: entry.index, with: state.history[entry.index].withTokenCount(count))
+                }
+            }
+        }
+
+        let budget = policy.historyBudget(for: config)
+        while true {
+            let window = withLock { advanceContextWindow(budget: budget, policy: policy) }
+            guard !window.evicted.isEmpty, case .summarize(let summarize) = policy.overflow else {
+                return window.messages
+            }
+
+            // Fold the evicted turns into the summary, then re-check the budget with its new size
+            guard var summary = try? await summarize(window.summary, window.evicted) else {
+                return window.messages
+            }
+            if Self.needsTokenCount(summary) {
+                let count = await countTokens(in: [summary], policy: policy).first
+                summary = summary.withTokenCount(count ?? ContextWindowPolicy.estimatedTokens(in: summary))
+            }
+            withLock { state.contextWindow.summary = summary }
+        }
+    }
+
+    /// The messages sent for a turn: the system prompt, the running summary,
+    /// and the history from the window's first message on.
+    private struct ContextWindowSnapshot {
+        let history: MessageHistory
+        let start: Int
+        let summary: Message?
+        let evicted: [Message]
+
+        /// Builds the request array; done outside the lock.
+        var messages: [Message] {
+            var window: [Message] = []
+            window.reserveCapacity(history.count - start + 2)
+            if let systemMessage = history.first, systemMessage.role == .system {
+                window.append(systemMessage)
+            }
+            if let summary { window.append(summary) }
+            window.append(contentsOf: history[start...])
+            return window
+        }
+    }
+
+    /// Resets the window's running totals if the history was edited since the last turn.
+    ///
+    /// Must be called with the lock held.
+    private func reconcileContextWindow() {
+        let messages = state.history
+        var window = state.contextWindow
+        let accountedIsCurrent = window.accountedThrough == 0
+            || (window.accountedThrough <= messages.count
+                && messages[window.accountedThrough - 1].id == window.lastAccountedID)
+        if !accountedIsCurrent {
+            // Messages were removed or replaced (undo, rollback); re-sum from cached counts
+            window.start = min(window.start, messages.count)
+            window.accountedThrough = window.start
+            window.tokens = 0
+        }
+
+        let firstHistoryIndex = messages.first?.role == .system ? 1 : 0
+        if window.start < firstHistoryIndex {
+            window.start = firstHistoryIndex
+            window.accountedThrough = max(window.accountedThrough, firstHistoryIndex)
+        }
+        state.contextWindow = window
+    }
+
+    /// Adds newly appended messages to the window and evicts whole turns until it fits `budget`.
+    ///
+    /// The current turn, from the last user message on, is never evicted.
+    /// Must be called with the lock held.
+    private func advanceContextWindow(budget: Int, policy: ContextWindowPolicy) -> ContextWindowSnapshot {
+        func cost(_ message: Message) -> Int {
+            let tokens = message.metadata?.tokenCount ?? ContextWindowPolicy.estimatedTokens(in: message)
+            return tokens + policy.tokensPerMessage
+        }
+
+        let messages = self.state.history
+        var state = self.state.contextWindow
+        for index in state.accountedThrough..<messages.count {
+            state.tokens += cost(messages[index])
+        }
+        state.accountedThrough = messages.count
+        state.lastAccountedID = messages.last?.id
+
+        let systemMessage = messages.first?.role == .system ? messages.first : nil
+        let pinnedTokens = (systemMessage.map(cost) ?? 0) + (state.summary.map(cost) ?? 0)
+        let currentTurnStart = messages.lastIndex { $0.role == .user } ?? messages.count
+        let evictionStart = state.start
+
+        while pinnedTokens + state.tokens > budget, state.start < currentTurnStart {
+            let nextTurn = messages[(state.start + 1)..<currentTurnStart].firstIndex { $0.role == .user }
+                ?? currentTurnStart
+            for message in messages[state.start..<nextTurn] {
+                state.tokens -= cost(message)
+            }
+            state.start = nextTurn
+        }
+        state.tokens = max(0, state.tokens)
+        self.state.contextWindow = state
+
+        return ContextWindowSnapshot(
+            history: messages,
+            start: state.start,
+            summary: state.summary,
+            evicted: Array(messages[evictionStart..<state.start])
+        )
+    }
+
+    /// Whether `message` still needs a token count.
+    ///
+    /// A zero count on non-empty content comes from providers that don't
+    /// report usage and is treated as missing.
+    private static func needsTokenCount(_ message: Message) -> Bool {
+        guard let count = message.metadata?.tokenCount else { return true }
+        return count == 0 && !message.content.textValue.isEmpty
+    }
+
+    /// Counts content tokens in each message with the policy's counter, the provider, or an estimate.
+    private func countTokens(in messages: [Message], policy: ContextWindowPolicy) async -> [Int] {
+        if let tokenCounter = policy.tokenCounter,
+           let counts = try? await tokenCounter(messages),
+           counts.count == messages.count {
+            return counts
+        }
+        if let counter = provider as? any TokenCounter {
+            return await Self.countTokens(in: messages, with: counter, model: model)
+        }
+        return messages.map(ContextWindowPolicy.estimatedTokens(in:))
+    }
+
+    private static func countTokens<Counter: TokenCounter>(
+        in messages: [Message],
+        with counter: Counter,
+        model: Provider.ModelID
+    ) async -> [Int] {
+        guard let model = model as? Counter.ModelID else {
+            return messages.map(ContextWindowPolicy.estimatedTokens(in:))
+        }
+        var counts: [Int] = []
+        counts.reserveCapacity(messages.count)
+        for message in messages {
+            let count = try? await counter.countTokens(in: message.content.textValue, for: model)
+            counts.append(count?.count ?? ContextWindowPolicy.estimatedTokens(in: message))
+        }
+        return counts
+    }
+
     // MARK: - Cancellation
 
     /// Cancels any in-progress generation.
@@ -881,7 +1505,7 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
         let task: Task<Void, Never>? = withLock {
             let currentTask = generationTask
             generationTask = nil
-            cancellationRequested = true
+            state.cancellationRequested = true
             return currentTask
         }
 
@@ -893,9 +1517,9 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
 
         // Update state
         withLock {
-            if isGenerating {
-                isGenerating = false
-                lastError = AIError.cancelled
+            if state.isGenerating {
+                state.isGenerating = false
+                state.lastError = AIError.cancelled
             }
         }
     }
@@ -906,32 +1530,43 @@ public final class ChatSession<Provider: AIProvider & TextGenerator>: @unchecked
     ///
     /// Includes system, user, and assistant messages.
     public var messageCount: Int {
-        withLock { messages.count }
+        withLock { state.history.count }
     }
 
     /// The number of user messages in the conversation.
     ///
     /// Useful for tracking the number of conversation turns.
     public var userMessageCount: Int {
-        withLock {
-            messages.filter { $0.role == .user }.count
-        }
+        // Count outside the lock; the snapshot does not change
+        withLock { state.history }.reduce(0) { $0 + ($1.role == .user ? 1 : 0) }
     }
 
     /// Whether the session has an active system prompt.
     public var hasSystemPrompt: Bool {
         withLock {
-            messages.first?.role == .system
+            state.history.first?.role == .system
         }
     }
 
     /// The current system prompt, if any.
     public var systemPrompt: String? {
         withLock {
-            guard let first = messages.first, first.role == .system else {
+            guard let first = state.history.first, first.role == .system else {
                 return nil
             }
             return first.content.textValue
         }
     }
 }
+
+// MARK: - Message Token Count
+
+private extension Message {
+
+    /// A copy of this message with `tokenCount` set in its metadata.
+    func withTokenCount(_ count: Int) -> Message {
+        var metadata = self.metadata ?? MessageMetadata()
+        metadata.tokenCount = count
+        return Message(id: id, role: role, content: content, timestamp: timestamp, metadata: metadata)
+    }
+}
@@ -161,19 +161,25 @@ public struct Provider: Sendable {
         public var headers: [String: String]
         public var organizationID: String?
         public var api: APIStyle
+        public var transport: ConduitTransport?
+        public var rateLimiter: RateLimitScheduler?
 
         public init(
             timeout: TimeInterval = 60,
             maxRetries: Int = 3,
             headers: [String: String] = [:],
             organizationID: String? = nil,
-            api: APIStyle = .chat
+            api: APIStyle = .chat,
+            transport: ConduitTransport? = nil,
+            rateLimiter: RateLimitScheduler? = nil
         ) {
             self.timeout = timeout
             self.maxRetries = maxRetries
             self.headers = headers
             self.organizationID = organizationID
             self.api = api
+            self.transport = transport
+            self.rateLimiter = rateLimiter
         }
     }
     #endif
@@ -189,6 +195,8 @@ public struct Provider: Sendable {
         public var supportsVision: Bool
         public var supportsExtendedThinking: Bool
         public var thinkingBudgetTokens: Int?
+        public var transport: ConduitTransport?
+        public var rateLimiter: RateLimitScheduler?
 
         public init(
             baseURL: URL = URL(string: "https://api.anthropic.com")!,
@@ -198,7 +206,9 @@ public struct Provider: Sendable {
             supportsStreaming: Bool = true,
             supportsVision: Bool = true,
             supportsExtendedThinking: Bool = true,
-            thinkingBudgetTokens: Int? = nil
+            thinkingBudgetTokens: Int? = nil,
+            transport: ConduitTransport? = nil,
+            rateLimiter: RateLimitScheduler? = nil
         ) {
             self.baseURL = baseURL
             self.apiVersion = apiVersion
@@ -208,6 +218,8 @@ public struct Provider: Sendable {
             self.supportsVision = supportsVision
             self.supportsExtendedThinking = supportsExtendedThinking
             self.thinkingBudgetTokens = thinkingBudgetTokens
+            self.transport = transport
+            self.rateLimiter = rateLimiter
         }
     }
     #endif
@@ -246,17 +258,20 @@ public struct Provider: Sendable {
         public var timeout: TimeInterval
         public var maxRetries: Int
         public var retryBaseDelay: TimeInterval
+        public var transport: ConduitTransport?
 
         public init(
             baseURL: URL = URL(string: "https://api-inference.huggingface.co")!,
             timeout: TimeInterval = 60,
             maxRetries: Int = 3,
-            retryBaseDelay: TimeInterval = 1.0
+            retryBaseDelay: TimeInterval = 1.0,
+            transport: ConduitTransport? = nil
         ) {
             self.baseURL = baseURL
             self.timeout = timeout
             self.maxRetries = maxRetries
             self.retryBaseDelay = retryBaseDelay
+            self.transport = transport
         }
     }
 
@@ -354,14 +369,21 @@ extension Provider {
         configuration.timeout = max(0, options.timeout)
         configuration.maxRetries = max(0, options.maxRetries)
         configuration.retryBaseDelay = max(0, options.retryBaseDelay)
+        configuration.transport = options.transport
         let provider = HuggingFaceProvider(configuration: configuration)
 
-        return .custom(provider) { model in
-            guard model.family == .huggingFace || model.family == .custom else {
-                throw AIError.invalidInput("HuggingFace provider requires .huggingFace(...) models")
+        return .custom(
+            provider,
+            mapModel: { model in
+                guard model.family == .huggingFace || model.family == .custom else {
+                    throw AIError.invalidInput("HuggingFace provider requires .huggingFace(...) models")
+                }
+                return .huggingFace(model.id)
+            },
+            prepare: { _ in
+                await provider.prewarmConnection()
             }
-            return .huggingFace(model.id)
-        }
+        )
     }
 
     // MARK: - Cloud (Fallback)
@@ -380,11 +402,15 @@ extension Provider {
         configuration.defaultHeaders = options.headers
         configuration.organizationID = options.organizationID
         configuration.apiVariant = options.api == .responses ? .responses : .chatCompletions
+        configuration.transport = options.transport
+        configuration.rateLimiter = options.rateLimiter
         let provider = OpenAIProvider(configuration: configuration)
 
-        return .custom(provider) { model in
-            .openAI(model.id)
-        }
+        return .custom(
+            provider,
+            mapModel: { model in .openAI(model.id) },
+            prepare: { _ in await provider.prewarmConnection() }
+        )
     }
 
     public static func openRouter(
@@ -400,11 +426,15 @@ extension Provider {
         configuration.defaultHeaders = options.headers
         configuration.organizationID = options.organizationID
         configuration.apiVariant = options.api == .responses ? .responses : .chatCompletions
+        configuration.transport = options.transport
+        configuration.rateLimiter = options.rateLimiter
         let provider = OpenAIProvider(configuration: configuration)
 
-        return .custom(provider) { model in
-            .openAI(model.id)
-        }
+        return .custom(
+            provider,
+            mapModel: { model in .openAI(model.id) },
+            prepare: { _ in await provider.prewarmConnection() }
+        )
     }
     #endif
 
@@ -427,11 +457,15 @@ extension Provider {
         configuration.thinkingConfig = options.thinkingBudgetTokens.map {
             ThinkingConfiguration(enabled: true, budgetTokens: max(0, $0))
         }
+        configuration.transport = options.transport
+        configuration.rateLimiter = options.rateLimiter
         let provider = AnthropicProvider(configuration: configuration)
 
-        return .custom(provider) { model in
-            .anthropic(model.id)
-        }
+        return .custom(
+            provider,
+            mapModel: { model in .anthropic(model.id) },
+            prepare: { _ in await provider.prewarmConnection() }
+        )
     }
     #endif
 
@@ -441,12 +475,16 @@ extension Provider {
     public static func kimi(apiKey: String) -> Self {
         let provider = KimiProvider(apiKey: apiKey)
 
-        return .custom(provider) { model in
-            guard model.family == .kimi || model.family == .custom else {
-                throw AIError.invalidInput("Kimi provider requires .kimi(...) models")
-            }
-            return .kimi(model.id)
-        }
+        return .custom(
+            provider,
+            mapModel: { model in
+                guard model.family == .kimi || model.family == .custom else {
+                    throw AIError.invalidInput("Kimi provider requires .kimi(...) models")
+                }
+                return .kimi(model.id)
+            },
+            prepare: { _ in await provider.prewarmConnection() }
+        )
     }
     #endif
 
@@ -454,12 +492,16 @@ extension Provider {
     public static func miniMax(apiKey: String? = nil) -> Self {
         let provider = MiniMaxProvider(apiKey: apiKey)
 
-        return .custom(provider) { model in
-            guard model.family == .miniMax || model.family == .custom else {
-                throw AIError.invalidInput("MiniMax provider requires .miniMax(...) models")
-            }
-            return .miniMax(model.id)
-        }
+        return .custom(
+            provider,
+            mapModel: { model in
+                guard model.family == .miniMax || model.family == .custom else {
+                    throw AIError.invalidInput("MiniMax provider requires .miniMax(...) models")
+                }
+                return .miniMax(model.id)
+            },
+            prepare: { _ in await provider.prewarmConnection() }
+        )
     }
     #endif
 }
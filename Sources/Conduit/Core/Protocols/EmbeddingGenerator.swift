@@ -87,6 +87,8 @@ import Foundation
 /// ## Performance Considerations
 ///
 /// - Use `embedBatch(_:model:)` for multiple texts to benefit from batching optimizations
+/// - Use `embedMatrix(_:model:)` for large batches to receive one contiguous buffer
+/// - Wrap a provider in ``EmbeddingMicroBatcher`` to merge concurrent single `embed` calls
 /// - Cache embeddings when possible; they're deterministic for the same text and model
 /// - Choose embedding models based on your use case:
 ///   - **Small models** (384 dims): Fast, less accurate (e.g., `all-MiniLM-L6-v2`)
@@ -241,6 +243,34 @@ public protocol EmbeddingGenerator: Sendable {
         _ texts: [String],
         model: ModelID
     ) async throws -> [EmbeddingResult]
+
+    /// Generates embeddings for multiple texts into one contiguous buffer.
+    ///
+    /// Equivalent to ``embedBatch(_:model:)``, but returns an
+    /// ``EmbeddingMatrix`` whose rows share a single `[Float]` allocation.
+    /// Prefer this for large batches: it avoids one array per text and
+    /// hands vector stores a buffer they can copy in one step.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let matrix = try await provider.embedMatrix(chunks, model: .textEmbedding3Small)
+    /// for (chunk, row) in zip(chunks, matrix) {
+    ///     store.insert(chunk, vector: row)
+    /// }
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - texts: An array of input texts to embed.
+    ///   - model: The embedding model to use.
+    ///
+    /// - Returns: A matrix with one row per input text, in the same order.
+    ///
+    /// - Throws: ``AIError`` if batch embedding fails, including when the
+    ///           provider returns rows of different dimensions.
+    func embedMatrix(
+        _ texts: [String],
+        model: ModelID
+    ) async throws -> EmbeddingMatrix
 }
 
 // MARK: - Default Implementations
@@ -270,4 +300,16 @@ extension EmbeddingGenerator {
 
         return results
     }
+
+    /// Default implementation that packs ``embedBatch(_:model:)`` results
+    /// into a contiguous matrix.
+    ///
+    /// Providers with native batch endpoints override this to decode
+    /// responses straight into the matrix.
+    public func embedMatrix(
+        _ texts: [String],
+        model: ModelID
+    ) async throws -> EmbeddingMatrix {
+        try EmbeddingMatrix(try await embedBatch(texts, model: model))
+    }
 }
@@ -110,6 +110,10 @@ extension Tool where Self.Arguments: Generable {
 // MARK: - Helpers
 
 extension Tool {
+    internal func validate(arguments: GeneratedContent) throws {
+        _ = try Arguments(arguments)
+    }
+
     internal func makeOutputSegments(from arguments: GeneratedContent) async throws -> [Transcript.Segment] {
         let parsedArguments = try Arguments(arguments)
         let output = try await call(arguments: parsedArguments)
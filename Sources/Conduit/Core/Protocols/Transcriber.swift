@@ -158,3 +158,38 @@ public protocol Transcriber: Sendable {
         config: TranscriptionConfig
     ) -> AsyncThrowingStream<TranscriptionSegment, Error>
 }
+
+// MARK: - Chunked Streaming Transcription
+
+extension Transcriber {
+
+    /// Streams a long recording by transcribing overlapping windows in parallel.
+    ///
+    /// The file is cut into windows according to `chunking`, each window is
+    /// sent through ``transcribe(audioData:model:config:)``, and the results
+    /// are stitched into segments whose timestamps are relative to the whole
+    /// recording. Segments arrive in order as soon as every earlier window has
+    /// finished, so the first words are available after one window's latency
+    /// and only the windows in flight are held in memory.
+    ///
+    /// Enable ``TranscriptionConfig/wordTimestamps`` where the provider
+    /// supports it: words let the boundary between windows fall between two
+    /// words rather than between two segments.
+    ///
+    /// - Parameters:
+    ///   - url: The audio file. WAV files are windowed; other formats are sent whole.
+    ///   - model: The transcription model to use.
+    ///   - config: Transcription options applied to every window.
+    ///   - chunking: Window length, overlap and concurrency.
+    /// - Returns: An async stream of segments, numbered from 0 across the recording.
+    public func streamTranscription(
+        audioURL url: URL,
+        model: ModelID,
+        config: TranscriptionConfig,
+        chunking: TranscriptionChunking
+    ) -> AsyncThrowingStream<TranscriptionSegment, Error> {
+        chunking.stream(audioURL: url) { audio in
+            try await self.transcribe(audioData: audio, model: model, config: config)
+        }
+    }
+}
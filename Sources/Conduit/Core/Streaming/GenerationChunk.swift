@@ -96,6 +96,23 @@ public struct PartialToolCall: Sendable, Hashable {
     /// Current accumulated arguments JSON fragment.
     public let argumentsFragment: String
 
+    /// Best-effort structured view of the arguments received so far.
+    ///
+    /// Providers parse argument fragments incrementally as they arrive, so this
+    /// value is available on every update without re-parsing ``argumentsFragment``.
+    /// Unterminated strings carry the characters received so far and keys without
+    /// a value yet are omitted. `nil` when no argument value has started or the
+    /// provider does not parse arguments incrementally.
+    ///
+    /// Use it together with ``isArgumentsComplete`` to validate or prefetch before
+    /// the model finishes the tool call (see ``ToolExecutor/validateArguments(of:)``).
+    public let partialArguments: GeneratedContent?
+
+    /// Whether the arguments JSON has been fully received.
+    ///
+    /// When `true`, ``partialArguments`` holds the final arguments value.
+    public let isArgumentsComplete: Bool
+
     /// Creates a partial tool call.
     ///
     /// - Parameters:
@@ -103,11 +120,20 @@ public struct PartialToolCall: Sendable, Hashable {
     ///   - toolName: Name of the tool being called. Must not be empty.
     ///   - index: Index of this tool call in the response. Must be in range `0...maxToolCallIndex`.
     ///   - argumentsFragment: Current accumulated arguments JSON fragment.
+    ///   - partialArguments: Structured view of the arguments received so far.
+    ///   - isArgumentsComplete: Whether the arguments JSON has been fully received.
     ///
     /// - Precondition: `id` must not be empty.
     /// - Precondition: `toolName` must not be empty.
     /// - Precondition: `index` must be in range `0...maxToolCallIndex` (0...100).
-    public init(id: String, toolName: String, index: Int, argumentsFragment: String) {
+    public init(
+        id: String,
+        toolName: String,
+        index: Int,
+        argumentsFragment: String,
+        partialArguments: GeneratedContent? = nil,
+        isArgumentsComplete: Bool = false
+    ) {
         precondition(!id.isEmpty, "PartialToolCall id must not be empty")
         precondition(!toolName.isEmpty, "PartialToolCall toolName must not be empty")
         precondition(
@@ -119,6 +145,16 @@ public struct PartialToolCall: Sendable, Hashable {
         self.toolName = toolName
         self.index = index
         self.argumentsFragment = argumentsFragment
+        self.partialArguments = partialArguments
+        self.isArgumentsComplete = isArgumentsComplete
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        hasher.combine(id)
+        hasher.combine(toolName)
+        hasher.combine(index)
+        hasher.combine(argumentsFragment)
+        hasher.combine(isArgumentsComplete)
     }
 }
 
@@ -0,0 +1,163 @@
+// StreamingToolCallAccumulator.swift
+// Conduit
+//
+// Incremental assembly of streamed tool-call arguments.
+
+import Foundation
+
+// MARK: - StreamingToolCallAccumulator
+
+/// Accumulates the argument fragments of one streamed tool call.
+///
+/// Each fragment is appended to the raw arguments buffer and fed to an
+/// ``IncrementalJSONParser`` exactly once, so providers can publish a typed
+/// ``PartialToolCall/partialArguments`` value on every delta and finalize the
+/// call from parser state instead of re-parsing (and repairing) the whole
+/// buffer when the stream finishes.
+///
+/// ## Usage
+///
+/// ```swift
+/// var accumulator = StreamingToolCallAccumulator(
+///     id: "call_1",
+///     name: "get_weather",
+///     index: 0,
+///     maximumArgumentsSize: maxToolArgumentsSize
+/// )
+/// accumulator.append(#"{"city": "Par"#)
+/// continuation.yield(GenerationChunk(text: "", partialToolCall: accumulator.partialToolCall))
+///
+/// let (toolCall, wasRepaired) = try accumulator.makeToolCall()
+/// ```
+internal struct StreamingToolCallAccumulator: Sendable {
+
+    /// Provider-assigned tool call identifier.
+    let id: String
+
+    /// Name of the tool being called.
+    var name: String
+
+    /// Position of this call among the parallel tool calls of a response.
+    let index: Int
+
+    /// Maximum number of characters retained in ``argumentsBuffer``.
+    let maximumArgumentsSize: Int
+
+    /// The raw arguments JSON received so far.
+    private(set) var argumentsBuffer = ""
+
+    /// Whether fragments were dropped because ``maximumArgumentsSize`` was reached.
+    private(set) var isTruncated = false
+
+    private var parser = IncrementalJSONParser()
+    private var argumentsCount = 0
+
+    // MARK: - Initialization
+
+    init(id: String, name: String, index: Int, maximumArgumentsSize: Int, arguments: String = "") {
+        self.id = id
+        self.name = name
+        self.index = index
+        self.maximumArgumentsSize = maximumArgumentsSize
+        if !arguments.isEmpty {
+            append(arguments)
+        }
+    }
+
+    // MARK: - Accumulation
+
+    /// Whether the parser has received a complete arguments value.
+    var isArgumentsComplete: Bool {
+        parser.state == .complete
+    }
+
+    /// Appends an arguments fragment, truncating at ``maximumArgumentsSize``.
+    ///
+    /// - Returns: `false` if the fragment was truncated.
+    @discardableResult
+    mutating func append(_ fragment: String) -> Bool {
+        guard !fragment.isEmpty else { return true }
+
+        if argumentsBuffer.isEmpty {
+            // Pre-allocate capacity on first append to avoid O(n²) string concatenation
+            argumentsBuffer.reserveCapacity(min(4096, maximumArgumentsSize))
+        }
+
+        var accepted = fragment
+        var acceptedCount = fragment.count
+        let remaining = max(0, maximumArgumentsSize - argumentsCount)
+        let fitsLimit = acceptedCount <= remaining
+        if !fitsLimit {
+            accepted = String(fragment.prefix(remaining))
+            acceptedCount = remaining
+            isTruncated = true
+        }
+
+        argumentsBuffer += accepted
+        argumentsCount += acceptedCount
+
+        parser.feed(accepted)
+
+        return fitsLimit
+    }
+
+    /// A streaming update describing the current state of this call.
+    ///
+    /// The structured arguments are assembled on each read rather than kept
+    /// here: a retained snapshot shares storage with the parser's open
+    /// containers, so the next fragment would copy them in full.
+    var partialToolCall: PartialToolCall {
+        PartialToolCall(
+            id: id,
+            toolName: name,
+            index: index,
+            argumentsFragment: argumentsBuffer,
+            partialArguments: parser.state == .failed ? nil : parser.snapshot(),
+            isArgumentsComplete: isArgumentsComplete
+        )
+    }
+
+    // MARK: - Finalization
+
+    /// Builds the completed tool call.
+    ///
+    /// Well-formed and truncated-but-valid-so-far arguments are resolved directly
+    /// from parser state: open strings are closed, keys without values dropped and
+    /// open containers closed, without another pass over the buffer. Only when the
+    /// parser rejected the input does this fall back to strict parsing followed by
+    /// ``JsonRepair``.
+    ///
+    /// - Returns: The tool call and whether the arguments had to be repaired.
+    /// - Throws: The strict parsing error if the arguments cannot be recovered.
+    func makeToolCall() throws -> (toolCall: Transcript.ToolCall, wasRepaired: Bool) {
+        var parser = parser
+        parser.finish()
+
+        switch parser.state {
+        case .complete:
+            if let arguments = parser.snapshot() {
+                return (Transcript.ToolCall(id: id, toolName: name, arguments: arguments), false)
+            }
+
+        case .parsing:
+            if let arguments = parser.snapshot() {
+                return (Transcript.ToolCall(id: id, toolName: name, arguments: arguments), true)
+            }
+            if argumentsBuffer.allSatisfy(\.isWhitespace) {
+                let arguments = GeneratedContent(kind: .structure(properties: [:], orderedKeys: []))
+                return (Transcript.ToolCall(id: id, toolName: name, arguments: arguments), false)
+            }
+
+        case .failed:
+            break
+        }
+
+        do {
+            return (try Transcript.ToolCall(id: id, toolName: name, argumentsJSON: argumentsBuffer), false)
+        } catch {
+            let repaired = JsonRepair.repair(argumentsBuffer)
+            guard repaired != argumentsBuffer else { throw error }
+            return (try Transcript.ToolCall(id: id, toolName: name, argumentsJSON: repaired), true)
+        }
+    }
+}
@@ -0,0 +1,321 @@
+// ConduitTelemetry.swift
+// Conduit
+//
+// Pluggable stage timings and counters for providers, tools, and transport.
+
+import Foundation
+
+// MARK: - TelemetryStage
+
+/// A stage of a request that Conduit times.
+public enum TelemetryStage: String, Sendable, Hashable, CaseIterable, Codable {
+    /// Time a request waited for a per-host slot in ``ConduitTransport``.
+    case queueWait
+
+    /// Time from sending a request to receiving its response headers,
+    /// including DNS, TLS, and server think time before the first byte.
+    case connect
+
+    /// Time from the start of a streaming generation to its first chunk.
+    case timeToFirstToken
+
+    /// Time between consecutive chunks of a streaming generation.
+    case interTokenGap
+
+    /// Time from the start of a streaming generation to its last chunk.
+    case generation
+
+    /// Time one attempt of a tool call took in ``ToolExecutor``.
+    case toolExecution
+
+    /// Time ``JsonRepair`` spent closing incomplete JSON.
+    case jsonRepair
+}
+
+// MARK: - TelemetryCounter
+
+/// An event Conduit counts.
+public enum TelemetryCounter: String, Sendable, Hashable, CaseIterable, Codable {
+    /// Streaming generations started.
+    case requests
+
+    /// Chunks yielded by streaming generations. For local providers each
+    /// chunk is one token.
+    case streamedChunks
+
+    /// Tool call attempts run by ``ToolExecutor``.
+    case toolCalls
+
+    /// Tool call attempts that threw.
+    case toolFailures
+
+    /// Strings ``JsonRepair`` was asked to repair.
+    case jsonRepairs
+}
+
+// MARK: - TelemetryMeasurement
+
+/// A finished stage.
+public struct TelemetryMeasurement: Sendable, Hashable {
+    /// The stage that finished.
+    public var stage: TelemetryStage
+
+    /// What the stage belongs to: the provider (e.g. "openai") for
+    /// generation stages, the host for transport stages, the tool name for
+    /// tool execution, and "json" for JSON repair.
+    public var source: String
+
+    /// How long the stage took.
+    public var duration: Duration
+
+    /// Matches the ID passed to ``TelemetryBackend/stageDidBegin(_:source:spanID:)``,
+    /// or 0 for stages that were not announced when they began.
+    public var spanID: UInt64
+
+    /// Creates a measurement.
+    public init(stage: TelemetryStage, source: String, duration: Duration, spanID: UInt64 = 0) {
+        self.stage = stage
+        self.source = source
+        self.duration = duration
+        self.spanID = spanID
+    }
+
+    /// ``duration`` in nanoseconds.
+    public var nanoseconds: Int64 {
+        let (seconds, attoseconds) = duration.components
+        return seconds * 1_000_000_000 + attoseconds / 1_000_000_000
+    }
+}
+
+// MARK: - TelemetryBackend
+
+/// Receives Conduit's stage timings and counters.
+///
+/// Conform to forward measurements to a metrics or tracing system. Methods
+/// are called synchronously from provider streaming loops, so they should
+/// return quickly and must be safe to call from any thread.
+///
+/// ```swift
+/// import Metrics
+///
+/// struct SwiftMetricsBackend: TelemetryBackend {
+///     func record(_ measurement: TelemetryMeasurement) {
+///         Timer(label: "conduit.\(measurement.stage.rawValue)",
+///               dimensions: [("source", measurement.source)])
+///             .recordNanoseconds(measurement.nanoseconds)
+///     }
+///
+///     func increment(_ counter: TelemetryCounter, source: String, by amount: Int) {
+///         Counter(label: "conduit.\(counter.rawValue)", dimensions: [("source", source)])
+///             .increment(by: amount)
+///     }
+/// }
+///
+/// ConduitTelemetry.bootstrap(SwiftMetricsBackend())
+/// ```
+public protocol TelemetryBackend: Sendable {
+    /// Called when a stage that can be traced as a span begins.
+    ///
+    /// Short, frequent stages such as ``TelemetryStage/interTokenGap`` are
+    /// only reported through ``record(_:)``. Default: does nothing.
+    func stageDidBegin(_ stage: TelemetryStage, source: String, spanID: UInt64)
+
+    /// Called when a stage finishes.
+    func record(_ measurement: TelemetryMeasurement)
+
+    /// Called when a counted event occurs. Default: does nothing.
+    func increment(_ counter: TelemetryCounter, source: String, by amount: Int)
+}
+
+extension TelemetryBackend {
+    public func stageDidBegin(_ stage: TelemetryStage, source: String, spanID: UInt64) {}
+
+    public func increment(_ counter: TelemetryCounter, source: String, by amount: Int) {}
+}
+
+// MARK: - ConduitTelemetry
+
+/// The process-wide telemetry backend.
+///
+/// Telemetry is off until a backend is bootstrapped. While it is off, each
+/// instrumented call site costs one uncontended lock to find there is no
+/// backend, and streaming loops resolve the backend once per request, so
+/// the per-token cost is a `nil` check.
+///
+/// ```swift
+/// let histograms = TelemetryHistograms()
+/// ConduitTelemetry.bootstrap(histograms, SignpostTelemetryBackend())
+///
+/// // Later
+/// let ttft = histograms.summary(of: .timeToFirstToken, source: "openai")
+/// print(ttft?.p90 ?? .zero)
+/// ```
+public enum ConduitTelemetry {
+
+    private static let lock = NSLock()
+    nonisolated(unsafe) private static var installed: (any TelemetryBackend)?
+
+    /// Sends measurements to `backends`, replacing any earlier backends.
+    ///
+    /// Requests already streaming keep reporting to the backends that were
+    /// installed when they began.
+    public static func bootstrap(_ backends: any TelemetryBackend...) {
+        bootstrap(backends)
+    }
+
+    /// Sends measurements to `backends`, replacing any earlier backends.
+    /// Pass an empty array to turn telemetry off.
+    public static func bootstrap(_ backends: [any TelemetryBackend]) {
+        let backend: (any TelemetryBackend)? = switch backends.count {
+        case 0: nil
+        case 1: backends[0]
+        default: MultiplexTelemetryBackend(backends: backends)
+        }
+        lock.lock()
+        defer { lock.unlock() }
+        installed = backend
+    }
+
+    /// The installed backend, or `nil` when telemetry is off.
+    public static var backend: (any TelemetryBackend)? {
+        lock.lock()
+        defer { lock.unlock() }
+        return installed
+    }
+
+    // MARK: - Recording
+
+    /// Times `body` as `stage`.
+    internal static func measure<T>(
+        _ stage: TelemetryStage,
+        source: @autoclosure () -> String,
+        _ body: () throws -> T
+    ) rethrows -> T {
+        guard let backend else { return try body() }
+        let span = TelemetrySpan(stage, source: source(), backend: backend)
+        defer { span.end() }
+        return try body()
+    }
+
+    /// Times `body` as `stage`, running it on the caller's actor.
+    internal static func measure<T>(
+        _ stage: TelemetryStage,
+        source: @autoclosure () -> String,
+        isolation: isolated (any Actor)? = #isolation,
+        _ body: () async throws -> T
+    ) async rethrows -> T {
+        guard let backend else { return try await body() }
+        let span = TelemetrySpan(stage, source: source(), backend: backend)
+        defer { span.end() }
+        return try await body()
+    }
+
+    /// Counts `amount` occurrences of `counter`.
+    internal static func increment(_ counter: TelemetryCounter, source: @autoclosure () -> String, by amount: Int = 1) {
+        backend?.increment(counter, source: source(), by: amount)
+    }
+}
+
+// MARK: - TelemetrySpan
+
+/// A stage in progress, reported to the backend that was installed when it began.
+internal struct TelemetrySpan: Sendable {
+    let stage: TelemetryStage
+    let source: String
+    let spanID: UInt64
+    private let backend: any TelemetryBackend
+    private let start: ContinuousClock.Instant
+
+    /// Begins `stage`, or returns `nil` when telemetry is off.
+    init?(_ stage: TelemetryStage, source: @autoclosure () -> String) {
+        guard let backend = ConduitTelemetry.backend else { return nil }
+        self.init(stage, source: source(), backend: backend)
+    }
+
+    init(_ stage: TelemetryStage, source: String, backend: any TelemetryBackend) {
+        self.stage = stage
+        self.source = source
+        self.spanID = UInt64.random(in: 1...UInt64.max)
+        self.backend = backend
+        backend.stageDidBegin(stage, source: source, spanID: spanID)
+        self.start = .now
+    }
+
+    /// Reports the stage as finished now.
+    func end() {
+        backend.record(TelemetryMeasurement(
+            stage: stage,
+            source: source,
+            duration: ContinuousClock.now - start,
+            spanID: spanID
+        ))
+    }
+}
+
+// MARK: - TelemetryStream
+
+/// Times one streaming generation: time to first token, the gaps between
+/// chunks, and the whole generation.
+///
+/// Create one per request with `TelemetryStream(source:)`, which returns
+/// `nil` when telemetry is off, and call ``chunkReceived()`` through
+/// optional chaining for every yielded chunk.
+internal struct TelemetryStream: Sendable {
+    private let backend: any TelemetryBackend
+    private let generation: TelemetrySpan
+    private let start: ContinuousClock.Instant
+    private var lastChunk: ContinuousClock.Instant?
+    private var chunks = 0
+
+    /// Begins timing a generation, or returns `nil` when telemetry is off.
+    init?(source: String) {
+        guard let backend = ConduitTelemetry.backend else { return nil }
+        self.backend = backend
+        backend.increment(.requests, source: source, by: 1)
+        self.generation = TelemetrySpan(.generation, source: source, backend: backend)
+        self.start = .now
+    }
+
+    /// Records a chunk arriving now.
+    mutating func chunkReceived() {
+        let now = ContinuousClock.now
+        backend.record(TelemetryMeasurement(
+            stage: lastChunk == nil ? .timeToFirstToken : .interTokenGap,
+            source: generation.source,
+            duration: now - (lastChunk ?? start)
+        ))
+        lastChunk = now
+        chunks += 1
+    }
+
+    /// Records the end of the generation.
+    func finish() {
+        backend.increment(.streamedChunks, source: generation.source, by: chunks)
+        generation.end()
+    }
+}
+
+// MARK: - MultiplexTelemetryBackend
+
+/// Forwards to several backends in order.
+private struct MultiplexTelemetryBackend: TelemetryBackend {
+    let backends: [any TelemetryBackend]
+
+    func stageDidBegin(_ stage: TelemetryStage, source: String, spanID: UInt64) {
+        for backend in backends {
+            backend.stageDidBegin(stage, source: source, spanID: spanID)
+        }
+    }
+
+    func record(_ measurement: TelemetryMeasurement) {
+        for backend in backends {
+            backend.record(measurement)
+        }
+    }
+
+    func increment(_ counter: TelemetryCounter, source: String, by amount: Int) {
+        for backend in backends {
+            backend.increment(counter, source: source, by: amount)
+        }
+    }
+}
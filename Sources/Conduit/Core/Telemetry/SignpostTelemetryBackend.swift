@@ -0,0 +1,105 @@
+// SignpostTelemetryBackend.swift
+// Conduit
+//
+// Reports ConduitTelemetry stages as os_signpost intervals for Instruments.
+
+#if canImport(os)
+import Foundation
+import os
+
+// MARK: - SignpostTelemetryBackend
+
+/// A ``TelemetryBackend`` that emits signposts for Instruments.
+///
+/// Stages announced when they begin appear as intervals in the
+/// Points of Interest and os_signpost instruments. Stages reported only
+/// when they finish, such as ``TelemetryStage/interTokenGap``, appear as
+/// events carrying their source and duration.
+///
+/// ```swift
+/// ConduitTelemetry.bootstrap(SignpostTelemetryBackend())
+/// ```
+///
+/// Signposts cost almost nothing while Instruments is not recording.
+public final class SignpostTelemetryBackend: TelemetryBackend, @unchecked Sendable {
+
+    private let signposter: OSSignposter
+    private let lock = NSLock()
+    private var intervals: [UInt64: OSSignpostIntervalState] = [:]
+
+    /// Creates a signpost backend.
+    ///
+    /// - Parameters:
+    ///   - subsystem: The log subsystem. Default: `com.conduit`
+    ///   - category: The log category. Default: `Telemetry`
+    public init(subsystem: String = "com.conduit", category: String = "Telemetry") {
+        self.signposter = OSSignposter(subsystem: subsystem, category: category)
+    }
+
+    // MARK: - TelemetryBackend
+
+    public func stageDidBegin(_ stage: TelemetryStage, source: String, spanID: UInt64) {
+        guard signposter.isEnabled else { return }
+        let id = OSSignpostID(spanID)
+        let state: OSSignpostIntervalState
+        switch stage {
+        case .queueWait: state = signposter.beginInterval("queueWait", id: id, "\(source, privacy: .public)")
+        case .connect: state = signposter.beginInterval("connect", id: id, "\(source, privacy: .public)")
+        case .timeToFirstToken:
+            state = signposter.beginInterval("timeToFirstToken", id: id, "\(source, privacy: .public)")
+        case .interTokenGap: state = signposter.beginInterval("interTokenGap", id: id, "\(source, privacy: .public)")
+        case .generation: state = signposter.beginInterval("generation", id: id, "\(source, privacy: .public)")
+        case .toolExecution: state = signposter.beginInterval("toolExecution", id: id, "\(source, privacy: .public)")
+        case .jsonRepair: state = signposter.beginInterval("jsonRepair", id: id, "\(source, privacy: .public)")
+        }
+        lock.lock()
+        intervals[spanID] = state
+        lock.unlock()
+    }
+
+    public func record(_ measurement: TelemetryMeasurement) {
+        var state: OSSignpostIntervalState?
+        if measurement.spanID != 0 {
+            lock.lock()
+            state = intervals.removeValue(forKey: measurement.spanID)
+            lock.unlock()
+        }
+        guard signposter.isEnabled else { return }
+
+        if let state {
+            end(measurement.stage, state: state)
+        } else {
+            emit(measurement)
+        }
+    }
+
+    // MARK: - Private
+
+    private func end(_ stage: TelemetryStage, state: OSSignpostIntervalState) {
+        switch stage {
+        case .queueWait: signposter.endInterval("queueWait", state)
+        case .connect: signposter.endInterval("connect", state)
+        case .timeToFirstToken: signposter.endInterval("timeToFirstToken", state)
+        case .interTokenGap: signposter.endInterval("interTokenGap", state)
+        case .generation: signposter.endInterval("generation", state)
+        case .toolExecution: signposter.endInterval("toolExecution", state)
+        case .jsonRepair: signposter.endInterval("jsonRepair", state)
+        }
+    }
+
+    private func emit(_ measurement: TelemetryMeasurement) {
+        let source = measurement.source
+        let microseconds = measurement.nanoseconds / 1_000
+        switch measurement.stage {
+        case .queueWait: signposter.emitEvent("queueWait", "\(source, privacy: .public) \(microseconds)µs")
+        case .connect: signposter.emitEvent("connect", "\(source, privacy: .public) \(microseconds)µs")
+        case .timeToFirstToken:
+            signposter.emitEvent("timeToFirstToken", "\(source, privacy: .public) \(microseconds)µs")
+        case .interTokenGap: signposter.emitEvent("interTokenGap", "\(source, privacy: .public) \(microseconds)µs")
+        case .generation: signposter.emitEvent("generation", "\(source, privacy: .public) \(microseconds)µs")
+        case .toolExecution: signposter.emitEvent("toolExecution", "\(source, privacy: .public) \(microseconds)µs")
+        case .jsonRepair: signposter.emitEvent("jsonRepair", "\(source, privacy: .public) \(microseconds)µs")
+        }
+    }
+}
+#endif
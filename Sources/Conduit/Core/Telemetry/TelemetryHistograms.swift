@@ -0,0 +1,235 @@
+// TelemetryHistograms.swift
+// Conduit
+//
+// In-process histograms and counters for ConduitTelemetry.
+
+import Foundation
+
+// MARK: - TelemetryHistogram
+
+/// A fixed-size latency histogram with logarithmic buckets.
+///
+/// Each power of two from 1µs up is split into four buckets, so quantiles
+/// are accurate to within 25% of the value at any scale, and recording is
+/// a constant-time bucket increment with no allocation.
+public struct TelemetryHistogram: Sendable, Hashable {
+
+    /// Linear sub-buckets per power of two.
+    private static let subBuckets = 4
+
+    /// Bucket count, covering up to 2^40µs (about 12 days).
+    private static let bucketCount = subBuckets * 40
+
+    /// Recorded values per bucket.
+    private var buckets = [Int](repeating: 0, count: bucketCount)
+
+    /// Values recorded.
+    public private(set) var count = 0
+
+    /// Sum of recorded durations in microseconds.
+    private var totalMicroseconds: Int64 = 0
+
+    /// Shortest recorded duration.
+    public private(set) var min: Duration?
+
+    /// Longest recorded duration.
+    public private(set) var max: Duration?
+
+    /// Creates an empty histogram.
+    public init() {}
+
+    /// Adds a duration.
+    public mutating func record(_ duration: Duration) {
+        let microseconds = Swift.max(0, Self.microseconds(of: duration))
+        buckets[Self.bucket(for: microseconds)] += 1
+        count += 1
+        totalMicroseconds &+= microseconds
+        min = min.map { Swift.min($0, duration) } ?? duration
+        max = max.map { Swift.max($0, duration) } ?? duration
+    }
+
+    /// Mean of the recorded durations, or `nil` if none were recorded.
+    public var mean: Duration? {
+        guard count > 0 else { return nil }
+        return .microseconds(totalMicroseconds / Int64(count))
+    }
+
+    /// The duration below which `fraction` of recorded values fall, or `nil`
+    /// if none were recorded.
+    ///
+    /// - Parameter fraction: A quantile in 0...1, such as 0.99.
+    public func quantile(_ fraction: Double) -> Duration? {
+        guard count > 0 else { return nil }
+        let rank = Swift.max(1, Int((Double(count) * Swift.min(Swift.max(fraction, 0), 1)).rounded(.up)))
+        var seen = 0
+        for (index, bucketCount) in buckets.enumerated() where bucketCount > 0 {
+            seen += bucketCount
+            if seen >= rank {
+                let value = Duration.microseconds(Self.upperBound(ofBucket: index))
+                return Swift.min(Swift.max(value, min ?? value), max ?? value)
+            }
+        }
+        return max
+    }
+
+    /// Median.
+    public var p50: Duration? { quantile(0.5) }
+
+    /// 90th percentile.
+    public var p90: Duration? { quantile(0.9) }
+
+    /// 99th percentile.
+    public var p99: Duration? { quantile(0.99) }
+
+    // MARK: - Buckets
+
+    static func microseconds(of duration: Duration) -> Int64 {
+        let (seconds, attoseconds) = duration.components
+        return seconds * 1_000_000 + attoseconds / 1_000_000_000_000
+    }
+
+    /// The bucket holding `microseconds`.
+    static func bucket(for microseconds: Int64) -> Int {
+        guard microseconds >= Int64(subBuckets) else { return Int(microseconds) }
+        let exponent = Int64.bitWidth - 1 - microseconds.leadingZeroBitCount
+        let subBucket = Int(microseconds >> (exponent - 2)) & (subBuckets - 1)
+        return Swift.min(bucketCount - 1, (exponent - 1) * subBuckets + subBucket)
+    }
+
+    /// The largest value, in microseconds, that falls in bucket `index`.
+    static func upperBound(ofBucket index: Int) -> Int64 {
+        guard index >= subBuckets else { return Int64(index) }
+        let exponent = index / subBuckets + 1
+        let subBucket = Int64(index % subBuckets)
+        let width = Int64(1) << (exponent - 2)
+        return (Int64(subBuckets) + subBucket + 1) * width - 1
+    }
+}
+
+// MARK: - TelemetryHistograms
+
+/// A ``TelemetryBackend`` that keeps latency histograms and counters in memory.
+///
+/// Measurements are grouped by source, so each provider, host, and tool
+/// has its own histograms. Each source has its own lock, held only for a
+/// bucket increment, so providers streaming at once share nothing but a
+/// brief lookup of their source.
+///
+/// ```swift
+/// let histograms = TelemetryHistograms()
+/// ConduitTelemetry.bootstrap(histograms)
+///
+/// // After some traffic
+/// if let gaps = histograms.summary(of: .interTokenGap, source: "anthropic") {
+///     print("p99 inter-token gap:", gaps.p99 ?? .zero)
+/// }
+/// print(histograms.count(of: .streamedChunks, source: "anthropic"))
+/// ```
+public final class TelemetryHistograms: TelemetryBackend, @unchecked Sendable, Hashable {
+
+    // MARK: - Snapshot
+
+    /// The histograms and counters of one source.
+    public struct Snapshot: Sendable, Hashable {
+        /// Durations per stage.
+        public var histograms: [TelemetryStage: TelemetryHistogram] = [:]
+
+        /// Event counts.
+        public var counters: [TelemetryCounter: Int] = [:]
+    }
+
+    // MARK: - State
+
+    private final class Shard: @unchecked Sendable {
+        private let lock = NSLock()
+        private var snapshot = Snapshot()
+
+        func record(_ duration: Duration, stage: TelemetryStage) {
+            lock.lock()
+            defer { lock.unlock() }
+            snapshot.histograms[stage, default: TelemetryHistogram()].record(duration)
+        }
+
+        func increment(_ counter: TelemetryCounter, by amount: Int) {
+            lock.lock()
+            defer { lock.unlock() }
+            snapshot.counters[counter, default: 0] += amount
+        }
+
+        func read() -> Snapshot {
+            lock.lock()
+            defer { lock.unlock() }
+            return snapshot
+        }
+    }
+
+    private let lock = NSLock()
+    private var shards: [String: Shard] = [:]
+
+    // MARK: - Initialization
+
+    /// Creates an empty set of histograms.
+    public init() {}
+
+    // MARK: - Public API
+
+    /// The histograms and counters of every source, keyed by source.
+    public var snapshot: [String: Snapshot] {
+        let shards = withLock { self.shards }
+        return shards.mapValues { $0.read() }
+    }
+
+    /// The histogram of `stage` for `source`, or `nil` if none was recorded.
+    public func summary(of stage: TelemetryStage, source: String) -> TelemetryHistogram? {
+        withLock { shards[source] }?.read().histograms[stage]
+    }
+
+    /// How many times `counter` was incremented for `source`.
+    public func count(of counter: TelemetryCounter, source: String) -> Int {
+        withLock { shards[source] }?.read().counters[counter] ?? 0
+    }
+
+    /// Clears every histogram and counter.
+    public func reset() {
+        withLock { shards.removeAll() }
+    }
+
+    // MARK: - TelemetryBackend
+
+    public func record(_ measurement: TelemetryMeasurement) {
+        shard(for: measurement.source).record(measurement.duration, stage: measurement.stage)
+    }
+
+    public func increment(_ counter: TelemetryCounter, source: String, by amount: Int) {
+        shard(for: source).increment(counter, by: amount)
+    }
+
+    // MARK: - Hashable
+
+    public static func == (lhs: TelemetryHistograms, rhs: TelemetryHistograms) -> Bool {
+        lhs === rhs
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        hasher.combine(ObjectIdentifier(self))
+    }
+
+    // MARK: - Private
+
+    private func shard(for source: String) -> Shard {
+        withLock {
+            if let shard = shards[source] {
+                return shard
+            }
+            let shard = Shard()
+            shards[source] = shard
+            return shard
+        }
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
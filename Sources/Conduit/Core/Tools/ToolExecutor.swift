@@ -38,6 +38,30 @@ import Foundation
 /// let result = try await executor.execute(toolCall: toolCall)
 /// ```
 ///
+/// ## Scheduling
+///
+/// Batches from ``execute(toolCalls:retryPolicy:)`` run concurrently. To
+/// protect downstream services, cap concurrency for the whole executor with
+/// ``setMaxConcurrentCalls(_:)`` and for individual tools with
+/// ``ToolOptions/maxConcurrentCalls``. Calls over a limit wait in order for a
+/// free slot. Tools marked ``ToolOptions/isIdempotent`` run once per distinct
+/// arguments within a batch, and can reuse results across batches for
+/// ``ToolOptions/resultCacheTTL``.
+///
+/// ```swift
+/// await executor.register(SearchTool(), options: ToolOptions(
+///     maxConcurrentCalls: 4,
+///     isIdempotent: true,
+///     resultCacheTTL: .seconds(60)
+/// ))
+/// await executor.setMaxConcurrentCalls(8)
+///
+/// // Handle each output as soon as its tool finishes
+/// for try await output in await executor.outputs(for: toolCalls) {
+///     print(output.toolName, output.text)
+/// }
+/// ```
+///
 /// ## Thread Safety
 ///
 /// `ToolExecutor` is an actor, ensuring thread-safe access to registered tools
@@ -59,8 +83,9 @@ public actor ToolExecutor {
     /// - `maxAttempts = 1`: execute once, no retries.
     /// - `maxAttempts = 2`: up to one retry.
     ///
-    /// This policy is deterministic: retries are immediate and do not use delays
-    /// or jitter.
+    /// Retries are immediate unless ``backoff`` is set, in which case the
+    /// delay starts at `backoff` and doubles after each failed retry. Delays
+    /// have no jitter, so retry timing stays deterministic.
     public struct RetryPolicy: Sendable, Hashable, Codable {
         /// Conditions under which failed tool calls are retried.
         public enum Condition: String, Sendable, Hashable, Codable {
@@ -80,6 +105,11 @@ public actor ToolExecutor {
         /// Retry condition used after each failed attempt.
         public var condition: Condition
 
+        /// Delay before the first retry, doubling for each later retry.
+        ///
+        /// `nil` retries immediately.
+        public var backoff: Duration?
+
         /// Creates a retry policy.
         ///
         /// Values less than `1` are clamped to `1`.
@@ -87,25 +117,34 @@ public actor ToolExecutor {
         /// - Parameters:
         ///   - maxAttempts: Maximum execution attempts including initial attempt.
         ///   - condition: Error-matching behavior for retries.
+        ///   - backoff: Delay before the first retry. Default: `nil` (immediate)
         public init(
             maxAttempts: Int = 1,
-            condition: Condition = .retryableAIErrors
+            condition: Condition = .retryableAIErrors,
+            backoff: Duration? = nil
         ) {
             self.maxAttempts = max(1, maxAttempts)
             self.condition = condition
+            self.backoff = backoff
         }
 
         /// Execute once, with no retries.
         public static let none = RetryPolicy(maxAttempts: 1, condition: .never)
 
         /// Retry retryable `AIError` failures up to `maxAttempts`.
-        public static func retryableAIErrors(maxAttempts: Int) -> RetryPolicy {
-            RetryPolicy(maxAttempts: maxAttempts, condition: .retryableAIErrors)
+        public static func retryableAIErrors(maxAttempts: Int, backoff: Duration? = nil) -> RetryPolicy {
+            RetryPolicy(maxAttempts: maxAttempts, condition: .retryableAIErrors, backoff: backoff)
         }
 
         /// Retry all non-cancellation failures up to `maxAttempts`.
-        public static func allFailures(maxAttempts: Int) -> RetryPolicy {
-            RetryPolicy(maxAttempts: maxAttempts, condition: .allFailuresExceptCancellation)
+        public static func allFailures(maxAttempts: Int, backoff: Duration? = nil) -> RetryPolicy {
+            RetryPolicy(maxAttempts: maxAttempts, condition: .allFailuresExceptCancellation, backoff: backoff)
+        }
+
+        /// The delay before retrying after `failedAttempt` failures, if any.
+        fileprivate func delay(afterFailedAttempt failedAttempt: Int) -> Duration? {
+            guard let backoff, backoff > .zero else { return nil }
+            return backoff * (1 << min(max(0, failedAttempt - 1), 16))
         }
 
         fileprivate func shouldRetry(after error: any Error, failedAttempt: Int) -> Bool {
@@ -131,12 +170,94 @@ public actor ToolExecutor {
         }
     }
 
+    /// Outcome of validating a streamed tool call before it completes.
+    ///
+    /// - SeeAlso: ``ToolExecutor/validateArguments(of:)``
+    public enum ArgumentsValidation: Sendable, Hashable {
+        /// Not enough arguments have arrived to decide.
+        case pending
+
+        /// The arguments decode into the tool's `Arguments` type.
+        ///
+        /// For a call whose arguments are still streaming, string values may
+        /// continue to grow; the result becomes final once
+        /// ``PartialToolCall/isArgumentsComplete`` is `true`.
+        case valid
+
+        /// The complete arguments do not decode into the tool's `Arguments` type.
+        case invalid(reason: String)
+
+        /// No tool with the call's name is registered.
+        case toolNotFound
+    }
+
+    /// Scheduling options for a registered tool.
+    public struct ToolOptions: Sendable, Hashable {
+
+        /// Maximum concurrent calls to this tool, or `nil` for no per-tool limit.
+        public var maxConcurrentCalls: Int?
+
+        /// Whether calls with identical arguments always produce the same output.
+        ///
+        /// Identical calls to an idempotent tool within one batch run once and
+        /// share the output, each under its own call ID.
+        public var isIdempotent: Bool
+
+        /// How long an idempotent tool's outputs are reused for identical calls.
+        ///
+        /// `nil` disables the cache. Ignored unless ``isIdempotent`` is `true`.
+        public var resultCacheTTL: Duration?
+
+        /// Creates tool options.
+        ///
+        /// - Parameters:
+        ///   - maxConcurrentCalls: Per-tool concurrency limit. Clamped to at least 1. Default: `nil`
+        ///   - isIdempotent: Whether identical calls may share results. Default: `false`
+        ///   - resultCacheTTL: Result reuse window for idempotent tools. Default: `nil`
+        public init(
+            maxConcurrentCalls: Int? = nil,
+            isIdempotent: Bool = false,
+            resultCacheTTL: Duration? = nil
+        ) {
+            self.maxConcurrentCalls = maxConcurrentCalls.map { max(1, $0) }
+            self.isIdempotent = isIdempotent
+            self.resultCacheTTL = resultCacheTTL
+        }
+
+        /// No limits, no coalescing and no caching.
+        public static let `default` = ToolOptions()
+    }
+
     // MARK: - Properties
 
     /// Registered tools indexed by name.
     private var tools: [String: any Tool] = [:]
     private let missingToolPolicy: MissingToolPolicy
 
+    /// Scheduling options for tools registered with non-default options.
+    private var toolOptions: [String: ToolOptions] = [:]
+
+    /// Executor-wide concurrency limit, or `nil` for unlimited.
+    private var maxConcurrentCalls: Int?
+
+    private var activeCalls = 0
+    private var activeCallsByTool: [String: Int] = [:]
+
+    /// Calls waiting for a concurrency slot, in arrival order.
+    private var slotWaiters: [(toolName: String, continuation: CheckedContinuation<Void, Never>)] = []
+
+    private struct CachedOutput {
+        let arguments: GeneratedContent
+        let segments: [Transcript.Segment]
+        let expiresAt: ContinuousClock.Instant
+    }
+
+    /// Cached outputs of idempotent tools, by tool name.
+    private var outputCache: [String: [CachedOutput]] = [:]
+
+    /// Cached outputs kept per tool; the oldest is evicted beyond this.
+    private static let maxCachedOutputsPerTool = 64
+
     // MARK: - Initialization
 
     /// Creates an empty tool executor.
@@ -183,6 +304,39 @@ public actor ToolExecutor {
         tools[tool.name] = tool
     }
 
+    /// Registers a tool with scheduling options.
+    ///
+    /// - Parameters:
+    ///   - tool: The tool to register.
+    ///   - options: Concurrency, coalescing and caching behavior for the tool.
+    /// - Note: If a tool with the same name exists, it and its options are replaced.
+    public func register<T: Tool>(_ tool: T, options: ToolOptions) {
+        tools[tool.name] = tool
+        setOptions(options, forTool: tool.name)
+    }
+
+    /// Sets scheduling options for a tool by name.
+    ///
+    /// Changing options clears the tool's cached outputs.
+    ///
+    /// - Parameters:
+    ///   - options: Concurrency, coalescing and caching behavior.
+    ///   - name: The tool's name.
+    public func setOptions(_ options: ToolOptions, forTool name: String) {
+        toolOptions[name] = options == .default ? nil : options
+        outputCache[name] = nil
+        resumeRunnableWaiters()
+    }
+
+    /// Sets the executor-wide limit on concurrently running tool calls.
+    ///
+    /// - Parameter limit: Maximum running calls across all tools and batches,
+    ///   clamped to at least 1, or `nil` for no limit.
+    public func setMaxConcurrentCalls(_ limit: Int?) {
+        maxConcurrentCalls = limit.map { max(1, $0) }
+        resumeRunnableWaiters()
+    }
+
     /// Registers multiple tools for execution.
     ///
     /// - Parameter toolsToRegister: The tools to register.
@@ -198,7 +352,9 @@ public actor ToolExecutor {
     /// - Returns: `true` if the tool was found and removed.
     @discardableResult
     public func unregister(name: String) -> Bool {
-        tools.removeValue(forKey: name) != nil
+        toolOptions[name] = nil
+        outputCache[name] = nil
+        return tools.removeValue(forKey: name) != nil
     }
 
     /// Returns all registered tool names.
@@ -215,6 +371,47 @@ public actor ToolExecutor {
         }
     }
 
+    // MARK: - Speculative Validation
+
+    /// Validates the arguments of a tool call that may still be streaming.
+    ///
+    /// Providers attach incrementally parsed arguments to each ``PartialToolCall``
+    /// update, so this check costs one decode of the arguments received so far and
+    /// never re-parses JSON. Use it to reject bad calls, or to start prefetching
+    /// work for a call that already decodes, before the model reports
+    /// `finish_reason`.
+    ///
+    /// ```swift
+    /// for try await chunk in stream {
+    ///     if let partial = chunk.partialToolCall,
+    ///        await executor.validateArguments(of: partial) == .valid {
+    ///         prefetcher.warmUp(for: partial)
+    ///     }
+    /// }
+    /// ```
+    ///
+    /// - Parameter partialToolCall: The latest streaming update for a tool call.
+    /// - Returns: `.pending` while incomplete arguments do not decode yet,
+    ///   `.invalid` only once the arguments are complete.
+    public func validateArguments(of partialToolCall: PartialToolCall) -> ArgumentsValidation {
+        guard let tool = tools[partialToolCall.toolName] else {
+            return .toolNotFound
+        }
+        guard let arguments = partialToolCall.partialArguments else {
+            return partialToolCall.isArgumentsComplete
+                ? .invalid(reason: "Arguments are not valid JSON")
+                : .pending
+        }
+
+        do {
+            try tool.validate(arguments: arguments)
+            return .valid
+        } catch {
+            guard partialToolCall.isArgumentsComplete else { return .pending }
+            return .invalid(reason: error.localizedDescription)
+        }
+    }
+
     // MARK: - Execution
 
     /// Executes a tool call from the LLM without retries.
@@ -229,6 +426,10 @@ public actor ToolExecutor {
 
     /// Executes a tool call from the LLM with explicit retry behavior.
     ///
+    /// The call waits for a free slot under the executor and tool concurrency
+    /// limits, and holds it across retries. Outputs of idempotent tools with a
+    /// ``ToolOptions/resultCacheTTL`` are served from the cache when fresh.
+    ///
     /// - Parameters:
     ///   - toolCall: The tool call to execute.
     ///   - retryPolicy: Retry behavior for failures.
@@ -239,18 +440,37 @@ public actor ToolExecutor {
         toolCall: Transcript.ToolCall,
         retryPolicy: RetryPolicy
     ) async throws -> Transcript.ToolOutput {
+        let cacheTTL = cacheTTL(forTool: toolCall.toolName)
+        if cacheTTL != nil, let segments = cachedSegments(for: toolCall) {
+            return Transcript.ToolOutput(id: toolCall.id, toolName: toolCall.toolName, segments: segments)
+        }
+
+        await acquireSlot(forTool: toolCall.toolName)
+        defer { releaseSlot(forTool: toolCall.toolName) }
+
         var failedAttempt = 0
 
         while true {
             try Task.checkCancellation()
 
             do {
-                return try await executeSingleAttempt(toolCall: toolCall)
+                ConduitTelemetry.increment(.toolCalls, source: toolCall.toolName)
+                let output = try await ConduitTelemetry.measure(.toolExecution, source: toolCall.toolName) {
+                    try await executeSingleAttempt(toolCall: toolCall)
+                }
+                if let cacheTTL, tools[toolCall.toolName] != nil {
+                    storeCachedSegments(output.segments, for: toolCall, ttl: cacheTTL)
+                }
+                return output
             } catch {
+                ConduitTelemetry.increment(.toolFailures, source: toolCall.toolName)
                 failedAttempt += 1
                 guard retryPolicy.shouldRetry(after: error, failedAttempt: failedAttempt) else {
                     throw error
                 }
+                if let delay = retryPolicy.delay(afterFailedAttempt: failedAttempt) {
+                    try await Task.sleep(for: delay)
+                }
             }
         }
     }
@@ -288,6 +508,10 @@ public actor ToolExecutor {
 
     /// Executes multiple tool calls concurrently with explicit retry behavior.
     ///
+    /// Identical calls to idempotent tools run once. Each output is placed
+    /// as soon as its call finishes; use ``outputs(for:retryPolicy:)`` to
+    /// handle outputs in completion order instead.
+    ///
     /// - Parameters:
     ///   - toolCalls: The tool calls to execute.
     ///   - retryPolicy: Retry behavior for each individual tool call.
@@ -300,27 +524,179 @@ public actor ToolExecutor {
         try Task.checkCancellation()
         guard !toolCalls.isEmpty else { return [] }
 
-        return try await withThrowingTaskGroup(of: (Int, Transcript.ToolOutput).self) { group in
-            for (index, toolCall) in toolCalls.enumerated() {
+        var outputs = [Transcript.ToolOutput?](repeating: nil, count: toolCalls.count)
+        try await executeBatch(toolCalls, retryPolicy: retryPolicy) { index, output in
+            outputs[index] = output
+        }
+        return outputs.compactMap { $0 }
+    }
+
+    /// Executes multiple tool calls concurrently, yielding each output as it finishes.
+    ///
+    /// Outputs arrive in completion order; match them to calls by ``Transcript/ToolOutput/id``.
+    /// The stream throws the first tool failure and cancels the remaining
+    /// calls. Terminating the stream early also cancels them.
+    ///
+    /// - Parameters:
+    ///   - toolCalls: The tool calls to execute.
+    ///   - retryPolicy: Retry behavior for each individual tool call.
+    /// - Returns: A stream of outputs, one per tool call.
+    public func outputs(
+        for toolCalls: [Transcript.ToolCall],
+        retryPolicy: RetryPolicy = .none
+    ) -> AsyncThrowingStream<Transcript.ToolOutput, Error> {
+        let (stream, continuation) = AsyncThrowingStream.makeStream(of: Transcript.ToolOutput.self)
+        let task = Task {
+            do {
+                try await self.executeBatch(toolCalls, retryPolicy: retryPolicy) { _, output in
+                    continuation.yield(output)
+                }
+                continuation.finish()
+            } catch {
+                continuation.finish(throwing: error)
+            }
+        }
+        continuation.onTermination = { _ in task.cancel() }
+        return stream
+    }
+
+    // MARK: - Batch Scheduling
+
+    /// Runs `toolCalls` concurrently, reporting each output with its call's index.
+    ///
+    /// Identical calls to idempotent tools are coalesced into one execution
+    /// whose output is reported once per call, under each call's ID.
+    private func executeBatch(
+        _ toolCalls: [Transcript.ToolCall],
+        retryPolicy: RetryPolicy,
+        onOutput: (_ index: Int, _ output: Transcript.ToolOutput) -> Void
+    ) async throws {
+        try Task.checkCancellation()
+
+        // Group call indices so that each group runs once
+        var groups: [[Int]] = []
+        for (index, toolCall) in toolCalls.enumerated() {
+            if toolOptions[toolCall.toolName]?.isIdempotent == true,
+               let group = groups.firstIndex(where: { members in
+                   let representative = toolCalls[members[0]]
+                   return representative.toolName == toolCall.toolName
+                       && representative.arguments == toolCall.arguments
+               }) {
+                groups[group].append(index)
+            } else {
+                groups.append([index])
+            }
+        }
+
+        try await withThrowingTaskGroup(of: (Int, Transcript.ToolOutput).self) { group in
+            for (groupIndex, members) in groups.enumerated() {
                 try Task.checkCancellation()
 
+                let toolCall = toolCalls[members[0]]
                 group.addTask { [self] in
                     let output = try await self.execute(
                         toolCall: toolCall,
                         retryPolicy: retryPolicy
                     )
-                    return (index, output)
+                    return (groupIndex, output)
                 }
             }
 
-            var results: [(Int, Transcript.ToolOutput)] = []
-            results.reserveCapacity(toolCalls.count)
+            for try await (groupIndex, output) in group {
+                for index in groups[groupIndex] {
+                    var shared = output
+                    shared.id = toolCalls[index].id
+                    onOutput(index, shared)
+                }
+            }
+        }
+    }
+
+    // MARK: - Concurrency Limits
+
+    private func canStart(toolName: String) -> Bool {
+        if let maxConcurrentCalls, activeCalls >= maxConcurrentCalls {
+            return false
+        }
+        if let toolLimit = toolOptions[toolName]?.maxConcurrentCalls,
+           activeCallsByTool[toolName, default: 0] >= toolLimit {
+            return false
+        }
+        return true
+    }
+
+    private func markStarted(toolName: String) {
+        activeCalls += 1
+        activeCallsByTool[toolName, default: 0] += 1
+    }
 
-            for try await result in group {
-                results.append(result)
+    /// Waits until a call to `toolName` fits under the concurrency limits, then claims the slot.
+    private func acquireSlot(forTool toolName: String) async {
+        // Waiters are only ever blocked by a full limit, so a call that fits can start ahead of them
+        if canStart(toolName: toolName) {
+            markStarted(toolName: toolName)
+            return
+        }
+        // The slot is claimed on this call's behalf before it is resumed
+        await withCheckedContinuation { continuation in
+            slotWaiters.append((toolName, continuation))
+        }
+    }
+
+    private func releaseSlot(forTool toolName: String) {
+        activeCalls -= 1
+        activeCallsByTool[toolName, default: 1] -= 1
+        if activeCallsByTool[toolName] == 0 {
+            activeCallsByTool[toolName] = nil
+        }
+        resumeRunnableWaiters()
+    }
+
+    /// Starts waiting calls, oldest first, skipping calls blocked only by their tool's limit.
+    private func resumeRunnableWaiters() {
+        var index = 0
+        while index < slotWaiters.count {
+            let waiter = slotWaiters[index]
+            if canStart(toolName: waiter.toolName) {
+                slotWaiters.remove(at: index)
+                markStarted(toolName: waiter.toolName)
+                waiter.continuation.resume()
+            } else if maxConcurrentCalls.map({ activeCalls >= $0 }) ?? false {
+                return
+            } else {
+                index += 1
             }
+        }
+    }
+
+    // MARK: - Output Cache
+
+    private func cacheTTL(forTool toolName: String) -> Duration? {
+        guard let options = toolOptions[toolName], options.isIdempotent else { return nil }
+        return options.resultCacheTTL
+    }
+
+    private func cachedSegments(for toolCall: Transcript.ToolCall) -> [Transcript.Segment]? {
+        let now = ContinuousClock.now
+        outputCache[toolCall.toolName]?.removeAll { $0.expiresAt <= now }
+        return outputCache[toolCall.toolName]?.first { $0.arguments == toolCall.arguments }?.segments
+    }
 
-            return results.sorted { $0.0 < $1.0 }.map { $0.1 }
+    private func storeCachedSegments(
+        _ segments: [Transcript.Segment],
+        for toolCall: Transcript.ToolCall,
+        ttl: Duration
+    ) {
+        var entries = outputCache[toolCall.toolName] ?? []
+        entries.removeAll { $0.arguments == toolCall.arguments }
+        entries.append(CachedOutput(
+            arguments: toolCall.arguments,
+            segments: segments,
+            expiresAt: ContinuousClock.now.advanced(by: ttl)
+        ))
+        if entries.count > Self.maxCachedOutputsPerTool {
+            entries.removeFirst(entries.count - Self.maxCachedOutputsPerTool)
         }
+        outputCache[toolCall.toolName] = entries
     }
 }
@@ -0,0 +1,184 @@
+// EmbeddingBatchPolicy.swift
+// Conduit
+
+import Foundation
+
+/// Limits used when splitting an embedding batch into provider requests.
+///
+/// Cloud embedding endpoints accept many inputs per request, but cap the
+/// number of inputs and the total tokens in each request. Providers split
+/// a batch with ``chunks(for:)``, which keeps input order and fills each
+/// request up to whichever limit is reached first. Chunks are then sent
+/// with at most ``maxConcurrentRequests`` in flight.
+///
+/// ## Usage
+/// ```swift
+/// var config = OpenAIConfiguration.openAI(apiKey: "sk-...")
+/// config.embeddingBatchPolicy = EmbeddingBatchPolicy(maxInputsPerRequest: 512, maxConcurrentRequests: 8)
+///
+/// let provider = OpenAIProvider(configuration: config)
+/// let matrix = try await provider.embedMatrix(documents, model: .textEmbedding3Small)
+/// ```
+public struct EmbeddingBatchPolicy: Sendable, Hashable, Codable {
+
+    /// Maximum number of texts sent in a single request.
+    public var maxInputsPerRequest: Int
+
+    /// Maximum estimated tokens across all texts in a single request.
+    ///
+    /// `nil` disables token budgeting. A single text above the budget is
+    /// still sent on its own so the provider can report the error.
+    public var maxTokensPerRequest: Int?
+
+    /// Maximum number of requests in flight at once.
+    public var maxConcurrentRequests: Int
+
+    /// Creates a batching policy.
+    ///
+    /// - Parameters:
+    ///   - maxInputsPerRequest: Texts per request. Clamped to at least 1.
+    ///   - maxTokensPerRequest: Estimated tokens per request, or `nil` for no budget.
+    ///   - maxConcurrentRequests: Requests in flight. Clamped to at least 1.
+    public init(
+        maxInputsPerRequest: Int,
+        maxTokensPerRequest: Int? = nil,
+        maxConcurrentRequests: Int = 4
+    ) {
+        self.maxInputsPerRequest = max(1, maxInputsPerRequest)
+        self.maxTokensPerRequest = maxTokensPerRequest.map { max(1, $0) }
+        self.maxConcurrentRequests = max(1, maxConcurrentRequests)
+    }
+
+    // MARK: - Static Presets
+
+    /// OpenAI `/v1/embeddings` limits: 2048 inputs and 300K tokens per request.
+    public static let openAI = EmbeddingBatchPolicy(
+        maxInputsPerRequest: 2048,
+        maxTokensPerRequest: 300_000,
+        maxConcurrentRequests: 4
+    )
+
+    /// Conservative limits for HuggingFace feature-extraction endpoints.
+    public static let huggingFace = EmbeddingBatchPolicy(
+        maxInputsPerRequest: 32,
+        maxConcurrentRequests: 4
+    )
+
+    // MARK: - Chunking
+
+    /// Estimate of the tokens in `text`, at about four characters per token.
+    ///
+    /// Rounds up so token budgets leave headroom for denser tokenization.
+    public static func estimatedTokens(in text: String) -> Int {
+        max(1, (text.utf8.count + 3) / 4)
+    }
+
+    /// Splits `texts` into consecutive index ranges that respect this policy.
+    ///
+    /// - Parameter texts: The batch to split.
+    /// - Returns: Non-empty ranges covering every index of `texts` in order.
+    public func chunks(for texts: [String]) -> [Range<Int>] {
+        var chunks: [Range<Int>] = []
+        var start = 0
+        var tokens = 0
+
+        for (index, text) in texts.enumerated() {
+            let textTokens = Self.estimatedTokens(in: text)
+            let isFull = index - start >= maxInputsPerRequest
+            let overBudget = maxTokensPerRequest.map { tokens + textTokens > $0 } ?? false
+
+            if index > start, isFull || overBudget {
+                chunks.append(start..<index)
+                start = index
+                tokens = 0
+            }
+            tokens += textTokens
+        }
+
+        if start < texts.count {
+            chunks.append(start..<texts.count)
+        }
+        return chunks
+    }
+
+    // MARK: - Execution
+
+    /// Embeds `texts` chunk by chunk and assembles one contiguous matrix.
+    ///
+    /// - Parameters:
+    ///   - texts: The texts to embed.
+    ///   - model: Model name recorded on the matrix.
+    ///   - embedChunk: Embeds one chunk, returning one vector per input in
+    ///     order and the provider-reported token count, if any.
+    /// - Returns: Embeddings for every text, in input order.
+    /// - Throws: Errors from `embedChunk`, or `AIError.generationFailed` when
+    ///   a chunk returns the wrong number of vectors or mismatched dimensions.
+    internal func embedMatrix(
+        _ texts: [String],
+        model: String,
+        embedChunk: @escaping @Sendable ([String]) async throws -> (vectors: [[Float]], tokenCount: Int?)
+    ) async throws -> EmbeddingMatrix {
+        let ranges = chunks(for: texts)
+        guard !ranges.isEmpty else {
+            return EmbeddingMatrix(storage: [], dimensions: 0, texts: [], model: model)
+        }
+
+        let chunkResults = try await withThrowingTaskGroup(
+            of: (Int, [[Float]], Int?).self
+        ) { group -> [([[Float]], Int?)] in
+            var results = [([[Float]], Int?)?](repeating: nil, count: ranges.count)
+            var nextChunk = 0
+            var inFlight = 0
+
+            // Keep at most maxConcurrentRequests chunks in flight
+            while nextChunk < ranges.count || inFlight > 0 {
+                while nextChunk < ranges.count, inFlight < maxConcurrentRequests {
+                    let chunkIndex = nextChunk
+                    let inputs = Array(texts[ranges[chunkIndex]])
+                    group.addTask {
+                        let embedded = try await embedChunk(inputs)
+                        return (chunkIndex, embedded.vectors, embedded.tokenCount)
+                    }
+                    nextChunk += 1
+                    inFlight += 1
+                }
+
+                guard let completed = try await group.next() else { break }
+                let (chunkIndex, vectors, tokenCount) = completed
+                inFlight -= 1
+                guard vectors.count == ranges[chunkIndex].count else {
+                    throw AIError.generationFailed(underlying: SendableError(
+                        localizedDescription: "Expected \(ranges[chunkIndex].count) embeddings, "
+                            + "received \(vectors.count)"
+                    ))
+                }
+                results[chunkIndex] = (vectors, tokenCount)
+            }
+            return results.compactMap { $0 }
+        }
+
+        let dimensions = chunkResults.first?.0.first?.count ?? 0
+        var storage: [Float] = []
+        storage.reserveCapacity(texts.count * dimensions)
+        for (vectors, _) in chunkResults {
+            for vector in vectors {
+                guard vector.count == dimensions else {
+                    throw AIError.generationFailed(underlying: SendableError(
+                        localizedDescription: "Embedding dimensions differ within batch "
+                            + "(\(vector.count) vs \(dimensions))"
+                    ))
+                }
+                storage.append(contentsOf: vector)
+            }
+        }
+
+        let tokenCounts = chunkResults.compactMap(\.1)
+        return EmbeddingMatrix(
+            storage: storage,
+            dimensions: dimensions,
+            texts: texts,
+            model: model,
+            tokenCount: tokenCounts.count == chunkResults.count ? tokenCounts.reduce(0, +) : nil
+        )
+    }
+}
@@ -0,0 +1,125 @@
+// EmbeddingMatrix.swift
+// Conduit
+
+import Foundation
+
+/// Embeddings for a batch of texts stored in one contiguous buffer.
+///
+/// Row `i` holds the embedding of `texts[i]`. All rows share one
+/// `[Float]` allocation in row-major order instead of one array per text,
+/// so large batches can go straight into vector stores or BLAS routines
+/// without further copies.
+///
+/// ## Usage
+/// ```swift
+/// let matrix = try await provider.embedMatrix(documents, model: .textEmbedding3Small)
+/// print("\(matrix.count) rows x \(matrix.dimensions) dims")
+///
+/// for row in matrix {
+///     index.insert(row)  // ArraySlice<Float> view, no copy
+/// }
+///
+/// matrix.storage.withUnsafeBufferPointer { buffer in
+///     upload(buffer)     // All rows, back to back
+/// }
+/// ```
+public struct EmbeddingMatrix: Sendable, Hashable, RandomAccessCollection {
+
+    /// All embedding values in row-major order.
+    public let storage: [Float]
+
+    /// Number of values in each row.
+    public let dimensions: Int
+
+    /// The texts that were embedded, one per row.
+    public let texts: [String]
+
+    /// The model used to generate the embeddings.
+    public let model: String
+
+    /// Total input tokens reported by the provider for the batch, if available.
+    public let tokenCount: Int?
+
+    /// Creates an embedding matrix.
+    ///
+    /// - Parameters:
+    ///   - storage: Row-major embedding values. Must have
+    ///     `texts.count * dimensions` elements.
+    ///   - dimensions: Number of values in each row.
+    ///   - texts: The embedded texts, one per row.
+    ///   - model: The model used for embedding.
+    ///   - tokenCount: Optional total token count of the inputs.
+    public init(
+        storage: [Float],
+        dimensions: Int,
+        texts: [String],
+        model: String,
+        tokenCount: Int? = nil
+    ) {
+        precondition(
+            storage.count == texts.count * dimensions,
+            "EmbeddingMatrix storage must hold texts.count * dimensions values"
+        )
+        self.storage = storage
+        self.dimensions = dimensions
+        self.texts = texts
+        self.model = model
+        self.tokenCount = tokenCount
+    }
+
+    /// Creates a matrix by copying individual embedding results.
+    ///
+    /// - Parameter results: Results with equal dimensions, all from the same model.
+    /// - Throws: `AIError.generationFailed` if the results have different dimensions.
+    public init(_ results: [EmbeddingResult]) throws {
+        let dimensions = results.first?.dimensions ?? 0
+        var storage: [Float] = []
+        storage.reserveCapacity(results.count * dimensions)
+
+        for result in results {
+            guard result.dimensions == dimensions else {
+                throw AIError.generationFailed(underlying: SendableError(
+                    localizedDescription: "Embedding dimensions differ within batch "
+                        + "(\(result.dimensions) vs \(dimensions))"
+                ))
+            }
+            storage.append(contentsOf: result.vector)
+        }
+
+        let tokenCounts = results.compactMap(\.tokenCount)
+        self.init(
+            storage: storage,
+            dimensions: dimensions,
+            texts: results.map(\.text),
+            model: results.first?.model ?? "",
+            tokenCount: tokenCounts.isEmpty ? nil : tokenCounts.reduce(0, +)
+        )
+    }
+
+    // MARK: - RandomAccessCollection
+
+    public var startIndex: Int { 0 }
+
+    public var endIndex: Int { texts.count }
+
+    /// A view of the embedding at `row`, sharing this matrix's storage.
+    public subscript(row: Int) -> ArraySlice<Float> {
+        let start = row * dimensions
+        return storage[start..<(start + dimensions)]
+    }
+
+    // MARK: - Results
+
+    /// The embedding at `row` as a standalone result.
+    ///
+    /// Copies the row into its own array. Prefer the subscript when a view
+    /// is enough.
+    public func result(at row: Int) -> EmbeddingResult {
+        EmbeddingResult(vector: Array(self[row]), text: texts[row], model: model)
+    }
+
+    /// Every row as a standalone ``EmbeddingResult``.
+    public var results: [EmbeddingResult] {
+        indices.map(result(at:))
+    }
+}
@@ -68,7 +68,7 @@ public struct GenerationSchema: Sendable, Codable, CustomDebugStringConvertible
                     }
                     try propsContainer.encode(node, forKey: key)
                 }
-                try container.encode(Array(obj.required), forKey: .required)
+                try container.encode(obj.required.sorted(), forKey: .required)
 
                 // Check userInfo to see if additionalProperties should be omitted
                 let shouldOmit = encoder.userInfo[GenerationSchema.omitAdditionalPropertiesKey] as? Bool ?? false
@@ -234,6 +234,14 @@ public struct GenerationSchema: Sendable, Codable, CustomDebugStringConvertible
     let root: Node
     private var defs: [String: Node]
 
+    /// JSON forms of this schema, encoded on first use and shared by copies.
+    let encodings = GenerationSchemaEncodings()
+
+    /// The node a `$ref` name resolves to, if it is defined.
+    func definition(named name: String) -> Node? {
+        defs[name]
+    }
+
     /// A string representation of the debug description.
     ///
     /// This string is not localized and is not appropriate for display to end users.
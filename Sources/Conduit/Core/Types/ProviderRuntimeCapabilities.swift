@@ -565,13 +565,20 @@ public struct ProviderRuntimeFeatureConfiguration: Sendable, Hashable, Codable {
         public var rollbackTokenBudgetPerTurn: Int?
         public var autoDisableDivergenceRate: Double?
 
+        /// Draft model that proposes tokens for the target model to verify.
+        ///
+        /// A Hugging Face repo ID or local directory for MLX, a GGUF path for
+        /// llama.cpp. The draft must share the target's tokenizer.
+        public var draftModel: String?
+
         public init(
             enabled: Bool? = nil,
             draftStreamCount: Int? = nil,
             draftAheadTokens: Int? = nil,
             verificationBatchTokens: Int? = nil,
             rollbackTokenBudgetPerTurn: Int? = nil,
-            autoDisableDivergenceRate: Double? = nil
+            autoDisableDivergenceRate: Double? = nil,
+            draftModel: String? = nil
         ) {
             self.enabled = enabled
             self.draftStreamCount = draftStreamCount
@@ -579,6 +586,7 @@ public struct ProviderRuntimeFeatureConfiguration: Sendable, Hashable, Codable {
             self.verificationBatchTokens = verificationBatchTokens
             self.rollbackTokenBudgetPerTurn = rollbackTokenBudgetPerTurn
             self.autoDisableDivergenceRate = autoDisableDivergenceRate
+            self.draftModel = draftModel
         }
     }
 
@@ -611,6 +619,9 @@ public enum ProviderRuntimeDiagnosticsEventKind: String, Sendable, Codable {
     case capabilityDenied = "capability_denied"
     case fallbackUsed = "fallback_used"
     case autoDisabled = "auto_disabled"
+    case prefixCacheHit = "prefix_cache_hit"
+    case prefixCacheMiss = "prefix_cache_miss"
+    case speculativeDecoding = "speculative_decoding"
 }
 
 /// Structured runtime diagnostics event for observability and conformance logs.
@@ -638,3 +649,41 @@ public struct ProviderRuntimeDiagnosticsEvent: Sendable, Equatable, Codable {
         self.details = details
     }
 }
+
+/// Aggregate prompt-prefix (KV cache) reuse counters for a provider runtime.
+public struct ProviderRuntimePrefixCacheStatistics: Sendable, Hashable, Codable {
+    /// Requests that reused at least one cached prompt token.
+    public var hits: Int
+
+    /// Requests that prefilled the whole prompt.
+    public var misses: Int
+
+    /// Prompt tokens served from the KV cache instead of being decoded.
+    public var reusedTokens: Int
+
+    /// Prompt tokens decoded during prefill.
+    public var prefilledTokens: Int
+
+    /// Cached tokens evicted because the prompt diverged from the cache.
+    public var evictedTokens: Int
+
+    /// Fraction of requests that were cache hits, or `0` before any request.
+    public var hitRate: Double {
+        let total = hits + misses
+        return total > 0 ? Double(hits) / Double(total) : 0
+    }
+
+    public init(
+        hits: Int = 0,
+        misses: Int = 0,
+        reusedTokens: Int = 0,
+        prefilledTokens: Int = 0,
+        evictedTokens: Int = 0
+    ) {
+        self.hits = hits
+        self.misses = misses
+        self.reusedTokens = reusedTokens
+        self.prefilledTokens = prefilledTokens
+        self.evictedTokens = evictedTokens
+    }
+}
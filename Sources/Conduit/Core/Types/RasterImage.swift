@@ -0,0 +1,125 @@
+// RasterImage.swift
+// Conduit
+
+import Foundation
+
+#if canImport(CoreGraphics)
+import CoreGraphics
+#endif
+
+#if canImport(ImageIO)
+import ImageIO
+#endif
+
+/// Uncompressed 8-bit RGB pixels produced by a local image generator.
+///
+/// Local generators decode images into memory the CPU can read directly on
+/// Apple Silicon. A `RasterImage` hands those pixels out without encoding
+/// them, for callers that display, post-process, or upload images in their
+/// own format. Use ``cgImage`` to draw the pixels, or ``pngData()`` when a
+/// file format is needed after all.
+///
+/// ```swift
+/// let rasters = try await provider.generateRasterImages(
+///     prompt: "A lighthouse at dawn",
+///     count: 4
+/// )
+/// imageView.image = rasters.first?.cgImage.map { UIImage(cgImage: $0) }
+/// ```
+///
+/// Pixels are stored row by row with no alpha channel. Rows may be padded,
+/// so index them with ``bytesPerRow`` rather than `width * 3`.
+public struct RasterImage: Sendable {
+
+    /// Bytes per pixel: one each for red, green, and blue.
+    public static let bytesPerPixel = 3
+
+    /// Width in pixels.
+    public let width: Int
+
+    /// Height in pixels.
+    public let height: Int
+
+    /// Bytes from the start of one row to the start of the next.
+    public let bytesPerRow: Int
+
+    /// The RGB pixel bytes.
+    ///
+    /// The storage may be shared with the generator's output buffer, so
+    /// reading it does not copy the image.
+    public let pixels: Data
+
+    /// Creates a raster image from RGB pixel bytes.
+    ///
+    /// - Parameters:
+    ///   - width: Width in pixels.
+    ///   - height: Height in pixels.
+    ///   - bytesPerRow: Row stride in bytes. Default: `width * 3`
+    ///   - pixels: At least `bytesPerRow * height` bytes of RGB pixels.
+    public init(width: Int, height: Int, bytesPerRow: Int? = nil, pixels: Data) {
+        let bytesPerRow = bytesPerRow ?? width * Self.bytesPerPixel
+        precondition(width > 0 && height > 0, "RasterImage dimensions must be positive")
+        precondition(bytesPerRow >= width * Self.bytesPerPixel, "bytesPerRow is smaller than one row of pixels")
+        precondition(pixels.count >= bytesPerRow * height, "RasterImage pixel data is shorter than its dimensions")
+        self.width = width
+        self.height = height
+        self.bytesPerRow = bytesPerRow
+        self.pixels = pixels
+    }
+
+    // MARK: - CoreGraphics
+
+    #if canImport(CoreGraphics)
+    /// The pixels as a `CGImage` that shares their storage.
+    ///
+    /// Returns `nil` if CoreGraphics cannot describe the buffer.
+    public var cgImage: CGImage? {
+        guard let provider = CGDataProvider(data: pixels as CFData) else { return nil }
+        return CGImage(
+            width: width,
+            height: height,
+            bitsPerComponent: 8,
+            bitsPerPixel: 8 * Self.bytesPerPixel,
+            bytesPerRow: bytesPerRow,
+            space: CGColorSpaceCreateDeviceRGB(),
+            bitmapInfo: CGBitmapInfo(rawValue: CGImageAlphaInfo.none.rawValue),
+            provider: provider,
+            decode: nil,
+            shouldInterpolate: true,
+            intent: .defaultIntent
+        )
+    }
+    #endif
+
+    // MARK: - Encoding
+
+    /// Encodes the pixels as PNG.
+    ///
+    /// - Throws: `GeneratedImageError.invalidImageData` if the pixels cannot
+    ///   be encoded, including on platforms without ImageIO.
+    public func pngData() throws -> Data {
+        #if canImport(ImageIO) && canImport(CoreGraphics)
+        let output = NSMutableData()
+        guard let image = cgImage,
+              let destination = CGImageDestinationCreateWithData(output, "public.png" as CFString, 1, nil)
+        else {
+            throw GeneratedImageError.invalidImageData
+        }
+        CGImageDestinationAddImage(destination, image, nil)
+        guard CGImageDestinationFinalize(destination) else {
+            throw GeneratedImageError.invalidImageData
+        }
+        return output as Data
+        #else
+        throw GeneratedImageError.invalidImageData
+        #endif
+    }
+
+    /// The pixels encoded as a PNG ``GeneratedImage``.
+    ///
+    /// - Parameter metadata: Metadata to attach to the image.
+    /// - Throws: `GeneratedImageError.invalidImageData` if encoding fails.
+    public func generatedImage(metadata: ImageGenerationMetadata? = nil) throws -> GeneratedImage {
+        GeneratedImage(data: try pngData(), format: .png, metadata: metadata)
+    }
+}
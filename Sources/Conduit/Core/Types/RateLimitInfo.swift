@@ -7,6 +7,10 @@
 
 import Foundation
 
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
 /// Rate limiting information extracted from API response headers.
 ///
 /// Anthropic provides detailed rate limit headers that help clients
@@ -33,6 +37,10 @@ import Foundation
 /// - `anthropic-ratelimit-requests-reset`: Reset time for requests
 /// - `anthropic-ratelimit-tokens-reset`: Reset time for tokens
 /// - `retry-after`: Wait time for 429 errors
+///
+/// OpenAI-style `x-ratelimit-*` headers are read when the Anthropic ones are
+/// absent. Their reset values are durations such as `6m0s`, converted to
+/// timestamps relative to when the headers were parsed.
 public struct RateLimitInfo: Sendable, Hashable, Codable {
 
     // MARK: - Request Identification
@@ -83,14 +91,20 @@ public struct RateLimitInfo: Sendable, Hashable, Codable {
             result[pair.key.lowercased()] = pair.value
         }
 
-        self.requestId = normalizedHeaders["request-id"]
+        // Anthropic headers first, then OpenAI-style x-ratelimit-* headers
+        func integer(_ anthropic: String, _ openAI: String) -> Int? {
+            (normalizedHeaders[anthropic] ?? normalizedHeaders[openAI]).flatMap(Int.init)
+        }
+
+        self.requestId = normalizedHeaders["request-id"] ?? normalizedHeaders["x-request-id"]
         self.organizationId = normalizedHeaders["anthropic-organization-id"]
+            ?? normalizedHeaders["openai-organization"]
 
-        self.limitRequests = normalizedHeaders["anthropic-ratelimit-requests-limit"].flatMap(Int.init)
-        self.limitTokens = normalizedHeaders["anthropic-ratelimit-tokens-limit"].flatMap(Int.init)
+        self.limitRequests = integer("anthropic-ratelimit-requests-limit", "x-ratelimit-limit-requests")
+        self.limitTokens = integer("anthropic-ratelimit-tokens-limit", "x-ratelimit-limit-tokens")
 
-        self.remainingRequests = normalizedHeaders["anthropic-ratelimit-requests-remaining"].flatMap(Int.init)
-        self.remainingTokens = normalizedHeaders["anthropic-ratelimit-tokens-remaining"].flatMap(Int.init)
+        self.remainingRequests = integer("anthropic-ratelimit-requests-remaining", "x-ratelimit-remaining-requests")
+        self.remainingTokens = integer("anthropic-ratelimit-tokens-remaining", "x-ratelimit-remaining-tokens")
 
         // Parse RFC 3339 timestamps with fractional seconds support
         let formatterWithFractional = ISO8601DateFormatter()
@@ -105,10 +119,62 @@ public struct RateLimitInfo: Sendable, Hashable, Codable {
             return formatterWithFractional.date(from: value) ?? formatterWithoutFractional.date(from: value)
         }
 
+        let now = Date()
         self.resetRequests = parseDate(normalizedHeaders["anthropic-ratelimit-requests-reset"])
+            ?? normalizedHeaders["x-ratelimit-reset-requests"].flatMap(Self.parseDuration).map(now.addingTimeInterval)
         self.resetTokens = parseDate(normalizedHeaders["anthropic-ratelimit-tokens-reset"])
+            ?? normalizedHeaders["x-ratelimit-reset-tokens"].flatMap(Self.parseDuration).map(now.addingTimeInterval)
 
         self.retryAfter = normalizedHeaders["retry-after"].flatMap(TimeInterval.init)
+            ?? normalizedHeaders["retry-after-ms"].flatMap(TimeInterval.init).map { $0 / 1000 }
+    }
+
+    /// Initialize from the headers of an HTTP response.
+    ///
+    /// - Parameter response: The HTTP response to read.
+    public init(response: HTTPURLResponse) {
+        let headers = response.allHeaderFields.reduce(into: [String: String]()) { result, pair in
+            if let key = pair.key as? String, let value = pair.value as? String {
+                result[key] = value
+            }
+        }
+        self.init(headers: headers)
+    }
+
+    /// Parses a Go-style duration such as `1s`, `20ms` or `6m0.5s` into seconds.
+    internal static func parseDuration(_ value: String) -> TimeInterval? {
+        if let seconds = TimeInterval(value) {
+            return seconds
+        }
+
+        var total: TimeInterval = 0
+        var number = ""
+        var index = value.startIndex
+        while index < value.endIndex {
+            let character = value[index]
+            if character.isNumber || character == "." {
+                number.append(character)
+                index = value.index(after: index)
+                continue
+            }
+
+            var unit = String(character)
+            index = value.index(after: index)
+            if unit == "m", index < value.endIndex, value[index] == "s" {
+                unit = "ms"
+                index = value.index(after: index)
+            }
+            guard let amount = TimeInterval(number) else { return nil }
+            switch unit {
+            case "h": total += amount * 3600
+            case "m": total += amount * 60
+            case "s": total += amount
+            case "ms": total += amount / 1000
+            default: return nil
+            }
+            number = ""
+        }
+        return number.isEmpty ? total : nil
     }
 
     /// Initialize with explicit values.
@@ -0,0 +1,223 @@
+// SpeculativeDecoding.swift
+// Conduit
+//
+// Provider-agnostic draft/verify bookkeeping for speculative decoding.
+
+import Foundation
+
+// MARK: - Statistics
+
+/// Counters for one speculative decoding turn.
+internal struct SpeculativeDecodingStatistics: Sendable, Hashable {
+    /// Verification passes that carried at least one draft token.
+    var rounds = 0
+
+    /// Tokens proposed by the draft model.
+    var draftedTokens = 0
+
+    /// Draft tokens the target model accepted.
+    var acceptedTokens = 0
+
+    /// Tokens emitted by the target, including tokens decoded without a draft.
+    var emittedTokens = 0
+
+    /// Rejected draft tokens whose KV entries were rolled back.
+    var rollbackTokens: Int {
+        draftedTokens - acceptedTokens
+    }
+
+    /// Fraction of draft tokens accepted, or `0` before any draft.
+    var acceptRate: Double {
+        draftedTokens > 0 ? Double(acceptedTokens) / Double(draftedTokens) : 0
+    }
+
+    /// Fraction of draft tokens rejected, or `0` before any draft.
+    var divergenceRate: Double {
+        draftedTokens > 0 ? 1 - acceptRate : 0
+    }
+}
+
+// MARK: - Controller
+
+/// Draft sizing, verification and auto-disable policy for speculative decoding.
+///
+/// A provider engine drives one controller per turn:
+///
+/// 1. ask ``draftLength(remainingTokens:)`` how many tokens the draft model
+///    should propose,
+/// 2. run the target once over the last emitted token plus the draft and
+///    ``verify(draft:sampleTarget:)`` the proposals against it,
+/// 3. roll back the KV caches past the accepted prefix and report the round
+///    with ``recordRound(draftedTokens:acceptedTokens:)``.
+///
+/// Verification samples the target's own token at each draft position and
+/// stops at the first mismatch, so every emitted token is drawn from the target
+/// distribution: output matches plain decoding, only latency changes. Drafting
+/// stops for the rest of the turn when the rollback budget or divergence
+/// threshold from ``ProviderRuntimeFeatureConfiguration/SpeculativeScheduling``
+/// is exceeded; a zero-length draft degenerates to ordinary one-token decoding.
+///
+/// ## Usage
+///
+/// ```swift
+/// var controller = SpeculativeDecodingController(
+///     configuration: features.speculativeScheduling,
+///     maximumDraftAheadTokens: 64,
+///     maximumBatchTokens: 512
+/// )
+/// let draft = proposeDraft(count: controller.draftLength(remainingTokens: remaining))
+/// let emitted = SpeculativeDecodingController.verify(draft: draft) { position in
+///     sampleTarget(at: position)
+/// }
+/// controller.recordRound(draftedTokens: draft.count, acceptedTokens: emitted.count - 1)
+/// ```
+internal struct SpeculativeDecodingController: Sendable {
+
+    /// Draft length used when the request does not set `draftAheadTokens`.
+    static let defaultDraftAheadTokens = 4
+
+    /// Rounds observed before the divergence rate may disable drafting.
+    static let minimumRoundsBeforeAutoDisable = 4
+
+    /// Maximum tokens proposed per round.
+    let draftAheadTokens: Int
+
+    /// Rejected draft tokens tolerated per turn, if limited.
+    let rollbackTokenBudget: Int?
+
+    /// Divergence rate above which drafting stops, if set.
+    let autoDisableDivergenceRate: Double?
+
+    /// Counters for the current turn.
+    private(set) var statistics = SpeculativeDecodingStatistics()
+
+    /// Why drafting stopped, or `nil` while drafting.
+    private(set) var disabledReason: String?
+
+    /// Whether the next round should draft tokens.
+    var isDrafting: Bool {
+        disabledReason == nil
+    }
+
+    // MARK: - Initialization
+
+    /// Creates a controller for one turn.
+    ///
+    /// - Parameters:
+    ///   - configuration: Per-request speculative scheduling controls.
+    ///   - maximumDraftAheadTokens: The provider's draft-ahead capability.
+    ///   - maximumBatchTokens: Tokens the target can verify in one pass,
+    ///     including the last emitted token.
+    init(
+        configuration: ProviderRuntimeFeatureConfiguration.SpeculativeScheduling,
+        maximumDraftAheadTokens: Int,
+        maximumBatchTokens: Int
+    ) {
+        var draftAhead = configuration.draftAheadTokens ?? Self.defaultDraftAheadTokens
+        if let verificationBatchTokens = configuration.verificationBatchTokens {
+            draftAhead = min(draftAhead, verificationBatchTokens - 1)
+        }
+        draftAhead = min(draftAhead, maximumDraftAheadTokens, maximumBatchTokens - 1)
+
+        self.draftAheadTokens = max(0, draftAhead)
+        self.rollbackTokenBudget = configuration.rollbackTokenBudgetPerTurn.map { max(0, $0) }
+        self.autoDisableDivergenceRate = configuration.autoDisableDivergenceRate
+        if draftAheadTokens == 0 {
+            disabledReason = "noDraftBudget"
+        }
+    }
+
+    // MARK: - Rounds
+
+    /// Number of tokens to draft in the next round.
+    ///
+    /// A round emits up to one token more than it drafts, so the draft is
+    /// limited to `remainingTokens - 1`.
+    func draftLength(remainingTokens: Int) -> Int {
+        guard isDrafting else { return 0 }
+        return max(0, min(draftAheadTokens, remainingTokens - 1))
+    }
+
+    /// Verifies `draft` against tokens sampled from the target model.
+    ///
+    /// - Parameters:
+    ///   - draft: Tokens proposed by the draft model.
+    ///   - sampleTarget: Samples the target's token at a position. Position `i`
+    ///     uses the logits produced after draft token `i - 1`; position
+    ///     `draft.count` is the bonus token after a fully accepted draft.
+    /// - Returns: The accepted draft prefix followed by one target token.
+    static func verify<Token: Equatable>(
+        draft: [Token],
+        sampleTarget: (Int) throws -> Token
+    ) rethrows -> [Token] {
+        var emitted: [Token] = []
+        emitted.reserveCapacity(draft.count + 1)
+
+        for position in 0...draft.count {
+            let token = try sampleTarget(position)
+            emitted.append(token)
+            guard position < draft.count, token == draft[position] else { break }
+        }
+        return emitted
+    }
+
+    /// Records a verification round.
+    ///
+    /// - Returns: The reason drafting was disabled by this round, if it was.
+    @discardableResult
+    mutating func recordRound(draftedTokens: Int, acceptedTokens: Int) -> String? {
+        statistics.emittedTokens += acceptedTokens + 1
+        guard draftedTokens > 0 else { return nil }
+
+        statistics.rounds += 1
+        statistics.draftedTokens += draftedTokens
+        statistics.acceptedTokens += min(acceptedTokens, draftedTokens)
+
+        guard isDrafting else { return nil }
+
+        if let rollbackTokenBudget, statistics.rollbackTokens > rollbackTokenBudget {
+            disabledReason = "rollbackBudgetExceeded"
+        } else if let autoDisableDivergenceRate,
+                  statistics.rounds >= Self.minimumRoundsBeforeAutoDisable,
+                  statistics.divergenceRate > autoDisableDivergenceRate {
+            disabledReason = "divergenceRateExceeded"
+        }
+        return disabledReason
+    }
+
+    /// Records a token emitted outside a verification round.
+    mutating func recordEmittedToken() {
+        statistics.emittedTokens += 1
+    }
+
+    // MARK: - Diagnostics
+
+    /// Summary details for a ``ProviderRuntimeDiagnosticsEventKind/speculativeDecoding`` event.
+    ///
+    /// - Parameters:
+    ///   - draftModel: Identifier of the draft model.
+    ///   - elapsed: Wall-clock decode time of the turn.
+    func diagnosticsDetails(draftModel: String, elapsed: TimeInterval) -> [String: String] {
+        let tokensPerSecond = elapsed > 0 ? Double(statistics.emittedTokens) / elapsed : 0
+        let tokensPerRound = statistics.rounds > 0
+            ? Double(statistics.acceptedTokens + statistics.rounds) / Double(statistics.rounds)
+            : 0
+
+        var details = [
+            "draft_model": draftModel,
+            "draft_ahead_tokens": String(draftAheadTokens),
+            "rounds": String(statistics.rounds),
+            "drafted_tokens": String(statistics.draftedTokens),
+            "accepted_tokens": String(statistics.acceptedTokens),
+            "rollback_tokens": String(statistics.rollbackTokens),
+            "emitted_tokens": String(statistics.emittedTokens),
+            "accept_rate": String(format: "%.3f", statistics.acceptRate),
+            "tokens_per_round": String(format: "%.2f", tokensPerRound),
+            "effective_tokens_per_second": String(format: "%.2f", tokensPerSecond),
+        ]
+        if let disabledReason {
+            details["disabled_reason"] = disabledReason
+        }
+        return details
+    }
+}
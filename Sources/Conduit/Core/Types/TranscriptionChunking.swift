@@ -0,0 +1,295 @@
+// TranscriptionChunking.swift
+// Conduit
+
+import Foundation
+
+/// Limits used when splitting a long recording into transcription requests.
+///
+/// Transcription endpoints take a whole file and answer once it has been
+/// processed, so an hour-long recording means one large upload and a long
+/// wait for the first word. Streaming transcription instead cuts the
+/// recording into ``windowDuration``-second windows that share ``overlap``
+/// seconds with their neighbours, reads each window from disk only when it
+/// is about to be sent, and transcribes up to ``maxConcurrentWindows`` at
+/// once. Segments are yielded in order as soon as every earlier window has
+/// finished.
+///
+/// Words near a window edge are often cut off or misheard, so each window
+/// keeps only what it heard around its centre: the boundary between two
+/// windows is the middle of their overlap, and a word belongs to the window
+/// that contains its midpoint.
+///
+/// ## Usage
+/// ```swift
+/// let chunking = TranscriptionChunking(windowDuration: 20, overlap: 2, maxConcurrentWindows: 8)
+/// let stream = provider.streamTranscription(
+///     audioURL: recordingURL,
+///     model: .huggingFace("openai/whisper-large-v3"),
+///     config: TranscriptionConfig(wordTimestamps: true),
+///     chunking: chunking
+/// )
+///
+/// for try await segment in stream {
+///     print("[\(segment.startTime)s]: \(segment.text)")
+/// }
+/// ```
+///
+/// - Note: Only WAV files can be cut without decoding. Other formats are
+///   transcribed as a single window, memory-mapped rather than copied.
+public struct TranscriptionChunking: Sendable, Hashable, Codable {
+
+    /// Seconds of audio sent in each request.
+    public var windowDuration: TimeInterval
+
+    /// Seconds each window shares with the next.
+    public var overlap: TimeInterval
+
+    /// Maximum number of windows being transcribed at once.
+    public var maxConcurrentWindows: Int
+
+    /// Creates a chunking policy.
+    ///
+    /// - Parameters:
+    ///   - windowDuration: Seconds per window. Clamped to at least 1. Default: 30
+    ///   - overlap: Seconds shared by neighbouring windows. Clamped to at most
+    ///     half a window. Default: 2
+    ///   - maxConcurrentWindows: Requests in flight. Clamped to at least 1. Default: 4
+    public init(
+        windowDuration: TimeInterval = 30,
+        overlap: TimeInterval = 2,
+        maxConcurrentWindows: Int = 4
+    ) {
+        self.windowDuration = max(1, windowDuration)
+        self.overlap = min(max(0, overlap), self.windowDuration / 2)
+        self.maxConcurrentWindows = max(1, maxConcurrentWindows)
+    }
+
+    // MARK: - Static Presets
+
+    /// 30-second windows, matching Whisper's receptive field, with 2 seconds
+    /// of overlap and 4 requests in flight.
+    public static let `default` = TranscriptionChunking()
+
+    // MARK: - Windows
+
+    /// One slice of a recording, sent as its own request.
+    public struct Window: Sendable, Hashable {
+
+        /// Position of the window in the recording, from 0.
+        public let index: Int
+
+        /// Start of the window in the recording, in seconds.
+        public let start: TimeInterval
+
+        /// End of the window in the recording, in seconds.
+        public let end: TimeInterval
+
+        /// Recording times this window is responsible for.
+        ///
+        /// Words and segments whose midpoint falls outside this range are
+        /// left to the neighbouring window.
+        public let keptRange: Range<TimeInterval>
+    }
+
+    /// Splits a recording of `duration` seconds into overlapping windows.
+    ///
+    /// - Parameter duration: The recording length in seconds.
+    /// - Returns: Windows covering the recording in order, or an empty array
+    ///   when `duration` is not positive.
+    public func windows(forDuration duration: TimeInterval) -> [Window] {
+        guard duration > 0 else { return [] }
+
+        // The last window starts early enough to hear more than the overlap
+        let stride = windowDuration - overlap
+        let count = duration <= windowDuration ? 1 : Int(((duration - overlap) / stride).rounded(.up))
+        let bounds = (0..<count).map { index in
+            (start: TimeInterval(index) * stride, end: min(duration, TimeInterval(index) * stride + windowDuration))
+        }
+
+        return bounds.indices.map { index in
+            let lower = index == 0 ? -TimeInterval.infinity : (bounds[index].start + bounds[index - 1].end) / 2
+            let upper = index == count - 1 ? TimeInterval.infinity : (bounds[index + 1].start + bounds[index].end) / 2
+            return Window(index: index, start: bounds[index].start, end: bounds[index].end, keptRange: lower..<upper)
+        }
+    }
+
+    // MARK: - Execution
+
+    /// Transcribes `url` window by window and yields merged segments in order.
+    ///
+    /// Windows are read from disk only when they are about to be sent, and at
+    /// most twice ``maxConcurrentWindows`` finished or running windows wait
+    /// on a slow earlier window, so memory stays bounded for any file length.
+    /// Cancelling the consuming task cancels every running request.
+    ///
+    /// - Parameters:
+    ///   - url: The audio file.
+    ///   - transcribeWindow: Transcribes one self-contained audio file.
+    ///     Timestamps are relative to the start of that file.
+    /// - Returns: Segments with recording-relative timestamps and IDs
+    ///   numbered from 0 across the whole recording.
+    internal func stream(
+        audioURL url: URL,
+        transcribeWindow: @escaping @Sendable (Data) async throws -> TranscriptionResult
+    ) -> AsyncThrowingStream<TranscriptionSegment, Error> {
+        let chunking = self
+        return AsyncThrowingStream { continuation in
+            let task = Task {
+                do {
+                    try await chunking.run(audioURL: url, transcribeWindow: transcribeWindow) { segment in
+                        continuation.yield(segment)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+
+    private func run(
+        audioURL url: URL,
+        transcribeWindow: @escaping @Sendable (Data) async throws -> TranscriptionResult,
+        yield: (TranscriptionSegment) -> Void
+    ) async throws {
+        var merger = TranscriptionWindowMerger()
+
+        guard let reader = try WAVWindowReader(url: url) else {
+            // Compressed audio cannot be cut without decoding it
+            let result = try await transcribeWindow(try Data(contentsOf: url, options: .mappedIfSafe))
+            let whole = Window(index: 0, start: 0, end: result.duration, keptRange: -.infinity..<.infinity)
+            merger.segments(from: result, in: whole).forEach(yield)
+            return
+        }
+
+        let windows = windows(forDuration: reader.duration)
+        try await withThrowingTaskGroup(of: (Int, TranscriptionResult).self) { group in
+            var finished: [Int: TranscriptionResult] = [:]
+            var nextWindow = 0
+            var nextEmitted = 0
+            var inFlight = 0
+
+            while nextWindow < windows.count || inFlight > 0 {
+                while nextWindow < windows.count, inFlight < maxConcurrentWindows,
+                      nextWindow - nextEmitted < maxConcurrentWindows * 2 {
+                    let index = nextWindow
+                    let audio = try reader.read(from: windows[index].start, to: windows[index].end)
+                    group.addTask {
+                        (index, try await transcribeWindow(audio))
+                    }
+                    nextWindow += 1
+                    inFlight += 1
+                }
+
+                guard let completed = try await group.next() else { break }
+                inFlight -= 1
+                finished[completed.0] = completed.1
+
+                // Emit in recording order so timestamps never go backwards
+                while let result = finished.removeValue(forKey: nextEmitted) {
+                    merger.segments(from: result, in: windows[nextEmitted]).forEach(yield)
+                    nextEmitted += 1
+                }
+            }
+        }
+    }
+}
+
+// MARK: - TranscriptionWindowMerger
+
+/// Joins per-window transcriptions into one run of recording-relative segments.
+///
+/// Windows must be passed in order. Each window's timestamps are shifted by
+/// its start, and words or segments outside its
+/// ``TranscriptionChunking/Window/keptRange`` are dropped. A word the
+/// previous window already kept, heard again across the boundary, is
+/// skipped as well.
+internal struct TranscriptionWindowMerger {
+
+    private var nextID = 0
+    private var lastWord: TranscriptionWord?
+
+    /// Returns the segments of `result` that `window` is responsible for.
+    mutating func segments(
+        from result: TranscriptionResult,
+        in window: TranscriptionChunking.Window
+    ) -> [TranscriptionSegment] {
+        var segments = result.segments
+        if segments.isEmpty, !result.text.isEmpty {
+            // Without timestamps, attribute the text to the window's own span
+            let start = max(window.start, window.keptRange.lowerBound) - window.start
+            let end = min(window.end, window.keptRange.upperBound) - window.start
+            segments = [TranscriptionSegment(id: 0, startTime: start, endTime: end, text: result.text)]
+        }
+        return segments.compactMap { merge($0, in: window) }
+    }
+
+    private mutating func merge(
+        _ segment: TranscriptionSegment,
+        in window: TranscriptionChunking.Window
+    ) -> TranscriptionSegment? {
+        let offset = window.start
+
+        guard let words = segment.words, !words.isEmpty else {
+            let midpoint = offset + (segment.startTime + segment.endTime) / 2
+            guard window.keptRange.contains(midpoint) else { return nil }
+            return renumbered(segment, startTime: segment.startTime + offset, endTime: segment.endTime + offset,
+                              text: segment.text, words: segment.words)
+        }
+
+        var kept: [TranscriptionWord] = []
+        for word in words {
+            let shifted = TranscriptionWord(
+                word: word.word,
+                startTime: word.startTime + offset,
+                endTime: word.endTime + offset,
+                confidence: word.confidence
+            )
+            guard window.keptRange.contains((shifted.startTime + shifted.endTime) / 2),
+                  !isRepeat(of: shifted) else {
+                continue
+            }
+            kept.append(shifted)
+            lastWord = shifted
+        }
+        guard let first = kept.first, let last = kept.last else { return nil }
+
+        if kept.count == words.count {
+            return renumbered(segment, startTime: segment.startTime + offset, endTime: segment.endTime + offset,
+                              text: segment.text, words: kept)
+        }
+        let text = kept.map { $0.word.trimmingCharacters(in: .whitespaces) }.joined(separator: " ")
+        return renumbered(segment, startTime: first.startTime, endTime: last.endTime, text: text, words: kept)
+    }
+
+    /// Whether `word` is the previous window's last word heard again.
+    private func isRepeat(of word: TranscriptionWord) -> Bool {
+        guard let lastWord, word.startTime < lastWord.endTime else { return false }
+        return Self.normalized(word.word) == Self.normalized(lastWord.word)
+    }
+
+    private static func normalized(_ word: String) -> String {
+        word.lowercased().filter { $0.isLetter || $0.isNumber }
+    }
+
+    private mutating func renumbered(
+        _ segment: TranscriptionSegment,
+        startTime: TimeInterval,
+        endTime: TimeInterval,
+        text: String,
+        words: [TranscriptionWord]?
+    ) -> TranscriptionSegment {
+        defer { nextID += 1 }
+        return TranscriptionSegment(
+            id: nextID,
+            startTime: startTime,
+            endTime: endTime,
+            text: text,
+            words: words,
+            avgLogProb: segment.avgLogProb,
+            compressionRatio: segment.compressionRatio,
+            noSpeechProb: segment.noSpeechProb
+        )
+    }
+}
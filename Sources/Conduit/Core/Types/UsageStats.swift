@@ -15,15 +15,28 @@ import Foundation
 ///     print("Prompt: \(usage.promptTokens) tokens")
 ///     print("Output: \(usage.completionTokens) tokens")
 ///     print("Total: \(usage.totalTokens) tokens")
+///     if let cached = usage.cacheReadTokens {
+///         print("Served from prompt cache: \(cached) tokens")
+///     }
 /// }
 /// ```
 public struct UsageStats: Sendable, Hashable, Codable {
-    /// Tokens in the prompt/input.
+    /// Tokens in the prompt/input, including any served from or written to
+    /// a prompt cache.
     public let promptTokens: Int
 
     /// Tokens in the completion/output.
     public let completionTokens: Int
 
+    /// Prompt tokens read from the provider's prompt cache, when reported.
+    ///
+    /// Cache reads are typically billed at a fraction of the input rate and
+    /// skip prefill, so a high share here shortens time to first token.
+    public let cacheReadTokens: Int?
+
+    /// Prompt tokens written to the provider's prompt cache, when reported.
+    public let cacheCreationTokens: Int?
+
     /// Total tokens used (prompt + completion).
     ///
     /// This is a computed property that sums prompt and completion tokens.
@@ -34,10 +47,19 @@ public struct UsageStats: Sendable, Hashable, Codable {
     /// Creates usage statistics.
     ///
     /// - Parameters:
-    ///   - promptTokens: Number of tokens in the input prompt.
+    ///   - promptTokens: Number of tokens in the input prompt, including cached tokens.
     ///   - completionTokens: Number of tokens in the generated output.
-    public init(promptTokens: Int, completionTokens: Int) {
+    ///   - cacheReadTokens: Prompt tokens read from a prompt cache.
+    ///   - cacheCreationTokens: Prompt tokens written to a prompt cache.
+    public init(
+        promptTokens: Int,
+        completionTokens: Int,
+        cacheReadTokens: Int? = nil,
+        cacheCreationTokens: Int? = nil
+    ) {
         self.promptTokens = promptTokens
         self.completionTokens = completionTokens
+        self.cacheReadTokens = cacheReadTokens
+        self.cacheCreationTokens = cacheCreationTokens
     }
 }
@@ -0,0 +1,372 @@
+// V2RuntimeBenchmarkHarness+Providers.swift
+// Conduit
+//
+// Measured benchmark and parity runs against any TextGenerator.
+
+import Foundation
+
+// MARK: - Options
+
+/// Controls for measured benchmark and parity runs.
+package struct V2RuntimeBenchmarkOptions: Sendable {
+    /// Prompts to replay; `nil` derives a seeded corpus from the harness seed.
+    package var corpus: V2RuntimeBenchmarkCorpus?
+
+    /// Base generation settings.
+    ///
+    /// The harness overrides `seed` with its fixed seed and switches runtime
+    /// features per mode with ``V2RuntimeMode/runtimeFeatures(base:)``, using
+    /// `config.runtimeFeatures` as the base.
+    package var config: GenerateConfig
+
+    /// Untimed requests sent before each mode is measured, so model loading
+    /// and first-use compilation stay out of the numbers.
+    package var warmupRuns: Int
+
+    /// Generations per mode compared against baseline output in parity runs.
+    package var parityRuns: Int
+
+    package var memoryProbe: V2RuntimeMemoryProbe
+
+    package init(
+        corpus: V2RuntimeBenchmarkCorpus? = nil,
+        config: GenerateConfig = .default.temperature(0).maxTokens(128),
+        warmupRuns: Int = 1,
+        parityRuns: Int = 8,
+        memoryProbe: V2RuntimeMemoryProbe = .process
+    ) {
+        self.corpus = corpus
+        self.config = config
+        self.warmupRuns = warmupRuns
+        self.parityRuns = parityRuns
+        self.memoryProbe = memoryProbe
+    }
+}
+
+// MARK: - Measured Runs
+
+extension V2RuntimeBenchmarkHarness {
+
+    /// Measures each mode by streaming the prompt corpus through `provider`.
+    ///
+    /// Modes run in `rawValue` order, one request at a time, with the same
+    /// seed and corpus. Per mode the harness records:
+    ///
+    /// - `ttftMs`: median wall-clock time from request to first streamed text.
+    /// - `decodeTokensPerSecond`: completion tokens after the first, divided by
+    ///   the time from first to last token.
+    /// - `p95LatencyMs`, p50/p99 and a histogram of inter-token latency,
+    ///   measured between streamed text chunks.
+    /// - `kvMemoryMB`: peak memory growth over the level after warm-up — GPU
+    ///   memory when the probe reports it, resident memory otherwise.
+    /// - Peak resident and GPU memory.
+    ///
+    /// The report is written to `benchmarks/<profileName>-benchmark.json`.
+    ///
+    /// ## Usage
+    ///
+    /// ```swift
+    /// let harness = V2RuntimeBenchmarkHarness(outputRoot: outputURL, fixedSeed: 42)
+    /// let artifact = try await harness.runBenchmark(
+    ///     provider: LlamaProvider(),
+    ///     model: .llama("/models/qwen2.5-0.5b.gguf"),
+    ///     profileName: "llama-q4",
+    ///     modes: V2RuntimeMode.allCases
+    /// )
+    /// ```
+    ///
+    /// - Throws: `AIError.invalidInput` for an empty corpus, or any error the
+    ///   provider throws.
+    package func runBenchmark<Provider: TextGenerator>(
+        provider: Provider,
+        model: Provider.ModelID,
+        profileName: String,
+        modes: [V2RuntimeMode],
+        options: V2RuntimeBenchmarkOptions = .init()
+    ) async throws -> V2RuntimeBenchmarkArtifact {
+        let corpus = try resolvedCorpus(options)
+        let generatedAt = Date()
+
+        var results: [V2RuntimeBenchmarkPoint] = []
+        for mode in modes.sorted(by: { $0.rawValue < $1.rawValue }) {
+            try Task.checkCancellation()
+            results.append(
+                try await measure(mode, provider: provider, model: model, corpus: corpus, options: options)
+            )
+        }
+
+        let outputPath = benchmarkOutputPath(profileName: profileName)
+        try writeReport(
+            V2RuntimeBenchmarkReport(
+                generatedAt: generatedAt,
+                fixedSeed: fixedSeed,
+                profileName: profileName,
+                modelID: model.rawValue,
+                corpusFingerprint: corpus.fingerprint,
+                warmupRuns: max(0, options.warmupRuns),
+                results: results
+            ),
+            to: outputPath
+        )
+
+        return V2RuntimeBenchmarkArtifact(
+            generatedAt: generatedAt,
+            fixedSeed: fixedSeed,
+            profileName: profileName,
+            results: results,
+            outputPath: outputPath
+        )
+    }
+
+    /// Checks each mode's output against baseline decoding of the same prompts.
+    ///
+    /// A reference output is generated for every corpus prompt with all runtime
+    /// features off. Each mode then runs `options.parityRuns` generations,
+    /// cycling through the corpus, and a run matches when its text equals the
+    /// reference exactly. With greedy decoding, lossless modes such as
+    /// `speculative` should match every run; the `baseline` row measures the
+    /// provider's own run-to-run determinism.
+    ///
+    /// The report is written to `conformance/<profileName>-parity.json`.
+    package func runParity<Provider: TextGenerator>(
+        provider: Provider,
+        model: Provider.ModelID,
+        profileName: String,
+        modes: [V2RuntimeMode],
+        options: V2RuntimeBenchmarkOptions = .init()
+    ) async throws -> V2RuntimeParityArtifact {
+        let corpus = try resolvedCorpus(options)
+        let generatedAt = Date()
+        let runs = max(1, options.parityRuns)
+
+        let baselineConfig = requestConfig(for: .baseline, options: options)
+        var references: [String] = []
+        for prompt in corpus.prompts {
+            references.append(
+                try await provider.generate(messages: [.user(prompt)], model: model, config: baselineConfig).text
+            )
+        }
+
+        var modeResults: [V2RuntimeParityModeResult] = []
+        for mode in modes.sorted(by: { $0.rawValue < $1.rawValue }) {
+            let config = requestConfig(for: mode, options: options)
+            var matchingRuns = 0
+            var firstMismatch: Int?
+
+            for run in 0..<runs {
+                try Task.checkCancellation()
+                let index = run % corpus.prompts.count
+                let output = try await provider.generate(
+                    messages: [.user(corpus.prompts[index])],
+                    model: model,
+                    config: config
+                ).text
+
+                if output == references[index] {
+                    matchingRuns += 1
+                } else if firstMismatch == nil {
+                    firstMismatch = index
+                }
+            }
+
+            modeResults.append(
+                V2RuntimeParityModeResult(
+                    mode: mode,
+                    matchingRuns: matchingRuns,
+                    totalRuns: runs,
+                    firstMismatchPromptIndex: firstMismatch
+                )
+            )
+        }
+
+        let outputPath = parityOutputPath(profileName: profileName)
+        try writeReport(
+            V2RuntimeParityReport(
+                generatedAt: generatedAt,
+                fixedSeed: fixedSeed,
+                profileName: profileName,
+                modelID: model.rawValue,
+                corpusFingerprint: corpus.fingerprint,
+                runs: runs,
+                modes: modeResults
+            ),
+            to: outputPath
+        )
+
+        return V2RuntimeParityArtifact(
+            generatedAt: generatedAt,
+            fixedSeed: fixedSeed,
+            profileName: profileName,
+            modes: modeResults,
+            outputPath: outputPath
+        )
+    }
+
+    // MARK: - Private Helpers
+
+    private func resolvedCorpus(_ options: V2RuntimeBenchmarkOptions) throws -> V2RuntimeBenchmarkCorpus {
+        let corpus = options.corpus ?? .seeded(fixedSeed)
+        guard !corpus.prompts.isEmpty else {
+            throw AIError.invalidInput("Benchmark corpus must contain at least one prompt")
+        }
+        return corpus
+    }
+
+    private func requestConfig(for mode: V2RuntimeMode, options: V2RuntimeBenchmarkOptions) -> GenerateConfig {
+        options.config
+            .seed(fixedSeed)
+            .runtimeFeatures(mode.runtimeFeatures(base: options.config.runtimeFeatures ?? .init()))
+    }
+
+    private func measure<Provider: TextGenerator>(
+        _ mode: V2RuntimeMode,
+        provider: Provider,
+        model: Provider.ModelID,
+        corpus: V2RuntimeBenchmarkCorpus,
+        options: V2RuntimeBenchmarkOptions
+    ) async throws -> V2RuntimeBenchmarkPoint {
+        let config = requestConfig(for: mode, options: options)
+        let probe = options.memoryProbe
+
+        for _ in 0..<max(0, options.warmupRuns) {
+            var ignored = V2RuntimeMemoryPeak()
+            _ = try await streamRequest(corpus.prompts[0], provider: provider, model: model,
+                                        config: config, probe: probe, peak: &ignored)
+        }
+
+        var idle = V2RuntimeMemoryPeak()
+        idle.sample(probe)
+        var peak = idle
+
+        var ttfts: [Double] = []
+        var latencies: [Double] = []
+        var histogram = V2RuntimeLatencyHistogram()
+        var completionTokens = 0
+        var decodeTokens = 0
+        var decodeSeconds = 0.0
+
+        for prompt in corpus.prompts {
+            try Task.checkCancellation()
+            let sample = try await streamRequest(prompt, provider: provider, model: model,
+                                                 config: config, probe: probe, peak: &peak)
+            if let ttftMs = sample.ttftMs {
+                ttfts.append(ttftMs)
+            }
+            for latency in sample.interTokenLatenciesMs {
+                latencies.append(latency)
+                histogram.record(latency)
+            }
+            completionTokens += sample.completionTokens
+            decodeTokens += max(0, sample.completionTokens - 1)
+            decodeSeconds += sample.decodeSeconds
+        }
+
+        ttfts.sort()
+        latencies.sort()
+
+        let bytesPerMB = 1_048_576.0
+        let memoryGrowth: UInt64
+        if let gpuPeak = peak.gpu {
+            memoryGrowth = gpuPeak - min(gpuPeak, idle.gpu ?? 0)
+        } else {
+            memoryGrowth = peak.resident - min(peak.resident, idle.resident)
+        }
+
+        return V2RuntimeBenchmarkPoint(
+            mode: mode,
+            ttftMs: Self.percentile(ttfts, 0.5),
+            decodeTokensPerSecond: decodeSeconds > 0 ? Double(decodeTokens) / decodeSeconds : 0,
+            p95LatencyMs: Self.percentile(latencies, 0.95),
+            kvMemoryMB: Double(memoryGrowth) / bytesPerMB,
+            samples: corpus.prompts.count,
+            completionTokens: completionTokens,
+            p50InterTokenLatencyMs: Self.percentile(latencies, 0.5),
+            p99InterTokenLatencyMs: Self.percentile(latencies, 0.99),
+            interTokenLatencyHistogram: histogram,
+            peakResidentMemoryMB: Double(peak.resident) / bytesPerMB,
+            peakGPUMemoryMB: peak.gpu.map { Double($0) / bytesPerMB }
+        )
+    }
+
+    private func streamRequest<Provider: TextGenerator>(
+        _ prompt: String,
+        provider: Provider,
+        model: Provider.ModelID,
+        config: GenerateConfig,
+        probe: V2RuntimeMemoryProbe,
+        peak: inout V2RuntimeMemoryPeak
+    ) async throws -> V2RuntimeRequestSample {
+        let clock = ContinuousClock()
+        let start = clock.now
+        var sample = V2RuntimeRequestSample()
+        var firstTextAt: ContinuousClock.Instant?
+        var lastTextAt: ContinuousClock.Instant?
+        var reportedCompletionTokens: Int?
+
+        let stream = provider.streamWithMetadata(messages: [.user(prompt)], model: model, config: config)
+        for try await chunk in stream {
+            let now = clock.now
+            peak.sample(probe)
+
+            if let usage = chunk.usage {
+                reportedCompletionTokens = usage.completionTokens
+            }
+            guard !chunk.text.isEmpty else { continue }
+
+            if let previous = lastTextAt {
+                sample.interTokenLatenciesMs.append(Self.milliseconds(now - previous))
+            } else {
+                firstTextAt = now
+                sample.ttftMs = Self.milliseconds(now - start)
+            }
+            lastTextAt = now
+            sample.completionTokens += max(1, chunk.tokenCount)
+        }
+
+        // Provider-reported usage is authoritative when chunks batch several tokens.
+        if let reportedCompletionTokens, reportedCompletionTokens > 0 {
+            sample.completionTokens = reportedCompletionTokens
+        }
+        if let firstTextAt, let lastTextAt {
+            sample.decodeSeconds = Self.milliseconds(lastTextAt - firstTextAt) / 1_000
+        }
+        return sample
+    }
+
+    /// Nearest-rank percentile of an ascending array, or `0` when empty.
+    static func percentile(_ sorted: [Double], _ fraction: Double) -> Double {
+        guard !sorted.isEmpty else { return 0 }
+        let rank = Int((fraction * Double(sorted.count)).rounded(.up))
+        return sorted[min(sorted.count - 1, max(0, rank - 1))]
+    }
+
+    private static func milliseconds(_ duration: Duration) -> Double {
+        let components = duration.components
+        return Double(components.seconds) * 1_000 + Double(components.attoseconds) / 1e15
+    }
+}
+
+// MARK: - Supporting Types
+
+/// Timings collected from one streamed request.
+private struct V2RuntimeRequestSample {
+    var ttftMs: Double?
+    var interTokenLatenciesMs: [Double] = []
+    var completionTokens = 0
+    var decodeSeconds = 0.0
+}
+
+/// Highest memory readings seen so far.
+private struct V2RuntimeMemoryPeak {
+    var resident: UInt64 = 0
+    var gpu: UInt64?
+
+    mutating func sample(_ probe: V2RuntimeMemoryProbe) {
+        if let resident = probe.residentBytes() {
+            self.resident = max(self.resident, resident)
+        }
+        if let gpu = probe.gpuBytes?() {
+            self.gpu = max(self.gpu ?? 0, gpu)
+        }
+    }
+}
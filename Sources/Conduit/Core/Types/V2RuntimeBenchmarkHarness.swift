@@ -3,7 +3,7 @@
 
 import Foundation
 
-enum V2RuntimeMode: String, Sendable, Codable, CaseIterable {
+package enum V2RuntimeMode: String, Sendable, Codable, CaseIterable {
     case baseline
     case quantizedKV = "quantized_kv"
     case attentionSinks = "attention_sinks"
@@ -12,61 +12,188 @@ enum V2RuntimeMode: String, Sendable, Codable, CaseIterable {
     case speculative
 }
 
-struct V2RuntimeBenchmarkPoint: Sendable, Codable, Equatable {
-    var mode: V2RuntimeMode
-    var ttftMs: Double
-    var decodeTokensPerSecond: Double
-    var p95LatencyMs: Double
-    var kvMemoryMB: Double
+/// Benchmark results for one runtime mode.
+///
+/// Measured runs fill every field; synthetic runs leave the optional
+/// measurement details `nil`, and they are omitted from the JSON artifact.
+package struct V2RuntimeBenchmarkPoint: Sendable, Codable, Equatable {
+    package var mode: V2RuntimeMode
 
-    init(
+    /// Median time from request to first streamed text.
+    package var ttftMs: Double
+
+    /// Completion tokens after the first, divided by time from first to last token.
+    package var decodeTokensPerSecond: Double
+
+    /// 95th percentile inter-token latency.
+    package var p95LatencyMs: Double
+
+    /// Peak memory growth while the mode ran, an upper bound on its KV cache footprint.
+    package var kvMemoryMB: Double
+
+    /// Measured requests, excluding warm-up.
+    package var samples: Int?
+
+    /// Completion tokens across measured requests.
+    package var completionTokens: Int?
+
+    /// Median inter-token latency.
+    package var p50InterTokenLatencyMs: Double?
+
+    /// 99th percentile inter-token latency.
+    package var p99InterTokenLatencyMs: Double?
+
+    /// Distribution of inter-token latencies.
+    package var interTokenLatencyHistogram: V2RuntimeLatencyHistogram?
+
+    /// Peak resident memory of the process.
+    package var peakResidentMemoryMB: Double?
+
+    /// Peak accelerator memory, when the memory probe reports it.
+    package var peakGPUMemoryMB: Double?
+
+    package init(
         mode: V2RuntimeMode,
         ttftMs: Double,
         decodeTokensPerSecond: Double,
         p95LatencyMs: Double,
-        kvMemoryMB: Double
+        kvMemoryMB: Double,
+        samples: Int? = nil,
+        completionTokens: Int? = nil,
+        p50InterTokenLatencyMs: Double? = nil,
+        p99InterTokenLatencyMs: Double? = nil,
+        interTokenLatencyHistogram: V2RuntimeLatencyHistogram? = nil,
+        peakResidentMemoryMB: Double? = nil,
+        peakGPUMemoryMB: Double? = nil
     ) {
         self.mode = mode
         self.ttftMs = ttftMs
         self.decodeTokensPerSecond = decodeTokensPerSecond
         self.p95LatencyMs = p95LatencyMs
         self.kvMemoryMB = kvMemoryMB
+        self.samples = samples
+        self.completionTokens = completionTokens
+        self.p50InterTokenLatencyMs = p50InterTokenLatencyMs
+        self.p99InterTokenLatencyMs = p99InterTokenLatencyMs
+        self.interTokenLatencyHistogram = interTokenLatencyHistogram
+        self.peakResidentMemoryMB = peakResidentMemoryMB
+        self.peakGPUMemoryMB = peakGPUMemoryMB
     }
 }
 
-struct V2RuntimeBenchmarkArtifact: Sendable {
-    var generatedAt: Date
-    var fixedSeed: UInt64
-    var profileName: String
-    var results: [V2RuntimeBenchmarkPoint]
-    var outputPath: URL
+package struct V2RuntimeBenchmarkArtifact: Sendable {
+    package var generatedAt: Date
+    package var fixedSeed: UInt64
+    package var profileName: String
+    package var results: [V2RuntimeBenchmarkPoint]
+    package var outputPath: URL
 }
 
-struct V2RuntimeParityModeResult: Sendable, Codable, Equatable {
-    var mode: V2RuntimeMode
-    var matchingRuns: Int
-    var totalRuns: Int
+package struct V2RuntimeParityModeResult: Sendable, Codable, Equatable {
+    package var mode: V2RuntimeMode
+    package var matchingRuns: Int
+    package var totalRuns: Int
 
-    init(mode: V2RuntimeMode, matchingRuns: Int, totalRuns: Int) {
+    /// Corpus index of the first prompt whose output differed from baseline.
+    package var firstMismatchPromptIndex: Int?
+
+    package init(mode: V2RuntimeMode, matchingRuns: Int, totalRuns: Int, firstMismatchPromptIndex: Int? = nil) {
         self.mode = mode
         self.matchingRuns = matchingRuns
         self.totalRuns = totalRuns
+        self.firstMismatchPromptIndex = firstMismatchPromptIndex
+    }
+}
+
+package struct V2RuntimeParityArtifact: Sendable {
+    package var generatedAt: Date
+    package var fixedSeed: UInt64
+    package var profileName: String
+    package var modes: [V2RuntimeParityModeResult]
+    package var outputPath: URL
+}
+
+// MARK: - Reports
+
+/// JSON written to `benchmarks/<profile>-benchmark.json`.
+///
+/// Keys are sorted so artifacts from different releases diff cleanly.
+package struct V2RuntimeBenchmarkReport: Sendable, Codable, Equatable {
+    package var generatedAt: Date
+    package var fixedSeed: UInt64
+    package var profileName: String
+    package var modelID: String?
+    package var corpusFingerprint: String?
+    package var warmupRuns: Int?
+    package var results: [V2RuntimeBenchmarkPoint]
+
+    package init(
+        generatedAt: Date,
+        fixedSeed: UInt64,
+        profileName: String,
+        modelID: String? = nil,
+        corpusFingerprint: String? = nil,
+        warmupRuns: Int? = nil,
+        results: [V2RuntimeBenchmarkPoint]
+    ) {
+        self.generatedAt = generatedAt
+        self.fixedSeed = fixedSeed
+        self.profileName = profileName
+        self.modelID = modelID
+        self.corpusFingerprint = corpusFingerprint
+        self.warmupRuns = warmupRuns
+        self.results = results
+    }
+
+    /// Reads a report previously written by ``V2RuntimeBenchmarkHarness``.
+    package static func load(from url: URL) throws -> V2RuntimeBenchmarkReport {
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        return try decoder.decode(V2RuntimeBenchmarkReport.self, from: Data(contentsOf: url))
     }
 }
 
-struct V2RuntimeParityArtifact: Sendable {
-    var generatedAt: Date
-    var fixedSeed: UInt64
-    var profileName: String
-    var modes: [V2RuntimeParityModeResult]
-    var outputPath: URL
+/// JSON written to `conformance/<profile>-parity.json`.
+package struct V2RuntimeParityReport: Sendable, Codable, Equatable {
+    package var generatedAt: Date
+    package var fixedSeed: UInt64
+    package var profileName: String
+    package var modelID: String?
+    package var corpusFingerprint: String?
+    package var runs: Int
+    package var modes: [V2RuntimeParityModeResult]
+
+    package init(
+        generatedAt: Date,
+        fixedSeed: UInt64,
+        profileName: String,
+        modelID: String? = nil,
+        corpusFingerprint: String? = nil,
+        runs: Int,
+        modes: [V2RuntimeParityModeResult]
+    ) {
+        self.generatedAt = generatedAt
+        self.fixedSeed = fixedSeed
+        self.profileName = profileName
+        self.modelID = modelID
+        self.corpusFingerprint = corpusFingerprint
+        self.runs = runs
+        self.modes = modes
+    }
 }
 
-struct V2RuntimeBenchmarkHarness: Sendable {
-    var outputRoot: URL
-    var fixedSeed: UInt64
+// MARK: - Harness
 
-    init(outputRoot: URL, fixedSeed: UInt64) {
+/// Writes benchmark and parity artifacts for the V2 runtime modes.
+///
+/// The `runSynthetic…` methods emit fixed, seed-derived numbers and exist to
+/// exercise the artifact format. Measured runs against a provider live in
+/// `V2RuntimeBenchmarkHarness+Providers.swift`.
+package struct V2RuntimeBenchmarkHarness: Sendable {
+    package var outputRoot: URL
+    package var fixedSeed: UInt64
+
+    package init(outputRoot: URL, fixedSeed: UInt64) {
         self.outputRoot = outputRoot
         self.fixedSeed = fixedSeed
     }
@@ -81,26 +208,16 @@ struct V2RuntimeBenchmarkHarness: Sendable {
             syntheticPoint(mode: mode, random: &random)
         }
 
-        let outputPath = outputRoot
-            .appendingPathComponent("benchmarks", isDirectory: true)
-            .appendingPathComponent("\(profileName)-benchmark.json")
-
-        try FileManager.default.createDirectory(
-            at: outputPath.deletingLastPathComponent(),
-            withIntermediateDirectories: true
-        )
-
-        let payload = SyntheticBenchmarkPayload(
-            generatedAt: generatedAt,
-            fixedSeed: fixedSeed,
-            profileName: profileName,
-            results: results
+        let outputPath = benchmarkOutputPath(profileName: profileName)
+        try writeReport(
+            V2RuntimeBenchmarkReport(
+                generatedAt: generatedAt,
+                fixedSeed: fixedSeed,
+                profileName: profileName,
+                results: results
+            ),
+            to: outputPath
         )
-        let encoder = JSONEncoder()
-        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
-        encoder.dateEncodingStrategy = .iso8601
-        let data = try encoder.encode(payload)
-        try data.write(to: outputPath, options: .atomic)
 
         return V2RuntimeBenchmarkArtifact(
             generatedAt: generatedAt,
@@ -122,28 +239,18 @@ struct V2RuntimeBenchmarkHarness: Sendable {
             V2RuntimeParityModeResult(mode: mode, matchingRuns: normalizedRuns, totalRuns: normalizedRuns)
         }
 
-        let outputPath = outputRoot
-            .appendingPathComponent("conformance", isDirectory: true)
-            .appendingPathComponent("\(profileName)-parity.json")
-
-        try FileManager.default.createDirectory(
-            at: outputPath.deletingLastPathComponent(),
-            withIntermediateDirectories: true
+        let outputPath = parityOutputPath(profileName: profileName)
+        try writeReport(
+            V2RuntimeParityReport(
+                generatedAt: generatedAt,
+                fixedSeed: fixedSeed,
+                profileName: profileName,
+                runs: normalizedRuns,
+                modes: modeResults
+            ),
+            to: outputPath
         )
 
-        let payload = SyntheticParityPayload(
-            generatedAt: generatedAt,
-            fixedSeed: fixedSeed,
-            profileName: profileName,
-            runs: normalizedRuns,
-            modes: modeResults
-        )
-        let encoder = JSONEncoder()
-        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
-        encoder.dateEncodingStrategy = .iso8601
-        let data = try encoder.encode(payload)
-        try data.write(to: outputPath, options: .atomic)
-
         return V2RuntimeParityArtifact(
             generatedAt: generatedAt,
             fixedSeed: fixedSeed,
@@ -217,22 +324,39 @@ struct V2RuntimeBenchmarkHarness: Sendable {
     }
 }
 
-private struct SyntheticBenchmarkPayload: Codable {
-    var generatedAt: Date
-    var fixedSeed: UInt64
-    var profileName: String
-    var results: [V2RuntimeBenchmarkPoint]
-}
+// MARK: - Artifact Output
+
+extension V2RuntimeBenchmarkHarness {
 
-private struct SyntheticParityPayload: Codable {
-    var generatedAt: Date
-    var fixedSeed: UInt64
-    var profileName: String
-    var runs: Int
-    var modes: [V2RuntimeParityModeResult]
+    func benchmarkOutputPath(profileName: String) -> URL {
+        outputRoot
+            .appendingPathComponent("benchmarks", isDirectory: true)
+            .appendingPathComponent("\(profileName)-benchmark.json")
+    }
+
+    func parityOutputPath(profileName: String) -> URL {
+        outputRoot
+            .appendingPathComponent("conformance", isDirectory: true)
+            .appendingPathComponent("\(profileName)-parity.json")
+    }
+
+    func writeReport<Report: Encodable>(_ report: Report, to outputPath: URL) throws {
+        try FileManager.default.createDirectory(
+            at: outputPath.deletingLastPathComponent(),
+            withIntermediateDirectories: true
+        )
+
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        encoder.dateEncodingStrategy = .iso8601
+        let data = try encoder.encode(report)
+        try data.write(to: outputPath, options: .atomic)
+    }
 }
 
-private struct DeterministicLCG: Sendable {
+// MARK: - Deterministic Random
+
+struct DeterministicLCG: Sendable {
     private var state: UInt64
 
     init(seed: UInt64) {
@@ -247,4 +371,9 @@ private struct DeterministicLCG: Sendable {
     mutating func nextUnit() -> Double {
         Double(next() % 10_000) / 10_000.0
     }
+
+    /// Uniform index in `0..<upperBound`, drawn from the high bits.
+    mutating func nextIndex(_ upperBound: Int) -> Int {
+        Int((next() >> 33) % UInt64(max(1, upperBound)))
+    }
 }
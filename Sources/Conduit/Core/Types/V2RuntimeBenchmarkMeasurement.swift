@@ -0,0 +1,266 @@
+// V2RuntimeBenchmarkMeasurement.swift
+// Conduit
+//
+// Prompt corpus, latency histograms, memory probes and regression checks for
+// measured V2 runtime benchmarks.
+
+import Foundation
+
+#if canImport(Darwin)
+import Darwin
+#elseif os(Linux)
+import Glibc
+#endif
+
+// MARK: - Mode Features
+
+extension V2RuntimeMode {
+
+    /// Runtime features that exercise this mode in isolation.
+    ///
+    /// Every feature in `base` is switched off except the one this mode
+    /// measures. Other settings in `base` (KV bits, sink size, draft model)
+    /// are kept, so a run can tune the feature under test.
+    package func runtimeFeatures(
+        base: ProviderRuntimeFeatureConfiguration = .init()
+    ) -> ProviderRuntimeFeatureConfiguration {
+        var features = base
+        features.kvQuantization.enabled = self == .quantizedKV
+        features.attentionSinks.enabled = self == .attentionSinks
+        features.kvSwap.enabled = self == .kvSwap
+        features.incrementalPrefill.enabled = self == .incrementalPrefill
+        features.speculativeScheduling.enabled = self == .speculative
+        return features
+    }
+}
+
+// MARK: - Prompt Corpus
+
+/// Prompts replayed for every mode of a measured benchmark.
+///
+/// ``seeded(_:count:)`` derives the same prompts from the same seed on every
+/// platform, so artifacts from different releases measure identical work.
+/// Prompts mix task styles and carry 0–7 sentences of background so prefill
+/// length varies across the corpus.
+package struct V2RuntimeBenchmarkCorpus: Sendable, Codable, Equatable {
+    package var prompts: [String]
+
+    package init(prompts: [String]) {
+        self.prompts = prompts
+    }
+
+    /// Stable FNV-1a fingerprint of the prompts, recorded in artifacts.
+    package var fingerprint: String {
+        var hash: UInt64 = 0xCBF2_9CE4_8422_2325
+        func mix(_ byte: UInt8) {
+            hash ^= UInt64(byte)
+            hash = hash &* 0x0000_0100_0000_01B3
+        }
+        for prompt in prompts {
+            prompt.utf8.forEach(mix)
+            mix(0)
+        }
+        return String(format: "%016llx", hash)
+    }
+
+    /// Builds a corpus of `count` prompts from `seed`.
+    package static func seeded(_ seed: UInt64, count: Int = 8) -> V2RuntimeBenchmarkCorpus {
+        var random = DeterministicLCG(seed: seed)
+        let prompts = (0..<max(1, count)).map { _ in
+            let topic = topics[random.nextIndex(topics.count)]
+            let task = tasks[random.nextIndex(tasks.count)].replacingOccurrences(of: "{topic}", with: topic)
+            let sentence = "Notes on \(topic) cover design trade-offs, failure modes and measurement. "
+            let background = String(repeating: sentence, count: random.nextIndex(8))
+            return background.isEmpty ? task : "Background: \(background)\n\n\(task)"
+        }
+        return V2RuntimeBenchmarkCorpus(prompts: prompts)
+    }
+
+    private static let tasks = [
+        "Summarize {topic} in three sentences.",
+        "Explain {topic} to an engineer joining the team.",
+        "List five common mistakes when working with {topic}.",
+        "Write a short Swift function that illustrates {topic}.",
+        "Compare two approaches to {topic} and recommend one.",
+        "Describe how you would test a system that depends on {topic}.",
+    ]
+
+    private static let topics = [
+        "cache eviction policies",
+        "structured concurrency",
+        "vector embeddings",
+        "memory-mapped files",
+        "rate limiting",
+        "tokenization",
+        "attention mechanisms",
+        "retry strategies",
+        "binary search",
+        "content-addressed storage",
+        "speculative execution",
+        "backpressure in streams",
+    ]
+}
+
+// MARK: - Latency Histogram
+
+/// Fixed-bucket histogram of inter-token latencies.
+///
+/// Bucket bounds are fixed so histograms from different releases line up
+/// bucket-for-bucket when artifacts are diffed.
+package struct V2RuntimeLatencyHistogram: Sendable, Codable, Equatable {
+    package static let defaultBucketUpperBoundsMs: [Double] = [1, 2, 5, 10, 20, 50, 100, 200, 500, 1_000]
+
+    /// Inclusive upper bound of each bucket in milliseconds.
+    package private(set) var bucketUpperBoundsMs: [Double]
+
+    /// Samples per bucket; the last entry counts samples above every bound.
+    package private(set) var counts: [Int]
+
+    package init(bucketUpperBoundsMs: [Double] = V2RuntimeLatencyHistogram.defaultBucketUpperBoundsMs) {
+        self.bucketUpperBoundsMs = bucketUpperBoundsMs.sorted()
+        self.counts = Array(repeating: 0, count: bucketUpperBoundsMs.count + 1)
+    }
+
+    /// Total recorded samples.
+    package var sampleCount: Int {
+        counts.reduce(0, +)
+    }
+
+    package mutating func record(_ latencyMs: Double) {
+        let index = bucketUpperBoundsMs.firstIndex { latencyMs <= $0 } ?? bucketUpperBoundsMs.count
+        counts[index] += 1
+    }
+}
+
+// MARK: - Memory Probe
+
+/// Reads process and accelerator memory while a benchmark runs.
+///
+/// The harness samples the probe before each mode and on every streamed
+/// chunk, and reports the peak. Providers with their own allocator (such as
+/// MLX's Metal heap) supply `gpuBytes`.
+package struct V2RuntimeMemoryProbe: Sendable {
+    package var residentBytes: @Sendable () -> UInt64?
+    package var gpuBytes: (@Sendable () -> UInt64?)?
+
+    package init(
+        residentBytes: @escaping @Sendable () -> UInt64? = { V2RuntimeMemoryProbe.processResidentBytes() },
+        gpuBytes: (@Sendable () -> UInt64?)? = nil
+    ) {
+        self.residentBytes = residentBytes
+        self.gpuBytes = gpuBytes
+    }
+
+    /// Process memory only.
+    package static let process = V2RuntimeMemoryProbe()
+
+    /// Physical memory footprint of the current process, or `nil` when unavailable.
+    package static func processResidentBytes() -> UInt64? {
+        #if canImport(Darwin)
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(
+            MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<integer_t>.size
+        )
+
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? UInt64(info.phys_footprint) : nil
+        #elseif os(Linux)
+        // Second field of /proc/self/statm is the resident set size in pages.
+        guard let statm = try? String(contentsOfFile: "/proc/self/statm", encoding: .utf8) else {
+            return nil
+        }
+        let fields = statm.split(whereSeparator: { $0.isWhitespace })
+        guard fields.count >= 2, let pages = UInt64(fields[1]) else {
+            return nil
+        }
+        return pages * UInt64(getpagesize())
+        #else
+        return nil
+        #endif
+    }
+}
+
+// MARK: - Regression Gate
+
+/// Relative regressions tolerated before a benchmark comparison fails.
+package struct V2RuntimeBenchmarkThresholds: Sendable, Codable, Equatable {
+    package var ttftIncrease: Double
+    package var decodeThroughputDecrease: Double
+    package var p95LatencyIncrease: Double
+    package var kvMemoryIncrease: Double
+
+    package init(
+        ttftIncrease: Double = 0.10,
+        decodeThroughputDecrease: Double = 0.10,
+        p95LatencyIncrease: Double = 0.15,
+        kvMemoryIncrease: Double = 0.10
+    ) {
+        self.ttftIncrease = ttftIncrease
+        self.decodeThroughputDecrease = decodeThroughputDecrease
+        self.p95LatencyIncrease = p95LatencyIncrease
+        self.kvMemoryIncrease = kvMemoryIncrease
+    }
+
+    package static let `default` = V2RuntimeBenchmarkThresholds()
+}
+
+/// A metric that moved past its threshold relative to a previous report.
+package struct V2RuntimeBenchmarkRegression: Sendable, Codable, Equatable {
+    package var mode: V2RuntimeMode
+
+    /// JSON key of the metric, e.g. `ttftMs`.
+    package var metric: String
+    package var baseline: Double
+    package var current: Double
+
+    /// Relative change, positive when the metric got worse.
+    package var change: Double
+}
+
+extension V2RuntimeBenchmarkReport {
+
+    /// Metrics in this report that regressed past `thresholds` relative to `baseline`.
+    ///
+    /// Modes missing from either report, and metrics whose baseline is zero,
+    /// are skipped.
+    package func regressions(
+        against baseline: V2RuntimeBenchmarkReport,
+        thresholds: V2RuntimeBenchmarkThresholds = .default
+    ) -> [V2RuntimeBenchmarkRegression] {
+        var regressions: [V2RuntimeBenchmarkRegression] = []
+
+        for point in results {
+            guard let reference = baseline.results.first(where: { $0.mode == point.mode }) else { continue }
+
+            func check(_ metric: String, _ old: Double, _ new: Double, lowerIsBetter: Bool, threshold: Double) {
+                guard old > 0 else { return }
+                let change = lowerIsBetter ? (new - old) / old : (old - new) / old
+                if change > threshold {
+                    regressions.append(
+                        V2RuntimeBenchmarkRegression(
+                            mode: point.mode,
+                            metric: metric,
+                            baseline: old,
+                            current: new,
+                            change: change
+                        )
+                    )
+                }
+            }
+
+            check("ttftMs", reference.ttftMs, point.ttftMs,
+                  lowerIsBetter: true, threshold: thresholds.ttftIncrease)
+            check("decodeTokensPerSecond", reference.decodeTokensPerSecond, point.decodeTokensPerSecond,
+                  lowerIsBetter: false, threshold: thresholds.decodeThroughputDecrease)
+            check("p95LatencyMs", reference.p95LatencyMs, point.p95LatencyMs,
+                  lowerIsBetter: true, threshold: thresholds.p95LatencyIncrease)
+            check("kvMemoryMB", reference.kvMemoryMB, point.kvMemoryMB,
+                  lowerIsBetter: true, threshold: thresholds.kvMemoryIncrease)
+        }
+        return regressions
+    }
+}
@@ -0,0 +1,137 @@
+// ByteLineSplitter.swift
+// Conduit
+//
+// Incremental line splitting over byte chunks with a moving read cursor.
+
+import Foundation
+
+/// Splits a stream of byte chunks into lines without per-byte work outside
+/// of a single linear scan.
+///
+/// Chunks are appended as they arrive from the transport. Complete lines are
+/// returned as slices of the internal buffer; consumed bytes are reclaimed at
+/// most once per appended chunk, so total work is linear in the stream length
+/// regardless of how long individual lines are.
+///
+/// Lines are delimited by `\n`, `\r`, or `\r\n`. Delimiters are not included
+/// in the returned slices. A `\r\n` pair split across two chunks is treated as
+/// a single delimiter.
+///
+/// ## Usage
+///
+/// ```swift
+/// var splitter = ByteLineSplitter()
+/// splitter.append(chunk)
+/// while let line = splitter.nextLine() {
+///     handle(line)
+/// }
+/// // At end of stream:
+/// if let trailing = splitter.finish() {
+///     handle(trailing)
+/// }
+/// ```
+internal struct ByteLineSplitter: Sendable {
+    private static let lineFeed = UInt8(ascii: "\n")
+    private static let carriageReturn = UInt8(ascii: "\r")
+
+    private var buffer: [UInt8] = []
+
+    /// Start of the first unconsumed byte.
+    private var readIndex = 0
+
+    /// Bytes before this index are known not to contain a delimiter.
+    private var scanIndex = 0
+
+    /// Set when the last delimiter was a `\r` at the very end of the buffer,
+    /// so a `\n` at the start of the next chunk must be dropped.
+    private var skipsLeadingLineFeed = false
+
+    init() {}
+
+    /// Number of bytes buffered that have not yet been returned as a line.
+    var bufferedByteCount: Int {
+        buffer.count - readIndex
+    }
+
+    /// Appends a chunk of bytes received from the transport.
+    mutating func append<Bytes: Collection>(_ chunk: Bytes) where Bytes.Element == UInt8 {
+        guard !chunk.isEmpty else { return }
+
+        compactIfNeeded()
+
+        if skipsLeadingLineFeed {
+            skipsLeadingLineFeed = false
+            if chunk.first == Self.lineFeed {
+                buffer.append(contentsOf: chunk.dropFirst())
+                return
+            }
+        }
+        buffer.append(contentsOf: chunk)
+    }
+
+    /// Returns the next complete line, or `nil` if more bytes are needed.
+    mutating func nextLine() -> ArraySlice<UInt8>? {
+        let count = buffer.count
+        guard scanIndex < count else { return nil }
+
+        let delimiterIndex: Int? = buffer.withUnsafeBufferPointer { pointer in
+            var index = scanIndex
+            while index < count {
+                let byte = pointer[index]
+                if byte == Self.lineFeed || byte == Self.carriageReturn {
+                    return index
+                }
+                index += 1
+            }
+            return nil
+        }
+
+        guard let delimiterIndex else {
+            scanIndex = count
+            return nil
+        }
+
+        let line = buffer[readIndex..<delimiterIndex]
+        var nextIndex = delimiterIndex + 1
+        if buffer[delimiterIndex] == Self.carriageReturn {
+            if nextIndex < count {
+                if buffer[nextIndex] == Self.lineFeed {
+                    nextIndex += 1
+                }
+            } else {
+                skipsLeadingLineFeed = true
+            }
+        }
+
+        readIndex = nextIndex
+        scanIndex = nextIndex
+        return line
+    }
+
+    /// Flushes any trailing bytes that were not terminated by a delimiter.
+    ///
+    /// Call once at end of stream. Returns `nil` when nothing remains.
+    mutating func finish() -> ArraySlice<UInt8>? {
+        defer {
+            buffer.removeAll()
+            readIndex = 0
+            scanIndex = 0
+            skipsLeadingLineFeed = false
+        }
+        guard readIndex < buffer.count else { return nil }
+        return buffer[readIndex...]
+    }
+
+    // MARK: - Private
+
+    private mutating func compactIfNeeded() {
+        guard readIndex > 0 else { return }
+        if readIndex == buffer.count {
+            buffer.removeAll(keepingCapacity: true)
+        } else {
+            buffer.removeSubrange(0..<readIndex)
+        }
+        scanIndex -= readIndex
+        readIndex = 0
+    }
+}
@@ -0,0 +1,80 @@
+// CachedEmbeddingGenerator.swift
+// Conduit
+//
+// Serves repeated embeddings from a ResponseCache.
+
+import Foundation
+
+/// An ``EmbeddingGenerator`` that answers repeated texts from a ``ResponseCache``.
+///
+/// Each text is keyed by its model and content. Batch calls look up every
+/// text, then send only the misses to the wrapped generator in one batch.
+/// Concurrent single-text calls for the same text share one request.
+///
+/// ## Usage
+/// ```swift
+/// let embedder = CachedEmbeddingGenerator(OpenAIProvider(apiKey: "sk-..."), cache: cache)
+/// let vectors = try await embedder.embedBatch(chunks, model: .textEmbedding3Small)
+/// ```
+public actor CachedEmbeddingGenerator<Base: EmbeddingGenerator>: EmbeddingGenerator {
+    public typealias ModelID = Base.ModelID
+
+    /// The wrapped generator.
+    public nonisolated let base: Base
+
+    /// The cache embeddings are read from and written to.
+    public nonisolated let cache: ResponseCache
+
+    /// Creates a caching wrapper around `base`.
+    ///
+    /// - Parameters:
+    ///   - base: The generator that serves cache misses.
+    ///   - cache: The response store. Default: a new in-memory cache
+    public init(_ base: Base, cache: ResponseCache = ResponseCache()) {
+        self.base = base
+        self.cache = cache
+    }
+
+    // MARK: - EmbeddingGenerator
+
+    public func embed(_ text: String, model: ModelID) async throws -> EmbeddingResult {
+        let base = base
+        let key = cache.key(embedding: text, model: model)
+        let cached = try await cache.value(for: key, as: CachedEmbedding.self) {
+            CachedEmbedding(try await base.embed(text, model: model))
+        }
+        return cached.result
+    }
+
+    public func embedBatch(_ texts: [String], model: ModelID) async throws -> [EmbeddingResult] {
+        let keys = texts.map { cache.key(embedding: $0, model: model) }
+        var results = [EmbeddingResult?](repeating: nil, count: texts.count)
+        var missing: [Int] = []
+
+        for (index, key) in keys.enumerated() {
+            if let cached = await cache.cachedValue(for: key, as: CachedEmbedding.self) {
+                results[index] = cached.result
+            } else {
+                missing.append(index)
+            }
+        }
+
+        if !missing.isEmpty {
+            let fetched = try await base.embedBatch(missing.map { texts[$0] }, model: model)
+            guard fetched.count == missing.count else {
+                throw AIError.generationFailed(underlying: SendableError(
+                    localizedDescription: "Expected \(missing.count) embeddings, received \(fetched.count)"
+                ))
+            }
+            for (index, result) in zip(missing, fetched) {
+                results[index] = result
+                await cache.store(CachedEmbedding(result), for: keys[index])
+            }
+        }
+        return results.compactMap { $0 }
+    }
+
+    public func embedMatrix(_ texts: [String], model: ModelID) async throws -> EmbeddingMatrix {
+        try EmbeddingMatrix(try await embedBatch(texts, model: model))
+    }
+}
@@ -0,0 +1,355 @@
+// CachedTextGenerator.swift
+// Conduit
+//
+// Serves repeated deterministic generations from a ResponseCache.
+
+import Foundation
+
+/// A ``TextGenerator`` that answers repeated requests from a ``ResponseCache``.
+///
+/// Requests are keyed by their model, messages and ``GenerateConfig``. A hit
+/// returns the stored ``GenerationResult`` without contacting the wrapped
+/// generator; streaming hits replay it as a text chunk followed by a
+/// completion chunk. Misses go to the wrapped generator and are stored when
+/// they complete. Requests the cache declines to key, such as sampled
+/// generations, pass straight through.
+///
+/// When the wrapped generator is also an ``AIProvider``, so is the wrapper,
+/// which lets it back a ``ChatSession`` or `Provider.custom`.
+///
+/// ## Usage
+/// ```swift
+/// let cached = CachedTextGenerator(AnthropicProvider(apiKey: "sk-ant-..."))
+/// let session = ChatSession(provider: cached, model: .claudeSonnet46, config: .default.temperature(0))
+/// ```
+///
+/// Streamed responses are only stored once the stream completes. Identical
+/// streams in flight at the same time share one upstream stream: a request
+/// that joins late first receives the chunks sent so far, and the upstream
+/// is cancelled only once every request has stopped listening.
+public actor CachedTextGenerator<Base: TextGenerator>: TextGenerator {
+    public typealias ModelID = Base.ModelID
+
+    /// The wrapped generator.
+    public nonisolated let base: Base
+
+    /// The cache responses are read from and written to.
+    public nonisolated let cache: ResponseCache
+
+    private var inFlightStreams: [ResponseCache.Key: StreamBroadcast] = [:]
+
+    /// Creates a caching wrapper around `base`.
+    ///
+    /// - Parameters:
+    ///   - base: The generator that serves cache misses.
+    ///   - cache: The response store. Default: a new in-memory cache
+    public init(_ base: Base, cache: ResponseCache = ResponseCache()) {
+        self.base = base
+        self.cache = cache
+    }
+
+    // MARK: - TextGenerator
+
+    public func generate(_ prompt: String, model: ModelID, config: GenerateConfig) async throws -> String {
+        try await generate(messages: [.user(prompt)], model: model, config: config).text
+    }
+
+    public func generate(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) async throws -> GenerationResult {
+        let base = base
+        guard let key = cache.key(messages: messages, model: model, config: config) else {
+            return try await base.generate(messages: messages, model: model, config: config)
+        }
+        let cached = try await cache.value(for: key, as: CachedGeneration.self) {
+            CachedGeneration(try await base.generate(messages: messages, model: model, config: config))
+        }
+        return cached.result
+    }
+
+    public nonisolated func stream(
+        _ prompt: String,
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<String, Error> {
+        let chunks = streamWithMetadata(messages: [.user(prompt)], model: model, config: config)
+        return AsyncThrowingStream { continuation in
+            let task = Task {
+                do {
+                    for try await chunk in chunks where !chunk.text.isEmpty {
+                        continuation.yield(chunk.text)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+
+    public nonisolated func streamWithMetadata(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        guard let key = cache.key(messages: messages, model: model, config: config) else {
+            return base.streamWithMetadata(messages: messages, model: model, config: config)
+        }
+        return AsyncThrowingStream { continuation in
+            let task = Task {
+                do {
+                    let chunks = await self.sharedStream(for: key, messages: messages, model: model, config: config)
+                    for try await chunk in chunks {
+                        continuation.yield(chunk)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+
+    // MARK: - Stream Sharing
+
+    /// Joins the identical stream in flight, or starts one that later requests can join.
+    ///
+    /// A new stream replays the cached response if there is one, and otherwise
+    /// streams from ``base`` and stores the result once it completes.
+    private func sharedStream(
+        for key: ResponseCache.Key,
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) async -> AsyncThrowingStream<GenerationChunk, Error> {
+        if let chunks = inFlightStreams[key]?.subscribe() {
+            await cache.recordCoalescedRequest()
+            return chunks
+        }
+
+        let (shared, chunks) = StreamBroadcast.make()
+        inFlightStreams[key] = shared
+        let base = base, cache = cache
+        shared.start {
+            if let cached = await cache.cachedValue(for: key, as: CachedGeneration.self) {
+                for chunk in cached.chunks {
+                    shared.yield(chunk)
+                }
+                return
+            }
+
+            var recorder = StreamRecorder()
+            for try await chunk in base.streamWithMetadata(messages: messages, model: model, config: config) {
+                recorder.append(chunk)
+                shared.yield(chunk)
+            }
+            try Task.checkCancellation()
+            if let generation = recorder.generation {
+                await cache.store(generation, for: key)
+            }
+        } onEnd: {
+            await self.endStream(shared, for: key)
+        }
+        return chunks
+    }
+
+    private func endStream(_ shared: StreamBroadcast, for key: ResponseCache.Key) {
+        if inFlightStreams[key] === shared {
+            inFlightStreams[key] = nil
+        }
+    }
+}
+
+// MARK: - AIProvider
+
+extension CachedTextGenerator: AIProvider where Base: AIProvider {
+    public typealias Response = GenerationResult
+    public typealias StreamChunk = GenerationChunk
+
+    public var isAvailable: Bool {
+        get async { await base.isAvailable }
+    }
+
+    public var availabilityStatus: ProviderAvailability {
+        get async { await base.availabilityStatus }
+    }
+
+    public nonisolated func stream(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        streamWithMetadata(messages: messages, model: model, config: config)
+    }
+
+    public func cancelGeneration() async {
+        await base.cancelGeneration()
+    }
+}
+
+// MARK: - Stream Recording
+
+/// Assembles streamed chunks into a ``CachedGeneration``.
+private struct StreamRecorder {
+    private var text = ""
+    private var tokenCount = 0
+    private var finishReason: FinishReason?
+    private var usage: UsageStats?
+    private var toolCalls: [Transcript.ToolCall] = []
+    private var reasoningDetails: [ReasoningDetail] = []
+    private let start = Date()
+
+    mutating func append(_ chunk: GenerationChunk) {
+        text += chunk.text
+        tokenCount += chunk.tokenCount
+        finishReason = chunk.finishReason ?? finishReason
+        usage = chunk.usage ?? usage
+        if let calls = chunk.completedToolCalls {
+            toolCalls = calls
+        }
+        if let details = chunk.reasoningDetails {
+            reasoningDetails += details
+        }
+    }
+
+    /// The recorded generation, or `nil` if the stream never reported how it finished.
+    var generation: CachedGeneration? {
+        guard let finishReason else { return nil }
+        let elapsed = Date().timeIntervalSince(start)
+        let tokens = usage?.completionTokens ?? tokenCount
+        return CachedGeneration(GenerationResult(
+            text: text,
+            tokenCount: tokens,
+            generationTime: elapsed,
+            tokensPerSecond: elapsed > 0 ? Double(tokens) / elapsed : 0,
+            finishReason: finishReason,
+            usage: usage,
+            toolCalls: toolCalls,
+            reasoningDetails: reasoningDetails
+        ))
+    }
+}
+
+// MARK: - Stream Broadcast
+
+/// Sends the chunks of one upstream stream to every request sharing it.
+///
+/// Chunks are kept until the stream ends, so a subscriber that joins late
+/// first receives everything sent so far. When the last subscriber leaves
+/// before the end, the upstream is cancelled and the broadcast takes no new
+/// subscribers.
+private final class StreamBroadcast: @unchecked Sendable {
+    typealias Chunks = AsyncThrowingStream<GenerationChunk, Error>
+
+    private let lock = NSLock()
+    private var received: [GenerationChunk] = []
+    private var subscribers: [Int: Chunks.Continuation] = [:]
+    private var nextSubscriber = 0
+    private var producer: Task<Void, Never>?
+    private var isFinished = false
+    private var failure: Error?
+    private var isAbandoned = false
+
+    /// Creates a broadcast together with its first subscriber's stream.
+    static func make() -> (broadcast: StreamBroadcast, chunks: Chunks) {
+        let broadcast = StreamBroadcast()
+        let (chunks, continuation) = Chunks.makeStream()
+        broadcast.attach(continuation)
+        return (broadcast, chunks)
+    }
+
+    /// A stream of the chunks sent so far followed by the rest, or `nil` if
+    /// every subscriber has left and the upstream is being cancelled.
+    func subscribe() -> Chunks? {
+        let (chunks, continuation) = Chunks.makeStream()
+        return attach(continuation) ? chunks : nil
+    }
+
+    /// Runs `produce`, then `onEnd`, then ends every subscriber's stream the way `produce` ended.
+    func start(_ produce: @escaping @Sendable () async throws -> Void, onEnd: @escaping @Sendable () async -> Void) {
+        let task = Task {
+            var failure: Error?
+            do {
+                try await produce()
+            } catch {
+                failure = error
+            }
+            await onEnd()
+            self.finish(throwing: failure)
+        }
+        let abandoned = withLock {
+            producer = task
+            return isAbandoned
+        }
+        if abandoned {
+            task.cancel()
+        }
+    }
+
+    /// Sends `chunk` to every subscriber and keeps it for later ones.
+    func yield(_ chunk: GenerationChunk) {
+        withLock {
+            received.append(chunk)
+            for subscriber in subscribers.values {
+                subscriber.yield(chunk)
+            }
+        }
+    }
+
+    // Chunks are yielded under the lock to keep replay and live chunks in
+    // order. Streams are finished outside it, because finishing runs
+    // `onTermination`, which takes the lock again.
+    @discardableResult
+    private func attach(_ continuation: Chunks.Continuation) -> Bool {
+        let outcome: (accepted: Bool, finished: Bool, failure: Error?) = withLock {
+            guard !isAbandoned else { return (false, false, nil) }
+            for chunk in received {
+                continuation.yield(chunk)
+            }
+            guard !isFinished else { return (true, true, failure) }
+
+            let id = nextSubscriber
+            nextSubscriber += 1
+            subscribers[id] = continuation
+            continuation.onTermination = { [weak self] _ in self?.detach(id) }
+            return (true, false, nil)
+        }
+        if outcome.finished {
+            continuation.finish(throwing: outcome.failure)
+        }
+        return outcome.accepted
+    }
+
+    private func detach(_ id: Int) {
+        let abandoned: Task<Void, Never>? = withLock {
+            subscribers[id] = nil
+            guard subscribers.isEmpty, !isFinished else { return nil }
+            isAbandoned = true
+            return producer
+        }
+        abandoned?.cancel()
+    }
+
+    private func finish(throwing failure: Error?) {
+        let finished = withLock {
+            isFinished = true
+            self.failure = failure
+            producer = nil
+            defer { subscribers.removeAll() }
+            return Array(subscribers.values)
+        }
+        for subscriber in finished {
+            subscriber.finish(throwing: failure)
+        }
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
@@ -0,0 +1,440 @@
+// ConduitTransport.swift
+// Conduit
+//
+// Shared HTTP transport for cloud providers.
+
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// A shared, tunable HTTP transport for cloud providers.
+///
+/// Each cloud provider creates its own `URLSession` by default, so an app
+/// talking to several providers, or creating providers per request, keeps
+/// several connection pools and repeats DNS and TLS setup. Passing one
+/// transport to every provider shares a single pool, applies one set of
+/// connection limits and proxy settings, and exposes live gauges for the
+/// requests in flight and queued.
+///
+/// ## Usage
+/// ```swift
+/// let transport = ConduitTransport(configuration: .init(
+///     maxConnectionsPerHost: 16,
+///     maxConcurrentRequestsPerHost: 32
+/// ))
+///
+/// var openAI = OpenAIConfiguration.openAI(apiKey: "sk-...")
+/// openAI.transport = transport
+/// let gpt = OpenAIProvider(configuration: openAI)
+/// let claude = AnthropicProvider(apiKey: "sk-ant-...", transport: transport)
+///
+/// // Open connections before the first request
+/// await transport.prewarm(URL(string: "https://api.openai.com")!)
+///
+/// print(transport.metrics.inFlightRequests)
+/// ```
+///
+/// Time spent waiting for a per-host slot and, for streaming requests,
+/// time to the response headers are reported to ``ConduitTelemetry`` as
+/// ``TelemetryStage/queueWait`` and ``TelemetryStage/connect``, keyed by host.
+///
+/// ## Thread Safety
+/// Gauges and the per-host queue are protected by an NSLock that is never
+/// held across await points, so the transport can be shared freely.
+///
+/// - Note: Idle keep-alive timing is managed by the system URL loading
+///   stack; reuse is tuned through ``Configuration/maxConnectionsPerHost``
+///   and ``Configuration/usesHTTPPipelining``.
+public final class ConduitTransport: @unchecked Sendable, Hashable {
+
+    // MARK: - Configuration
+
+    /// Connection, timeout, and queueing settings for a transport.
+    public struct Configuration: Sendable, Hashable {
+
+        /// Maximum simultaneous connections to a single host.
+        public var maxConnectionsPerHost: Int
+
+        /// Maximum requests running at once against a single host, or `nil`
+        /// for no limit.
+        ///
+        /// Requests above the limit wait in first-in, first-out order and are
+        /// reported by ``Metrics/queuedRequests``. A streaming request holds
+        /// its slot until the response body ends.
+        public var maxConcurrentRequestsPerHost: Int?
+
+        /// Seconds to wait for more data before a request times out.
+        ///
+        /// Providers override this per request with their own timeout.
+        public var requestTimeout: TimeInterval
+
+        /// Seconds a request may take in total, including streaming.
+        public var resourceTimeout: TimeInterval
+
+        /// Whether requests wait for connectivity instead of failing
+        /// immediately when the network is unavailable.
+        public var waitsForConnectivity: Bool
+
+        /// Whether HTTP/1.1 pipelining is used.
+        public var usesHTTPPipelining: Bool
+
+        /// Proxy for all requests, or `nil` to use the system settings.
+        public var proxy: Proxy?
+
+        /// Headers added to every request.
+        ///
+        /// Headers set on a request take precedence.
+        public var additionalHeaders: [String: String]
+
+        /// Creates a transport configuration.
+        ///
+        /// - Parameters:
+        ///   - maxConnectionsPerHost: Connections per host. Clamped to at least 1. Default: 8
+        ///   - maxConcurrentRequestsPerHost: Requests per host before queueing.
+        ///     Clamped to at least 1. Default: no limit
+        ///   - requestTimeout: Idle timeout in seconds. Default: 60
+        ///   - resourceTimeout: Total timeout in seconds. Default: 600
+        ///   - waitsForConnectivity: Wait for connectivity. Default: false
+        ///   - usesHTTPPipelining: Use HTTP/1.1 pipelining. Default: false
+        ///   - proxy: Proxy server. Default: system settings
+        ///   - additionalHeaders: Headers for every request. Default: none
+        public init(
+            maxConnectionsPerHost: Int = 8,
+            maxConcurrentRequestsPerHost: Int? = nil,
+            requestTimeout: TimeInterval = 60,
+            resourceTimeout: TimeInterval = 600,
+            waitsForConnectivity: Bool = false,
+            usesHTTPPipelining: Bool = false,
+            proxy: Proxy? = nil,
+            additionalHeaders: [String: String] = [:]
+        ) {
+            self.maxConnectionsPerHost = max(1, maxConnectionsPerHost)
+            self.maxConcurrentRequestsPerHost = maxConcurrentRequestsPerHost.map { max(1, $0) }
+            self.requestTimeout = requestTimeout
+            self.resourceTimeout = resourceTimeout
+            self.waitsForConnectivity = waitsForConnectivity
+            self.usesHTTPPipelining = usesHTTPPipelining
+            self.proxy = proxy
+            self.additionalHeaders = additionalHeaders
+        }
+
+        /// Default configuration.
+        public static let `default` = Configuration()
+
+        /// Builds the URL session configuration for these settings.
+        internal func makeSessionConfiguration() -> URLSessionConfiguration {
+            let config = URLSessionConfiguration.default
+            config.httpMaximumConnectionsPerHost = maxConnectionsPerHost
+            config.timeoutIntervalForRequest = requestTimeout
+            config.timeoutIntervalForResource = resourceTimeout
+            config.httpShouldUsePipelining = usesHTTPPipelining
+            #if !canImport(FoundationNetworking)
+            config.waitsForConnectivity = waitsForConnectivity
+            #endif
+            if !additionalHeaders.isEmpty {
+                config.httpAdditionalHeaders = additionalHeaders
+            }
+            if let proxy {
+                config.connectionProxyDictionary = proxy.dictionary
+            }
+            return config
+        }
+    }
+
+    /// A proxy server used for every request.
+    public struct Proxy: Sendable, Hashable {
+
+        /// The proxy protocol.
+        public enum Kind: String, Sendable, Hashable {
+            /// An HTTP proxy, used for both `http` and `https` requests.
+            case http
+
+            /// A SOCKS proxy.
+            case socks
+        }
+
+        /// Proxy protocol.
+        public var kind: Kind
+
+        /// Proxy host name or address.
+        public var host: String
+
+        /// Proxy port.
+        public var port: Int
+
+        /// Creates a proxy setting.
+        public init(kind: Kind = .http, host: String, port: Int) {
+            self.kind = kind
+            self.host = host
+            self.port = port
+        }
+
+        /// The `connectionProxyDictionary` entries for this proxy.
+        internal var dictionary: [AnyHashable: Any] {
+            switch kind {
+            case .http:
+                return [
+                    "HTTPEnable": 1, "HTTPProxy": host, "HTTPPort": port,
+                    "HTTPSEnable": 1, "HTTPSProxy": host, "HTTPSPort": port,
+                ]
+            case .socks:
+                return ["SOCKSEnable": 1, "SOCKSProxy": host, "SOCKSPort": port]
+            }
+        }
+    }
+
+    // MARK: - Metrics
+
+    /// A snapshot of the transport's request gauges.
+    public struct Metrics: Sendable, Hashable {
+
+        /// Gauges for a single host.
+        public struct Host: Sendable, Hashable {
+            /// Requests currently running.
+            public var inFlightRequests: Int = 0
+
+            /// Requests waiting for a per-host slot.
+            public var queuedRequests: Int = 0
+        }
+
+        /// Requests currently running across all hosts.
+        public var inFlightRequests: Int
+
+        /// Requests waiting for a per-host slot across all hosts.
+        public var queuedRequests: Int
+
+        /// Requests that have finished, successfully or not.
+        public var completedRequests: Int
+
+        /// Per-host gauges, keyed by host name. Idle hosts are omitted.
+        public var hosts: [String: Host]
+    }
+
+    // MARK: - Properties
+
+    /// A transport with the default configuration.
+    ///
+    /// Used by services that are not tied to a provider, such as model
+    /// metadata lookups and tokenizer downloads.
+    public static let shared = ConduitTransport()
+
+    /// The settings this transport was created with.
+    public let configuration: Configuration
+
+    /// The session that carries every request.
+    internal let session: URLSession
+
+    private let lock = NSLock()
+    private var hosts: [String: HostState] = [:]
+    private var completedRequests = 0
+    private var prewarmedOrigins: [String: ContinuousClock.Instant] = [:]
+
+    /// How long a prewarmed origin is skipped by later ``prewarm(_:)`` calls.
+    private static let prewarmInterval: Duration = .seconds(30)
+
+    private struct HostState {
+        var inFlight = 0
+        var waiters: [CheckedContinuation<Void, Never>] = []
+    }
+
+    // MARK: - Initialization
+
+    /// Creates a transport.
+    ///
+    /// - Parameter configuration: Connection, timeout, and queueing settings.
+    public init(configuration: Configuration = .default) {
+        self.configuration = configuration
+        self.session = URLSession(configuration: configuration.makeSessionConfiguration())
+    }
+
+    /// Returns `shared` if set, or a private transport for one provider.
+    ///
+    /// The private transport applies `timeout` per request and twice that
+    /// per resource, matching a provider-owned session.
+    internal static func resolve(_ shared: ConduitTransport?, timeout: TimeInterval) -> ConduitTransport {
+        shared ?? ConduitTransport(configuration: Configuration(
+            requestTimeout: timeout,
+            resourceTimeout: timeout * 2
+        ))
+    }
+
+    deinit {
+        session.finishTasksAndInvalidate()
+    }
+
+    // MARK: - Requests
+
+    /// Loads `request` and returns the whole response body.
+    ///
+    /// - Parameter request: The request to send.
+    /// - Returns: The response body and metadata.
+    /// - Throws: `URLError` if the request fails.
+    public func data(for request: URLRequest) async throws -> (Data, URLResponse) {
+        let host = Self.hostKey(for: request)
+        await ConduitTelemetry.measure(.queueWait, source: host) { await acquire(host) }
+        defer { release(host) }
+        return try await session.data(for: request)
+    }
+
+    /// Streams the response body of `request` as it arrives.
+    ///
+    /// The request holds its per-host slot until the returned stream ends
+    /// or is dropped.
+    ///
+    /// - Parameter request: The request to send.
+    /// - Returns: The response body stream and metadata.
+    /// - Throws: `URLError` if the request fails.
+    public func asyncBytes(for request: URLRequest) async throws -> (URLSessionAsyncBytes, URLResponse) {
+        let host = Self.hostKey(for: request)
+        await ConduitTelemetry.measure(.queueWait, source: host) { await acquire(host) }
+
+        let released = ReleaseOnce { [weak self] in self?.release(host) }
+        do {
+            let (chunks, response) = try await ConduitTelemetry.measure(.connect, source: host) {
+                try await session.asyncChunks(
+                    for: request,
+                    linuxConfiguration: configuration.makeSessionConfiguration(),
+                    onTermination: { released.run() }
+                )
+            }
+            return (URLSessionAsyncBytes(chunks: chunks), response)
+        } catch {
+            released.run()
+            throw error
+        }
+    }
+
+    /// Opens a connection to the origin of `url` ahead of the first request.
+    ///
+    /// Sends a `HEAD` request to the origin so DNS resolution and the TLS
+    /// handshake are done before a latency-sensitive call. The response,
+    /// including any error status, is ignored. Origins prewarmed in the last
+    /// 30 seconds are skipped.
+    ///
+    /// - Parameter url: Any URL on the origin to warm up.
+    public func prewarm(_ url: URL) async {
+        guard var components = URLComponents(url: url, resolvingAgainstBaseURL: false),
+              components.host != nil else { return }
+        components.path = "/"
+        components.query = nil
+        components.fragment = nil
+        guard let origin = components.url else { return }
+
+        let now = ContinuousClock.now
+        let isFresh: Bool = withLock {
+            if let last = prewarmedOrigins[origin.absoluteString], now - last < Self.prewarmInterval {
+                return false
+            }
+            prewarmedOrigins[origin.absoluteString] = now
+            return true
+        }
+        guard isFresh else { return }
+
+        var request = URLRequest(url: origin)
+        request.httpMethod = "HEAD"
+        request.timeoutInterval = 10
+        _ = try? await data(for: request)
+    }
+
+    /// A snapshot of the current request gauges.
+    public var metrics: Metrics {
+        withLock {
+            var metrics = Metrics(
+                inFlightRequests: 0,
+                queuedRequests: 0,
+                completedRequests: completedRequests,
+                hosts: [:]
+            )
+            for (host, state) in hosts {
+                metrics.inFlightRequests += state.inFlight
+                metrics.queuedRequests += state.waiters.count
+                metrics.hosts[host] = Metrics.Host(
+                    inFlightRequests: state.inFlight,
+                    queuedRequests: state.waiters.count
+                )
+            }
+            return metrics
+        }
+    }
+
+    // MARK: - Per-Host Slots
+
+    /// Waits for a slot on `host`, counting the request as in flight.
+    internal func acquire(_ host: String) async {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            let startsNow: Bool = withLock {
+                var state = hosts[host] ?? HostState()
+                defer { hosts[host] = state }
+                if let limit = configuration.maxConcurrentRequestsPerHost, state.inFlight >= limit {
+                    state.waiters.append(continuation)
+                    return false
+                }
+                state.inFlight += 1
+                return true
+            }
+            if startsNow {
+                continuation.resume()
+            }
+        }
+    }
+
+    /// Frees a slot on `host`, handing it to the oldest queued request.
+    internal func release(_ host: String) {
+        let next: CheckedContinuation<Void, Never>? = withLock {
+            completedRequests += 1
+            guard var state = hosts[host] else { return nil }
+            if state.waiters.isEmpty {
+                state.inFlight -= 1
+                hosts[host] = state.inFlight > 0 ? state : nil
+                return nil
+            }
+            // The slot passes straight to the next waiter
+            let next = state.waiters.removeFirst()
+            hosts[host] = state
+            return next
+        }
+        next?.resume()
+    }
+
+    // MARK: - Hashable
+
+    public static func == (lhs: ConduitTransport, rhs: ConduitTransport) -> Bool {
+        lhs === rhs
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        hasher.combine(ObjectIdentifier(self))
+    }
+
+    // MARK: - Private
+
+    private static func hostKey(for request: URLRequest) -> String {
+        request.url?.host?.lowercased() ?? ""
+    }
+
+    private func withLock<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
+    }
+}
+
+/// Runs a closure at most once, from whichever path finishes first.
+private final class ReleaseOnce: @unchecked Sendable {
+    private let lock = NSLock()
+    private var action: (() -> Void)?
+
+    init(_ action: @escaping () -> Void) {
+        self.action = action
+    }
+
+    func run() {
+        lock.lock()
+        let action = self.action
+        self.action = nil
+        lock.unlock()
+        action?()
+    }
+}
@@ -0,0 +1,216 @@
+// EmbeddingMicroBatcher.swift
+// Conduit
+//
+// Coalesces concurrent single-text embedding calls into batched requests.
+
+import Foundation
+
+/// Merges concurrent ``embed(_:model:)`` calls into batched provider requests.
+///
+/// Indexing pipelines often embed one chunk at a time from many concurrent
+/// tasks. Sent directly, each call is its own round trip. The batcher holds
+/// calls for the same model for at most ``Configuration/maxLatency``, then
+/// sends them together through the wrapped provider's
+/// ``EmbeddingGenerator/embedMatrix(_:model:)``. A batch is sent early once
+/// it reaches ``Configuration/maxBatchSize`` texts or
+/// ``Configuration/maxBatchTokens`` estimated tokens. At most
+/// ``Configuration/maxConcurrentBatches`` batches are in flight; later
+/// batches wait for a free slot.
+///
+/// The batcher is itself an ``EmbeddingGenerator``, so it can replace the
+/// provider wherever one is expected. Batch calls pass straight through.
+///
+/// ## Usage
+/// ```swift
+/// let batcher = EmbeddingMicroBatcher(provider: OpenAIProvider(apiKey: "sk-..."))
+///
+/// try await withThrowingTaskGroup(of: EmbeddingResult.self) { group in
+///     for chunk in chunks {
+///         group.addTask { try await batcher.embed(chunk, model: .textEmbedding3Small) }
+///     }
+///     for try await embedding in group {
+///         await store.insert(embedding)
+///     }
+/// }
+/// ```
+///
+/// - Note: If a batch fails, every call in it receives the error. Cancelling
+///   one caller does not cancel the shared request.
+public actor EmbeddingMicroBatcher<Provider: EmbeddingGenerator>: EmbeddingGenerator {
+    public typealias ModelID = Provider.ModelID
+
+    // MARK: - Configuration
+
+    /// Batching window and size limits.
+    public struct Configuration: Sendable, Hashable {
+
+        /// Longest a call waits for other calls before its batch is sent.
+        public var maxLatency: Duration
+
+        /// Maximum texts per batch.
+        public var maxBatchSize: Int
+
+        /// Maximum estimated tokens per batch, or `nil` for no budget.
+        ///
+        /// Estimated with ``EmbeddingBatchPolicy/estimatedTokens(in:)``.
+        public var maxBatchTokens: Int?
+
+        /// Maximum batches sent to the provider at once.
+        public var maxConcurrentBatches: Int
+
+        /// Creates a batching configuration.
+        ///
+        /// - Parameters:
+        ///   - maxLatency: Batching window. Default: 5 ms
+        ///   - maxBatchSize: Texts per batch. Clamped to at least 1. Default: 64
+        ///   - maxBatchTokens: Estimated tokens per batch. Default: 8192
+        ///   - maxConcurrentBatches: Batches in flight. Clamped to at least 1. Default: 4
+        public init(
+            maxLatency: Duration = .milliseconds(5),
+            maxBatchSize: Int = 64,
+            maxBatchTokens: Int? = 8192,
+            maxConcurrentBatches: Int = 4
+        ) {
+            self.maxLatency = maxLatency
+            self.maxBatchSize = max(1, maxBatchSize)
+            self.maxBatchTokens = maxBatchTokens.map { max(1, $0) }
+            self.maxConcurrentBatches = max(1, maxConcurrentBatches)
+        }
+
+        /// Default configuration.
+        public static let `default` = Configuration()
+    }
+
+    // MARK: - State
+
+    private struct PendingCall {
+        let text: String
+        let continuation: CheckedContinuation<EmbeddingResult, Error>
+    }
+
+    private struct Queue {
+        var calls: [PendingCall] = []
+        var tokens = 0
+
+        /// Identifies the current window so stale timers don't flush a newer one.
+        var window = 0
+    }
+
+    private let provider: Provider
+
+    /// Batching limits.
+    public nonisolated let configuration: Configuration
+
+    private var queues: [ModelID: Queue] = [:]
+    private var readyBatches: [(model: ModelID, calls: [PendingCall])] = []
+    private var inFlightBatches = 0
+    private var nextWindow = 0
+
+    // MARK: - Initialization
+
+    /// Creates a micro-batcher in front of `provider`.
+    ///
+    /// - Parameters:
+    ///   - provider: The provider that receives batched requests.
+    ///   - configuration: Batching window and limits.
+    public init(provider: Provider, configuration: Configuration = .default) {
+        self.provider = provider
+        self.configuration = configuration
+    }
+
+    // MARK: - EmbeddingGenerator
+
+    /// Embeds `text` as part of the next batch for `model`.
+    public func embed(_ text: String, model: ModelID) async throws -> EmbeddingResult {
+        try await withCheckedThrowingContinuation { continuation in
+            enqueue(PendingCall(text: text, continuation: continuation), model: model)
+        }
+    }
+
+    /// Embeds `texts` directly through the provider.
+    public func embedBatch(_ texts: [String], model: ModelID) async throws -> [EmbeddingResult] {
+        try await provider.embedBatch(texts, model: model)
+    }
+
+    /// Embeds `texts` directly through the provider.
+    public func embedMatrix(_ texts: [String], model: ModelID) async throws -> EmbeddingMatrix {
+        try await provider.embedMatrix(texts, model: model)
+    }
+
+    // MARK: - Batching
+
+    private func enqueue(_ call: PendingCall, model: ModelID) {
+        let tokens = EmbeddingBatchPolicy.estimatedTokens(in: call.text)
+        var queue = queues[model] ?? Queue()
+
+        // Send the open window first if this call would exceed its token budget
+        if let budget = configuration.maxBatchTokens, !queue.calls.isEmpty, queue.tokens + tokens > budget {
+            queues[model] = queue
+            flush(model)
+            queue = queues[model] ?? Queue()
+        }
+
+        if queue.calls.isEmpty {
+            nextWindow += 1
+            queue.window = nextWindow
+            scheduleFlush(model, window: queue.window)
+        }
+        queue.calls.append(call)
+        queue.tokens += tokens
+        queues[model] = queue
+
+        if queue.calls.count >= configuration.maxBatchSize {
+            flush(model)
+        }
+    }
+
+    private func scheduleFlush(_ model: ModelID, window: Int) {
+        let latency = configuration.maxLatency
+        Task {
+            try? await Task.sleep(for: latency)
+            await self.flushWindow(model, window: window)
+        }
+    }
+
+    private func flushWindow(_ model: ModelID, window: Int) {
+        guard queues[model]?.window == window else { return }
+        flush(model)
+    }
+
+    private func flush(_ model: ModelID) {
+        guard let queue = queues.removeValue(forKey: model), !queue.calls.isEmpty else { return }
+        readyBatches.append((model, queue.calls))
+        dispatchReadyBatches()
+    }
+
+    private func dispatchReadyBatches() {
+        while inFlightBatches < configuration.maxConcurrentBatches, !readyBatches.isEmpty {
+            let batch = readyBatches.removeFirst()
+            inFlightBatches += 1
+            Task {
+                await self.run(batch.calls, model: batch.model)
+            }
+        }
+    }
+
+    private func run(_ calls: [PendingCall], model: ModelID) async {
+        do {
+            let matrix = try await provider.embedMatrix(calls.map(\.text), model: model)
+            guard matrix.count == calls.count else {
+                throw AIError.generationFailed(underlying: SendableError(
+                    localizedDescription: "Expected \(calls.count) embeddings, received \(matrix.count)"
+                ))
+            }
+            for (row, call) in calls.enumerated() {
+                call.continuation.resume(returning: matrix.result(at: row))
+            }
+        } catch {
+            for call in calls {
+                call.continuation.resume(throwing: error)
+            }
+        }
+
+        inFlightBatches -= 1
+        dispatchReadyBatches()
+    }
+}
@@ -0,0 +1,433 @@
+// MediaCache.swift
+// Conduit
+//
+// Content-addressed cache of prepared image payloads and provider file references.
+
+import Foundation
+
+#if canImport(ImageIO)
+import ImageIO
+#endif
+
+// MARK: - MediaCache
+
+/// A content-addressed store for the image payloads sent to cloud providers.
+///
+/// A multimodal ``ChatSession`` resends every earlier image on every turn.
+/// Without a cache, each request rebuilds every image's `data:` URL from its
+/// Base64 text and uploads the full-size bytes again.
+/// `MediaCache` keys each ``Message/ImageContent`` by a SHA-256 digest of
+/// its MIME type and data. The first request prepares the payload, which
+/// includes an optional downscale to ``Configuration/maxPixelDimension``.
+/// Later requests reuse the prepared strings.
+///
+/// Images that were uploaded through a provider's Files API can be
+/// registered with ``setFileReference(_:for:service:)``. Providers then send
+/// the file ID instead of the bytes:
+///
+/// ```swift
+/// let media = MediaCache(configuration: .init(maxPixelDimension: 1568))
+/// let provider = AnthropicProvider(apiKey: "sk-ant-...", mediaCache: media)
+///
+/// // After uploading `image` yourself:
+/// media.setFileReference("file_011C...", for: image, service: .anthropic)
+/// ```
+///
+/// State is protected by an NSLock that is never held while images are
+/// hashed or re-encoded, so one cache can be shared by several providers.
+///
+/// - Note: Downscaling uses ImageIO and only applies to JPEG and PNG images.
+///   On platforms without ImageIO, payloads are cached as supplied.
+public final class MediaCache: @unchecked Sendable, Hashable {
+
+    // MARK: - Configuration
+
+    /// Downscaling and size limits for a ``MediaCache``.
+    public struct Configuration: Sendable, Hashable {
+
+        /// Longest side, in pixels, that larger images are downscaled to.
+        /// `nil` sends images at their original size.
+        public var maxPixelDimension: Int?
+
+        /// Compression quality used when a downscaled JPEG is re-encoded.
+        public var jpegQuality: Double
+
+        /// Maximum bytes of prepared payloads held in memory.
+        public var memoryLimit: Int
+
+        /// Maximum payloads held in memory.
+        public var maxEntries: Int
+
+        /// Creates a media cache configuration.
+        ///
+        /// - Parameters:
+        ///   - maxPixelDimension: Longest side after downscaling. Default: `nil`
+        ///   - jpegQuality: JPEG re-encoding quality, clamped to 0...1. Default: 0.85
+        ///   - memoryLimit: Bytes held in memory. Default: 128 MB
+        ///   - maxEntries: Payloads held in memory. Clamped to at least 1. Default: 256
+        public init(
+            maxPixelDimension: Int? = nil,
+            jpegQuality: Double = 0.85,
+            memoryLimit: Int = 128 * 1024 * 1024,
+            maxEntries: Int = 256
+        ) {
+            self.maxPixelDimension = maxPixelDimension.map { max(1, $0) }
+            self.jpegQuality = min(max(jpegQuality, 0), 1)
+            self.memoryLimit = max(0, memoryLimit)
+            self.maxEntries = max(1, maxEntries)
+        }
+
+        /// Caches payloads at their original size.
+        public static let `default` = Configuration()
+    }
+
+    // MARK: - Metrics
+
+    /// Counters describing how the cache has been used.
+    public struct Metrics: Sendable, Hashable {
+        /// Images served from a prepared payload.
+        public var hits = 0
+
+        /// Images prepared from their supplied data.
+        public var misses = 0
+
+        /// Images sent as a registered file reference instead of bytes.
+        public var fileReferenceHits = 0
+
+        /// Images that were downscaled while being prepared.
+        public var downscaledImages = 0
+
+        /// Base64 characters removed by downscaling, summed over prepared images.
+        public var bytesSaved = 0
+
+        /// Payloads currently held in memory.
+        public var memoryEntries = 0
+
+        /// Bytes of prepared payloads held in memory.
+        public var memoryBytes = 0
+
+        /// Payloads dropped from memory to stay within limits.
+        public var evictions = 0
+    }
+
+    // MARK: - Key
+
+    /// The SHA-256 digest identifying an image as supplied.
+    public struct Key: Sendable, Hashable, CustomStringConvertible {
+        /// Lowercase hex digest.
+        public let digest: String
+
+        public var description: String { digest }
+    }
+
+    // MARK: - Service
+
+    /// A provider whose Files API references the cache can hold.
+    public enum Service: String, Sendable, Hashable, CaseIterable {
+        /// Anthropic's Files API (`file_…` IDs).
+        case anthropic
+        /// OpenAI's Files API (`file-…` IDs), used by the Responses API.
+        case openAI
+    }
+
+    // MARK: - PreparedImage
+
+    /// An image payload ready to be placed in a request body.
+    ///
+    /// The strings are built once per image and share storage with the
+    /// cache, so handing them out does not copy the image.
+    public struct PreparedImage: Sendable, Hashable {
+        /// Digest of the image as supplied.
+        public let key: Key
+
+        /// MIME type of ``base64Data``.
+        public let mimeType: String
+
+        /// Base64-encoded image bytes, downscaled if configured.
+        public let base64Data: String
+
+        /// ``base64Data`` as a `data:` URL.
+        public let dataURL: String
+    }
+
+    // MARK: - State
+
+    private struct Entry {
+        let image: PreparedImage
+        let cost: Int
+        var lastAccess: UInt64
+    }
+
+    private struct ReferenceKey: Hashable {
+        let key: Key
+        let service: Service
+    }
+
+    /// A cheap identity for an image: its MIME type, length and a hash of
+    /// sampled bytes. Only used to find a memoized digest, which is reused
+    /// only if the stored data is equal to the image's.
+    private struct Fingerprint: Hashable {
+        let mimeType: String
+        let length: Int
+        let sample: Int
+    }
+
+    private struct Digest {
+        let base64Data: String
+        let key: Key
+    }
+
+    /// Cache settings.
+    public let configuration: Configuration
+
+    private let lock = NSLock()
+    private var entries: [Key: Entry] = [:]
+    private var fileReferences: [ReferenceKey: String] = [:]
+    private var digests: [Fingerprint: Digest] = [:]
+    private var memoryBytes = 0
+    private var accessClock: UInt64 = 0
+    private var counters = Metrics()
+
+    // MARK: - Initialization
+
+    /// Creates a media cache.
+    ///
+    /// - Parameter configuration: Downscaling and size limits.
+    public init(configuration: Configuration = .default) {
+        self.configuration = configuration
+    }
+
+    // MARK: - Public API
+
+    /// Current hit, miss and size counters.
+    public var metrics: Metrics {
+        withLock {
+            var metrics = counters
+            metrics.memoryEntries = entries.count
+            metrics.memoryBytes = memoryBytes
+            return metrics
+        }
+    }
+
+    /// The digest identifying `image`.
+    ///
+    /// Digests are memoized, so an image resent on every turn is hashed
+    /// once. A memoized digest is reused only when the data matches, which
+    /// is a pointer comparison for the same string.
+    public func key(for image: Message.ImageContent) -> Key {
+        guard let fingerprint = Self.fingerprint(of: image) else {
+            return Self.digest(of: image)
+        }
+        if let memoized = withLock({ digests[fingerprint] }), memoized.base64Data == image.base64Data {
+            return memoized.key
+        }
+
+        let key = Self.digest(of: image)
+        withLock {
+            if digests.count >= configuration.maxEntries, let stale = digests.keys.first {
+                digests[stale] = nil
+            }
+            digests[fingerprint] = Digest(base64Data: image.base64Data, key: key)
+        }
+        return key
+    }
+
+    private static func digest(of image: Message.ImageContent) -> Key {
+        var digest = SHA256Digest()
+        digest.update(Data(image.mimeType.utf8))
+        digest.update(Data([0]))
+        digest.update(Data(image.base64Data.utf8))
+        return Key(digest: digest.finalize())
+    }
+
+    /// Hashes the length, both ends and 32 evenly spaced bytes of the data,
+    /// or returns `nil` if the string is not stored contiguously.
+    private static func fingerprint(of image: Message.ImageContent) -> Fingerprint? {
+        image.base64Data.utf8.withContiguousStorageIfAvailable { bytes -> Fingerprint in
+            var hasher = Hasher()
+            hasher.combine(bytes.count)
+            let edge = min(bytes.count, 64)
+            hasher.combine(bytes: UnsafeRawBufferPointer(UnsafeBufferPointer(rebasing: bytes.prefix(edge))))
+            hasher.combine(bytes: UnsafeRawBufferPointer(UnsafeBufferPointer(rebasing: bytes.suffix(edge))))
+            let step = max(1, bytes.count / 32)
+            for offset in stride(from: 0, to: bytes.count, by: step) {
+                hasher.combine(bytes[offset])
+            }
+            return Fingerprint(mimeType: image.mimeType, length: bytes.count, sample: hasher.finalize())
+        }
+    }
+
+    /// The payload to send for `image`, prepared on first use.
+    public func prepared(_ image: Message.ImageContent) -> PreparedImage {
+        let key = key(for: image)
+        if let cached = lookup(key) {
+            return cached
+        }
+
+        var base64Data = image.base64Data
+        var mimeType = image.mimeType
+        var downscaled = false
+        if let maxPixelDimension = configuration.maxPixelDimension,
+           let data = Data(base64Encoded: image.base64Data),
+           let smaller = Self.downscale(
+               data,
+               mimeType: image.mimeType,
+               maxPixelDimension: maxPixelDimension,
+               jpegQuality: configuration.jpegQuality
+           ) {
+            base64Data = smaller.data.base64EncodedString()
+            mimeType = smaller.mimeType
+            downscaled = true
+        }
+
+        let prepared = PreparedImage(
+            key: key,
+            mimeType: mimeType,
+            base64Data: base64Data,
+            dataURL: "data:\(mimeType);base64,\(base64Data)"
+        )
+        insert(prepared, downscaledFrom: downscaled ? image.base64Data.utf8.count : nil)
+        return prepared
+    }
+
+    /// The file ID registered for the image with `key`, if any.
+    public func fileReference(for key: Key, service: Service) -> String? {
+        withLock {
+            let reference = fileReferences[ReferenceKey(key: key, service: service)]
+            if reference != nil {
+                counters.fileReferenceHits += 1
+            }
+            return reference
+        }
+    }
+
+    /// Registers the file ID `service` assigned to an uploaded copy of the
+    /// image with `key`. Requests through that service send the ID instead of
+    /// the image bytes. Pass `nil` to remove the registration.
+    public func setFileReference(_ fileID: String?, for key: Key, service: Service) {
+        withLock {
+            fileReferences[ReferenceKey(key: key, service: service)] = fileID
+        }
+    }
+
+    /// Registers the file ID `service` assigned to an uploaded copy of `image`.
+    public func setFileReference(_ fileID: String?, for image: Message.ImageContent, service: Service) {
+        setFileReference(fileID, for: key(for: image), service: service)
+    }
+
+    /// Removes every prepared payload and file reference.
+    public func removeAll() {
+        withLock {
+            entries.removeAll()
+            fileReferences.removeAll()
+            digests.removeAll()
+            memoryBytes = 0
+        }
+    }
+
+    // MARK: - Hashable
+
+    public static func == (lhs: MediaCache, rhs: MediaCache) -> Bool {
+        lhs === rhs
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        hasher.combine(ObjectIdentifier(self))
+    }
+
+    // MARK: - Storage
+
+    private func lookup(_ key: Key) -> PreparedImage? {
+        withLock {
+            guard var entry = entries[key] else {
+                counters.misses += 1
+                return nil
+            }
+            accessClock += 1
+            entry.lastAccess = accessClock
+            entries[key] = entry
+            counters.hits += 1
+            return entry.image
+        }
+    }
+
+    private func insert(_ image: PreparedImage, downscaledFrom originalSize: Int?) {
+        let cost = image.base64Data.utf8.count + image.dataURL.utf8.count
+        withLock {
+            if let originalSize {
+                counters.downscaledImages += 1
+                counters.bytesSaved += max(0, originalSize - image.base64Data.utf8.count)
+            }
+            guard cost <= configuration.memoryLimit, entries[image.key] == nil else { return }
+
+            while !entries.isEmpty,
+                  entries.count >= configuration.maxEntries
+                    || memoryBytes + cost > configuration.memoryLimit {
+                guard let oldest = entries.min(by: { $0.value.lastAccess < $1.value.lastAccess }) else { break }
+                entries[oldest.key] = nil
+                memoryBytes -= oldest.value.cost
+                counters.evictions += 1
+            }
+
+            accessClock += 1
+            entries[image.key] = Entry(image: image, cost: cost, lastAccess: accessClock)
+            memoryBytes += cost
+        }
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+
+    // MARK: - Downscaling
+
+    /// `data` re-encoded with its longest side at most `maxPixelDimension`,
+    /// or `nil` if it is already small enough or cannot be downscaled.
+    private static func downscale(
+        _ data: Data,
+        mimeType: String,
+        maxPixelDimension: Int,
+        jpegQuality: Double
+    ) -> (data: Data, mimeType: String)? {
+        #if canImport(ImageIO)
+        // GIF and WebP may be animated; leave them as supplied.
+        let typeIdentifiers = ["image/jpeg": "public.jpeg", "image/png": "public.png"]
+        guard let typeIdentifier = typeIdentifiers[mimeType],
+              let source = CGImageSourceCreateWithData(data as CFData, nil),
+              let properties = CGImageSourceCopyPropertiesAtIndex(source, 0, nil) as? [CFString: Any],
+              let width = properties[kCGImagePropertyPixelWidth] as? Int,
+              let height = properties[kCGImagePropertyPixelHeight] as? Int,
+              max(width, height) > maxPixelDimension
+        else {
+            return nil
+        }
+
+        let thumbnailOptions: [CFString: Any] = [
+            kCGImageSourceCreateThumbnailFromImageAlways: true,
+            kCGImageSourceCreateThumbnailWithTransform: true,
+            kCGImageSourceThumbnailMaxPixelSize: maxPixelDimension,
+        ]
+        guard let image = CGImageSourceCreateThumbnailAtIndex(source, 0, thumbnailOptions as CFDictionary) else {
+            return nil
+        }
+
+        let output = NSMutableData()
+        guard let destination = CGImageDestinationCreateWithData(output, typeIdentifier as CFString, 1, nil) else {
+            return nil
+        }
+        var destinationOptions: [CFString: Any] = [:]
+        if mimeType == "image/jpeg" {
+            destinationOptions[kCGImageDestinationLossyCompressionQuality] = jpegQuality
+        }
+        CGImageDestinationAddImage(destination, image, destinationOptions as CFDictionary)
+        guard CGImageDestinationFinalize(destination), output.length < data.count else {
+            return nil
+        }
+        return (output as Data, mimeType)
+        #else
+        return nil
+        #endif
+    }
+}
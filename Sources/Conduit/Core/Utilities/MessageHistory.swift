@@ -0,0 +1,252 @@
+// MessageHistory.swift
+// Conduit
+//
+// Persistent, structurally shared message list for ChatSession snapshots.
+
+import Foundation
+
+// MARK: - MessageHistory
+
+/// An immutable list of messages whose copies share storage.
+///
+/// `ChatSession` hands a snapshot of its history to every `send` and
+/// `stream` call while other calls keep appending to it. With an `Array`,
+/// the first append after a snapshot copies the whole history, and it does
+/// so while the session's state is locked. `MessageHistory` is a persistent
+/// vector instead: a 32-way trie of immutable nodes plus a tail of up to 32
+/// recent messages. An append copies at most the tail and one path through
+/// the trie, so it costs O(log₃₂ n) however many snapshots are alive, and
+/// a snapshot is a handful of references.
+///
+/// Replacing a message copies one path. Removing the last message is as
+/// cheap as appending; inserting or removing anywhere else rebuilds the
+/// list, which `ChatSession` only does for rare edits such as a new system
+/// prompt or a rollback that raced another turn.
+internal struct MessageHistory: Sendable {
+
+    private static let bits = 5
+    private static let width = 1 << bits
+    private static let mask = width - 1
+
+    /// A trie node: leaves hold messages, branches hold child nodes.
+    private final class Node: Sendable {
+        let messages: [Message]
+        let children: [Node]
+
+        init(messages: [Message] = [], children: [Node] = []) {
+            self.messages = messages
+            self.children = children
+        }
+    }
+
+    private var root = Node()
+    private var tail: [Message] = []
+    private var shift = MessageHistory.bits
+
+    /// The number of messages.
+    private(set) var count = 0
+
+    // MARK: - Initialization
+
+    /// Creates an empty history.
+    init() {}
+
+    /// Creates a history holding `messages` in order.
+    init<S: Sequence>(_ messages: S) where S.Element == Message {
+        for message in messages {
+            append(message)
+        }
+    }
+
+    // MARK: - Reading
+
+    /// Index of the first message held in the tail.
+    private var tailOffset: Int {
+        count - tail.count
+    }
+
+    /// The messages as an array, copied leaf by leaf.
+    var elements: [Message] {
+        var result: [Message] = []
+        result.reserveCapacity(count)
+        appendLeaves(of: root, level: shift, to: &result)
+        result.append(contentsOf: tail)
+        return result
+    }
+
+    private func appendLeaves(of node: Node, level: Int, to result: inout [Message]) {
+        guard level > 0 else {
+            result.append(contentsOf: node.messages)
+            return
+        }
+        for child in node.children {
+            appendLeaves(of: child, level: level - Self.bits, to: &result)
+        }
+    }
+
+    /// The leaf holding the message at `index`, which must be before the tail.
+    private func leaf(containing index: Int) -> Node {
+        var node = root
+        var level = shift
+        while level > 0 {
+            node = node.children[(index >> level) & Self.mask]
+            level -= Self.bits
+        }
+        return node
+    }
+
+    // MARK: - Appending
+
+    /// Adds `message` to the end.
+    mutating func append(_ message: Message) {
+        if tail.count < Self.width {
+            tail.append(message)
+            count += 1
+            return
+        }
+
+        // The tail is full: move it into the trie and start a new one
+        let full = Node(messages: tail)
+        if (count >> Self.bits) > (1 << shift) {
+            root = Node(children: [root, Self.path(to: full, level: shift)])
+            shift += Self.bits
+        } else {
+            root = pushTail(full, into: root, level: shift)
+        }
+        tail = [message]
+        count += 1
+    }
+
+    /// Adds `messages` to the end, in order.
+    mutating func append<S: Sequence>(contentsOf messages: S) where S.Element == Message {
+        for message in messages {
+            append(message)
+        }
+    }
+
+    private func pushTail(_ leaf: Node, into parent: Node, level: Int) -> Node {
+        let slot = ((count - 1) >> level) & Self.mask
+        var children = parent.children
+        let child: Node
+        if level == Self.bits {
+            child = leaf
+        } else if slot < children.count {
+            child = pushTail(leaf, into: children[slot], level: level - Self.bits)
+        } else {
+            child = Self.path(to: leaf, level: level - Self.bits)
+        }
+        if slot < children.count {
+            children[slot] = child
+        } else {
+            children.append(child)
+        }
+        return Node(children: children)
+    }
+
+    private static func path(to leaf: Node, level: Int) -> Node {
+        level == 0 ? leaf : Node(children: [path(to: leaf, level: level - bits)])
+    }
+
+    // MARK: - Editing
+
+    /// Replaces the message at `index`.
+    mutating func replace(at index: Int, with message: Message) {
+        precondition(indices.contains(index), "MessageHistory index out of range")
+        if index >= tailOffset {
+            tail[index - tailOffset] = message
+        } else {
+            root = Self.replacing(in: root, level: shift, at: index, with: message)
+        }
+    }
+
+    private static func replacing(in node: Node, level: Int, at index: Int, with message: Message) -> Node {
+        guard level > 0 else {
+            var messages = node.messages
+            messages[index & mask] = message
+            return Node(messages: messages)
+        }
+        var children = node.children
+        let slot = (index >> level) & mask
+        children[slot] = replacing(in: children[slot], level: level - bits, at: index, with: message)
+        return Node(children: children)
+    }
+
+    /// Removes the last message.
+    mutating func removeLast() {
+        precondition(count > 0, "Cannot remove the last message of an empty MessageHistory")
+        if count == 1 {
+            self = MessageHistory()
+            return
+        }
+        if tail.count > 1 {
+            tail.removeLast()
+            count -= 1
+            return
+        }
+
+        // The tail empties: the trie's last leaf becomes the new tail
+        tail = leaf(containing: count - 2).messages
+        var newRoot = popTail(from: root, level: shift) ?? Node()
+        if shift > Self.bits, newRoot.children.count == 1 {
+            newRoot = newRoot.children[0]
+            shift -= Self.bits
+        }
+        root = newRoot
+        count -= 1
+    }
+
+    private func popTail(from node: Node, level: Int) -> Node? {
+        let slot = ((count - 2) >> level) & Self.mask
+        if level > Self.bits {
+            let child = popTail(from: node.children[slot], level: level - Self.bits)
+            guard child != nil || slot > 0 else { return nil }
+            var children = Array(node.children.prefix(slot))
+            if let child {
+                children.append(child)
+            }
+            return Node(children: children)
+        }
+        guard slot > 0 else { return nil }
+        return Node(children: Array(node.children.prefix(slot)))
+    }
+
+    /// Removes the message at `index`.
+    mutating func remove(at index: Int) {
+        precondition(indices.contains(index), "MessageHistory index out of range")
+        if index == count - 1 {
+            removeLast()
+        } else {
+            var messages = elements
+            messages.remove(at: index)
+            self = MessageHistory(messages)
+        }
+    }
+
+    /// Inserts `message` at `index`.
+    mutating func insert(_ message: Message, at index: Int) {
+        if index == count {
+            append(message)
+        } else {
+            var messages = elements
+            messages.insert(message, at: index)
+            self = MessageHistory(messages)
+        }
+    }
+}
+
+// MARK: - RandomAccessCollection
+
+extension MessageHistory: RandomAccessCollection {
+
+    var startIndex: Int { 0 }
+
+    var endIndex: Int { count }
+
+    subscript(position: Int) -> Message {
+        precondition(indices.contains(position), "MessageHistory index out of range")
+        if position >= tailOffset {
+            return tail[position - tailOffset]
+        }
+        return leaf(containing: position).messages[position & Self.mask]
+    }
+}
@@ -0,0 +1,883 @@
+// RangedDownloader.swift
+// Conduit
+//
+// Parallel, resumable HTTP range downloads that hash files as they arrive.
+
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+// MARK: - RangedDownloader
+
+/// Downloads large files over several HTTP range requests at once.
+///
+/// Each file is split into ``Configuration/segmentSize`` segments that are
+/// fetched over up to ``Configuration/connectionsPerFile`` connections and
+/// written in place into a `.partial` file next to the destination. A small
+/// JSON sidecar records which segments are on disk, so a download that was
+/// cancelled, failed or interrupted by a crash resumes from the segments it
+/// already has. Segment data is flushed to storage before the sidecar lists
+/// it, so a crash cannot leave the sidecar vouching for unwritten bytes.
+///
+/// The SHA-256 digest is computed while the file downloads. Segments are
+/// hashed in file order as soon as every earlier segment has arrived; a
+/// segment that arrives early is kept in memory until its turn, up to
+/// ``Configuration/hashBufferLimit`` bytes. Only segments beyond that buffer,
+/// and segments kept from an earlier run, are read back from disk to be hashed.
+///
+/// ## Usage
+/// ```swift
+/// let downloader = RangedDownloader(configuration: .init(
+///     connectionsPerFile: 8,
+///     maxBytesPerSecond: 50_000_000
+/// ))
+///
+/// let file = try await downloader.download(
+///     RangedDownloader.File(url: weightsURL, destination: localURL, expectedSHA256: checksum)
+/// ) { progress in
+///     print("\(Int(progress.fractionCompleted * 100))%")
+/// }
+/// print(file.sha256)
+/// ```
+///
+/// One downloader shares its bandwidth limit across every file and
+/// connection it runs. Requests go through a ``ConduitTransport``, so its
+/// per-host limits also apply.
+///
+/// - Note: Servers that ignore `Range` requests are downloaded over a single
+///   connection and cannot be resumed.
+public final class RangedDownloader: Sendable {
+
+    // MARK: - Configuration
+
+    /// Connection, segment, and rate settings for a ``RangedDownloader``.
+    public struct Configuration: Sendable, Hashable {
+
+        /// Range requests run at once for a single file.
+        public var connectionsPerFile: Int
+
+        /// Files downloaded at once.
+        public var maxConcurrentFiles: Int
+
+        /// Bytes requested by each range request.
+        public var segmentSize: Int
+
+        /// Combined rate across every connection, in bytes per second, or
+        /// `nil` for no limit.
+        public var maxBytesPerSecond: Int?
+
+        /// Times a failed range request is retried before the download fails.
+        public var maxRetries: Int
+
+        /// Bytes of early segments held in memory until they can be hashed.
+        public var hashBufferLimit: Int
+
+        /// Creates a downloader configuration.
+        ///
+        /// - Parameters:
+        ///   - connectionsPerFile: Connections per file. Clamped to at least 1. Default: 4
+        ///   - maxConcurrentFiles: Files at once. Clamped to at least 1. Default: 2
+        ///   - segmentSize: Bytes per range request. Clamped to at least 64 KB. Default: 8 MB
+        ///   - maxBytesPerSecond: Combined rate limit. Default: no limit
+        ///   - maxRetries: Retries per range request. Default: 3
+        ///   - hashBufferLimit: Bytes held for in-order hashing. Default: 64 MB
+        public init(
+            connectionsPerFile: Int = 4,
+            maxConcurrentFiles: Int = 2,
+            segmentSize: Int = 8 * 1024 * 1024,
+            maxBytesPerSecond: Int? = nil,
+            maxRetries: Int = 3,
+            hashBufferLimit: Int = 64 * 1024 * 1024
+        ) {
+            self.connectionsPerFile = max(1, connectionsPerFile)
+            self.maxConcurrentFiles = max(1, maxConcurrentFiles)
+            self.segmentSize = max(64 * 1024, segmentSize)
+            self.maxBytesPerSecond = maxBytesPerSecond.map { max(1, $0) }
+            self.maxRetries = max(0, maxRetries)
+            self.hashBufferLimit = max(0, hashBufferLimit)
+        }
+
+        /// Default configuration.
+        public static let `default` = Configuration()
+    }
+
+    // MARK: - File
+
+    /// A file to download.
+    public struct File: Sendable, Hashable {
+        /// Where the file is downloaded from.
+        public var url: URL
+
+        /// Where the finished file is placed. Existing files are replaced.
+        public var destination: URL
+
+        /// Size in bytes, if known ahead of the first response.
+        public var expectedSize: Int64?
+
+        /// Lowercase hex SHA-256 the finished file must match, if known.
+        public var expectedSHA256: String?
+
+        /// Headers added to every request for this file, such as `Authorization`.
+        public var headers: [String: String]
+
+        /// Creates a file to download.
+        public init(
+            url: URL,
+            destination: URL,
+            expectedSize: Int64? = nil,
+            expectedSHA256: String? = nil,
+            headers: [String: String] = [:]
+        ) {
+            self.url = url
+            self.destination = destination
+            self.expectedSize = expectedSize
+            self.expectedSHA256 = expectedSHA256?.lowercased()
+            self.headers = headers
+        }
+    }
+
+    // MARK: - Progress
+
+    /// Combined progress across the files of one download call.
+    public struct Progress: Sendable, Hashable {
+        /// Bytes on disk, including bytes resumed from partial files.
+        public var completedBytes: Int64
+
+        /// Sum of the sizes known so far.
+        public var totalBytes: Int64
+
+        /// Files that have finished downloading.
+        public var completedFiles: Int
+
+        /// Files in the download call.
+        public var totalFiles: Int
+
+        /// Fraction of ``totalBytes`` completed, from 0 to 1.
+        public var fractionCompleted: Double {
+            totalBytes > 0 ? min(1, Double(completedBytes) / Double(totalBytes)) : 0
+        }
+    }
+
+    // MARK: - DownloadedFile
+
+    /// A file that finished downloading.
+    public struct DownloadedFile: Sendable, Hashable {
+        /// Where the file was downloaded from.
+        public let url: URL
+
+        /// Where the file was placed.
+        public let destination: URL
+
+        /// Size in bytes.
+        public let size: Int64
+
+        /// Lowercase hex SHA-256 of the file.
+        public let sha256: String
+
+        /// Bytes reused from a partial file left by an earlier download.
+        public let resumedBytes: Int64
+    }
+
+    // MARK: - Properties
+
+    /// A downloader with the default configuration.
+    public static let shared = RangedDownloader()
+
+    /// The settings this downloader was created with.
+    public let configuration: Configuration
+
+    private let transport: ConduitTransport
+    private let limiter: BandwidthLimiter?
+
+    // MARK: - Initialization
+
+    /// Creates a downloader.
+    ///
+    /// - Parameters:
+    ///   - configuration: Connection, segment, and rate settings.
+    ///   - transport: The transport requests are sent through. Default: ``ConduitTransport/shared``
+    public init(configuration: Configuration = .default, transport: ConduitTransport = .shared) {
+        self.configuration = configuration
+        self.transport = transport
+        self.limiter = configuration.maxBytesPerSecond.map { BandwidthLimiter(bytesPerSecond: $0) }
+    }
+
+    // MARK: - Downloading
+
+    /// Downloads `files`, up to ``Configuration/maxConcurrentFiles`` at once.
+    ///
+    /// - Parameters:
+    ///   - files: The files to download.
+    ///   - progress: Called with combined progress as bytes arrive.
+    /// - Returns: The downloaded files, in the order of `files`.
+    /// - Throws: `AIError.checksumMismatch` if a file does not match its
+    ///   expected digest, `AIError.cancelled` if the task is cancelled, or
+    ///   another `AIError` if a request fails. Partial files are kept for
+    ///   resuming unless their digest did not match.
+    public func download(
+        _ files: [File],
+        progress: (@Sendable (Progress) -> Void)? = nil
+    ) async throws -> [DownloadedFile] {
+        let reporter = ProgressReporter(files: files, handler: progress)
+        do {
+            let fetch: @Sendable (Int) async throws -> (index: Int, file: DownloadedFile) = { index in
+                (index, try await self.download(files[index], index: index, reporter: reporter))
+            }
+            return try await withThrowingTaskGroup(of: (index: Int, file: DownloadedFile).self) { group in
+                var results = [DownloadedFile?](repeating: nil, count: files.count)
+                var next = 0
+                while next < min(files.count, configuration.maxConcurrentFiles) {
+                    let index = next
+                    group.addTask { try await fetch(index) }
+                    next += 1
+                }
+                while let finished = try await group.next() {
+                    results[finished.index] = finished.file
+                    if next < files.count {
+                        let index = next
+                        group.addTask { try await fetch(index) }
+                        next += 1
+                    }
+                }
+                return results.compactMap { $0 }
+            }
+        } catch where Task.isCancelled || error is CancellationError || (error as? URLError)?.code == .cancelled {
+            throw AIError.cancelled
+        } catch let error as AIError {
+            throw error
+        } catch let error as URLError {
+            throw AIError.networkError(error)
+        } catch {
+            throw AIError.downloadFailed(underlying: SendableError(error))
+        }
+    }
+
+    /// Downloads a single file.
+    ///
+    /// - Parameters:
+    ///   - file: The file to download.
+    ///   - progress: Called with progress as bytes arrive.
+    /// - Returns: The downloaded file.
+    public func download(
+        _ file: File,
+        progress: (@Sendable (Progress) -> Void)? = nil
+    ) async throws -> DownloadedFile {
+        try await download([file], progress: progress)[0]
+    }
+
+    // MARK: - Partial Files
+
+    /// The file segments are written to while `destination` downloads.
+    internal static func partialURL(for destination: URL) -> URL {
+        destination.deletingLastPathComponent().appendingPathComponent(destination.lastPathComponent + ".partial")
+    }
+
+    /// The sidecar recording which segments of the partial file are on disk.
+    internal static func stateURL(for destination: URL) -> URL {
+        destination.deletingLastPathComponent().appendingPathComponent(destination.lastPathComponent + ".partial.json")
+    }
+
+    // MARK: - Per-File Download
+
+    private func download(_ file: File, index: Int, reporter: ProgressReporter) async throws -> DownloadedFile {
+        let fileManager = FileManager.default
+        let partialURL = Self.partialURL(for: file.destination)
+        let stateURL = Self.stateURL(for: file.destination)
+        try fileManager.createDirectory(
+            at: file.destination.deletingLastPathComponent(),
+            withIntermediateDirectories: true
+        )
+
+        let saved = RangedDownloadState.load(from: stateURL).flatMap { state -> RangedDownloadState? in
+            guard state.url == file.url,
+                  state.segmentSize == configuration.segmentSize,
+                  file.expectedSize.map({ $0 == state.size }) ?? true,
+                  fileManager.fileExists(atPath: partialURL.path) else { return nil }
+            return state
+        }
+        if saved == nil {
+            Self.removePartial(for: file.destination)
+        }
+
+        if let size = saved?.size ?? file.expectedSize {
+            reporter.setSize(size, forFile: index)
+        }
+
+        // The first missing segment is fetched alone: its response carries
+        // the total size and validator, and shows whether ranges are supported.
+        let state: RangedDownloadState
+        var probe: (segment: Int, data: Data)?
+        if let saved, saved.firstMissingSegment == nil {
+            state = saved
+        } else if file.expectedSize == 0, saved == nil {
+            state = RangedDownloadState(url: file.url, size: 0, etag: nil, segmentSize: configuration.segmentSize)
+        } else {
+            let segment = saved?.firstMissingSegment ?? 0
+            let range = saved?.range(ofSegment: segment)
+                ?? 0..<Int64(configuration.segmentSize)
+            reporter.add(saved?.completedBytes ?? 0, toFile: index)
+
+            let response = try await requestRange(
+                of: file,
+                range,
+                ifRange: saved?.etag,
+                onBytes: { reporter.add(Int64($0), toFile: index) }
+            )
+            switch response {
+            case .partial(let data, let total, let etag):
+                if let saved, saved.size != total {
+                    // The remote file changed without a usable validator
+                    reporter.reset(file: index)
+                    Self.removePartial(for: file.destination)
+                    return try await download(file, index: index, reporter: reporter)
+                }
+                state = saved ?? RangedDownloadState(
+                    url: file.url,
+                    size: total,
+                    etag: etag,
+                    segmentSize: configuration.segmentSize
+                )
+                probe = (segment, data)
+            case .whole(let chunks, let length):
+                reporter.reset(file: index)
+                return try await downloadWhole(file, chunks: chunks, length: length, index: index, reporter: reporter)
+            case .empty:
+                state = RangedDownloadState(url: file.url, size: 0, etag: nil, segmentSize: configuration.segmentSize)
+            }
+        }
+        reporter.setSize(state.size, forFile: index)
+
+        let resumedBytes = state.completedBytes
+        let assembler = try RangedFileAssembler(
+            partialURL: partialURL,
+            stateURL: stateURL,
+            state: state,
+            bufferLimit: configuration.hashBufferLimit
+        )
+        defer { assembler.close() }
+
+        if let probe {
+            try assembler.store(probe.data, forSegment: probe.segment)
+        }
+
+        let fetchSegment: @Sendable (Int) async throws -> Void = { [state] segment in
+            try await self.downloadSegment(
+                segment,
+                of: file,
+                state: state,
+                into: assembler,
+                index: index,
+                reporter: reporter
+            )
+        }
+        let segments = (0..<state.segmentCount).filter { !assembler.isCompleted($0) }
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            var pending = segments.makeIterator()
+            for _ in 0..<configuration.connectionsPerFile {
+                guard let segment = pending.next() else { break }
+                group.addTask { try await fetchSegment(segment) }
+            }
+            while try await group.next() != nil {
+                if let segment = pending.next() {
+                    group.addTask { try await fetchSegment(segment) }
+                }
+            }
+        }
+
+        return try complete(
+            file,
+            sha256: try assembler.finish(),
+            size: state.size,
+            resumedBytes: resumedBytes,
+            index: index,
+            reporter: reporter
+        )
+    }
+
+    /// Fetches one segment, retrying transient failures.
+    private func downloadSegment(
+        _ segment: Int,
+        of file: File,
+        state: RangedDownloadState,
+        into assembler: RangedFileAssembler,
+        index: Int,
+        reporter: ProgressReporter
+    ) async throws {
+        let range = state.range(ofSegment: segment)
+        var attempt = 0
+        while true {
+            var received: Int64 = 0
+            do {
+                let response = try await requestRange(of: file, range, ifRange: state.etag) { count in
+                    received += Int64(count)
+                    reporter.add(Int64(count), toFile: index)
+                }
+                guard case .partial(let data, let total, _) = response, total == state.size else {
+                    throw AIError.serverError(statusCode: 200, message: "The file changed while it was downloading")
+                }
+                try assembler.store(data, forSegment: segment)
+                return
+            } catch let error as AIError {
+                // Server answers other than 5xx are not retried
+                switch error {
+                case .serverError(let statusCode, _) where statusCode >= 500:
+                    break
+                case .networkError:
+                    break
+                default:
+                    throw error
+                }
+                reporter.add(-received, toFile: index)
+                guard attempt < configuration.maxRetries else { throw error }
+            } catch let error as URLError where error.code != .cancelled {
+                reporter.add(-received, toFile: index)
+                guard attempt < configuration.maxRetries else { throw AIError.networkError(error) }
+            }
+            attempt += 1
+            try await Task.sleep(for: .milliseconds(500 * (1 << min(attempt, 5))))
+        }
+    }
+
+    /// Streams a response that ignored the `Range` header straight to disk.
+    private func downloadWhole(
+        _ file: File,
+        chunks: URLSessionAsyncChunks,
+        length: Int64?,
+        index: Int,
+        reporter: ProgressReporter
+    ) async throws -> DownloadedFile {
+        let partialURL = Self.partialURL(for: file.destination)
+        Self.removePartial(for: file.destination)
+        if let length {
+            reporter.setSize(length, forFile: index)
+        }
+
+        guard FileManager.default.createFile(atPath: partialURL.path, contents: nil) else {
+            throw AIError.fileError(underlying: SendableError(CocoaError(.fileWriteUnknown)))
+        }
+        let handle = try FileHandle(forWritingTo: partialURL)
+        defer { try? handle.close() }
+
+        var digest = SHA256Digest()
+        var size: Int64 = 0
+        for try await chunk in chunks {
+            try Task.checkCancellation()
+            try handle.write(contentsOf: chunk)
+            digest.update(chunk)
+            size += Int64(chunk.count)
+            reporter.add(Int64(chunk.count), toFile: index)
+            try await limiter?.consume(chunk.count)
+        }
+        try handle.synchronize()
+        try handle.close()
+        return try complete(
+            file,
+            sha256: digest.finalize(),
+            size: size,
+            resumedBytes: 0,
+            index: index,
+            reporter: reporter
+        )
+    }
+
+    /// Checks the digest and moves the partial file into place.
+    private func complete(
+        _ file: File,
+        sha256: String,
+        size: Int64,
+        resumedBytes: Int64,
+        index: Int,
+        reporter: ProgressReporter
+    ) throws -> DownloadedFile {
+        let fileManager = FileManager.default
+        let partialURL = Self.partialURL(for: file.destination)
+        if size == 0, !fileManager.fileExists(atPath: partialURL.path) {
+            fileManager.createFile(atPath: partialURL.path, contents: nil)
+        }
+
+        if let expected = file.expectedSHA256, expected != sha256 {
+            Self.removePartial(for: file.destination)
+            throw AIError.checksumMismatch(expected: expected, actual: sha256)
+        }
+
+        if fileManager.fileExists(atPath: file.destination.path) {
+            try fileManager.removeItem(at: file.destination)
+        }
+        try fileManager.moveItem(at: partialURL, to: file.destination)
+        try? fileManager.removeItem(at: Self.stateURL(for: file.destination))
+        reporter.finish(file: index)
+
+        return DownloadedFile(
+            url: file.url,
+            destination: file.destination,
+            size: size,
+            sha256: sha256,
+            resumedBytes: resumedBytes
+        )
+    }
+
+    private static func removePartial(for destination: URL) {
+        try? FileManager.default.removeItem(at: partialURL(for: destination))
+        try? FileManager.default.removeItem(at: stateURL(for: destination))
+    }
+
+    // MARK: - Range Requests
+
+    private enum RangeResponse {
+        /// The requested bytes and the file's total size.
+        case partial(Data, total: Int64, etag: String?)
+
+        /// The server ignored the range and sent the whole file.
+        case whole(URLSessionAsyncChunks, length: Int64?)
+
+        /// The file is empty.
+        case empty
+    }
+
+    /// Requests `range` of `file`, collecting a 206 response into memory.
+    private func requestRange(
+        of file: File,
+        _ range: Range<Int64>,
+        ifRange validator: String?,
+        onBytes: (Int) -> Void
+    ) async throws -> RangeResponse {
+        var request = URLRequest(url: file.url)
+        for (field, value) in file.headers {
+            request.setValue(value, forHTTPHeaderField: field)
+        }
+        request.setValue("bytes=\(range.lowerBound)-\(range.upperBound - 1)", forHTTPHeaderField: "Range")
+        // Compressed bodies would not line up with byte offsets
+        request.setValue("identity", forHTTPHeaderField: "Accept-Encoding")
+        // Weak validators are not allowed in If-Range
+        if let validator, !validator.hasPrefix("W/") {
+            request.setValue(validator, forHTTPHeaderField: "If-Range")
+        }
+
+        let (bytes, response) = try await transport.asyncBytes(for: request)
+        guard let http = response as? HTTPURLResponse else {
+            throw AIError.networkError(URLError(.badServerResponse))
+        }
+
+        switch http.statusCode {
+        case 206:
+            guard let header = http.value(forHTTPHeaderField: "Content-Range"),
+                  let contentRange = Self.parseContentRange(header),
+                  let total = contentRange.total,
+                  contentRange.range?.lowerBound == range.lowerBound else {
+                throw AIError.serverError(statusCode: 206, message: "Missing or unexpected Content-Range")
+            }
+            let expected = Int(min(range.upperBound, total) - range.lowerBound)
+            var data = Data()
+            data.reserveCapacity(expected)
+            for try await chunk in bytes.chunks {
+                try Task.checkCancellation()
+                data.append(chunk)
+                onBytes(chunk.count)
+                try await limiter?.consume(chunk.count)
+            }
+            guard data.count == expected else {
+                throw AIError.networkError(URLError(.networkConnectionLost))
+            }
+            return .partial(data, total: total, etag: http.value(forHTTPHeaderField: "ETag"))
+
+        case 200:
+            let length = http.expectedContentLength >= 0 ? http.expectedContentLength : nil
+            return .whole(bytes.chunks, length: length)
+
+        case 416:
+            let total = http.value(forHTTPHeaderField: "Content-Range").flatMap(Self.parseContentRange)?.total
+            guard total == 0 else {
+                throw AIError.serverError(statusCode: 416, message: "Requested range not satisfiable")
+            }
+            return .empty
+
+        default:
+            var body = Data()
+            for try await chunk in bytes.chunks where body.count < 4096 {
+                body.append(chunk)
+            }
+            throw AIError.serverError(statusCode: http.statusCode, message: String(data: body, encoding: .utf8))
+        }
+    }
+
+    /// Parses `bytes 0-99/1000` and `bytes */1000` Content-Range values.
+    internal static func parseContentRange(_ value: String) -> (range: Range<Int64>?, total: Int64?)? {
+        let trimmed = value.trimmingCharacters(in: .whitespaces)
+        guard trimmed.lowercased().hasPrefix("bytes ") else { return nil }
+        let parts = trimmed.dropFirst("bytes ".count).split(separator: "/", maxSplits: 1)
+        guard parts.count == 2 else { return nil }
+
+        let total = parts[1] == "*" ? nil : Int64(parts[1])
+        if parts[1] != "*" && total == nil {
+            return nil
+        }
+        if parts[0] == "*" {
+            return (nil, total)
+        }
+
+        let bounds = parts[0].split(separator: "-", maxSplits: 1)
+        guard bounds.count == 2,
+              let first = Int64(bounds[0]),
+              let last = Int64(bounds[1]),
+              first <= last else { return nil }
+        return (first..<(last + 1), total)
+    }
+}
+
+// MARK: - RangedDownloadState
+
+/// The resume sidecar of a partial download.
+internal struct RangedDownloadState: Codable, Hashable {
+    /// Where the file is downloaded from.
+    var url: URL
+
+    /// Total size of the file.
+    var size: Int64
+
+    /// Validator sent as `If-Range`, so a changed file is not spliced with the old one.
+    var etag: String?
+
+    /// Bytes per segment.
+    var segmentSize: Int
+
+    /// Segments written to the partial file.
+    var completed: Set<Int> = []
+
+    /// Number of segments the file is split into.
+    var segmentCount: Int {
+        Int((size + Int64(segmentSize) - 1) / Int64(segmentSize))
+    }
+
+    /// Byte range of `segment`.
+    func range(ofSegment segment: Int) -> Range<Int64> {
+        let start = Int64(segment) * Int64(segmentSize)
+        return start..<min(size, start + Int64(segmentSize))
+    }
+
+    /// The lowest segment not yet on disk, or `nil` if all are.
+    var firstMissingSegment: Int? {
+        (0..<segmentCount).first { !completed.contains($0) }
+    }
+
+    /// Bytes of the completed segments.
+    var completedBytes: Int64 {
+        completed.reduce(Int64(0)) { $0 + Int64(range(ofSegment: $1).count) }
+    }
+
+    static func load(from url: URL) -> RangedDownloadState? {
+        guard let data = try? Data(contentsOf: url) else { return nil }
+        return try? JSONDecoder().decode(RangedDownloadState.self, from: data)
+    }
+
+    func save(to url: URL) throws {
+        try JSONEncoder().encode(self).write(to: url, options: .atomic)
+    }
+}
+
+// MARK: - RangedFileAssembler
+
+/// Writes segments into a partial file and hashes them in file order.
+///
+/// Segments may be stored in any order. The digest advances over the
+/// contiguous run of stored segments from the start of the file, using
+/// buffered segment data where it was kept and reading back from disk
+/// otherwise.
+internal final class RangedFileAssembler: @unchecked Sendable {
+
+    private let stateURL: URL
+    private let handle: FileHandle
+    private let bufferLimit: Int
+
+    private let lock = NSLock()
+    private var state: RangedDownloadState
+    private var digest = SHA256Digest()
+    private var hashedSegments = 0
+    private var buffered: [Int: Data] = [:]
+    private var bufferedBytes = 0
+    private var rereadBytes: Int64 = 0
+    private var isClosed = false
+
+    /// Opens or creates the partial file for `state`.
+    init(partialURL: URL, stateURL: URL, state: RangedDownloadState, bufferLimit: Int) throws {
+        let fileManager = FileManager.default
+        if !fileManager.fileExists(atPath: partialURL.path) {
+            guard fileManager.createFile(atPath: partialURL.path, contents: nil) else {
+                throw AIError.fileError(underlying: SendableError(CocoaError(.fileWriteUnknown)))
+            }
+        }
+        self.handle = try FileHandle(forUpdating: partialURL)
+        self.stateURL = stateURL
+        self.state = state
+        self.bufferLimit = bufferLimit
+
+        if try handle.seekToEnd() < UInt64(state.size) {
+            try handle.truncate(atOffset: UInt64(state.size))
+        }
+        try state.save(to: stateURL)
+    }
+
+    deinit {
+        close()
+    }
+
+    /// Whether `segment` is already on disk.
+    func isCompleted(_ segment: Int) -> Bool {
+        withLock { state.completed.contains(segment) }
+    }
+
+    /// Bytes read back from disk to be hashed.
+    var bytesReadBack: Int64 {
+        withLock { rereadBytes }
+    }
+
+    /// Writes `data` at the offset of `segment` and records it in the sidecar.
+    func store(_ data: Data, forSegment segment: Int) throws {
+        try withLock {
+            guard !state.completed.contains(segment) else { return }
+            try handle.seek(toOffset: UInt64(state.range(ofSegment: segment).lowerBound))
+            try handle.write(contentsOf: data)
+            // The sidecar must never list a segment whose bytes could still be lost
+            try handle.synchronize()
+            state.completed.insert(segment)
+            try state.save(to: stateURL)
+
+            if segment == hashedSegments || bufferedBytes + data.count <= bufferLimit {
+                buffered[segment] = data
+                bufferedBytes += data.count
+            }
+            try drain()
+        }
+    }
+
+    /// Hashes any remaining segments, closes the file and returns its digest.
+    ///
+    /// - Throws: `AIError.downloadFailed` if a segment is missing.
+    func finish() throws -> String {
+        try withLock {
+            try drain()
+            guard hashedSegments == state.segmentCount else {
+                throw AIError.downloadFailed(underlying: SendableError(URLError(.networkConnectionLost)))
+            }
+            try handle.synchronize()
+            isClosed = true
+            try handle.close()
+            return digest.finalize()
+        }
+    }
+
+    /// Closes the partial file. Stored segments stay on disk for resuming.
+    func close() {
+        withLock {
+            guard !isClosed else { return }
+            isClosed = true
+            try? handle.close()
+        }
+    }
+
+    /// Advances the digest over completed segments. Call with the lock held.
+    private func drain() throws {
+        while hashedSegments < state.segmentCount, state.completed.contains(hashedSegments) {
+            let data: Data
+            if let kept = buffered.removeValue(forKey: hashedSegments) {
+                data = kept
+                bufferedBytes -= kept.count
+            } else {
+                let range = state.range(ofSegment: hashedSegments)
+                try handle.seek(toOffset: UInt64(range.lowerBound))
+                data = try handle.read(upToCount: range.count) ?? Data()
+                rereadBytes += Int64(data.count)
+            }
+            digest.update(data)
+            hashedSegments += 1
+        }
+    }
+
+    private func withLock<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
+    }
+}
+
+// MARK: - BandwidthLimiter
+
+/// Paces received bytes to a shared rate across connections.
+private final class BandwidthLimiter: @unchecked Sendable {
+    private let bytesPerSecond: Double
+    private let lock = NSLock()
+    private var nextSlot = ContinuousClock.now
+
+    /// Unused capacity carried over from an idle period.
+    private static let burst: Duration = .milliseconds(250)
+
+    init(bytesPerSecond: Int) {
+        self.bytesPerSecond = Double(bytesPerSecond)
+    }
+
+    /// Waits until `count` received bytes fit within the rate.
+    func consume(_ count: Int) async throws {
+        let delay: Duration = {
+            lock.lock()
+            defer { lock.unlock() }
+            let now = ContinuousClock.now
+            let start = max(nextSlot, now - Self.burst)
+            nextSlot = start + .seconds(Double(count) / bytesPerSecond)
+            return nextSlot - now
+        }()
+        if delay > .zero {
+            try await Task.sleep(for: delay)
+        }
+    }
+}
+
+// MARK: - ProgressReporter
+
+/// Sums per-file byte counts into ``RangedDownloader/Progress`` updates.
+private final class ProgressReporter: @unchecked Sendable {
+    private let handler: (@Sendable (RangedDownloader.Progress) -> Void)?
+    private let lock = NSLock()
+    private var sizes: [Int64?]
+    private var bytes: [Int64]
+    private var completedFiles = 0
+
+    init(files: [RangedDownloader.File], handler: (@Sendable (RangedDownloader.Progress) -> Void)?) {
+        self.handler = handler
+        self.sizes = files.map(\.expectedSize)
+        self.bytes = Array(repeating: 0, count: files.count)
+    }
+
+    func setSize(_ size: Int64, forFile index: Int) {
+        update { sizes[index] = size }
+    }
+
+    func add(_ count: Int64, toFile index: Int) {
+        guard count != 0 else { return }
+        update { bytes[index] += count }
+    }
+
+    func reset(file index: Int) {
+        update { bytes[index] = 0 }
+    }
+
+    func finish(file index: Int) {
+        update {
+            bytes[index] = sizes[index] ?? bytes[index]
+            completedFiles += 1
+        }
+    }
+
+    private func update(_ body: () -> Void) {
+        lock.lock()
+        body()
+        let progress = RangedDownloader.Progress(
+            completedBytes: bytes.reduce(0, +),
+            totalBytes: zip(sizes, bytes).reduce(Int64(0)) { $0 + ($1.0 ?? $1.1) },
+            completedFiles: completedFiles,
+            totalFiles: sizes.count
+        )
+        lock.unlock()
+        handler?(progress)
+    }
+}
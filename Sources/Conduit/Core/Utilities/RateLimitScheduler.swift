@@ -0,0 +1,489 @@
+// RateLimitScheduler.swift
+// Conduit
+//
+// Client-side request shaping driven by provider rate-limit headers.
+
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+/// Shapes outgoing requests to stay within a provider's rate limits.
+///
+/// Retrying after a 429 reacts too late: under burst load every request
+/// fails, backs off, and retries at about the same time. The scheduler
+/// keeps a token bucket per key, usually a model, for both requests and
+/// tokens. Each bucket is refilled from the `remaining` and `reset` values
+/// in ``RateLimitInfo``. Requests wait before they are sent when the
+/// budget is exhausted. A 429 pauses every request for the key until its
+/// `retry-after` time has passed.
+///
+/// Waiting requests are served in priority order, and first-in, first-out
+/// within a priority. Batch requests also leave
+/// ``Configuration/interactiveReserve`` of each bucket for interactive
+/// ones. Priority comes from the task-local ``priority``, so a whole
+/// batch job can be marked once.
+///
+/// Give one scheduler to a provider configuration and every
+/// ``ChatSession`` on that provider shares its budget.
+///
+/// ## Usage
+/// ```swift
+/// var config = OpenAIConfiguration.openAI(apiKey: "sk-...")
+/// config.rateLimiter = RateLimitScheduler()
+/// let provider = OpenAIProvider(configuration: config)
+///
+/// // Background work yields to interactive sessions on the same provider
+/// try await RateLimitScheduler.$priority.withValue(.batch) {
+///     for document in documents {
+///         _ = try await provider.generate(summaryPrompt(document), model: .gpt4oMini)
+///     }
+/// }
+/// ```
+public actor RateLimitScheduler: Hashable {
+
+    // MARK: - Priority
+
+    /// Scheduling priority for a request.
+    public enum Priority: Int, Sendable, Hashable, Comparable {
+
+        /// Background work that can wait, such as indexing or evaluation.
+        case batch
+
+        /// Latency-sensitive work, such as a user waiting on a reply.
+        case interactive
+
+        public static func < (lhs: Priority, rhs: Priority) -> Bool {
+            lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    /// The priority for requests made from the current task.
+    ///
+    /// Default: ``Priority/interactive``
+    @TaskLocal public static var priority: Priority = .interactive
+
+    // MARK: - Configuration
+
+    /// Reserve and timing settings for a scheduler.
+    public struct Configuration: Sendable, Hashable {
+
+        /// Fraction of each bucket that batch requests leave for interactive ones.
+        public var interactiveReserve: Double
+
+        /// Refill window assumed when a response reports a limit but no reset time.
+        public var defaultWindow: Duration
+
+        /// Pause after a 429 that carries no `retry-after` header.
+        public var defaultRetryAfter: Duration
+
+        /// Longest pause honoured from a `retry-after` header.
+        public var maxRetryAfter: Duration
+
+        /// Creates a scheduler configuration.
+        ///
+        /// - Parameters:
+        ///   - interactiveReserve: Share kept for interactive requests, from 0 to 1. Default: 0.1
+        ///   - defaultWindow: Assumed refill window. Default: 60 seconds
+        ///   - defaultRetryAfter: Pause after a bare 429. Default: 1 second
+        ///   - maxRetryAfter: Cap on `retry-after` pauses. Default: 5 minutes
+        public init(
+            interactiveReserve: Double = 0.1,
+            defaultWindow: Duration = .seconds(60),
+            defaultRetryAfter: Duration = .seconds(1),
+            maxRetryAfter: Duration = .seconds(300)
+        ) {
+            self.interactiveReserve = min(max(interactiveReserve, 0), 1)
+            self.defaultWindow = defaultWindow
+            self.defaultRetryAfter = defaultRetryAfter
+            self.maxRetryAfter = maxRetryAfter
+        }
+
+        /// Default configuration.
+        public static let `default` = Configuration()
+    }
+
+    // MARK: - Status
+
+    /// A snapshot of one key's budget.
+    public struct Status: Sendable, Hashable {
+
+        /// Requests left in the bucket, or `nil` before any limit is known.
+        public var remainingRequests: Int?
+
+        /// Tokens left in the bucket, or `nil` before any limit is known.
+        public var remainingTokens: Int?
+
+        /// Requests sent and not yet answered.
+        public var inFlightRequests: Int
+
+        /// Requests waiting for budget.
+        public var queuedRequests: Int
+
+        /// Whether a 429 is holding every request for this key.
+        public var isPaused: Bool
+    }
+
+    /// Budget reserved by ``acquire(_:estimatedTokens:priority:)``.
+    ///
+    /// Pass it to ``complete(_:rateLimitInfo:statusCode:)`` once the
+    /// response headers arrive.
+    public struct Permit: Sendable, Hashable {
+        /// The key the budget was taken from.
+        public let key: String
+
+        /// Tokens reserved for the request.
+        public let estimatedTokens: Int
+    }
+
+    // MARK: - State
+
+    /// One token bucket, refilled linearly towards its capacity.
+    private struct Bucket {
+        var capacity: Double?
+        var level: Double?
+        var refillPerSecond: Double = 0
+        var updatedAt: ContinuousClock.Instant
+
+        mutating func refill(at now: ContinuousClock.Instant) {
+            guard let capacity, let current = level else { return }
+            let elapsed = Self.seconds(now - updatedAt)
+            level = min(capacity, current + refillPerSecond * elapsed)
+            updatedAt = now
+        }
+
+        /// Seconds until `cost` fits above `reserve`, or 0 when it fits now.
+        func wait(for cost: Double, reserve: Double) -> Double? {
+            guard let capacity, let level else { return 0 }
+            // A request larger than the bucket goes once the bucket is full
+            let needed = min(cost + reserve * capacity, capacity)
+            if level >= needed { return 0 }
+            guard refillPerSecond > 0 else { return nil }
+            return (needed - level) / refillPerSecond
+        }
+
+        mutating func take(_ cost: Double) {
+            if let current = level {
+                level = current - cost
+            }
+        }
+
+        mutating func update(
+            limit: Int?,
+            remaining: Int?,
+            reset: Date?,
+            inFlight: Double,
+            window: Duration,
+            now: ContinuousClock.Instant
+        ) {
+            if let limit {
+                capacity = Double(limit)
+            }
+            guard let remaining, let capacity else { return }
+
+            // Requests still in flight have not been counted by the server yet
+            level = Double(remaining) - inFlight
+            updatedAt = now
+            let missing = capacity - Double(remaining)
+            if let reset, reset.timeIntervalSinceNow > 0, missing > 0 {
+                refillPerSecond = missing / reset.timeIntervalSinceNow
+            } else {
+                refillPerSecond = capacity / max(Self.seconds(window), 1)
+            }
+        }
+
+        static func seconds(_ duration: Duration) -> Double {
+            let components = duration.components
+            return Double(components.seconds) + Double(components.attoseconds) / 1e18
+        }
+    }
+
+    private struct Waiter {
+        let id: Int
+        let priority: Priority
+        let tokens: Double
+        let continuation: CheckedContinuation<Void, Error>
+    }
+
+    private struct KeyState {
+        var requests: Bucket
+        var tokens: Bucket
+        var inFlightRequests = 0
+        var inFlightTokens = 0
+        var pausedUntil: ContinuousClock.Instant?
+        var waiters: [Waiter] = []
+        var wakeTask: Task<Void, Never>?
+
+        init(now: ContinuousClock.Instant) {
+            self.requests = Bucket(updatedAt: now)
+            self.tokens = Bucket(updatedAt: now)
+        }
+    }
+
+    /// Reserve and timing settings.
+    public nonisolated let configuration: Configuration
+
+    private var keys: [String: KeyState] = [:]
+    private var nextWaiterID = 0
+    private let clock = ContinuousClock()
+
+    // MARK: - Initialization
+
+    /// Creates a scheduler with no known limits.
+    ///
+    /// Limits are learned from the first responses for each key.
+    ///
+    /// - Parameter configuration: Reserve and timing settings.
+    public init(configuration: Configuration = .default) {
+        self.configuration = configuration
+    }
+
+    // MARK: - Scheduling
+
+    /// Waits until `key` has budget for one request of `estimatedTokens`.
+    ///
+    /// - Parameters:
+    ///   - key: The budget to draw from, usually the model identifier.
+    ///   - estimatedTokens: Prompt plus maximum completion tokens.
+    ///   - priority: The request's priority. Default: the task-local ``priority``
+    /// - Returns: A permit to pass to ``complete(_:rateLimitInfo:statusCode:)``.
+    /// - Throws: `CancellationError` if the task is cancelled while waiting.
+    public func acquire(
+        _ key: String,
+        estimatedTokens: Int = 0,
+        priority: Priority = RateLimitScheduler.priority
+    ) async throws -> Permit {
+        let tokens = max(0, estimatedTokens)
+        var state = keys[key] ?? KeyState(now: clock.now)
+
+        // Fast path: nothing queued ahead and the budget fits
+        if state.waiters.isEmpty, delay(for: Double(tokens), priority: priority, in: &state) == 0 {
+            take(Double(tokens), from: &state)
+            keys[key] = state
+            return Permit(key: key, estimatedTokens: tokens)
+        }
+
+        keys[key] = state
+        let id = nextWaiterID
+        nextWaiterID += 1
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+                guard !Task.isCancelled else {
+                    continuation.resume(throwing: CancellationError())
+                    return
+                }
+                let waiter = Waiter(id: id, priority: priority, tokens: Double(tokens), continuation: continuation)
+                enqueue(waiter, key: key)
+            }
+        } onCancel: {
+            Task { await self.cancelWaiter(id, key: key) }
+        }
+        return Permit(key: key, estimatedTokens: tokens)
+    }
+
+    /// Records the response to a request and releases its permit.
+    ///
+    /// - Parameters:
+    ///   - permit: The permit from ``acquire(_:estimatedTokens:priority:)``.
+    ///   - rateLimitInfo: Limits parsed from the response headers, if any.
+    ///   - statusCode: The HTTP status, or `nil` when the request failed
+    ///     before a response arrived.
+    public func complete(_ permit: Permit, rateLimitInfo: RateLimitInfo?, statusCode: Int?) {
+        guard var state = keys[permit.key] else { return }
+        let now = clock.now
+        state.inFlightRequests = max(0, state.inFlightRequests - 1)
+        state.inFlightTokens = max(0, state.inFlightTokens - permit.estimatedTokens)
+
+        if let info = rateLimitInfo {
+            state.requests.update(
+                limit: info.limitRequests,
+                remaining: info.remainingRequests,
+                reset: info.resetRequests,
+                inFlight: Double(state.inFlightRequests),
+                window: configuration.defaultWindow,
+                now: now
+            )
+            state.tokens.update(
+                limit: info.limitTokens,
+                remaining: info.remainingTokens,
+                reset: info.resetTokens,
+                inFlight: Double(state.inFlightTokens),
+                window: configuration.defaultWindow,
+                now: now
+            )
+        }
+
+        if statusCode == 429 {
+            let retryAfter = rateLimitInfo?.retryAfter.map { Duration.seconds($0) } ?? configuration.defaultRetryAfter
+            let pause = min(retryAfter, configuration.maxRetryAfter)
+            let until = now + pause
+            state.pausedUntil = max(state.pausedUntil ?? until, until)
+        }
+
+        keys[permit.key] = state
+        drain(permit.key)
+    }
+
+    /// The current budget for `key`.
+    public func status(for key: String) -> Status {
+        var state = keys[key] ?? KeyState(now: clock.now)
+        let now = clock.now
+        state.requests.refill(at: now)
+        state.tokens.refill(at: now)
+        return Status(
+            remainingRequests: state.requests.level.map { Int($0.rounded(.down)) },
+            remainingTokens: state.tokens.level.map { Int($0.rounded(.down)) },
+            inFlightRequests: state.inFlightRequests,
+            queuedRequests: state.waiters.count,
+            isPaused: state.pausedUntil.map { $0 > now } ?? false
+        )
+    }
+
+    // MARK: - Queue
+
+    private func enqueue(_ waiter: Waiter, key: String) {
+        guard var state = keys[key] else { return }
+        // Keep waiters sorted by priority, first-in first-out within one
+        let index = state.waiters.firstIndex { $0.priority < waiter.priority } ?? state.waiters.endIndex
+        state.waiters.insert(waiter, at: index)
+        keys[key] = state
+        drain(key)
+    }
+
+    private func cancelWaiter(_ id: Int, key: String) {
+        guard var state = keys[key],
+              let index = state.waiters.firstIndex(where: { $0.id == id }) else { return }
+        let waiter = state.waiters.remove(at: index)
+        keys[key] = state
+        waiter.continuation.resume(throwing: CancellationError())
+        drain(key)
+    }
+
+    /// Starts every waiter that fits, in order, and schedules a wake-up for the rest.
+    private func drain(_ key: String) {
+        guard var state = keys[key] else { return }
+        defer { keys[key] = state }
+
+        while let head = state.waiters.first {
+            guard let wait = delay(for: head.tokens, priority: head.priority, in: &state) else {
+                // No refill rate is known yet; a response will wake the queue
+                state.wakeTask?.cancel()
+                state.wakeTask = nil
+                return
+            }
+            guard wait == 0 else {
+                scheduleWake(key, after: wait, in: &state)
+                return
+            }
+            state.waiters.removeFirst()
+            take(head.tokens, from: &state)
+            head.continuation.resume()
+        }
+        state.wakeTask?.cancel()
+        state.wakeTask = nil
+    }
+
+    private func scheduleWake(_ key: String, after seconds: Double, in state: inout KeyState) {
+        state.wakeTask?.cancel()
+        state.wakeTask = Task {
+            try? await Task.sleep(for: .seconds(seconds))
+            guard !Task.isCancelled else { return }
+            await self.drain(key)
+        }
+    }
+
+    /// Seconds until a request fits, 0 if it fits now, or `nil` if unknown.
+    private func delay(for tokens: Double, priority: Priority, in state: inout KeyState) -> Double? {
+        let now = clock.now
+        if let pausedUntil = state.pausedUntil {
+            if pausedUntil > now {
+                return Bucket.seconds(pausedUntil - now)
+            }
+            state.pausedUntil = nil
+        }
+
+        state.requests.refill(at: now)
+        state.tokens.refill(at: now)
+        let reserve = priority == .batch ? configuration.interactiveReserve : 0
+        guard let requestWait = state.requests.wait(for: 1, reserve: reserve),
+              let tokenWait = state.tokens.wait(for: tokens, reserve: reserve) else {
+            // Without a refill rate only a response can free budget
+            return state.inFlightRequests == 0 ? 0 : nil
+        }
+        return max(requestWait, tokenWait)
+    }
+
+    private func take(_ tokens: Double, from state: inout KeyState) {
+        state.requests.take(1)
+        state.tokens.take(tokens)
+        state.inFlightRequests += 1
+        state.inFlightTokens += Int(tokens)
+    }
+
+    // MARK: - Hashable
+
+    public static func == (lhs: RateLimitScheduler, rhs: RateLimitScheduler) -> Bool {
+        lhs === rhs
+    }
+
+    public nonisolated func hash(into hasher: inout Hasher) {
+        hasher.combine(ObjectIdentifier(self))
+    }
+}
+
+// MARK: - Request Helpers
+
+extension RateLimitScheduler {
+
+    /// Sends a request within `scheduler`'s budget for `key`.
+    ///
+    /// Runs `send` directly when `scheduler` is `nil`. Otherwise waits for
+    /// budget, sends, and records the response headers. Runs on the
+    /// caller's actor.
+    ///
+    /// - Parameters:
+    ///   - scheduler: The scheduler to draw from, if any.
+    ///   - key: The budget to draw from.
+    ///   - estimatedTokens: Tokens reserved for the request.
+    ///   - send: Performs the HTTP request.
+    /// - Returns: The result of `send`.
+    internal static func send<T>(
+        through scheduler: RateLimitScheduler?,
+        key: String,
+        estimatedTokens: Int,
+        isolation: isolated (any Actor)? = #isolation,
+        _ send: () async throws -> (T, URLResponse)
+    ) async throws -> (T, URLResponse) {
+        guard let scheduler else {
+            return try await send()
+        }
+
+        let permit = try await scheduler.acquire(key, estimatedTokens: estimatedTokens)
+        let result: (T, URLResponse)
+        do {
+            result = try await send()
+        } catch {
+            await scheduler.complete(permit, rateLimitInfo: nil, statusCode: nil)
+            throw error
+        }
+
+        let httpResponse = result.1 as? HTTPURLResponse
+        await scheduler.complete(
+            permit,
+            rateLimitInfo: httpResponse.map { RateLimitInfo(response: $0) },
+            statusCode: httpResponse?.statusCode
+        )
+        return result
+    }
+
+    /// Estimated tokens a chat request counts against a tokens-per-minute limit.
+    ///
+    /// Providers count the prompt plus the requested completion budget, so
+    /// this sums about four characters per token over the messages and adds
+    /// `maxTokens`.
+    internal static func estimatedTokens(for messages: [Message], maxTokens: Int?) -> Int {
+        let characters = messages.reduce(0) { $0 + $1.content.textValue.utf8.count }
+        return (characters + 3) / 4 + (maxTokens ?? 0)
+    }
+}
@@ -0,0 +1,482 @@
+// ResponseCache.swift
+// Conduit
+//
+// Content-addressed cache for deterministic generations and embeddings.
+
+import Foundation
+
+// MARK: - ResponseCache
+
+/// A content-addressed store for generation and embedding responses.
+///
+/// Evaluation jobs and retries often send the same deterministic request
+/// many times. `ResponseCache` keys each request by a SHA-256 digest of its
+/// model, messages and ``GenerateConfig``, keeps recent responses in an
+/// in-memory LRU, and can persist them to a directory of memory-mapped
+/// files so they survive restarts.
+///
+/// The cache is used through ``CachedTextGenerator`` and
+/// ``CachedEmbeddingGenerator``, which sit in front of any provider. One
+/// cache can back several wrappers.
+///
+/// ## Usage
+/// ```swift
+/// let cache = ResponseCache(configuration: .persistent(at: cacheDirectory))
+/// let provider = CachedTextGenerator(OpenAIProvider(apiKey: "sk-..."), cache: cache)
+///
+/// let first = try await provider.generate("Classify: ...", model: .gpt4o, config: .default.temperature(0))
+/// let second = try await provider.generate("Classify: ...", model: .gpt4o, config: .default.temperature(0))
+/// print(await cache.metrics.hits) // 1
+/// ```
+///
+/// Identical requests that arrive while the first is still running share
+/// its upstream call. Cancelling one waiting caller does not cancel the
+/// shared request.
+///
+/// - Note: Generations are only cached when they are deterministic: a
+///   temperature of 0 or a fixed seed. Set
+///   ``Configuration/cachesSampledGenerations`` to cache every request.
+public actor ResponseCache {
+
+    // MARK: - Configuration
+
+    /// Size limits and persistence for a ``ResponseCache``.
+    public struct Configuration: Sendable, Hashable {
+
+        /// Maximum bytes of encoded responses held in memory.
+        public var memoryLimit: Int
+
+        /// Maximum responses held in memory.
+        public var maxEntries: Int
+
+        /// Directory for the on-disk store, or `nil` to keep responses in memory only.
+        public var directory: URL?
+
+        /// Maximum bytes kept in ``directory``.
+        public var diskLimit: Int
+
+        /// Whether generations with a nonzero temperature and no seed are cached.
+        public var cachesSampledGenerations: Bool
+
+        /// Creates a cache configuration.
+        ///
+        /// - Parameters:
+        ///   - memoryLimit: Bytes held in memory. Default: 64 MB
+        ///   - maxEntries: Responses held in memory. Clamped to at least 1. Default: 1000
+        ///   - directory: On-disk store location. Default: `nil`
+        ///   - diskLimit: Bytes kept on disk. Default: 512 MB
+        ///   - cachesSampledGenerations: Cache non-deterministic generations. Default: `false`
+        public init(
+            memoryLimit: Int = 64 * 1024 * 1024,
+            maxEntries: Int = 1000,
+            directory: URL? = nil,
+            diskLimit: Int = 512 * 1024 * 1024,
+            cachesSampledGenerations: Bool = false
+        ) {
+            self.memoryLimit = max(0, memoryLimit)
+            self.maxEntries = max(1, maxEntries)
+            self.directory = directory
+            self.diskLimit = max(0, diskLimit)
+            self.cachesSampledGenerations = cachesSampledGenerations
+        }
+
+        /// In-memory cache with default limits.
+        public static let `default` = Configuration()
+
+        /// In-memory cache backed by an on-disk store at `directory`.
+        public static func persistent(at directory: URL) -> Configuration {
+            Configuration(directory: directory)
+        }
+    }
+
+    // MARK: - Metrics
+
+    /// Counters describing how the cache has been used.
+    public struct Metrics: Sendable, Hashable {
+        /// Lookups answered from memory or disk.
+        public var hits = 0
+
+        /// Lookups that went to the provider.
+        public var misses = 0
+
+        /// Requests that waited on an identical in-flight request.
+        public var coalescedRequests = 0
+
+        /// Responses currently held in memory.
+        public var memoryEntries = 0
+
+        /// Bytes of encoded responses held in memory.
+        public var memoryBytes = 0
+
+        /// Bytes of encoded responses stored on disk.
+        public var diskBytes = 0
+
+        /// Responses dropped from memory or disk to stay within limits.
+        public var evictions = 0
+
+        /// Fraction of lookups that were hits, or 0 before any lookup.
+        public var hitRate: Double {
+            let lookups = hits + misses + coalescedRequests
+            return lookups == 0 ? 0 : Double(hits + coalescedRequests) / Double(lookups)
+        }
+    }
+
+    // MARK: - Key
+
+    /// The SHA-256 digest identifying a cached response.
+    public struct Key: Sendable, Hashable, CustomStringConvertible {
+        /// Lowercase hex digest.
+        public let digest: String
+
+        public var description: String { digest }
+    }
+
+    // MARK: - State
+
+    private struct MemoryEntry {
+        let data: Data
+        var lastAccess: UInt64
+    }
+
+    /// Cache settings.
+    public nonisolated let configuration: Configuration
+
+    private var memory: [Key: MemoryEntry] = [:]
+    private var accessClock: UInt64 = 0
+    private var inFlight: [Key: Task<Data, Error>] = [:]
+    private var diskUsage: Int?
+    private var counters = Metrics()
+
+    // MARK: - Initialization
+
+    /// Creates a response cache.
+    ///
+    /// - Parameter configuration: Size limits and persistence.
+    public init(configuration: Configuration = .default) {
+        self.configuration = configuration
+    }
+
+    // MARK: - Public API
+
+    /// Current hit, miss and size counters.
+    public var metrics: Metrics {
+        var metrics = counters
+        metrics.memoryEntries = memory.count
+        metrics.diskBytes = diskUsage ?? 0
+        return metrics
+    }
+
+    /// Removes every response from memory and disk.
+    ///
+    /// Only the cache's own entries are deleted; other files in
+    /// ``Configuration/directory`` are left alone.
+    public func removeAll() {
+        memory.removeAll()
+        counters.memoryBytes = 0
+        for file in diskFiles() {
+            try? FileManager.default.removeItem(at: file.url)
+        }
+        diskUsage = nil
+    }
+
+    // MARK: - Keys
+
+    /// The key for a generation request, or `nil` when it should not be cached.
+    nonisolated func key<ModelID: ModelIdentifying>(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) -> Key? {
+        guard configuration.cachesSampledGenerations || config.temperature == 0 || config.seed != nil else {
+            return nil
+        }
+        let material = GenerationKeyMaterial(
+            provider: model.provider.rawValue,
+            model: model.rawValue,
+            messages: messages.map(MessageKeyMaterial.init),
+            config: config
+        )
+        return Self.key(for: material, kind: "generation")
+    }
+
+    /// The key for embedding `text` with `model`.
+    nonisolated func key<ModelID: ModelIdentifying>(embedding text: String, model: ModelID) -> Key {
+        Self.key(for: [model.provider.rawValue, model.rawValue, text], kind: "embedding")
+    }
+
+    private static func key<Material: Encodable>(for material: Material, kind: String) -> Key {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.sortedKeys]
+        var digest = SHA256Digest()
+        digest.update("conduit.response-cache.v1.\(kind)\n")
+        // Encoding plain Codable values cannot fail; fall back to their description just in case
+        digest.update((try? encoder.encode(material)) ?? Data(String(describing: material).utf8))
+        return Key(digest: digest.finalize())
+    }
+
+    // MARK: - Lookup and Storage
+
+    /// Returns the cached value for `key`, or computes, stores and returns it.
+    ///
+    /// Concurrent calls for the same key share one `compute` call.
+    func value<Value: Codable & Sendable>(
+        for key: Key,
+        as type: Value.Type = Value.self,
+        compute: @escaping @Sendable () async throws -> Value
+    ) async throws -> Value {
+        if let data = lookup(key), let value = try? JSONDecoder().decode(Value.self, from: data) {
+            counters.hits += 1
+            return value
+        }
+        if let task = inFlight[key] {
+            counters.coalescedRequests += 1
+            return try JSONDecoder().decode(Value.self, from: await task.value)
+        }
+
+        counters.misses += 1
+        let task = Task<Data, Error> {
+            try JSONEncoder().encode(try await compute())
+        }
+        inFlight[key] = task
+        defer { inFlight[key] = nil }
+
+        let data = try await task.value
+        insert(data, for: key)
+        return try JSONDecoder().decode(Value.self, from: data)
+    }
+
+    /// Returns the cached value for `key`, counting a hit or miss.
+    ///
+    /// Waits for an identical in-flight request if there is one.
+    func cachedValue<Value: Decodable>(for key: Key, as type: Value.Type = Value.self) async -> Value? {
+        if let data = lookup(key), let value = try? JSONDecoder().decode(Value.self, from: data) {
+            counters.hits += 1
+            return value
+        }
+        if let task = inFlight[key], let data = try? await task.value {
+            counters.coalescedRequests += 1
+            return try? JSONDecoder().decode(Value.self, from: data)
+        }
+        counters.misses += 1
+        return nil
+    }
+
+    /// Counts a request that was answered by joining an identical one in flight.
+    func recordCoalescedRequest() {
+        counters.coalescedRequests += 1
+    }
+
+    /// Stores `value` under `key` in memory and, if configured, on disk.
+    func store<Value: Encodable>(_ value: Value, for key: Key) {
+        guard let data = try? JSONEncoder().encode(value) else { return }
+        insert(data, for: key)
+    }
+
+    private func lookup(_ key: Key) -> Data? {
+        accessClock += 1
+        if var entry = memory[key] {
+            entry.lastAccess = accessClock
+            memory[key] = entry
+            return entry.data
+        }
+        guard let url = fileURL(for: key),
+              let data = try? Data(contentsOf: url, options: .alwaysMapped) else {
+            return nil
+        }
+        try? FileManager.default.setAttributes([.modificationDate: Date()], ofItemAtPath: url.path)
+        insertInMemory(data, for: key)
+        return data
+    }
+
+    private func insert(_ data: Data, for key: Key) {
+        insertInMemory(data, for: key)
+        writeToDisk(data, for: key)
+    }
+
+    // MARK: - Memory Store
+
+    private func insertInMemory(_ data: Data, for key: Key) {
+        guard data.count <= configuration.memoryLimit else { return }
+        accessClock += 1
+        if let previous = memory.updateValue(MemoryEntry(data: data, lastAccess: accessClock), forKey: key) {
+            counters.memoryBytes -= previous.data.count
+        }
+        counters.memoryBytes += data.count
+
+        while memory.count > configuration.maxEntries || counters.memoryBytes > configuration.memoryLimit,
+              let oldest = memory.min(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+            memory[oldest.key] = nil
+            counters.memoryBytes -= oldest.value.data.count
+            counters.evictions += 1
+        }
+    }
+
+    // MARK: - Disk Store
+
+    private func fileURL(for key: Key) -> URL? {
+        configuration.directory?.appendingPathComponent("\(key.digest).json")
+    }
+
+    private func writeToDisk(_ data: Data, for key: Key) {
+        guard let directory = configuration.directory, let url = fileURL(for: key),
+              data.count <= configuration.diskLimit else {
+            return
+        }
+        let fileManager = FileManager.default
+        do {
+            try fileManager.createDirectory(at: directory, withIntermediateDirectories: true)
+            let existing = (try? fileManager.attributesOfItem(atPath: url.path)[.size] as? Int) ?? 0
+            try data.write(to: url, options: .atomic)
+            diskUsage = currentDiskUsage() - existing + data.count
+        } catch {
+            return
+        }
+        trimDisk()
+    }
+
+    private func currentDiskUsage() -> Int {
+        if let diskUsage { return diskUsage }
+        let usage = diskFiles().reduce(0) { $0 + $1.size }
+        diskUsage = usage
+        return usage
+    }
+
+    private func trimDisk() {
+        guard currentDiskUsage() > configuration.diskLimit else { return }
+        var usage = currentDiskUsage()
+        for file in diskFiles().sorted(by: { $0.modified < $1.modified }) where usage > configuration.diskLimit {
+            guard (try? FileManager.default.removeItem(at: file.url)) != nil else { continue }
+            usage -= file.size
+            counters.evictions += 1
+        }
+        diskUsage = max(0, usage)
+    }
+
+    private func diskFiles() -> [(url: URL, size: Int, modified: Date)] {
+        guard let directory = configuration.directory,
+              let urls = try? FileManager.default.contentsOfDirectory(
+                  at: directory,
+                  includingPropertiesForKeys: [.fileSizeKey, .contentModificationDateKey]
+              ) else {
+            return []
+        }
+        return urls.filter(Self.isEntry).map { url in
+            let values = try? url.resourceValues(forKeys: [.fileSizeKey, .contentModificationDateKey])
+            return (url, values?.fileSize ?? 0, values?.contentModificationDate ?? .distantPast)
+        }
+    }
+
+    /// Whether `url` names an entry written by ``writeToDisk(_:for:)``: a SHA-256 hex digest plus `.json`.
+    private static func isEntry(_ url: URL) -> Bool {
+        guard url.pathExtension == "json" else { return false }
+        let name = url.deletingPathExtension().lastPathComponent
+        return name.utf8.count == 64 && name.utf8.allSatisfy { (48...57).contains($0) || (97...102).contains($0) }
+    }
+}
+
+// MARK: - Key Material
+
+/// The parts of a generation request that determine its response.
+private struct GenerationKeyMaterial: Encodable {
+    let provider: String
+    let model: String
+    let messages: [MessageKeyMaterial]
+    let config: GenerateConfig
+}
+
+/// A message without its identifier, timestamp or timing metadata.
+private struct MessageKeyMaterial: Encodable {
+    let role: Message.Role
+    let content: Message.Content
+    let toolCalls: [Transcript.ToolCall]?
+    let custom: [String: String]?
+
+    init(_ message: Message) {
+        role = message.role
+        content = message.content
+        toolCalls = message.metadata?.toolCalls
+        custom = message.metadata?.custom
+    }
+}
+
+// MARK: - Stored Values
+
+/// The encoded form of a cached ``GenerationResult``.
+struct CachedGeneration: Codable, Sendable {
+    let text: String
+    let tokenCount: Int
+    let generationTime: TimeInterval
+    let tokensPerSecond: Double
+    let finishReason: FinishReason
+    let logprobs: [TokenLogprob]?
+    let usage: UsageStats?
+    let toolCalls: [Transcript.ToolCall]
+    let reasoningDetails: [ReasoningDetail]
+
+    init(_ result: GenerationResult) {
+        text = result.text
+        tokenCount = result.tokenCount
+        generationTime = result.generationTime
+        tokensPerSecond = result.tokensPerSecond
+        finishReason = result.finishReason
+        logprobs = result.logprobs
+        usage = result.usage
+        toolCalls = result.toolCalls
+        reasoningDetails = result.reasoningDetails
+    }
+
+    var result: GenerationResult {
+        GenerationResult(
+            text: text,
+            tokenCount: tokenCount,
+            generationTime: generationTime,
+            tokensPerSecond: tokensPerSecond,
+            finishReason: finishReason,
+            logprobs: logprobs,
+            usage: usage,
+            toolCalls: toolCalls,
+            reasoningDetails: reasoningDetails
+        )
+    }
+
+    /// Replays the result as a text chunk followed by a completion chunk.
+    var chunks: [GenerationChunk] {
+        var chunks: [GenerationChunk] = []
+        if !text.isEmpty {
+            chunks.append(GenerationChunk(text: text, tokenCount: tokenCount))
+        }
+        chunks.append(GenerationChunk(
+            text: "",
+            tokenCount: 0,
+            isComplete: true,
+            finishReason: finishReason,
+            usage: usage,
+            completedToolCalls: toolCalls.isEmpty ? nil : toolCalls,
+            reasoningDetails: reasoningDetails.isEmpty ? nil : reasoningDetails
+        ))
+        return chunks
+    }
+}
+
+/// The encoded form of a cached ``EmbeddingResult``.
+///
+/// The vector is stored as raw float bytes rather than a JSON array of numbers.
+struct CachedEmbedding: Codable, Sendable {
+    let vector: Data
+    let text: String
+    let model: String
+    let tokenCount: Int?
+
+    init(_ result: EmbeddingResult) {
+        vector = result.vector.withUnsafeBytes { Data($0) }
+        text = result.text
+        model = result.model
+        tokenCount = result.tokenCount
+    }
+
+    var result: EmbeddingResult {
+        var floats = [Float](repeating: 0, count: vector.count / MemoryLayout<Float>.stride)
+        _ = floats.withUnsafeMutableBytes { vector.copyBytes(to: $0) }
+        return EmbeddingResult(vector: floats, text: text, model: model, tokenCount: tokenCount)
+    }
+}
@@ -0,0 +1,150 @@
+// SHA256Digest.swift
+// Conduit
+//
+// Incremental SHA-256 that works with or without CryptoKit.
+
+import Foundation
+
+#if canImport(CryptoKit)
+import CryptoKit
+#endif
+
+/// An incremental SHA-256 hasher producing lowercase hex digests.
+///
+/// Uses CryptoKit where it is available and a portable implementation
+/// elsewhere (e.g. Linux), so digests are identical on every platform.
+///
+/// ```swift
+/// var digest = SHA256Digest()
+/// digest.update(chunk1)
+/// digest.update(chunk2)
+/// let hex = digest.finalize()
+/// ```
+struct SHA256Digest {
+
+    #if canImport(CryptoKit)
+    private var hasher = SHA256()
+    #else
+    private var state: [UInt32] = [
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    ]
+    private var pending: [UInt8] = []
+    private var byteCount: UInt64 = 0
+    #endif
+
+    init() {}
+
+    /// The hex digest of `data`.
+    static func hex(of data: Data) -> String {
+        var digest = SHA256Digest()
+        digest.update(data)
+        return digest.finalize()
+    }
+
+    /// Feeds more bytes into the hash.
+    mutating func update(_ data: Data) {
+        #if canImport(CryptoKit)
+        hasher.update(data: data)
+        #else
+        byteCount &+= UInt64(data.count)
+        pending.append(contentsOf: data)
+        var offset = 0
+        while pending.count - offset >= 64 {
+            compress(pending, at: offset)
+            offset += 64
+        }
+        pending.removeFirst(offset)
+        #endif
+    }
+
+    /// Feeds the UTF-8 bytes of `string` into the hash.
+    mutating func update(_ string: String) {
+        update(Data(string.utf8))
+    }
+
+    /// Finishes the hash and returns the lowercase hex digest.
+    mutating func finalize() -> String {
+        #if canImport(CryptoKit)
+        return hasher.finalize().map { String(format: "%02x", $0) }.joined()
+        #else
+        var tail = pending
+        tail.append(0x80)
+        while tail.count % 64 != 56 {
+            tail.append(0)
+        }
+        let bits = byteCount &* 8
+        for shift in stride(from: 56, through: 0, by: -8) {
+            tail.append(UInt8(truncatingIfNeeded: bits >> UInt64(shift)))
+        }
+        for offset in stride(from: 0, to: tail.count, by: 64) {
+            compress(tail, at: offset)
+        }
+        pending = []
+        return state.map { String(format: "%08x", $0) }.joined()
+        #endif
+    }
+
+    #if !canImport(CryptoKit)
+    private static let roundConstants: [UInt32] = [
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+    ]
+
+    private mutating func compress(_ bytes: [UInt8], at offset: Int) {
+        var words = [UInt32](repeating: 0, count: 64)
+        for index in 0..<16 {
+            let byte = offset + index * 4
+            words[index] = UInt32(bytes[byte]) << 24 | UInt32(bytes[byte + 1]) << 16
+                | UInt32(bytes[byte + 2]) << 8 | UInt32(bytes[byte + 3])
+        }
+        for index in 16..<64 {
+            let s0 = words[index - 15].rotatedRight(7) ^ words[index - 15].rotatedRight(18) ^ (words[index - 15] >> 3)
+            let s1 = words[index - 2].rotatedRight(17) ^ words[index - 2].rotatedRight(19) ^ (words[index - 2] >> 10)
+            words[index] = words[index - 16] &+ s0 &+ words[index - 7] &+ s1
+        }
+
+        var a = state[0], b = state[1], c = state[2], d = state[3]
+        var e = state[4], f = state[5], g = state[6], h = state[7]
+        for index in 0..<64 {
+            let sum1 = e.rotatedRight(6) ^ e.rotatedRight(11) ^ e.rotatedRight(25)
+            let choice = (e & f) ^ (~e & g)
+            let temp1 = h &+ sum1 &+ choice &+ Self.roundConstants[index] &+ words[index]
+            let sum0 = a.rotatedRight(2) ^ a.rotatedRight(13) ^ a.rotatedRight(22)
+            let majority = (a & b) ^ (a & c) ^ (b & c)
+            let temp2 = sum0 &+ majority
+            h = g
+            g = f
+            f = e
+            e = d &+ temp1
+            d = c
+            c = b
+            b = a
+            a = temp1 &+ temp2
+        }
+
+        state[0] &+= a
+        state[1] &+= b
+        state[2] &+= c
+        state[3] &+= d
+        state[4] &+= e
+        state[5] &+= f
+        state[6] &+= g
+        state[7] &+= h
+    }
+    #endif
+}
+
+#if !canImport(CryptoKit)
+private extension UInt32 {
+    func rotatedRight(_ count: UInt32) -> UInt32 {
+        (self >> count) | (self << (32 - count))
+    }
+}
+#endif
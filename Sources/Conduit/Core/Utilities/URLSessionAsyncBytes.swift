@@ -1,9 +1,10 @@
 // URLSessionAsyncBytes.swift
 // Conduit
 //
-// Cross-platform async byte streaming for URLSession.
-// On Apple platforms, uses native URLSession.bytes(for:).
-// On Linux, provides a polyfill using URLSessionDataTask with delegate.
+// Cross-platform async streaming for URLSession.
+// Response bodies are delivered as whole `Data` chunks straight from the
+// URLSession data delegate. Byte and line views are thin adapters over the
+// chunk stream, so no per-byte async hop is introduced anywhere.
 
 import Foundation
 
@@ -11,15 +12,91 @@ import Foundation
 import FoundationNetworking
 #endif
 
-// MARK: - Cross-Platform Byte Streaming
+// MARK: - Chunk Streaming
 
-#if canImport(FoundationNetworking)
+/// An async sequence of response body chunks as they arrive from the server.
+///
+/// This is the primary streaming primitive. Each element is the `Data` buffer
+/// delivered by a single `urlSession(_:dataTask:didReceive:)` callback, so
+/// consumers pay one async hop per network read rather than per byte.
+///
+/// ## Usage
+///
+/// ```swift
+/// let (chunks, response) = try await session.asyncChunks(for: request)
+/// for try await chunk in chunks {
+///     // Process a whole buffer
+/// }
+/// // Or iterate lines:
+/// for try await line in chunks.lines {
+///     // Process line
+/// }
+/// ```
+public struct URLSessionAsyncChunks: AsyncSequence, Sendable {
+    public typealias Element = Data
+
+    private let stream: AsyncThrowingStream<Data, Error>
+
+    init(stream: AsyncThrowingStream<Data, Error>) {
+        self.stream = stream
+    }
+
+    public func makeAsyncIterator() -> AsyncIterator {
+        AsyncIterator(iterator: stream.makeAsyncIterator())
+    }
+
+    public struct AsyncIterator: AsyncIteratorProtocol {
+        var iterator: AsyncThrowingStream<Data, Error>.AsyncIterator
+
+        public mutating func next() async throws -> Data? {
+            try await iterator.next()
+        }
+    }
+
+    /// A byte-at-a-time view of the chunk stream.
+    public var bytes: URLSessionAsyncBytes {
+        URLSessionAsyncBytes(chunks: self)
+    }
+
+    /// An async sequence of lines from the chunk stream.
+    ///
+    /// Lines are delimited by `\n`, `\r`, or `\r\n`. The delimiter is not included
+    /// in the returned strings.
+    public var lines: AsyncLineSequence {
+        AsyncLineSequence(chunks: self)
+    }
+
+    /// Collects the response body up to `maxBytes`.
+    ///
+    /// Useful for reading bounded error bodies without iterating byte by byte.
+    ///
+    /// - Parameter maxBytes: The maximum number of bytes to keep.
+    /// - Returns: The collected data and whether the body exceeded `maxBytes`.
+    public func collect(upTo maxBytes: Int) async throws -> (data: Data, truncated: Bool) {
+        var data = Data()
+        data.reserveCapacity(min(maxBytes, 16 * 1024))
+
+        for try await chunk in self {
+            let remaining = maxBytes - data.count
+            if chunk.count > remaining {
+                data.append(chunk.prefix(remaining))
+                return (data, true)
+            }
+            data.append(chunk)
+        }
+        return (data, false)
+    }
+}
+
+// MARK: - Byte Streaming
 
-/// A cross-platform async sequence of bytes for streaming HTTP responses on Linux.
+/// A cross-platform async sequence of bytes for streaming HTTP responses.
 ///
-/// This type provides Linux compatibility for `URLSession.bytes(for:)` which is
-/// only available on Apple platforms. It uses a delegate-based approach to
-/// stream bytes as they arrive from the server.
+/// This type mirrors `URLSession.AsyncBytes` on every platform, including
+/// Linux where the native API is unavailable. It is a thin adapter over
+/// ``URLSessionAsyncChunks``: bytes are read out of each received buffer
+/// in place, and the underlying stream is only awaited when a buffer is
+/// exhausted.
 ///
 /// ## Usage
 ///
@@ -36,21 +113,34 @@ import FoundationNetworking
 public struct URLSessionAsyncBytes: AsyncSequence, Sendable {
     public typealias Element = UInt8
 
-    private let stream: AsyncThrowingStream<UInt8, Error>
+    /// The underlying chunk stream.
+    public let chunks: URLSessionAsyncChunks
 
-    init(stream: AsyncThrowingStream<UInt8, Error>) {
-        self.stream = stream
+    init(chunks: URLSessionAsyncChunks) {
+        self.chunks = chunks
     }
 
     public func makeAsyncIterator() -> AsyncIterator {
-        AsyncIterator(iterator: stream.makeAsyncIterator())
+        AsyncIterator(chunksIterator: chunks.makeAsyncIterator())
     }
 
     public struct AsyncIterator: AsyncIteratorProtocol {
-        var iterator: AsyncThrowingStream<UInt8, Error>.AsyncIterator
+        var chunksIterator: URLSessionAsyncChunks.AsyncIterator
+        var current = Data()
+        var index = 0
 
         public mutating func next() async throws -> UInt8? {
-            try await iterator.next()
+            while index == current.endIndex {
+                guard let chunk = try await chunksIterator.next() else {
+                    return nil
+                }
+                current = chunk
+                index = chunk.startIndex
+            }
+
+            let byte = current[index]
+            index = current.index(after: index)
+            return byte
         }
     }
 
@@ -59,11 +149,17 @@ public struct URLSessionAsyncBytes: AsyncSequence, Sendable {
     /// Lines are delimited by `\n`, `\r`, or `\r\n`. The delimiter is not included
     /// in the returned strings.
     public var lines: AsyncLineSequence {
-        AsyncLineSequence(bytes: self)
+        AsyncLineSequence(chunks: chunks)
     }
 }
 
-/// An async sequence that yields lines from a byte stream.
+// MARK: - Line Streaming
+
+/// An async sequence that yields lines from a chunked byte stream.
+///
+/// Lines are split with a ``ByteLineSplitter`` that scans each received
+/// buffer once and advances a read cursor, so long lines spanning many
+/// chunks cost linear rather than quadratic time.
 public struct AsyncLineSequence: AsyncSequence, Sendable {
     public typealias Element = String
 
@@ -71,83 +167,68 @@ public struct AsyncLineSequence: AsyncSequence, Sendable {
     /// If a line exceeds this size, an error will be thrown.
     public static let maxBufferSize = 10 * 1024 * 1024
 
-    private let bytes: URLSessionAsyncBytes
+    private let chunks: URLSessionAsyncChunks
 
-    init(bytes: URLSessionAsyncBytes) {
-        self.bytes = bytes
+    init(chunks: URLSessionAsyncChunks) {
+        self.chunks = chunks
     }
 
     public func makeAsyncIterator() -> AsyncIterator {
-        AsyncIterator(bytesIterator: bytes.makeAsyncIterator())
+        AsyncIterator(chunksIterator: chunks.makeAsyncIterator())
     }
 
     public struct AsyncIterator: AsyncIteratorProtocol {
-        var bytesIterator: URLSessionAsyncBytes.AsyncIterator
-        var buffer: [UInt8] = []
+        var chunksIterator: URLSessionAsyncChunks.AsyncIterator
+        var splitter = ByteLineSplitter()
         var finished = false
 
         public mutating func next() async throws -> String? {
             if finished { return nil }
 
             while true {
-                // Check if we have a complete line in the buffer
-                if let newlineIndex = buffer.firstIndex(where: { $0 == UInt8(ascii: "\n") || $0 == UInt8(ascii: "\r") }) {
-                    let delimiter = buffer[newlineIndex]
-                    let lineBytes = Array(buffer[..<newlineIndex])
-                    var removeCount = newlineIndex + 1
-                    if delimiter == UInt8(ascii: "\r"),
-                       removeCount < buffer.count,
-                       buffer[removeCount] == UInt8(ascii: "\n") {
-                        removeCount += 1
-                    }
-                    buffer.removeFirst(removeCount)
-                    return String(decoding: lineBytes, as: UTF8.self)
+                if let line = splitter.nextLine() {
+                    return String(decoding: line, as: UTF8.self)
                 }
 
                 // Check buffer size limit before reading more bytes
-                if buffer.count >= AsyncLineSequence.maxBufferSize {
+                if splitter.bufferedByteCount >= AsyncLineSequence.maxBufferSize {
                     throw URLError(.dataLengthExceedsMaximum)
                 }
 
-                // Read more bytes
-                guard let byte = try await bytesIterator.next() else {
+                guard let chunk = try await chunksIterator.next() else {
                     // End of stream - return remaining buffer if non-empty
                     finished = true
-                    if buffer.isEmpty {
+                    guard let remaining = splitter.finish() else {
                         return nil
                     }
-                    // Handle trailing \r
-                    if buffer.last == UInt8(ascii: "\r") {
-                        buffer.removeLast()
-                    }
-                    let remaining = String(decoding: buffer, as: UTF8.self)
-                    buffer.removeAll()
-                    return remaining.isEmpty ? nil : remaining
+                    return String(decoding: remaining, as: UTF8.self)
                 }
 
-                buffer.append(byte)
+                splitter.append(chunk)
             }
         }
     }
 }
 
-/// Delegate for streaming HTTP response data on Linux.
+// MARK: - Data Delegate
+
+/// Delegate for streaming HTTP response data as whole chunks.
 ///
-/// This class buffers incoming data and feeds it to an AsyncThrowingStream
-/// for consumption by async/await code.
+/// Each `Data` buffer delivered by URLSession is yielded unchanged to an
+/// `AsyncThrowingStream` for consumption by async/await code.
 ///
 /// ## Thread Safety
 /// NSLock is used to synchronize access to mutable state. The `@unchecked Sendable`
 /// conformance is safe because all mutable state is protected by the lock
 /// and lock is never held across await points.
 final class StreamingDataDelegate: NSObject, URLSessionDataDelegate, @unchecked Sendable {
-    private let continuation: AsyncThrowingStream<UInt8, Error>.Continuation
+    private let continuation: AsyncThrowingStream<Data, Error>.Continuation
     private let responseContinuation: CheckedContinuation<URLResponse, Error>
     private var hasReceivedResponse = false
     private let lock = NSLock()
 
     init(
-        continuation: AsyncThrowingStream<UInt8, Error>.Continuation,
+        continuation: AsyncThrowingStream<Data, Error>.Continuation,
         responseContinuation: CheckedContinuation<URLResponse, Error>
     ) {
         self.continuation = continuation
@@ -172,9 +253,8 @@ final class StreamingDataDelegate: NSObject, URLSessionDataDelegate, @unchecked
     }
 
     func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
-        for byte in data {
-            continuation.yield(byte)
-        }
+        guard !data.isEmpty else { return }
+        continuation.yield(data)
     }
 
     func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
@@ -206,47 +286,43 @@ final class StreamingDataDelegate: NSObject, URLSessionDataDelegate, @unchecked
     }
 }
 
+// MARK: - URLSession Extension
+
 extension URLSession {
-    /// Streams bytes from a URL request asynchronously (Linux polyfill).
+    /// Streams response body chunks from a URL request asynchronously.
     ///
-    /// This method provides Linux compatibility for the Apple-only
-    /// `URLSession.bytes(for:)` API. It uses a delegate-based approach
-    /// to stream response data as it arrives.
+    /// Each element is a `Data` buffer as delivered by the URLSession data
+    /// delegate. Prefer this over ``asyncBytes(for:)`` in hot streaming paths.
     ///
     /// - Parameter request: The URL request to execute.
-    /// - Returns: A tuple containing an async byte stream and the URL response.
+    /// - Returns: A tuple containing an async chunk stream and the URL response.
     /// - Throws: `URLError` if the request fails.
     ///
     /// - Note: On Linux, this creates a new session with default configuration
     ///   because `URLSession.configuration` is not safely reusable with
-    ///   FoundationNetworking's libcurl backend.
-    public func asyncBytes(for request: URLRequest) async throws -> (URLSessionAsyncBytes, URLResponse) {
-        // Validate URL before passing to libcurl to prevent CURLE_BAD_FUNCTION_ARGUMENT (error 43)
-        guard let url = request.url else {
-            throw URLError(.badURL, userInfo: [
-                NSLocalizedDescriptionKey: "URLRequest has nil URL"
-            ])
-        }
-
-        guard let scheme = url.scheme?.lowercased(),
-              scheme == "http" || scheme == "https" else {
-            throw URLError(.unsupportedURL, userInfo: [
-                NSLocalizedDescriptionKey: "URL scheme must be http or https, got: \(url.scheme ?? "nil")"
-            ])
-        }
-
-        guard url.host != nil else {
-            throw URLError(.badURL, userInfo: [
-                NSLocalizedDescriptionKey: "URL must have a host component"
-            ])
-        }
-
-        // Create a dedicated session with delegate for streaming
-        var streamContinuation: AsyncThrowingStream<UInt8, Error>.Continuation!
+    ///   FoundationNetworking's libcurl backend. On Apple platforms the task
+    ///   runs on this session with a task-level delegate, so connection
+    ///   pooling and session configuration are preserved.
+    public func asyncChunks(for request: URLRequest) async throws -> (URLSessionAsyncChunks, URLResponse) {
+        try await asyncChunks(for: request, linuxConfiguration: .default, onTermination: nil)
+    }
 
-        let byteStream = AsyncThrowingStream<UInt8, Error> { continuation in
-            streamContinuation = continuation
-        }
+    /// Streams response body chunks, running `onTermination` once the stream ends.
+    ///
+    /// - Parameters:
+    ///   - request: The URL request to execute.
+    ///   - linuxConfiguration: Configuration for the per-stream session used
+    ///     with FoundationNetworking. Ignored on Apple platforms.
+    ///   - onTermination: Called once when the body finishes, fails, or is
+    ///     cancelled, or when the request fails before a response arrives.
+    internal func asyncChunks(
+        for request: URLRequest,
+        linuxConfiguration: @autoclosure () -> URLSessionConfiguration,
+        onTermination: (@Sendable () -> Void)?
+    ) async throws -> (URLSessionAsyncChunks, URLResponse) {
+        try Self.validateStreamingRequest(request)
+
+        let (chunkStream, streamContinuation) = AsyncThrowingStream<Data, Error>.makeStream()
 
         let response: URLResponse = try await withCheckedThrowingContinuation { responseContinuation in
             let delegate = StreamingDataDelegate(
@@ -254,11 +330,12 @@ extension URLSession {
                 responseContinuation: responseContinuation
             )
 
+            #if canImport(FoundationNetworking)
             // Use fresh default configuration instead of self.configuration
             // to avoid libcurl errors on Linux where session configuration
             // may not be safely accessible after creation.
             let streamingSession = URLSession(
-                configuration: .default,
+                configuration: linuxConfiguration(),
                 delegate: delegate,
                 delegateQueue: nil
             )
@@ -268,132 +345,41 @@ extension URLSession {
             streamContinuation.onTermination = { @Sendable _ in
                 task.cancel()
                 streamingSession.invalidateAndCancel()
+                onTermination?()
             }
+            #else
+            let task = self.dataTask(with: request)
+            task.delegate = delegate
 
-            task.resume()
-        }
-
-        return (URLSessionAsyncBytes(stream: byteStream), response)
-    }
-}
-
-#else
-
-// MARK: - Apple Platforms Wrapper
-
-/// Wrapper around native URLSession.AsyncBytes for API consistency.
-///
-/// On Apple platforms, this provides the same interface as the Linux polyfill
-/// while delegating to the native implementation.
-public struct URLSessionAsyncBytes: AsyncSequence, Sendable {
-    public typealias Element = UInt8
-
-    private let nativeBytes: URLSession.AsyncBytes
-
-    init(nativeBytes: URLSession.AsyncBytes) {
-        self.nativeBytes = nativeBytes
-    }
-
-    public func makeAsyncIterator() -> AsyncIterator {
-        AsyncIterator(nativeIterator: nativeBytes.makeAsyncIterator())
-    }
-
-    public struct AsyncIterator: AsyncIteratorProtocol {
-        var nativeIterator: URLSession.AsyncBytes.AsyncIterator
+            streamContinuation.onTermination = { @Sendable _ in
+                task.cancel()
+                onTermination?()
+            }
+            #endif
 
-        public mutating func next() async throws -> UInt8? {
-            try await nativeIterator.next()
+            task.resume()
         }
-    }
 
-    /// An async sequence of lines from the byte stream.
-    public var lines: AsyncLineSequence {
-        AsyncLineSequence(bytes: self)
+        return (URLSessionAsyncChunks(stream: chunkStream), response)
     }
-}
 
-/// An async sequence that yields lines from a byte stream (Apple platforms).
-///
-/// This implementation mirrors the Linux polyfill for API consistency,
-/// parsing lines from raw bytes rather than wrapping the native `.lines`.
-public struct AsyncLineSequence: AsyncSequence, Sendable {
-    public typealias Element = String
-
-    /// Maximum buffer size in bytes (10 MB) to prevent unbounded memory growth.
-    /// If a line exceeds this size, an error will be thrown.
-    public static let maxBufferSize = 10 * 1024 * 1024
-
-    private let bytes: URLSessionAsyncBytes
-
-    init(bytes: URLSessionAsyncBytes) {
-        self.bytes = bytes
-    }
-
-    public func makeAsyncIterator() -> AsyncIterator {
-        AsyncIterator(bytesIterator: bytes.makeAsyncIterator())
-    }
-
-    public struct AsyncIterator: AsyncIteratorProtocol {
-        var bytesIterator: URLSessionAsyncBytes.AsyncIterator
-        var buffer: [UInt8] = []
-        var finished = false
-
-        public mutating func next() async throws -> String? {
-            if finished { return nil }
-
-            while true {
-                // Check if we have a complete line in the buffer
-                if let newlineIndex = buffer.firstIndex(where: { $0 == UInt8(ascii: "\n") || $0 == UInt8(ascii: "\r") }) {
-                    let delimiter = buffer[newlineIndex]
-                    let lineBytes = Array(buffer[..<newlineIndex])
-                    var removeCount = newlineIndex + 1
-                    if delimiter == UInt8(ascii: "\r"),
-                       removeCount < buffer.count,
-                       buffer[removeCount] == UInt8(ascii: "\n") {
-                        removeCount += 1
-                    }
-                    buffer.removeFirst(removeCount)
-                    return String(decoding: lineBytes, as: UTF8.self)
-                }
-
-                // Check buffer size limit before reading more bytes
-                if buffer.count >= AsyncLineSequence.maxBufferSize {
-                    throw URLError(.dataLengthExceedsMaximum)
-                }
-
-                // Read more bytes
-                guard let byte = try await bytesIterator.next() else {
-                    // End of stream - return remaining buffer if non-empty
-                    finished = true
-                    if buffer.isEmpty {
-                        return nil
-                    }
-                    // Handle trailing \r
-                    if buffer.last == UInt8(ascii: "\r") {
-                        buffer.removeLast()
-                    }
-                    let remaining = String(decoding: buffer, as: UTF8.self)
-                    buffer.removeAll()
-                    return remaining.isEmpty ? nil : remaining
-                }
-
-                buffer.append(byte)
-            }
-        }
-    }
-}
-
-extension URLSession {
     /// Streams bytes from a URL request asynchronously.
     ///
-    /// On Apple platforms, this wraps the native `URLSession.bytes(for:)`
-    /// API for API consistency with the Linux polyfill.
+    /// This method provides a cross-platform equivalent of the Apple-only
+    /// `URLSession.bytes(for:)` API. The returned sequence is a byte view
+    /// over ``asyncChunks(for:)``; use its `chunks` or `lines` properties
+    /// to avoid per-byte iteration.
     ///
     /// - Parameter request: The URL request to execute.
-    /// - Returns: A tuple containing the async byte stream and the URL response.
+    /// - Returns: A tuple containing an async byte stream and the URL response.
     /// - Throws: `URLError` if the request fails.
     public func asyncBytes(for request: URLRequest) async throws -> (URLSessionAsyncBytes, URLResponse) {
-        // Validate URL for consistency with Linux implementation
+        let (chunks, response) = try await asyncChunks(for: request)
+        return (URLSessionAsyncBytes(chunks: chunks), response)
+    }
+
+    private static func validateStreamingRequest(_ request: URLRequest) throws {
+        // Validate URL before passing to libcurl to prevent CURLE_BAD_FUNCTION_ARGUMENT (error 43)
         guard let url = request.url else {
             throw URLError(.badURL, userInfo: [
                 NSLocalizedDescriptionKey: "URLRequest has nil URL"
@@ -412,10 +398,5 @@ extension URLSession {
                 NSLocalizedDescriptionKey: "URL must have a host component"
             ])
         }
-
-        let (nativeBytes, response) = try await self.bytes(for: request)
-        return (URLSessionAsyncBytes(nativeBytes: nativeBytes), response)
     }
 }
-
-#endif
@@ -0,0 +1,153 @@
+// WAVWindowReader.swift
+// Conduit
+//
+// Reads time windows of a WAV file as standalone WAV files, without loading the whole recording.
+
+import Foundation
+
+// MARK: - WAVWindowReader
+
+/// Reads slices of an uncompressed WAV file as self-contained WAV data.
+///
+/// Only the RIFF header is parsed up front. Each call to
+/// ``read(from:to:)`` seeks to the slice's first frame and reads just its
+/// samples, so memory stays proportional to the window length however long
+/// the recording is. The original `fmt ` chunk is copied into every slice,
+/// so PCM, IEEE float and extensible layouts are passed through unchanged.
+internal final class WAVWindowReader {
+
+    /// The recording's length in seconds.
+    let duration: TimeInterval
+
+    private let handle: FileHandle
+    private let format: Data
+    private let bytesPerSecond: Int
+    private let blockAlign: Int
+    private let dataOffset: UInt64
+    private let dataLength: Int
+
+    /// Opens `url`, or returns `nil` if it is not a RIFF/WAVE file.
+    ///
+    /// - Throws: File system errors, or `AIError.invalidInput` for a WAVE
+    ///   file whose header is damaged.
+    init?(url: URL) throws {
+        let handle = try FileHandle(forReadingFrom: url)
+        var ownsHandle = false
+        defer {
+            if !ownsHandle { try? handle.close() }
+        }
+
+        let header = try handle.read(upToCount: 12) ?? Data()
+        guard header.count == 12,
+              header.prefix(4) == Data("RIFF".utf8),
+              header.suffix(4) == Data("WAVE".utf8) else {
+            return nil
+        }
+
+        let fileLength = try handle.seekToEnd()
+        var offset: UInt64 = 12
+        var format: Data?
+        var data: (offset: UInt64, length: Int)?
+
+        // Walk the chunk list until both `fmt ` and `data` are found
+        while offset + 8 <= fileLength, format == nil || data == nil {
+            try handle.seek(toOffset: offset)
+            guard let chunkHeader = try handle.read(upToCount: 8), chunkHeader.count == 8 else { break }
+            let id = String(decoding: chunkHeader.prefix(4), as: UTF8.self)
+            let declared = UInt64(Self.uint32(chunkHeader, at: 4))
+            let body = offset + 8
+
+            switch id {
+            case "fmt ":
+                guard declared >= 16, let bytes = try handle.read(upToCount: Int(declared)),
+                      bytes.count == Int(declared) else {
+                    throw AIError.invalidInput("WAV file \(url.lastPathComponent) has a truncated format chunk")
+                }
+                format = bytes
+            case "data":
+                // Streaming writers leave the size at 0 or 0xFFFFFFFF
+                let available = fileLength - body
+                let length = declared == 0 || declared == 0xFFFF_FFFF ? available : min(declared, available)
+                data = (body, Int(length))
+            default:
+                break
+            }
+            offset = body + declared + (declared & 1)
+        }
+
+        guard let format, let data else {
+            throw AIError.invalidInput("WAV file \(url.lastPathComponent) has no format or data chunk")
+        }
+        let blockAlign = Int(Self.uint16(format, at: 12))
+        let bytesPerSecond = Int(Self.uint32(format, at: 8))
+        guard blockAlign > 0, bytesPerSecond > 0 else {
+            throw AIError.invalidInput("WAV file \(url.lastPathComponent) declares no sample size")
+        }
+
+        self.handle = handle
+        self.format = format
+        self.blockAlign = blockAlign
+        self.bytesPerSecond = bytesPerSecond
+        self.dataOffset = data.offset
+        self.dataLength = data.length - data.length % blockAlign
+        self.duration = TimeInterval(self.dataLength) / TimeInterval(bytesPerSecond)
+        ownsHandle = true
+    }
+
+    deinit {
+        try? handle.close()
+    }
+
+    // MARK: - Reading
+
+    /// Returns the audio between `start` and `end` seconds as a WAV file.
+    ///
+    /// Bounds are rounded down to whole frames and clamped to the recording.
+    func read(from start: TimeInterval, to end: TimeInterval) throws -> Data {
+        let first = frameOffset(at: start)
+        let last = max(first, frameOffset(at: end))
+
+        try handle.seek(toOffset: dataOffset + UInt64(first))
+        let samples = try handle.read(upToCount: last - first) ?? Data()
+
+        // Chunks are padded to an even length
+        let formatLength = format.count + format.count % 2
+        var wav = Data()
+        wav.reserveCapacity(20 + formatLength + 8 + samples.count)
+        wav.append(contentsOf: Array("RIFF".utf8))
+        Self.append(UInt32(4 + 8 + formatLength + 8 + samples.count), to: &wav)
+        wav.append(contentsOf: Array("WAVEfmt ".utf8))
+        Self.append(UInt32(format.count), to: &wav)
+        wav.append(format)
+        if formatLength > format.count {
+            wav.append(0)
+        }
+        wav.append(contentsOf: Array("data".utf8))
+        Self.append(UInt32(samples.count), to: &wav)
+        wav.append(samples)
+        return wav
+    }
+
+    /// Byte offset into the data chunk of the frame at `time`.
+    private func frameOffset(at time: TimeInterval) -> Int {
+        guard time < duration else { return dataLength }
+        let bytes = Int((max(0, time) * TimeInterval(bytesPerSecond)).rounded(.down))
+        return min(dataLength, bytes - bytes % blockAlign)
+    }
+
+    // MARK: - Little-Endian Fields
+
+    private static func uint16(_ data: Data, at offset: Int) -> UInt16 {
+        let start = data.startIndex + offset
+        return UInt16(data[start]) | UInt16(data[start + 1]) << 8
+    }
+
+    private static func uint32(_ data: Data, at offset: Int) -> UInt32 {
+        let start = data.startIndex + offset
+        return (0..<4).reduce(UInt32(0)) { $0 | UInt32(data[start + $1]) << (8 * $1) }
+    }
+
+    private static func append(_ value: UInt32, to data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+}
@@ -6,11 +6,13 @@
 #if CONDUIT_TRAIT_MLX && canImport(MLX) && canImport(Hub)
 
 import Foundation
-import Hub
-import CryptoKit
 
 /// Downloads diffusion models from HuggingFace Hub.
 ///
+/// Files are fetched with a ``RangedDownloader``: large weights download
+/// over several connections, interrupted downloads resume from their
+/// partial files, and checksums are computed while the bytes arrive.
+///
 /// ## Usage
 ///
 /// ```swift
@@ -28,9 +30,7 @@ public actor DiffusionModelDownloader {
 
     // MARK: - Properties
 
-#if canImport(Hub)
-    private let hubApi: HubApi
-#endif
+    private let snapshots: HFSnapshotDownloader
     private let token: String?
     private var activeDownloads: [String: Task<URL, Error>] = [:]
     private let registry = DiffusionModelRegistry.shared
@@ -39,16 +39,14 @@ public actor DiffusionModelDownloader {
 
     /// Creates a new downloader.
     ///
-    /// - Parameter token: Optional HuggingFace token for authenticated downloads.
-    public init(token: String? = nil) {
+    /// - Parameters:
+    ///   - token: Optional HuggingFace token for authenticated downloads.
+    ///     Defaults to `HF_TOKEN` from the environment.
+    ///   - downloader: The engine that fetches files, carrying the
+    ///     connection and bandwidth limits. Default: ``RangedDownloader/shared``
+    public init(token: String? = nil, downloader: RangedDownloader = .shared) {
         self.token = token
-        #if canImport(Hub)
-        if let token {
-            self.hubApi = HubApi(hfToken: token)
-        } else {
-            self.hubApi = HubApi()
-        }
-        #endif
+        self.snapshots = HFSnapshotDownloader(downloader: downloader, token: token ?? HFTokenProvider.auto.token)
     }
 
     // MARK: - Download
@@ -94,14 +92,12 @@ public actor DiffusionModelDownloader {
                 // Check for cancellation before starting
                 try Task.checkCancellation()
 
-                let localURL: URL
-                localURL = try await hubApi.snapshot(
-                    from: Hub.Repo(id: modelId),
+                let snapshot = try await snapshots.download(
+                    repoId: modelId,
                     matching: ["*.safetensors", "*.json", "tokenizer*", "*.txt", "*.model"],
-                    progressHandler: { progress in
-                        progressHandler?(progress)
-                    }
+                    progressHandler: progressHandler
                 )
+                let localURL = snapshot.directory
 
                 // Check for cancellation after download
                 try Task.checkCancellation()
@@ -111,7 +107,7 @@ public actor DiffusionModelDownloader {
                 // for production use to prevent loading corrupted or malicious models.
                 // A compromised model could execute arbitrary code or produce incorrect results.
                 if let expectedChecksum = expectedChecksum {
-                    try await self.verifyChecksum(at: localURL, expected: expectedChecksum)
+                    try self.verifyChecksum(of: snapshot, expected: expectedChecksum)
                 } else {
                     // Log warning when checksum is skipped
                     #if DEBUG
@@ -313,77 +309,32 @@ public actor DiffusionModelDownloader {
 
     // MARK: - Checksum Verification
 
-    /// Verifies the SHA256 checksum of downloaded files.
+    /// Verifies the SHA256 checksum of the primary model file.
+    ///
+    /// The digest of each file is computed while it downloads, so the
+    /// weights are not read back from disk.
     ///
     /// - Parameters:
-    ///   - directoryURL: The directory containing downloaded files.
+    ///   - snapshot: The downloaded snapshot.
     ///   - expected: The expected SHA256 checksum (hex string).
     /// - Throws: `AIError.checksumMismatch` if verification fails.
-    private nonisolated func verifyChecksum(at directoryURL: URL, expected: String) async throws {
-        let fileManager = FileManager.default
-
+    private nonisolated func verifyChecksum(of snapshot: HFSnapshotDownloader.Snapshot, expected: String) throws {
         // Find the primary model file (largest .safetensors file)
-        guard let enumerator = fileManager.enumerator(
-            at: directoryURL,
-            includingPropertiesForKeys: [.fileSizeKey],
-            options: [.skipsHiddenFiles]
-        ) else {
-            throw AIError.downloadFailed(
-                underlying: SendableError(NSError(
-                    domain: "DiffusionModelDownloader",
-                    code: -1,
-                    userInfo: [NSLocalizedDescriptionKey: "Cannot enumerate downloaded files"]
-                ))
-            )
-        }
-
-        var primaryFile: URL?
-        var maxSize: Int64 = 0
-
-        while let fileURL = enumerator.nextObject() as? URL {
-            guard fileURL.pathExtension == "safetensors" else { continue }
-            let resourceValues = try fileURL.resourceValues(forKeys: [.fileSizeKey])
-            let size = Int64(resourceValues.fileSize ?? 0)
-            if size > maxSize {
-                maxSize = size
-                primaryFile = fileURL
-            }
-        }
+        let primaryFile = snapshot.files
+            .filter { $0.key.hasSuffix(".safetensors") }
+            .max { $0.value.size < $1.value.size }
 
         guard let fileToVerify = primaryFile else {
             // No safetensors file found, skip verification
             return
         }
 
-        // Calculate SHA256 checksum
-        let actualChecksum = try await calculateSHA256(of: fileToVerify)
-
         // Compare checksums (case-insensitive)
+        let actualChecksum = fileToVerify.value.sha256
         if actualChecksum.lowercased() != expected.lowercased() {
             throw AIError.checksumMismatch(expected: expected, actual: actualChecksum)
         }
     }
-
-    /// Calculates the SHA256 checksum of a file.
-    ///
-    /// - Parameter fileURL: The file URL.
-    /// - Returns: The SHA256 checksum as a hex string.
-    private nonisolated func calculateSHA256(of fileURL: URL) async throws -> String {
-        let handle = try FileHandle(forReadingFrom: fileURL)
-        defer { try? handle.close() }
-
-        var hasher = SHA256()
-        let bufferSize = 1024 * 1024 // 1MB chunks
-
-        while true {
-            let data = try handle.read(upToCount: bufferSize)
-            guard let data = data, !data.isEmpty else { break }
-            hasher.update(data: data)
-        }
-
-        let digest = hasher.finalize()
-        return digest.map { String(format: "%02x", $0) }.joined()
-    }
 }
 
 // MARK: - Convenience Extensions
@@ -52,6 +52,12 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
     /// Optional. Sets context and instructions for the assistant.
     let system: String?
 
+    /// Cache breakpoint for the system prompt.
+    ///
+    /// When set, `system` is encoded as a single text block carrying this
+    /// `cache_control` marker instead of a plain string.
+    var systemCacheControl: CacheControl? = nil
+
     /// Sampling temperature (0.0 to 1.0).
     ///
     /// Optional. Controls randomness in generation.
@@ -129,6 +135,73 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
         case toolChoice = "tool_choice"
     }
 
+    /// Maximum `cache_control` breakpoints the API accepts per request.
+    static let maxCacheBreakpoints = 4
+
+    // MARK: - Encoding
+
+    /// Encodes the request, emitting `system` as a cached text block when
+    /// ``systemCacheControl`` is set.
+    func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(model, forKey: .model)
+        try container.encode(messages, forKey: .messages)
+        try container.encode(maxTokens, forKey: .maxTokens)
+        if let system, let systemCacheControl {
+            let block = MessageContent.ContentPart(
+                type: "text",
+                text: system,
+                source: nil,
+                cacheControl: systemCacheControl
+            )
+            try container.encode([block], forKey: .system)
+        } else {
+            try container.encodeIfPresent(system, forKey: .system)
+        }
+        try container.encodeIfPresent(temperature, forKey: .temperature)
+        try container.encodeIfPresent(topP, forKey: .topP)
+        try container.encodeIfPresent(topK, forKey: .topK)
+        try container.encodeIfPresent(stream, forKey: .stream)
+        try container.encodeIfPresent(thinking, forKey: .thinking)
+        try container.encodeIfPresent(stopSequences, forKey: .stopSequences)
+        try container.encodeIfPresent(metadata, forKey: .metadata)
+        try container.encodeIfPresent(serviceTier, forKey: .serviceTier)
+        try container.encodeIfPresent(tools, forKey: .tools)
+        try container.encodeIfPresent(toolChoice, forKey: .toolChoice)
+    }
+
+    /// Whether any image is sent as a Files API reference, which needs
+    /// ``AnthropicConfiguration/filesBeta``.
+    var usesFileSources: Bool {
+        messages.contains { message in
+            guard case .multipart(let parts) = message.content else { return false }
+            return parts.contains { $0.source?.type == "file" }
+        }
+    }
+
+    // MARK: - CacheControl
+
+    /// Prompt-cache breakpoint marker.
+    ///
+    /// Everything up to and including the marked block (tools, then system,
+    /// then messages) becomes a cacheable prefix.
+    ///
+    /// ```json
+    /// { "type": "ephemeral", "ttl": "1h" }
+    /// ```
+    struct CacheControl: Codable, Sendable, Hashable {
+        /// Cache type (always `"ephemeral"`).
+        let type: String
+
+        /// Cache lifetime (`"5m"` or `"1h"`); `nil` uses the API default of five minutes.
+        let ttl: String?
+
+        init(type: String = "ephemeral", ttl: String? = nil) {
+            self.type = type
+            self.ttl = ttl
+        }
+    }
+
     // MARK: - ToolDefinitionRequest
 
     /// Tool definition for Anthropic's API format.
@@ -144,10 +217,14 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
         /// JSON schema for the tool's input parameters.
         let inputSchema: InputSchema
 
+        /// Cache breakpoint covering this and all preceding tool definitions.
+        var cacheControl: CacheControl? = nil
+
         enum CodingKeys: String, CodingKey {
             case name
             case description
             case inputSchema = "input_schema"
+            case cacheControl = "cache_control"
         }
 
         /// JSON schema wrapper for input parameters.
@@ -412,6 +489,23 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
             }
         }
 
+        /// Returns this message with a cache breakpoint on its last content part.
+        ///
+        /// Plain text content is promoted to a single text part so it can
+        /// carry the marker.
+        func withCacheControl(_ cacheControl: CacheControl) -> MessageContent {
+            var parts: [ContentPart]
+            switch content {
+            case .text(let text):
+                parts = [ContentPart(type: "text", text: text, source: nil)]
+            case .multipart(let existing):
+                parts = existing
+            }
+            guard !parts.isEmpty else { return self }
+            parts[parts.count - 1].cacheControl = cacheControl
+            return MessageContent(role: role, content: .multipart(parts))
+        }
+
         // MARK: - ContentPart
 
         /// Content part for multimodal messages.
@@ -445,6 +539,9 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
             /// Whether the tool result represents an error (for tool_result parts).
             let isError: Bool?
 
+            /// Cache breakpoint ending a cacheable prefix at this part.
+            var cacheControl: CacheControl?
+
             // MARK: - Coding Keys
 
             enum CodingKeys: String, CodingKey {
@@ -457,6 +554,7 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
                 case toolUseId = "tool_use_id"
                 case content
                 case isError = "is_error"
+                case cacheControl = "cache_control"
             }
 
             init(
@@ -468,7 +566,8 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
                 input: GeneratedContent? = nil,
                 toolUseId: String? = nil,
                 content: String? = nil,
-                isError: Bool? = nil
+                isError: Bool? = nil,
+                cacheControl: CacheControl? = nil
             ) {
                 self.type = type
                 self.text = text
@@ -479,9 +578,10 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
                 self.toolUseId = toolUseId
                 self.content = content
                 self.isError = isError
+                self.cacheControl = cacheControl
             }
 
-            /// Image source with base64 data.
+            /// Image source with base64 data or a Files API reference.
             ///
             /// Anthropic expects images in this format:
             /// ```json
@@ -494,15 +594,27 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
             ///   }
             /// }
             /// ```
+            ///
+            /// Uploaded images use `{"type": "file", "file_id": "file_..."}`.
             struct ImageSource: Codable, Sendable {
-                /// Source type (always "base64").
+                /// Source type ("base64" or "file").
                 let type: String
 
                 /// Media type ("image/jpeg", "image/png", "image/gif", "image/webp").
-                let mediaType: String
+                let mediaType: String?
 
                 /// Base64-encoded image data.
-                let data: String
+                let data: String?
+
+                /// Files API ID (for file sources).
+                let fileId: String?
+
+                init(type: String, mediaType: String?, data: String?, fileId: String? = nil) {
+                    self.type = type
+                    self.mediaType = mediaType
+                    self.data = data
+                    self.fileId = fileId
+                }
 
                 // MARK: - Coding Keys
 
@@ -510,6 +622,7 @@ internal struct AnthropicMessagesRequest: Codable, Sendable {
                     case type
                     case mediaType = "media_type"
                     case data
+                    case fileId = "file_id"
                 }
             }
         }
@@ -669,12 +782,33 @@ internal struct AnthropicMessagesResponse: Codable, Sendable {
         /// Number of tokens in the output (completion).
         let outputTokens: Int
 
+        /// Input tokens written to the prompt cache by this request.
+        var cacheCreationInputTokens: Int? = nil
+
+        /// Input tokens read from the prompt cache by this request.
+        var cacheReadInputTokens: Int? = nil
+
         // MARK: - Coding Keys
 
         /// Maps Swift property names to API's snake_case fields.
         enum CodingKeys: String, CodingKey {
             case inputTokens = "input_tokens"
             case outputTokens = "output_tokens"
+            case cacheCreationInputTokens = "cache_creation_input_tokens"
+            case cacheReadInputTokens = "cache_read_input_tokens"
+        }
+
+        /// Conduit usage statistics.
+        ///
+        /// Anthropic's `input_tokens` excludes cached tokens, so the prompt
+        /// total adds cache reads and writes back in.
+        var usageStats: UsageStats {
+            UsageStats(
+                promptTokens: inputTokens + (cacheReadInputTokens ?? 0) + (cacheCreationInputTokens ?? 0),
+                completionTokens: outputTokens,
+                cacheReadTokens: cacheReadInputTokens,
+                cacheCreationTokens: cacheCreationInputTokens
+            )
         }
     }
 }
@@ -836,6 +970,9 @@ internal enum AnthropicStreamEvent: Sendable {
             /// Initial stop sequence (typically `null`).
             let stopSequence: String?
 
+            /// Input and prompt-cache token counts, known once the prompt is processed.
+            var usage: AnthropicMessagesResponse.Usage? = nil
+
             // MARK: - Coding Keys
 
             enum CodingKeys: String, CodingKey {
@@ -846,6 +983,7 @@ internal enum AnthropicStreamEvent: Sendable {
                 case model
                 case stopReason = "stop_reason"
                 case stopSequence = "stop_sequence"
+                case usage
             }
         }
     }
@@ -1031,11 +1169,19 @@ internal enum AnthropicStreamEvent: Sendable {
             /// Number of tokens in the generated output.
             let outputTokens: Int
 
+            /// Input tokens written to the prompt cache, if reported on this event.
+            var cacheCreationInputTokens: Int? = nil
+
+            /// Input tokens read from the prompt cache, if reported on this event.
+            var cacheReadInputTokens: Int? = nil
+
             // MARK: - Coding Keys
 
             enum CodingKeys: String, CodingKey {
                 case inputTokens = "input_tokens"
                 case outputTokens = "output_tokens"
+                case cacheCreationInputTokens = "cache_creation_input_tokens"
+                case cacheReadInputTokens = "cache_read_input_tokens"
             }
         }
     }
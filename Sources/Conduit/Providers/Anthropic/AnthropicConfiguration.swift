@@ -121,6 +121,61 @@ struct AnthropicConfiguration: Sendable, Hashable, Codable {
     /// ```
     var thinkingConfig: ThinkingConfiguration?
 
+    /// Prompt caching with automatic `cache_control` breakpoints.
+    ///
+    /// When set, requests mark stable prefixes (tool definitions, the system
+    /// prompt, and conversation history) as cacheable, so later turns reuse
+    /// them instead of paying full prefill and input cost.
+    ///
+    /// Set to `nil` to disable prompt caching (default).
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = AnthropicConfiguration.standard(apiKey: "sk-ant-...")
+    ///     .promptCaching(.automatic)
+    /// ```
+    var promptCaching: AnthropicPromptCaching?
+
+    // MARK: - Transport
+
+    /// HTTP transport shared with other providers.
+    ///
+    /// `nil` gives the provider its own connection pool with ``timeout``
+    /// applied. Not encoded.
+    ///
+    /// Default: `nil`
+    var transport: ConduitTransport?
+
+    /// Scheduler that paces requests from rate-limit headers.
+    ///
+    /// Requests are keyed by model. `nil` disables pacing. Not encoded.
+    ///
+    /// Default: `nil`
+    var rateLimiter: RateLimitScheduler?
+
+    /// Cache of prepared image payloads and Files API references.
+    ///
+    /// Images are downscaled and encoded once, and images registered with
+    /// a file ID are sent by reference. `nil` sends images as supplied.
+    /// Not encoded.
+    ///
+    /// Default: `nil`
+    var mediaCache: MediaCache?
+
+    private enum CodingKeys: String, CodingKey {
+        case authentication
+        case baseURL
+        case apiVersion
+        case timeout
+        case maxRetries
+        case supportsStreaming
+        case supportsVision
+        case supportsExtendedThinking
+        case thinkingConfig
+        case promptCaching
+        // transport, rateLimiter and mediaCache are live objects and are not encoded
+    }
+
     // MARK: - Initialization
 
     /// Creates an Anthropic configuration with the specified settings.
@@ -208,12 +263,18 @@ struct AnthropicConfiguration: Sendable, Hashable, Codable {
 
     // MARK: - Request Building
 
+    /// Beta flag that enables `file` image sources, sent with requests
+    /// that reference an uploaded image.
+    static let filesBeta = "files-api-2025-04-14"
+
     /// Builds HTTP headers for a request.
     ///
     /// Combines authentication, API version, and content type headers.
     ///
+    /// - Parameter request: The request being sent, used to decide which
+    ///   beta flags it needs.
     /// - Returns: Dictionary of header names to values.
-    func buildHeaders() -> [String: String] {
+    func buildHeaders(for request: AnthropicMessagesRequest? = nil) -> [String: String] {
         var headers: [String: String] = [
             "Content-Type": "application/json",
             "anthropic-version": apiVersion
@@ -224,6 +285,18 @@ struct AnthropicConfiguration: Sendable, Hashable, Codable {
             headers["X-Api-Key"] = apiKey
         }
 
+        // One-hour cache entries and file sources are gated behind beta flags
+        var betas: [String] = []
+        if promptCaching?.ttl == .oneHour {
+            betas.append(AnthropicPromptCaching.extendedTTLBeta)
+        }
+        if request?.usesFileSources == true {
+            betas.append(Self.filesBeta)
+        }
+        if !betas.isEmpty {
+            headers["anthropic-beta"] = betas.joined(separator: ",")
+        }
+
         return headers
     }
 
@@ -360,6 +433,155 @@ extension AnthropicConfiguration {
         copy.thinkingConfig = config
         return copy
     }
+
+    /// Returns a copy with the specified prompt caching configuration.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// // Cache tools, system prompt and history for five minutes
+    /// let config = AnthropicConfiguration.standard(apiKey: "sk-ant-...")
+    ///     .promptCaching(.automatic)
+    ///
+    /// // Cache only instructions, kept for an hour
+    /// let config = AnthropicConfiguration.standard(apiKey: "sk-ant-...")
+    ///     .promptCaching(AnthropicPromptCaching(cacheConversation: false, ttl: .oneHour))
+    /// ```
+    ///
+    /// - Parameter caching: The caching configuration, or `nil` to disable.
+    /// - Returns: A new configuration with updated caching settings.
+    func promptCaching(_ caching: AnthropicPromptCaching?) -> AnthropicConfiguration {
+        var copy = self
+        copy.promptCaching = caching
+        return copy
+    }
+
+    /// Returns a copy that sends requests through `transport`.
+    ///
+    /// - Parameter transport: The shared transport, or `nil` for a private one.
+    /// - Returns: A new configuration with the updated transport.
+    func transport(_ transport: ConduitTransport?) -> AnthropicConfiguration {
+        var copy = self
+        copy.transport = transport
+        return copy
+    }
+
+    /// Returns a copy that paces requests through `scheduler`.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let limiter = RateLimitScheduler()
+    /// let config = AnthropicConfiguration.standard(apiKey: "sk-ant-...")
+    ///     .rateLimiter(limiter)
+    /// ```
+    ///
+    /// - Parameter scheduler: The rate-limit scheduler, or `nil` to disable pacing.
+    /// - Returns: A new configuration with the updated scheduler.
+    func rateLimiter(_ scheduler: RateLimitScheduler?) -> AnthropicConfiguration {
+        var copy = self
+        copy.rateLimiter = scheduler
+        return copy
+    }
+
+    /// Returns a copy that prepares images through `cache`.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let media = MediaCache(configuration: .init(maxPixelDimension: 1568))
+    /// let config = AnthropicConfiguration.standard(apiKey: "sk-ant-...")
+    ///     .mediaCache(media)
+    /// ```
+    ///
+    /// - Parameter cache: The media cache, or `nil` to send images as supplied.
+    /// - Returns: A new configuration with the updated cache.
+    func mediaCache(_ cache: MediaCache?) -> AnthropicConfiguration {
+        var copy = self
+        copy.mediaCache = cache
+        return copy
+    }
+}
+
+// MARK: - AnthropicPromptCaching
+
+/// Configuration for Anthropic prompt caching.
+///
+/// The provider places up to four `cache_control` breakpoints per request,
+/// following the API's prefix order of tools, system, then messages:
+///
+/// 1. the last tool definition, covering every tool,
+/// 2. the system prompt,
+/// 3. the final message, so the next turn can read the whole conversation,
+/// 4. the last assistant message before it, so earlier history stays
+///    readable when the newest turn adds many blocks (such as tool results).
+///
+/// Breakpoints are assigned in this order, so when tools and the system
+/// prompt are cached, the final message always keeps its breakpoint.
+///
+/// Prefixes shorter than the model's minimum cacheable length (1024 tokens
+/// for most models) are processed normally. Cache hits show up as
+/// ``UsageStats/cacheReadTokens``.
+///
+/// ## Protocol Conformances
+/// - `Sendable`: Thread-safe across concurrency boundaries
+/// - `Hashable`: Can be used in sets and as dictionary keys
+/// - `Codable`: Full JSON encoding/decoding support
+struct AnthropicPromptCaching: Sendable, Hashable, Codable {
+
+    /// Lifetime of cache entries written by a request.
+    enum TTL: String, Sendable, Hashable, Codable {
+        /// Five minutes, refreshed on every hit (API default).
+        case fiveMinutes = "5m"
+
+        /// One hour; writes cost more than five-minute entries.
+        case oneHour = "1h"
+    }
+
+    /// Beta flag sent with requests that use ``TTL/oneHour``.
+    static let extendedTTLBeta = "extended-cache-ttl-2025-04-11"
+
+    // MARK: - Properties
+
+    /// Whether to cache the tool definitions.
+    var cacheTools: Bool
+
+    /// Whether to cache the system prompt.
+    var cacheSystemPrompt: Bool
+
+    /// Whether to cache earlier conversation turns.
+    var cacheConversation: Bool
+
+    /// Lifetime of written cache entries.
+    var ttl: TTL
+
+    // MARK: - Static Factories
+
+    /// Caches tools, system prompt and conversation with the default TTL.
+    static let automatic = AnthropicPromptCaching()
+
+    // MARK: - Initialization
+
+    /// Creates a prompt caching configuration.
+    ///
+    /// - Parameters:
+    ///   - cacheTools: Cache tool definitions. Default: `true`
+    ///   - cacheSystemPrompt: Cache the system prompt. Default: `true`
+    ///   - cacheConversation: Cache conversation history. Default: `true`
+    ///   - ttl: Cache entry lifetime. Default: `.fiveMinutes`
+    init(
+        cacheTools: Bool = true,
+        cacheSystemPrompt: Bool = true,
+        cacheConversation: Bool = true,
+        ttl: TTL = .fiveMinutes
+    ) {
+        self.cacheTools = cacheTools
+        self.cacheSystemPrompt = cacheSystemPrompt
+        self.cacheConversation = cacheConversation
+        self.ttl = ttl
+    }
+
+    /// The marker attached to each breakpoint.
+    var cacheControl: AnthropicMessagesRequest.CacheControl {
+        AnthropicMessagesRequest.CacheControl(ttl: ttl == .oneHour ? ttl.rawValue : nil)
+    }
 }
 
 // MARK: - ThinkingConfiguration
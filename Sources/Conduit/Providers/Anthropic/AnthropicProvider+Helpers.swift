@@ -152,15 +152,10 @@ extension AnthropicProvider {
 
                         case .image(let imageContent):
                             // Image part
-                            let source = AnthropicMessagesRequest.MessageContent.ContentPart.ImageSource(
-                                type: "base64",
-                                mediaType: imageContent.mimeType,
-                                data: imageContent.base64Data
-                            )
                             apiParts.append(AnthropicMessagesRequest.MessageContent.ContentPart(
                                 type: "image",
                                 text: nil,
-                                source: source
+                                source: imageSource(for: imageContent)
                             ))
 
                         case .audio:
@@ -252,11 +247,18 @@ extension AnthropicProvider {
             outboundTopP = nil
         }
 
+        let cached = applyPromptCaching(
+            tools: toolDefinitions,
+            systemPrompt: effectiveSystemPrompt,
+            messages: apiMessages
+        )
+
         return AnthropicMessagesRequest(
             model: model.rawValue,
-            messages: apiMessages,
+            messages: cached.messages,
             maxTokens: config.maxTokens ?? 1024,
             system: effectiveSystemPrompt,
+            systemCacheControl: cached.systemCacheControl,
             temperature: outboundTemperature,
             topP: outboundTopP,
             topK: config.topK,
@@ -265,11 +267,67 @@ extension AnthropicProvider {
             stopSequences: config.stopSequences.isEmpty ? nil : config.stopSequences,
             metadata: metadata,
             serviceTier: config.serviceTier?.rawValue,
-            tools: toolDefinitions,
+            tools: cached.tools,
             toolChoice: toolChoiceRequest
         )
     }
 
+    /// Places `cache_control` breakpoints for the configured prompt caching mode.
+    ///
+    /// Breakpoints follow the API's prefix order (tools, system, messages) and
+    /// never exceed ``AnthropicMessagesRequest/maxCacheBreakpoints``:
+    ///
+    /// 1. The last tool definition, caching every tool.
+    /// 2. The system prompt.
+    /// 3. The final message, so the next turn can read the whole conversation.
+    /// 4. The last assistant message before it, so earlier history stays
+    ///    readable when the newest turn adds many blocks (such as tool results).
+    ///
+    /// Returns the inputs unchanged when prompt caching is disabled.
+    private func applyPromptCaching(
+        tools: [AnthropicMessagesRequest.ToolDefinitionRequest]?,
+        systemPrompt: String?,
+        messages: [AnthropicMessagesRequest.MessageContent]
+    ) -> (
+        tools: [AnthropicMessagesRequest.ToolDefinitionRequest]?,
+        systemCacheControl: AnthropicMessagesRequest.CacheControl?,
+        messages: [AnthropicMessagesRequest.MessageContent]
+    ) {
+        guard let caching = configuration.promptCaching else {
+            return (tools, nil, messages)
+        }
+
+        let marker = caching.cacheControl
+        var remaining = AnthropicMessagesRequest.maxCacheBreakpoints
+
+        var cachedTools = tools
+        if caching.cacheTools, var definitions = cachedTools, !definitions.isEmpty {
+            definitions[definitions.count - 1].cacheControl = marker
+            cachedTools = definitions
+            remaining -= 1
+        }
+
+        var systemCacheControl: AnthropicMessagesRequest.CacheControl?
+        if caching.cacheSystemPrompt, let systemPrompt, !systemPrompt.isEmpty {
+            systemCacheControl = marker
+            remaining -= 1
+        }
+
+        var cachedMessages = messages
+        if caching.cacheConversation, !cachedMessages.isEmpty {
+            let lastIndex = cachedMessages.count - 1
+            var indices = [lastIndex]
+            if let historyIndex = cachedMessages[..<lastIndex].lastIndex(where: { $0.role == "assistant" }) {
+                indices.append(historyIndex)
+            }
+            for index in indices.prefix(max(0, remaining)) {
+                cachedMessages[index] = cachedMessages[index].withCacheControl(marker)
+            }
+        }
+
+        return (cachedTools, systemCacheControl, cachedMessages)
+    }
+
     /// Validates that the requested model belongs to Anthropic.
     private nonisolated func validateModel(_ model: ModelIdentifier) throws {
         guard model.provider == .anthropic else {
@@ -329,6 +387,24 @@ extension AnthropicProvider {
         }
     }
 
+    /// The request source for an image.
+    ///
+    /// With a ``AnthropicConfiguration/mediaCache`` the image is sent as its
+    /// registered Files API ID when there is one, and otherwise as the
+    /// cached, possibly downscaled, payload.
+    private func imageSource(
+        for image: Message.ImageContent
+    ) -> AnthropicMessagesRequest.MessageContent.ContentPart.ImageSource {
+        guard let cache = configuration.mediaCache else {
+            return .init(type: "base64", mediaType: image.mimeType, data: image.base64Data)
+        }
+        let prepared = cache.prepared(image)
+        if let fileID = cache.fileReference(for: prepared.key, service: .anthropic) {
+            return .init(type: "file", mediaType: nil, data: nil, fileId: fileID)
+        }
+        return .init(type: "base64", mediaType: prepared.mimeType, data: prepared.base64Data)
+    }
+
     /// Converts Conduit tool configuration to Anthropic's API format.
     ///
     /// - Parameter config: The generation configuration with tools.
@@ -556,7 +632,7 @@ extension AnthropicProvider {
     ///
     /// 1. **URL Construction**: Appends `/v1/messages` to the base URL
     /// 2. **Headers**: Adds authentication, API version, and content type via
-    ///    `configuration.buildHeaders()`
+    ///    `configuration.buildHeaders(for:)`
     /// 3. **Body Encoding**: JSON-encodes the request body
     /// 4. **Execution**: Performs async HTTP request with retry logic
     /// 5. **Validation**: Checks HTTP status code
@@ -590,7 +666,10 @@ extension AnthropicProvider {
     /// print("Remaining requests: \(rateLimitInfo?.remainingRequests ?? 0)")
     /// ```
     ///
-    /// - Parameter request: The Anthropic API request to execute.
+    /// - Parameters:
+    ///   - request: The Anthropic API request to execute.
+    ///   - estimatedTokens: Tokens reserved with the configured
+    ///     ``AnthropicConfiguration/rateLimiter`` for each attempt.
     ///
     /// - Returns: A tuple containing the decoded `AnthropicMessagesResponse` and
     ///   optional `RateLimitInfo` extracted from response headers.
@@ -602,7 +681,8 @@ extension AnthropicProvider {
     ///   - `.serverError`: Anthropic API error after all retries (HTTP 4xx/5xx)
     ///   - `.generationFailed`: Encoding/decoding failures or all retries exhausted
     internal func executeRequest(
-        _ request: AnthropicMessagesRequest
+        _ request: AnthropicMessagesRequest,
+        estimatedTokens: Int = 0
     ) async throws -> (AnthropicMessagesResponse, RateLimitInfo?) {
         // Encode request body once (reused across retries)
         let requestBody: Data
@@ -620,16 +700,23 @@ extension AnthropicProvider {
                 let url = configuration.baseURL.appending(path: "v1/messages")
                 var urlRequest = URLRequest(url: url)
                 urlRequest.httpMethod = "POST"
+                urlRequest.timeoutInterval = configuration.timeout
 
                 // Add headers (authentication, API version, content-type)
-                for (name, value) in configuration.buildHeaders() {
+                for (name, value) in configuration.buildHeaders(for: request) {
                     urlRequest.setValue(value, forHTTPHeaderField: name)
                 }
 
                 urlRequest.httpBody = requestBody
 
-                // Execute request
-                let (data, response) = try await session.data(for: urlRequest)
+                // Execute request, paced by the model's rate limits
+                let (data, response) = try await RateLimitScheduler.send(
+                    through: configuration.rateLimiter,
+                    key: request.model,
+                    estimatedTokens: estimatedTokens
+                ) {
+                    try await transport.data(for: urlRequest)
+                }
 
                 // Validate HTTP response
                 guard let httpResponse = response as? HTTPURLResponse else {
@@ -637,12 +724,7 @@ extension AnthropicProvider {
                 }
 
                 // Extract rate limit info from headers
-                let headers = httpResponse.allHeaderFields.reduce(into: [String: String]()) { result, pair in
-                    if let key = pair.key as? String, let value = pair.value as? String {
-                        result[key] = value
-                    }
-                }
-                let rateLimitInfo = RateLimitInfo(headers: headers)
+                let rateLimitInfo = RateLimitInfo(response: httpResponse)
 
                 // Success case
                 if (200...299).contains(httpResponse.statusCode) {
@@ -862,8 +944,10 @@ extension AnthropicProvider {
     /// ## Usage Statistics
     ///
     /// Maps Anthropic's usage fields to Conduit's `UsageStats`:
-    /// - `usage.inputTokens` → `promptTokens`
+    /// - `usage.inputTokens` + cached input tokens → `promptTokens`
     /// - `usage.outputTokens` → `completionTokens`
+    /// - `usage.cacheReadInputTokens` → `cacheReadTokens`
+    /// - `usage.cacheCreationInputTokens` → `cacheCreationTokens`
     ///
     /// ## Rate Limit Information
     ///
@@ -971,10 +1055,7 @@ extension AnthropicProvider {
             tokensPerSecond: tokensPerSecond,
             finishReason: mapStopReason(response.stopReason),
             logprobs: nil,  // Anthropic doesn't provide logprobs
-            usage: UsageStats(
-                promptTokens: response.usage.inputTokens,
-                completionTokens: response.usage.outputTokens
-            ),
+            usage: response.usage.usageStats,
             rateLimitInfo: rateLimitInfo,
             toolCalls: toolCalls
         )
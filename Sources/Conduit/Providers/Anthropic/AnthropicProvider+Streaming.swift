@@ -296,9 +296,10 @@ extension AnthropicProvider {
         let url = configuration.baseURL.appending(path: "v1/messages")
         var urlRequest = URLRequest(url: url)
         urlRequest.httpMethod = "POST"
+        urlRequest.timeoutInterval = configuration.timeout
 
         // Add headers (authentication, API version, content-type)
-        for (name, value) in configuration.buildHeaders() {
+        for (name, value) in configuration.buildHeaders(for: request) {
             urlRequest.setValue(value, forHTTPHeaderField: name)
         }
 
@@ -309,11 +310,22 @@ extension AnthropicProvider {
             throw AIError.generationFailed(underlying: SendableError(error))
         }
 
-        // Execute streaming request (cross-platform)
+        var telemetry = TelemetryStream(source: "anthropic")
+        defer { telemetry?.finish() }
+
+        // Execute streaming request (cross-platform), paced by the model's rate limits
         let bytes: URLSessionAsyncBytes
         let response: URLResponse
         do {
-            (bytes, response) = try await session.asyncBytes(for: urlRequest)
+            (bytes, response) = try await RateLimitScheduler.send(
+                through: configuration.rateLimiter,
+                key: request.model,
+                estimatedTokens: RateLimitScheduler.estimatedTokens(for: messages, maxTokens: request.maxTokens)
+            ) {
+                try await transport.asyncBytes(for: urlRequest)
+            }
+        } catch is CancellationError {
+            throw AIError.cancelled
         } catch let urlError as URLError {
             throw AIError.networkError(urlError)
         } catch {
@@ -327,13 +339,8 @@ extension AnthropicProvider {
 
         guard (200...299).contains(httpResponse.statusCode) else {
             // Issue 12.9: Collect and decode error body for better diagnostics
-            var errorData = Data()
-            errorData.reserveCapacity(10_000)  // Pre-allocate for expected error size
-            for try await byte in bytes {
-                try Task.checkCancellation()
-                errorData.append(byte)
-                if errorData.count > 10_000 { break } // Limit collection
-            }
+            try Task.checkCancellation()
+            let (errorData, _) = try await bytes.chunks.collect(upTo: 10_000)
 
             // Try to decode structured error response
             if let errorResponse = try? decoder.decode(AnthropicErrorResponse.self, from: errorData) {
@@ -352,48 +359,45 @@ extension AnthropicProvider {
         let startTime = Date()
 
         // Tool call accumulation state
-        // Maps content block index to (id, name, jsonBuffer)
-        var activeToolCalls: [Int: (id: String, name: String, jsonBuffer: String)] = [:]
+        // Maps content block index to its incrementally parsed tool call
+        var activeToolCalls: [Int: StreamingToolCallAccumulator] = [:]
         var completedToolCalls: [Transcript.ToolCall] = []
 
-        var sseParser = ServerSentEventParser()
+        // Input usage from message_start, including prompt cache reads/writes
+        var messageStartUsage: AnthropicMessagesResponse.Usage?
 
-        sse: for try await line in bytes.lines {
+        sse: for try await event in bytes.chunks.serverSentEvents {
             // Check for task cancellation at the start of each iteration
             try Task.checkCancellation()
 
-            for event in sseParser.ingestLine(line) {
-                let jsonString = event.data
-
-                // Skip [DONE] marker
-                if jsonString == "[DONE]" { break sse }
-
-                guard let eventData = jsonString.data(using: .utf8) else { continue }
-
-                // Issue 12.11: Parse event with error logging for diagnostics
-                do {
-                    if let event = try parseStreamEvent(from: eventData) {
-                        if let chunk = try processStreamEvent(
-                            event,
-                            startTime: startTime,
-                            totalTokens: &totalTokens,
-                            activeToolCalls: &activeToolCalls,
-                            completedToolCalls: &completedToolCalls
-                        ) {
-                            continuation.yield(chunk)
-                        }
+            // Skip [DONE] marker
+            if event.isDoneMarker { break sse }
+
+            // Issue 12.11: Parse event with error logging for diagnostics
+            do {
+                if let streamEvent = try parseStreamEvent(from: event.data) {
+                    if let chunk = try processStreamEvent(
+                        streamEvent,
+                        startTime: startTime,
+                        totalTokens: &totalTokens,
+                        activeToolCalls: &activeToolCalls,
+                        completedToolCalls: &completedToolCalls,
+                        messageStartUsage: &messageStartUsage
+                    ) {
+                        telemetry?.chunkReceived()
+                        continuation.yield(chunk)
                     }
-                } catch let error as AIError {
-                    // Stream error events throw AIError - propagate to consumer
-                    throw error
-                } catch {
-                    // Issue 12.11: Log parsing errors for diagnostics
-                    logger.debug(
-                        "Failed to parse stream event",
-                        metadata: ["error": .string("\(error)")]
-                    )
-                    // Continue processing - don't fail the stream for single event parse errors
                 }
+            } catch let error as AIError {
+                // Stream error events throw AIError - propagate to consumer
+                throw error
+            } catch {
+                // Issue 12.11: Log parsing errors for diagnostics
+                logger.debug(
+                    "Failed to parse stream event",
+                    metadata: ["error": .string("\(error)")]
+                )
+                // Continue processing - don't fail the stream for single event parse errors
             }
         }
 
@@ -491,9 +495,10 @@ extension AnthropicProvider {
     ///
     /// ## Event Processing
     ///
-    /// - `messageStart`: Metadata only, returns `nil`
+    /// - `messageStart`: Records input and prompt cache usage, returns `nil`
     /// - `contentBlockStart`: Initializes tool call state for tool_use blocks, returns `nil`
     /// - `contentBlockDelta`: **Contains text or tool JSON**, returns `GenerationChunk` for text
+    ///   and a `partialToolCall` update for tool JSON
     /// - `contentBlockStop`: Finalizes tool calls, returns `nil`
     /// - `messageDelta`: **Contains usage stats**, returns final `GenerationChunk` with tool calls
     /// - `messageStop`: Metadata only, returns `nil`
@@ -504,7 +509,8 @@ extension AnthropicProvider {
     ///
     /// Tool calls are accumulated during streaming:
     /// 1. `contentBlockStart` with type="tool_use" initializes a new tool call
-    /// 2. `contentBlockDelta` with type="input_json_delta" accumulates JSON fragments
+    /// 2. `contentBlockDelta` with type="input_json_delta" parses JSON fragments incrementally
+    ///    and yields a `PartialToolCall` with the arguments received so far
     /// 3. `contentBlockStop` finalizes the tool call and adds it to completedToolCalls
     /// 4. `messageDelta` returns the final chunk with all completed tool calls
     ///
@@ -522,7 +528,8 @@ extension AnthropicProvider {
     ///     startTime: startTime,
     ///     totalTokens: &totalTokens,
     ///     activeToolCalls: &activeToolCalls,
-    ///     completedToolCalls: &completedToolCalls
+    ///     completedToolCalls: &completedToolCalls,
+    ///     messageStartUsage: &messageStartUsage
     /// ) {
     ///     continuation.yield(chunk)
     /// }
@@ -534,18 +541,26 @@ extension AnthropicProvider {
     ///   - totalTokens: Running total of tokens (incremented for text deltas).
     ///   - activeToolCalls: Currently accumulating tool calls (by content block index).
     ///   - completedToolCalls: Finalized tool calls ready to be returned.
+    ///   - messageStartUsage: Usage reported by `message_start`, used to fill in
+    ///     prompt cache counts that `message_delta` omits.
     ///
-    /// - Returns: A `GenerationChunk` if this event contains text or completes generation, `nil` otherwise.
+    /// - Returns: A `GenerationChunk` if this event contains text, tool-call progress, or completes
+    ///   generation, `nil` otherwise.
     ///
     /// - Throws: `AIError.serverError` if an error event is received.
     internal func processStreamEvent(
         _ event: AnthropicStreamEvent,
         startTime: Date,
         totalTokens: inout Int,
-        activeToolCalls: inout [Int: (id: String, name: String, jsonBuffer: String)],
-        completedToolCalls: inout [Transcript.ToolCall]
+        activeToolCalls: inout [Int: StreamingToolCallAccumulator],
+        completedToolCalls: inout [Transcript.ToolCall],
+        messageStartUsage: inout AnthropicMessagesResponse.Usage?
     ) throws -> GenerationChunk? {
         switch event {
+        case .messageStart(let start):
+            messageStartUsage = start.message.usage
+            return nil
+
         case .contentBlockStart(let start):
             // Initialize tool call state for tool_use blocks
             if start.contentBlock.type == "tool_use",
@@ -558,7 +573,12 @@ extension AnthropicProvider {
                     )
                     return nil
                 }
-                activeToolCalls[start.index] = (id: id, name: name, jsonBuffer: "")
+                activeToolCalls[start.index] = StreamingToolCallAccumulator(
+                    id: id,
+                    name: name,
+                    index: start.index,
+                    maximumArgumentsSize: maxToolArgumentsSize
+                )
             }
             return nil
 
@@ -588,27 +608,23 @@ extension AnthropicProvider {
             // Handle tool input JSON deltas
             if delta.delta.type == "input_json_delta", let partialJson = delta.delta.partialJson {
                 if var toolData = activeToolCalls[delta.index] {
-                    // Pre-allocate capacity on first append to avoid O(n²) string concatenation
-                    if toolData.jsonBuffer.isEmpty {
-                        toolData.jsonBuffer.reserveCapacity(min(4096, maxToolArgumentsSize))
-                    }
-
-                    // Check buffer size limit to prevent memory exhaustion
-                    let newSize = toolData.jsonBuffer.count + partialJson.count
-                    if newSize > maxToolArgumentsSize {
+                    // Truncation will likely result in invalid JSON,
+                    // which will be caught during finalization
+                    if !toolData.append(partialJson) {
                         logger.warning(
                             "Tool call '\(toolData.name)' arguments exceeded \(maxToolArgumentsSize) bytes, truncating"
                         )
-                        // Truncate to limit - this will likely result in invalid JSON,
-                        // which will be caught during finalization
-                        let remaining = max(0, maxToolArgumentsSize - toolData.jsonBuffer.count)
-                        toolData.jsonBuffer += String(partialJson.prefix(remaining))
-                    } else {
-                        toolData.jsonBuffer += partialJson
                     }
                     activeToolCalls[delta.index] = toolData
+
+                    return GenerationChunk(
+                        text: "",
+                        tokenCount: 0,
+                        isComplete: false,
+                        timestamp: Date(),
+                        partialToolCall: toolData.partialToolCall
+                    )
                 }
-                // Optionally could yield a PartialToolCall chunk here for progress tracking
             }
 
             return nil
@@ -616,42 +632,19 @@ extension AnthropicProvider {
         case .contentBlockStop(let stop):
             // Finalize tool call if we have one at this index
             if let toolData = activeToolCalls.removeValue(forKey: stop.index) {
-                // Only create tool call if we have accumulated JSON
-                let jsonBuffer = toolData.jsonBuffer.isEmpty ? "{}" : toolData.jsonBuffer
                 do {
-                    let toolCall = try Transcript.ToolCall(
-                        id: toolData.id,
-                        toolName: toolData.name,
-                        argumentsJSON: jsonBuffer
-                    )
+                    let (toolCall, wasRepaired) = try toolData.makeToolCall()
                     completedToolCalls.append(toolCall)
-                    logger.debug("Parsed tool call '\(toolData.name)' with id '\(toolData.id)'")
-                } catch {
-                    // Try to repair incomplete JSON before giving up
-                    let repairedJson = JsonRepair.repair(jsonBuffer)
-                    if repairedJson != jsonBuffer {
-                        logger.debug("Attempting JSON repair for '\(toolData.name)'")
-                        do {
-                            let toolCall = try Transcript.ToolCall(
-                                id: toolData.id,
-                                toolName: toolData.name,
-                                argumentsJSON: repairedJson
-                            )
-                            completedToolCalls.append(toolCall)
-                            logger.info("Recovered tool call '\(toolData.name)' via JSON repair")
-                        } catch {
-                            logger.warning(
-                                "Failed to parse tool call '\(toolData.name)' even after repair: \(error.localizedDescription)"
-                            )
-                            logger.debug("Original JSON: \(jsonBuffer.prefix(500))")
-                            logger.debug("Repaired JSON: \(repairedJson.prefix(500))")
-                        }
+                    if wasRepaired {
+                        logger.info("Recovered tool call '\(toolData.name)' from incomplete arguments")
                     } else {
-                        logger.warning(
-                            "Failed to parse tool call '\(toolData.name)': \(error.localizedDescription)"
-                        )
-                        logger.debug("Malformed JSON buffer: \(jsonBuffer.prefix(500))")
+                        logger.debug("Parsed tool call '\(toolData.name)' with id '\(toolData.id)'")
                     }
+                } catch {
+                    logger.warning(
+                        "Failed to parse tool call '\(toolData.name)': \(error.localizedDescription)"
+                    )
+                    logger.debug("Malformed JSON buffer: \(toolData.argumentsBuffer.prefix(500))")
                 }
             }
             return nil
@@ -668,10 +661,7 @@ extension AnthropicProvider {
                 isComplete: true,
                 finishReason: mapStreamStopReason(delta.delta.stopReason),
                 timestamp: Date(),
-                usage: UsageStats(
-                    promptTokens: delta.usage.inputTokens,
-                    completionTokens: delta.usage.outputTokens
-                ),
+                usage: streamUsage(delta.usage, messageStartUsage: messageStartUsage),
                 completedToolCalls: completedToolCalls.isEmpty ? nil : completedToolCalls
             )
 
@@ -687,11 +677,30 @@ extension AnthropicProvider {
             return nil
 
         default:
-            // message_start, message_stop are metadata only
+            // message_stop is metadata only
             return nil
         }
     }
 
+    /// Combines final `message_delta` usage with prompt cache counts.
+    ///
+    /// Cache counts are taken from the delta when present and otherwise from
+    /// `message_start`. As with non-streaming responses, `promptTokens`
+    /// includes cached input tokens.
+    private func streamUsage(
+        _ usage: AnthropicStreamEvent.MessageDelta.Usage,
+        messageStartUsage: AnthropicMessagesResponse.Usage?
+    ) -> UsageStats {
+        let cacheRead = usage.cacheReadInputTokens ?? messageStartUsage?.cacheReadInputTokens
+        let cacheCreation = usage.cacheCreationInputTokens ?? messageStartUsage?.cacheCreationInputTokens
+        return UsageStats(
+            promptTokens: usage.inputTokens + (cacheRead ?? 0) + (cacheCreation ?? 0),
+            completionTokens: usage.outputTokens,
+            cacheReadTokens: cacheRead,
+            cacheCreationTokens: cacheCreation
+        )
+    }
+
     // MARK: - Private Helpers
 
     /// Maps Anthropic's stop reason string to a FinishReason enum.
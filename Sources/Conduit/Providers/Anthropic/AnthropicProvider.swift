@@ -127,10 +127,11 @@ public actor AnthropicProvider: AIProvider, TextGenerator {
     /// retry policy, and feature flags.
     let configuration: AnthropicConfiguration
 
-    /// The URLSession used for HTTP requests.
+    /// The transport used for HTTP requests.
     ///
-    /// Configured with timeout and resource limits from the configuration.
-    internal let session: URLSession
+    /// Shared when the configuration supplies one; otherwise private to this
+    /// provider, with timeout limits from the configuration.
+    internal let transport: ConduitTransport
 
     /// JSON encoder for request bodies.
     ///
@@ -161,12 +162,29 @@ public actor AnthropicProvider: AIProvider, TextGenerator {
     /// let response = try await provider.generate("Hello", model: .claudeOpus45)
     /// ```
     ///
-    /// - Parameter apiKey: Your Anthropic API key (starts with "sk-ant-").
+    /// - Parameters:
+    ///   - apiKey: Your Anthropic API key (starts with "sk-ant-").
+    ///   - transport: HTTP transport shared with other providers, or `nil`
+    ///     for a private connection pool.
+    ///   - rateLimiter: Scheduler that paces requests from rate-limit
+    ///     headers, or `nil` to send requests immediately.
+    ///   - mediaCache: Cache of prepared images and Files API references,
+    ///     or `nil` to send images as supplied.
     ///
     /// - Note: For advanced configuration (custom timeouts, retries, etc.),
     ///   use `init(configuration:)` instead.
-    public init(apiKey: String) {
-        self.init(configuration: .standard(apiKey: apiKey))
+    public init(
+        apiKey: String,
+        transport: ConduitTransport? = nil,
+        rateLimiter: RateLimitScheduler? = nil,
+        mediaCache: MediaCache? = nil
+    ) {
+        self.init(
+            configuration: AnthropicConfiguration.standard(apiKey: apiKey)
+                .transport(transport)
+                .rateLimiter(rateLimiter)
+                .mediaCache(mediaCache)
+        )
     }
 
     /// Creates a provider with a full configuration.
@@ -200,17 +218,22 @@ public actor AnthropicProvider: AIProvider, TextGenerator {
     init(configuration: AnthropicConfiguration) {
         self.configuration = configuration
 
-        // Configure URLSession with timeout settings
-        let sessionConfig = URLSessionConfiguration.default
-        sessionConfig.timeoutIntervalForRequest = configuration.timeout
-        sessionConfig.timeoutIntervalForResource = configuration.timeout * 2
-        self.session = URLSession(configuration: sessionConfig)
+        // Use the shared transport, or a private one with this timeout
+        self.transport = ConduitTransport.resolve(configuration.transport, timeout: configuration.timeout)
 
         // Set up JSON encoding/decoding
         self.encoder = JSONEncoder()
         self.decoder = JSONDecoder()
     }
 
+    /// Opens a connection to the API ahead of the first request.
+    ///
+    /// Resolves DNS and completes the TLS handshake so the first generation
+    /// does not pay for them. Failures are ignored.
+    public func prewarmConnection() async {
+        await transport.prewarm(configuration.baseURL)
+    }
+
     // MARK: - AIProvider Protocol
 
     /// Whether this provider is currently available.
@@ -447,7 +470,10 @@ public actor AnthropicProvider: AIProvider, TextGenerator {
         )
 
         // Execute HTTP request with retry logic
-        let (response, rateLimitInfo) = try await executeRequest(request)
+        let (response, rateLimitInfo) = try await executeRequest(
+            request,
+            estimatedTokens: RateLimitScheduler.estimatedTokens(for: messages, maxTokens: request.maxTokens)
+        )
 
         // Convert to GenerationResult with rate limit info
         return try convertToGenerationResult(response, startTime: startTime, rateLimitInfo: rateLimitInfo)
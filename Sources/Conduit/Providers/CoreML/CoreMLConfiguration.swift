@@ -65,6 +65,23 @@ public struct CoreMLConfiguration: Sendable, Hashable, Codable {
     /// Compute units preference for model execution.
     public var computeUnits: ComputeUnits
 
+    /// Compute units for specific models, keyed by compiled model path or
+    /// file name (e.g. `"Llama-3.2-1B.mlmodelc"`).
+    ///
+    /// Models not listed use ``computeUnits``. Use this to keep a small
+    /// draft or embedding model on the Neural Engine while a larger model
+    /// runs on the GPU.
+    public var modelComputeUnits: [String: ComputeUnits]
+
+    /// Whether models with a KV cache in model state are decoded by
+    /// Conduit's stateful decode loop.
+    ///
+    /// The loop feeds one token per step and keeps the cache between turns,
+    /// so a follow-up prompt that extends the previous conversation only
+    /// processes its new tokens. Models without state always use the
+    /// `swift-transformers` generation path. Default: `true`
+    public var usesStatefulDecoding: Bool
+
     /// Default maximum output tokens when `GenerateConfig.maxTokens` is unset.
     public var defaultMaxTokens: Int
 
@@ -90,9 +107,13 @@ public struct CoreMLConfiguration: Sendable, Hashable, Codable {
         promptFormatting: PromptFormatting = .rolePrefixedText,
         toolSpecificationStrategy: ToolSpecificationStrategy = .openAIFunction,
         chatTemplate: String? = nil,
-        additionalTemplateContext: [String: JSONValue]? = nil
+        additionalTemplateContext: [String: JSONValue]? = nil,
+        modelComputeUnits: [String: ComputeUnits] = [:],
+        usesStatefulDecoding: Bool = true
     ) {
         self.computeUnits = computeUnits
+        self.modelComputeUnits = modelComputeUnits
+        self.usesStatefulDecoding = usesStatefulDecoding
         self.defaultMaxTokens = max(1, defaultMaxTokens)
         self.promptFormatting = promptFormatting
         self.toolSpecificationStrategy = toolSpecificationStrategy
@@ -108,4 +129,52 @@ public struct CoreMLConfiguration: Sendable, Hashable, Codable {
 public extension CoreMLConfiguration {
     /// Default balanced Core ML configuration.
     static let `default` = CoreMLConfiguration()
+
+    /// The compute units for the compiled model at `modelURL`: its entry in
+    /// ``modelComputeUnits`` by path, then by file name, else ``computeUnits``.
+    func computeUnits(for modelURL: URL) -> ComputeUnits {
+        modelComputeUnits[modelURL.standardizedFileURL.path]
+            ?? modelComputeUnits[modelURL.path]
+            ?? modelComputeUnits[modelURL.lastPathComponent]
+            ?? computeUnits
+    }
+}
+
+// MARK: - Codable
+
+extension CoreMLConfiguration {
+    private enum CodingKeys: String, CodingKey {
+        case computeUnits
+        case modelComputeUnits
+        case usesStatefulDecoding
+        case defaultMaxTokens
+        case promptFormatting
+        case toolSpecificationStrategy
+        case chatTemplate
+        case additionalTemplateContext
+    }
+
+    /// Decodes a configuration, defaulting settings added after it was encoded.
+    public init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        self.init(
+            computeUnits: try container.decode(ComputeUnits.self, forKey: .computeUnits),
+            defaultMaxTokens: try container.decode(Int.self, forKey: .defaultMaxTokens),
+            promptFormatting: try container.decode(PromptFormatting.self, forKey: .promptFormatting),
+            toolSpecificationStrategy: try container.decode(
+                ToolSpecificationStrategy.self,
+                forKey: .toolSpecificationStrategy
+            ),
+            chatTemplate: try container.decodeIfPresent(String.self, forKey: .chatTemplate),
+            additionalTemplateContext: try container.decodeIfPresent(
+                [String: JSONValue].self,
+                forKey: .additionalTemplateContext
+            ),
+            modelComputeUnits: try container.decodeIfPresent(
+                [String: ComputeUnits].self,
+                forKey: .modelComputeUnits
+            ) ?? [:],
+            usesStatefulDecoding: try container.decodeIfPresent(Bool.self, forKey: .usesStatefulDecoding) ?? true
+        )
+    }
 }
@@ -12,6 +12,12 @@ import Tokenizers
 /// Native Core ML provider backed by `swift-transformers`.
 ///
 /// Use `.coreml("/path/to/model.mlmodelc")` model identifiers with this provider.
+///
+/// Loaded models are kept for later requests. Models that store their KV
+/// cache in model state are decoded one token per step, and a prompt that
+/// extends the previous conversation on the same model reuses the cached
+/// keys and values of the tokens it shares. See
+/// ``CoreMLConfiguration/usesStatefulDecoding``.
 public actor CoreMLProvider: AIProvider, TextGenerator {
 
     public typealias Response = GenerationResult
@@ -26,11 +32,41 @@ public actor CoreMLProvider: AIProvider, TextGenerator {
     private let toolSpecificationHandler: ToolSpecificationHandler?
 
     @available(macOS 15.0, iOS 18.0, tvOS 18.0, watchOS 11.0, visionOS 2.0, *)
-    private struct Runtime {
+    private final class Runtime {
         let model: Models.LanguageModel
         let tokenizer: any Tokenizer
+
+        /// The stateful decode loop, or `nil` when the model has no KV-cache state.
+        let decoder: CoreMLStatefulDecoder?
+
+        init(model: Models.LanguageModel, tokenizer: any Tokenizer, decoder: CoreMLStatefulDecoder?) {
+            self.model = model
+            self.tokenizer = tokenizer
+            self.decoder = decoder
+        }
+    }
+
+    /// Identifies a loaded model.
+    private struct RuntimeKey: Hashable {
+        let path: String
+        let computeUnits: CoreMLConfiguration.ComputeUnits
     }
 
+    /// Loaded models held at once; the least recently used is released first.
+    private static let runtimeCacheLimit = 2
+
+    /// Loaded runtimes, most recently used last. Values are `Runtime`, which
+    /// requires an OS version a stored property cannot be annotated with.
+    private var runtimes: [(key: RuntimeKey, runtime: Any)] = []
+
+    /// Set by ``cancelGeneration()`` and checked between decode steps.
+    private var isCancelled = false
+
+    /// Whether a generation is using a loaded model. Loaded models and their
+    /// KV-cache state are shared, so generations run one at a time.
+    private var isGenerating = false
+    private var generationWaiters: [CheckedContinuation<Void, Never>] = []
+
     private let minimumSupportedVersion = "iOS 18 / macOS 15 / tvOS 18 / watchOS 11 / visionOS 2"
 
     public init(
@@ -175,7 +211,8 @@ public actor CoreMLProvider: AIProvider, TextGenerator {
     }
 
     public func cancelGeneration() async {
-        // swift-transformers does not expose per-request cancellation hooks.
+        // Stops the stateful decode loop; swift-transformers generation has no cancellation hook.
+        isCancelled = true
     }
 }
 
@@ -216,6 +253,10 @@ extension CoreMLProvider {
         config: GenerateConfig
     ) async throws -> GenerationResult {
         let startTime = Date()
+        await acquireGeneration()
+        defer { releaseGeneration() }
+        isCancelled = false
+
         let runtime = try await loadRuntime(modelURL: modelURL)
         let promptTokens = try encodeInputTokens(
             messages: messages,
@@ -223,6 +264,16 @@ extension CoreMLProvider {
             tokenizer: runtime.tokenizer
         )
 
+        if let decoder = runtime.decoder {
+            return try await generateStateful(
+                decoder: decoder,
+                tokenizer: runtime.tokenizer,
+                promptTokens: promptTokens,
+                config: config,
+                startTime: startTime
+            )
+        }
+
         await runtime.model.resetState()
 
         let outputTokenIDs = await runtime.model.generate(
@@ -255,19 +306,119 @@ extension CoreMLProvider {
         )
     }
 
+    private func acquireGeneration() async {
+        guard isGenerating else {
+            isGenerating = true
+            return
+        }
+        await withCheckedContinuation { generationWaiters.append($0) }
+    }
+
+    private func releaseGeneration() {
+        if generationWaiters.isEmpty {
+            isGenerating = false
+        } else {
+            generationWaiters.removeFirst().resume()
+        }
+    }
+
+    /// Decodes with the model's KV-cache state: the prompt's uncached suffix
+    /// is fed once, then one token per step.
+    @available(macOS 15.0, iOS 18.0, tvOS 18.0, watchOS 11.0, visionOS 2.0, *)
+    private func generateStateful(
+        decoder: CoreMLStatefulDecoder,
+        tokenizer: any Tokenizer,
+        promptTokens: [Int],
+        config: GenerateConfig,
+        startTime: Date
+    ) async throws -> GenerationResult {
+        let maxNewTokens = config.maxTokens ?? configuration.defaultMaxTokens
+        let stopSequences = config.stopSequences.filter { !$0.isEmpty }
+        let stopWindow = (stopSequences.map(\.count).max() ?? 0) + 8
+        var sampler = CoreMLTokenSampler(config: config)
+        var seen = Set(promptTokens)
+        var generated: [Int] = []
+        var finishReason: FinishReason = .maxTokens
+
+        var logits = try decoder.prefill(promptTokens)
+        while generated.count < maxNewTokens {
+            // Let cancelGeneration() reach the actor between steps
+            await Task.yield()
+            if isCancelled || Task.isCancelled {
+                throw AIError.cancelled
+            }
+
+            let token = sampler.sample(&logits, previous: seen)
+            if token == tokenizer.eosTokenId {
+                finishReason = .stop
+                break
+            }
+            generated.append(token)
+            seen.insert(token)
+
+            if !stopSequences.isEmpty {
+                let tail = tokenizer.decode(tokens: Array(generated.suffix(stopWindow)))
+                if stopSequences.contains(where: { tail.contains($0) }) {
+                    finishReason = .stopSequence
+                    break
+                }
+            }
+            guard generated.count < maxNewTokens, decoder.cachedTokens.count < decoder.maxContextLength else {
+                break
+            }
+            logits = try decoder.decode(token)
+        }
+
+        var text = tokenizer.decode(tokens: generated)
+        if finishReason == .stopSequence,
+           let range = stopSequences.compactMap({ text.range(of: $0) }).min(by: { $0.lowerBound < $1.lowerBound }) {
+            text = String(text[..<range.lowerBound])
+        }
+
+        let generationTime = Date().timeIntervalSince(startTime)
+        let tokensPerSecond = generationTime > 0 ? Double(generated.count) / generationTime : 0
+
+        return GenerationResult(
+            text: text,
+            tokenCount: generated.count,
+            generationTime: generationTime,
+            tokensPerSecond: tokensPerSecond,
+            finishReason: finishReason,
+            usage: UsageStats(promptTokens: promptTokens.count, completionTokens: generated.count)
+        )
+    }
+
+    /// Returns the loaded runtime for `modelURL`, loading and compiling it
+    /// only the first time.
     @available(macOS 15.0, iOS 18.0, tvOS 18.0, watchOS 11.0, visionOS 2.0, *)
     private func loadRuntime(modelURL: URL) async throws -> Runtime {
+        let computeUnits = configuration.computeUnits(for: modelURL)
+        let key = RuntimeKey(path: modelURL.standardizedFileURL.path, computeUnits: computeUnits)
+        if let index = runtimes.firstIndex(where: { $0.key == key }),
+           let runtime = runtimes[index].runtime as? Runtime {
+            runtimes.append(runtimes.remove(at: index))
+            return runtime
+        }
+
+        let runtime: Runtime
         do {
             let model = try Models.LanguageModel.loadCompiled(
                 url: modelURL,
-                computeUnits: configuration.computeUnits.mlComputeUnits
+                computeUnits: computeUnits.mlComputeUnits
             )
             let tokenizer = try await model.tokenizer
 
-            return Runtime(model: model, tokenizer: tokenizer)
+            let decoder = configuration.usesStatefulDecoding ? CoreMLStatefulDecoder(model: model.model) : nil
+            runtime = Runtime(model: model, tokenizer: tokenizer, decoder: decoder)
         } catch {
             throw AIError.generation(error)
         }
+
+        runtimes.append((key, runtime))
+        if runtimes.count > Self.runtimeCacheLimit {
+            runtimes.removeFirst(runtimes.count - Self.runtimeCacheLimit)
+        }
+        return runtime
     }
 
     private func encodeInputTokens(
@@ -372,7 +523,7 @@ extension CoreMLProvider {
         }
 
         return toolDefinitions.map { tool in
-            let resolvedSchema = tool.parameters.withResolvedRoot() ?? tool.parameters
+            let resolvedSchema = tool.parameters.resolvedForProviders()
             let parameters: JSONValue = (try? JSONValue(resolvedSchema))
                 ?? .object(["type": .string("object"), "properties": .object([:]), "required": .array([])])
 
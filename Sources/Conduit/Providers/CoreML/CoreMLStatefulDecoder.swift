@@ -0,0 +1,314 @@
+// CoreMLStatefulDecoder.swift
+// Conduit
+//
+// Token-by-token decoding for Core ML models that keep their KV cache in MLState.
+
+import Foundation
+
+#if CONDUIT_TRAIT_COREML && canImport(CoreML)
+import CoreML
+
+// MARK: - CoreMLStatefulDecoder
+
+/// Runs a stateful Core ML language model one step at a time.
+///
+/// Models converted with a KV cache stored in model state (`MLState`) take
+/// only the new tokens on each call, with a causal mask whose last dimension
+/// covers every cached position. Each decoded token therefore costs the same
+/// however long the context is, instead of re-running the whole sequence.
+///
+/// The decoder remembers which tokens its state holds. When the next prompt
+/// starts with the same tokens, as a chat transcript does from one turn to
+/// the next, only the new suffix is fed. A prompt that diverges overwrites
+/// the cache from the first differing position.
+///
+/// The model must have an `Int32` token input, a 16- or 32-bit float causal
+/// mask input and a logits output, named as exported by Apple's and Hugging Face's
+/// conversion scripts (`inputIds`, `causalMask`, `logits`).
+@available(macOS 15.0, iOS 18.0, tvOS 18.0, watchOS 11.0, visionOS 2.0, *)
+internal final class CoreMLStatefulDecoder {
+
+    // MARK: - Feature Names
+
+    /// The model's input and output names.
+    struct FeatureNames: Sendable, Hashable {
+        var inputIDs: String
+        var causalMask: String
+        var logits: String
+
+        /// Names tried, in order, for each feature.
+        static let candidates = (
+            inputIDs: ["inputIds", "input_ids"],
+            causalMask: ["causalMask", "causal_mask", "attention_mask"],
+            logits: ["logits"]
+        )
+    }
+
+    // MARK: - State
+
+    let model: MLModel
+    let names: FeatureNames
+
+    /// Longest context the state can hold.
+    let maxContextLength: Int
+
+    /// Most tokens fed in one prediction.
+    let maxInputLength: Int
+
+    private let maskType: MLMultiArrayDataType
+    private let state: MLState
+
+    /// Tokens whose keys and values are in the state, in order.
+    private(set) var cachedTokens: [Int] = []
+
+    // MARK: - Initialization
+
+    /// Wraps `model`, or returns `nil` if it has no state or lacks the
+    /// expected inputs and outputs.
+    init?(model: MLModel) {
+        let description = model.modelDescription
+        guard !description.stateDescriptionsByName.isEmpty,
+              let names = Self.featureNames(in: description),
+              let inputConstraint = description.inputDescriptionsByName[names.inputIDs]?.multiArrayConstraint,
+              let maskConstraint = description.inputDescriptionsByName[names.causalMask]?.multiArrayConstraint,
+              inputConstraint.dataType == .int32,
+              [MLMultiArrayDataType.float16, .float32].contains(maskConstraint.dataType),
+              let contextLength = Self.maxContextLength(mask: maskConstraint, states: description)
+        else {
+            return nil
+        }
+
+        self.model = model
+        self.names = names
+        self.maxContextLength = contextLength
+        self.maxInputLength = min(contextLength, Self.upperBound(of: inputConstraint, dimension: 1) ?? 1)
+        self.maskType = maskConstraint.dataType
+        self.state = model.makeState()
+    }
+
+    // MARK: - Decoding
+
+    /// Feeds `tokens`, reusing the cached prefix they share with earlier
+    /// calls, and returns the logits following the last token.
+    ///
+    /// - Throws: `AIError.invalidInput` if `tokens` do not fit the context.
+    func prefill(_ tokens: [Int]) throws -> [Float] {
+        guard !tokens.isEmpty else {
+            throw AIError.invalidInput("Prompt produced no tokens")
+        }
+        guard tokens.count <= maxContextLength else {
+            throw AIError.invalidInput(
+                "Prompt has \(tokens.count) tokens but the Core ML model's context holds \(maxContextLength)"
+            )
+        }
+
+        // Keep at least one token to feed, since its logits are needed
+        let shared = min(commonPrefixLength(cachedTokens, tokens), tokens.count - 1)
+        cachedTokens.removeLast(cachedTokens.count - shared)
+
+        var logits: [Float] = []
+        var start = shared
+        while start < tokens.count {
+            let end = min(tokens.count, start + maxInputLength)
+            logits = try feed(Array(tokens[start..<end]))
+            start = end
+        }
+        return logits
+    }
+
+    /// Feeds one token and returns the logits following it.
+    func decode(_ token: Int) throws -> [Float] {
+        guard cachedTokens.count < maxContextLength else {
+            throw AIError.invalidInput("The Core ML model's context of \(maxContextLength) tokens is full")
+        }
+        return try feed([token])
+    }
+
+    /// Forgets the cached tokens so the next prompt is fed in full.
+    func reset() {
+        cachedTokens.removeAll()
+    }
+
+    // MARK: - Prediction
+
+    private func feed(_ tokens: [Int]) throws -> [Float] {
+        let past = cachedTokens.count
+        let inputs = try MLDictionaryFeatureProvider(dictionary: [
+            names.inputIDs: MLFeatureValue(multiArray: try makeInputIDs(tokens)),
+            names.causalMask: MLFeatureValue(multiArray: try makeCausalMask(past: past, count: tokens.count)),
+        ])
+
+        let output: MLFeatureProvider
+        do {
+            output = try model.prediction(from: inputs, using: state, options: MLPredictionOptions())
+        } catch {
+            // The state may hold a partial write
+            cachedTokens.removeAll()
+            throw error
+        }
+        cachedTokens.append(contentsOf: tokens)
+
+        guard let logits = output.featureValue(for: names.logits)?.multiArrayValue else {
+            throw AIError.generation(CoreMLDecodingError.missingOutput(names.logits))
+        }
+        return try Self.lastRow(of: logits)
+    }
+
+    /// `[1, count]` 32-bit token IDs.
+    private func makeInputIDs(_ tokens: [Int]) throws -> MLMultiArray {
+        let array = try MLMultiArray(shape: [1, NSNumber(value: tokens.count)], dataType: .int32)
+        let stride = array.strides[1].intValue
+        array.withUnsafeMutableBytes { bytes, _ in
+            for (index, token) in tokens.enumerated() {
+                bytes.storeBytes(of: Int32(token), toByteOffset: index * stride * 4, as: Int32.self)
+            }
+        }
+        return array
+    }
+
+    /// `[1, 1, count, past + count]` additive mask: 0 where a token may
+    /// attend, negative infinity after it.
+    private func makeCausalMask(past: Int, count: Int) throws -> MLMultiArray {
+        let total = past + count
+        let shape = [1, 1, count, total].map { NSNumber(value: $0) }
+        let array = try MLMultiArray(shape: shape, dataType: maskType)
+        let rowStride = array.strides[2].intValue
+        let columnStride = array.strides[3].intValue
+        array.withUnsafeMutableBytes { bytes, _ in
+            for row in 0..<count {
+                for column in 0..<total {
+                    let masked = column > past + row
+                    let element = row * rowStride + column * columnStride
+                    switch maskType {
+                    case .float16:
+                        bytes.storeBytes(of: masked ? 0xFC00 : 0, toByteOffset: element * 2, as: UInt16.self)
+                    default:
+                        bytes.storeBytes(of: masked ? -Float.infinity : 0, toByteOffset: element * 4, as: Float.self)
+                    }
+                }
+            }
+        }
+        return array
+    }
+
+    /// The logits of the last position of a `[1, count, vocabulary]` output.
+    private static func lastRow(of logits: MLMultiArray) throws -> [Float] {
+        let shape = logits.shape.map(\.intValue)
+        let strides = logits.strides.map(\.intValue)
+        guard shape.count >= 2, let vocabulary = shape.last, let columnStride = strides.last else {
+            throw AIError.generation(CoreMLDecodingError.unexpectedShape(shape))
+        }
+        let rowOffset = (shape[shape.count - 2] - 1) * strides[strides.count - 2]
+
+        var row = [Float](repeating: 0, count: vocabulary)
+        switch logits.dataType {
+        case .float16:
+            logits.withUnsafeBytes { bytes in
+                for index in 0..<vocabulary {
+                    let offset = (rowOffset + index * columnStride) * 2
+                    row[index] = Self.float(fromHalf: bytes.load(fromByteOffset: offset, as: UInt16.self))
+                }
+            }
+        case .float32:
+            logits.withUnsafeBytes { bytes in
+                for index in 0..<vocabulary {
+                    row[index] = bytes.load(fromByteOffset: (rowOffset + index * columnStride) * 4, as: Float.self)
+                }
+            }
+        default:
+            for index in 0..<vocabulary {
+                row[index] = logits[rowOffset + index * columnStride].floatValue
+            }
+        }
+        return row
+    }
+
+    /// Converts IEEE 754 half-precision bits to a `Float`.
+    static func float(fromHalf bits: UInt16) -> Float {
+        let sign: UInt32 = UInt32(bits & 0x8000) << 16
+        let exponent = UInt32(bits >> 10) & 0x1F
+        let mantissa = UInt32(bits & 0x3FF)
+        switch exponent {
+        case 0:
+            let magnitude = Float(mantissa) * 0x1p-24
+            return sign == 0 ? magnitude : -magnitude
+        case 0x1F:
+            return Float(bitPattern: sign | 0x7F80_0000 | (mantissa << 13))
+        default:
+            return Float(bitPattern: sign | ((exponent + 112) << 23) | (mantissa << 13))
+        }
+    }
+
+    // MARK: - Model Inspection
+
+    private static func featureNames(in description: MLModelDescription) -> FeatureNames? {
+        let inputs = description.inputDescriptionsByName
+        let outputs = description.outputDescriptionsByName
+        guard let inputIDs = FeatureNames.candidates.inputIDs.first(where: { inputs[$0] != nil }),
+              let causalMask = FeatureNames.candidates.causalMask.first(where: { inputs[$0] != nil }),
+              let logits = FeatureNames.candidates.logits.first(where: { outputs[$0] != nil }) else {
+            return nil
+        }
+        return FeatureNames(inputIDs: inputIDs, causalMask: causalMask, logits: logits)
+    }
+
+    /// The mask's largest key dimension, or the sequence dimension of the
+    /// KV-cache state when the mask is unbounded.
+    private static func maxContextLength(
+        mask: MLMultiArrayConstraint,
+        states: MLModelDescription
+    ) -> Int? {
+        if let bound = upperBound(of: mask, dimension: 3) {
+            return bound
+        }
+        let stateShapes = states.stateDescriptionsByName.values.compactMap {
+            $0.stateConstraint?.bufferShape.map(\.intValue)
+        }
+        return stateShapes.compactMap { $0.count >= 2 ? $0[$0.count - 2] : nil }.min()
+    }
+
+    /// The largest size `dimension` accepts, or `nil` if it is unbounded.
+    private static func upperBound(of constraint: MLMultiArrayConstraint, dimension: Int) -> Int? {
+        let shapeConstraint = constraint.shapeConstraint
+        switch shapeConstraint.type {
+        case .range:
+            let ranges = shapeConstraint.sizeRangeForDimension
+            guard dimension < ranges.count else { return nil }
+            let upper = ranges[dimension].rangeValue.upperBound
+            return upper > 0 && upper < Int32.max ? upper : nil
+        case .enumerated:
+            let sizes = shapeConstraint.enumeratedShapes.compactMap { shape in
+                dimension < shape.count ? shape[dimension].intValue : nil
+            }
+            return sizes.max()
+        default:
+            return dimension < constraint.shape.count ? constraint.shape[dimension].intValue : nil
+        }
+    }
+
+    private func commonPrefixLength(_ lhs: [Int], _ rhs: [Int]) -> Int {
+        var length = 0
+        while length < lhs.count, length < rhs.count, lhs[length] == rhs[length] {
+            length += 1
+        }
+        return length
+    }
+}
+
+// MARK: - CoreMLDecodingError
+
+/// A stateful Core ML model produced output the decoder could not read.
+internal enum CoreMLDecodingError: Error, LocalizedError, Sendable {
+    case missingOutput(String)
+    case unexpectedShape([Int])
+
+    var errorDescription: String? {
+        switch self {
+        case .missingOutput(let name):
+            return "Core ML model did not return a '\(name)' output"
+        case .unexpectedShape(let shape):
+            return "Core ML model returned logits with unexpected shape \(shape)"
+        }
+    }
+}
+#endif
@@ -0,0 +1,116 @@
+// CoreMLTokenSampler.swift
+// Conduit
+//
+// Picks the next token from a row of logits for CoreMLProvider's decode loop.
+
+import Foundation
+
+// MARK: - CoreMLTokenSampler
+
+/// Chooses tokens from logits according to a ``GenerateConfig``.
+///
+/// A temperature of 0 or below picks the most likely token. Otherwise the
+/// logits are scaled by the temperature, narrowed to the `topK` most likely
+/// tokens or the smallest set whose probability reaches `topP`, and sampled.
+/// A `seed` makes sampling repeatable.
+internal struct CoreMLTokenSampler {
+
+    /// Tokens whose logit is this far below the maximum are never sampled;
+    /// their probability is below e^-20 relative to the most likely token.
+    private static let logitWindow: Float = 20
+
+    let temperature: Float
+    let topK: Int?
+    let topP: Float
+    let repetitionPenalty: Float
+    private var random: SplitMix64
+
+    /// Creates a sampler for `config`.
+    init(config: GenerateConfig) {
+        self.temperature = config.temperature
+        self.topK = config.topK.flatMap { $0 > 0 ? $0 : nil }
+        self.topP = config.topP > 0 && config.topP < 1 ? config.topP : 1
+        self.repetitionPenalty = config.repetitionPenalty > 0 ? config.repetitionPenalty : 1
+        self.random = SplitMix64(seed: config.seed ?? UInt64.random(in: .min ... .max))
+    }
+
+    /// Returns the next token.
+    ///
+    /// - Parameters:
+    ///   - logits: One score per vocabulary entry. Modified in place by the
+    ///     repetition penalty and temperature.
+    ///   - previous: Tokens already in the context, penalized when
+    ///     `repetitionPenalty` is not 1.
+    mutating func sample(_ logits: inout [Float], previous: Set<Int> = []) -> Int {
+        guard !logits.isEmpty else { return 0 }
+
+        if repetitionPenalty != 1 {
+            for token in previous where logits.indices.contains(token) {
+                let logit = logits[token]
+                logits[token] = logit > 0 ? logit / repetitionPenalty : logit * repetitionPenalty
+            }
+        }
+
+        var best = 0
+        for index in logits.indices where logits[index] > logits[best] {
+            best = index
+        }
+        guard temperature > 0 else { return best }
+
+        // Candidates close enough to the maximum to matter, most likely first
+        let floor = logits[best] - Self.logitWindow * temperature
+        var candidates = logits.indices.filter { logits[$0] >= floor }
+        candidates.sort { logits[$0] > logits[$1] }
+        if let topK, candidates.count > topK {
+            candidates.removeLast(candidates.count - topK)
+        }
+
+        let maximum = logits[best]
+        var weights = candidates.map { exp((logits[$0] - maximum) / temperature) }
+        let total = weights.reduce(0, +)
+        if topP < 1 {
+            var cumulative: Float = 0
+            for (rank, weight) in weights.enumerated() {
+                cumulative += weight
+                if cumulative >= topP * total {
+                    candidates.removeLast(candidates.count - rank - 1)
+                    weights.removeLast(weights.count - rank - 1)
+                    break
+                }
+            }
+        }
+
+        var target = random.nextUnit() * weights.reduce(0, +)
+        for (candidate, weight) in zip(candidates, weights) {
+            target -= weight
+            if target <= 0 {
+                return candidate
+            }
+        }
+        return candidates.last ?? best
+    }
+}
+
+// MARK: - SplitMix64
+
+/// A small, fast seeded generator for repeatable sampling.
+private struct SplitMix64: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var value = state
+        value = (value ^ (value >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        value = (value ^ (value >> 27)) &* 0x94D0_49BB_1331_11EB
+        return value ^ (value >> 31)
+    }
+
+    /// A uniform value in `0..<1`.
+    mutating func nextUnit() -> Float {
+        Float(next() >> 40) * 0x1p-24
+    }
+}
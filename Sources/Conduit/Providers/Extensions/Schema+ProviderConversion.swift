@@ -9,34 +9,102 @@ import Foundation
 
 extension GenerationSchema {
 
+    /// The schema as compact JSON with sorted keys.
+    ///
+    /// Encoded once per schema and shared by every copy, so a schema sent
+    /// with many requests is only serialized on first use.
+    public var canonicalJSONData: Data {
+        encodings.memoized(\.canonicalData) {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.sortedKeys]
+            return (try? encoder.encode(self)) ?? Data("{}".utf8)
+        }
+    }
+
+    /// ``canonicalJSONData`` as a string.
+    public var canonicalJSONString: String {
+        encodings.memoized(\.canonicalString) {
+            String(decoding: canonicalJSONData, as: UTF8.self)
+        }
+    }
+
     /// Converts this GenerationSchema to a JSON schema dictionary for provider APIs.
     public func toJSONSchema() -> [String: Any] {
-        let encoder = JSONEncoder()
-        let data = (try? encoder.encode(self)) ?? Data()
-        guard let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any] else {
-            return [:]
+        encodings.memoized(\.jsonObject) {
+            let json = try? JSONSerialization.jsonObject(with: canonicalJSONData) as? [String: Any]
+            return json ?? [:]
         }
-        return json
     }
 
     /// Converts this GenerationSchema to a JSON string suitable for embedding in prompts.
     public func toJSONString(prettyPrinted: Bool = true) -> String {
-        let json = toJSONSchema()
-        guard JSONSerialization.isValidJSONObject(json) else {
-            return "{}"
+        guard prettyPrinted else {
+            return canonicalJSONString
         }
+        return encodings.memoized(\.prettyString) {
+            let json = toJSONSchema()
+            guard JSONSerialization.isValidJSONObject(json),
+                  let data = try? JSONSerialization.data(
+                      withJSONObject: json,
+                      options: [.prettyPrinted, .sortedKeys]
+                  ),
+                  let string = String(data: data, encoding: .utf8) else {
+                return "{}"
+            }
+            return string
+        }
+    }
 
-        var options: JSONSerialization.WritingOptions = []
-        if prettyPrinted {
-            options.insert(.prettyPrinted)
-            options.insert(.sortedKeys)
+    /// ``withResolvedRoot()``, computed once per schema so its encodings are
+    /// shared too.
+    ///
+    /// Schemas whose root is not a resolvable reference are returned as is.
+    /// Memoizing `self` would store the schema in its own encodings box and
+    /// keep both alive forever.
+    func resolvedForProviders() -> GenerationSchema {
+        guard case .ref(let name) = root, defs[name] != nil else { return self }
+        return encodings.memoized(\.resolved) {
+            withResolvedRoot() ?? self
         }
+    }
+}
+
+// MARK: - GenerationSchemaEncodings
 
-        guard let data = try? JSONSerialization.data(withJSONObject: json, options: options),
-              let string = String(data: data, encoding: .utf8) else {
-            return "{}"
+/// Memoized JSON forms of a ``GenerationSchema``.
+///
+/// Schemas are immutable once built, so each form is computed on first use
+/// and reused by every copy of the schema. Concurrent first uses may both
+/// compute a form; the results are identical.
+///
+/// Marked `@unchecked Sendable` because all state is guarded by an `NSLock`.
+/// The cached dictionary is a value type and is only handed out as a copy.
+final class GenerationSchemaEncodings: @unchecked Sendable {
+    fileprivate var canonicalData: Data?
+    fileprivate var canonicalString: String?
+    fileprivate var prettyString: String?
+    fileprivate var jsonObject: [String: Any]?
+    fileprivate var resolved: GenerationSchema?
+
+    private let lock = NSLock()
+
+    fileprivate func memoized<Value>(
+        _ slot: ReferenceWritableKeyPath<GenerationSchemaEncodings, Value?>,
+        _ make: () -> Value
+    ) -> Value {
+        if let cached = withLock({ self[keyPath: slot] }) {
+            return cached
         }
-        return string
+        // Computed outside the lock: forms are built from one another.
+        let value = make()
+        withLock { self[keyPath: slot] = value }
+        return value
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
     }
 }
 
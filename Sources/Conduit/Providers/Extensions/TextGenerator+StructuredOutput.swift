@@ -5,6 +5,15 @@
 
 import Foundation
 
+// MARK: - GrammarConstrainedGenerator
+
+/// A generator that enforces ``GenerateConfig/responseFormat`` by masking
+/// tokens while decoding, rather than relying on the prompt alone.
+///
+/// Structured-output requests to these generators carry the target type's
+/// schema as a `.jsonSchema` response format, so the output always parses.
+protocol GrammarConstrainedGenerator {}
+
 // MARK: - TextGenerator Structured Output
 
 extension TextGenerator {
@@ -53,7 +62,11 @@ extension TextGenerator {
         \(schemaJSON)
         """
 
-        let text = try await generate(structuredPrompt, model: model, config: config)
+        let text = try await generate(
+            structuredPrompt,
+            model: model,
+            config: structuredOutputConfig(config, for: type)
+        )
 
         do {
             let content = try GeneratedContent(json: text)
@@ -95,7 +108,11 @@ extension TextGenerator {
         var structuredMessages = messages
         structuredMessages.append(.user(instruction))
 
-        let result = try await generate(messages: structuredMessages, model: model, config: config)
+        let result = try await generate(
+            messages: structuredMessages,
+            model: model,
+            config: structuredOutputConfig(config, for: type)
+        )
 
         do {
             let content = try GeneratedContent(json: result.text)
@@ -104,4 +121,13 @@ extension TextGenerator {
             throw AIError.generationFailed(underlying: SendableError(error))
         }
     }
+
+    /// `config` with `type`'s schema as the response format, when this
+    /// generator decodes under a grammar and no format was chosen.
+    func structuredOutputConfig<T: Generable>(_ config: GenerateConfig, for type: T.Type) -> GenerateConfig {
+        guard self is any GrammarConstrainedGenerator, config.responseFormat == nil else {
+            return config
+        }
+        return config.responseFormat(.jsonSchema(name: String(describing: type), schema: T.generationSchema))
+    }
 }
@@ -12,7 +12,11 @@ extension TextGenerator {
     /// Streams a structured response, yielding partial values as they arrive.
     ///
     /// This method enables progressive UI updates during generation by parsing
-    /// incomplete JSON and yielding typed partial values.
+    /// incomplete JSON and yielding typed partial values. Chunks are fed to a
+    /// resumable `IncrementalJSONParser`, so text is never re-parsed. Each
+    /// partial value still copies the containers that are open at that point,
+    /// so an update costs time in proportion to their size: a long array of
+    /// objects costs more per update than a short one.
     ///
     /// ## Usage
     ///
@@ -49,30 +53,65 @@ extension TextGenerator {
         config: GenerateConfig = GenerateConfig()
     ) -> StreamingResult<T> {
         // Create the underlying string stream
-        let stringStream = stream(prompt, model: model, config: config)
+        let stringStream = stream(prompt, model: model, config: structuredOutputConfig(config, for: type))
 
         // Transform to structured streaming
         let structuredStream = AsyncThrowingStream<StreamingResult<T>.Snapshot, Error> { continuation in
             let task = Task {
+                // The incremental parser consumes each chunk once. The raw text is
+                // kept only so the repair-based fallback can take over if the model
+                // emits something the strict parser rejects (e.g. trailing commas).
+                var parser = IncrementalJSONParser()
+                var usesFallback = false
                 var accumulated = ""
                 accumulated.reserveCapacity(4096)
-                var lastParsedContent: GeneratedContent?
+                var accumulatedCount = 0
+                // The parser path dedupes by revision; only the fallback, which
+                // re-parses the whole buffer anyway, compares content
+                var yieldedRevision: Int?
+                var lastFallbackContent: GeneratedContent?
+                var hasYielded = false
                 let partialDecoder = PartialJSONDecoder()
 
                 // Maximum buffer size limit (1MB)
                 let maxAccumulatedSize = 1_000_000
 
+                @discardableResult
+                func yieldPartial(_ content: GeneratedContent) -> Bool {
+                    guard let partial = try? T.PartiallyGenerated(content) else {
+                        // Parsing to Partial failed; continue accumulating
+                        return false
+                    }
+                    hasYielded = true
+                    continuation.yield(.init(content: partial, rawContent: content))
+                    return true
+                }
+
                 do {
                     for try await chunk in stringStream {
                         // Check for cancellation to improve responsiveness
                         try Task.checkCancellation()
 
                         // Check buffer size limit BEFORE appending to prevent exceeding limit
-                        guard accumulated.count + chunk.count <= maxAccumulatedSize else {
+                        let chunkCount = chunk.count
+                        guard accumulatedCount + chunkCount <= maxAccumulatedSize else {
                             throw StreamingError.parseFailed("Response would exceed maximum size of 1MB")
                         }
+                        accumulatedCount += chunkCount
                         accumulated += chunk
 
+                        if !usesFallback {
+                            parser.feed(chunk)
+
+                            if parser.state != .failed {
+                                if let content = parser.snapshotIfChanged(), yieldPartial(content) {
+                                    yieldedRevision = parser.revision
+                                }
+                                continue
+                            }
+                            usesFallback = true
+                        }
+
                         // Only attempt parse when chunk likely changes JSON parseability.
                         let shouldAttemptParse = chunk.rangeOfCharacter(
                             from: CharacterSet(charactersIn: "{}[]\":,0123456789tfn-")
@@ -83,35 +122,34 @@ extension TextGenerator {
                         if let content = Self.parseStreamingContent(
                             from: accumulated,
                             partialDecoder: partialDecoder
-                        ) {
-                            do {
-                                let partial = try T.PartiallyGenerated(content)
-                                // Only yield if meaningfully different from last
-                                if lastParsedContent != content {
-                                    lastParsedContent = content
-                                    continuation.yield(.init(content: partial, rawContent: content))
-                                }
-                            } catch {
-                                // Parsing to Partial failed, continue accumulating
-                            }
+                        ), content != lastFallbackContent, yieldPartial(content) {
+                            lastFallbackContent = content
                         }
                     }
 
                     // Final parse attempt with complete content
-                    if let content = Self.parseStreamingContent(
-                        from: accumulated,
-                        partialDecoder: partialDecoder
-                    ) {
+                    parser.finish()
+                    let finalContent: GeneratedContent?
+                    let isNew: Bool
+                    if usesFallback {
+                        finalContent = Self.parseStreamingContent(from: accumulated, partialDecoder: partialDecoder)
+                        isNew = finalContent != lastFallbackContent
+                    } else {
+                        finalContent = parser.snapshot()
+                        isNew = parser.revision != yieldedRevision
+                    }
+
+                    if let content = finalContent {
                         do {
                             let partial = try T.PartiallyGenerated(content)
-                            if lastParsedContent != content {
+                            if isNew {
                                 continuation.yield(.init(content: partial, rawContent: content))
                             }
                         } catch {
                             continuation.finish(throwing: StreamingError.conversionFailed(error))
                             return
                         }
-                    } else if lastParsedContent == nil && !accumulated.trimmingCharacters(in: .whitespacesAndNewlines).isEmpty {
+                    } else if !hasYielded && !accumulated.trimmingCharacters(in: .whitespacesAndNewlines).isEmpty {
                         continuation.finish(throwing: StreamingError.parseFailed("Unable to parse streamed JSON"))
                         return
                     }
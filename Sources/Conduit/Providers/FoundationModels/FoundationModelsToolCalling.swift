@@ -134,14 +134,7 @@ enum FoundationModelsToolPromptBuilder {
     }
 
     private static func schemaJSONString(_ schema: GenerationSchema) -> String {
-        let encoder = JSONEncoder()
-        encoder.outputFormatting = [.sortedKeys]
-        guard let data = try? encoder.encode(schema),
-              let string = String(data: data, encoding: .utf8)
-        else {
-            return "{}"
-        }
-        return string
+        schema.canonicalJSONString
     }
 }
 
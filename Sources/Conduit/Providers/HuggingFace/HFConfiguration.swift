@@ -102,6 +102,47 @@ struct HFConfiguration: Sendable, Hashable {
     /// ```
     var retryBaseDelay: TimeInterval
 
+    // MARK: - Embeddings
+
+    /// How `embedBatch` and `embedMatrix` split inputs into feature-extraction requests.
+    ///
+    /// - Note: Default is ``EmbeddingBatchPolicy/huggingFace``.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = HFConfiguration.default.embeddingBatchPolicy(
+    ///     EmbeddingBatchPolicy(maxInputsPerRequest: 64, maxConcurrentRequests: 2)
+    /// )
+    /// ```
+    var embeddingBatchPolicy: EmbeddingBatchPolicy = .huggingFace
+
+    // MARK: - Transcription
+
+    /// How `streamTranscription` splits recordings into speech-recognition requests.
+    ///
+    /// - Note: Default is ``TranscriptionChunking/default``.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = HFConfiguration.default.transcriptionChunking(
+    ///     TranscriptionChunking(windowDuration: 20, maxConcurrentWindows: 8)
+    /// )
+    /// ```
+    var transcriptionChunking: TranscriptionChunking = .default
+
+    // MARK: - Transport
+
+    /// HTTP transport shared with other providers.
+    ///
+    /// - Note: Default is `nil`, which gives the client its own connection
+    ///   pool with ``timeout`` applied.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = HFConfiguration.default.transport(.shared)
+    /// ```
+    var transport: ConduitTransport?
+
     // MARK: - Initialization
 
     /// Creates an HFConfiguration with the specified parameters.
@@ -279,4 +320,39 @@ extension HFConfiguration {
         copy.retryBaseDelay = max(0, delay)
         return copy
     }
+
+    /// Returns a copy with the specified embedding batch policy.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = HFConfiguration.default.embeddingBatchPolicy(.huggingFace)
+    /// ```
+    ///
+    /// - Parameter policy: Request size, token budget and concurrency limits.
+    /// - Returns: A new configuration with the updated policy.
+    func embeddingBatchPolicy(_ policy: EmbeddingBatchPolicy) -> HFConfiguration {
+        var copy = self
+        copy.embeddingBatchPolicy = policy
+        return copy
+    }
+
+    /// Returns a copy with the specified transcription chunking.
+    ///
+    /// - Parameter chunking: Window length, overlap and concurrency limits.
+    /// - Returns: A new configuration with the updated chunking.
+    func transcriptionChunking(_ chunking: TranscriptionChunking) -> HFConfiguration {
+        var copy = self
+        copy.transcriptionChunking = chunking
+        return copy
+    }
+
+    /// Returns a copy that sends requests through `transport`.
+    ///
+    /// - Parameter transport: The shared transport, or `nil` for a private one.
+    /// - Returns: A new configuration with the updated transport.
+    func transport(_ transport: ConduitTransport?) -> HFConfiguration {
+        var copy = self
+        copy.transport = transport
+        return copy
+    }
 }
@@ -190,7 +190,7 @@ internal struct HFErrorResponse: Codable, Sendable {
 internal actor HFInferenceClient {
 
     private let configuration: HFConfiguration
-    private let session: URLSession
+    private let transport: ConduitTransport
     private let decoder: JSONDecoder
     private let encoder: JSONEncoder
 
@@ -200,15 +200,17 @@ internal actor HFInferenceClient {
     init(configuration: HFConfiguration) {
         self.configuration = configuration
 
-        let sessionConfig = URLSessionConfiguration.default
-        sessionConfig.timeoutIntervalForRequest = configuration.timeout
-        sessionConfig.timeoutIntervalForResource = configuration.timeout * 2
-        self.session = URLSession(configuration: sessionConfig)
+        self.transport = ConduitTransport.resolve(configuration.transport, timeout: configuration.timeout)
 
         self.decoder = JSONDecoder()
         self.encoder = JSONEncoder()
     }
 
+    /// Opens a connection to the configured base URL.
+    func prewarmConnection() async {
+        await transport.prewarm(configuration.baseURL)
+    }
+
     // MARK: - Chat Completion (Non-Streaming)
 
     /// Performs a non-streaming chat completion request.
@@ -338,12 +340,32 @@ internal actor HFInferenceClient {
             .appendingPathComponent(model)
 
         var urlRequest = try createURLRequest(url: url, method: "POST")
-        urlRequest.setValue("audio/mpeg", forHTTPHeaderField: "Content-Type")
+        urlRequest.setValue(Self.audioContentType(of: audioData), forHTTPHeaderField: "Content-Type")
         urlRequest.httpBody = audioData
 
         return try await performRequestWithRetry(urlRequest, responseType: HFASRResponse.self)
     }
 
+    /// The MIME type of `audioData`, judged from its leading bytes.
+    ///
+    /// Falls back to `audio/mpeg` for MP3 and anything unrecognized.
+    static func audioContentType(of audioData: Data) -> String {
+        let magic = audioData.prefix(12)
+        if magic.starts(with: Data("RIFF".utf8)), magic.dropFirst(8).starts(with: Data("WAVE".utf8)) {
+            return "audio/wav"
+        }
+        if magic.starts(with: Data("fLaC".utf8)) {
+            return "audio/flac"
+        }
+        if magic.starts(with: Data("OggS".utf8)) {
+            return "audio/ogg"
+        }
+        if magic.dropFirst(4).starts(with: Data("ftyp".utf8)) {
+            return "audio/mp4"
+        }
+        return "audio/mpeg"
+    }
+
     // MARK: - Text-to-Image Generation
 
     /// Generates an image from a text prompt.
@@ -420,7 +442,7 @@ internal actor HFInferenceClient {
 
         for attempt in 0...configuration.maxRetries {
             do {
-                let (data, response) = try await session.data(for: request)
+                let (data, response) = try await transport.data(for: request)
 
                 guard let httpResponse = response as? HTTPURLResponse else {
                     throw AIError.networkError(URLError(.badServerResponse))
@@ -475,7 +497,7 @@ internal actor HFInferenceClient {
 
         for attempt in 0...configuration.maxRetries {
             do {
-                let (data, response) = try await session.data(for: request)
+                let (data, response) = try await transport.data(for: request)
 
                 guard let httpResponse = response as? HTTPURLResponse else {
                     throw AIError.networkError(URLError(.badServerResponse))
@@ -522,7 +544,7 @@ internal actor HFInferenceClient {
         urlRequest.setValue("text/event-stream", forHTTPHeaderField: "Accept")
         urlRequest.httpBody = try encoder.encode(body)
 
-        let (bytes, response) = try await session.asyncBytes(for: urlRequest)
+        let (bytes, response) = try await transport.asyncBytes(for: urlRequest)
 
         guard let httpResponse = response as? HTTPURLResponse else {
             throw AIError.networkError(URLError(.badServerResponse))
@@ -530,25 +552,15 @@ internal actor HFInferenceClient {
 
         if httpResponse.statusCode >= 400 {
             // Read all data for error response
-            var errorData = Data()
-            for try await byte in bytes {
-                errorData.append(byte)
-            }
+            let (errorData, _) = try await bytes.chunks.collect(upTo: .max)
             try handleHTTPError(statusCode: httpResponse.statusCode, data: errorData, response: httpResponse)
         }
 
-        var parser = ServerSentEventParser()
+        for try await event in bytes.chunks.serverSentEvents {
+            if event.isDoneMarker { return }
 
-        for try await line in bytes.lines {
-            let events = parser.ingestLine(line)
-
-            for event in events {
-                if event.data == "[DONE]" { return }
-
-                guard let data = event.data.data(using: .utf8) else { continue }
-                if let chunk = try? decoder.decode(HFChatCompletionResponse.self, from: data) {
-                    continuation.yield(chunk)
-                }
+            if let chunk = try? decoder.decode(HFChatCompletionResponse.self, from: event.data) {
+                continuation.yield(chunk)
             }
         }
     }
@@ -609,6 +621,7 @@ internal actor HFInferenceClient {
     private func createURLRequest(url: URL, method: String) throws -> URLRequest {
         var request = URLRequest(url: url)
         request.httpMethod = method
+        request.timeoutInterval = configuration.timeout
 
         // Add authentication if available
         let token = try resolveToken()
@@ -164,6 +164,8 @@ public actor HuggingFaceProvider: AIProvider, TextGenerator, EmbeddingGenerator,
     /// - Parameters:
     ///   - token: HuggingFace API token (starts with "hf_").
     ///   - defaultImageModel: Default model for image generation. Defaults to Stable Diffusion 3.
+    ///   - transport: HTTP transport shared with other providers, or `nil` for
+    ///     a private connection pool.
     ///
     /// ## Example
     /// ```swift
@@ -179,12 +181,21 @@ public actor HuggingFaceProvider: AIProvider, TextGenerator, EmbeddingGenerator,
     /// - Warning: Do not hardcode tokens in source code. Load from secure storage.
     public init(
         token: String,
-        defaultImageModel: String = "stabilityai/stable-diffusion-3"
+        defaultImageModel: String = "stabilityai/stable-diffusion-3",
+        transport: ConduitTransport? = nil
     ) {
-        let config = HFConfiguration.default.token(.static(token))
+        let config = HFConfiguration.default.token(.static(token)).transport(transport)
         self.init(configuration: config, defaultImageModel: defaultImageModel)
     }
 
+    /// Opens a connection to the inference API ahead of the first request.
+    ///
+    /// Resolves DNS and completes the TLS handshake so the first generation
+    /// does not pay for them. Failures are ignored.
+    public func prewarmConnection() async {
+        await client.prewarmConnection()
+    }
+
     // MARK: - AIProvider: Availability
 
     /// Whether HuggingFace is available for inference.
@@ -460,33 +471,42 @@ public actor HuggingFaceProvider: AIProvider, TextGenerator, EmbeddingGenerator,
 
     /// Generates embeddings for multiple texts in a batch.
     ///
+    /// Texts are split into feature-extraction requests according to
+    /// `configuration.embeddingBatchPolicy`, sent with bounded concurrency.
+    ///
     /// - Parameters:
     ///   - texts: Array of texts to embed.
     ///   - model: Embedding model identifier. Must be a `.huggingFace()` model.
     /// - Returns: Array of embedding results, one per input text.
-    /// - Throws: `AIError` if batch embedding fails.
+    /// - Throws: `AIError` if batch embedding fails or the endpoint returns
+    ///   a different number of embeddings than inputs.
     public func embedBatch(
         _ texts: [String],
         model: ModelID
     ) async throws -> [EmbeddingResult] {
+        try await embedMatrix(texts, model: model).results
+    }
+
+    /// Generates embeddings for multiple texts into one contiguous buffer.
+    ///
+    /// - Parameters:
+    ///   - texts: Array of texts to embed.
+    ///   - model: Embedding model identifier. Must be a `.huggingFace()` model.
+    /// - Returns: A matrix with one row per input text, in order.
+    /// - Throws: `AIError` if batch embedding fails.
+    public func embedMatrix(
+        _ texts: [String],
+        model: ModelID
+    ) async throws -> EmbeddingMatrix {
         // Validate model type
         guard case .huggingFace(let modelId) = model else {
             throw AIError.invalidInput("HuggingFaceProvider only supports .huggingFace() models")
         }
 
-        // Call feature extraction with batch
-        let embeddings = try await client.featureExtraction(
-            model: modelId,
-            inputs: texts
-        )
-
-        // Convert to results
-        return zip(texts, embeddings).map { text, embedding in
-            EmbeddingResult(
-                vector: embedding,
-                text: text,
-                model: modelId
-            )
+        let client = self.client
+        return try await configuration.embeddingBatchPolicy.embedMatrix(texts, model: modelId) { inputs in
+            let vectors = try await client.featureExtraction(model: modelId, inputs: inputs)
+            return (vectors, nil)
         }
     }
 
@@ -505,8 +525,8 @@ public actor HuggingFaceProvider: AIProvider, TextGenerator, EmbeddingGenerator,
         model: ModelID,
         config: TranscriptionConfig
     ) async throws -> TranscriptionResult {
-        // Load audio data
-        let data = try Data(contentsOf: url)
+        // Map rather than copy, since recordings can be large
+        let data = try Data(contentsOf: url, options: .mappedIfSafe)
         return try await transcribe(audioData: data, model: model, config: config)
     }
 
@@ -568,8 +588,11 @@ public actor HuggingFaceProvider: AIProvider, TextGenerator, EmbeddingGenerator,
 
     /// Streams transcription results as they become available.
     ///
-    /// HuggingFace Inference API does not support streaming transcription.
-    /// This method falls back to calling `transcribe()` and yielding all segments.
+    /// The HuggingFace Inference API answers once a whole file is processed,
+    /// so WAV recordings are cut into overlapping windows that are uploaded
+    /// and transcribed in parallel, as set by
+    /// ``HFConfiguration/transcriptionChunking``. Segments are yielded in
+    /// order as their windows finish. Other formats are sent in one request.
     ///
     /// - Parameters:
     ///   - url: The URL of the audio file to transcribe.
@@ -581,28 +604,7 @@ public actor HuggingFaceProvider: AIProvider, TextGenerator, EmbeddingGenerator,
         model: ModelID,
         config: TranscriptionConfig
     ) -> AsyncThrowingStream<TranscriptionSegment, Error> {
-        AsyncThrowingStream { continuation in
-            Task {
-                do {
-                    // HF doesn't support streaming transcription, so we fallback
-                    // to full transcription and yield all segments
-                    let result = try await self.transcribe(
-                        audioURL: url,
-                        model: model,
-                        config: config
-                    )
-
-                    // Yield all segments
-                    for segment in result.segments {
-                        continuation.yield(segment)
-                    }
-
-                    continuation.finish()
-                } catch {
-                    continuation.finish(throwing: error)
-                }
-            }
-        }
+        streamTranscription(audioURL: url, model: model, config: config, chunking: configuration.transcriptionChunking)
     }
 
     // MARK: - Image Generation
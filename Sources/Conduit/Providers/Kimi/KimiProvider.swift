@@ -64,11 +64,14 @@ public actor KimiProvider: AIProvider, TextGenerator {
     }
 
     /// Creates a provider with explicit network tuning settings.
+    ///
+    /// Pass `transport` to share one connection pool across providers.
     public init(
         apiKey: String,
         baseURL: URL,
         timeout: TimeInterval = 120,
-        maxRetries: Int = 3
+        maxRetries: Int = 3,
+        transport: ConduitTransport? = nil
     ) {
         self.init(
             configuration: KimiConfiguration(
@@ -76,26 +79,36 @@ public actor KimiProvider: AIProvider, TextGenerator {
                 baseURL: baseURL,
                 timeout: timeout,
                 maxRetries: maxRetries
-            )
+            ),
+            transport: transport
         )
     }
 
     /// Creates a provider with a full configuration.
     ///
-    /// - Parameter configuration: The provider configuration.
-    init(configuration: KimiConfiguration) {
+    /// - Parameters:
+    ///   - configuration: The provider configuration.
+    ///   - transport: HTTP transport shared with other providers, or `nil`
+    ///     for a private connection pool.
+    init(configuration: KimiConfiguration, transport: ConduitTransport? = nil) {
         self.configuration = configuration
 
         // Create OpenAI-compatible internal configuration
-        let openAIConfig = OpenAIConfiguration(
+        var openAIConfig = OpenAIConfiguration(
             endpoint: .custom(configuration.baseURL),
             authentication: .bearer(configuration.authentication.apiKey ?? ""),
             timeout: configuration.timeout,
             maxRetries: configuration.maxRetries
         )
+        openAIConfig.transport = transport
         self.internalProvider = OpenAIProvider(configuration: openAIConfig)
     }
 
+    /// Opens a connection to the API ahead of the first request.
+    public func prewarmConnection() async {
+        await internalProvider.prewarmConnection()
+    }
+
     // MARK: - AIProvider Protocol
 
     public var isAvailable: Bool {
@@ -52,6 +52,15 @@ public struct LlamaConfiguration: Sendable, Hashable, Codable {
     /// Optional mirostat sampling configuration.
     public var mirostat: MirostatMode?
 
+    /// Maximum number of requests decoded together (`n_seq_max`).
+    ///
+    /// With `1`, requests run one at a time and reuse the KV cache prefix of the
+    /// previous request. Larger values enable continuous batching: concurrent
+    /// requests to the same model are packed into one `llama_batch` per step,
+    /// each with its own sequence and sampler. The context is sized so every
+    /// sequence gets `contextSize` tokens.
+    public var maxConcurrentSequences: Int
+
     /// Creates a llama.cpp configuration.
     public init(
         contextSize: UInt32 = 4096,
@@ -62,7 +71,8 @@ public struct LlamaConfiguration: Sendable, Hashable, Codable {
         lockMemory: Bool = false,
         defaultMaxTokens: Int = 512,
         repeatLastTokens: Int32 = -1,
-        mirostat: MirostatMode? = nil
+        mirostat: MirostatMode? = nil,
+        maxConcurrentSequences: Int = 1
     ) {
         self.contextSize = max(1, contextSize)
         self.batchSize = max(1, batchSize)
@@ -73,6 +83,28 @@ public struct LlamaConfiguration: Sendable, Hashable, Codable {
         self.defaultMaxTokens = max(1, defaultMaxTokens)
         self.repeatLastTokens = max(-1, repeatLastTokens)
         self.mirostat = mirostat
+        self.maxConcurrentSequences = max(1, maxConcurrentSequences)
+    }
+
+    private enum CodingKeys: String, CodingKey {
+        case contextSize, batchSize, threadCount, gpuLayers, useMemoryMapping, lockMemory
+        case defaultMaxTokens, repeatLastTokens, mirostat, maxConcurrentSequences
+    }
+
+    public init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        self.init(
+            contextSize: try container.decode(UInt32.self, forKey: .contextSize),
+            batchSize: try container.decode(UInt32.self, forKey: .batchSize),
+            threadCount: try container.decode(Int32.self, forKey: .threadCount),
+            gpuLayers: try container.decode(Int32.self, forKey: .gpuLayers),
+            useMemoryMapping: try container.decode(Bool.self, forKey: .useMemoryMapping),
+            lockMemory: try container.decode(Bool.self, forKey: .lockMemory),
+            defaultMaxTokens: try container.decode(Int.self, forKey: .defaultMaxTokens),
+            repeatLastTokens: try container.decode(Int32.self, forKey: .repeatLastTokens),
+            mirostat: try container.decodeIfPresent(MirostatMode.self, forKey: .mirostat),
+            maxConcurrentSequences: try container.decodeIfPresent(Int.self, forKey: .maxConcurrentSequences) ?? 1
+        )
     }
 }
 
@@ -80,6 +112,20 @@ public extension LlamaConfiguration {
     /// Default balanced llama.cpp configuration.
     static let `default` = LlamaConfiguration()
 
+    /// Throughput profile that batches up to four concurrent requests.
+    static let concurrent = LlamaConfiguration(
+        contextSize: 4096,
+        batchSize: 512,
+        threadCount: Int32(ProcessInfo.processInfo.processorCount),
+        gpuLayers: 0,
+        useMemoryMapping: true,
+        lockMemory: false,
+        defaultMaxTokens: 512,
+        repeatLastTokens: -1,
+        mirostat: nil,
+        maxConcurrentSequences: 4
+    )
+
     /// Conservative memory profile for constrained devices.
     static let lowMemory = LlamaConfiguration(
         contextSize: 2048,
@@ -0,0 +1,78 @@
+// LlamaPromptCache.swift
+// Conduit
+
+import Foundation
+
+/// Tracks the token sequence resident in a persistent llama.cpp KV cache.
+///
+/// `LlamaProvider` keeps its context alive between requests. Before each
+/// generation it asks the cache for a ``Plan``: the longest prefix of the new
+/// prompt that is already decoded is kept, everything after the first
+/// divergence is evicted, and only the remaining suffix is prefilled. In a
+/// chat this turns every turn's prefill from "whole conversation" into
+/// "latest messages", and edits such as `undoLastExchange()` simply trim the
+/// cache back to the shared history.
+internal struct LlamaPromptCache: Sendable, Equatable {
+
+    /// How a prompt maps onto the tokens already in the KV cache.
+    struct Plan: Sendable, Equatable {
+        /// Leading prompt tokens whose KV cells are reused as-is.
+        let reusedTokenCount: Int
+
+        /// Prompt tokens that must be decoded.
+        let prefillTokenCount: Int
+
+        /// Cached tokens past the reused prefix that are evicted.
+        let evictedTokenCount: Int
+
+        /// Whether any KV cells were reused.
+        var isHit: Bool {
+            reusedTokenCount > 0
+        }
+    }
+
+    /// Tokens currently decoded into the KV cache, in position order.
+    private(set) var tokens: [Int32] = []
+
+    /// Computes how to bring the cache in line with `prompt`.
+    ///
+    /// At least one prompt token is always left to decode so the model
+    /// produces logits for the next sample.
+    ///
+    /// - Parameters:
+    ///   - prompt: The fully templated prompt tokens.
+    ///   - maximumReusedTokens: Optional cap on the reused prefix.
+    func plan(for prompt: [Int32], maximumReusedTokens: Int? = nil) -> Plan {
+        var common = 0
+        let limit = min(tokens.count, prompt.count)
+        while common < limit, tokens[common] == prompt[common] {
+            common += 1
+        }
+
+        var reused = min(common, max(0, prompt.count - 1))
+        if let maximumReusedTokens {
+            reused = min(reused, max(0, maximumReusedTokens))
+        }
+
+        return Plan(
+            reusedTokenCount: reused,
+            prefillTokenCount: prompt.count - reused,
+            evictedTokenCount: tokens.count - reused
+        )
+    }
+
+    /// Records that `prompt` is now fully decoded into the KV cache.
+    mutating func commit(prompt: [Int32]) {
+        tokens = prompt
+    }
+
+    /// Records a generated token decoded after the prompt.
+    mutating func append(_ token: Int32) {
+        tokens.append(token)
+    }
+
+    /// Forgets all cached tokens.
+    mutating func invalidate() {
+        tokens.removeAll(keepingCapacity: true)
+    }
+}
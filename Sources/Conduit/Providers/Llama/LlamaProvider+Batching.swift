@@ -0,0 +1,498 @@
+// LlamaProvider+Batching.swift
+// Conduit
+//
+// Continuous batching of concurrent requests for LlamaProvider.
+
+import Foundation
+
+#if Llama && canImport(LlamaSwift)
+@preconcurrency import LlamaSwift
+
+// MARK: - Request Handle
+
+/// Cancellation flag shared between a batched request's stream and the scheduler.
+///
+/// Stream termination handlers are synchronous and may run before the request
+/// reaches the actor, so the flag is lock-protected rather than actor state.
+final class LlamaBatchRequestHandle: @unchecked Sendable {
+    private let lock = NSLock()
+    private var cancelled = false
+
+    var isCancelled: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return cancelled
+    }
+
+    func cancel() {
+        lock.lock()
+        cancelled = true
+        lock.unlock()
+    }
+}
+
+// MARK: - Scheduler State
+
+/// Requests served by the continuous-batching scheduler.
+///
+/// Every active request owns one llama.cpp sequence (`seq_id`) in the shared
+/// context and its own sampler chain. Each scheduler step packs one decode
+/// token per generating sequence plus as many prompt tokens of prefilling
+/// sequences as fit in `batchSize` into a single `llama_batch`.
+struct LlamaBatchScheduler {
+
+    /// A request waiting for a free sequence.
+    struct PendingRequest {
+        let handle: LlamaBatchRequestHandle
+        let modelPath: String
+        let messages: [Message]
+        let options: LlamaProvider.RuntimeOptions
+        let continuation: AsyncThrowingStream<GenerationChunk, Error>.Continuation
+        let startTime: Date
+    }
+
+    /// A request occupying a sequence in the shared context.
+    struct ActiveSequence {
+        let request: PendingRequest
+        let seqID: llama_seq_id
+        let promptTokens: [llama_token]
+        let sampler: UnsafeMutablePointer<llama_sampler>
+        var prefillOffset = 0
+        var nextPosition: Int32 = 0
+        var pendingToken: llama_token?
+        var logitsIndex: Int32?
+        var completionTokens = 0
+        var pendingText = ""
+
+        var isPrefilling: Bool {
+            prefillOffset < promptTokens.count
+        }
+    }
+
+    var waiting: [PendingRequest] = []
+    var active: [ActiveSequence] = []
+    var modelPath: String?
+    var isRunning = false
+}
+
+// MARK: - Scheduling
+
+extension LlamaProvider {
+
+    /// Whether requests are served by the continuous-batching scheduler.
+    nonisolated var usesContinuousBatching: Bool {
+        configuration.maxConcurrentSequences > 1
+    }
+
+    /// Streams a request through the continuous-batching scheduler.
+    nonisolated func batchedStream(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        AsyncThrowingStream { continuation in
+            let handle = LlamaBatchRequestHandle()
+            continuation.onTermination = { @Sendable _ in
+                handle.cancel()
+            }
+
+            Task {
+                await self.enqueueBatchedRequest(
+                    handle: handle,
+                    messages: messages,
+                    model: model,
+                    config: config,
+                    continuation: continuation
+                )
+            }
+        }
+    }
+
+    /// Runs a non-streaming request through the scheduler and collects its output.
+    func batchedGeneration(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async throws -> GenerationResult {
+        let startTime = Date()
+        var text = ""
+        var finishReason: FinishReason = .maxTokens
+        var usage: UsageStats?
+
+        for try await chunk in batchedStream(messages: messages, model: model, config: config) {
+            text += chunk.text
+            if chunk.isComplete {
+                finishReason = chunk.finishReason ?? .stop
+                usage = chunk.usage
+            }
+        }
+
+        let duration = Date().timeIntervalSince(startTime)
+        let completionTokens = usage?.completionTokens ?? 0
+        return GenerationResult(
+            text: text,
+            tokenCount: completionTokens,
+            generationTime: duration,
+            tokensPerSecond: duration > 0 ? Double(completionTokens) / duration : 0,
+            finishReason: finishReason,
+            usage: usage
+        )
+    }
+
+    /// Cancels every queued and active batched request.
+    func cancelBatchedRequests() {
+        for request in batchScheduler.waiting {
+            request.handle.cancel()
+        }
+        for sequence in batchScheduler.active {
+            sequence.request.handle.cancel()
+        }
+    }
+
+    private func enqueueBatchedRequest(
+        handle: LlamaBatchRequestHandle,
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        continuation: AsyncThrowingStream<GenerationChunk, Error>.Continuation
+    ) {
+        do {
+            guard !messages.isEmpty else {
+                throw AIError.invalidInput("Messages cannot be empty")
+            }
+            let modelPath = try resolveModelPath(from: model)
+            guard FileManager.default.fileExists(atPath: modelPath) else {
+                throw AIError.modelNotFound(model)
+            }
+
+            batchScheduler.waiting.append(
+                LlamaBatchScheduler.PendingRequest(
+                    handle: handle,
+                    modelPath: modelPath,
+                    messages: messages,
+                    options: makeRuntimeOptions(from: config),
+                    continuation: continuation,
+                    startTime: Date()
+                )
+            )
+        } catch {
+            continuation.finish(throwing: mapError(error))
+            return
+        }
+
+        guard !batchScheduler.isRunning else { return }
+        batchScheduler.isRunning = true
+        Task { await self.runBatchScheduler() }
+    }
+
+    /// Drives scheduler steps until no request is queued or active.
+    ///
+    /// The actor is released between steps, which is where new requests are
+    /// enqueued and admitted.
+    private func runBatchScheduler() async {
+        var batch = llama_batch_init(Int32(configuration.batchSize), 0, 1)
+        defer {
+            llama_batch_free(batch)
+            batchScheduler.isRunning = false
+        }
+
+        while !batchScheduler.waiting.isEmpty || !batchScheduler.active.isEmpty {
+            retireCancelledSequences()
+            admitWaitingRequests()
+
+            if !batchScheduler.active.isEmpty {
+                do {
+                    try stepBatch(&batch)
+                } catch {
+                    failActiveSequences(with: error)
+                }
+            }
+
+            await Task.yield()
+        }
+    }
+
+    // MARK: - Admission
+
+    private func admitWaitingRequests() {
+        var index = 0
+        while index < batchScheduler.waiting.count,
+              batchScheduler.active.count < configuration.maxConcurrentSequences {
+            let request = batchScheduler.waiting[index]
+
+            if request.handle.isCancelled {
+                batchScheduler.waiting.remove(at: index)
+                request.continuation.finish()
+                continue
+            }
+
+            // Sequences share one context, so a different model waits until the batch drains.
+            if let current = batchScheduler.modelPath, current != request.modelPath, !batchScheduler.active.isEmpty {
+                index += 1
+                continue
+            }
+
+            batchScheduler.waiting.remove(at: index)
+            do {
+                try activate(request)
+            } catch {
+                request.continuation.finish(throwing: mapError(error))
+            }
+        }
+    }
+
+    private func activate(_ request: LlamaBatchScheduler.PendingRequest) throws {
+        let modelPointer = try ensureModelLoaded(at: request.modelPath)
+        let context = try acquireContext(model: modelPointer, options: request.options)
+        batchScheduler.modelPath = request.modelPath
+
+        if llama_model_has_encoder(modelPointer) {
+            throw AIError.invalidInput("Continuous batching does not support encoder-decoder models")
+        }
+        guard let vocab = llama_model_get_vocab(modelPointer) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
+        }
+
+        let prompt = try buildPrompt(from: request.messages, model: modelPointer)
+        let promptTokens = try tokenize(text: prompt, vocab: vocab)
+        guard promptTokens.count < Int(configuration.contextSize) else {
+            throw AIError.invalidInput(
+                "Prompt has \(promptTokens.count) tokens, exceeding the context size of \(configuration.contextSize)"
+            )
+        }
+
+        let usedIDs = Set(batchScheduler.active.map(\.seqID))
+        let sequenceIDs = 0..<Int32(configuration.maxConcurrentSequences)
+        guard let seqID = sequenceIDs.first(where: { !usedIDs.contains($0) }) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
+        }
+
+        guard let sampler = llama_sampler_chain_init(llama_sampler_chain_default_params()) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
+        }
+        let samplerPtr = UnsafeMutablePointer<llama_sampler>(sampler)
+        configureSampler(sampler: samplerPtr, options: request.options, vocab: vocab)
+
+        if let memory = llama_get_memory(context) {
+            _ = llama_memory_seq_rm(memory, seqID, -1, -1)
+        }
+
+        batchScheduler.active.append(
+            LlamaBatchScheduler.ActiveSequence(
+                request: request,
+                seqID: seqID,
+                promptTokens: promptTokens,
+                sampler: samplerPtr
+            )
+        )
+    }
+
+    // MARK: - Stepping
+
+    /// Decodes one mixed prefill/decode batch and samples every sequence that produced logits.
+    private func stepBatch(_ batch: inout llama_batch) throws {
+        guard let context = cachedContext,
+              let model = loadedModel,
+              let vocab = llama_model_get_vocab(model) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
+        }
+
+        let threads = max(1, configuration.threadCount)
+        llama_set_n_threads(context, threads, threads)
+
+        let capacity = Int(configuration.batchSize)
+        batch.n_tokens = 0
+
+        func append(_ token: llama_token, position: Int32, seqID: llama_seq_id, wantsLogits: Bool) {
+            let index = Int(batch.n_tokens)
+            batch.token[index] = token
+            batch.pos[index] = position
+            batch.n_seq_id[index] = 1
+            if let seqIDs = batch.seq_id, let seq = seqIDs[index] {
+                seq[0] = seqID
+            }
+            batch.logits[index] = wantsLogits ? 1 : 0
+            batch.n_tokens += 1
+        }
+
+        // Decode tokens first so generating sequences advance every step.
+        for index in batchScheduler.active.indices {
+            batchScheduler.active[index].logitsIndex = nil
+            guard let token = batchScheduler.active[index].pendingToken,
+                  Int(batch.n_tokens) < capacity else { continue }
+
+            let sequence = batchScheduler.active[index]
+            batchScheduler.active[index].logitsIndex = batch.n_tokens
+            append(token, position: sequence.nextPosition, seqID: sequence.seqID, wantsLogits: true)
+            batchScheduler.active[index].nextPosition += 1
+            batchScheduler.active[index].pendingToken = nil
+        }
+
+        // Fill the remaining budget with prompt chunks.
+        for index in batchScheduler.active.indices where batchScheduler.active[index].isPrefilling {
+            let room = capacity - Int(batch.n_tokens)
+            guard room > 0 else { break }
+
+            var sequence = batchScheduler.active[index]
+            let end = min(sequence.prefillOffset + room, sequence.promptTokens.count)
+            for position in sequence.prefillOffset..<end {
+                let isLastPromptToken = position == sequence.promptTokens.count - 1
+                if isLastPromptToken {
+                    sequence.logitsIndex = batch.n_tokens
+                }
+                append(
+                    sequence.promptTokens[position],
+                    position: Int32(position),
+                    seqID: sequence.seqID,
+                    wantsLogits: isLastPromptToken
+                )
+            }
+            sequence.prefillOffset = end
+            sequence.nextPosition = Int32(end)
+            batchScheduler.active[index] = sequence
+        }
+
+        guard batch.n_tokens > 0 else { return }
+        guard llama_decode(context, batch) == 0 else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
+        }
+
+        var finished: [(index: Int, reason: FinishReason)] = []
+        for index in batchScheduler.active.indices {
+            guard let logitsIndex = batchScheduler.active[index].logitsIndex else { continue }
+            if let reason = sampleNextToken(at: index, logitsIndex: logitsIndex, context: context, vocab: vocab) {
+                finished.append((index, reason))
+            }
+        }
+
+        for entry in finished.reversed() {
+            retireSequence(at: entry.index, finishReason: entry.reason)
+        }
+    }
+
+    /// Samples and delivers the next token of a sequence.
+    ///
+    /// - Returns: The finish reason if the sequence is done.
+    private func sampleNextToken(
+        at index: Int,
+        logitsIndex: Int32,
+        context: OpaquePointer,
+        vocab: OpaquePointer
+    ) -> FinishReason? {
+        var sequence = batchScheduler.active[index]
+        defer { batchScheduler.active[index] = sequence }
+
+        let options = sequence.request.options
+        let nextToken = llama_sampler_sample(sequence.sampler, context, logitsIndex)
+
+        if llama_vocab_is_eog(vocab, nextToken) {
+            return .stop
+        }
+
+        sequence.completionTokens += 1
+        if let piece = tokenToText(vocab: vocab, token: nextToken), !piece.isEmpty {
+            if deliver(piece, to: &sequence) {
+                return .stopSequence
+            }
+        }
+
+        if sequence.completionTokens >= options.maxTokens
+            || Int(sequence.nextPosition) >= Int(configuration.contextSize) - 1 {
+            return .maxTokens
+        }
+
+        sequence.pendingToken = nextToken
+        return nil
+    }
+
+    /// Appends a decoded piece, yielding text that can no longer start a stop sequence.
+    ///
+    /// - Returns: `true` if a stop sequence matched.
+    private func deliver(_ piece: String, to sequence: inout LlamaBatchScheduler.ActiveSequence) -> Bool {
+        let options = sequence.request.options
+        let elapsed = Date().timeIntervalSince(sequence.request.startTime)
+        let tokensPerSecond = elapsed > 0 ? Double(sequence.completionTokens) / elapsed : 0
+        sequence.pendingText += piece
+
+        if trimMatchedStopSequence(in: &sequence.pendingText, stopSequences: options.stopSequences) {
+            return true
+        }
+
+        let holdbackCount = max(0, (options.stopSequences.map(\.count).max() ?? 0) - 1)
+        guard sequence.pendingText.count > holdbackCount else { return false }
+
+        let safeCount = sequence.pendingText.count - holdbackCount
+        let safeText = String(sequence.pendingText.prefix(safeCount))
+        sequence.pendingText.removeFirst(safeCount)
+        sequence.request.continuation.yield(
+            GenerationChunk(
+                text: safeText,
+                tokenCount: 1,
+                tokensPerSecond: tokensPerSecond,
+                isComplete: false
+            )
+        )
+        return false
+    }
+
+    // MARK: - Retirement
+
+    private func retireCancelledSequences() {
+        for index in batchScheduler.active.indices.reversed()
+        where batchScheduler.active[index].request.handle.isCancelled {
+            retireSequence(at: index, finishReason: .cancelled)
+        }
+    }
+
+    private func retireSequence(at index: Int, finishReason: FinishReason) {
+        let sequence = batchScheduler.active.remove(at: index)
+        let continuation = sequence.request.continuation
+
+        if !sequence.pendingText.isEmpty {
+            let elapsed = Date().timeIntervalSince(sequence.request.startTime)
+            continuation.yield(
+                GenerationChunk(
+                    text: sequence.pendingText,
+                    tokenCount: 0,
+                    tokensPerSecond: elapsed > 0 ? Double(sequence.completionTokens) / elapsed : 0,
+                    isComplete: false
+                )
+            )
+        }
+
+        continuation.yield(
+            GenerationChunk(
+                text: "",
+                tokenCount: 0,
+                isComplete: true,
+                finishReason: finishReason,
+                usage: UsageStats(
+                    promptTokens: sequence.promptTokens.count,
+                    completionTokens: sequence.completionTokens
+                )
+            )
+        )
+        continuation.finish()
+        releaseSequenceResources(sequence)
+    }
+
+    private func failActiveSequences(with error: Error) {
+        let mapped = mapError(error)
+        let sequences = batchScheduler.active
+        batchScheduler.active.removeAll()
+
+        for sequence in sequences {
+            sequence.request.continuation.finish(throwing: mapped)
+            releaseSequenceResources(sequence)
+        }
+    }
+
+    private func releaseSequenceResources(_ sequence: LlamaBatchScheduler.ActiveSequence) {
+        llama_sampler_free(sequence.sampler)
+        if let cachedContext, let memory = llama_get_memory(cachedContext) {
+            _ = llama_memory_seq_rm(memory, sequence.seqID, -1, -1)
+        }
+    }
+}
+
+#endif
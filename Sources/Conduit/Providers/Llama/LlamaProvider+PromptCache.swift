@@ -0,0 +1,192 @@
+// LlamaProvider+PromptCache.swift
+// Conduit
+//
+// Persistent llama.cpp context and KV prompt-prefix reuse for LlamaProvider.
+
+import Foundation
+
+#if Llama && canImport(LlamaSwift)
+@preconcurrency import LlamaSwift
+
+extension LlamaProvider {
+
+    // MARK: - Runtime Diagnostics
+
+    /// Returns runtime feature capabilities for the given model.
+    public func runtimeCapabilities(for model: ModelID) async -> ProviderRuntimeCapabilities {
+        ProviderRuntimeCapabilities(capabilities: [
+            .incrementalPrefill: ProviderRuntimeFeatureCapability(
+                isSupported: true,
+                maxIncrementalPrefillTokens: Int(configuration.contextSize)
+            ),
+            .speculativeScheduling: ProviderRuntimeFeatureCapability(
+                isSupported: true,
+                maxDraftStreams: 1,
+                maxDraftAheadTokens: Self.maximumDraftAheadTokens,
+                supportsVerifierRollback: true
+            ),
+        ])
+    }
+
+    /// Snapshot current runtime diagnostics.
+    public func runtimeDiagnosticsSnapshot() -> [ProviderRuntimeDiagnosticsEvent] {
+        runtimeDiagnosticsEvents
+    }
+
+    /// Clears buffered runtime diagnostics.
+    public func clearRuntimeDiagnostics() {
+        runtimeDiagnosticsEvents.removeAll(keepingCapacity: false)
+    }
+
+    /// Returns prompt-prefix reuse counters accumulated since the last reset.
+    public func prefixCacheStatistics() -> ProviderRuntimePrefixCacheStatistics {
+        prefixCacheCounters
+    }
+
+    /// Drops the cached KV state and resets prefix-cache counters.
+    ///
+    /// The next request prefills its whole prompt.
+    public func resetPromptCache() {
+        if let cachedContext, let memory = llama_get_memory(cachedContext) {
+            llama_memory_clear(memory, true)
+        }
+        promptCache.invalidate()
+        prefixCacheCounters = ProviderRuntimePrefixCacheStatistics()
+    }
+}
+
+// MARK: - Context Lifecycle
+
+extension LlamaProvider {
+    /// Returns the persistent context for the loaded model, creating it on first use.
+    func acquireContext(model: OpaquePointer, options: RuntimeOptions) throws -> OpaquePointer {
+        if let cachedContext {
+            return cachedContext
+        }
+
+        let contextParams = createContextParams(from: options)
+        guard let context = llama_init_from_model(model, contextParams) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
+        }
+
+        if llama_get_memory(context) == nil {
+            llama_free(context)
+            throw AIError.invalidInput("The selected GGUF model cannot be used for causal text generation")
+        }
+
+        llama_set_causal_attn(context, true)
+        llama_set_warmup(context, false)
+
+        cachedContext = context
+        promptCache.invalidate()
+        return context
+    }
+
+    func releaseContext() {
+        if let cachedContext {
+            llama_free(cachedContext)
+            self.cachedContext = nil
+        }
+        promptCache.invalidate()
+    }
+
+    /// Brings the KV cache in line with `promptTokens`, decoding only the uncached suffix.
+    func prefillPrompt(
+        batch: inout llama_batch,
+        promptTokens: [llama_token],
+        model: OpaquePointer,
+        modelPath: String,
+        vocab: OpaquePointer,
+        context: OpaquePointer,
+        options: RuntimeOptions,
+        config: GenerateConfig
+    ) throws -> Bool {
+        guard let memory = llama_get_memory(context) else {
+            throw AIError.invalidInput("The selected GGUF model cannot be used for causal text generation")
+        }
+
+        let incrementalPrefill = config.runtimeFeatures?.incrementalPrefill
+        let canReuse = !llama_model_has_encoder(model) && incrementalPrefill?.enabled != false
+
+        var plan = promptCache.plan(
+            for: promptTokens,
+            maximumReusedTokens: canReuse ? incrementalPrefill?.maxPrefixTokens : 0
+        )
+
+        // Evict everything past the reused prefix. Stale cells left by a failed
+        // request are removed the same way.
+        if !llama_memory_seq_rm(memory, -1, Int32(plan.reusedTokenCount), -1) {
+            // Some memory types (e.g. recurrent state) cannot be trimmed partially.
+            llama_memory_clear(memory, true)
+            plan = LlamaPromptCache.Plan(
+                reusedTokenCount: 0,
+                prefillTokenCount: promptTokens.count,
+                evictedTokenCount: promptCache.tokens.count
+            )
+        }
+        promptCache.invalidate()
+
+        let hasEncoder = try prepareInitialBatch(
+            batch: &batch,
+            promptTokens: promptTokens,
+            reusedPrefixCount: plan.reusedTokenCount,
+            model: model,
+            vocab: vocab,
+            context: context,
+            batchSize: options.batchSize
+        )
+
+        if !hasEncoder {
+            promptCache.commit(prompt: promptTokens)
+        }
+        recordPrefixCacheLookup(plan, modelID: modelPath, reuseEnabled: canReuse)
+        return hasEncoder
+    }
+
+    private func recordPrefixCacheLookup(_ plan: LlamaPromptCache.Plan, modelID: String, reuseEnabled: Bool) {
+        if plan.isHit {
+            prefixCacheCounters.hits += 1
+        } else {
+            prefixCacheCounters.misses += 1
+        }
+        prefixCacheCounters.reusedTokens += plan.reusedTokenCount
+        prefixCacheCounters.prefilledTokens += plan.prefillTokenCount
+        prefixCacheCounters.evictedTokens += plan.evictedTokenCount
+
+        recordRuntimeDiagnostic(
+            feature: .incrementalPrefill,
+            kind: plan.isHit ? .prefixCacheHit : .prefixCacheMiss,
+            modelID: modelID,
+            reason: reuseEnabled ? nil : "reuseDisabled",
+            details: [
+                "reused_tokens": String(plan.reusedTokenCount),
+                "prefill_tokens": String(plan.prefillTokenCount),
+                "evicted_tokens": String(plan.evictedTokenCount),
+            ]
+        )
+    }
+
+    func recordRuntimeDiagnostic(
+        feature: ProviderRuntimeFeature,
+        kind: ProviderRuntimeDiagnosticsEventKind,
+        modelID: String,
+        reason: String?,
+        details: [String: String]
+    ) {
+        runtimeDiagnosticsEvents.append(
+            ProviderRuntimeDiagnosticsEvent(
+                feature: feature,
+                kind: kind,
+                modelID: modelID,
+                reason: reason,
+                details: details
+            )
+        )
+
+        if runtimeDiagnosticsEvents.count > runtimeDiagnosticsLimit {
+            runtimeDiagnosticsEvents.removeFirst(runtimeDiagnosticsEvents.count - runtimeDiagnosticsLimit)
+        }
+    }
+}
+
+#endif
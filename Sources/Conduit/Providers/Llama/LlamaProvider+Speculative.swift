@@ -0,0 +1,378 @@
+// LlamaProvider+Speculative.swift
+// Conduit
+//
+// Draft-model speculative decoding for LlamaProvider.
+
+import Foundation
+
+#if Llama && canImport(LlamaSwift)
+@preconcurrency import LlamaSwift
+
+// MARK: - Speculative State
+
+/// Per-turn state of a speculative decoding run.
+///
+/// `history` is the prompt plus every emitted token. Its last token has been
+/// sampled but not yet decoded by the target; each round decodes it together
+/// with the draft in one batch, so the target KV cache always ends one token
+/// behind `history`.
+struct LlamaSpeculativeState {
+    let modelID: String
+    let draftModelPath: String
+    let draftContext: OpaquePointer
+    let draftSampler: UnsafeMutablePointer<llama_sampler>
+    var draftBatch: llama_batch
+    let startTime: Date
+    var controller: SpeculativeDecodingController
+    var history: [llama_token]
+    var pending: [llama_token] = []
+    var needsInitialSample = true
+}
+
+extension LlamaProvider {
+
+    /// Upper bound on `draftAheadTokens` advertised in runtime capabilities.
+    static let maximumDraftAheadTokens = 16
+
+    // MARK: - Setup
+
+    /// Prepares speculative decoding for a turn, or returns `nil` to decode normally.
+    ///
+    /// Loads (or reuses) the draft model named by
+    /// `runtimeFeatures.speculativeScheduling.draftModel` and prefills it with
+    /// the prompt. Any reason the draft cannot be used is recorded as a
+    /// diagnostic and the turn falls back to baseline decoding.
+    func makeSpeculativeState(
+        config: GenerateConfig,
+        options: RuntimeOptions,
+        targetModel: OpaquePointer,
+        targetModelPath: String,
+        targetVocab: OpaquePointer,
+        promptTokens: [llama_token]
+    ) -> LlamaSpeculativeState? {
+        guard let speculative = config.runtimeFeatures?.speculativeScheduling,
+              speculative.enabled == true else { return nil }
+
+        func fallBack(_ reason: String, details: [String: String] = [:]) -> LlamaSpeculativeState? {
+            recordRuntimeDiagnostic(
+                feature: .speculativeScheduling,
+                kind: .capabilityDenied,
+                modelID: targetModelPath,
+                reason: reason,
+                details: details
+            )
+            recordRuntimeDiagnostic(
+                feature: .speculativeScheduling,
+                kind: .fallbackUsed,
+                modelID: targetModelPath,
+                reason: "fallbackToBaseline",
+                details: [:]
+            )
+            return nil
+        }
+
+        guard let draftPath = speculative.draftModel, !draftPath.isEmpty else {
+            return fallBack("draftModelMissing")
+        }
+        if llama_model_has_encoder(targetModel) {
+            return fallBack("encoderDecoderUnsupported")
+        }
+        if let count = speculative.draftStreamCount, count > 1 {
+            return fallBack("draftStreamCountExceedsCapability", details: ["requested": String(count), "max": "1"])
+        }
+
+        let controller = SpeculativeDecodingController(
+            configuration: speculative,
+            maximumDraftAheadTokens: Self.maximumDraftAheadTokens,
+            maximumBatchTokens: Int(options.batchSize)
+        )
+        guard controller.isDrafting else {
+            return fallBack(controller.disabledReason ?? "noDraftBudget")
+        }
+
+        let draftContext: OpaquePointer
+        do {
+            draftContext = try acquireDraftContext(at: draftPath, options: options)
+        } catch {
+            return fallBack("draftModelUnavailable", details: ["draft_model": draftPath])
+        }
+
+        guard let draftModel, let draftVocab = llama_model_get_vocab(draftModel),
+              llama_vocab_n_tokens(draftVocab) == llama_vocab_n_tokens(targetVocab) else {
+            return fallBack("draftVocabularyMismatch", details: ["draft_model": draftPath])
+        }
+
+        guard let sampler = llama_sampler_chain_init(llama_sampler_chain_default_params()) else {
+            return fallBack("draftSamplerUnavailable")
+        }
+        let draftSampler = UnsafeMutablePointer<llama_sampler>(sampler)
+        llama_sampler_chain_add(draftSampler, llama_sampler_init_greedy())
+
+        var state = LlamaSpeculativeState(
+            modelID: targetModelPath,
+            draftModelPath: draftPath,
+            draftContext: draftContext,
+            draftSampler: draftSampler,
+            draftBatch: llama_batch_init(Int32(options.batchSize), 0, 1),
+            startTime: Date(),
+            controller: controller,
+            history: promptTokens
+        )
+
+        do {
+            try syncDraft(&state)
+        } catch {
+            llama_batch_free(state.draftBatch)
+            llama_sampler_free(draftSampler)
+            return fallBack("draftPrefillFailed", details: ["draft_model": draftPath])
+        }
+
+        recordRuntimeDiagnostic(
+            feature: .speculativeScheduling,
+            kind: .capabilitySelected,
+            modelID: targetModelPath,
+            reason: nil,
+            details: [
+                "draft_model": draftPath,
+                "draft_ahead_tokens": String(controller.draftAheadTokens),
+            ]
+        )
+        return state
+    }
+
+    /// Releases per-turn resources and records the turn's acceptance statistics.
+    func finishSpeculation(_ state: LlamaSpeculativeState) {
+        llama_batch_free(state.draftBatch)
+        llama_sampler_free(state.draftSampler)
+        recordRuntimeDiagnostic(
+            feature: .speculativeScheduling,
+            kind: .speculativeDecoding,
+            modelID: state.modelID,
+            reason: state.controller.disabledReason,
+            details: state.controller.diagnosticsDetails(
+                draftModel: state.draftModelPath,
+                elapsed: Date().timeIntervalSince(state.startTime)
+            )
+        )
+    }
+
+    // MARK: - Decoding
+
+    /// Returns the next target token, running a draft/verify round when none are pending.
+    ///
+    /// Tokens returned here are already decoded into the target KV cache (except the
+    /// most recent one), so callers skip their own per-token decode.
+    ///
+    /// - Parameters:
+    ///   - logitsIndex: Batch index of the prefill logits, used for the first token.
+    ///   - remainingTokens: Tokens the turn may still emit.
+    func nextSpeculativeToken(
+        _ state: inout LlamaSpeculativeState,
+        context: OpaquePointer,
+        sampler: UnsafeMutablePointer<llama_sampler>,
+        vocab: OpaquePointer,
+        batch: inout llama_batch,
+        logitsIndex: Int32,
+        remainingTokens: Int
+    ) throws -> llama_token {
+        if !state.pending.isEmpty {
+            return state.pending.removeFirst()
+        }
+
+        if state.needsInitialSample {
+            state.needsInitialSample = false
+            let token = llama_sampler_sample(sampler, context, logitsIndex)
+            state.history.append(token)
+            state.controller.recordEmittedToken()
+            return token
+        }
+
+        let contextRoom = Int(configuration.contextSize) - state.history.count
+        let draftCount = state.controller.draftLength(remainingTokens: min(remainingTokens, contextRoom))
+        let draft = try draftTokens(&state, count: draftCount, vocab: vocab)
+        let emitted = try verify(draft: draft, state: state, context: context, sampler: sampler, batch: &batch)
+        let accepted = emitted.count - 1
+
+        // The target decoded the last emitted token and the whole draft; keep only the accepted prefix.
+        let lastPosition = state.history.count - 1
+        if accepted < draft.count, let memory = llama_get_memory(context) {
+            _ = llama_memory_seq_rm(memory, 0, Int32(lastPosition + 1 + accepted), -1)
+        }
+        promptCache.append(state.history[lastPosition])
+        for token in draft.prefix(accepted) {
+            promptCache.append(token)
+        }
+
+        state.history.append(contentsOf: emitted)
+        if let reason = state.controller.recordRound(draftedTokens: draft.count, acceptedTokens: accepted) {
+            recordRuntimeDiagnostic(
+                feature: .speculativeScheduling,
+                kind: .autoDisabled,
+                modelID: state.modelID,
+                reason: reason,
+                details: [
+                    "accept_rate": String(format: "%.3f", state.controller.statistics.acceptRate),
+                    "rollback_tokens": String(state.controller.statistics.rollbackTokens),
+                ]
+            )
+        }
+
+        state.pending = emitted
+        return state.pending.removeFirst()
+    }
+
+    /// Decodes the last emitted token plus `draft` in one target pass and verifies the draft.
+    private func verify(
+        draft: [llama_token],
+        state: LlamaSpeculativeState,
+        context: OpaquePointer,
+        sampler: UnsafeMutablePointer<llama_sampler>,
+        batch: inout llama_batch
+    ) throws -> [llama_token] {
+        let lastPosition = state.history.count - 1
+        let tokens = [state.history[lastPosition]] + draft
+
+        batch.n_tokens = 0
+        for (offset, token) in tokens.enumerated() {
+            appendToBatch(&batch, token: token, position: Int32(lastPosition + offset), wantsLogits: true)
+        }
+        guard llama_decode(context, batch) == 0 else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
+        }
+
+        return SpeculativeDecodingController.verify(draft: draft) { position in
+            let token = llama_sampler_sample(sampler, context, Int32(position))
+            return token
+        }
+    }
+
+    /// Greedily proposes up to `count` tokens continuing `history` with the draft model.
+    private func draftTokens(
+        _ state: inout LlamaSpeculativeState,
+        count: Int,
+        vocab: OpaquePointer
+    ) throws -> [llama_token] {
+        guard count > 0 else { return [] }
+        try syncDraft(&state)
+
+        var draft: [llama_token] = []
+        draft.reserveCapacity(count)
+        llama_sampler_reset(state.draftSampler)
+
+        while draft.count < count {
+            let token = llama_sampler_sample(state.draftSampler, state.draftContext, -1)
+            draft.append(token)
+            if draft.count == count || llama_vocab_is_eog(vocab, token) {
+                break
+            }
+
+            let position = Int32(state.history.count + draft.count - 1)
+            state.draftBatch.n_tokens = 0
+            appendToBatch(&state.draftBatch, token: token, position: position, wantsLogits: true)
+            guard llama_decode(state.draftContext, state.draftBatch) == 0 else {
+                throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
+            }
+            draftCache.append(token)
+        }
+        return draft
+    }
+
+    /// Brings the draft KV cache in line with `history`, decoding only what it has not seen.
+    private func syncDraft(_ state: inout LlamaSpeculativeState) throws {
+        guard let memory = llama_get_memory(state.draftContext) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
+        }
+
+        var plan = draftCache.plan(for: state.history)
+        if !llama_memory_seq_rm(memory, -1, Int32(plan.reusedTokenCount), -1) {
+            llama_memory_clear(memory, true)
+            plan = LlamaPromptCache.Plan(
+                reusedTokenCount: 0,
+                prefillTokenCount: state.history.count,
+                evictedTokenCount: draftCache.tokens.count
+            )
+        }
+        draftCache.invalidate()
+
+        let capacity = Int(configuration.batchSize)
+        var position = plan.reusedTokenCount
+        while position < state.history.count {
+            let end = min(position + capacity, state.history.count)
+            state.draftBatch.n_tokens = 0
+            for index in position..<end {
+                appendToBatch(
+                    &state.draftBatch,
+                    token: state.history[index],
+                    position: Int32(index),
+                    wantsLogits: index == state.history.count - 1
+                )
+            }
+            guard llama_decode(state.draftContext, state.draftBatch) == 0 else {
+                throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
+            }
+            position = end
+        }
+        draftCache.commit(prompt: state.history)
+    }
+
+    private func appendToBatch(_ batch: inout llama_batch, token: llama_token, position: Int32, wantsLogits: Bool) {
+        let index = Int(batch.n_tokens)
+        batch.token[index] = token
+        batch.pos[index] = position
+        batch.n_seq_id[index] = 1
+        if let seqIDs = batch.seq_id, let seqID = seqIDs[index] {
+            seqID[0] = 0
+        }
+        batch.logits[index] = wantsLogits ? 1 : 0
+        batch.n_tokens += 1
+    }
+
+    // MARK: - Draft Lifecycle
+
+    /// Returns the draft context for `path`, loading the draft model on first use.
+    private func acquireDraftContext(at path: String, options: RuntimeOptions) throws -> OpaquePointer {
+        if draftModelPath == path, let draftContext {
+            return draftContext
+        }
+        releaseDraftModel()
+
+        guard FileManager.default.fileExists(atPath: path) else {
+            throw AIError.modelNotFound(.llama(path))
+        }
+
+        guard let model = llama_model_load_from_file(path, createModelParams()) else {
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.modelLoadFailed))
+        }
+
+        var contextParams = llama_context_default_params()
+        contextParams.n_ctx = options.contextSize
+        contextParams.n_batch = options.batchSize
+        contextParams.n_threads = options.threads
+        contextParams.n_threads_batch = options.threads
+        guard let context = llama_init_from_model(model, contextParams) else {
+            llama_model_free(model)
+            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
+        }
+
+        draftModel = model
+        draftContext = context
+        draftModelPath = path
+        return context
+    }
+
+    /// Frees the draft model and its context.
+    func releaseDraftModel() {
+        if let draftContext {
+            llama_free(draftContext)
+            self.draftContext = nil
+        }
+        if let draftModel {
+            llama_model_free(draftModel)
+            self.draftModel = nil
+        }
+        draftModelPath = nil
+        draftCache.invalidate()
+    }
+}
+
+#endif
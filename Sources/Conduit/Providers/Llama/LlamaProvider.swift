@@ -9,6 +9,18 @@ import Foundation
 /// Native llama.cpp provider backed by `LlamaSwift`.
 ///
 /// Use `.llama("/path/to/model.gguf")` model identifiers with this provider.
+///
+/// ## Prompt Prefix Reuse
+///
+/// The provider keeps one llama.cpp context alive per loaded model and tracks
+/// which prompt tokens are already decoded into its KV cache. Each request only
+/// prefills the suffix after the longest shared prefix, so successive
+/// `ChatSession` turns do not re-decode the conversation history. When the
+/// history diverges (for example after `undoLastExchange()`), cells past the
+/// divergence point are evicted. Hits and misses are reported through
+/// ``runtimeDiagnosticsSnapshot()`` and ``prefixCacheStatistics()``; set
+/// `GenerateConfig.runtimeFeatures?.incrementalPrefill.enabled` to `false` to
+/// force a full prefill for a request.
 public actor LlamaProvider: AIProvider, TextGenerator {
 
     public typealias Response = GenerationResult
@@ -18,16 +30,43 @@ public actor LlamaProvider: AIProvider, TextGenerator {
     /// Runtime configuration for llama.cpp.
     public let configuration: LlamaConfiguration
 
-    private var backendInitialized = false
-    private var loadedModelPath: String?
-    nonisolated(unsafe) private var loadedModel: OpaquePointer?
-    private var isCancelled = false
+    var backendInitialized = false
+    var loadedModelPath: String?
+    nonisolated(unsafe) var loadedModel: OpaquePointer?
+    nonisolated(unsafe) var cachedContext: OpaquePointer?
+    var promptCache = LlamaPromptCache()
+    var isCancelled = false
+
+    /// Prompt-prefix reuse counters since the last reset.
+    var prefixCacheCounters = ProviderRuntimePrefixCacheStatistics()
+
+    /// Bounded runtime diagnostics for prefix-cache telemetry.
+    var runtimeDiagnosticsEvents: [ProviderRuntimeDiagnosticsEvent] = []
+    let runtimeDiagnosticsLimit = 512
+
+    /// Continuous-batching state, used when `maxConcurrentSequences > 1`.
+    var batchScheduler = LlamaBatchScheduler()
+
+    /// Draft model for speculative decoding, kept loaded across requests.
+    nonisolated(unsafe) var draftModel: OpaquePointer?
+    nonisolated(unsafe) var draftContext: OpaquePointer?
+    var draftModelPath: String?
+    var draftCache = LlamaPromptCache()
 
     public init(configuration: LlamaConfiguration = .default) {
         self.configuration = configuration
     }
 
     deinit {
+        if let draftContext {
+            llama_free(draftContext)
+        }
+        if let draftModel {
+            llama_model_free(draftModel)
+        }
+        if let cachedContext {
+            llama_free(cachedContext)
+        }
         if let loadedModel {
             llama_model_free(loadedModel)
         }
@@ -63,6 +102,9 @@ public actor LlamaProvider: AIProvider, TextGenerator {
         model: ModelIdentifier,
         config: GenerateConfig
     ) async throws -> GenerationResult {
+        if usesContinuousBatching {
+            return try await batchedGeneration(messages: messages, model: model, config: config)
+        }
         do {
             return try performGeneration(messages: messages, model: model, config: config)
         } catch {
@@ -92,7 +134,10 @@ public actor LlamaProvider: AIProvider, TextGenerator {
 
             continuation.onTermination = { @Sendable _ in
                 task.cancel()
-                Task { await self.cancelGeneration() }
+                // Batched requests cancel individually when the chunk stream terminates.
+                if !self.usesContinuousBatching {
+                    Task { await self.cancelGeneration() }
+                }
             }
         }
     }
@@ -110,7 +155,10 @@ public actor LlamaProvider: AIProvider, TextGenerator {
         model: ModelIdentifier,
         config: GenerateConfig
     ) -> AsyncThrowingStream<GenerationChunk, Error> {
-        AsyncThrowingStream { continuation in
+        if usesContinuousBatching {
+            return batchedStream(messages: messages, model: model, config: config)
+        }
+        return AsyncThrowingStream { continuation in
             let task = Task {
                 await self.performStreamingGeneration(
                     messages: messages,
@@ -129,13 +177,59 @@ public actor LlamaProvider: AIProvider, TextGenerator {
 
     public func cancelGeneration() async {
         isCancelled = true
+        cancelBatchedRequests()
+    }
+
+    // MARK: - Lifecycle
+
+    /// Loads a model ahead of the first request.
+    ///
+    /// With `useMemoryMapping` (the default) and `lockMemory` off, llama.cpp
+    /// maps the GGUF file rather than reading it, so loading returns once the
+    /// tensors are mapped and pages are read as they are first touched.
+    /// The model is loaded before this returns regardless of `warmup.mode`.
+    /// With `.blocking`, the warmup generation runs before returning as well;
+    /// with `.background` and `.progressive`, it runs afterwards in the
+    /// background so Metal kernels compile without delaying the caller.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let provider = LlamaProvider()
+    /// try await provider.prepare(model: .llama("/models/qwen.gguf"), warmup: .background)
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - model: The `.llama()` model to load.
+    ///   - warmup: Warmup prompt size, token count and scheduling. `warmupOnInit` is ignored.
+    public func prepare(model: ModelID, warmup: WarmupConfig = .default) async throws {
+        do {
+            _ = try ensureModelLoaded(at: try resolveModelPath(from: model))
+        } catch {
+            throw mapError(error)
+        }
+
+        let prefillText = warmup.prefillText
+        let maxTokens = warmup.warmupTokens
+        switch warmup.mode {
+        case .blocking:
+            try await warmUp(model: model, prefillText: prefillText, maxTokens: maxTokens)
+        case .background, .progressive:
+            Task {
+                try? await self.warmUp(model: model, prefillText: prefillText, maxTokens: maxTokens)
+            }
+        }
     }
 }
 
+// MARK: - Grammar-Constrained Decoding
+
+/// `responseFormat` is enforced with llama.cpp's grammar sampler.
+extension LlamaProvider: GrammarConstrainedGenerator {}
+
 // MARK: - Private Implementation
 
 extension LlamaProvider {
-    private struct RuntimeOptions: Sendable {
+    struct RuntimeOptions: Sendable {
         let contextSize: UInt32
         let batchSize: UInt32
         let threads: Int32
@@ -150,6 +244,8 @@ extension LlamaProvider {
         let presencePenalty: Float
         let mirostat: LlamaConfiguration.MirostatMode?
         let stopSequences: [String]
+        /// GBNF grammar enforcing the request's response format, if any.
+        let grammar: String?
     }
 
     private func performGeneration(
@@ -175,30 +271,21 @@ extension LlamaProvider {
 
         let promptTokens = try tokenize(text: prompt, vocab: vocab)
 
-        let contextParams = createContextParams(from: options)
-        guard let context = llama_init_from_model(modelPointer, contextParams) else {
-            throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
-        }
-        defer { llama_free(context) }
-
-        if llama_get_memory(context) == nil {
-            throw AIError.invalidInput("The selected GGUF model cannot be used for causal text generation")
-        }
-
-        llama_set_causal_attn(context, true)
-        llama_set_warmup(context, false)
+        let context = try acquireContext(model: modelPointer, options: options)
         llama_set_n_threads(context, options.threads, options.threads)
 
         var batch = llama_batch_init(Int32(options.batchSize), 0, 1)
         defer { llama_batch_free(batch) }
 
-        let hasEncoder = try prepareInitialBatch(
+        let hasEncoder = try prefillPrompt(
             batch: &batch,
             promptTokens: promptTokens,
             model: modelPointer,
+            modelPath: modelPath,
             vocab: vocab,
             context: context,
-            batchSize: options.batchSize
+            options: options,
+            config: config
         )
 
         guard let sampler = llama_sampler_chain_init(llama_sampler_chain_default_params()) else {
@@ -206,12 +293,26 @@ extension LlamaProvider {
         }
         defer { llama_sampler_free(sampler) }
         let samplerPtr = UnsafeMutablePointer<llama_sampler>(sampler)
-        configureSampler(sampler: samplerPtr, options: options)
+        configureSampler(sampler: samplerPtr, options: options, vocab: vocab)
+
+        var speculative = hasEncoder ? nil : makeSpeculativeState(
+            config: config,
+            options: options,
+            targetModel: modelPointer,
+            targetModelPath: modelPath,
+            targetVocab: vocab,
+            promptTokens: promptTokens
+        )
+        defer {
+            if let speculative {
+                finishSpeculation(speculative)
+            }
+        }
 
         var generatedText = ""
         var completionTokens = 0
         var finishReason: FinishReason = .maxTokens
-        var nCur: Int32 = hasEncoder ? 1 : batch.n_tokens
+        var nCur: Int32 = hasEncoder ? 1 : Int32(promptTokens.count)
 
         for _ in 0..<options.maxTokens {
             if Task.isCancelled || isCancelled {
@@ -219,8 +320,21 @@ extension LlamaProvider {
                 break
             }
 
-            let nextToken = llama_sampler_sample(sampler, context, batch.n_tokens - 1)
-            llama_sampler_accept(sampler, nextToken)
+            let nextToken: llama_token
+            if speculative != nil {
+                let logitsIndex = batch.n_tokens - 1
+                nextToken = try nextSpeculativeToken(
+                    &speculative!,
+                    context: context,
+                    sampler: samplerPtr,
+                    vocab: vocab,
+                    batch: &batch,
+                    logitsIndex: logitsIndex,
+                    remainingTokens: options.maxTokens - completionTokens
+                )
+            } else {
+                nextToken = llama_sampler_sample(sampler, context, batch.n_tokens - 1)
+            }
 
             if llama_vocab_is_eog(vocab, nextToken) {
                 finishReason = .stop
@@ -237,6 +351,9 @@ extension LlamaProvider {
                 break
             }
 
+            // Speculative rounds decode emitted tokens while verifying the draft.
+            guard speculative == nil else { continue }
+
             batch.n_tokens = 1
             batch.token[0] = nextToken
             batch.pos[0] = nCur
@@ -250,6 +367,9 @@ extension LlamaProvider {
             guard llama_decode(context, batch) == 0 else {
                 throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
             }
+            if !hasEncoder {
+                promptCache.append(nextToken)
+            }
         }
 
         let duration = Date().timeIntervalSince(startTime)
@@ -278,6 +398,8 @@ extension LlamaProvider {
 
             isCancelled = false
             let startTime = Date()
+            var telemetry = TelemetryStream(source: "llama")
+            defer { telemetry?.finish() }
 
             let modelPath = try resolveModelPath(from: model)
             let modelPointer = try ensureModelLoaded(at: modelPath)
@@ -290,30 +412,21 @@ extension LlamaProvider {
 
             let promptTokens = try tokenize(text: prompt, vocab: vocab)
 
-            let contextParams = createContextParams(from: options)
-            guard let context = llama_init_from_model(modelPointer, contextParams) else {
-                throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.contextInitializationFailed))
-            }
-            defer { llama_free(context) }
-
-            if llama_get_memory(context) == nil {
-                throw AIError.invalidInput("The selected GGUF model cannot be used for causal text generation")
-            }
-
-            llama_set_causal_attn(context, true)
-            llama_set_warmup(context, false)
+            let context = try acquireContext(model: modelPointer, options: options)
             llama_set_n_threads(context, options.threads, options.threads)
 
             var batch = llama_batch_init(Int32(options.batchSize), 0, 1)
             defer { llama_batch_free(batch) }
 
-            let hasEncoder = try prepareInitialBatch(
+            let hasEncoder = try prefillPrompt(
                 batch: &batch,
                 promptTokens: promptTokens,
                 model: modelPointer,
+                modelPath: modelPath,
                 vocab: vocab,
                 context: context,
-                batchSize: options.batchSize
+                options: options,
+                config: config
             )
 
             guard let sampler = llama_sampler_chain_init(llama_sampler_chain_default_params()) else {
@@ -321,11 +434,25 @@ extension LlamaProvider {
             }
             defer { llama_sampler_free(sampler) }
             let samplerPtr = UnsafeMutablePointer<llama_sampler>(sampler)
-            configureSampler(sampler: samplerPtr, options: options)
+            configureSampler(sampler: samplerPtr, options: options, vocab: vocab)
+
+            var speculative = hasEncoder ? nil : makeSpeculativeState(
+                config: config,
+                options: options,
+                targetModel: modelPointer,
+                targetModelPath: modelPath,
+                targetVocab: vocab,
+                promptTokens: promptTokens
+            )
+            defer {
+                if let speculative {
+                    finishSpeculation(speculative)
+                }
+            }
 
             var completionTokens = 0
             var finishReason: FinishReason = .maxTokens
-            var nCur: Int32 = hasEncoder ? 1 : batch.n_tokens
+            var nCur: Int32 = hasEncoder ? 1 : Int32(promptTokens.count)
             var pendingText = ""
             let maxStopSequenceLength = options.stopSequences.map(\.count).max() ?? 0
             let holdbackCount = max(0, maxStopSequenceLength - 1)
@@ -336,8 +463,21 @@ extension LlamaProvider {
                     break
                 }
 
-                let nextToken = llama_sampler_sample(sampler, context, batch.n_tokens - 1)
-                llama_sampler_accept(sampler, nextToken)
+                let nextToken: llama_token
+                if speculative != nil {
+                    let logitsIndex = batch.n_tokens - 1
+                    nextToken = try nextSpeculativeToken(
+                        &speculative!,
+                        context: context,
+                        sampler: samplerPtr,
+                        vocab: vocab,
+                        batch: &batch,
+                        logitsIndex: logitsIndex,
+                        remainingTokens: options.maxTokens - completionTokens
+                    )
+                } else {
+                    nextToken = llama_sampler_sample(sampler, context, batch.n_tokens - 1)
+                }
 
                 if llama_vocab_is_eog(vocab, nextToken) {
                     finishReason = .stop
@@ -345,6 +485,7 @@ extension LlamaProvider {
                 }
 
                 completionTokens += 1
+                telemetry?.chunkReceived()
                 let elapsed = Date().timeIntervalSince(startTime)
                 let tokensPerSecond = elapsed > 0 ? Double(completionTokens) / elapsed : 0
 
@@ -392,6 +533,9 @@ extension LlamaProvider {
                     }
                 }
 
+                // Speculative rounds decode emitted tokens while verifying the draft.
+                guard speculative == nil else { continue }
+
                 batch.n_tokens = 1
                 batch.token[0] = nextToken
                 batch.pos[0] = nCur
@@ -405,6 +549,9 @@ extension LlamaProvider {
                 guard llama_decode(context, batch) == 0 else {
                     throw AIError.generationFailed(underlying: SendableError(LlamaProviderError.decodingFailed))
                 }
+                if !hasEncoder {
+                    promptCache.append(nextToken)
+                }
             }
 
             if finishReason != .stopSequence, !pendingText.isEmpty {
@@ -439,7 +586,7 @@ extension LlamaProvider {
 // MARK: - Llama Runtime Helpers
 
 extension LlamaProvider {
-    private func resolveModelPath(from model: ModelIdentifier) throws -> String {
+    func resolveModelPath(from model: ModelIdentifier) throws -> String {
         guard case .llama(let path) = model else {
             throw AIError.invalidInput("LlamaProvider only supports .llama() models")
         }
@@ -451,7 +598,7 @@ extension LlamaProvider {
         return trimmedPath
     }
 
-    private func ensureModelLoaded(at path: String) throws -> OpaquePointer {
+    func ensureModelLoaded(at path: String) throws -> OpaquePointer {
         if let loadedModel, loadedModelPath == path {
             return loadedModel
         }
@@ -465,6 +612,7 @@ extension LlamaProvider {
             backendInitialized = true
         }
 
+        releaseContext()
         if let loadedModel {
             llama_model_free(loadedModel)
             self.loadedModel = nil
@@ -489,16 +637,20 @@ extension LlamaProvider {
         return params
     }
 
-    private func createContextParams(from options: RuntimeOptions) -> llama_context_params {
+    func createContextParams(from options: RuntimeOptions) -> llama_context_params {
         var params = llama_context_default_params()
-        params.n_ctx = options.contextSize
+        // Each concurrent sequence gets its own `contextSize` worth of KV cells.
+        let sequences = UInt32(max(1, configuration.maxConcurrentSequences))
+        let (totalContext, overflow) = options.contextSize.multipliedReportingOverflow(by: sequences)
+        params.n_ctx = overflow ? UInt32.max : totalContext
+        params.n_seq_max = sequences
         params.n_batch = options.batchSize
         params.n_threads = options.threads
         params.n_threads_batch = options.threads
         return params
     }
 
-    private func makeRuntimeOptions(from config: GenerateConfig) -> RuntimeOptions {
+    func makeRuntimeOptions(from config: GenerateConfig) -> RuntimeOptions {
         let maxTokens = max(1, config.maxTokens ?? configuration.defaultMaxTokens)
         let normalizedTopP = min(1, max(0, config.topP))
         let normalizedTemperature = max(0, config.temperature)
@@ -519,14 +671,21 @@ extension LlamaProvider {
             frequencyPenalty: config.frequencyPenalty,
             presencePenalty: config.presencePenalty,
             mirostat: configuration.mirostat,
-            stopSequences: config.stopSequences.filter { !$0.isEmpty }
+            stopSequences: config.stopSequences.filter { !$0.isEmpty },
+            grammar: JSONGrammar.compiled(for: config.responseFormat)?.gbnf
         )
     }
 
-    private func configureSampler(
+    func configureSampler(
         sampler: UnsafeMutablePointer<llama_sampler>,
-        options: RuntimeOptions
+        options: RuntimeOptions,
+        vocab: OpaquePointer
     ) {
+        // The grammar runs first so every later stage only sees valid tokens.
+        if let grammar = options.grammar, let grammarSampler = llama_sampler_init_grammar(vocab, grammar, "root") {
+            llama_sampler_chain_add(sampler, grammarSampler)
+        }
+
         if options.repetitionPenalty != 1.0 || options.frequencyPenalty != 0.0 || options.presencePenalty != 0.0 {
             llama_sampler_chain_add(
                 sampler,
@@ -580,7 +739,7 @@ extension LlamaProvider {
         llama_sampler_chain_add(sampler, llama_sampler_init_dist(options.seed))
     }
 
-    private func buildPrompt(from messages: [Message], model: OpaquePointer) throws -> String {
+    func buildPrompt(from messages: [Message], model: OpaquePointer) throws -> String {
         try validateMessages(messages)
 
         let mappedMessages = messages.compactMap { message -> (role: String, content: String)? in
@@ -703,7 +862,7 @@ extension LlamaProvider {
         return lines.joined(separator: "\n")
     }
 
-    private func tokenize(text: String, vocab: OpaquePointer) throws -> [llama_token] {
+    func tokenize(text: String, vocab: OpaquePointer) throws -> [llama_token] {
         let utf8Count = text.utf8.count
         let maxTokens = Int32(max(8, utf8Count * 2))
         let tokens = UnsafeMutablePointer<llama_token>.allocate(capacity: Int(maxTokens))
@@ -726,9 +885,10 @@ extension LlamaProvider {
         return Array(UnsafeBufferPointer(start: tokens, count: Int(tokenCount)))
     }
 
-    private func prepareInitialBatch(
+    func prepareInitialBatch(
         batch: inout llama_batch,
         promptTokens: [llama_token],
+        reusedPrefixCount: Int,
         model: OpaquePointer,
         vocab: OpaquePointer,
         context: OpaquePointer,
@@ -786,7 +946,7 @@ extension LlamaProvider {
                 throw AIError.invalidInput("Encoder-only model is not supported for text generation")
             }
         } else {
-            var start = 0
+            var start = reusedPrefixCount
             while start < promptTokens.count {
                 let end = min(start + effectiveBatchSize, promptTokens.count)
                 let chunk = promptTokens[start..<end]
@@ -819,7 +979,7 @@ extension LlamaProvider {
         return hasEncoder
     }
 
-    private func tokenToText(vocab: OpaquePointer, token: llama_token) -> String? {
+    func tokenToText(vocab: OpaquePointer, token: llama_token) -> String? {
         var capacity: Int32 = 64
         var buffer = UnsafeMutablePointer<CChar>.allocate(capacity: Int(capacity))
         defer { buffer.deallocate() }
@@ -856,7 +1016,7 @@ extension LlamaProvider {
         return String(decoding: bytes, as: UTF8.self)
     }
 
-    private func trimMatchedStopSequence(in text: inout String, stopSequences: [String]) -> Bool {
+    func trimMatchedStopSequence(in text: inout String, stopSequences: [String]) -> Bool {
         for sequence in stopSequences where text.hasSuffix(sequence) {
             text = String(text.dropLast(sequence.count))
             return true
@@ -864,7 +1024,7 @@ extension LlamaProvider {
         return false
     }
 
-    private func mapError(_ error: Error) -> AIError {
+    func mapError(_ error: Error) -> AIError {
         if let aiError = error as? AIError {
             return aiError
         }
@@ -872,7 +1032,7 @@ extension LlamaProvider {
     }
 }
 
-private enum LlamaProviderError: Error {
+enum LlamaProviderError: Error {
     case modelLoadFailed
     case contextInitializationFailed
     case tokenizationFailed
@@ -950,6 +1110,26 @@ public actor LlamaProvider: AIProvider, TextGenerator {
     }
 
     public func cancelGeneration() async {}
+
+    public func prepare(model: ModelID, warmup: WarmupConfig = .default) async throws {
+        throw AIError.providerUnavailable(reason: .deviceNotSupported)
+    }
+
+    public func runtimeCapabilities(for model: ModelID) async -> ProviderRuntimeCapabilities {
+        ProviderRuntimeCapabilities()
+    }
+
+    public func runtimeDiagnosticsSnapshot() -> [ProviderRuntimeDiagnosticsEvent] {
+        []
+    }
+
+    public func clearRuntimeDiagnostics() {}
+
+    public func prefixCacheStatistics() -> ProviderRuntimePrefixCacheStatistics {
+        ProviderRuntimePrefixCacheStatistics()
+    }
+
+    public func resetPromptCache() {}
 }
 
 #endif
@@ -0,0 +1,20 @@
+// MLXBenchmarkMemoryProbe.swift
+// Conduit
+
+#if CONDUIT_TRAIT_MLX && canImport(MLX)
+
+import Foundation
+@preconcurrency import MLX
+
+extension V2RuntimeMemoryProbe {
+
+    /// Process memory plus MLX's active Metal allocations.
+    ///
+    /// Model weights and KV caches live in MLX buffers that are not always
+    /// reflected in the process footprint, so MLX benchmarks use this probe.
+    package static let mlx = V2RuntimeMemoryProbe(
+        gpuBytes: { UInt64(max(0, MLX.GPU.activeMemory)) }
+    )
+}
+
+#endif // CONDUIT_TRAIT_MLX && canImport(MLX)
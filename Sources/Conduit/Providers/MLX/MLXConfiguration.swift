@@ -117,6 +117,23 @@ struct MLXConfiguration: Sendable, Hashable {
     ///
     var maxCacheSize: ByteCount?
 
+    /// Whether to load the model predicted to be requested next in the background.
+    ///
+    /// Predictions come from which model has usually followed the current
+    /// one. A model is only prefetched once its footprint has been measured,
+    /// and only if it fits the cache without evicting anything while leaving
+    /// the device memory headroom.
+    ///
+    /// - Note: Default is `false`.
+    var prefetchesPredictedModels: Bool
+
+    // MARK: - Downloads
+
+    /// Connection, segment, and bandwidth settings for downloading Hub models.
+    ///
+    /// - Note: Default is ``RangedDownloader/Configuration/default``.
+    var downloadConfiguration: RangedDownloader.Configuration
+
     // MARK: - Runtime Policy
 
     /// Policy gate for provider/runtime-owned features.
@@ -155,6 +172,8 @@ struct MLXConfiguration: Sendable, Hashable {
         self.kvQuantizationBits = max(4, min(8, kvQuantizationBits)) // Clamp to valid range
         self.maxCachedModels = 3
         self.maxCacheSize = nil
+        self.prefetchesPredictedModels = false
+        self.downloadConfiguration = .default
         self.runtimePolicy = runtimePolicy
     }
 
@@ -392,6 +411,38 @@ extension MLXConfiguration {
         return copy
     }
 
+    /// Returns a copy with predicted-model prefetching enabled or disabled.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = MLXConfiguration.default.prefetchesPredictedModels(true)
+    /// ```
+    ///
+    /// - Parameter enabled: Whether to prefetch the model predicted to be requested next.
+    /// - Returns: A new configuration with the updated setting.
+    func prefetchesPredictedModels(_ enabled: Bool) -> MLXConfiguration {
+        var copy = self
+        copy.prefetchesPredictedModels = enabled
+        return copy
+    }
+
+    /// Returns a copy with updated model download settings.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let config = MLXConfiguration.default.downloadConfiguration(
+    ///     .init(connectionsPerFile: 8, maxBytesPerSecond: 20_000_000)
+    /// )
+    /// ```
+    ///
+    /// - Parameter configuration: Connection, segment, and bandwidth settings.
+    /// - Returns: A new configuration with the updated settings.
+    func downloadConfiguration(_ configuration: RangedDownloader.Configuration) -> MLXConfiguration {
+        var copy = self
+        copy.downloadConfiguration = configuration
+        return copy
+    }
+
     /// Returns a copy with an updated runtime policy gate.
     ///
     /// - Parameter policy: Runtime feature policy + model allowlists.
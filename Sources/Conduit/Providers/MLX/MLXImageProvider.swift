@@ -12,12 +12,6 @@ import Hub
 @preconcurrency import MLX
 import StableDiffusion
 
-#if os(iOS) || os(visionOS)
-import UIKit
-#elseif os(macOS)
-import AppKit
-#endif
-
 /// Local on-device image generation using MLX StableDiffusion.
 ///
 /// Generates images entirely on-device using Apple Silicon's Neural Engine
@@ -29,6 +23,8 @@ import AppKit
 /// - **Offline**: Works without internet connection
 /// - **Progress**: Step-by-step progress callbacks
 /// - **Cancellation**: Cancel mid-generation
+/// - **Batching**: Several images of one prompt per denoising pass
+/// - **Raw Output**: Pixels or `CGImage` without PNG encoding
 ///
 /// ## Requirements
 ///
@@ -67,6 +63,10 @@ import AppKit
 /// - ≤8GB RAM: Conservative mode (3GB GPU limit)
 /// - >8GB RAM: Normal mode (more cache)
 ///
+/// Batched generation sizes each pass to the same budget, so
+/// ``generateImages(prompt:negativePrompt:count:config:onProgress:)`` runs
+/// fewer images per pass on smaller devices.
+///
 /// Call `unloadModel()` when finished to free memory.
 public actor MLXImageProvider: ImageGenerator {
 
@@ -93,6 +93,10 @@ public actor MLXImageProvider: ImageGenerator {
     /// Cache for prompt embeddings to avoid re-encoding repeated prompts.
     private let embeddingCache = TextEmbeddingCache()
 
+    /// GPU memory that batched generation plans against, recorded by
+    /// `configureMemoryLimits()` when a model loads.
+    private var generationMemoryLimit: Int?
+
     // MARK: - Initialization
 
     /// Creates a new MLX image provider.
@@ -180,6 +184,90 @@ public actor MLXImageProvider: ImageGenerator {
         config: ImageGenerationConfig = .default,
         onProgress: (@Sendable (ImageGenerationProgress) -> Void)? = nil
     ) async throws -> GeneratedImage {
+        let rasters = try await generateRasterImages(
+            prompt: prompt,
+            negativePrompt: negativePrompt,
+            count: 1,
+            config: config,
+            onProgress: onProgress
+        )
+        return try encodePNG(rasters[0])
+    }
+
+    /// Generates several images of one prompt, batching them through the
+    /// denoising loop.
+    ///
+    /// Images are denoised together, as many per pass as the GPU memory
+    /// budget from model loading allows, so `count` images take far less
+    /// than `count` sequential calls to ``generateImage(prompt:negativePrompt:config:onProgress:)``.
+    /// Each image starts from different noise.
+    ///
+    /// ```swift
+    /// let variations = try await provider.generateImages(
+    ///     prompt: "A watercolor fox in a snowy forest",
+    ///     count: 4
+    /// )
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - prompt: Text description of the desired images (must be non-empty).
+    ///   - negativePrompt: Optional text describing what to avoid.
+    ///   - count: Number of images to generate (must be positive).
+    ///   - config: Image generation configuration applied to every image.
+    ///   - onProgress: Optional callback invoked after each denoising step of
+    ///     each pass. Steps are counted across all passes.
+    ///
+    /// - Returns: `count` PNG images.
+    ///
+    /// - Throws: The same errors as ``generateImage(prompt:negativePrompt:config:onProgress:)``.
+    public func generateImages(
+        prompt: String,
+        negativePrompt: String? = nil,
+        count: Int,
+        config: ImageGenerationConfig = .default,
+        onProgress: (@Sendable (ImageGenerationProgress) -> Void)? = nil
+    ) async throws -> [GeneratedImage] {
+        let rasters = try await generateRasterImages(
+            prompt: prompt,
+            negativePrompt: negativePrompt,
+            count: count,
+            config: config,
+            onProgress: onProgress
+        )
+        return try rasters.map(encodePNG)
+    }
+
+    /// Generates images as uncompressed RGB pixels, without PNG encoding.
+    ///
+    /// The returned ``RasterImage`` values share the decoder's output buffer,
+    /// which the CPU reads directly on Apple Silicon, so no pixel data is
+    /// copied or compressed. Use this when the images are displayed or
+    /// post-processed in memory.
+    ///
+    /// ```swift
+    /// let rasters = try await provider.generateRasterImages(prompt: "A koi pond")
+    /// let cgImage = rasters[0].cgImage
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - prompt: Text description of the desired images (must be non-empty).
+    ///   - negativePrompt: Optional text describing what to avoid.
+    ///   - count: Number of images to generate (must be positive). Default: 1
+    ///   - config: Image generation configuration applied to every image.
+    ///   - onProgress: Optional callback invoked after each denoising step of
+    ///     each pass. Steps are counted across all passes.
+    ///
+    /// - Returns: `count` raster images.
+    ///
+    /// - Throws: The same errors as ``generateImage(prompt:negativePrompt:config:onProgress:)``,
+    ///   and `AIError.invalidInput` if `count` is not positive.
+    public func generateRasterImages(
+        prompt: String,
+        negativePrompt: String? = nil,
+        count: Int = 1,
+        config: ImageGenerationConfig = .default,
+        onProgress: (@Sendable (ImageGenerationProgress) -> Void)? = nil
+    ) async throws -> [RasterImage] {
         // 1. Check for task cancellation at start
         try Task.checkCancellation()
 
@@ -198,11 +286,14 @@ public actor MLXImageProvider: ImageGenerator {
             throw AIError.modelNotLoaded("No diffusion model loaded. Call loadModel() first.")
         }
 
-        // 5. Prompt validation
+        // 5. Prompt and count validation
         let trimmedPrompt = prompt.trimmingCharacters(in: .whitespacesAndNewlines)
         guard !trimmedPrompt.isEmpty else {
             throw AIError.invalidInput("Prompt cannot be empty")
         }
+        guard count > 0 else {
+            throw AIError.invalidInput("Image count must be positive, got \(count)")
+        }
 
         // 6. Determine generation parameters
         let steps = config.steps ?? variant.defaultSteps
@@ -222,102 +313,45 @@ public actor MLXImageProvider: ImageGenerator {
         isCancelled = false
         let startTime = Date()
 
-        // Calculate latent size (image size / 8 for VAE encoding)
-        let latentWidth = width / 8
-        let latentHeight = height / 8
-
-        // 9. Create evaluation parameters
-        let evaluateParams = EvaluateParameters(
-            cfgWeight: guidance,
-            steps: steps,
-            imageCount: 1,
-            decodingBatchSize: 1,
-            latentSize: [latentHeight, latentWidth],
-            seed: UInt64.random(in: 0...UInt64.max),
-            prompt: trimmedPrompt,
-            negativePrompt: negativePrompt ?? ""
-        )
+        // 9. Split the images into passes that fit the memory budget
+        let batchSize = min(count, maxBatchSize(width: width, height: height))
+        let passCount = (count + batchSize - 1) / batchSize
 
         do {
-            // 10. Generate latents with progress tracking
-            // Capture cancellation state before entering Sendable closure
-            let wasCancelled = isCancelled
-
-            let (finalLatent, totalSteps) = try await container.perform { generator in
-                // Ensure cleanup happens on all exit paths (cancellation, error, success)
-                defer {
-                    // Clean up GPU resources if cancelled or errored
-                    if Task.isCancelled || wasCancelled {
-                        #if arch(arm64)
-                        MLX.GPU.clearCache()
-                        #endif
-                    }
-                }
-
-                // Ensure model is loaded
-                generator.ensureLoaded()
-
-                // Generate latents through denoising iterations
-                var latentIterator = generator.generateLatents(parameters: evaluateParams)
-                var finalLatent: MLXArray?
-                var currentStep = 0
-                let totalSteps = latentIterator.underestimatedCount
-
-                while let latent = latentIterator.next() {
-                    currentStep += 1
-                    finalLatent = latent
-
-                    // Report progress
-                    let elapsed = Date().timeIntervalSince(startTime)
-                    let progress = ImageGenerationProgress(
-                        currentStep: currentStep,
-                        totalSteps: totalSteps,
-                        elapsedTime: elapsed
-                    )
-                    onProgress?(progress)
-
-                    // Evaluate to prevent graph buildup
-                    eval(latent)
-                }
-
-                guard let latent = finalLatent else {
-                    throw AIError.generationFailed(
-                        underlying: SendableError(
-                            localizedDescription: "No latent generated"
-                        )
-                    )
-                }
-
-                // Return evaluated latent and total steps
-                return (latent, totalSteps)
-            }
-
-            // 11. Check for cancellation after expensive latent generation
-            try Task.checkCancellation()
-            if isCancelled {
-                cleanupGPUResources()
-                throw AIError.cancelled
-            }
-
-            // 12. Decode the latent to an image
-            let decoded = try await container.perform { generator in
-                let decoder = generator.detachedDecoder()
-                let result = decoder(finalLatent)
-                eval(result)
-                return result
-            }
+            var rasters: [RasterImage] = []
+            rasters.reserveCapacity(count)
+            var totalSteps = 0
+
+            for pass in 0..<passCount {
+                let imageCount = min(batchSize, count - rasters.count)
+
+                // Latent size is image size / 8 for VAE encoding
+                let parameters = EvaluateParameters(
+                    cfgWeight: guidance,
+                    steps: steps,
+                    imageCount: imageCount,
+                    decodingBatchSize: imageCount,
+                    latentSize: [height / 8, width / 8],
+                    seed: UInt64.random(in: 0...UInt64.max),
+                    prompt: trimmedPrompt,
+                    negativePrompt: negativePrompt ?? ""
+                )
 
-            // 13. Check for cancellation after decoding
-            try Task.checkCancellation()
-            if isCancelled {
-                cleanupGPUResources()
-                throw AIError.cancelled
+                let result = try await runPass(
+                    container: container,
+                    parameters: parameters,
+                    width: width,
+                    height: height,
+                    pass: pass,
+                    passCount: passCount,
+                    startTime: startTime,
+                    onProgress: onProgress
+                )
+                rasters.append(contentsOf: result.rasters)
+                totalSteps = result.totalSteps
             }
 
-            // 14. Convert MLXArray to PNG data
-            let pngData = try convertToPNG(decoded, width: width, height: height)
-
-            // 15. Report completion
+            // 10. Report completion
             let totalTime = Date().timeIntervalSince(startTime)
             let completionProgress = ImageGenerationProgress.completed(
                 totalSteps: totalSteps,
@@ -325,7 +359,7 @@ public actor MLXImageProvider: ImageGenerator {
             )
             onProgress?(completionProgress)
 
-            return GeneratedImage(data: pngData, format: .png)
+            return rasters
 
         } catch is CancellationError {
             cleanupGPUResources()
@@ -575,6 +609,10 @@ public actor MLXImageProvider: ImageGenerator {
     /// - 256MB cache limit
     /// - No explicit GPU memory limit
     ///
+    /// The limit is also recorded as the budget batched generation sizes its
+    /// passes against; without an explicit limit, three quarters of device
+    /// RAM is used.
+    ///
     /// This method should be called once during model loading, not on every generation.
     private func configureMemoryLimits() {
         #if arch(arm64)
@@ -582,11 +620,14 @@ public actor MLXImageProvider: ImageGenerator {
 
         if physicalMemory <= 8 * 1024 * 1024 * 1024 {
             // Low memory device (≤8GB)
+            let memoryLimit = 3 * 1024 * 1024 * 1024
             MLX.GPU.set(cacheLimit: 1 * 1024 * 1024)           // 1MB cache
-            MLX.GPU.set(memoryLimit: 3 * 1024 * 1024 * 1024)   // 3GB limit
+            MLX.GPU.set(memoryLimit: memoryLimit)              // 3GB limit
+            generationMemoryLimit = memoryLimit
         } else {
             // High memory device (>8GB)
             MLX.GPU.set(cacheLimit: 256 * 1024 * 1024)         // 256MB cache
+            generationMemoryLimit = Int(physicalMemory / 4 * 3)
         }
         #endif
     }
@@ -713,90 +754,149 @@ public actor MLXImageProvider: ImageGenerator {
         }
     }
 
-    /// Converts an MLXArray to PNG data.
-    ///
-    /// The array is expected to be in RGB format with shape [height, width, 3]
-    /// and values in the range [0.0, 1.0] (normalized).
-    ///
-    /// - Parameters:
-    ///   - array: The MLX array containing normalized image data.
-    ///   - width: Image width in pixels.
-    ///   - height: Image height in pixels.
-    ///
-    /// - Returns: PNG-encoded image data.
-    ///
-    /// - Throws: `AIError.generationFailed` if conversion fails.
-    private func convertToPNG(_ array: MLXArray, width: Int, height: Int) throws -> Data {
-        // Convert from [0.0, 1.0] to [0, 255] and extract as UInt8 data
-        let scaledArray = array * 255.0
-        let uint8Array = scaledArray.asType(UInt8.self)
-        eval(uint8Array)
-
-        // Get raw data from MLXArray
-        // The array should be in [height, width, 3] format for RGB
-        let mlxData = uint8Array.asData()
-        let data = mlxData.data
-
-        // Create CGImage from raw bytes
-        guard let provider = CGDataProvider(data: data as CFData) else {
-            throw AIError.generationFailed(
-                underlying: SendableError(
-                    localizedDescription: "Failed to create image data provider"
+    /// Denoises and decodes one batch of images.
+    ///
+    /// Progress steps are offset by `pass` so they count up across all
+    /// passes of a batched request.
+    ///
+    /// - Returns: The decoded images and the step count across all passes.
+    private func runPass(
+        container: ModelContainer<TextToImageGenerator>,
+        parameters: EvaluateParameters,
+        width: Int,
+        height: Int,
+        pass: Int,
+        passCount: Int,
+        startTime: Date,
+        onProgress: (@Sendable (ImageGenerationProgress) -> Void)?
+    ) async throws -> (rasters: [RasterImage], totalSteps: Int) {
+        // Capture cancellation state before entering Sendable closure
+        let wasCancelled = isCancelled
+
+        let (finalLatent, totalSteps) = try await container.perform { generator in
+            // Ensure cleanup happens on all exit paths (cancellation, error, success)
+            defer {
+                // Clean up GPU resources if cancelled or errored
+                if Task.isCancelled || wasCancelled {
+                    #if arch(arm64)
+                    MLX.GPU.clearCache()
+                    #endif
+                }
+            }
+
+            // Ensure model is loaded
+            generator.ensureLoaded()
+
+            // Generate latents through denoising iterations
+            var latentIterator = generator.generateLatents(parameters: parameters)
+            var finalLatent: MLXArray?
+            let passSteps = latentIterator.underestimatedCount
+            let totalSteps = passSteps * passCount
+            var currentStep = passSteps * pass
+
+            while let latent = latentIterator.next() {
+                currentStep += 1
+                finalLatent = latent
+
+                // Report progress
+                let elapsed = Date().timeIntervalSince(startTime)
+                let progress = ImageGenerationProgress(
+                    currentStep: currentStep,
+                    totalSteps: totalSteps,
+                    elapsedTime: elapsed
                 )
-            )
-        }
+                onProgress?(progress)
 
-        let colorSpace = CGColorSpaceCreateDeviceRGB()
-        let bitmapInfo = CGBitmapInfo(rawValue: CGImageAlphaInfo.none.rawValue)
-
-        guard let cgImage = CGImage(
-            width: width,
-            height: height,
-            bitsPerComponent: 8,
-            bitsPerPixel: 24,
-            bytesPerRow: width * 3,
-            space: colorSpace,
-            bitmapInfo: bitmapInfo,
-            provider: provider,
-            decode: nil,
-            shouldInterpolate: true,
-            intent: .defaultIntent
-        ) else {
-            throw AIError.generationFailed(
-                underlying: SendableError(
-                    localizedDescription: "Failed to create CGImage"
+                // Evaluate to prevent graph buildup
+                eval(latent)
+            }
+
+            guard let latent = finalLatent else {
+                throw AIError.generationFailed(
+                    underlying: SendableError(
+                        localizedDescription: "No latent generated"
+                    )
                 )
-            )
+            }
+
+            // Return evaluated latent and total steps
+            return (latent, totalSteps)
         }
 
-        // Convert to PNG data using platform-specific APIs
-        #if os(iOS) || os(visionOS)
-        let uiImage = UIImage(cgImage: cgImage)
-        guard let pngData = uiImage.pngData() else {
-            throw AIError.generationFailed(
-                underlying: SendableError(
-                    localizedDescription: "Failed to encode PNG"
+        // Check for cancellation after expensive latent generation
+        try Task.checkCancellation()
+        if isCancelled {
+            cleanupGPUResources()
+            throw AIError.cancelled
+        }
+
+        // Decode the whole batch at once and convert it to bytes on the GPU,
+        // then hand each image's slice of the buffer out without copying
+        let imageCount = parameters.imageCount
+        let rasters = try await container.perform { generator in
+            let decoder = generator.detachedDecoder()
+            let decoded = decoder(finalLatent)
+            let pixels = (decoded * 255.0).asType(UInt8.self)
+            eval(pixels)
+
+            guard pixels.shape == [imageCount, height, width, RasterImage.bytesPerPixel] else {
+                throw AIError.generationFailed(
+                    underlying: SendableError(
+                        localizedDescription: "Unexpected decoded image shape \(pixels.shape)"
+                    )
                 )
-            )
+            }
+            return (0..<imageCount).map { index in
+                RasterImage(
+                    width: width,
+                    height: height,
+                    pixels: pixels[index].asData(access: .noCopyIfContiguous).data
+                )
+            }
         }
-        return pngData
 
-        #elseif os(macOS)
-        let nsImage = NSImage(cgImage: cgImage, size: NSSize(width: width, height: height))
-        guard let tiffData = nsImage.tiffRepresentation,
-              let bitmap = NSBitmapImageRep(data: tiffData),
-              let pngData = bitmap.representation(using: NSBitmapImageRep.FileType.png, properties: [:]) else {
+        // Check for cancellation after decoding
+        try Task.checkCancellation()
+        if isCancelled {
+            cleanupGPUResources()
+            throw AIError.cancelled
+        }
+
+        return (rasters, totalSteps)
+    }
+
+    /// The number of images one denoising pass can hold within the memory
+    /// budget recorded by `configureMemoryLimits()`, after the loaded
+    /// weights are accounted for. Always at least 1.
+    private func maxBatchSize(width: Int, height: Int) -> Int {
+        #if arch(arm64)
+        let limit = generationMemoryLimit ?? Int(ProcessInfo.processInfo.physicalMemory / 4 * 3)
+        let available = limit - MLX.GPU.activeMemory
+        return max(1, available / Self.estimatedBytesPerImage(width: width, height: height))
+        #else
+        return 1
+        #endif
+    }
+
+    /// Rough peak GPU memory for one image, dominated by the VAE decoder's
+    /// full-resolution activations: about 128MB at 512x512.
+    private static func estimatedBytesPerImage(width: Int, height: Int) -> Int {
+        width * height * 512
+    }
+
+    /// Encodes a raster image as a PNG ``GeneratedImage``.
+    ///
+    /// - Throws: `AIError.generationFailed` if encoding fails.
+    private nonisolated func encodePNG(_ raster: RasterImage) throws -> GeneratedImage {
+        do {
+            return try raster.generatedImage()
+        } catch {
             throw AIError.generationFailed(
                 underlying: SendableError(
                     localizedDescription: "Failed to encode PNG"
                 )
             )
         }
-        return pngData
-
-        #else
-        throw AIError.unsupportedPlatform("Image encoding not supported on this platform")
-        #endif
     }
 }
 #endif // CONDUIT_TRAIT_MLX && canImport(MLX) && canImport(StableDiffusion)
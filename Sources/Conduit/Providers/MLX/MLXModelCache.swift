@@ -46,15 +46,19 @@ struct CacheStats: Sendable {
 
 // MARK: - MLXModelCache
 
-/// Actor for caching loaded MLX models with NSCache-based lifecycle management.
+/// Actor that keeps loaded MLX models resident within memory limits.
 ///
-/// Provides automatic memory management using NSCache's built-in eviction policies
-/// while maintaining parallel tracking for statistics and cache queries.
+/// Records each model's measured footprint and load time, evicts by LRU
+/// weighted by reload cost (see ``MLXResidencyPolicy``), releases idle
+/// models when the operating system reports memory pressure, and tracks
+/// time-to-first-token so the cost of switching models is visible.
 ///
 /// ## Features
-/// - **Automatic Eviction**: NSCache handles memory pressure automatically
-/// - **Size Limits**: Configure max cached models and total memory usage
-/// - **Statistics**: Track cache hits, memory usage, and active models
+/// - **Measured Footprints**: Sizes are the loaded weights' byte counts
+/// - **Cost-Weighted Eviction**: Models that reload quickly are evicted before slow ones
+/// - **Memory Pressure**: Idle models are released on OS memory warnings
+/// - **Prefetch Prediction**: Remembers which model usually follows which
+/// - **Statistics**: ``cacheStats()`` for contents, ``residencyStats()`` for history and latency
 /// - **Thread-Safe**: Actor isolation ensures safe concurrent access
 ///
 /// ## Usage
@@ -62,11 +66,11 @@ struct CacheStats: Sendable {
 /// let cache = MLXModelCache.shared
 ///
 /// // Cache a model
-/// let model = CachedModel(container: container, capabilities: caps, weightsSize: .gigabytes(2))
+/// let model = CachedModel(container: container, capabilities: caps, weightsSize: .gigabytes(2), loadDuration: 4.2)
 /// await cache.set(model, forKey: "llama-3.2-1B")
 ///
-/// // Retrieve a model
-/// if let cached = await cache.get("llama-3.2-1B") {
+/// // Retrieve a model for a request
+/// if let cached = await cache.checkout("llama-3.2-1B") {
 ///     print("Cache hit!")
 /// }
 ///
@@ -105,48 +109,104 @@ actor MLXModelCache {
         /// Size of model weights in memory
         let weightsSize: ByteCount
 
-        init(container: ModelContainer, capabilities: ModelCapabilities, weightsSize: ByteCount) {
+        /// Seconds it took to load the weights, used as the reload cost
+        let loadDuration: TimeInterval
+
+        init(
+            container: ModelContainer,
+            capabilities: ModelCapabilities,
+            weightsSize: ByteCount,
+            loadDuration: TimeInterval = 0
+        ) {
             self.container = container
             self.capabilities = capabilities
             self.loadedAt = Date()
             self.weightsSize = weightsSize
+            self.loadDuration = loadDuration
         }
     }
 
     // MARK: - Properties
 
-    /// Thread-safe wrapper around NSCache
-    ///
-    /// Using `SendableNSCache` which provides `@unchecked Sendable` conformance
-    /// for safe actor usage. As an immutable `let` property with a Sendable type,
-    /// this can be safely accessed without `nonisolated(unsafe)`.
-    private let cacheWrapper = SendableNSCache<NSString, CachedModel>()
+    /// A loaded model and its eviction state.
+    private struct Resident {
+        let model: CachedModel
+        var priority: Double
+        var lastAccess: UInt64
+
+        /// How the current request found the model, until its first token is recorded
+        var pendingStart: MLXResidencyStartKind?
+
+        /// Whether the model was prefetched and has not been used yet
+        var prefetched: Bool
+    }
+
+    /// Running latency average for one kind of start.
+    private struct LatencyTotal {
+        var total: TimeInterval = 0
+        var count = 0
+
+        var average: TimeInterval? {
+            count > 0 ? total / Double(count) : nil
+        }
+
+        mutating func add(_ latency: TimeInterval) {
+            total += latency
+            count += 1
+        }
+    }
+
+    /// History that outlives a model's residency.
+    private struct Profile {
+        var footprint = ByteCount(0)
+        var generationFootprint: ByteCount?
+        var loads = 0
+        var hits = 0
+        var evictions = 0
+        var totalLoadTime: TimeInterval = 0
+        var latency: [MLXResidencyStartKind: LatencyTotal] = [:]
+        var lastAccess: UInt64 = 0
+    }
+
+    /// Models currently loaded, keyed by model ID
+    private var residents: [String: Resident] = [:]
 
-    /// Convenience accessor for the underlying cache
-    private var cache: NSCache<NSString, CachedModel> { cacheWrapper.cache }
+    /// Footprint, load and latency history per model ID
+    private var profiles: [String: Profile] = [:]
 
-    /// Tracks cached model IDs (NSCache doesn't provide enumeration)
-    private var cachedModelIds: Set<String> = []
+    /// How often each model was followed by each other model
+    private var transitions: [String: [String: Int]] = [:]
 
-    /// Tracks memory usage per model for statistics
-    private var modelSizes: [String: ByteCount] = [:]
+    /// Latency across all models, per kind of start
+    private var latency: [MLXResidencyStartKind: LatencyTotal] = [:]
 
     /// Currently active model ID
     private var currentModelId: String?
 
-    /// Cache eviction delegate
-    private let delegate: CacheDelegate
+    /// Monotonic access counter used to break priority ties by recency
+    private var clock: UInt64 = 0
 
-    /// NSCache delegate for handling eviction notifications
-    private final class CacheDelegate: NSObject, NSCacheDelegate, @unchecked Sendable {
-        /// Optional callback when NSCache evicts an object
-        var onEviction: ((String) -> Void)?
+    /// GreedyDual inflation: the priority of the most recent eviction
+    private var inflation: Double = 0
 
-        func cache(_ cache: NSCache<AnyObject, AnyObject>, willEvictObject obj: Any) {
-            // NSCache eviction callback - we'll clean up tracking asynchronously
-            // Actual cleanup happens in get() when we detect the model is gone
-        }
-    }
+    /// Maximum resident models (0 = unlimited)
+    private var countLimit: Int
+
+    /// Explicit byte limit, if configured
+    private var byteLimit: Int64?
+
+    /// Byte budget used when no explicit limit is configured
+    private let defaultByteBudget: Int64
+
+    /// Operating-system memory-pressure listener, started with the first model
+    private var pressureMonitor: MLXMemoryPressureMonitor?
+
+    private var hits = 0
+    private var misses = 0
+    private var evictions = 0
+    private var pressureEvents = 0
+    private var prefetches = 0
+    private var prefetchHits = 0
 
     // MARK: - Configuration
 
@@ -157,10 +217,11 @@ actor MLXModelCache {
         /// Maximum number of models to keep in cache
         var maxCachedModels: Int
 
-        /// Maximum total memory for cached models (nil = unlimited)
+        /// Maximum total memory for cached models
+        /// (nil = 60% of physical memory, see ``MLXResidencyPolicy/defaultByteBudget(for:)``)
         var maxCacheSize: ByteCount?
 
-        /// Default configuration: 3 models, no size limit
+        /// Default configuration: 3 models, device-derived size limit
         static let `default` = Configuration(maxCachedModels: 3, maxCacheSize: nil)
 
         /// Low memory configuration: 1 model, 4GB limit
@@ -176,61 +237,123 @@ actor MLXModelCache {
 
     /// Initialize a new cache with the given configuration.
     ///
-    /// - Parameter configuration: Cache size and eviction settings
+    /// - Parameters:
+    ///   - configuration: Cache size and eviction settings
+    ///   - device: Hardware used to derive the default byte budget
     ///
     /// - Important: This is `internal` to allow unit tests to create isolated
     /// caches without mutating the process-global `shared` singleton.
-    internal init(configuration: Configuration = .default) {
-        self.delegate = CacheDelegate()
-        cacheWrapper.cache.delegate = delegate
-        cacheWrapper.cache.countLimit = configuration.maxCachedModels
-        if let maxSize = configuration.maxCacheSize {
-            cacheWrapper.cache.totalCostLimit = Int(maxSize.bytes)
+    internal init(configuration: Configuration = .default, device: DeviceCapabilities = .current()) {
+        self.countLimit = max(0, configuration.maxCachedModels)
+        if let maxSize = configuration.maxCacheSize, maxSize.bytes > 0 {
+            self.byteLimit = maxSize.bytes
         }
+        self.defaultByteBudget = MLXResidencyPolicy.defaultByteBudget(for: device)
     }
 
-    // MARK: - Public Methods
+    // MARK: - Lookup
 
-    /// Retrieves a cached model by ID.
-    ///
-    /// Automatically cleans up tracking if the model was evicted by NSCache.
+    /// Retrieves a cached model by ID without counting it as a request.
     ///
     /// - Parameter modelId: Unique identifier for the model
-    /// - Returns: The cached model, or nil if not found or evicted
+    /// - Returns: The cached model, or nil if not resident
     func get(_ modelId: String) -> CachedModel? {
-        let key = modelId as NSString
-        let model = cache.object(forKey: key)
-        if model == nil {
-            // Model was evicted by NSCache - clean up tracking
-            cachedModelIds.remove(modelId)
-            modelSizes.removeValue(forKey: modelId)
+        residents[modelId]?.model
+    }
+
+    /// Retrieves a cached model for a generation request.
+    ///
+    /// Counts a hit or miss, refreshes the model's eviction priority, and
+    /// notes whether the request is a warm start or a switch from another
+    /// model so its time-to-first-token is grouped correctly.
+    ///
+    /// - Parameter modelId: Unique identifier for the model
+    /// - Returns: The cached model, or nil if it must be loaded
+    func checkout(_ modelId: String) -> CachedModel? {
+        guard var resident = residents[modelId] else {
+            misses += 1
+            return nil
+        }
+        hits += 1
+        if resident.prefetched {
+            prefetchHits += 1
+            resident.prefetched = false
         }
-        return model
+        resident.pendingStart = modelId == currentModelId ? .warm : .switch
+        touch(&resident, forKey: modelId)
+        profiles[modelId, default: Profile()].hits += 1
+        residents[modelId] = resident
+        return resident.model
+    }
+
+    /// The footprint measured the last time a model was loaded, if it ever was.
+    func measuredFootprint(forKey modelId: String) -> ByteCount? {
+        guard let footprint = profiles[modelId]?.footprint, footprint.bytes > 0 else { return nil }
+        return footprint
+    }
+
+    /// Checks if a model is cached.
+    ///
+    /// - Parameter modelId: The model ID to check
+    /// - Returns: true if the model is currently cached
+    func contains(_ modelId: String) -> Bool {
+        residents[modelId] != nil
+    }
+
+    // MARK: - Insertion and Removal
+
+    /// Evicts models ahead of a load so the new weights fit.
+    ///
+    /// Evicting before loading keeps the old and new weights from being
+    /// resident at the same time.
+    ///
+    /// - Parameters:
+    ///   - bytes: Expected footprint of the model about to load
+    ///   - modelId: The model about to load
+    func reserve(_ bytes: ByteCount, forKey modelId: String) {
+        guard residents[modelId] == nil else { return }
+        enforceLimits(additionalModels: 1, additionalBytes: bytes.bytes, protecting: nil)
     }
 
     /// Caches a model with the given ID.
     ///
-    /// The model's weight size is used as the cost for NSCache eviction.
-    /// NSCache may automatically evict older models if limits are exceeded.
+    /// The model's measured size and load duration set its eviction priority.
+    /// Other models are evicted if limits are exceeded.
     ///
     /// - Parameters:
     ///   - model: The cached model container
     ///   - modelId: Unique identifier for the model
-    func set(_ model: CachedModel, forKey modelId: String) {
-        let key = modelId as NSString
-        cache.setObject(model, forKey: key, cost: Int(model.weightsSize.bytes))
-        cachedModelIds.insert(modelId)
-        modelSizes[modelId] = model.weightsSize
+    ///   - prefetched: Whether the model was loaded speculatively rather than for a request
+    func set(_ model: CachedModel, forKey modelId: String, prefetched: Bool = false) {
+        startMonitoringMemoryPressure()
+
+        var profile = profiles[modelId, default: Profile()]
+        profile.footprint = model.weightsSize
+        profile.loads += 1
+        profile.totalLoadTime += model.loadDuration
+        profiles[modelId] = profile
+
+        var resident = Resident(
+            model: model,
+            priority: 0,
+            lastAccess: 0,
+            pendingStart: prefetched ? nil : .cold,
+            prefetched: prefetched
+        )
+        touch(&resident, forKey: modelId)
+        residents[modelId] = resident
+        if prefetched {
+            prefetches += 1
+        }
+
+        enforceLimits(protecting: prefetched ? currentModelId : modelId)
     }
 
     /// Removes a model from the cache.
     ///
     /// - Parameter modelId: The model ID to remove
     func remove(_ modelId: String) {
-        let key = modelId as NSString
-        cache.removeObject(forKey: key)
-        cachedModelIds.remove(modelId)
-        modelSizes.removeValue(forKey: modelId)
+        residents.removeValue(forKey: modelId)
         if currentModelId == modelId {
             currentModelId = nil
         }
@@ -238,32 +361,13 @@ actor MLXModelCache {
 
     /// Removes all models from the cache.
     ///
-    /// Clears both the NSCache and all tracking structures.
+    /// Residency history is kept so footprints and latencies remain available.
     func removeAll() {
-        cache.removeAllObjects()
-        cachedModelIds.removeAll()
-        modelSizes.removeAll()
+        residents.removeAll()
         currentModelId = nil
     }
 
-    /// Checks if a model is cached.
-    ///
-    /// Verifies the model is actually still in NSCache, not just in tracking.
-    /// Automatically cleans up stale tracking if the model was evicted.
-    ///
-    /// - Parameter modelId: The model ID to check
-    /// - Returns: true if the model is currently cached
-    func contains(_ modelId: String) -> Bool {
-        // Verify it's actually still in cache (may have been evicted)
-        let key = modelId as NSString
-        if cache.object(forKey: key) != nil {
-            return true
-        }
-        // Clean up tracking if evicted
-        cachedModelIds.remove(modelId)
-        modelSizes.removeValue(forKey: modelId)
-        return false
-    }
+    // MARK: - Statistics
 
     /// Returns current cache statistics.
     ///
@@ -272,23 +376,73 @@ actor MLXModelCache {
     ///
     /// - Returns: Cache statistics structure
     func cacheStats() -> CacheStats {
-        let totalMemory = modelSizes.values.reduce(ByteCount(0)) {
-            ByteCount($0.bytes + $1.bytes)
-        }
-        return CacheStats(
-            cachedModelCount: cachedModelIds.count,
-            totalMemoryUsage: totalMemory,
+        CacheStats(
+            cachedModelCount: residents.count,
+            totalMemoryUsage: ByteCount(residentBytes),
             currentModelId: currentModelId,
-            modelIds: Array(cachedModelIds)
+            modelIds: Array(residents.keys)
+        )
+    }
+
+    /// Returns residency history, eviction counts and time-to-first-token by kind of start.
+    func residencyStats() -> MLXResidencyStats {
+        let models = profiles
+            .sorted { $0.value.lastAccess > $1.value.lastAccess }
+            .map { id, profile in
+                MLXResidencyStats.Model(
+                    id: id,
+                    isResident: residents[id] != nil,
+                    footprint: profile.footprint,
+                    generationFootprint: profile.generationFootprint,
+                    loads: profile.loads,
+                    hits: profile.hits,
+                    evictions: profile.evictions,
+                    averageLoadTime: profile.loads > 0 ? profile.totalLoadTime / Double(profile.loads) : nil,
+                    coldStartTimeToFirstToken: profile.latency[.cold]?.average,
+                    switchTimeToFirstToken: profile.latency[.switch]?.average,
+                    warmTimeToFirstToken: profile.latency[.warm]?.average
+                )
+            }
+        return MLXResidencyStats(
+            hits: hits,
+            misses: misses,
+            evictions: evictions,
+            memoryPressureEvents: pressureEvents,
+            prefetches: prefetches,
+            prefetchHits: prefetchHits,
+            residentBytes: ByteCount(residentBytes),
+            byteBudget: ByteCount(byteBudget),
+            coldStartTimeToFirstToken: latency[.cold]?.average,
+            switchTimeToFirstToken: latency[.switch]?.average,
+            warmTimeToFirstToken: latency[.warm]?.average,
+            models: models
         )
     }
 
+    /// Records the time to first token of the request currently using a model.
+    ///
+    /// Only the first call after a checkout or load counts.
+    func recordFirstToken(forKey modelId: String, latency seconds: TimeInterval) {
+        guard let kind = residents[modelId]?.pendingStart else { return }
+        residents[modelId]?.pendingStart = nil
+        latency[kind, default: LatencyTotal()].add(seconds)
+        profiles[modelId, default: Profile()].latency[kind, default: LatencyTotal()].add(seconds)
+    }
+
+    /// Records the peak memory a generation used above the model's weights.
+    func recordGenerationFootprint(forKey modelId: String, bytes: ByteCount) {
+        profiles[modelId]?.generationFootprint = bytes
+    }
+
     /// Sets the currently active model ID.
     ///
-    /// Used to track which model is currently in use for statistics.
+    /// Also records the switch from the previous model, which drives prefetch prediction.
     ///
     /// - Parameter modelId: The model ID to mark as active, or nil to clear
     func setCurrentModel(_ modelId: String?) {
+        if let previous = currentModelId, let modelId, previous != modelId {
+            transitions[previous, default: [:]][modelId, default: 0] += 1
+        }
         currentModelId = modelId
     }
 
@@ -299,34 +453,148 @@ actor MLXModelCache {
         currentModelId
     }
 
+    // MARK: - Prefetch
+
+    /// The model most likely to be requested after `modelId`, if it is worth loading now.
+    ///
+    /// A model qualifies when it has followed `modelId` at least twice, is
+    /// not resident, has a measured footprint, and fits without evicting
+    /// anything while leaving the device headroom.
+    ///
+    /// - Parameters:
+    ///   - modelId: The model that was just used
+    ///   - device: Current hardware state. Default: ``DeviceCapabilities/current()``
+    func prefetchCandidate(
+        after modelId: String,
+        device: DeviceCapabilities = .current()
+    ) -> String? {
+        guard countLimit == 0 || residents.count < countLimit else { return nil }
+        let successors = (transitions[modelId] ?? [:])
+            .filter { $0.value >= 2 && residents[$0.key] == nil }
+            .sorted { ($0.value, $1.key) > ($1.value, $0.key) }
+
+        for (candidate, _) in successors {
+            guard let footprint = measuredFootprint(forKey: candidate) else { continue }
+            if MLXResidencyPolicy.canPrefetch(
+                bytes: footprint.bytes,
+                residentBytes: residentBytes,
+                byteBudget: byteBudget,
+                device: device
+            ) {
+                return candidate
+            }
+        }
+        return nil
+    }
+
+    // MARK: - Memory Pressure
+
+    /// Releases models in response to an operating-system memory-pressure event.
+    ///
+    /// A warning evicts idle models until resident weights are within half
+    /// the byte budget; a critical event evicts every model except the one
+    /// in use. Both release MLX's buffer cache.
+    func handleMemoryPressure(_ level: MLXMemoryPressureLevel) {
+        pressureEvents += 1
+        switch level {
+        case .warning:
+            enforceLimits(byteLimit: byteBudget / 2, protecting: currentModelId)
+        case .critical:
+            for key in residents.keys where key != currentModelId {
+                evict(key)
+            }
+        }
+        #if arch(arm64)
+        MLX.GPU.clearCache()
+        #endif
+    }
+
+    private func startMonitoringMemoryPressure() {
+        guard pressureMonitor == nil else { return }
+        pressureMonitor = MLXMemoryPressureMonitor { [weak self] level in
+            Task { await self?.handleMemoryPressure(level) }
+        }
+    }
+
+    // MARK: - Eviction
+
+    /// The byte limit resident weights are kept within.
+    private var byteBudget: Int64 {
+        byteLimit ?? defaultByteBudget
+    }
+
+    private var residentBytes: Int64 {
+        residents.values.reduce(0) { $0 + $1.model.weightsSize.bytes }
+    }
+
+    /// Marks a model as just used and refreshes its GreedyDual priority.
+    private func touch(_ resident: inout Resident, forKey modelId: String) {
+        clock += 1
+        resident.lastAccess = clock
+        resident.priority = MLXResidencyPolicy.priority(
+            inflation: inflation,
+            reloadSeconds: resident.model.loadDuration,
+            bytes: resident.model.weightsSize.bytes
+        )
+        profiles[modelId, default: Profile()].lastAccess = clock
+    }
+
+    private func enforceLimits(
+        byteLimit: Int64? = nil,
+        additionalModels: Int = 0,
+        additionalBytes: Int64 = 0,
+        protecting: String?
+    ) {
+        let candidates = residents.map { key, resident in
+            MLXResidencyPolicy.Candidate(
+                key: key,
+                bytes: resident.model.weightsSize.bytes,
+                priority: resident.priority,
+                lastAccess: resident.lastAccess
+            )
+        }
+        let victims = MLXResidencyPolicy.victims(
+            among: candidates,
+            countLimit: countLimit,
+            byteLimit: byteLimit ?? byteBudget,
+            additionalModels: additionalModels,
+            additionalBytes: additionalBytes,
+            protecting: protecting
+        )
+        for key in victims {
+            evict(key)
+        }
+    }
+
+    private func evict(_ modelId: String) {
+        guard let resident = residents.removeValue(forKey: modelId) else { return }
+        inflation = max(inflation, resident.priority)
+        evictions += 1
+        profiles[modelId, default: Profile()].evictions += 1
+        if currentModelId == modelId {
+            currentModelId = nil
+        }
+    }
+
     // MARK: - Test Hooks
 
     /// Apply a cache configuration.
+    ///
+    /// Limits only ever tighten, so several providers sharing the cache
+    /// settle on the strictest configuration.
     internal func apply(configuration: Configuration) {
-        let currentCountLimit = cache.countLimit
         let newCountLimit = max(1, configuration.maxCachedModels)
-
-        if currentCountLimit == 0 {
-            cache.countLimit = newCountLimit
-        } else {
-            cache.countLimit = min(currentCountLimit, newCountLimit)
-        }
+        countLimit = countLimit == 0 ? newCountLimit : min(countLimit, newCountLimit)
 
         if let maxSize = configuration.maxCacheSize, maxSize.bytes > 0 {
-            let newCostLimit = Int(maxSize.bytes)
-            let currentCostLimit = cache.totalCostLimit
-
-            if currentCostLimit == 0 {
-                cache.totalCostLimit = newCostLimit
-            } else {
-                cache.totalCostLimit = min(currentCostLimit, newCostLimit)
-            }
+            byteLimit = min(byteLimit ?? maxSize.bytes, maxSize.bytes)
         }
+        enforceLimits(protecting: currentModelId)
     }
 
-    /// Returns the current underlying NSCache limits for unit tests.
+    /// Returns the current count and byte limits for unit tests (0 = unlimited).
     internal func _testing_limits() -> (countLimit: Int, totalCostLimit: Int) {
-        (cache.countLimit, cache.totalCostLimit)
+        (countLimit, Int(byteLimit ?? 0))
     }
 }
 
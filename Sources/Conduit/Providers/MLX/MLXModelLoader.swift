@@ -15,10 +15,19 @@ import Foundation
 @preconcurrency import Tokenizers
 // Note: Tokenizer protocol is re-exported through MLXLMCommon
 
+/// Fetches Hub snapshots with Conduit's ranged downloader.
+///
+/// Weight files download over several connections, resume from partial
+/// files, and are checked against the Hub's LFS digests as they arrive.
+/// Files already in the Hugging Face Hub cache are linked, not downloaded.
+/// When the repository cannot be listed, such as when offline, the
+/// snapshot comes from the Hugging Face cache instead.
 private struct MLXHuggingFaceDownloader: MLXLMCommon.Downloader {
+    private let snapshots: HFSnapshotDownloader
     private let hubClient: HuggingFace.HubClient
 
-    init(hubClient: HuggingFace.HubClient = HuggingFace.HubClient()) {
+    init(downloader: RangedDownloader = .shared, hubClient: HuggingFace.HubClient = HuggingFace.HubClient()) {
+        self.snapshots = HFSnapshotDownloader(downloader: downloader)
         self.hubClient = hubClient
     }
 
@@ -33,21 +42,98 @@ private struct MLXHuggingFaceDownloader: MLXLMCommon.Downloader {
             throw AIError.invalidInput("Invalid Hugging Face repository ID: '\(id)'")
         }
 
-        return try await hubClient.downloadSnapshot(
-            of: repoID,
-            revision: revision ?? "main",
-            matching: patterns,
-            progressHandler: { @MainActor progress in
-                progressHandler(progress)
-            }
-        )
+        let directory: URL
+        do {
+            directory = try await snapshots.download(
+                repoId: id,
+                revision: revision ?? "main",
+                matching: patterns,
+                useLatest: useLatest,
+                progressHandler: progressHandler
+            ).directory
+        } catch is HFSnapshotDownloader.RepositoryUnavailable {
+            directory = try await hubClient.downloadSnapshot(
+                of: repoID,
+                revision: revision ?? "main",
+                matching: patterns,
+                progressHandler: { @MainActor progress in
+                    progressHandler(progress)
+                }
+            )
+        }
+
+        // Start parsing the tokenizer now so it overlaps with the factory's weight load
+        MLXTokenizerStore.shared.prefetch(from: directory)
+        return directory
     }
 }
 
 private struct MLXHuggingFaceTokenizerLoader: MLXLMCommon.TokenizerLoader {
     func load(from directory: URL) async throws -> any MLXLMCommon.Tokenizer {
-        let tokenizer = try await Tokenizers.AutoTokenizer.from(modelFolder: directory)
-        return MLXHuggingFaceTokenizer(tokenizer)
+        try await MLXTokenizerStore.shared.tokenizer(from: directory)
+    }
+}
+
+/// Parses tokenizers once per model directory and shares the result.
+///
+/// Loading starts as soon as a model's directory is known, so tokenizer
+/// parsing overlaps with weight loading instead of following it. Parsed
+/// tokenizers are kept for the most recent directories, so reloading an
+/// evicted model skips the parse.
+private final class MLXTokenizerStore: @unchecked Sendable {
+    static let shared = MLXTokenizerStore()
+
+    /// Number of parsed tokenizers to keep.
+    private let capacity = 4
+
+    private let lock = NSLock()
+    private var tasks: [String: Task<any MLXLMCommon.Tokenizer, Error>] = [:]
+    private var order: [String] = []
+
+    /// Starts loading the tokenizer in `directory` if it is not already loading or loaded.
+    func prefetch(from directory: URL) {
+        _ = task(for: directory)
+    }
+
+    /// The tokenizer in `directory`, joining an in-progress load.
+    func tokenizer(from directory: URL) async throws -> any MLXLMCommon.Tokenizer {
+        let key = directory.standardizedFileURL.path
+        do {
+            return try await task(for: directory).value
+        } catch {
+            withLock {
+                tasks[key] = nil
+                order.removeAll { $0 == key }
+            }
+            throw error
+        }
+    }
+
+    private func task(for directory: URL) -> Task<any MLXLMCommon.Tokenizer, Error> {
+        let key = directory.standardizedFileURL.path
+        return withLock {
+            if let existing = tasks[key] {
+                order.removeAll { $0 == key }
+                order.append(key)
+                return existing
+            }
+            let task = Task<any MLXLMCommon.Tokenizer, Error>(priority: .userInitiated) {
+                let tokenizer = try await Tokenizers.AutoTokenizer.from(modelFolder: directory)
+                return MLXHuggingFaceTokenizer(tokenizer)
+            }
+            tasks[key] = task
+            order.append(key)
+            while order.count > capacity {
+                tasks[order.removeFirst()] = nil
+            }
+            return task
+        }
+    }
+
+    private func withLock<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
     }
 }
 
@@ -140,6 +226,18 @@ internal actor MLXModelLoader {
     /// - Note: This is now managed by MLXModelCache.
     let maxLoadedModels: Int
 
+    /// Fetches Hub snapshots with the configured connection and bandwidth limits.
+    private let downloader: RangedDownloader
+
+    /// Loads in progress, keyed by cache key, so concurrent requests share one load.
+    private var inFlightLoads: [String: (task: Task<ModelContainer, Error>, prefetched: Bool)] = [:]
+
+    /// Identifiers this loader has loaded, so predicted cache keys can be prefetched.
+    private var knownIdentifiers: [String: ModelIdentifier] = [:]
+
+    /// The background prefetch currently running, if any.
+    private var prefetchTask: Task<Void, Never>?
+
     // MARK: - Initialization
 
     /// Creates a model loader with the specified configuration.
@@ -150,6 +248,9 @@ internal actor MLXModelLoader {
     init(configuration: MLXConfiguration = .default, maxLoadedModels: Int = 1) {
         self.configuration = configuration
         self.maxLoadedModels = max(1, maxLoadedModels)
+        self.downloader = configuration.downloadConfiguration == .default
+            ? .shared
+            : RangedDownloader(configuration: configuration.downloadConfiguration)
     }
 
     // MARK: - Model Loading
@@ -159,7 +260,7 @@ internal actor MLXModelLoader {
     ///
     /// If the model is already loaded in memory, returns the cached container
     /// immediately. Otherwise, downloads the model (if needed) and loads it
-    /// into memory.
+    /// into memory. Concurrent requests for the same model share one load.
     ///
     /// This method automatically detects VLM capabilities and routes to the
     /// appropriate factory (VLMModelFactory for vision models, LLMModelFactory
@@ -174,42 +275,100 @@ internal actor MLXModelLoader {
     /// - `AIError.modelNotCached` if download fails
     /// - `AIError.generationFailed` if model loading fails
     func loadModel(identifier: ModelIdentifier) async throws -> ModelContainer {
-        // Validate it's an MLX model (either HF Hub or local path)
-        let (cacheKey, modelConfig): (String, ModelConfiguration)
-
-        switch identifier {
-        case .mlx(let modelId):
-            // HuggingFace Hub model
-            cacheKey = modelId
-            modelConfig = ModelConfiguration(id: modelId)
-
-        case .mlxLocal(let path):
-            // Local filesystem model
-            cacheKey = path
-            let directoryURL = URL(fileURLWithPath: path)
-            modelConfig = ModelConfiguration(directory: directoryURL)
-
-        default:
+        guard let cacheKey = Self.cacheKey(for: identifier) else {
             throw AIError.invalidInput("MLXModelLoader only supports .mlx() and .mlxLocal() model identifiers")
         }
 
         applyRuntimeConfiguration()
-        let downloader = MLXHuggingFaceDownloader()
-        let tokenizerLoader = MLXHuggingFaceTokenizerLoader()
+        knownIdentifiers[cacheKey] = identifier
 
         // Check cache first
-        if let cached = await MLXModelCache.shared.get(cacheKey) {
+        if let cached = await MLXModelCache.shared.checkout(cacheKey) {
             // Set as current model
             await MLXModelCache.shared.setCurrentModel(cacheKey)
+            schedulePrefetch(after: cacheKey)
             return cached.container
         }
 
+        let container = try await sharedLoad(identifier: identifier, cacheKey: cacheKey, prefetched: false)
+        await MLXModelCache.shared.setCurrentModel(cacheKey)
+        schedulePrefetch(after: cacheKey)
+        return container
+    }
+
+    /// Loads a model into the cache without making it current.
+    ///
+    /// Used to prefetch the model predicted to be requested next.
+    ///
+    /// - Parameter identifier: The model identifier to load.
+    func prefetchModel(identifier: ModelIdentifier) async throws {
+        guard let cacheKey = Self.cacheKey(for: identifier),
+              await !MLXModelCache.shared.contains(cacheKey) else {
+            return
+        }
+        _ = try await sharedLoad(identifier: identifier, cacheKey: cacheKey, prefetched: true)
+    }
+
+    /// Joins an in-flight load of `cacheKey` or starts one.
+    private func sharedLoad(
+        identifier: ModelIdentifier,
+        cacheKey: String,
+        prefetched: Bool
+    ) async throws -> ModelContainer {
+        if let inFlight = inFlightLoads[cacheKey] {
+            let container = try await inFlight.task.value
+            if inFlight.prefetched && !prefetched {
+                // A prefetch did the load; count this request as served by it.
+                _ = await MLXModelCache.shared.checkout(cacheKey)
+            }
+            return container
+        }
+
+        let task = Task { [downloader] in
+            try await Self.load(
+                identifier: identifier,
+                cacheKey: cacheKey,
+                prefetched: prefetched,
+                downloader: downloader
+            )
+        }
+        inFlightLoads[cacheKey] = (task, prefetched)
+        defer { inFlightLoads[cacheKey] = nil }
+        return try await task.value
+    }
+
+    /// Loads the weights, measures their footprint and stores them in the cache.
+    private static func load(
+        identifier: ModelIdentifier,
+        cacheKey: String,
+        prefetched: Bool,
+        downloader rangedDownloader: RangedDownloader
+    ) async throws -> ModelContainer {
+        let modelConfig: ModelConfiguration
+        if case .mlxLocal(let path) = identifier {
+            // Local filesystem model; the directory is known, so start the tokenizer now
+            let directory = URL(fileURLWithPath: path)
+            MLXTokenizerStore.shared.prefetch(from: directory)
+            modelConfig = ModelConfiguration(directory: directory)
+        } else {
+            // HuggingFace Hub model
+            modelConfig = ModelConfiguration(id: cacheKey)
+        }
+        let downloader = MLXHuggingFaceDownloader(downloader: rangedDownloader)
+        let tokenizerLoader = MLXHuggingFaceTokenizerLoader()
+
+        // Make room before loading so old and new weights are not resident together
+        let expectedSize = await MLXModelCache.shared.measuredFootprint(forKey: cacheKey)
+            ?? estimateModelSize(modelId: cacheKey)
+        await MLXModelCache.shared.reserve(expectedSize, forKey: cacheKey)
+
         // Detect model capabilities using VLMDetector
         let capabilities = await VLMDetector.shared.detectCapabilities(identifier)
 
         // Load the model using the appropriate factory based on capabilities
         do {
             let container: ModelContainer
+            let start = Date()
 
             if capabilities.supportsVision {
                 // Route to VLMModelFactory for vision-capable models
@@ -235,17 +394,23 @@ internal actor MLXModelLoader {
                 )
             }
 
-            // Estimate model size (rough estimate based on name/path or default to 2GB)
-            let estimatedSize = estimateModelSize(modelId: cacheKey)
+            let loadDuration = Date().timeIntervalSince(start)
+
+            // Sum the loaded parameters rather than diffing the process-wide
+            // allocator, which other loads and generations move at the same time
+            let measured = await container.perform { context in
+                context.model.parameters().flattened().reduce(0) { $0 + $1.1.nbytes }
+            }
+            let weightsSize = measured > 0 ? ByteCount(Int64(measured)) : expectedSize
 
             // Cache the loaded model with its capabilities
             let cachedModel = MLXModelCache.CachedModel(
                 container: container,
                 capabilities: capabilities,
-                weightsSize: estimatedSize
+                weightsSize: weightsSize,
+                loadDuration: loadDuration
             )
-            await MLXModelCache.shared.set(cachedModel, forKey: cacheKey)
-            await MLXModelCache.shared.setCurrentModel(cacheKey)
+            await MLXModelCache.shared.set(cachedModel, forKey: cacheKey, prefetched: prefetched)
 
             return container
 
@@ -253,6 +418,22 @@ internal actor MLXModelLoader {
             throw AIError.generationFailed(underlying: SendableError(error))
         }
     }
+
+    /// Prefetches the model predicted to follow `cacheKey`, when enabled and it fits.
+    private func schedulePrefetch(after cacheKey: String) {
+        guard configuration.prefetchesPredictedModels, prefetchTask == nil else { return }
+        prefetchTask = Task(priority: .background) {
+            if let next = await MLXModelCache.shared.prefetchCandidate(after: cacheKey),
+               let identifier = self.knownIdentifiers[next] {
+                try? await self.prefetchModel(identifier: identifier)
+            }
+            self.finishPrefetch()
+        }
+    }
+
+    private func finishPrefetch() {
+        prefetchTask = nil
+    }
     #endif
 
     /// Applies global MLX runtime settings from the loader configuration.
@@ -264,6 +445,21 @@ internal actor MLXModelLoader {
         MLX.GPU.set(memoryLimit: resolvedLimit)
     }
 
+    /// The cache key for an MLX model identifier.
+    ///
+    /// - Parameter identifier: The model identifier.
+    /// - Returns: The Hugging Face repository ID or local path, or `nil` for non-MLX identifiers.
+    static func cacheKey(for identifier: ModelIdentifier) -> String? {
+        switch identifier {
+        case .mlx(let modelId):
+            return modelId
+        case .mlxLocal(let path):
+            return path
+        default:
+            return nil
+        }
+    }
+
     /// Unloads a specific model from memory.
     ///
     /// Removes the model from the in-memory cache. The model files remain
@@ -271,15 +467,7 @@ internal actor MLXModelLoader {
     ///
     /// - Parameter identifier: The model to unload.
     func unloadModel(identifier: ModelIdentifier) async {
-        let cacheKey: String
-        switch identifier {
-        case .mlx(let modelId):
-            cacheKey = modelId
-        case .mlxLocal(let path):
-            cacheKey = path
-        default:
-            return
-        }
+        guard let cacheKey = Self.cacheKey(for: identifier) else { return }
         await MLXModelCache.shared.remove(cacheKey)
     }
 
@@ -296,15 +484,7 @@ internal actor MLXModelLoader {
     /// - Parameter identifier: The model to check.
     /// - Returns: `true` if the model is loaded, `false` otherwise.
     func isLoaded(_ identifier: ModelIdentifier) async -> Bool {
-        let cacheKey: String
-        switch identifier {
-        case .mlx(let modelId):
-            cacheKey = modelId
-        case .mlxLocal(let path):
-            cacheKey = path
-        default:
-            return false
-        }
+        guard let cacheKey = Self.cacheKey(for: identifier) else { return false }
         return await MLXModelCache.shared.contains(cacheKey)
     }
 
@@ -326,15 +506,7 @@ internal actor MLXModelLoader {
     /// }
     /// ```
     func getCapabilities(_ identifier: ModelIdentifier) async -> ModelCapabilities? {
-        let cacheKey: String
-        switch identifier {
-        case .mlx(let modelId):
-            cacheKey = modelId
-        case .mlxLocal(let path):
-            cacheKey = path
-        default:
-            return nil
-        }
+        guard let cacheKey = Self.cacheKey(for: identifier) else { return nil }
         if let cached = await MLXModelCache.shared.get(cacheKey) {
             return cached.capabilities
         }
@@ -378,12 +550,13 @@ internal actor MLXModelLoader {
     #if arch(arm64)
     /// Estimates model size based on model ID heuristics.
     ///
-    /// This is a rough estimate based on common model naming patterns.
-    /// For more accurate sizes, the actual weights file would need to be inspected.
+    /// This is a rough estimate based on common model naming patterns, used
+    /// to reserve room before a model's first load. Later loads use the
+    /// footprint measured by ``MLXModelCache``.
     ///
     /// - Parameter modelId: The model identifier (repository ID).
     /// - Returns: Estimated model size in bytes.
-    private func estimateModelSize(modelId: String) -> ByteCount {
+    private static func estimateModelSize(modelId: String) -> ByteCount {
         let lowercased = modelId.lowercased()
 
         // Check for size indicators in the model name
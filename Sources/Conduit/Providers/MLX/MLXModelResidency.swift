@@ -0,0 +1,310 @@
+// MLXModelResidency.swift
+// Conduit
+//
+// Eviction policy, memory-pressure monitoring and statistics for resident MLX models.
+
+#if CONDUIT_TRAIT_MLX
+import Foundation
+
+// MARK: - Linux Compatibility
+// NOTE: MLX requires Metal GPU and Apple Silicon. Not available on Linux.
+#if CONDUIT_TRAIT_MLX && canImport(MLX)
+
+@preconcurrency import MLX
+
+// MARK: - MLXResidencyStats
+
+/// A snapshot of how loaded MLX models are using memory and how model
+/// switches affect latency.
+///
+/// Time-to-first-token is measured from the start of a request, so a cold
+/// start includes loading the weights. Requests are grouped by how the
+/// model was found:
+/// - **Cold**: the model was loaded for this request.
+/// - **Switch**: the model was resident but a different model served the previous request.
+/// - **Warm**: the model also served the previous request.
+///
+/// ## Usage
+/// ```swift
+/// let stats = await provider.residencyStats()
+/// print("Cold TTFT: \(stats.coldStartTimeToFirstToken ?? 0)s")
+/// print("Switch TTFT: \(stats.switchTimeToFirstToken ?? 0)s")
+/// for model in stats.models where model.isResident {
+///     print("\(model.id): \(model.footprint.formatted)")
+/// }
+/// ```
+public struct MLXResidencyStats: Sendable, Hashable {
+
+    /// Per-model residency history.
+    public struct Model: Sendable, Hashable {
+        /// The model's cache key (Hugging Face repository ID or local path).
+        public let id: String
+
+        /// Whether the model is currently loaded.
+        public let isResident: Bool
+
+        /// Memory used by the weights, measured when the model was last loaded.
+        public let footprint: ByteCount
+
+        /// Peak additional memory of the most recent generation, covering the
+        /// KV cache and activations, if a generation has been measured.
+        public let generationFootprint: ByteCount?
+
+        /// Number of times the weights were loaded.
+        public let loads: Int
+
+        /// Number of requests served while the model was already resident.
+        public let hits: Int
+
+        /// Number of times the model was evicted.
+        public let evictions: Int
+
+        /// Average time to load the weights, in seconds.
+        public let averageLoadTime: TimeInterval?
+
+        /// Average time to first token after a cold start, in seconds.
+        public let coldStartTimeToFirstToken: TimeInterval?
+
+        /// Average time to first token after switching from another model, in seconds.
+        public let switchTimeToFirstToken: TimeInterval?
+
+        /// Average time to first token when the model served the previous request, in seconds.
+        public let warmTimeToFirstToken: TimeInterval?
+    }
+
+    /// Requests that found their model resident.
+    public let hits: Int
+
+    /// Requests that had to load their model.
+    public let misses: Int
+
+    /// Models evicted to stay within limits or relieve memory pressure.
+    public let evictions: Int
+
+    /// Memory-pressure notifications received from the operating system.
+    public let memoryPressureEvents: Int
+
+    /// Models loaded in the background because they were predicted to be next.
+    public let prefetches: Int
+
+    /// Requests served by a prefetched model before it was first used.
+    public let prefetchHits: Int
+
+    /// Memory currently used by resident model weights.
+    public let residentBytes: ByteCount
+
+    /// The byte budget resident weights are kept within.
+    public let byteBudget: ByteCount
+
+    /// Average time to first token after a cold start, in seconds.
+    public let coldStartTimeToFirstToken: TimeInterval?
+
+    /// Average time to first token after switching from another model, in seconds.
+    public let switchTimeToFirstToken: TimeInterval?
+
+    /// Average time to first token when the model served the previous request, in seconds.
+    public let warmTimeToFirstToken: TimeInterval?
+
+    /// Every model seen since the cache was created, most recently used first.
+    public let models: [Model]
+}
+
+// MARK: - Start Kind
+
+/// How a request found its model, used to group time-to-first-token samples.
+enum MLXResidencyStartKind: Sendable, Hashable {
+    case cold
+    case `switch`
+    case warm
+}
+
+// MARK: - Memory Pressure
+
+/// Severity of an operating-system memory-pressure notification.
+enum MLXMemoryPressureLevel: Sendable, Hashable {
+    /// Memory is getting low; idle models should be released.
+    case warning
+
+    /// Memory is critically low; release everything that is not in use.
+    case critical
+}
+
+/// Forwards the operating system's memory-pressure events.
+///
+/// Uses a Dispatch memory-pressure source on Darwin. Elsewhere no events are
+/// delivered and eviction relies on the configured limits alone.
+///
+/// Marked `@unchecked Sendable` because the Dispatch source is only touched
+/// during initialization and cancellation.
+final class MLXMemoryPressureMonitor: @unchecked Sendable {
+    #if canImport(Darwin)
+    private let source: DispatchSourceMemoryPressure
+    #endif
+
+    /// Starts monitoring and calls `handler` for every event.
+    init(handler: @escaping @Sendable (MLXMemoryPressureLevel) -> Void) {
+        #if canImport(Darwin)
+        let source = DispatchSource.makeMemoryPressureSource(
+            eventMask: [.warning, .critical],
+            queue: .global(qos: .utility)
+        )
+        source.setEventHandler { [unowned source] in
+            let event = source.data
+            if event.contains(.critical) {
+                handler(.critical)
+            } else if event.contains(.warning) {
+                handler(.warning)
+            }
+        }
+        source.activate()
+        self.source = source
+        #endif
+    }
+
+    deinit {
+        #if canImport(Darwin)
+        source.cancel()
+        #endif
+    }
+}
+
+// MARK: - MLXResidencyPolicy
+
+/// Chooses which resident models to evict and whether to prefetch.
+///
+/// Eviction follows GreedyDual-Size: each model carries a priority of
+/// `inflation + reloadSeconds / gigabytes`, refreshed whenever it is used.
+/// The model with the lowest priority is evicted first and the cache's
+/// inflation rises to that priority, so models that are not used age
+/// toward eviction. The result is LRU ordering weighted by how expensive a
+/// model is to reload per byte it frees. Ties fall back to plain LRU.
+enum MLXResidencyPolicy {
+
+    /// A resident model as seen by the eviction policy.
+    struct Candidate: Sendable, Hashable {
+        let key: String
+        let bytes: Int64
+        let priority: Double
+        let lastAccess: UInt64
+    }
+
+    /// The smallest size used when weighting reload cost, so that tiny or
+    /// unmeasured models do not get unbounded priority.
+    static let minimumWeightedBytes: Int64 = 250_000_000
+
+    /// The priority of a model that was just used.
+    ///
+    /// - Parameters:
+    ///   - inflation: The cache's current inflation value.
+    ///   - reloadSeconds: How long the model took to load.
+    ///   - bytes: The model's measured footprint.
+    static func priority(inflation: Double, reloadSeconds: TimeInterval, bytes: Int64) -> Double {
+        let gigabytes = Double(max(bytes, minimumWeightedBytes)) / 1_000_000_000
+        return inflation + max(reloadSeconds, 0) / gigabytes
+    }
+
+    /// The models to evict, in order, so the cache fits its limits.
+    ///
+    /// - Parameters:
+    ///   - candidates: The resident models.
+    ///   - countLimit: Maximum resident models, or `0` for no limit.
+    ///   - byteLimit: Maximum resident bytes, or `nil` for no limit.
+    ///   - additionalModels: Models about to be loaded.
+    ///   - additionalBytes: Bytes about to be loaded.
+    ///   - protecting: A model that must stay resident, such as the one in use.
+    static func victims(
+        among candidates: [Candidate],
+        countLimit: Int,
+        byteLimit: Int64?,
+        additionalModels: Int = 0,
+        additionalBytes: Int64 = 0,
+        protecting: String? = nil
+    ) -> [String] {
+        var count = candidates.count + additionalModels
+        var bytes = candidates.reduce(additionalBytes) { $0 + $1.bytes }
+        let ordered = candidates
+            .filter { $0.key != protecting }
+            .sorted { ($0.priority, $0.lastAccess) < ($1.priority, $1.lastAccess) }
+
+        var victims: [String] = []
+        for candidate in ordered {
+            let overCount = countLimit > 0 && count > countLimit
+            let overBytes = byteLimit.map { bytes > $0 } ?? false
+            guard overCount || overBytes else { break }
+            victims.append(candidate.key)
+            count -= 1
+            bytes -= candidate.bytes
+        }
+        return victims
+    }
+
+    /// The byte budget used when no explicit cache size is configured:
+    /// 60% of physical memory, leaving room for the KV cache, activations
+    /// and the rest of the system on unified memory.
+    static func defaultByteBudget(for device: DeviceCapabilities) -> Int64 {
+        device.totalRAM / 10 * 6
+    }
+
+    /// Whether a model of `bytes` can be loaded speculatively.
+    ///
+    /// Prefetching never evicts: the model must fit in the remaining budget
+    /// and leave at least 10% of physical memory (and no less than 1 GB) free.
+    static func canPrefetch(
+        bytes: Int64,
+        residentBytes: Int64,
+        byteBudget: Int64,
+        device: DeviceCapabilities
+    ) -> Bool {
+        let headroom = max(device.totalRAM / 10, 1_000_000_000)
+        return residentBytes + bytes <= byteBudget && device.availableRAM - bytes >= headroom
+    }
+}
+
+// MARK: - MLXResidencyProbe
+
+/// Measures one request's time to first token and generation memory, and
+/// reports them to ``MLXModelCache``.
+///
+/// Create the probe before loading the model so cold starts include load time.
+struct MLXResidencyProbe: Sendable {
+    private let key: String?
+    private let cache: MLXModelCache
+    private let start = Date()
+    private var baselineBytes = 0
+    private var sawFirstToken = false
+
+    init(model: ModelIdentifier, cache: MLXModelCache = .shared) {
+        self.key = MLXModelLoader.cacheKey(for: model)
+        self.cache = cache
+    }
+
+    /// Marks the start of generation, after the model is loaded.
+    mutating func beginGeneration() {
+        #if arch(arm64)
+        MLX.GPU.resetPeakMemory()
+        baselineBytes = MLX.GPU.activeMemory
+        #endif
+    }
+
+    /// Records the first generated token. Later calls are ignored.
+    mutating func firstToken() async {
+        guard !sawFirstToken, let key else { return }
+        sawFirstToken = true
+        await cache.recordFirstToken(forKey: key, latency: Date().timeIntervalSince(start))
+    }
+
+    /// Records the generation's peak memory above the loaded weights.
+    func finish() async {
+        guard let key else { return }
+        #if arch(arm64)
+        let peak = MLX.GPU.peakMemory - baselineBytes
+        if peak > 0 {
+            await cache.recordGenerationFootprint(forKey: key, bytes: ByteCount(Int64(peak)))
+        }
+        #endif
+    }
+}
+
+#endif // CONDUIT_TRAIT_MLX && canImport(MLX)
+
+#endif // CONDUIT_TRAIT_MLX
@@ -0,0 +1,192 @@
+// MLXProvider+Grammar.swift
+// Conduit
+//
+// Grammar-constrained decoding for MLXProvider.
+
+// MARK: - Linux Compatibility
+// NOTE: MLX requires Metal GPU and Apple Silicon. Not available on Linux.
+#if CONDUIT_TRAIT_MLX && canImport(MLX)
+
+import Foundation
+@preconcurrency import MLX
+@preconcurrency import MLXLMCommon
+
+// MARK: - Supporting Types
+
+/// Result of a constrained turn, returned from the container's `perform` closure.
+internal struct MLXConstrainedOutcome: Sendable {
+    let text: String
+    let tokenCount: Int
+    let forcedTokenCount: Int
+    let finishReason: FinishReason
+    let elapsed: TimeInterval
+}
+
+// MARK: - Grammar-Constrained Generation
+
+/// `responseFormat` is enforced by masking logits in the constrained decode loop.
+extension MLXProvider: GrammarConstrainedGenerator {}
+
+extension MLXProvider {
+
+    /// Runs a turn whose output must match `grammar`.
+    ///
+    /// mlx-swift-lm's `ChatSession` has no hook for masking logits, so
+    /// constrained turns run their own decode loop on the container, as
+    /// speculative decoding does. At each step a cached
+    /// ``GrammarTokenMasker`` supplies the tokens the grammar allows and the
+    /// sampler only sees their logits. Where the grammar leaves a single
+    /// continuation, such as property names, punctuation and single-choice
+    /// values, the forced tokens are appended without sampling and fed to the
+    /// model together in one forward pass. The turn ends as soon as the
+    /// grammar is complete, without waiting for an end-of-sequence token.
+    ///
+    /// - Parameter onText: Receives detokenized text and the running token
+    ///   count as tokens are emitted.
+    func performConstrainedGeneration(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        plan: MLXResolvedRuntimePlan,
+        grammar: JSONGrammar,
+        onText: @escaping @Sendable (String, Int) -> Void
+    ) async throws -> MLXConstrainedOutcome {
+        try validateMLXModel(model)
+        await applyRuntimeConfigurationIfNeeded()
+
+        let container = try await modelLoader.loadModel(identifier: model)
+        let parameters = createGenerateParameters(from: config, mlxConfiguration: plan.configuration)
+        let prompt = buildPrompt(from: messages)
+        let vocabularyID = MLXModelLoader.cacheKey(for: model) ?? model.rawValue
+
+        return try await container.perform { context in
+            try await Self.decodeConstrained(
+                context: context,
+                prompt: prompt,
+                parameters: parameters,
+                grammar: grammar,
+                vocabularyID: vocabularyID,
+                onText: onText
+            )
+        }
+    }
+
+    // MARK: - Decode Loop
+
+    private static func decodeConstrained(
+        context: ModelContext,
+        prompt: String,
+        parameters: GenerateParameters,
+        grammar: JSONGrammar,
+        vocabularyID: String,
+        onText: @Sendable (String, Int) -> Void
+    ) async throws -> MLXConstrainedOutcome {
+        let startTime = Date()
+        let input = try await context.processor.prepare(input: UserInput(prompt: prompt))
+        let promptTokens = input.text.tokens.asArray(Int.self)
+        let cache = context.model.newCache(parameters: parameters)
+
+        var stopTokenIDs = Set(
+            context.configuration.extraEOSTokens.compactMap { context.tokenizer.convertTokenToId($0) }
+        )
+        if let eosTokenID = context.tokenizer.eosTokenId {
+            stopTokenIDs.insert(eosTokenID)
+        }
+
+        let sampler = parameters.sampler()
+        var processor = parameters.processor()
+        processor?.prompt(input.text.tokens)
+
+        var logits = prefill(
+            context.model,
+            tokens: promptTokens,
+            cache: cache,
+            stepSize: max(1, parameters.prefillStepSize)
+        )
+
+        // The vocabulary is decoded once per model and reused by every grammar.
+        let vocabularySize = logits.dim(-1)
+        let tokenizer = context.tokenizer
+        let masker = GrammarMaskerStore.shared.masker(for: grammar, vocabularyID: vocabularyID) {
+            GrammarVocabulary(pieces: (0..<vocabularySize).map { id in
+                stopTokenIDs.contains(id) ? nil : tokenizer.convertIdToToken(id)
+            })
+        }
+        let stopTokens = stopTokenIDs.filter { $0 < vocabularySize }.sorted().map { Int32($0) }
+
+        // Samples among `candidates` only, after the usual logit processing.
+        func sample(among candidates: [Int32]) -> Int {
+            var processed = logits
+            if let processor {
+                processed = processor.process(logits: processed)
+            }
+            let allowed = take(processed, MLXArray(candidates), axis: -1)
+            let choice = sampler.sample(logits: allowed).item(Int.self)
+            return Int(candidates[choice])
+        }
+
+        let maxTokens = parameters.maxTokens ?? Int.max
+        var matcher = masker.makeMatcher()
+        var detokenizer = NaiveStreamingDetokenizer(tokenizer: context.tokenizer)
+        var text = ""
+        var tokenCount = 0
+        var forcedTokenCount = 0
+        var finishReason: FinishReason = .maxTokens
+
+        while tokenCount < maxTokens {
+            if Task.isCancelled {
+                finishReason = .cancelled
+                break
+            }
+
+            var step = Array(masker.forcedTokens(after: matcher).prefix(maxTokens - tokenCount))
+            if step.isEmpty {
+                var candidates = masker.allowedTokens(for: matcher)
+                if matcher.isComplete {
+                    candidates += stopTokens
+                }
+                // No token of this vocabulary continues the grammar.
+                guard !candidates.isEmpty else {
+                    finishReason = .stop
+                    break
+                }
+                let token = sample(among: candidates)
+                if stopTokenIDs.contains(token) {
+                    finishReason = .stop
+                    break
+                }
+                step = [token]
+            } else {
+                forcedTokenCount += step.count
+            }
+
+            for token in step {
+                matcher.accept(masker.vocabulary.bytes(of: token))
+                processor?.didSample(token: MLXArray(Int32(token)))
+                tokenCount += 1
+                detokenizer.append(token: token)
+                if let piece = detokenizer.next(), !piece.isEmpty {
+                    text += piece
+                    onText(piece, tokenCount)
+                }
+            }
+
+            // A finished document needs no further forward pass.
+            guard matcher.canContinue else {
+                finishReason = .stop
+                break
+            }
+            logits = lastLogits(forward(context.model, tokens: step, cache: cache))
+        }
+
+        return MLXConstrainedOutcome(
+            text: text,
+            tokenCount: tokenCount,
+            forcedTokenCount: forcedTokenCount,
+            finishReason: finishReason,
+            elapsed: Date().timeIntervalSince(startTime)
+        )
+    }
+}
+
+#endif // CONDUIT_TRAIT_MLX && canImport(MLX)
@@ -0,0 +1,316 @@
+// MLXProvider+Speculative.swift
+// Conduit
+//
+// Draft-model speculative decoding for MLXProvider.
+
+// MARK: - Linux Compatibility
+// NOTE: MLX requires Metal GPU and Apple Silicon. Not available on Linux.
+#if CONDUIT_TRAIT_MLX && canImport(MLX)
+
+import Foundation
+@preconcurrency import MLX
+@preconcurrency import MLXLMCommon
+
+// MARK: - Supporting Types
+
+/// Result of a speculative turn, returned from the target container's `perform` closure.
+internal struct MLXSpeculativeOutcome: Sendable {
+    let text: String
+    let tokenCount: Int
+    let finishReason: FinishReason
+    let controller: SpeculativeDecodingController
+    let elapsed: TimeInterval
+}
+
+/// Reasons a request falls back to baseline decoding before any token is emitted.
+private enum MLXSpeculativeFallback: Error {
+    case cacheNotTrimmable
+}
+
+/// Carries the draft model into the target container's `perform` closure.
+///
+/// The draft model is only used inside that closure, one turn at a time.
+private struct MLXDraftModelReference: @unchecked Sendable {
+    let model: any LanguageModel
+}
+
+// MARK: - Speculative Generation
+
+extension MLXProvider {
+
+    /// Runs a turn with draft-model speculative decoding.
+    ///
+    /// The draft model (`runtimeFeatures.speculativeScheduling.draftModel`)
+    /// greedily proposes up to `draftAheadTokens` tokens; the target scores the
+    /// last emitted token plus the whole draft in one forward pass and samples its
+    /// own token at each position, keeping the draft prefix it agrees with. KV
+    /// entries of rejected tokens are trimmed from both caches.
+    ///
+    /// - Parameter onText: Receives detokenized text and the running token count
+    ///   as tokens are accepted.
+    /// - Returns: The outcome, or `nil` when the request should run on the baseline path.
+    func performSpeculativeGeneration(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        plan: MLXResolvedRuntimePlan,
+        onText: @escaping @Sendable (String, Int) -> Void
+    ) async throws -> MLXSpeculativeOutcome? {
+        let speculative = plan.runtimeFeatures.speculativeScheduling
+        let modelID = model.rawValue
+
+        guard let draftID = speculative.draftModel, !draftID.isEmpty else {
+            recordSpeculativeFallback(modelID: modelID, reason: "draftModelMissing")
+            return nil
+        }
+
+        let capability = await runtimeCapabilities(for: model)[.speculativeScheduling]
+        let maximumDraftAhead = capability.maxDraftAheadTokens ?? SpeculativeDecodingController.defaultDraftAheadTokens
+        let controller = SpeculativeDecodingController(
+            configuration: speculative,
+            maximumDraftAheadTokens: maximumDraftAhead,
+            maximumBatchTokens: max(2, plan.configuration.prefillStepSize)
+        )
+        guard controller.isDrafting else {
+            recordSpeculativeFallback(modelID: modelID, reason: controller.disabledReason ?? "noDraftBudget")
+            return nil
+        }
+
+        await applyRuntimeConfigurationIfNeeded()
+
+        // Load the draft first so the target stays the most recently used model.
+        let draftContainer: ModelContainer
+        do {
+            draftContainer = try await modelLoader.loadModel(identifier: draftModelIdentifier(draftID))
+        } catch {
+            recordSpeculativeFallback(
+                modelID: modelID,
+                reason: "draftModelUnavailable",
+                details: ["draft_model": draftID]
+            )
+            return nil
+        }
+        let targetContainer = try await modelLoader.loadModel(identifier: model)
+
+        let draft = await draftContainer.perform { context in
+            MLXDraftModelReference(model: context.model)
+        }
+        let parameters = createGenerateParameters(from: config, mlxConfiguration: plan.configuration)
+        let prompt = buildPrompt(from: messages)
+
+        let outcome: MLXSpeculativeOutcome
+        do {
+            outcome = try await targetContainer.perform { context in
+                try await Self.decodeSpeculatively(
+                    context: context,
+                    draftModel: draft.model,
+                    prompt: prompt,
+                    parameters: parameters,
+                    controller: controller,
+                    onText: onText
+                )
+            }
+        } catch MLXSpeculativeFallback.cacheNotTrimmable {
+            recordSpeculativeFallback(modelID: modelID, reason: "cacheNotTrimmable")
+            return nil
+        }
+
+        recordRuntimeDiagnostic(
+            feature: .speculativeScheduling,
+            kind: .speculativeDecoding,
+            modelID: modelID,
+            reason: outcome.controller.disabledReason,
+            details: outcome.controller.diagnosticsDetails(draftModel: draftID, elapsed: outcome.elapsed)
+        )
+        return outcome
+    }
+
+    /// Maps a draft model string to a local directory or Hugging Face identifier.
+    private func draftModelIdentifier(_ value: String) -> ModelIdentifier {
+        var isDirectory: ObjCBool = false
+        if FileManager.default.fileExists(atPath: value, isDirectory: &isDirectory), isDirectory.boolValue {
+            return .mlxLocal(value)
+        }
+        return .mlx(value)
+    }
+
+    private func recordSpeculativeFallback(modelID: String, reason: String, details: [String: String] = [:]) {
+        recordRuntimeDiagnostic(
+            feature: .speculativeScheduling,
+            kind: .capabilityDenied,
+            modelID: modelID,
+            reason: reason,
+            details: details
+        )
+        recordRuntimeDiagnostic(
+            feature: .speculativeScheduling,
+            kind: .fallbackUsed,
+            modelID: modelID,
+            reason: "fallbackToBaseline",
+            details: [:]
+        )
+    }
+
+    // MARK: - Decode Loop
+
+    private static func decodeSpeculatively(
+        context: ModelContext,
+        draftModel: any LanguageModel,
+        prompt: String,
+        parameters: GenerateParameters,
+        controller initialController: SpeculativeDecodingController,
+        onText: @Sendable (String, Int) -> Void
+    ) async throws -> MLXSpeculativeOutcome {
+        let input = try await context.processor.prepare(input: UserInput(prompt: prompt))
+        let promptTokens = input.text.tokens.asArray(Int.self)
+
+        let targetCache = context.model.newCache(parameters: parameters)
+        let draftCache = draftModel.newCache(parameters: parameters)
+        guard canTrimPromptCache(targetCache), canTrimPromptCache(draftCache) else {
+            throw MLXSpeculativeFallback.cacheNotTrimmable
+        }
+
+        var stopTokenIDs = Set(
+            context.configuration.extraEOSTokens.compactMap { context.tokenizer.convertTokenToId($0) }
+        )
+        if let eosTokenID = context.tokenizer.eosTokenId {
+            stopTokenIDs.insert(eosTokenID)
+        }
+
+        let sampler = parameters.sampler()
+        var processor = parameters.processor()
+        processor?.prompt(input.text.tokens)
+
+        func sampleTarget(_ logits: MLXArray) -> Int {
+            var logits = logits
+            if let processor {
+                logits = processor.process(logits: logits)
+            }
+            let token = sampler.sample(logits: logits)
+            processor?.didSample(token: token)
+            return token.item(Int.self)
+        }
+
+        let startTime = Date()
+        let stepSize = max(1, parameters.prefillStepSize)
+        let maxTokens = parameters.maxTokens ?? Int.max
+        var controller = initialController
+        var detokenizer = NaiveStreamingDetokenizer(tokenizer: context.tokenizer)
+        var text = ""
+        var tokenCount = 0
+        var finishReason: FinishReason = .maxTokens
+
+        func emit(_ token: Int) -> Bool {
+            if stopTokenIDs.contains(token) {
+                finishReason = .stop
+                return false
+            }
+            tokenCount += 1
+            detokenizer.append(token: token)
+            if let piece = detokenizer.next(), !piece.isEmpty {
+                text += piece
+                onText(piece, tokenCount)
+            }
+            return tokenCount < maxTokens
+        }
+
+        // Prefill both models; the draft's logits are discarded until the first round.
+        let promptLogits = prefill(context.model, tokens: promptTokens, cache: targetCache, stepSize: stepSize)
+        _ = prefill(draftModel, tokens: promptTokens, cache: draftCache, stepSize: stepSize)
+        var draftCachedCount = promptTokens.count
+
+        var history = promptTokens
+        let firstToken = sampleTarget(promptLogits)
+        history.append(firstToken)
+        controller.recordEmittedToken()
+        var isGenerating = emit(firstToken)
+
+        while isGenerating {
+            if Task.isCancelled {
+                finishReason = .cancelled
+                break
+            }
+
+            // Draft: catch the draft cache up with history, then propose greedily.
+            var draft: [Int] = []
+            let draftCount = controller.draftLength(remainingTokens: maxTokens - tokenCount)
+            if draftCount > 0 {
+                let unseen = Array(history[draftCachedCount...])
+                var logits = lastLogits(forward(draftModel, tokens: unseen, cache: draftCache))
+                draftCachedCount = history.count
+                while draft.count < draftCount {
+                    let token = argMax(logits, axis: -1).item(Int.self)
+                    draft.append(token)
+                    if draft.count == draftCount || stopTokenIDs.contains(token) {
+                        break
+                    }
+                    logits = lastLogits(forward(draftModel, tokens: [token], cache: draftCache))
+                    draftCachedCount += 1
+                }
+            }
+
+            // Verify: one target pass over the last emitted token plus the draft.
+            let verification = forward(context.model, tokens: [history[history.count - 1]] + draft, cache: targetCache)
+            let emitted = SpeculativeDecodingController.verify(draft: draft) { position in
+                sampleTarget(verification[0..., position, 0...])
+            }
+            let accepted = emitted.count - 1
+
+            // Roll back KV entries past the accepted prefix.
+            trimPromptCache(targetCache, numTokens: draft.count - accepted)
+            let draftFed = draftCachedCount - history.count
+            let draftKept = min(accepted, draftFed)
+            trimPromptCache(draftCache, numTokens: draftFed - draftKept)
+            draftCachedCount = history.count + draftKept
+
+            history.append(contentsOf: emitted)
+            controller.recordRound(draftedTokens: draft.count, acceptedTokens: accepted)
+
+            for token in emitted {
+                isGenerating = emit(token)
+                if !isGenerating {
+                    break
+                }
+            }
+        }
+
+        return MLXSpeculativeOutcome(
+            text: text,
+            tokenCount: tokenCount,
+            finishReason: finishReason,
+            controller: controller,
+            elapsed: Date().timeIntervalSince(startTime)
+        )
+    }
+
+    /// Runs `tokens` through `model`, returning logits of shape `[1, tokens.count, vocab]`.
+    static func forward(_ model: any LanguageModel, tokens: [Int], cache: [KVCache]) -> MLXArray {
+        let inputs = MLXArray(tokens.map { Int32($0) }).reshaped(1, tokens.count)
+        let logits = model(LMInput.Text(tokens: inputs), cache: cache, state: nil).logits
+        eval(logits)
+        return logits
+    }
+
+    /// Prefills `tokens` in `stepSize` chunks and returns the final position's logits.
+    static func prefill(
+        _ model: any LanguageModel,
+        tokens: [Int],
+        cache: [KVCache],
+        stepSize: Int
+    ) -> MLXArray {
+        var offset = 0
+        var logits = MLXArray(0)
+        while offset < tokens.count {
+            let end = min(offset + stepSize, tokens.count)
+            logits = lastLogits(forward(model, tokens: Array(tokens[offset..<end]), cache: cache))
+            offset = end
+        }
+        return logits
+    }
+
+    static func lastLogits(_ logits: MLXArray) -> MLXArray {
+        logits[0..., -1, 0...]
+    }
+}
+
+#endif // CONDUIT_TRAIT_MLX && canImport(MLX)
@@ -77,7 +77,7 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
     let configuration: MLXConfiguration
 
     /// Model loader for managing loaded models.
-    private let modelLoader: MLXModelLoader
+    let modelLoader: MLXModelLoader
 
     /// Flag for cancellation support.
     private var isCancelled: Bool = false
@@ -85,6 +85,9 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
     /// Tracks whether runtime configuration has been applied.
     private var didApplyRuntimeConfiguration: Bool = false
 
+    /// Warmup started by `prepare(model:warmup:)`, cancelled when a request arrives.
+    private var backgroundWarmup: Task<Void, Never>?
+
     /// Bounded runtime diagnostics for capability/fallback telemetry.
     private var runtimeDiagnosticsEvents: [ProviderRuntimeDiagnosticsEvent] = []
     private let runtimeDiagnosticsLimit = 512
@@ -166,6 +169,7 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
     ) async throws -> GenerationResult {
         #if arch(arm64)
         try validateMLXModel(model)
+        cancelBackgroundWarmup()
 
         // Reset cancellation flag
         isCancelled = false
@@ -197,6 +201,7 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
     ) -> AsyncThrowingStream<GenerationChunk, Error> {
         AsyncThrowingStream { continuation in
             let task = Task {
+                await self.cancelBackgroundWarmup()
                 await self.performStreamingGenerationWithRuntimePlan(
                     messages: messages,
                     model: model,
@@ -298,7 +303,7 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
         )
 
         let sinkTokens = max(16, configuration.kvCacheLimit ?? 256)
-        let draftLimit = 4
+        let draftLimit = 1
         let draftAhead = 64
         let prefillLimit = max(1024, configuration.prefillStepSize * 16)
 
@@ -346,6 +351,58 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
         try await warmUp(model: model, prefillText: "The quick brown fox jumps over the lazy dog.", maxTokens: 5)
     }
 
+    /// Prepares a model using the given warmup schedule.
+    ///
+    /// With `.blocking`, this performs the warmup pass before returning, like
+    /// ``prepare(model:)``. With `.background` and `.progressive`, it returns
+    /// immediately. Progressive warmup first loads the weights without
+    /// generating, then runs the warmup pass to compile kernels. A request
+    /// that arrives in the meantime joins the in-progress load and cancels
+    /// the remaining warmup generation so the two do not compete for the GPU.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// // During app launch, without delaying the first frame
+    /// try await provider.prepare(model: .llama3_2_1b, warmup: .progressive)
+    /// ```
+    ///
+    /// - Parameters:
+    ///   - model: The model identifier to prepare.
+    ///   - warmup: Warmup prompt size, token count and scheduling. `warmupOnInit` is ignored.
+    public func prepare(model: ModelID, warmup: WarmupConfig) async throws {
+        #if arch(arm64)
+        try validateMLXModel(model)
+        let prefillText = warmup.prefillText
+        let maxTokens = warmup.warmupTokens
+
+        switch warmup.mode {
+        case .blocking:
+            try await warmUp(model: model, prefillText: prefillText, maxTokens: maxTokens)
+        case .background:
+            backgroundWarmup?.cancel()
+            backgroundWarmup = Task {
+                try? await self.performWarmupPass(model: model, prefillText: prefillText, maxTokens: maxTokens)
+            }
+        case .progressive:
+            backgroundWarmup?.cancel()
+            backgroundWarmup = Task {
+                await self.applyRuntimeConfigurationIfNeeded()
+                _ = try? await self.modelLoader.loadModel(identifier: model)
+                guard !Task.isCancelled else { return }
+                try? await self.performWarmupPass(model: model, prefillText: prefillText, maxTokens: maxTokens)
+            }
+        }
+        #else
+        throw AIError.providerUnavailable(reason: .deviceNotSupported)
+        #endif
+    }
+
+    /// Cancels warmup started by `prepare(model:warmup:)` so a request does not compete with it.
+    private func cancelBackgroundWarmup() {
+        backgroundWarmup?.cancel()
+        backgroundWarmup = nil
+    }
+
     /// Releases provider-managed runtime resources.
     ///
     /// This clears in-memory model caches and GPU intermediate caches.
@@ -357,6 +414,22 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
         #endif
     }
 
+    /// Returns memory use, eviction counts and time-to-first-token for loaded models.
+    ///
+    /// Time to first token is grouped into cold starts, switches from another
+    /// model and warm repeats, which shows what model switching costs.
+    /// The statistics cover every MLX provider in the process because loaded
+    /// models are shared.
+    ///
+    /// ## Usage
+    /// ```swift
+    /// let stats = await provider.residencyStats()
+    /// print("Resident: \(stats.residentBytes.formatted) of \(stats.byteBudget.formatted)")
+    /// ```
+    public func residencyStats() async -> MLXResidencyStats {
+        await MLXModelCache.shared.residencyStats()
+    }
+
     // MARK: - Model Warmup
 
     /// Warms up the model for optimal first-token latency.
@@ -433,6 +506,19 @@ public actor MLXProvider: AIProvider, TextGenerator, TokenCounter {
         #endif
     }
 
+    #if arch(arm64)
+    /// Runs a warmup generation without going through `generate`, which would
+    /// cancel the background warmup running it.
+    private func performWarmupPass(model: ModelID, prefillText: String, maxTokens: Int) async throws {
+        let warmupConfig = GenerateConfig(maxTokens: maxTokens, temperature: 0.0, topP: 1.0)
+        _ = try await performGenerationWithRuntimePlan(
+            messages: [.user(prefillText)],
+            model: model,
+            config: warmupConfig
+        )
+    }
+    #endif
+
     // MARK: - TextGenerator
 
     /// Generates text from a simple string prompt.
@@ -633,7 +719,7 @@ extension MLXProvider {
     ///
     /// MLX public APIs intentionally accept both Hugging Face repo IDs
     /// (`.mlx(...)`) and local filesystem directories (`.mlxLocal(...)`).
-    private func validateMLXModel(_ model: ModelID) throws {
+    func validateMLXModel(_ model: ModelID) throws {
         switch model {
         case .mlx, .mlxLocal:
             return
@@ -655,8 +741,10 @@ extension MLXProvider {
 
         await applyRuntimeConfigurationIfNeeded()
 
-        // Load model container
+        // Load model container, measuring time to first token from here
+        var residencyProbe = MLXResidencyProbe(model: model)
         let container = try await modelLoader.loadModel(identifier: model)
+        residencyProbe.beginGeneration()
 
         // Track timing
         let startTime = Date()
@@ -695,9 +783,11 @@ extension MLXProvider {
                 )
             }
 
+            await residencyProbe.firstToken()
             generatedText += chunk
             tokenCount += 1
         }
+        await residencyProbe.finish()
 
         // Calculate metrics
         let duration = Date().timeIntervalSince(startTime)
@@ -735,7 +825,10 @@ extension MLXProvider {
 
             await applyRuntimeConfigurationIfNeeded()
 
-            // Load model container
+            // Load model container, measuring time to first token from here
+            var residencyProbe = MLXResidencyProbe(model: model)
+            var telemetry = TelemetryStream(source: "mlx")
+            defer { telemetry?.finish() }
             let container = try await modelLoader.loadModel(identifier: model)
 
             // Create generation parameters
@@ -757,6 +850,7 @@ extension MLXProvider {
             // Track timing
             let startTime = Date()
             var totalTokens = 0
+            residencyProbe.beginGeneration()
 
             // Stream response
             for try await chunk in session.streamResponse(to: prompt) {
@@ -769,6 +863,8 @@ extension MLXProvider {
                     return
                 }
 
+                await residencyProbe.firstToken()
+                telemetry?.chunkReceived()
                 totalTokens += 1
 
                 // Calculate current throughput
@@ -785,6 +881,8 @@ extension MLXProvider {
                 continuation.yield(generationChunk)
             }
 
+            await residencyProbe.finish()
+
             // Send completion chunk
             let finalChunk = GenerationChunk.completion(finishReason: .stop)
             continuation.yield(finalChunk)
@@ -804,7 +902,7 @@ extension MLXProvider {
     /// ChatSession handles conversation context internally, so we pass the
     /// last user message. For multi-turn conversations, system prompts are
     /// included as context.
-    private func buildPrompt(from messages: [Message]) -> String {
+    func buildPrompt(from messages: [Message]) -> String {
         // Find the system message if present
         let systemMessage = messages.first { $0.role == .system }
 
@@ -840,7 +938,7 @@ extension MLXProvider {
     }
 
     /// Converts Conduit GenerateConfig to mlx-swift-lm GenerateParameters.
-    private func createGenerateParameters(
+    func createGenerateParameters(
         from config: GenerateConfig,
         mlxConfiguration: MLXConfiguration
     ) -> GenerateParameters {
@@ -1063,7 +1161,7 @@ extension MLXProvider {
         }
     }
 
-    private func recordRuntimeDiagnostic(
+    func recordRuntimeDiagnostic(
         feature: ProviderRuntimeFeature,
         kind: ProviderRuntimeDiagnosticsEventKind,
         modelID: String,
@@ -1095,7 +1193,7 @@ extension MLXProvider {
 
     // MARK: - Runtime Configuration
 
-    private func applyRuntimeConfigurationIfNeeded() async {
+    func applyRuntimeConfigurationIfNeeded() async {
         guard !didApplyRuntimeConfiguration else { return }
         await MLXModelCache.shared.apply(configuration: configuration.cacheConfiguration())
 
@@ -1128,11 +1226,49 @@ extension MLXProvider {
     ) async throws -> GenerationResult {
         let plan = await resolveRuntimePlan(model: model, generateConfig: config)
 
+        if let grammar = JSONGrammar.compiled(for: config.responseFormat) {
+            let outcome = try await performConstrainedGeneration(
+                messages: messages,
+                model: model,
+                config: config,
+                plan: plan,
+                grammar: grammar,
+                onText: { _, _ in }
+            )
+            return GenerationResult(
+                text: outcome.text,
+                tokenCount: outcome.tokenCount,
+                generationTime: outcome.elapsed,
+                tokensPerSecond: outcome.elapsed > 0 ? Double(outcome.tokenCount) / outcome.elapsed : 0,
+                finishReason: outcome.finishReason
+            )
+        }
+
         switch plan.engineKind {
         case .baseline:
             return try await performGeneration(messages: messages, model: model, config: config)
         case .advanced:
-            // Advanced feature path currently uses the same generation core while
+            if plan.runtimeFeatures.speculativeScheduling.enabled == true {
+                let startTime = Date()
+                let outcome = try await performSpeculativeGeneration(
+                    messages: messages,
+                    model: model,
+                    config: config,
+                    plan: plan,
+                    onText: { _, _ in }
+                )
+                if let outcome {
+                    let duration = Date().timeIntervalSince(startTime)
+                    return GenerationResult(
+                        text: outcome.text,
+                        tokenCount: outcome.tokenCount,
+                        generationTime: duration,
+                        tokensPerSecond: duration > 0 ? Double(outcome.tokenCount) / duration : 0,
+                        finishReason: outcome.finishReason
+                    )
+                }
+            }
+            // Remaining advanced features use the same generation core while
             // capability-gated runtime controls are applied by resolveRuntimePlan.
             return try await performGeneration(messages: messages, model: model, config: config)
         }
@@ -1146,6 +1282,18 @@ extension MLXProvider {
     ) async {
         let plan = await resolveRuntimePlan(model: model, generateConfig: config)
 
+        if let grammar = JSONGrammar.compiled(for: config.responseFormat) {
+            await performConstrainedStreamingGeneration(
+                messages: messages,
+                model: model,
+                config: config,
+                plan: plan,
+                grammar: grammar,
+                continuation: continuation
+            )
+            return
+        }
+
         switch plan.engineKind {
         case .baseline:
             await performStreamingGeneration(
@@ -1155,7 +1303,17 @@ extension MLXProvider {
                 continuation: continuation
             )
         case .advanced:
-            // Advanced feature path currently uses the same generation core while
+            if plan.runtimeFeatures.speculativeScheduling.enabled == true,
+               await performSpeculativeStreamingGeneration(
+                messages: messages,
+                model: model,
+                config: config,
+                plan: plan,
+                continuation: continuation
+               ) {
+                return
+            }
+            // Remaining advanced features use the same generation core while
             // capability-gated runtime controls are applied by resolveRuntimePlan.
             await performStreamingGeneration(
                 messages: messages,
@@ -1166,6 +1324,91 @@ extension MLXProvider {
         }
     }
 
+    /// Streams a speculative turn.
+    ///
+    /// - Returns: `false` if nothing was streamed and the baseline path should run.
+    private func performSpeculativeStreamingGeneration(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        plan: MLXResolvedRuntimePlan,
+        continuation: AsyncThrowingStream<GenerationChunk, Error>.Continuation
+    ) async -> Bool {
+        isCancelled = false
+        let startTime = Date()
+
+        do {
+            let outcome = try await performSpeculativeGeneration(
+                messages: messages,
+                model: model,
+                config: config,
+                plan: plan,
+                onText: { text, tokens in
+                    let elapsed = Date().timeIntervalSince(startTime)
+                    continuation.yield(
+                        GenerationChunk(
+                            text: text,
+                            tokenCount: 1,
+                            tokensPerSecond: elapsed > 0 ? Double(tokens) / elapsed : 0,
+                            isComplete: false
+                        )
+                    )
+                }
+            )
+            guard let outcome else { return false }
+
+            continuation.yield(GenerationChunk.completion(finishReason: outcome.finishReason))
+            continuation.finish()
+        } catch is CancellationError {
+            continuation.yield(GenerationChunk.completion(finishReason: .cancelled))
+            continuation.finish()
+        } catch {
+            continuation.finish(throwing: AIError.generationFailed(underlying: SendableError(error)))
+        }
+        return true
+    }
+
+    /// Streams a turn whose output must match `grammar`.
+    private func performConstrainedStreamingGeneration(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        plan: MLXResolvedRuntimePlan,
+        grammar: JSONGrammar,
+        continuation: AsyncThrowingStream<GenerationChunk, Error>.Continuation
+    ) async {
+        isCancelled = false
+        let startTime = Date()
+
+        do {
+            let outcome = try await performConstrainedGeneration(
+                messages: messages,
+                model: model,
+                config: config,
+                plan: plan,
+                grammar: grammar,
+                onText: { text, tokens in
+                    let elapsed = Date().timeIntervalSince(startTime)
+                    continuation.yield(
+                        GenerationChunk(
+                            text: text,
+                            tokenCount: 1,
+                            tokensPerSecond: elapsed > 0 ? Double(tokens) / elapsed : 0,
+                            isComplete: false
+                        )
+                    )
+                }
+            )
+            continuation.yield(GenerationChunk.completion(finishReason: outcome.finishReason))
+            continuation.finish()
+        } catch is CancellationError {
+            continuation.yield(GenerationChunk.completion(finishReason: .cancelled))
+            continuation.finish()
+        } catch {
+            continuation.finish(throwing: AIError.generationFailed(underlying: SendableError(error)))
+        }
+    }
+
     private func resolveRuntimePlan(
         model: ModelIdentifier,
         generateConfig: GenerateConfig
@@ -17,11 +17,18 @@ import Foundation
 /// Provides automatic memory management using NSCache's built-in eviction policies.
 /// Caches are invalidated when the model changes to prevent stale embeddings.
 ///
+/// Pass a `directory` to also persist embeddings on disk. Persisted
+/// embeddings survive restarts and model changes, because their file names
+/// are derived from the whole key, model included. Memory misses are served
+/// from memory-mapped files, so a lookup reads only the pages the embedding
+/// occupies.
+///
 /// ## Features
 ///
 /// - **Automatic Eviction**: NSCache handles memory pressure automatically
 /// - **Model Awareness**: Cache invalidates when model changes
 /// - **Size Limits**: Configure max cached embeddings and total memory usage
+/// - **Persistence**: Optional on-disk tier that survives restarts
 /// - **Thread-Safe**: Actor isolation ensures safe concurrent access
 ///
 /// ## Usage
@@ -57,6 +64,9 @@ import Foundation
 ///
 /// The default configuration caches up to 50 embeddings with a 100MB limit.
 /// NSCache automatically evicts old entries when memory pressure increases.
+/// The disk tier tracks its size as it writes. Once it exceeds `diskLimit`
+/// bytes it removes its least recently used files down to three quarters of
+/// the limit, so the directory is listed once per trim rather than per write.
 public actor TextEmbeddingCache {
 
     // MARK: - Types
@@ -129,6 +139,24 @@ public actor TextEmbeddingCache {
     /// The current model ID for cache invalidation
     private var currentModelId: String?
 
+    /// Directory holding persisted embeddings, or `nil` for memory only
+    public let directory: URL?
+
+    /// Maximum total bytes of persisted embeddings
+    public let diskLimit: Int
+
+    /// Bytes the disk tier holds, counted once and then kept up to date
+    private let diskUsage = DiskUsage()
+
+    /// Where Conduit persists embeddings by default.
+    public static var defaultDirectory: URL {
+        let base = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? FileManager.default.temporaryDirectory
+        return base
+            .appendingPathComponent("Conduit", isDirectory: true)
+            .appendingPathComponent("TextEmbeddings", isDirectory: true)
+    }
+
     // MARK: - Initialization
 
     /// Creates a new text embedding cache.
@@ -136,10 +164,20 @@ public actor TextEmbeddingCache {
     /// - Parameters:
     ///   - countLimit: Maximum number of embeddings to cache (default: 50)
     ///   - costLimit: Maximum total memory in bytes (default: 100MB)
-    public init(countLimit: Int = 50, costLimit: Int = 100 * 1024 * 1024) {
+    ///   - directory: Directory to persist embeddings in, such as
+    ///     ``defaultDirectory``. Pass `nil` to keep embeddings in memory only (default: nil)
+    ///   - diskLimit: Maximum total bytes of persisted embeddings (default: 512MB)
+    public init(
+        countLimit: Int = 50,
+        costLimit: Int = 100 * 1024 * 1024,
+        directory: URL? = nil,
+        diskLimit: Int = 512 * 1024 * 1024
+    ) {
         // Access the cache directly through cacheWrapper since `cache` is actor-isolated
         cacheWrapper.cache.countLimit = countLimit
         cacheWrapper.cache.totalCostLimit = costLimit
+        self.directory = directory
+        self.diskLimit = max(0, diskLimit)
     }
 
     // MARK: - Public Methods
@@ -181,6 +219,9 @@ public actor TextEmbeddingCache {
     /// }
     /// ```
     ///
+    /// Memory misses fall back to the disk tier, if configured; embeddings
+    /// found there are kept in memory for later lookups.
+    ///
     /// - Parameter key: The cache key to look up
     /// - Returns: The cached embedding, or nil if not found
     ///
@@ -190,13 +231,21 @@ public actor TextEmbeddingCache {
     ///   through the thread-safe NSCache.
     public nonisolated func get(_ key: CacheKey) -> MLXArray? {
         let wrapper = KeyWrapper(key)
-        return cacheWrapper.cache.object(forKey: wrapper)?.embedding
+        if let cached = cacheWrapper.cache.object(forKey: wrapper)?.embedding {
+            return cached
+        }
+        guard let embedding = loadPersisted(key) else { return nil }
+        let cost = estimateCost(embedding)
+        cacheWrapper.cache.setObject(EmbeddingWrapper(embedding: embedding, cost: cost), forKey: wrapper, cost: cost)
+        return embedding
     }
 
     /// Caches an embedding.
     ///
     /// The cost is calculated from the embedding's memory footprint.
     /// NSCache may automatically evict old entries if limits are exceeded.
+    /// With a disk tier, the embedding is also written to `directory`;
+    /// embeddings of unsupported element types stay in memory only.
     ///
     /// ## Example
     ///
@@ -215,11 +264,13 @@ public actor TextEmbeddingCache {
         let wrapper = EmbeddingWrapper(embedding: embedding, cost: cost)
         let keyWrapper = KeyWrapper(key)
         cacheWrapper.cache.setObject(wrapper, forKey: keyWrapper, cost: cost)
+        persist(embedding, forKey: key)
     }
 
-    /// Clears all cached embeddings.
+    /// Clears all embeddings cached in memory.
     ///
     /// Use this when memory is low or when switching between models.
+    /// Persisted embeddings are kept; use ``removePersisted()`` to delete them.
     ///
     /// ## Example
     ///
@@ -232,10 +283,24 @@ public actor TextEmbeddingCache {
         cacheWrapper.cache.removeAllObjects()
     }
 
+    /// Deletes every persisted embedding.
+    ///
+    /// Embeddings cached in memory are kept.
+    public nonisolated func removePersisted() {
+        guard let directory else { return }
+        diskUsage.withLock { bytes in
+            for url in persistedFiles(in: directory) {
+                try? FileManager.default.removeItem(at: url)
+            }
+            bytes = nil
+        }
+    }
+
     /// Notifies the cache that the model has changed.
     ///
-    /// This clears all cached embeddings because embeddings from different
-    /// models are incompatible.
+    /// This clears the embeddings cached in memory because embeddings from
+    /// different models are incompatible. Persisted embeddings are keyed by
+    /// model and stay on disk.
     ///
     /// Call this whenever you load a new diffusion model.
     ///
@@ -254,6 +319,157 @@ public actor TextEmbeddingCache {
         }
     }
 
+    // MARK: - Disk Tier
+
+    /// File layout of a persisted embedding.
+    ///
+    /// A 16-byte header (magic, version, element type, rank) is followed by
+    /// the dimensions as little-endian `Int64` values and then the raw
+    /// element bytes.
+    enum PersistedFormat {
+        static let magic = Data("CEMB".utf8)
+        static let version: UInt8 = 1
+        static let headerSize = 16
+        static let fileExtension = "embedding"
+
+        /// Element types that can be persisted, indexed by their stored code.
+        static let dtypes: [DType] = [.float32, .float16, .bfloat16, .int32, .int64, .uint8]
+
+        static func encode(_ array: MLXArray) -> Data? {
+            guard let code = dtypes.firstIndex(of: array.dtype), array.ndim <= Int(UInt8.max) else {
+                return nil
+            }
+            let payload = array.asData(access: .noCopyIfContiguous).data
+            var data = Data(capacity: headerSize + array.ndim * 8 + payload.count)
+            data.append(magic)
+            data.append(contentsOf: [version, UInt8(code), UInt8(array.ndim)])
+            data.append(Data(count: headerSize - data.count))
+            for dimension in array.shape {
+                withUnsafeBytes(of: Int64(dimension).littleEndian) { data.append(contentsOf: $0) }
+            }
+            data.append(payload)
+            return data
+        }
+
+        static func decode(_ data: Data) -> MLXArray? {
+            guard data.count >= headerSize,
+                  data.prefix(magic.count) == magic,
+                  data[data.startIndex + 4] == version
+            else {
+                return nil
+            }
+            let code = Int(data[data.startIndex + 5])
+            let rank = Int(data[data.startIndex + 6])
+            guard code < dtypes.count, data.count >= headerSize + rank * 8 else { return nil }
+
+            var shape: [Int] = []
+            for index in 0..<rank {
+                let offset = data.startIndex + headerSize + index * 8
+                var dimension: Int64 = 0
+                withUnsafeMutableBytes(of: &dimension) { $0.copyBytes(from: data[offset..<offset + 8]) }
+                shape.append(Int(Int64(littleEndian: dimension)))
+            }
+
+            let dtype = dtypes[code]
+            let payload = data[(data.startIndex + headerSize + rank * 8)...]
+            guard shape.allSatisfy({ $0 >= 0 }),
+                  payload.count == shape.reduce(1, *) * dtype.size
+            else {
+                return nil
+            }
+            return MLXArray(payload, shape, dtype: dtype)
+        }
+    }
+
+    /// The file persisting `key`, named by a digest of the whole key.
+    nonisolated func persistedURL(for key: CacheKey) -> URL? {
+        guard let directory else { return nil }
+        var digest = SHA256Digest()
+        for part in [key.modelId, key.prompt, key.negativePrompt] {
+            digest.update(Data(part.utf8))
+            digest.update(Data([0]))
+        }
+        return directory
+            .appendingPathComponent(digest.finalize())
+            .appendingPathExtension(PersistedFormat.fileExtension)
+    }
+
+    private nonisolated func loadPersisted(_ key: CacheKey) -> MLXArray? {
+        guard let url = persistedURL(for: key),
+              let data = try? Data(contentsOf: url, options: .alwaysMapped)
+        else {
+            return nil
+        }
+        guard let embedding = PersistedFormat.decode(data) else {
+            diskUsage.withLock { bytes in
+                if (try? FileManager.default.removeItem(at: url)) != nil {
+                    bytes = bytes.map { max(0, $0 - data.count) }
+                }
+            }
+            return nil
+        }
+        // Mark as recently used for disk eviction
+        try? FileManager.default.setAttributes([.modificationDate: Date()], ofItemAtPath: url.path)
+        return embedding
+    }
+
+    private nonisolated func persist(_ embedding: MLXArray, forKey key: CacheKey) {
+        guard let directory, let url = persistedURL(for: key),
+              let data = PersistedFormat.encode(embedding), data.count <= diskLimit
+        else {
+            return
+        }
+        diskUsage.withLock { bytes in
+            var usage = bytes ?? persistedFiles(in: directory).reduce(0) { $0 + fileSize(of: $1) }
+            let replaced = fileSize(of: url)
+            do {
+                try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+                try data.write(to: url, options: .atomic)
+            } catch {
+                bytes = usage
+                return
+            }
+            usage += data.count - replaced
+            if usage > diskLimit {
+                usage = trimPersisted(in: directory, to: diskLimit / 4 * 3)
+            }
+            bytes = usage
+        }
+    }
+
+    /// Removes the least recently used files until the disk tier holds at
+    /// most `target` bytes. Call with ``diskUsage`` locked.
+    ///
+    /// - Returns: The bytes left on disk.
+    private nonisolated func trimPersisted(in directory: URL, to target: Int) -> Int {
+        let keys: Set<URLResourceKey> = [.fileSizeKey, .contentModificationDateKey]
+        var files = persistedFiles(in: directory).map { url in
+            let values = try? url.resourceValues(forKeys: keys)
+            return (url: url, size: values?.fileSize ?? 0, date: values?.contentModificationDate ?? .distantPast)
+        }
+        var total = files.reduce(0) { $0 + $1.size }
+
+        files.sort { $0.date < $1.date }
+        for file in files where total > target {
+            guard (try? FileManager.default.removeItem(at: file.url)) != nil else { continue }
+            total -= file.size
+        }
+        return total
+    }
+
+    private nonisolated func fileSize(of url: URL) -> Int {
+        (try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize ?? 0
+    }
+
+    private nonisolated func persistedFiles(in directory: URL) -> [URL] {
+        let contents = try? FileManager.default.contentsOfDirectory(
+            at: directory,
+            includingPropertiesForKeys: [.fileSizeKey, .contentModificationDateKey],
+            options: [.skipsHiddenFiles]
+        )
+        return (contents ?? []).filter { $0.pathExtension == PersistedFormat.fileExtension }
+    }
+
     // MARK: - Private Helpers
 
     /// Estimates the memory cost of an MLXArray.
@@ -284,6 +500,21 @@ public actor TextEmbeddingCache {
         return totalElements * bytesPerElement
     }
 }
+// MARK: - DiskUsage
+
+/// The byte count of a ``TextEmbeddingCache`` disk tier, `nil` until first counted.
+///
+/// Writes from concurrent `put` calls update it under one lock.
+private final class DiskUsage: @unchecked Sendable {
+    private let lock = NSLock()
+    private var bytes: Int?
+
+    func withLock<T>(_ body: (inout Int?) throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body(&bytes)
+    }
+}
 #endif // CONDUIT_TRAIT_MLX && canImport(MLX)
 
 #endif // CONDUIT_TRAIT_MLX
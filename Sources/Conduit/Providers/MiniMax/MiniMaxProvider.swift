@@ -25,11 +25,14 @@ public actor MiniMaxProvider: AIProvider, TextGenerator {
     }
 
     /// Creates a provider with explicit network tuning settings.
+    ///
+    /// Pass `transport` to share one connection pool across providers.
     public init(
         apiKey: String? = nil,
         baseURL: URL,
         timeout: TimeInterval = 120,
-        maxRetries: Int = 3
+        maxRetries: Int = 3,
+        transport: ConduitTransport? = nil
     ) {
         self.init(
             configuration: MiniMaxConfiguration(
@@ -37,22 +40,29 @@ public actor MiniMaxProvider: AIProvider, TextGenerator {
                 baseURL: baseURL,
                 timeout: timeout,
                 maxRetries: maxRetries
-            )
+            ),
+            transport: transport
         )
     }
 
-    init(configuration: MiniMaxConfiguration) {
+    init(configuration: MiniMaxConfiguration, transport: ConduitTransport? = nil) {
         self.configuration = configuration
 
-        let openAIConfig = OpenAIConfiguration(
+        var openAIConfig = OpenAIConfiguration(
             endpoint: .custom(configuration.baseURL),
             authentication: .bearer(configuration.authentication.apiKey ?? ""),
             timeout: configuration.timeout,
             maxRetries: configuration.maxRetries
         )
+        openAIConfig.transport = transport
         self.internalProvider = OpenAIProvider(configuration: openAIConfig)
     }
 
+    /// Opens a connection to the API ahead of the first request.
+    public func prewarmConnection() async {
+        await internalProvider.prewarmConnection()
+    }
+
     public var isAvailable: Bool {
         get async {
             configuration.hasValidAuthentication
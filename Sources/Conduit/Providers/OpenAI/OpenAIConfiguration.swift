@@ -159,6 +159,53 @@ public struct OpenAIConfiguration: Sendable, Hashable {
     /// Only used when `endpoint` is `.ollama`.
     public var ollamaConfig: OllamaConfiguration?
 
+    // MARK: - Embeddings
+
+    /// How `embedBatch` and `embedMatrix` split inputs into `/embeddings` requests.
+    ///
+    /// Default: ``EmbeddingBatchPolicy/openAI``
+    public var embeddingBatchPolicy: EmbeddingBatchPolicy = .openAI
+
+    // MARK: - Token Counting
+
+    /// Where tiktoken rank files are loaded from for exact token counts.
+    ///
+    /// The default only reads rank files already in the shared cache.
+    /// Use ``OpenAITokenizerSource/automatic`` to download them on first use,
+    /// ``OpenAITokenizerSource/directory(_:)`` to load bundled files, or
+    /// ``OpenAITokenizerSource/estimate`` to skip tokenization entirely.
+    ///
+    /// Default: ``OpenAITokenizerSource/cached``
+    public var tokenizer: OpenAITokenizerSource = .cached
+
+    // MARK: - Transport
+
+    /// HTTP transport shared with other providers.
+    ///
+    /// `nil` gives the provider its own connection pool with ``timeout``
+    /// applied. Not encoded.
+    ///
+    /// Default: `nil`
+    public var transport: ConduitTransport?
+
+    /// Scheduler that paces text generation requests from rate-limit headers.
+    ///
+    /// Requests are keyed by model. Share one scheduler between
+    /// configurations that use the same API key. `nil` disables pacing.
+    /// Not encoded.
+    ///
+    /// Default: `nil`
+    public var rateLimiter: RateLimitScheduler?
+
+    /// Cache of prepared image payloads and Files API references.
+    ///
+    /// Images are downscaled and turned into `data:` URLs once. With the
+    /// Responses API, images registered with a file ID are sent by
+    /// reference. `nil` sends images as supplied. Not encoded.
+    ///
+    /// Default: `nil`
+    public var mediaCache: MediaCache?
+
     // MARK: - Initialization
 
     /// Creates an OpenAI configuration with the specified settings.
@@ -556,6 +603,56 @@ extension OpenAIConfiguration {
         copy.azureConfig = config
         return copy
     }
+
+    /// Returns a copy with the specified embedding batch policy.
+    ///
+    /// - Parameter policy: Request size, token budget and concurrency limits.
+    /// - Returns: A new configuration with the updated policy.
+    func embeddingBatchPolicy(_ policy: EmbeddingBatchPolicy) -> OpenAIConfiguration {
+        var copy = self
+        copy.embeddingBatchPolicy = policy
+        return copy
+    }
+
+    /// Returns a copy with the specified tokenizer source.
+    ///
+    /// - Parameter source: Where tiktoken rank files are loaded from.
+    /// - Returns: A new configuration with the updated source.
+    func tokenizer(_ source: OpenAITokenizerSource) -> OpenAIConfiguration {
+        var copy = self
+        copy.tokenizer = source
+        return copy
+    }
+
+    /// Returns a copy that sends requests through `transport`.
+    ///
+    /// - Parameter transport: The shared transport, or `nil` for a private one.
+    /// - Returns: A new configuration with the updated transport.
+    func transport(_ transport: ConduitTransport?) -> OpenAIConfiguration {
+        var copy = self
+        copy.transport = transport
+        return copy
+    }
+
+    /// Returns a copy that paces requests through `scheduler`.
+    ///
+    /// - Parameter scheduler: The rate-limit scheduler, or `nil` to disable pacing.
+    /// - Returns: A new configuration with the updated scheduler.
+    func rateLimiter(_ scheduler: RateLimitScheduler?) -> OpenAIConfiguration {
+        var copy = self
+        copy.rateLimiter = scheduler
+        return copy
+    }
+
+    /// Returns a copy that prepares images through `cache`.
+    ///
+    /// - Parameter cache: The media cache, or `nil` to send images as supplied.
+    /// - Returns: A new configuration with the updated cache.
+    func mediaCache(_ cache: MediaCache?) -> OpenAIConfiguration {
+        var copy = self
+        copy.mediaCache = cache
+        return copy
+    }
 }
 
 // MARK: - Request Building
@@ -616,7 +713,10 @@ extension OpenAIConfiguration: Codable {
         case organizationID
         case openRouterConfig
         case ollamaConfig
-        // Note: authentication and azureConfig are not encoded for security
+        case embeddingBatchPolicy
+        case tokenizer
+        // Note: authentication and azureConfig are not encoded for security,
+        // and transport, rateLimiter and mediaCache are live objects
     }
 
     public init(from decoder: Decoder) throws {
@@ -634,6 +734,11 @@ extension OpenAIConfiguration: Codable {
         self.openRouterConfig = try container.decodeIfPresent(OpenRouterRoutingConfig.self, forKey: .openRouterConfig)
         self.azureConfig = nil  // Not encoded
         self.ollamaConfig = try container.decodeIfPresent(OllamaConfiguration.self, forKey: .ollamaConfig)
+        self.embeddingBatchPolicy = try container.decodeIfPresent(
+            EmbeddingBatchPolicy.self,
+            forKey: .embeddingBatchPolicy
+        ) ?? .openAI
+        self.tokenizer = try container.decodeIfPresent(OpenAITokenizerSource.self, forKey: .tokenizer) ?? .cached
     }
 
     public func encode(to encoder: Encoder) throws {
@@ -651,6 +756,8 @@ extension OpenAIConfiguration: Codable {
         try container.encodeIfPresent(openRouterConfig, forKey: .openRouterConfig)
         // azureConfig is not encoded for security
         try container.encodeIfPresent(ollamaConfig, forKey: .ollamaConfig)
+        try container.encode(embeddingBatchPolicy, forKey: .embeddingBatchPolicy)
+        try container.encode(tokenizer, forKey: .tokenizer)
     }
 }
 
@@ -336,6 +336,22 @@ public enum OpenAIEndpoint: Sendable, Hashable {
         }
     }
 
+    /// Source name reported to ``ConduitTelemetry``.
+    internal var telemetrySource: String {
+        switch self {
+        case .openAI:
+            return "openai"
+        case .openRouter:
+            return "openrouter"
+        case .ollama:
+            return "ollama"
+        case .azure:
+            return "azure-openai"
+        case .custom(let url):
+            return url.host ?? "custom"
+        }
+    }
+
     /// Human-readable display name.
     public var displayName: String {
         switch self {
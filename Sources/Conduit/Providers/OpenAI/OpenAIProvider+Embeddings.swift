@@ -19,9 +19,74 @@ extension OpenAIProvider {
         _ text: String,
         model: ModelIdentifier
     ) async throws -> EmbeddingResult {
+        let response = try await requestEmbeddings([text], model: model)
+        guard let embedding = response.vectors.first else {
+            throw Self.invalidEmbeddingResponse()
+        }
+
+        return EmbeddingResult(
+            vector: embedding,
+            text: text,
+            model: model.rawValue,
+            tokenCount: response.tokenCount
+        )
+    }
+
+    /// Generates embeddings for multiple texts.
+    ///
+    /// Texts are sent as array `input` requests, split according to
+    /// ``OpenAIConfiguration/embeddingBatchPolicy`` so each request stays
+    /// within the endpoint's input and token limits. Requests run with
+    /// bounded concurrency and results keep the original order.
+    ///
+    /// - Parameters:
+    ///   - texts: Array of text strings to generate embeddings for.
+    ///   - model: The model to use for generating embeddings.
+    /// - Returns: Array of `EmbeddingResult` in the same order as input texts.
+    /// - Throws: `AIError` if any embedding request fails.
+    public func embedBatch(
+        _ texts: [String],
+        model: ModelIdentifier
+    ) async throws -> [EmbeddingResult] {
+        try await embedMatrix(texts, model: model).results
+    }
+
+    /// Generates embeddings for multiple texts into one contiguous buffer.
+    ///
+    /// Uses the same batched requests as ``embedBatch(_:model:)``, but
+    /// skips the per-text arrays.
+    ///
+    /// - Parameters:
+    ///   - texts: Array of text strings to generate embeddings for.
+    ///   - model: The model to use for generating embeddings.
+    /// - Returns: A matrix with one row per input text, in order.
+    /// - Throws: `AIError` if any embedding request fails.
+    public func embedMatrix(
+        _ texts: [String],
+        model: ModelIdentifier
+    ) async throws -> EmbeddingMatrix {
+        try await configuration.embeddingBatchPolicy.embedMatrix(texts, model: model.rawValue) { inputs in
+            try await self.requestEmbeddings(inputs, model: model)
+        }
+    }
+
+    // MARK: - Request Execution
+
+    /// Sends one `/embeddings` request for `inputs`.
+    ///
+    /// A single input is sent as a plain string, which every
+    /// OpenAI-compatible server accepts; larger batches use the array form.
+    ///
+    /// - Returns: One vector per input in input order, and the reported
+    ///   prompt token count.
+    internal func requestEmbeddings(
+        _ inputs: [String],
+        model: ModelIdentifier
+    ) async throws -> (vectors: [[Float]], tokenCount: Int?) {
         let url = configuration.endpoint.embeddingsURL
         var request = URLRequest(url: url)
         request.httpMethod = "POST"
+        request.timeoutInterval = configuration.timeout
 
         // Add headers
         for (name, value) in configuration.buildHeaders() {
@@ -29,14 +94,14 @@ extension OpenAIProvider {
         }
 
         // Build request body
-        let body: [String: Any] = [
-            "model": model.rawValue,
-            "input": text
-        ]
-        request.httpBody = try JSONSerialization.data(withJSONObject: body)
+        let body = OpenAIEmbeddingsRequest(
+            model: model.rawValue,
+            input: inputs.count == 1 ? .single(inputs[0]) : .batch(inputs)
+        )
+        request.httpBody = try JSONEncoder().encode(body)
 
         // Execute request
-        let (data, response) = try await session.data(for: request)
+        let (data, response) = try await transport.data(for: request)
 
         // Check response
         guard let httpResponse = response as? HTTPURLResponse else {
@@ -47,83 +112,80 @@ extension OpenAIProvider {
             throw AIError.serverError(statusCode: httpResponse.statusCode, message: String(data: data, encoding: .utf8))
         }
 
-        // Parse response
-        let json = try JSONSerialization.jsonObject(with: data) as? [String: Any]
-        guard let dataArray = json?["data"] as? [[String: Any]],
-              let first = dataArray.first,
-              let embedding = first["embedding"] as? [Double] else {
-            throw AIError.generationFailed(underlying: SendableError(NSError(
-                domain: "OpenAIProvider",
-                code: -1,
-                userInfo: [NSLocalizedDescriptionKey: "Invalid embedding response"]
-            )))
-        }
-
-        let floatEmbedding = embedding.map { Float($0) }
-        return EmbeddingResult(
-            vector: floatEmbedding,
-            text: text,
-            model: model.rawValue
-        )
+        return try Self.parseEmbeddingsResponse(data, expectedCount: inputs.count)
     }
 
-    /// Generates embeddings for multiple texts.
-    ///
-    /// This method uses concurrent processing with structured concurrency
-    /// to generate embeddings in parallel while preserving the original order.
-    ///
-    /// To prevent rate limiting, concurrency is limited to 10 concurrent requests.
-    /// For large batches, requests are processed in waves.
+    /// Decodes an `/embeddings` response, ordering rows by their `index`.
     ///
-    /// - Parameters:
-    ///   - texts: Array of text strings to generate embeddings for.
-    ///   - model: The model to use for generating embeddings.
-    /// - Returns: Array of `EmbeddingResult` in the same order as input texts.
-    /// - Throws: `AIError` if any embedding generation fails.
-    public func embedBatch(
-        _ texts: [String],
-        model: ModelIdentifier
-    ) async throws -> [EmbeddingResult] {
-        // Limit concurrency to prevent rate limiting
-        let maxConcurrent = 10
-
-        return try await withThrowingTaskGroup(of: (Int, EmbeddingResult).self) { group in
-            var results = [(Int, EmbeddingResult)]()
-            results.reserveCapacity(texts.count)
-
-            var nextIndex = 0
-            let totalCount = texts.count
-
-            // Start initial batch of tasks
-            for index in 0..<min(maxConcurrent, totalCount) {
-                let text = texts[index]
-                group.addTask {
-                    let result = try await self.embed(text, model: model)
-                    return (index, result)
-                }
-                nextIndex = index + 1
+    /// - Throws: `AIError.generationFailed` if the body is malformed or does
+    ///   not contain exactly one embedding per input.
+    internal static func parseEmbeddingsResponse(
+        _ data: Data,
+        expectedCount: Int
+    ) throws -> (vectors: [[Float]], tokenCount: Int?) {
+        guard let decoded = try? JSONDecoder().decode(OpenAIEmbeddingsResponse.self, from: data),
+              decoded.data.count == expectedCount else {
+            throw invalidEmbeddingResponse()
+        }
+
+        var vectors = [[Float]](repeating: [], count: expectedCount)
+        for (position, item) in decoded.data.enumerated() {
+            let index = item.index ?? position
+            guard vectors.indices.contains(index), vectors[index].isEmpty else {
+                throw invalidEmbeddingResponse()
             }
+            vectors[index] = item.embedding
+        }
+        return (vectors, decoded.usage?.promptTokens)
+    }
+
+    private static func invalidEmbeddingResponse() -> AIError {
+        AIError.generationFailed(underlying: SendableError(NSError(
+            domain: "OpenAIProvider",
+            code: -1,
+            userInfo: [NSLocalizedDescriptionKey: "Invalid embedding response"]
+        )))
+    }
+}
+
+// MARK: - Wire Types
+
+/// Request body for `/v1/embeddings`.
+private struct OpenAIEmbeddingsRequest: Encodable {
+    enum Input: Encodable {
+        case single(String)
+        case batch([String])
 
-            // Process results and add new tasks as slots become available
-            while let indexedResult = try await group.next() {
-                results.append(indexedResult)
-
-                // Add next task if there are more texts to process
-                if nextIndex < totalCount {
-                    let index = nextIndex
-                    let text = texts[index]
-                    group.addTask {
-                        let result = try await self.embed(text, model: model)
-                        return (index, result)
-                    }
-                    nextIndex += 1
-                }
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.singleValueContainer()
+            switch self {
+            case .single(let text): try container.encode(text)
+            case .batch(let texts): try container.encode(texts)
             }
+        }
+    }
+
+    let model: String
+    let input: Input
+}
 
-            // Sort by original index to preserve order
-            return results.sorted { $0.0 < $1.0 }.map { $0.1 }
+/// Response body from `/v1/embeddings`.
+private struct OpenAIEmbeddingsResponse: Decodable {
+    struct Item: Decodable {
+        let index: Int?
+        let embedding: [Float]
+    }
+
+    struct Usage: Decodable {
+        let promptTokens: Int?
+
+        enum CodingKeys: String, CodingKey {
+            case promptTokens = "prompt_tokens"
         }
     }
+
+    let data: [Item]
+    let usage: Usage?
 }
 
 #endif // CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
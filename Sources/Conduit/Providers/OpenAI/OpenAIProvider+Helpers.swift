@@ -41,6 +41,7 @@ extension OpenAIProvider {
         let url = configuration.endpoint.textGenerationURL(for: apiVariant)
         var request = URLRequest(url: url)
         request.httpMethod = "POST"
+        request.timeoutInterval = configuration.timeout
 
         // Add headers
         for (name, value) in configuration.buildHeaders() {
@@ -57,8 +58,12 @@ extension OpenAIProvider {
         )
         request.httpBody = try JSONSerialization.data(withJSONObject: body)
 
-        // Execute request with retry
-        let (data, _) = try await executeWithRetry(request: request)
+        // Execute request with retry, paced by the model's rate limits
+        let (data, _) = try await executeWithRetry(
+            request: request,
+            rateLimitKey: model.rawValue,
+            estimatedTokens: RateLimitScheduler.estimatedTokens(for: messages, maxTokens: config.maxTokens)
+        )
 
         // Parse response
         return try parseGenerationResponse(data: data, variant: apiVariant)
@@ -336,10 +341,9 @@ extension OpenAIProvider {
 
         case .image(let imageContent):
             // OpenAI format: image_url with data URL
-            let dataURL = "data:\(imageContent.mimeType);base64,\(imageContent.base64Data)"
             return [
                 "type": "image_url",
-                "image_url": ["url": dataURL]
+                "image_url": ["url": imageDataURL(for: imageContent)]
             ]
 
         case .audio(let audioContent):
@@ -354,9 +358,17 @@ extension OpenAIProvider {
         }
     }
 
+    /// The `data:` URL for an image, built once per image when a
+    /// ``OpenAIConfiguration/mediaCache`` is configured.
+    private nonisolated func imageDataURL(for image: Message.ImageContent) -> String {
+        guard let cache = configuration.mediaCache else {
+            return "data:\(image.mimeType);base64,\(image.base64Data)"
+        }
+        return cache.prepared(image).dataURL
+    }
+
     private nonisolated func serializeSchema(_ schema: GenerationSchema) -> [String: Any] {
-        let resolved = schema.withResolvedRoot() ?? schema
-        return resolved.toJSONSchema()
+        schema.resolvedForProviders().toJSONSchema()
     }
 
     private struct ResponsesSerializedInput {
@@ -437,8 +449,14 @@ extension OpenAIProvider {
                 case .text(let text):
                     return ["type": "input_text", "text": text]
                 case .image(let image):
-                    let dataURL = "data:\(image.mimeType);base64,\(image.base64Data)"
-                    return ["type": "input_image", "image_url": dataURL]
+                    guard let cache = configuration.mediaCache else {
+                        return ["type": "input_image", "image_url": imageDataURL(for: image)]
+                    }
+                    let prepared = cache.prepared(image)
+                    if let fileID = cache.fileReference(for: prepared.key, service: .openAI) {
+                        return ["type": "input_image", "file_id": fileID]
+                    }
+                    return ["type": "input_image", "image_url": prepared.dataURL]
                 case .audio(let audio):
                     return [
                         "type": "input_audio",
@@ -528,7 +546,15 @@ extension OpenAIProvider {
     }
 
     /// Executes a request with retry logic.
-    internal func executeWithRetry(request: URLRequest) async throws -> (Data, URLResponse) {
+    ///
+    /// When `rateLimitKey` is set and the configuration has a
+    /// ``OpenAIConfiguration/rateLimiter``, each attempt waits for budget
+    /// under that key first.
+    internal func executeWithRetry(
+        request: URLRequest,
+        rateLimitKey: String? = nil,
+        estimatedTokens: Int = 0
+    ) async throws -> (Data, URLResponse) {
         var lastError: Error?
 
         for attempt in 0...configuration.maxRetries {
@@ -550,7 +576,13 @@ extension OpenAIProvider {
                     try await Task.sleep(nanoseconds: UInt64(nanoseconds))
                 }
 
-                let (data, response) = try await session.data(for: request)
+                let (data, response) = try await RateLimitScheduler.send(
+                    through: rateLimitKey == nil ? nil : configuration.rateLimiter,
+                    key: rateLimitKey ?? "",
+                    estimatedTokens: estimatedTokens
+                ) {
+                    try await transport.data(for: request)
+                }
 
                 guard let httpResponse = response as? HTTPURLResponse else {
                     throw AIError.networkError(URLError(.badServerResponse))
@@ -918,7 +950,7 @@ extension OpenAIProvider {
         request.timeoutInterval = configuration.ollamaConfig?.healthCheckTimeout ?? 5.0
 
         do {
-            let (_, response) = try await session.data(for: request)
+            let (_, response) = try await transport.data(for: request)
             return (response as? HTTPURLResponse)?.statusCode == 200
         } catch {
             return false
@@ -97,6 +97,7 @@ extension OpenAIProvider {
         let url = configuration.endpoint.imagesGenerationsURL
         var request = URLRequest(url: url)
         request.httpMethod = "POST"
+        request.timeoutInterval = configuration.timeout
 
         for (name, value) in configuration.buildHeaders() {
             request.setValue(value, forHTTPHeaderField: name)
@@ -126,7 +127,7 @@ extension OpenAIProvider {
         // 9. Execute request
         try Task.checkCancellation()
 
-        let (data, response) = try await session.data(for: request)
+        let (data, response) = try await transport.data(for: request)
 
         // 9. Check HTTP status
         if let httpResponse = response as? HTTPURLResponse, httpResponse.statusCode != 200 {
@@ -139,6 +139,7 @@ extension OpenAIProvider {
         let url = configuration.endpoint.textGenerationURL(for: apiVariant)
         var request = URLRequest(url: url)
         request.httpMethod = "POST"
+        request.timeoutInterval = configuration.timeout
 
         // Add headers
         for (name, value) in configuration.buildHeaders() {
@@ -155,8 +156,17 @@ extension OpenAIProvider {
         )
         request.httpBody = try JSONSerialization.data(withJSONObject: body)
 
-        // Execute streaming request (cross-platform)
-        let (bytes, response) = try await session.asyncBytes(for: request)
+        var telemetry = TelemetryStream(source: configuration.endpoint.telemetrySource)
+        defer { telemetry?.finish() }
+
+        // Execute streaming request (cross-platform), paced by the model's rate limits
+        let (bytes, response) = try await RateLimitScheduler.send(
+            through: configuration.rateLimiter,
+            key: model.rawValue,
+            estimatedTokens: RateLimitScheduler.estimatedTokens(for: messages, maxTokens: config.maxTokens)
+        ) {
+            try await transport.asyncBytes(for: request)
+        }
 
         guard let httpResponse = response as? HTTPURLResponse else {
             throw AIError.networkError(URLError(.badServerResponse))
@@ -165,32 +175,25 @@ extension OpenAIProvider {
         guard httpResponse.statusCode == 200 else {
             // Try to read error body with size limit to prevent DoS
             let maxErrorSize = 10_000 // 10KB should be enough for error messages
-            var errorData = Data()
-            errorData.reserveCapacity(maxErrorSize)
-
-            for try await byte in bytes {
-                // Enforce size limit
-                guard errorData.count < maxErrorSize else {
-                    let message = String(data: errorData, encoding: .utf8)
-                    throw AIError.serverError(
-                        statusCode: httpResponse.statusCode,
-                        message: (message ?? "") + " (error message truncated)"
-                    )
-                }
-                errorData.append(byte)
-            }
+            let (errorData, truncated) = try await bytes.chunks.collect(upTo: maxErrorSize)
 
             let message = String(data: errorData, encoding: .utf8)
+            guard !truncated else {
+                throw AIError.serverError(
+                    statusCode: httpResponse.statusCode,
+                    message: (message ?? "") + " (error message truncated)"
+                )
+            }
             throw AIError.serverError(statusCode: httpResponse.statusCode, message: message)
         }
 
         // Parse SSE stream
         var chunkIndex = 0
-        var sseParser = ServerSentEventParser()
+        let chunkDecoder = JSONDecoder()
 
         // Tool call accumulation by index
-        // Each entry tracks: id, name, and accumulated arguments buffer
-        var toolCallAccumulators: [Int: (id: String, name: String, argumentsBuffer: String)] = [:]
+        // Each accumulator parses its arguments incrementally as fragments arrive
+        var toolCallAccumulators: [Int: StreamingToolCallAccumulator] = [:]
         var completedToolCalls: [Transcript.ToolCall] = []
 
         // Reasoning accumulation
@@ -224,29 +227,26 @@ extension OpenAIProvider {
             return details
         }
 
-        func processEventData(_ jsonStr: String) -> Bool {
-            if jsonStr == "[DONE]" {
+        func processEventData(_ event: RawServerSentEvent) -> Bool {
+            if event.isDoneMarker {
                 continuation.finish()
                 return true
             }
 
-            guard let jsonData = jsonStr.data(using: .utf8),
-                  let json = try? JSONSerialization.jsonObject(with: jsonData) as? [String: Any],
-                  let choices = json["choices"] as? [[String: Any]],
-                  let firstChoice = choices.first,
-                  let delta = firstChoice["delta"] as? [String: Any]
+            guard let payload = try? chunkDecoder.decode(OpenAIChatCompletionChunk.self, from: event.data),
+                  let firstChoice = payload.choices.first,
+                  let delta = firstChoice.delta
             else {
                 return false
             }
 
-            let content = delta["content"] as? String
-            let finishReasonStr = firstChoice["finish_reason"] as? String
-            let finishReason = finishReasonStr.flatMap { FinishReason(rawValue: $0) }
+            let content = delta.content
+            let finishReason = firstChoice.finishReason.flatMap { FinishReason(rawValue: $0) }
 
             var hasReasoningUpdate = false
             var reasoningDetailsForChunk: [ReasoningDetail]? = nil
 
-            if let reasoningDelta = delta["reasoning"] as? String, !reasoningDelta.isEmpty {
+            if let reasoningDelta = delta.reasoning, !reasoningDelta.isEmpty {
                 let newSize = reasoningBuffer.count + reasoningDelta.count
                 if newSize > maxReasoningSize {
                     logger.warning("Reasoning text exceeded \(maxReasoningSize) bytes, truncating")
@@ -258,13 +258,13 @@ extension OpenAIProvider {
                 hasReasoningUpdate = true
             }
 
-            if let reasoningDetailsDelta = delta["reasoning_details"] as? [[String: Any]] {
+            if let reasoningDetailsDelta = delta.reasoningDetails {
                 for (fallbackIndex, rd) in reasoningDetailsDelta.enumerated() {
-                    let id = rd["id"] as? String ?? "rd_\(fallbackIndex)"
-                    let type = rd["type"] as? String ?? "reasoning.text"
-                    let format = rd["format"] as? String ?? "unknown"
-                    let index = rd["index"] as? Int ?? fallbackIndex
-                    let fragment = rd["content"] as? String ?? ""
+                    let id = rd.id ?? "rd_\(fallbackIndex)"
+                    let type = rd.type ?? "reasoning.text"
+                    let format = rd.format ?? "unknown"
+                    let index = rd.index ?? fallbackIndex
+                    let fragment = rd.content ?? ""
 
                     var acc = reasoningDetailBuffers[id] ?? ReasoningAccumulator(
                         id: id,
@@ -302,13 +302,13 @@ extension OpenAIProvider {
 
             // Process tool calls if present in delta
             var partialToolCall: PartialToolCall?
-            if let toolCalls = delta["tool_calls"] as? [[String: Any]] {
+            if let toolCalls = delta.toolCalls {
                 for tc in toolCalls {
-                    guard let index = tc["index"] as? Int else { continue }
+                    guard let index = tc.index else { continue }
 
                     // Validate index is within reasonable bounds (0...100)
                     guard (0...100).contains(index) else {
-                        let toolName = (tc["function"] as? [String: Any])?["name"] as? String ?? "unknown"
+                        let toolName = tc.function?.name ?? "unknown"
                         logger.warning(
                             "Skipping tool call '\(toolName)' with invalid index \(index) (must be 0...100)"
                         )
@@ -316,30 +316,22 @@ extension OpenAIProvider {
                     }
 
                     // First chunk for this tool call has id, type, and function name
-                    if let id = tc["id"] as? String,
-                       let function = tc["function"] as? [String: Any],
-                       let name = function["name"] as? String {
+                    if let id = tc.id, let name = tc.function?.name {
                         // Initialize accumulator with initial arguments (if any)
-                        let args = function["arguments"] as? String ?? ""
-                        toolCallAccumulators[index] = (id: id, name: name, argumentsBuffer: args)
-                    } else if let function = tc["function"] as? [String: Any],
-                              let argsFragment = function["arguments"] as? String {
+                        toolCallAccumulators[index] = StreamingToolCallAccumulator(
+                            id: id,
+                            name: name,
+                            index: index,
+                            maximumArgumentsSize: maxToolArgumentsSize,
+                            arguments: tc.function?.arguments ?? ""
+                        )
+                    } else if let argsFragment = tc.function?.arguments {
                         // Append to existing accumulator with buffer size check
                         if var acc = toolCallAccumulators[index] {
-                            // Pre-allocate capacity on first append to avoid O(n²) string concatenation
-                            if acc.argumentsBuffer.isEmpty {
-                                acc.argumentsBuffer.reserveCapacity(min(4096, maxToolArgumentsSize))
-                            }
-
-                            let newSize = acc.argumentsBuffer.count + argsFragment.count
-                            if newSize > maxToolArgumentsSize {
+                            if !acc.append(argsFragment) {
                                 logger.warning(
                                     "Tool call '\(acc.name)' arguments exceeded \(maxToolArgumentsSize) bytes, truncating"
                                 )
-                                let remaining = max(0, maxToolArgumentsSize - acc.argumentsBuffer.count)
-                                acc.argumentsBuffer += String(argsFragment.prefix(remaining))
-                            } else {
-                                acc.argumentsBuffer += argsFragment
                             }
                             toolCallAccumulators[index] = acc
                         }
@@ -347,12 +339,7 @@ extension OpenAIProvider {
 
                     // Create partial tool call for streaming updates
                     if let acc = toolCallAccumulators[index] {
-                        partialToolCall = PartialToolCall(
-                            id: acc.id,
-                            toolName: acc.name,
-                            index: index,
-                            argumentsFragment: acc.argumentsBuffer
-                        )
+                        partialToolCall = acc.partialToolCall
                     }
                 }
             }
@@ -366,39 +353,18 @@ extension OpenAIProvider {
                 // Finalize all accumulated tool calls
                 for (index, acc) in toolCallAccumulators.sorted(by: { $0.key < $1.key }) {
                     do {
-                        let toolCall = try Transcript.ToolCall(
-                            id: acc.id,
-                            toolName: acc.name,
-                            argumentsJSON: acc.argumentsBuffer
-                        )
+                        let (toolCall, wasRepaired) = try acc.makeToolCall()
                         completedToolCalls.append(toolCall)
-                        logger.debug("Parsed tool call '\(acc.name)' at index \(index)")
-                    } catch {
-                        // Try to repair incomplete JSON before giving up
-                        let repairedJson = JsonRepair.repair(acc.argumentsBuffer)
-                        if repairedJson != acc.argumentsBuffer {
-                            logger.debug("Attempting JSON repair for '\(acc.name)'")
-                            do {
-                                let toolCall = try Transcript.ToolCall(
-                                    id: acc.id,
-                                    toolName: acc.name,
-                                    argumentsJSON: repairedJson
-                                )
-                                completedToolCalls.append(toolCall)
-                                logger.info("Recovered tool call '\(acc.name)' via JSON repair")
-                            } catch {
-                                logger.warning(
-                                    "Failed to parse tool call '\(acc.name)' even after repair: \(error.localizedDescription)"
-                                )
-                                logger.debug("Original JSON: \(acc.argumentsBuffer.prefix(500))")
-                                logger.debug("Repaired JSON: \(repairedJson.prefix(500))")
-                            }
+                        if wasRepaired {
+                            logger.info("Recovered tool call '\(acc.name)' from incomplete arguments")
                         } else {
-                            logger.warning(
-                                "Failed to parse tool call '\(acc.name)': \(error.localizedDescription)"
-                            )
-                            logger.debug("Malformed JSON buffer: \(acc.argumentsBuffer.prefix(500))")
+                            logger.debug("Parsed tool call '\(acc.name)' at index \(index)")
                         }
+                    } catch {
+                        logger.warning(
+                            "Failed to parse tool call '\(acc.name)': \(error.localizedDescription)"
+                        )
+                        logger.debug("Malformed JSON buffer: \(acc.argumentsBuffer.prefix(500))")
                     }
                 }
 
@@ -468,37 +434,38 @@ extension OpenAIProvider {
             return false
         }
 
-        for try await line in bytes.lines {
+        for try await event in bytes.chunks.serverSentEvents {
             try Task.checkCancellation()
 
-            for event in sseParser.ingestLine(line) {
-                if processEventData(event.data) {
-                    return
-                }
-            }
-        }
-
-        for event in sseParser.finish() {
-            if processEventData(event.data) {
+            let yieldedChunks = chunkIndex
+            if processEventData(event) {
                 return
             }
+            if chunkIndex > yieldedChunks {
+                telemetry?.chunkReceived()
+            }
         }
 
         continuation.finish()
     }
 
     internal nonisolated func decodeResponsesEventData(_ jsonStr: String) -> ResponsesStreamEvent? {
-        guard let jsonData = jsonStr.data(using: .utf8),
-              let json = try? JSONSerialization.jsonObject(with: jsonData) as? [String: Any],
-              let type = json["type"] as? String else {
+        decodeResponsesEventData(Data(jsonStr.utf8))
+    }
+
+    internal nonisolated func decodeResponsesEventData(
+        _ jsonData: Data,
+        decoder: JSONDecoder = JSONDecoder()
+    ) -> ResponsesStreamEvent? {
+        guard let payload = try? decoder.decode(OpenAIResponsesStreamPayload.self, from: jsonData) else {
             return nil
         }
 
-        switch type {
+        switch payload.type {
         case "response.output_text.delta":
             return ResponsesStreamEvent(
                 kind: .outputTextDelta,
-                textDelta: json["delta"] as? String,
+                textDelta: payload.delta,
                 toolCallID: nil,
                 toolName: nil,
                 argumentsFragment: nil,
@@ -514,23 +481,22 @@ extension OpenAIProvider {
                 toolCallID: nil,
                 toolName: nil,
                 argumentsFragment: nil,
-                reasoningDelta: json["delta"] as? String,
+                reasoningDelta: payload.delta,
                 finishReason: nil,
                 usage: nil
             )
 
         case "response.tool_call.created", "response.tool_call.delta":
-            let toolCall = (json["tool_call"] as? [String: Any]) ?? json
-            let kind: ResponsesStreamEvent.Kind = (type == "response.tool_call.created") ? .toolCallCreated : .toolCallDelta
-            let argumentsFragment = (toolCall["arguments_delta"] as? String)
-                ?? (toolCall["delta"] as? String)
-                ?? (toolCall["arguments"] as? String)
+            let toolCall = payload.toolCall ?? payload.topLevelToolCall
+            let kind: ResponsesStreamEvent.Kind =
+                (payload.type == "response.tool_call.created") ? .toolCallCreated : .toolCallDelta
+            let argumentsFragment = toolCall?.argumentsDelta ?? toolCall?.delta ?? toolCall?.arguments
 
             return ResponsesStreamEvent(
                 kind: kind,
                 textDelta: nil,
-                toolCallID: (toolCall["call_id"] as? String) ?? (toolCall["id"] as? String),
-                toolName: toolCall["name"] as? String,
+                toolCallID: toolCall?.callID ?? toolCall?.id,
+                toolName: toolCall?.name,
                 argumentsFragment: argumentsFragment,
                 reasoningDelta: nil,
                 finishReason: nil,
@@ -538,11 +504,8 @@ extension OpenAIProvider {
             )
 
         case "response.completed":
-            let responsePayload = json["response"] as? [String: Any]
-            let finishReasonString = (responsePayload?["finish_reason"] as? String)
-                ?? (json["finish_reason"] as? String)
-            let usagePayload = (responsePayload?["usage"] as? [String: Any])
-                ?? (json["usage"] as? [String: Any])
+            let finishReasonString = payload.response?.finishReason ?? payload.finishReason
+            let usage = payload.response?.usage ?? payload.usage
 
             return ResponsesStreamEvent(
                 kind: .completed,
@@ -552,7 +515,7 @@ extension OpenAIProvider {
                 argumentsFragment: nil,
                 reasoningDelta: nil,
                 finishReason: mapResponsesFinishReason(finishReasonString),
-                usage: parseResponsesUsage(usagePayload)
+                usage: usage?.usageStats
             )
 
         default:
@@ -569,13 +532,6 @@ extension OpenAIProvider {
         }
     }
 
-    private struct ResponsesToolAccumulator {
-        var id: String
-        var name: String
-        var index: Int
-        var argumentsBuffer: String
-    }
-
     private func performResponsesStreamingGeneration(
         messages: [Message],
         model: ModelIdentifier,
@@ -585,6 +541,7 @@ extension OpenAIProvider {
         let url = configuration.endpoint.textGenerationURL(for: .responses)
         var request = URLRequest(url: url)
         request.httpMethod = "POST"
+        request.timeoutInterval = configuration.timeout
 
         for (name, value) in configuration.buildHeaders() {
             request.setValue(value, forHTTPHeaderField: name)
@@ -599,34 +556,37 @@ extension OpenAIProvider {
         )
         request.httpBody = try JSONSerialization.data(withJSONObject: body)
 
-        let (bytes, response) = try await session.asyncBytes(for: request)
+        var telemetry = TelemetryStream(source: configuration.endpoint.telemetrySource)
+        defer { telemetry?.finish() }
+
+        let (bytes, response) = try await RateLimitScheduler.send(
+            through: configuration.rateLimiter,
+            key: model.rawValue,
+            estimatedTokens: RateLimitScheduler.estimatedTokens(for: messages, maxTokens: config.maxTokens)
+        ) {
+            try await transport.asyncBytes(for: request)
+        }
         guard let httpResponse = response as? HTTPURLResponse else {
             throw AIError.networkError(URLError(.badServerResponse))
         }
 
         guard httpResponse.statusCode == 200 else {
             let maxErrorSize = 10_000
-            var errorData = Data()
-            errorData.reserveCapacity(maxErrorSize)
-
-            for try await byte in bytes {
-                guard errorData.count < maxErrorSize else {
-                    let message = String(data: errorData, encoding: .utf8)
-                    throw AIError.serverError(
-                        statusCode: httpResponse.statusCode,
-                        message: (message ?? "") + " (error message truncated)"
-                    )
-                }
-                errorData.append(byte)
-            }
+            let (errorData, truncated) = try await bytes.chunks.collect(upTo: maxErrorSize)
 
             let message = String(data: errorData, encoding: .utf8)
+            guard !truncated else {
+                throw AIError.serverError(
+                    statusCode: httpResponse.statusCode,
+                    message: (message ?? "") + " (error message truncated)"
+                )
+            }
             throw AIError.serverError(statusCode: httpResponse.statusCode, message: message)
         }
 
-        var sseParser = ServerSentEventParser()
+        let eventDecoder = JSONDecoder()
         var reasoningBuffer = ""
-        var toolAccumulatorsByID: [String: ResponsesToolAccumulator] = [:]
+        var toolAccumulatorsByID: [String: StreamingToolCallAccumulator] = [:]
         var nextToolIndex = 0
 
         func finalizeToolCalls() -> [Transcript.ToolCall] {
@@ -634,22 +594,10 @@ extension OpenAIProvider {
                 .sorted(by: { $0.index < $1.index })
                 .compactMap { acc in
                     do {
-                        return try Transcript.ToolCall(
-                            id: acc.id,
-                            toolName: acc.name,
-                            argumentsJSON: acc.argumentsBuffer
-                        )
+                        return try acc.makeToolCall().toolCall
                     } catch {
-                        let repairedJSON = JsonRepair.repair(acc.argumentsBuffer)
-                        guard repairedJSON != acc.argumentsBuffer else {
-                            logger.warning("Failed to parse Responses tool call '\(acc.name)': \(error.localizedDescription)")
-                            return nil
-                        }
-                        return try? Transcript.ToolCall(
-                            id: acc.id,
-                            toolName: acc.name,
-                            argumentsJSON: repairedJSON
-                        )
+                        logger.warning("Failed to parse Responses tool call '\(acc.name)': \(error.localizedDescription)")
+                        return nil
                     }
                 }
         }
@@ -667,108 +615,92 @@ extension OpenAIProvider {
             ]
         }
 
-        for try await line in bytes.lines {
+        for try await event in bytes.chunks.serverSentEvents {
             try Task.checkCancellation()
 
-            for event in sseParser.ingestLine(line) {
-                if event.data == "[DONE]" {
-                    continuation.finish()
-                    return
-                }
+            if event.isDoneMarker {
+                continuation.finish()
+                return
+            }
 
-                guard let decoded = decodeResponsesEventData(event.data) else {
-                    continue
-                }
+            guard let decoded = decodeResponsesEventData(event.data, decoder: eventDecoder) else {
+                continue
+            }
 
-                switch decoded.kind {
-                case .outputTextDelta:
-                    let text = decoded.textDelta ?? ""
-                    guard !text.isEmpty else { continue }
-                    continuation.yield(GenerationChunk(text: text, isComplete: false))
-
-                case .reasoningDelta:
-                    guard let fragment = decoded.reasoningDelta, !fragment.isEmpty else { continue }
-                    let newSize = reasoningBuffer.count + fragment.count
-                    if newSize > maxReasoningSize {
-                        let remaining = max(0, maxReasoningSize - reasoningBuffer.count)
-                        reasoningBuffer += String(fragment.prefix(remaining))
-                    } else {
-                        reasoningBuffer += fragment
-                    }
+            switch decoded.kind {
+            case .outputTextDelta:
+                let text = decoded.textDelta ?? ""
+                guard !text.isEmpty else { continue }
+                telemetry?.chunkReceived()
+                continuation.yield(GenerationChunk(text: text, isComplete: false))
 
-                    continuation.yield(GenerationChunk(
-                        text: "",
-                        tokenCount: 0,
-                        isComplete: false,
-                        reasoningDetails: currentReasoningDetails()
-                    ))
-
-                case .toolCallCreated, .toolCallDelta:
-                    guard let callID = decoded.toolCallID else { continue }
-                    var accumulator = toolAccumulatorsByID[callID] ?? ResponsesToolAccumulator(
-                        id: callID,
-                        name: decoded.toolName ?? "unknown_tool",
-                        index: nextToolIndex,
-                        argumentsBuffer: ""
-                    )
+            case .reasoningDelta:
+                guard let fragment = decoded.reasoningDelta, !fragment.isEmpty else { continue }
+                let newSize = reasoningBuffer.count + fragment.count
+                if newSize > maxReasoningSize {
+                    let remaining = max(0, maxReasoningSize - reasoningBuffer.count)
+                    reasoningBuffer += String(fragment.prefix(remaining))
+                } else {
+                    reasoningBuffer += fragment
+                }
 
-                    if toolAccumulatorsByID[callID] == nil {
-                        nextToolIndex += 1
-                    }
+                telemetry?.chunkReceived()
+                continuation.yield(GenerationChunk(
+                    text: "",
+                    tokenCount: 0,
+                    isComplete: false,
+                    reasoningDetails: currentReasoningDetails()
+                ))
 
-                    if let name = decoded.toolName, !name.isEmpty {
-                        accumulator.name = name
-                    }
+            case .toolCallCreated, .toolCallDelta:
+                guard let callID = decoded.toolCallID else { continue }
+                var accumulator = toolAccumulatorsByID[callID] ?? StreamingToolCallAccumulator(
+                    id: callID,
+                    name: decoded.toolName ?? "unknown_tool",
+                    index: nextToolIndex,
+                    maximumArgumentsSize: maxToolArgumentsSize
+                )
 
-                    if let argumentsFragment = decoded.argumentsFragment, !argumentsFragment.isEmpty {
-                        let newSize = accumulator.argumentsBuffer.count + argumentsFragment.count
-                        if newSize > maxToolArgumentsSize {
-                            let remaining = max(0, maxToolArgumentsSize - accumulator.argumentsBuffer.count)
-                            accumulator.argumentsBuffer += String(argumentsFragment.prefix(remaining))
-                        } else {
-                            accumulator.argumentsBuffer += argumentsFragment
-                        }
-                    }
+                if toolAccumulatorsByID[callID] == nil {
+                    nextToolIndex += 1
+                }
 
-                    toolAccumulatorsByID[callID] = accumulator
-
-                    continuation.yield(GenerationChunk(
-                        text: "",
-                        tokenCount: 0,
-                        isComplete: false,
-                        partialToolCall: PartialToolCall(
-                            id: accumulator.id,
-                            toolName: accumulator.name,
-                            index: accumulator.index,
-                            argumentsFragment: accumulator.argumentsBuffer
-                        ),
-                        reasoningDetails: currentReasoningDetails()
-                    ))
-
-                case .completed:
-                    let completedToolCalls = finalizeToolCalls()
-                    let finishReason = decoded.finishReason ?? (completedToolCalls.isEmpty ? .stop : .toolCalls)
-                    continuation.yield(GenerationChunk(
-                        text: "",
-                        tokenCount: 0,
-                        isComplete: true,
-                        finishReason: finishReason,
-                        usage: decoded.usage,
-                        completedToolCalls: completedToolCalls.isEmpty ? nil : completedToolCalls,
-                        reasoningDetails: currentReasoningDetails()
-                    ))
-                    continuation.finish()
-                    return
+                if let name = decoded.toolName, !name.isEmpty {
+                    accumulator.name = name
+                }
 
-                case .ignored:
-                    continue
+                if let argumentsFragment = decoded.argumentsFragment {
+                    accumulator.append(argumentsFragment)
                 }
-            }
-        }
 
-        for event in sseParser.finish() {
-            if event.data == "[DONE]" {
-                break
+                toolAccumulatorsByID[callID] = accumulator
+
+                telemetry?.chunkReceived()
+                continuation.yield(GenerationChunk(
+                    text: "",
+                    tokenCount: 0,
+                    isComplete: false,
+                    partialToolCall: accumulator.partialToolCall,
+                    reasoningDetails: currentReasoningDetails()
+                ))
+
+            case .completed:
+                let completedToolCalls = finalizeToolCalls()
+                let finishReason = decoded.finishReason ?? (completedToolCalls.isEmpty ? .stop : .toolCalls)
+                continuation.yield(GenerationChunk(
+                    text: "",
+                    tokenCount: 0,
+                    isComplete: true,
+                    finishReason: finishReason,
+                    usage: decoded.usage,
+                    completedToolCalls: completedToolCalls.isEmpty ? nil : completedToolCalls,
+                    reasoningDetails: currentReasoningDetails()
+                ))
+                continuation.finish()
+                return
+
+            case .ignored:
+                continue
             }
         }
 
@@ -793,17 +725,6 @@ extension OpenAIProvider {
             return nil
         }
     }
-
-    private nonisolated func parseResponsesUsage(_ usagePayload: [String: Any]?) -> UsageStats? {
-        guard let usagePayload else { return nil }
-        let inputTokens = (usagePayload["input_tokens"] as? Int)
-            ?? (usagePayload["prompt_tokens"] as? Int)
-            ?? 0
-        let outputTokens = (usagePayload["output_tokens"] as? Int)
-            ?? (usagePayload["completion_tokens"] as? Int)
-            ?? 0
-        return UsageStats(promptTokens: inputTokens, completionTokens: outputTokens)
-    }
 }
 
 #endif // CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
@@ -87,8 +87,8 @@ public actor OpenAIProvider: AIProvider, TextGenerator, EmbeddingGenerator, Toke
     /// The configuration for this provider.
     nonisolated let configuration: OpenAIConfiguration
 
-    /// The URLSession used for HTTP requests.
-    internal let session: URLSession
+    /// The transport used for HTTP requests.
+    internal let transport: ConduitTransport
 
     /// Active generation task for cancellation.
     private var activeTask: Task<Void, Never>?
@@ -110,10 +110,7 @@ public actor OpenAIProvider: AIProvider, TextGenerator, EmbeddingGenerator, Toke
     public init(configuration: OpenAIConfiguration) {
         self.configuration = configuration
 
-        let sessionConfig = URLSessionConfiguration.default
-        sessionConfig.timeoutIntervalForRequest = configuration.timeout
-        sessionConfig.timeoutIntervalForResource = configuration.timeout * 2
-        self.session = URLSession(configuration: sessionConfig)
+        self.transport = ConduitTransport.resolve(configuration.transport, timeout: configuration.timeout)
 
         self.encoder = JSONEncoder()
         self.decoder = JSONDecoder()
@@ -146,6 +143,14 @@ public actor OpenAIProvider: AIProvider, TextGenerator, EmbeddingGenerator, Toke
         self.init(configuration: OpenAIConfiguration(endpoint: endpoint, authentication: auth))
     }
 
+    /// Opens a connection to the configured endpoint ahead of the first request.
+    ///
+    /// Resolves DNS and completes the TLS handshake so the first generation
+    /// does not pay for them. Failures are ignored.
+    public func prewarmConnection() async {
+        await transport.prewarm(configuration.endpoint.baseURL)
+    }
+
     // MARK: - AIProvider Protocol
 
     /// Whether this provider is currently available.
@@ -222,75 +227,85 @@ public actor OpenAIProvider: AIProvider, TextGenerator, EmbeddingGenerator, Toke
 
     // MARK: - TokenCounter Protocol
 
-    /// Counts tokens in text (estimated).
+    /// Counts tokens in text.
     ///
-    /// - Important: This method uses a rough estimate of approximately 4 characters per token,
-    ///   which may be inaccurate for:
-    ///   - Non-English text (typically uses more tokens)
-    ///   - Code or technical content (variable token density)
-    ///   - Text with many special characters or unicode
-    ///   - Structured data formats (JSON, XML, etc.)
+    /// OpenAI models (GPT-3.5 through GPT-5 and the o-series) are counted
+    /// exactly with an in-process tiktoken-compatible tokenizer, loaded as
+    /// described by ``OpenAIConfiguration/tokenizer``.
     ///
-    /// For accurate token counting, consider:
-    /// - Using OpenAI's `tiktoken` library for client-side counting
-    /// - Calling the token counting API endpoint directly
-    /// - Testing with your specific content and model to calibrate estimates
+    /// Other models, or any model when the rank file cannot be loaded, fall
+    /// back to an estimate of about 4 characters per token with
+    /// `isEstimate == true`. The estimate can be off by ±50% or more for
+    /// non-English text, code and structured data.
     ///
     /// - Parameters:
     ///   - text: The text to count tokens for.
-    ///   - model: The model identifier (used for future model-specific counting).
-    /// - Returns: An estimated token count.
-    /// - Note: Estimates assume English prose. Actual counts may vary by ±50% or more.
+    ///   - model: The model identifier, which selects the encoding.
+    /// - Returns: The token count, flagged when estimated.
     public func countTokens(
         in text: String,
         for model: ModelIdentifier
     ) async throws -> TokenCount {
-        // Use a simple estimation: ~4 characters per token
-        let estimatedTokens = max(1, text.count / 4)
-        return TokenCount(count: estimatedTokens, isEstimate: true)
+        guard let tokenizer = await tokenizer(for: model) else {
+            // Use a simple estimation: ~4 characters per token
+            let estimatedTokens = max(1, text.count / 4)
+            return TokenCount(count: estimatedTokens, isEstimate: true)
+        }
+        return TokenCount(count: tokenizer.count(text), isEstimate: false)
     }
 
-    /// Counts tokens in messages (estimated).
+    /// Counts tokens in messages, including chat formatting overhead.
     ///
-    /// - Important: This method uses a rough estimate of approximately 4 characters per token,
-    ///   plus 4 tokens of overhead per message, which may be inaccurate for:
-    ///   - Non-English text (typically uses more tokens)
-    ///   - Code or technical content (variable token density)
-    ///   - Text with many special characters or unicode
-    ///   - Structured data formats (JSON, XML, etc.)
+    /// With a tokenizer, each message costs its role and content tokens plus
+    /// 3 tokens of framing, and 3 more are added for the assistant reply
+    /// primer, matching OpenAI's published counting recipe. Large message
+    /// arrays are counted in parallel.
     ///
-    /// For accurate token counting, consider:
-    /// - Using OpenAI's `tiktoken` library for client-side counting
-    /// - Calling the token counting API endpoint directly
-    /// - Testing with your specific content and model to calibrate estimates
+    /// Without a tokenizer, the
+    /// estimate is about 4 characters per token plus 4 tokens per message,
+    /// with `isEstimate == true`.
     ///
     /// - Parameters:
     ///   - messages: The messages to count tokens for.
-    ///   - model: The model identifier (used for future model-specific counting).
-    /// - Returns: An estimated total token count including message overhead.
-    /// - Note: Estimates assume English prose and include per-message formatting overhead.
-    ///   Actual counts may vary by ±50% or more depending on content characteristics.
+    ///   - model: The model identifier, which selects the encoding.
+    /// - Returns: The total token count, flagged when estimated.
     public func countTokens(
         in messages: [Message],
         for model: ModelIdentifier
     ) async throws -> TokenCount {
-        // Estimate tokens for each message plus overhead
-        var totalTokens = 0
-        for message in messages {
-            let textTokens = max(1, message.content.textValue.count / 4)
-            totalTokens += textTokens + 4  // 4 tokens overhead per message
+        guard let tokenizer = await tokenizer(for: model) else {
+            // Estimate tokens for each message plus overhead
+            var totalTokens = 0
+            for message in messages {
+                let textTokens = max(1, message.content.textValue.count / 4)
+                totalTokens += textTokens + 4  // 4 tokens overhead per message
+            }
+            return TokenCount(count: totalTokens, isEstimate: true)
         }
-        return TokenCount(count: totalTokens, isEstimate: true)
+
+        let contentTokens = await Self.countMessageTokens(messages, with: tokenizer)
+        let framingTokens = messages.count * Self.tokensPerMessage + Self.tokensPerReplyPrimer
+        return TokenCount(count: contentTokens + framingTokens, isEstimate: false)
     }
 
-    /// Encodes text to tokens (not supported - throws error).
+    /// Encodes text to tokens with the model's tiktoken encoding.
+    ///
+    /// Special-token strings such as `<|endoftext|>` are encoded as ordinary
+    /// text.
+    ///
+    /// - Throws: `AIError.providerUnavailable` if the model has no known
+    ///   encoding or its rank file cannot be loaded.
     public func encode(_ text: String, for model: ModelIdentifier) async throws -> [Int] {
-        throw AIError.providerUnavailable(reason: .unknown("Token encoding not supported for OpenAI provider"))
+        try await requireTokenizer(for: model).encode(text)
     }
 
-    /// Decodes tokens to text (not supported - throws error).
+    /// Decodes tokens to text with the model's tiktoken encoding.
+    ///
+    /// - Throws: `AIError.providerUnavailable` if the model has no known
+    ///   encoding or its rank file cannot be loaded, or `AIError.invalidInput`
+    ///   for tokens outside the vocabulary.
     public func decode(_ tokens: [Int], for model: ModelIdentifier, skipSpecialTokens: Bool) async throws -> String {
-        throw AIError.providerUnavailable(reason: .unknown("Token decoding not supported for OpenAI provider"))
+        try await requireTokenizer(for: model).decode(tokens, skipSpecialTokens: skipSpecialTokens)
     }
 
     // MARK: - Capabilities
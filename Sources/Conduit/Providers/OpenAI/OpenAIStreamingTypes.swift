@@ -0,0 +1,260 @@
+// OpenAIStreamingTypes.swift
+// Conduit
+//
+// Typed DTOs for OpenAI-compatible streaming payloads (chat-completions
+// deltas and Responses API events).
+
+#if CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
+import Foundation
+
+// MARK: - Chat Completions
+
+/// A single `chat.completion.chunk` payload from a chat-completions stream.
+///
+/// Only the fields Conduit consumes are modeled, and every field is optional.
+/// Fields with unexpected types are dropped individually rather than failing
+/// the whole chunk, matching the tolerance of dictionary-based parsing while
+/// decoding straight from the SSE `data` bytes.
+///
+/// ## JSON Structure
+/// ```json
+/// {
+///   "choices": [{
+///     "index": 0,
+///     "delta": { "content": "Hel", "tool_calls": [...] },
+///     "finish_reason": null
+///   }]
+/// }
+/// ```
+internal struct OpenAIChatCompletionChunk: Decodable, Sendable {
+
+    /// The choices in this chunk. Conduit reads the first choice only.
+    let choices: [Choice]
+
+    enum CodingKeys: String, CodingKey {
+        case choices
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        self.choices = (try? container.decodeIfPresent([Choice].self, forKey: .choices)) ?? []
+    }
+
+    // MARK: - Choice
+
+    struct Choice: Decodable, Sendable {
+        let delta: Delta?
+        let finishReason: String?
+
+        enum CodingKeys: String, CodingKey {
+            case delta
+            case finishReason = "finish_reason"
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.delta = try? container.decodeIfPresent(Delta.self, forKey: .delta)
+            self.finishReason = try? container.decodeIfPresent(String.self, forKey: .finishReason)
+        }
+    }
+
+    // MARK: - Delta
+
+    struct Delta: Decodable, Sendable {
+        let content: String?
+        let reasoning: String?
+        let reasoningDetails: [ReasoningDetailDelta]?
+        let toolCalls: [ToolCallDelta]?
+
+        enum CodingKeys: String, CodingKey {
+            case content
+            case reasoning
+            case reasoningDetails = "reasoning_details"
+            case toolCalls = "tool_calls"
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.content = try? container.decodeIfPresent(String.self, forKey: .content)
+            self.reasoning = try? container.decodeIfPresent(String.self, forKey: .reasoning)
+            self.reasoningDetails = try? container.decodeIfPresent(
+                [ReasoningDetailDelta].self,
+                forKey: .reasoningDetails
+            )
+            self.toolCalls = try? container.decodeIfPresent([ToolCallDelta].self, forKey: .toolCalls)
+        }
+    }
+
+    // MARK: - Reasoning Detail
+
+    struct ReasoningDetailDelta: Decodable, Sendable {
+        let id: String?
+        let type: String?
+        let format: String?
+        let index: Int?
+        let content: String?
+
+        enum CodingKeys: String, CodingKey {
+            case id, type, format, index, content
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.id = try? container.decodeIfPresent(String.self, forKey: .id)
+            self.type = try? container.decodeIfPresent(String.self, forKey: .type)
+            self.format = try? container.decodeIfPresent(String.self, forKey: .format)
+            self.index = try? container.decodeIfPresent(Int.self, forKey: .index)
+            self.content = try? container.decodeIfPresent(String.self, forKey: .content)
+        }
+    }
+
+    // MARK: - Tool Call
+
+    struct ToolCallDelta: Decodable, Sendable {
+        let index: Int?
+        let id: String?
+        let function: FunctionDelta?
+
+        enum CodingKeys: String, CodingKey {
+            case index, id, function
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.index = try? container.decodeIfPresent(Int.self, forKey: .index)
+            self.id = try? container.decodeIfPresent(String.self, forKey: .id)
+            self.function = try? container.decodeIfPresent(FunctionDelta.self, forKey: .function)
+        }
+    }
+
+    struct FunctionDelta: Decodable, Sendable {
+        let name: String?
+        let arguments: String?
+
+        enum CodingKeys: String, CodingKey {
+            case name, arguments
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.name = try? container.decodeIfPresent(String.self, forKey: .name)
+            self.arguments = try? container.decodeIfPresent(String.self, forKey: .arguments)
+        }
+    }
+}
+
+// MARK: - Responses API
+
+/// A single Responses API streaming event payload.
+///
+/// Tool-call fields may appear either nested under `tool_call` or at the top
+/// level of the event, depending on the server; both placements are decoded.
+internal struct OpenAIResponsesStreamPayload: Decodable, Sendable {
+    let type: String
+    let delta: String?
+    let toolCall: ToolCallFields?
+    let topLevelToolCall: ToolCallFields?
+    let response: ResponseFields?
+    let finishReason: String?
+    let usage: Usage?
+
+    enum CodingKeys: String, CodingKey {
+        case type
+        case delta
+        case toolCall = "tool_call"
+        case response
+        case finishReason = "finish_reason"
+        case usage
+    }
+
+    init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        let type = try container.decode(String.self, forKey: .type)
+        self.type = type
+        self.delta = try? container.decodeIfPresent(String.self, forKey: .delta)
+        self.toolCall = try? container.decodeIfPresent(ToolCallFields.self, forKey: .toolCall)
+        self.topLevelToolCall = type.hasPrefix("response.tool_call.") ? try? ToolCallFields(from: decoder) : nil
+        self.response = try? container.decodeIfPresent(ResponseFields.self, forKey: .response)
+        self.finishReason = try? container.decodeIfPresent(String.self, forKey: .finishReason)
+        self.usage = try? container.decodeIfPresent(Usage.self, forKey: .usage)
+    }
+
+    // MARK: - Tool Call
+
+    struct ToolCallFields: Decodable, Sendable {
+        let callID: String?
+        let id: String?
+        let name: String?
+        let argumentsDelta: String?
+        let delta: String?
+        let arguments: String?
+
+        enum CodingKeys: String, CodingKey {
+            case callID = "call_id"
+            case id
+            case name
+            case argumentsDelta = "arguments_delta"
+            case delta
+            case arguments
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.callID = try? container.decodeIfPresent(String.self, forKey: .callID)
+            self.id = try? container.decodeIfPresent(String.self, forKey: .id)
+            self.name = try? container.decodeIfPresent(String.self, forKey: .name)
+            self.argumentsDelta = try? container.decodeIfPresent(String.self, forKey: .argumentsDelta)
+            self.delta = try? container.decodeIfPresent(String.self, forKey: .delta)
+            self.arguments = try? container.decodeIfPresent(String.self, forKey: .arguments)
+        }
+    }
+
+    // MARK: - Completion
+
+    struct ResponseFields: Decodable, Sendable {
+        let finishReason: String?
+        let usage: Usage?
+
+        enum CodingKeys: String, CodingKey {
+            case finishReason = "finish_reason"
+            case usage
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.finishReason = try? container.decodeIfPresent(String.self, forKey: .finishReason)
+            self.usage = try? container.decodeIfPresent(Usage.self, forKey: .usage)
+        }
+    }
+
+    struct Usage: Decodable, Sendable {
+        let inputTokens: Int?
+        let outputTokens: Int?
+        let promptTokens: Int?
+        let completionTokens: Int?
+
+        enum CodingKeys: String, CodingKey {
+            case inputTokens = "input_tokens"
+            case outputTokens = "output_tokens"
+            case promptTokens = "prompt_tokens"
+            case completionTokens = "completion_tokens"
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            self.inputTokens = try? container.decodeIfPresent(Int.self, forKey: .inputTokens)
+            self.outputTokens = try? container.decodeIfPresent(Int.self, forKey: .outputTokens)
+            self.promptTokens = try? container.decodeIfPresent(Int.self, forKey: .promptTokens)
+            self.completionTokens = try? container.decodeIfPresent(Int.self, forKey: .completionTokens)
+        }
+
+        var usageStats: UsageStats {
+            UsageStats(
+                promptTokens: inputTokens ?? promptTokens ?? 0,
+                completionTokens: outputTokens ?? completionTokens ?? 0
+            )
+        }
+    }
+}
+
+#endif // CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
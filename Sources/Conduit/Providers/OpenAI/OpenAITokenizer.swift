@@ -0,0 +1,333 @@
+// OpenAITokenizer.swift
+// Conduit
+//
+// tiktoken encodings, rank-file loading and model lookup for OpenAIProvider
+// token counting.
+
+#if CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+private let logger = ConduitLoggers.openAI
+
+// MARK: - OpenAITokenizerEncoding
+
+/// tiktoken encodings used by OpenAI models.
+///
+/// ## Model Mapping
+/// - ``o200kBase``: GPT-4o, GPT-4.1, GPT-4.5, GPT-5 and the o-series reasoning models
+/// - ``cl100kBase``: GPT-4, GPT-3.5 Turbo and the embedding models
+public enum OpenAITokenizerEncoding: String, Sendable, Hashable, Codable, CaseIterable {
+
+    /// The GPT-4 / GPT-3.5 encoding (100K vocabulary).
+    case cl100kBase = "cl100k_base"
+
+    /// The GPT-4o and later encoding (200K vocabulary).
+    case o200kBase = "o200k_base"
+
+    /// The encoding used by `model`, or `nil` for models outside the OpenAI family.
+    ///
+    /// OpenRouter-style `openai/` prefixes are ignored.
+    ///
+    /// - Parameter model: A model identifier such as `gpt-4o-mini`.
+    public init?(model: String) {
+        var name = model.lowercased()
+        if name.hasPrefix("openai/") {
+            name.removeFirst("openai/".count)
+        }
+
+        // `gpt-5` covers `gpt-5-mini` and `gpt-5.2`, but not `gpt-50`
+        func matches(_ family: String) -> Bool {
+            name == family || name.hasPrefix(family + "-") || name.hasPrefix(family + ".")
+        }
+
+        if Self.o200kFamilies.contains(where: matches) {
+            self = .o200kBase
+        } else if Self.cl100kFamilies.contains(where: matches) {
+            self = .cl100kBase
+        } else {
+            return nil
+        }
+    }
+
+    // Checked first, so `gpt-4o` never falls through to the `gpt-4` family.
+    private static let o200kFamilies = ["gpt-4o", "chatgpt-4o", "gpt-4.1", "gpt-4.5", "gpt-5", "o1", "o3", "o4"]
+    private static let cl100kFamilies = [
+        "gpt-4", "gpt-3.5-turbo", "gpt-35-turbo",
+        "text-embedding-3-small", "text-embedding-3-large", "text-embedding-ada-002",
+    ]
+
+    // MARK: - Encoding Definition
+
+    /// The pre-tokenization pattern, as in tiktoken.
+    public var pattern: String {
+        switch self {
+        case .cl100kBase:
+            return #"(?i:'s|'t|'re|'ve|'m|'ll|'d)|[^\r\n\p{L}\p{N}]?\p{L}+|\p{N}{1,3}| ?[^\s\p{L}\p{N}]+[\r\n]*|\s*[\r\n]+|\s+(?!\S)|\s+"#
+        case .o200kBase:
+            return [
+                #"[^\r\n\p{L}\p{N}]?[\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]*[\p{Ll}\p{Lm}\p{Lo}\p{M}]+(?i:'s|'t|'re|'ve|'m|'ll|'d)?"#,
+                #"[^\r\n\p{L}\p{N}]?[\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]+[\p{Ll}\p{Lm}\p{Lo}\p{M}]*(?i:'s|'t|'re|'ve|'m|'ll|'d)?"#,
+                #"\p{N}{1,3}"#,
+                #" ?[^\s\p{L}\p{N}]+[\r\n/]*"#,
+                #"\s*[\r\n]+"#,
+                #"\s+(?!\S)"#,
+                #"\s+"#,
+            ].joined(separator: "|")
+        }
+    }
+
+    /// Special tokens and their ranks.
+    public var specialTokens: [String: Int] {
+        switch self {
+        case .cl100kBase:
+            return [
+                "<|endoftext|>": 100_257,
+                "<|fim_prefix|>": 100_258,
+                "<|fim_middle|>": 100_259,
+                "<|fim_suffix|>": 100_260,
+                "<|endofprompt|>": 100_276,
+            ]
+        case .o200kBase:
+            return [
+                "<|endoftext|>": 199_999,
+                "<|endofprompt|>": 200_018,
+            ]
+        }
+    }
+
+    /// File name of the rank file.
+    public var fileName: String {
+        "\(rawValue).tiktoken"
+    }
+
+    /// Where OpenAI publishes the rank file.
+    public var downloadURL: URL {
+        URL(string: "https://openaipublic.blob.core.windows.net/encodings/\(fileName)")!
+    }
+
+    /// SHA-256 of the published rank file.
+    public var sha256: String {
+        switch self {
+        case .cl100kBase: return "223921b76ee99bde995b7ff738513eef100fb51d18c93597a113bcffe865b2a7"
+        case .o200kBase: return "446a9538cb6c348e3516120d7c08b09f57c36495e2acfffe59a5bf8b0cfb1a2d"
+        }
+    }
+}
+
+// MARK: - OpenAITokenizerSource
+
+/// Where ``OpenAIProvider`` finds tiktoken rank files for exact token counts.
+///
+/// When no rank file can be loaded, token counting falls back to the
+/// four-characters-per-token estimate and reports `isEstimate == true`.
+/// Only ``automatic`` reaches the network.
+public enum OpenAITokenizerSource: Sendable, Hashable, Codable {
+
+    /// Use rank files already in the shared cache, without downloading.
+    case cached
+
+    /// Use the shared cache, downloading and verifying rank files on first use.
+    case automatic
+
+    /// Load `<encoding>.tiktoken` files from a local directory only (offline use).
+    case directory(URL)
+
+    /// Never load rank files; always estimate.
+    case estimate
+
+    /// The shared on-disk cache used by ``cached`` and ``automatic``.
+    public static var cacheDirectory: URL {
+        let base = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? FileManager.default.temporaryDirectory
+        return base.appendingPathComponent("Conduit/tiktoken", isDirectory: true)
+    }
+}
+
+// MARK: - OpenAITokenizerStore
+
+/// Loads each encoding's rank file once per process and shares the tokenizer.
+///
+/// Concurrent callers for the same encoding wait on one load. Failed loads
+/// are not retried for ``failureRetryInterval`` so offline callers fall back
+/// to estimates without repeating a network round trip on every count.
+internal actor OpenAITokenizerStore {
+
+    static let shared = OpenAITokenizerStore()
+
+    /// Seconds before a failed load is attempted again.
+    static let failureRetryInterval: TimeInterval = 300
+
+    private struct Key: Hashable {
+        let encoding: OpenAITokenizerEncoding
+        let source: OpenAITokenizerSource
+    }
+
+    private var loads: [Key: Task<BPETokenizer, Error>] = [:]
+    private var failures: [Key: (date: Date, error: Error)] = [:]
+
+    /// The tokenizer for `encoding`, loading it from `source` on first use.
+    ///
+    /// - Throws: `AIError.providerUnavailable` for ``OpenAITokenizerSource/estimate``,
+    ///   or the error from the most recent failed load.
+    func tokenizer(
+        for encoding: OpenAITokenizerEncoding,
+        source: OpenAITokenizerSource
+    ) async throws -> BPETokenizer {
+        let key = Key(encoding: encoding, source: source)
+
+        if let load = loads[key] {
+            return try await load.value
+        }
+        if let failure = failures[key], Date().timeIntervalSince(failure.date) < Self.failureRetryInterval {
+            throw failure.error
+        }
+
+        let load = Task.detached(priority: .utility) {
+            try await Self.load(encoding, from: source)
+        }
+        loads[key] = load
+
+        do {
+            let tokenizer = try await load.value
+            failures[key] = nil
+            return tokenizer
+        } catch {
+            loads[key] = nil
+            failures[key] = (Date(), error)
+            logger.debug("Falling back to estimated token counts for \(encoding.rawValue): \(error)")
+            throw error
+        }
+    }
+
+    // MARK: - Loading
+
+    private static func load(
+        _ encoding: OpenAITokenizerEncoding,
+        from source: OpenAITokenizerSource
+    ) async throws -> BPETokenizer {
+        let fileURL: URL
+        switch source {
+        case .estimate:
+            throw AIError.providerUnavailable(reason: .unknown("Tokenizer loading is disabled"))
+        case .directory(let directory):
+            fileURL = directory.appendingPathComponent(encoding.fileName)
+        case .cached:
+            fileURL = OpenAITokenizerSource.cacheDirectory.appendingPathComponent(encoding.fileName)
+        case .automatic:
+            fileURL = OpenAITokenizerSource.cacheDirectory.appendingPathComponent(encoding.fileName)
+            if !FileManager.default.fileExists(atPath: fileURL.path) {
+                try await download(encoding, to: fileURL)
+            }
+        }
+
+        return try BPETokenizer(
+            name: encoding.rawValue,
+            rankFile: fileURL,
+            pattern: encoding.pattern,
+            specialTokens: encoding.specialTokens
+        )
+    }
+
+    private static func download(_ encoding: OpenAITokenizerEncoding, to destination: URL) async throws {
+        let data: Data
+        let response: URLResponse
+        do {
+            (data, response) = try await ConduitTransport.shared.data(for: URLRequest(url: encoding.downloadURL))
+        } catch {
+            throw AIError.downloadFailed(underlying: SendableError(error))
+        }
+
+        guard let httpResponse = response as? HTTPURLResponse, httpResponse.statusCode == 200 else {
+            throw AIError.downloadFailed(underlying: SendableError(
+                localizedDescription: "Unexpected response downloading \(encoding.fileName)"
+            ))
+        }
+
+        // Verified on every platform before anything is cached
+        let digest = SHA256Digest.hex(of: data)
+        guard digest == encoding.sha256 else {
+            throw AIError.checksumMismatch(expected: encoding.sha256, actual: digest)
+        }
+
+        do {
+            try FileManager.default.createDirectory(
+                at: destination.deletingLastPathComponent(),
+                withIntermediateDirectories: true
+            )
+            // Write beside the destination and move, so readers never see a partial file
+            let staging = destination.appendingPathExtension("download")
+            try data.write(to: staging, options: .atomic)
+            if FileManager.default.fileExists(atPath: destination.path) {
+                try FileManager.default.removeItem(at: staging)
+            } else {
+                try FileManager.default.moveItem(at: staging, to: destination)
+            }
+        } catch {
+            throw AIError.fileError(underlying: SendableError(error))
+        }
+    }
+}
+
+// MARK: - OpenAIProvider Token Counting
+
+extension OpenAIProvider {
+
+    /// Framing tokens around each chat message.
+    static let tokensPerMessage = 3
+
+    /// Tokens that prime the assistant's reply.
+    static let tokensPerReplyPrimer = 3
+
+    /// Message arrays at least this long are counted in parallel.
+    static let parallelCountingThreshold = 64
+
+    /// The shared tokenizer for `model`, or `nil` when counts must be estimated.
+    func tokenizer(for model: ModelIdentifier) async -> BPETokenizer? {
+        guard let encoding = OpenAITokenizerEncoding(model: model.rawValue) else { return nil }
+        return try? await OpenAITokenizerStore.shared.tokenizer(for: encoding, source: configuration.tokenizer)
+    }
+
+    func requireTokenizer(for model: ModelIdentifier) async throws -> BPETokenizer {
+        guard let encoding = OpenAITokenizerEncoding(model: model.rawValue) else {
+            throw AIError.providerUnavailable(
+                reason: .unknown("No tiktoken encoding is known for model '\(model.rawValue)'")
+            )
+        }
+        do {
+            return try await OpenAITokenizerStore.shared.tokenizer(for: encoding, source: configuration.tokenizer)
+        } catch {
+            throw AIError.providerUnavailable(
+                reason: .unknown("Tokenizer for \(encoding.rawValue) is unavailable: \(error.localizedDescription)")
+            )
+        }
+    }
+
+    /// Role and content tokens across `messages`, split across cores for large arrays.
+    static func countMessageTokens(_ messages: [Message], with tokenizer: BPETokenizer) async -> Int {
+        guard messages.count >= parallelCountingThreshold else {
+            return countMessageTokens(messages[...], with: tokenizer)
+        }
+
+        let workers = max(1, min(ProcessInfo.processInfo.activeProcessorCount, messages.count / 16))
+        let sliceSize = (messages.count + workers - 1) / workers
+        return await withTaskGroup(of: Int.self) { group in
+            for start in stride(from: 0, to: messages.count, by: sliceSize) {
+                let slice = messages[start..<min(start + sliceSize, messages.count)]
+                group.addTask { countMessageTokens(slice, with: tokenizer) }
+            }
+            return await group.reduce(0, +)
+        }
+    }
+
+    private static func countMessageTokens(_ messages: ArraySlice<Message>, with tokenizer: BPETokenizer) -> Int {
+        messages.reduce(0) { total, message in
+            total + tokenizer.count(message.role.rawValue) + tokenizer.count(message.content.textValue)
+        }
+    }
+}
+
+#endif // CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
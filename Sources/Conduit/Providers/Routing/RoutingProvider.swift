@@ -0,0 +1,817 @@
+// RoutingProvider.swift
+// Conduit
+//
+// A provider that spreads requests across several backends with hedging and failover.
+
+import Foundation
+
+// MARK: - RoutingProvider
+
+/// A provider that routes each request across several backends.
+///
+/// `RoutingProvider` wraps any number of `AIProvider & TextGenerator` backends
+/// and sends each request to the fastest healthy one. It keeps an exponentially
+/// weighted moving average (EWMA) of every backend's latency, hedges slow
+/// requests by starting a second backend once the first runs past its recent
+/// p95 latency, and fails over to the next backend when a request fails with
+/// an error the policy considers routable.
+///
+/// ## Usage
+///
+/// ```swift
+/// let router = RoutingProvider(backends: [
+///     .init(name: "openai", provider: OpenAIProvider(apiKey: openAIKey), model: .openAI("gpt-4o-mini")),
+///     .init(name: "anthropic", provider: AnthropicProvider(apiKey: anthropicKey), model: .claudeSonnet46),
+/// ])
+///
+/// let answer = try await router.generate("Summarize this", model: .openAI("gpt-4o-mini"))
+/// ```
+///
+/// Backends created with a fixed model ignore the routed model. Use
+/// ``Backend/init(name:provider:map:)`` to translate it instead.
+///
+/// ## Hedging
+///
+/// Once a backend has ``Policy/Hedging/minimumSamples`` measurements, a
+/// request that runs longer than its ``Policy/Hedging/percentile`` latency
+/// starts the next backend in parallel. The first successful response wins
+/// and the loser's task is cancelled. Only that attempt stops; other
+/// requests running on the same backend are not affected.
+///
+/// ## Streaming
+///
+/// Streams race until the first chunk arrives. The backend that produces it
+/// wins, the others are cancelled, and every later chunk comes from the
+/// winner. Errors after that point are not failed over because text has
+/// already been delivered.
+///
+/// - Note: ``cancelGeneration()`` calls `cancelGeneration()` on every
+///   backend's provider, which stops all of their work, routed or not.
+public actor RoutingProvider: AIProvider, TextGenerator {
+
+    // MARK: - Type Aliases
+
+    public typealias Response = GenerationResult
+    public typealias StreamChunk = GenerationChunk
+    public typealias ModelID = ModelIdentifier
+
+    // MARK: - Properties
+
+    /// The backends in declaration order.
+    public let backends: [Backend]
+
+    /// The routing policy.
+    public let policy: Policy
+
+    private var states: [BackendState]
+
+    // MARK: - Initialization
+
+    /// Creates a routing provider.
+    ///
+    /// - Parameters:
+    ///   - backends: The backends to route across. Declaration order breaks
+    ///     ties between backends with equal latency.
+    ///   - policy: Hedging and failover settings.
+    public init(backends: [Backend], policy: Policy = .default) {
+        self.backends = backends
+        self.policy = policy
+        self.states = Array(repeating: BackendState(), count: backends.count)
+    }
+
+    // MARK: - Statistics
+
+    /// Latency and outcome counters for every backend, in declaration order.
+    public func statistics() -> [BackendStatistics] {
+        zip(backends, states).map { backend, state in
+            BackendStatistics(
+                name: backend.name,
+                averageLatency: state.latency.average.map { .seconds($0) },
+                averageTimeToFirstToken: state.firstToken.average.map { .seconds($0) },
+                requests: state.requests,
+                failures: state.failures
+            )
+        }
+    }
+
+    // MARK: - AIProvider
+
+    public var isAvailable: Bool {
+        get async {
+            for backend in backends {
+                if await backend.isAvailable() { return true }
+            }
+            return false
+        }
+    }
+
+    public var availabilityStatus: ProviderAvailability {
+        get async {
+            var first: ProviderAvailability?
+            for backend in backends {
+                let status = await backend.availability()
+                if status.isAvailable { return status }
+                first = first ?? status
+            }
+            return first ?? .unavailable(.unknown("RoutingProvider has no backends"))
+        }
+    }
+
+    public func cancelGeneration() async {
+        for backend in backends {
+            await backend.cancel()
+        }
+    }
+
+    public nonisolated func stream(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        streamWithMetadata(messages: messages, model: model, config: config)
+    }
+
+    // MARK: - TextGenerator
+
+    public func generate(
+        _ prompt: String,
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async throws -> String {
+        try await generate(messages: [.user(prompt)], model: model, config: config).text
+    }
+
+    public func generate(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async throws -> GenerationResult {
+        let order = routeOrder(using: \.latency)
+        guard !order.isEmpty else {
+            throw AIError.invalidInput("RoutingProvider has no backends")
+        }
+        let hedgeDelay = hedgeDelay(for: order[0], using: \.latency)
+        let maxHedges = policy.hedging?.maxHedges ?? 0
+
+        // Attempts run unstructured so the winner returns without waiting for losers to stop
+        let attempts = AttemptGroup<Attempt>()
+        defer { attempts.cancelAll() }
+
+        let outcome: Result<GenerationResult, Error> = await withTaskCancellationHandler {
+            var next = 0
+            var running: Set<Int> = []
+            var hedges = 0
+            var lastError: Error?
+
+            func launch() {
+                let index = order[next]
+                let backend = backends[index]
+                next += 1
+                running.insert(index)
+                states[index].requests += 1
+                attempts.addTask(for: index) {
+                    await Self.attempt(backend, index: index, messages: messages, model: model, config: config)
+                }
+            }
+
+            launch()
+            if let hedgeDelay, order.count > 1 {
+                attempts.addTask(after: hedgeDelay, .hedge)
+            }
+
+            for await attempt in attempts.events {
+                switch attempt {
+                case .finished(let index, let result, let latency):
+                    running.remove(index)
+                    recordSuccess(index, latency: latency)
+                    attempts.cancel(running)
+                    return .success(result)
+
+                case .failed(let index, let error):
+                    running.remove(index)
+                    states[index].recordFailure()
+                    guard shouldFailover(error) else {
+                        attempts.cancel(running)
+                        return .failure(error)
+                    }
+                    lastError = error
+                    if running.isEmpty {
+                        guard next < order.count else { return .failure(error) }
+                        launch()
+                    }
+
+                case .hedge:
+                    guard !running.isEmpty, next < order.count, hedges < maxHedges else {
+                        continue
+                    }
+                    hedges += 1
+                    launch()
+                    if let hedgeDelay, next < order.count, hedges < maxHedges {
+                        attempts.addTask(after: hedgeDelay, .hedge)
+                    }
+                }
+            }
+            return .failure(lastError ?? AIError.cancelled)
+        } onCancel: {
+            attempts.cancelAll()
+        }
+        return try outcome.get()
+    }
+
+    public nonisolated func stream(
+        _ prompt: String,
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<String, Error> {
+        let chunks = streamWithMetadata(messages: [.user(prompt)], model: model, config: config)
+        return AsyncThrowingStream { continuation in
+            let task = Task {
+                do {
+                    for try await chunk in chunks where !chunk.text.isEmpty {
+                        continuation.yield(chunk.text)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+
+    public nonisolated func streamWithMetadata(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        AsyncThrowingStream { continuation in
+            let task = Task {
+                do {
+                    try await self.routeStream(messages: messages, model: model, config: config, into: continuation)
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+
+    // MARK: - Streaming
+
+    private func routeStream(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        into continuation: AsyncThrowingStream<GenerationChunk, Error>.Continuation
+    ) async throws {
+        let order = routeOrder(using: \.firstToken)
+        guard !order.isEmpty else {
+            throw AIError.invalidInput("RoutingProvider has no backends")
+        }
+        let hedgeDelay = hedgeDelay(for: order[0], using: \.firstToken)
+        let maxHedges = policy.hedging?.maxHedges ?? 0
+        let race = StreamRace()
+        let backends = backends
+
+        let attempts = AttemptGroup<StreamAttempt>()
+        defer { attempts.cancelAll() }
+
+        let outcome: Result<Void, Error> = await withTaskCancellationHandler {
+            var next = 0
+            var running: Set<Int> = []
+            var hedges = 0
+            var lastError: Error?
+
+            func launch() {
+                let index = order[next]
+                next += 1
+                guard race.launch(index) else { return }
+                running.insert(index)
+                states[index].requests += 1
+                attempts.addTask(for: index) {
+                    await Self.streamAttempt(
+                        backends,
+                        index: index,
+                        race: race,
+                        attempts: attempts,
+                        messages: messages,
+                        model: model,
+                        config: config,
+                        continuation: continuation
+                    )
+                }
+            }
+
+            launch()
+            if let hedgeDelay, order.count > 1 {
+                attempts.addTask(after: hedgeDelay, .hedge)
+            }
+
+            for await attempt in attempts.events {
+                switch attempt {
+                case .finished(let index, let firstToken, let latency):
+                    recordSuccess(index, latency: latency, firstToken: firstToken)
+                    return .success(())
+
+                case .lost(let index):
+                    running.remove(index)
+                    race.finish(index)
+
+                case .failed(let index, let error, let committed):
+                    running.remove(index)
+                    race.finish(index)
+                    if committed {
+                        states[index].recordFailure()
+                        return .failure(error)
+                    }
+                    // Losers stopped after another backend committed are not failures
+                    guard race.winner == nil else { continue }
+
+                    states[index].recordFailure()
+                    guard shouldFailover(error) else {
+                        attempts.cancel(running)
+                        return .failure(error)
+                    }
+                    lastError = error
+                    if running.isEmpty {
+                        guard next < order.count else { return .failure(error) }
+                        launch()
+                    }
+
+                case .hedge:
+                    guard race.winner == nil, !running.isEmpty, next < order.count,
+                          hedges < maxHedges else {
+                        continue
+                    }
+                    hedges += 1
+                    launch()
+                    if let hedgeDelay, next < order.count, hedges < maxHedges {
+                        attempts.addTask(after: hedgeDelay, .hedge)
+                    }
+                }
+            }
+            return .failure(lastError ?? AIError.cancelled)
+        } onCancel: {
+            attempts.cancelAll()
+        }
+        try outcome.get()
+    }
+
+    // MARK: - Attempts
+
+    private enum Attempt: Sendable {
+        case finished(index: Int, result: GenerationResult, latency: Duration)
+        case failed(index: Int, error: Error)
+        case hedge
+    }
+
+    private enum StreamAttempt: Sendable {
+        case finished(index: Int, firstToken: Duration, latency: Duration)
+        case failed(index: Int, error: Error, committed: Bool)
+        case lost(index: Int)
+        case hedge
+    }
+
+    private static func attempt(
+        _ backend: Backend,
+        index: Int,
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async -> Attempt {
+        let start = ContinuousClock.now
+        do {
+            let result = try await backend.generate(messages, model, config)
+            return .finished(index: index, result: result, latency: ContinuousClock.now - start)
+        } catch {
+            return .failed(index: index, error: error)
+        }
+    }
+
+    private static func streamAttempt(
+        _ backends: [Backend],
+        index: Int,
+        race: StreamRace,
+        attempts: AttemptGroup<StreamAttempt>,
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig,
+        continuation: AsyncThrowingStream<GenerationChunk, Error>.Continuation
+    ) async -> StreamAttempt {
+        let start = ContinuousClock.now
+        var firstToken: Duration?
+
+        // Cancelling the losers' tasks does not wait for them, so the first chunk is not held back
+        func commit() -> Bool {
+            guard let losers = race.claim(index) else { return false }
+            firstToken = ContinuousClock.now - start
+            attempts.cancel(losers)
+            return true
+        }
+
+        do {
+            for try await chunk in backends[index].stream(messages, model, config) {
+                if firstToken == nil, !commit() {
+                    return .lost(index: index)
+                }
+                continuation.yield(chunk)
+            }
+            try Task.checkCancellation()
+            if firstToken == nil, !commit() {
+                return .lost(index: index)
+            }
+            return .finished(index: index, firstToken: firstToken ?? .zero, latency: ContinuousClock.now - start)
+        } catch {
+            return .failed(index: index, error: error, committed: firstToken != nil)
+        }
+    }
+
+    // MARK: - Routing
+
+    /// Backend indices in the order they should be tried.
+    ///
+    /// Backends that failed their last request go last. The rest are ordered
+    /// by their latency average, unmeasured backends first so they get sampled.
+    private func routeOrder(using metric: KeyPath<BackendState, LatencyTracker>) -> [Int] {
+        backends.indices.sorted { lhs, rhs in
+            let left = states[lhs], right = states[rhs]
+            if (left.consecutiveFailures > 0) != (right.consecutiveFailures > 0) {
+                return right.consecutiveFailures > 0
+            }
+            let leftAverage = left[keyPath: metric].average ?? 0
+            let rightAverage = right[keyPath: metric].average ?? 0
+            if leftAverage != rightAverage {
+                return leftAverage < rightAverage
+            }
+            return lhs < rhs
+        }
+    }
+
+    /// How long to wait on a backend before hedging, or `nil` to never hedge.
+    private func hedgeDelay(for index: Int, using metric: KeyPath<BackendState, LatencyTracker>) -> Duration? {
+        guard let hedging = policy.hedging, hedging.maxHedges > 0 else { return nil }
+        let tracker = states[index][keyPath: metric]
+        guard tracker.count >= hedging.minimumSamples, let seconds = tracker.percentile(hedging.percentile) else {
+            return hedging.initialDelay
+        }
+        return max(.seconds(seconds), hedging.minimumDelay)
+    }
+
+    private func shouldFailover(_ error: Error) -> Bool {
+        switch error {
+        case let error as AIError:
+            if case .cancelled = error { return false }
+            if policy.failoverCategories.contains(error.category) { return true }
+            return policy.failoverOnRetryable && error.isRetryable
+        case is URLError:
+            return policy.failoverCategories.contains(.network)
+        default:
+            return false
+        }
+    }
+
+    private func recordSuccess(_ index: Int, latency: Duration, firstToken: Duration? = nil) {
+        states[index].consecutiveFailures = 0
+        states[index].latency.record(latency.seconds, smoothing: policy.smoothing, window: policy.sampleWindow)
+        if let firstToken {
+            states[index].firstToken.record(
+                firstToken.seconds,
+                smoothing: policy.smoothing,
+                window: policy.sampleWindow
+            )
+        }
+    }
+}
+
+// MARK: - Backend
+
+extension RoutingProvider {
+
+    /// A provider the router can send requests to.
+    ///
+    /// Backends erase the provider's concrete type so providers with
+    /// different model identifier types can share one router.
+    public struct Backend: Sendable {
+        /// A name used in statistics.
+        public let name: String
+
+        let isAvailable: @Sendable () async -> Bool
+        let availability: @Sendable () async -> ProviderAvailability
+        let generate: @Sendable ([Message], ModelIdentifier, GenerateConfig) async throws -> GenerationResult
+        let stream: @Sendable ([Message], ModelIdentifier, GenerateConfig)
+            -> AsyncThrowingStream<GenerationChunk, Error>
+        let cancel: @Sendable () async -> Void
+
+        /// Creates a backend that translates the routed model into one of the provider's own.
+        ///
+        /// - Parameters:
+        ///   - name: A name used in statistics.
+        ///   - provider: The provider to send requests to.
+        ///   - map: Maps the model a request names onto the provider's model.
+        public init<P: AIProvider & TextGenerator>(
+            name: String,
+            provider: P,
+            map: @escaping @Sendable (ModelIdentifier) -> P.ModelID
+        ) {
+            self.name = name
+            self.isAvailable = { await provider.isAvailable }
+            self.availability = { await provider.availabilityStatus }
+            self.generate = { messages, model, config in
+                let result: GenerationResult = try await provider.generate(
+                    messages: messages,
+                    model: map(model),
+                    config: config
+                )
+                return result
+            }
+            self.stream = { messages, model, config in
+                provider.streamWithMetadata(messages: messages, model: map(model), config: config)
+            }
+            self.cancel = { await provider.cancelGeneration() }
+        }
+
+        /// Creates a backend that always uses `model`, whatever the request names.
+        ///
+        /// - Parameters:
+        ///   - name: A name used in statistics.
+        ///   - provider: The provider to send requests to.
+        ///   - model: The provider model every request uses.
+        public init<P: AIProvider & TextGenerator>(name: String, provider: P, model: P.ModelID) {
+            self.init(name: name, provider: provider, map: { _ in model })
+        }
+    }
+
+    /// Latency and outcome counters for one backend.
+    public struct BackendStatistics: Sendable, Equatable {
+        /// The backend's name.
+        public let name: String
+
+        /// EWMA of complete request latency, once measured.
+        public let averageLatency: Duration?
+
+        /// EWMA of time to the first streamed chunk, once measured.
+        public let averageTimeToFirstToken: Duration?
+
+        /// Requests started on this backend, including hedges.
+        public let requests: Int
+
+        /// Requests that failed on this backend.
+        public let failures: Int
+    }
+}
+
+// MARK: - Policy
+
+extension RoutingProvider {
+
+    /// Hedging and failover settings for a ``RoutingProvider``.
+    public struct Policy: Sendable {
+        /// Hedging settings, or `nil` to disable hedging.
+        public var hedging: Hedging?
+
+        /// Error categories that move a request on to the next backend.
+        public var failoverCategories: Set<AIError.ErrorCategory>
+
+        /// Whether any retryable `AIError` also fails over, whatever its category.
+        public var failoverOnRetryable: Bool
+
+        /// Weight given to the newest sample in latency averages, from 0 to 1.
+        public var smoothing: Double
+
+        /// Number of recent samples kept per backend for percentiles.
+        public var sampleWindow: Int
+
+        /// Creates a routing policy.
+        public init(
+            hedging: Hedging? = Hedging(),
+            failoverCategories: Set<AIError.ErrorCategory> = [.network, .provider],
+            failoverOnRetryable: Bool = true,
+            smoothing: Double = 0.2,
+            sampleWindow: Int = 128
+        ) {
+            self.hedging = hedging
+            self.failoverCategories = failoverCategories
+            self.failoverOnRetryable = failoverOnRetryable
+            self.smoothing = min(max(smoothing, 0.01), 1)
+            self.sampleWindow = max(1, sampleWindow)
+        }
+
+        /// Hedges after p95 and fails over on network and provider errors.
+        public static let `default` = Policy()
+
+        /// Fails over on errors but never hedges.
+        public static let failoverOnly = Policy(hedging: nil)
+    }
+}
+
+extension RoutingProvider.Policy {
+
+    /// When to start a backup request for a slow one.
+    public struct Hedging: Sendable {
+        /// The latency percentile after which a backup request starts.
+        public var percentile: Double
+
+        /// Samples a backend needs before its percentile is trusted.
+        public var minimumSamples: Int
+
+        /// Delay used before a backend has enough samples, or `nil` to wait for them.
+        public var initialDelay: Duration?
+
+        /// Shortest delay allowed, so fast backends are not hedged on noise.
+        public var minimumDelay: Duration
+
+        /// Most backup requests started for one request.
+        public var maxHedges: Int
+
+        /// Creates hedging settings.
+        public init(
+            percentile: Double = 0.95,
+            minimumSamples: Int = 20,
+            initialDelay: Duration? = nil,
+            minimumDelay: Duration = .milliseconds(20),
+            maxHedges: Int = 1
+        ) {
+            self.percentile = min(max(percentile, 0), 1)
+            self.minimumSamples = max(1, minimumSamples)
+            self.initialDelay = initialDelay
+            self.minimumDelay = minimumDelay
+            self.maxHedges = max(0, maxHedges)
+        }
+    }
+}
+
+// MARK: - Latency Tracking
+
+/// An EWMA plus a ring buffer of recent samples, in seconds.
+private struct LatencyTracker: Sendable {
+    private(set) var average: Double?
+    private var samples: [Double] = []
+    private var nextSlot = 0
+
+    var count: Int { samples.count }
+
+    mutating func record(_ seconds: Double, smoothing: Double, window: Int) {
+        average = average.map { $0 + smoothing * (seconds - $0) } ?? seconds
+        if samples.count < window {
+            samples.append(seconds)
+        } else {
+            samples[nextSlot] = seconds
+        }
+        nextSlot = (nextSlot + 1) % window
+    }
+
+    /// The nearest-rank percentile of the recent samples.
+    func percentile(_ fraction: Double) -> Double? {
+        guard !samples.isEmpty else { return nil }
+        let sorted = samples.sorted()
+        let rank = Int((fraction * Double(sorted.count)).rounded(.up)) - 1
+        return sorted[min(max(rank, 0), sorted.count - 1)]
+    }
+}
+
+private struct BackendState: Sendable {
+    var latency = LatencyTracker()
+    var firstToken = LatencyTracker()
+    var requests = 0
+    var failures = 0
+    var consecutiveFailures = 0
+
+    mutating func recordFailure() {
+        failures += 1
+        consecutiveFailures += 1
+    }
+}
+
+/// Attempts started for one routed request.
+///
+/// A task group waits for every child before it returns, so a hedged
+/// request would hold the winner's result until the loser had handled its
+/// cancellation. The attempts run as unstructured tasks instead; their
+/// results arrive on ``events``, and ``cancelAll()`` cancels whatever is
+/// still running and ends the stream without waiting.
+///
+/// A losing attempt is stopped by cancelling its own task with
+/// ``cancel(_:)``, never through the backend provider, which may be serving
+/// other requests at the same time.
+private final class AttemptGroup<Event: Sendable>: @unchecked Sendable {
+    let events: AsyncStream<Event>
+
+    private let continuation: AsyncStream<Event>.Continuation
+    private let lock = NSLock()
+    private var tasks: [Task<Void, Never>] = []
+    private var attempts: [Int: Task<Void, Never>] = [:]
+    private var isCancelled = false
+
+    init() {
+        (events, continuation) = AsyncStream.makeStream(of: Event.self)
+    }
+
+    /// Runs the attempt on backend `index` and delivers its result, unless the group is cancelled first.
+    func addTask(for index: Int, _ operation: @escaping @Sendable () async -> Event) {
+        let continuation = continuation
+        let task = Task {
+            continuation.yield(await operation())
+        }
+        withLock { attempts[index] = task }
+        register(task)
+    }
+
+    /// Cancels the attempts on the backends at `indices` without waiting for them to stop.
+    func cancel(_ indices: some Sequence<Int>) {
+        let losers = withLock { indices.compactMap { attempts[$0] } }
+        for task in losers {
+            task.cancel()
+        }
+    }
+
+    /// Delivers `event` after `delay`, unless the group is cancelled first.
+    func addTask(after delay: Duration, _ event: Event) {
+        let continuation = continuation
+        register(Task {
+            guard (try? await Task.sleep(for: delay)) != nil else { return }
+            continuation.yield(event)
+        })
+    }
+
+    /// Cancels every running attempt and ends ``events``.
+    func cancelAll() {
+        let running = withLock {
+            isCancelled = true
+            defer {
+                tasks.removeAll()
+                attempts.removeAll()
+            }
+            return tasks
+        }
+        for task in running {
+            task.cancel()
+        }
+        continuation.finish()
+    }
+
+    private func register(_ task: Task<Void, Never>) {
+        let accepted = withLock {
+            if !isCancelled {
+                tasks.append(task)
+            }
+            return !isCancelled
+        }
+        if !accepted {
+            task.cancel()
+        }
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
+
+/// Tracks which backends are racing a stream and which one committed.
+private final class StreamRace: @unchecked Sendable {
+    private let lock = NSLock()
+    private var launched: Set<Int> = []
+    private var committed: Int?
+
+    var winner: Int? {
+        withLock { committed }
+    }
+
+    /// Registers a backend, or returns `false` once a winner has committed.
+    func launch(_ index: Int) -> Bool {
+        withLock {
+            guard committed == nil else { return false }
+            launched.insert(index)
+            return true
+        }
+    }
+
+    /// Commits the stream to `index`, returning the backends to cancel.
+    func claim(_ index: Int) -> [Int]? {
+        withLock {
+            guard committed == nil else { return nil }
+            committed = index
+            launched.remove(index)
+            return Array(launched)
+        }
+    }
+
+    func finish(_ index: Int) {
+        withLock { _ = launched.remove(index) }
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
+
+private extension Duration {
+    var seconds: Double {
+        let (seconds, attoseconds) = components
+        return Double(seconds) + Double(attoseconds) / 1e18
+    }
+}
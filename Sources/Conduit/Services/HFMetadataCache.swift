@@ -0,0 +1,325 @@
+// HFMetadataCache.swift
+// Conduit
+//
+// TTL cache with ETag revalidation for HuggingFace API responses.
+
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+// MARK: - HFMetadataCache
+
+/// Caches HuggingFace API response bodies in memory and on disk.
+///
+/// Model selection asks for the same repository metadata and file listings
+/// several times: ``MLXCompatibilityChecker``, ``VLMDetector`` and
+/// ``HFSnapshotDownloader`` each query the API. `HFMetadataCache` answers
+/// repeats from an in-memory LRU while they are younger than
+/// ``Configuration/timeToLive``. Older responses are revalidated with
+/// `If-None-Match`, so an unchanged repository costs a `304` with no body,
+/// and identical lookups that arrive while one is in flight share it.
+///
+/// Responses to requests carrying an `Authorization` header are kept in
+/// memory only, so private repository listings never reach the disk.
+/// If the network fails, or the Hub is rate limiting or failing with a
+/// `5xx`, the last stored response is returned even when it has expired.
+/// Only a `404` or `410` removes it.
+internal actor HFMetadataCache {
+
+    // MARK: - Configuration
+
+    /// Freshness, size limits and persistence for an ``HFMetadataCache``.
+    struct Configuration: Sendable, Hashable {
+        /// How long a response is used without asking the server.
+        var timeToLive: TimeInterval
+
+        /// Maximum responses held in memory.
+        var maxEntries: Int
+
+        /// Directory for stored responses, or `nil` to keep them in memory only.
+        var directory: URL?
+
+        /// Creates a cache configuration.
+        ///
+        /// - Parameters:
+        ///   - timeToLive: Seconds a response stays fresh. Default: 10 minutes
+        ///   - maxEntries: Responses held in memory. Clamped to at least 1. Default: 128
+        ///   - directory: On-disk store location. Default: `nil`
+        init(timeToLive: TimeInterval = 600, maxEntries: Int = 128, directory: URL? = nil) {
+            self.timeToLive = max(0, timeToLive)
+            self.maxEntries = max(1, maxEntries)
+            self.directory = directory
+        }
+    }
+
+    // MARK: - Metrics
+
+    /// Counters describing how the cache has been used.
+    struct Metrics: Sendable, Hashable {
+        /// Lookups answered without contacting the server.
+        var hits = 0
+
+        /// Lookups that sent a request.
+        var misses = 0
+
+        /// Requests the server answered with `304 Not Modified`.
+        var revalidations = 0
+
+        /// Lookups that waited on an identical in-flight request.
+        var coalescedRequests = 0
+    }
+
+    // MARK: - Types
+
+    /// Sends a request and returns its body and response.
+    typealias Fetch = @Sendable (URLRequest) async throws -> (Data, URLResponse)
+
+    /// A stored response body.
+    struct Entry: Codable, Sendable {
+        /// The response body.
+        let body: Data
+
+        /// The `ETag` the server sent with the body.
+        let etag: String?
+
+        /// When the server last confirmed the body.
+        var validatedAt: Date
+    }
+
+    // MARK: - Shared Instance
+
+    /// The cache used by ``HFMetadataService/shared``.
+    static let shared = HFMetadataCache(configuration: Configuration(directory: defaultDirectory))
+
+    /// `Caches/Conduit/HFMetadata` in the user's domain.
+    static var defaultDirectory: URL {
+        let base = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? FileManager.default.temporaryDirectory
+        return base
+            .appendingPathComponent("Conduit", isDirectory: true)
+            .appendingPathComponent("HFMetadata", isDirectory: true)
+    }
+
+    // MARK: - State
+
+    private struct MemoryEntry {
+        var entry: Entry
+        var lastAccess: UInt64
+    }
+
+    /// Cache settings.
+    nonisolated let configuration: Configuration
+
+    private let fetch: Fetch
+    private let now: @Sendable () -> Date
+    private var memory: [String: MemoryEntry] = [:]
+    private var accessClock: UInt64 = 0
+    private var inFlight: [String: Task<Outcome, Never>] = [:]
+    private(set) var metrics = Metrics()
+
+    // MARK: - Initialization
+
+    /// Creates a metadata cache.
+    ///
+    /// - Parameters:
+    ///   - configuration: Freshness, size limits and persistence.
+    ///   - now: The clock used for freshness. Default: the system clock
+    ///   - fetch: Sends requests. Default: ``ConduitTransport/shared``
+    init(
+        configuration: Configuration = Configuration(),
+        now: @escaping @Sendable () -> Date = { Date() },
+        fetch: @escaping Fetch = { try await ConduitTransport.shared.data(for: $0) }
+    ) {
+        self.configuration = configuration
+        self.now = now
+        self.fetch = fetch
+    }
+
+    // MARK: - Lookup
+
+    /// Returns the body of a successful response to `request`, or `nil` if
+    /// the server could not answer and nothing was stored, or reported the
+    /// resource as gone.
+    ///
+    /// - Parameters:
+    ///   - request: The API request.
+    ///   - maximumAge: Seconds a stored response may be used without asking
+    ///     the server, or `nil` for ``Configuration/timeToLive``. Pass 0 to
+    ///     always revalidate.
+    func data(for request: URLRequest, maximumAge: TimeInterval? = nil) async -> Data? {
+        let key = Self.key(for: request)
+        let stored = lookup(key, persisted: Self.isPersistable(request))
+        if let stored, now().timeIntervalSince(stored.validatedAt) < maximumAge ?? configuration.timeToLive {
+            metrics.hits += 1
+            return stored.body
+        }
+        if let task = inFlight[key] {
+            metrics.coalescedRequests += 1
+            return await task.value.body(stored: stored)
+        }
+
+        metrics.misses += 1
+        let fetch = self.fetch
+        let now = self.now
+        let task = Task<Outcome, Never> {
+            await Self.revalidate(request, stored: stored, fetch: fetch, now: now)
+        }
+        inFlight[key] = task
+        defer { inFlight[key] = nil }
+
+        let outcome = await task.value
+        switch outcome {
+        case .fetched(let entry):
+            insert(entry, for: key, persisted: Self.isPersistable(request))
+        case .notModified(let entry):
+            metrics.revalidations += 1
+            insert(entry, for: key, persisted: Self.isPersistable(request))
+        case .unreachable:
+            break
+        case .rejected:
+            remove(key)
+        }
+        return outcome.body(stored: stored)
+    }
+
+    /// Removes every stored response from memory and disk.
+    func removeAll() {
+        memory.removeAll()
+        if let directory = configuration.directory {
+            try? FileManager.default.removeItem(at: directory)
+        }
+    }
+
+    // MARK: - Network
+
+    /// The result of asking the server about a request.
+    private enum Outcome: Sendable {
+        /// The server sent a new body.
+        case fetched(Entry)
+
+        /// The server confirmed the stored body.
+        case notModified(Entry)
+
+        /// The server could not be reached or did not answer, such as when
+        /// it was rate limiting or failing.
+        case unreachable
+
+        /// The server reported that the resource does not exist.
+        case rejected
+
+        /// The body to return, falling back to `stored` when the server did not answer.
+        func body(stored: Entry?) -> Data? {
+            switch self {
+            case .fetched(let entry), .notModified(let entry): entry.body
+            case .unreachable: stored?.body
+            case .rejected: nil
+            }
+        }
+    }
+
+    /// Sends `request`, conditional on `stored`'s ETag when there is one.
+    private static func revalidate(
+        _ request: URLRequest,
+        stored: Entry?,
+        fetch: Fetch,
+        now: @Sendable () -> Date
+    ) async -> Outcome {
+        var request = request
+        if let etag = stored?.etag {
+            request.setValue(etag, forHTTPHeaderField: "If-None-Match")
+        }
+
+        let data: Data
+        let response: URLResponse
+        do {
+            (data, response) = try await fetch(request)
+        } catch {
+            return .unreachable
+        }
+        guard let http = response as? HTTPURLResponse else { return .unreachable }
+
+        if http.statusCode == 304, var stored {
+            stored.validatedAt = now()
+            return .notModified(stored)
+        }
+        switch http.statusCode {
+        case 200..<300:
+            break
+        case 404, 410:
+            return .rejected
+        default:
+            // Rate limits and server errors say nothing about whether the stored body is still current
+            return .unreachable
+        }
+        return .fetched(Entry(body: data, etag: http.value(forHTTPHeaderField: "ETag"), validatedAt: now()))
+    }
+
+    // MARK: - Keys
+
+    /// The digest of the URL and credentials of `request`.
+    ///
+    /// Including the token keeps one user's private listings from answering
+    /// another user's lookups.
+    static func key(for request: URLRequest) -> String {
+        var digest = SHA256Digest()
+        digest.update("conduit.hf-metadata.v1\n")
+        digest.update(request.url?.absoluteString ?? "")
+        digest.update("\n")
+        digest.update(request.value(forHTTPHeaderField: "Authorization") ?? "")
+        return digest.finalize()
+    }
+
+    private static func isPersistable(_ request: URLRequest) -> Bool {
+        request.value(forHTTPHeaderField: "Authorization") == nil
+    }
+
+    // MARK: - Storage
+
+    private func lookup(_ key: String, persisted: Bool) -> Entry? {
+        accessClock += 1
+        if var cached = memory[key] {
+            cached.lastAccess = accessClock
+            memory[key] = cached
+            return cached.entry
+        }
+        guard persisted, let url = fileURL(for: key),
+              let data = try? Data(contentsOf: url),
+              let entry = try? JSONDecoder().decode(Entry.self, from: data) else {
+            return nil
+        }
+        insertInMemory(entry, for: key)
+        return entry
+    }
+
+    private func insert(_ entry: Entry, for key: String, persisted: Bool) {
+        insertInMemory(entry, for: key)
+        guard persisted, let directory = configuration.directory, let url = fileURL(for: key),
+              let data = try? JSONEncoder().encode(entry) else {
+            return
+        }
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        try? data.write(to: url, options: .atomic)
+    }
+
+    private func insertInMemory(_ entry: Entry, for key: String) {
+        accessClock += 1
+        memory[key] = MemoryEntry(entry: entry, lastAccess: accessClock)
+        while memory.count > configuration.maxEntries,
+              let oldest = memory.min(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+            memory[oldest.key] = nil
+        }
+    }
+
+    private func remove(_ key: String) {
+        memory[key] = nil
+        if let url = fileURL(for: key) {
+            try? FileManager.default.removeItem(at: url)
+        }
+    }
+
+    private func fileURL(for key: String) -> URL? {
+        configuration.directory?.appendingPathComponent("\(key).json")
+    }
+}
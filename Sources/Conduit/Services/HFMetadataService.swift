@@ -19,6 +19,10 @@ import FoundationNetworking
 /// Provides methods to estimate download sizes, fetch file trees,
 /// and retrieve detailed model information including VLM detection.
 ///
+/// Responses are cached in memory and under `Caches/Conduit/HFMetadata`
+/// for ten minutes, then revalidated with their ETag, and concurrent
+/// identical lookups share one request.
+///
 /// ## Usage
 /// ```swift
 /// let service = HFMetadataService.shared
@@ -63,10 +67,16 @@ public actor HFMetadataService {
         /// LFS (Large File Storage) metadata if applicable.
         public let lfs: LFSInfo?
 
+        /// The git object ID of the entry, which changes whenever its content does.
+        public let oid: String?
+
         /// LFS metadata structure.
         public struct LFSInfo: Sendable, Decodable {
             /// The actual size of the LFS file in bytes.
             public let size: Int64?
+
+            /// The SHA-256 of the file content, as lowercase hex.
+            public let oid: String?
         }
 
         /// Returns the effective size, preferring `size` then falling back to `lfs.size`.
@@ -167,9 +177,16 @@ public actor HFMetadataService {
         }
     }
 
+    // MARK: - State
+
+    private let cache: HFMetadataCache
+
     // MARK: - Initialization
 
-    private init() {}
+    /// Creates a service that reads responses through `cache`.
+    internal init(cache: HFMetadataCache = .shared) {
+        self.cache = cache
+    }
 
     // MARK: - Public Methods
 
@@ -198,7 +215,7 @@ public actor HFMetadataService {
             return nil
         }
 
-        let matchers = patterns.compactMap { GlobMatcher($0) }
+        let matchers = GlobMatcher.compiled(patterns)
         guard !matchers.isEmpty else { return nil }
 
         let total = files.reduce(Int64(0)) { acc, file in
@@ -217,35 +234,41 @@ public actor HFMetadataService {
 
     /// Fetches the complete file tree for a repository.
     ///
-    /// Uses the HuggingFace `/api/models/{repo}/tree/main?recursive=1` endpoint
+    /// Uses the HuggingFace `/api/models/{repo}/tree/{revision}?recursive=1` endpoint
     /// to retrieve all files and directories in the repository.
     ///
-    /// - Parameter repoId: The repository identifier.
+    /// - Parameters:
+    ///   - repoId: The repository identifier.
+    ///   - revision: The branch, tag, or commit to list. Default: `main`
+    ///   - token: Optional HuggingFace token for private or gated repositories.
+    ///   - maximumAge: Seconds a cached listing may be used without asking the
+    ///     server, or `nil` for the cache's default. Pass 0 to revalidate.
     /// - Returns: Array of files, or `nil` on failure.
-    private func fetchFileTree(repoId: String) async -> [RepoFile]? {
+    internal func fetchFileTree(
+        repoId: String,
+        revision: String = "main",
+        token: String? = nil,
+        maximumAge: TimeInterval? = nil
+    ) async -> [RepoFile]? {
         var comps = URLComponents()
         comps.scheme = "https"
         comps.host = "huggingface.co"
-        comps.path = "/api/models/\(repoId)/tree/main"
+        comps.path = "/api/models/\(repoId)/tree/\(revision)"
         comps.queryItems = [URLQueryItem(name: "recursive", value: "1")]
 
         guard let url = comps.url else { return nil }
 
         var req = URLRequest(url: url)
         req.setValue("application/json", forHTTPHeaderField: "Accept")
+        if let token {
+            req.setValue("Bearer \(token)", forHTTPHeaderField: "Authorization")
+        }
 
-        do {
-            let (data, response) = try await URLSession.shared.data(for: req)
-            guard let http = response as? HTTPURLResponse,
-                  (200..<300).contains(http.statusCode) else {
-                return nil
-            }
-
-            let files = try JSONDecoder().decode([RepoFile].self, from: data)
-            return files.isEmpty ? nil : files
-        } catch {
+        guard let data = await cache.data(for: req, maximumAge: maximumAge),
+              let files = try? JSONDecoder().decode([RepoFile].self, from: data) else {
             return nil
         }
+        return files.isEmpty ? nil : files
     }
 
     /// Fetches repository metadata including file tree and model tags.
@@ -304,24 +327,12 @@ public actor HFMetadataService {
     /// }
     /// ```
     public func fetchModelDetails(repoId: String) async -> ModelDetails? {
-        var comps = URLComponents()
-        comps.scheme = "https"
-        comps.host = "huggingface.co"
-        comps.path = "/api/models/\(repoId)"
-        comps.queryItems = [URLQueryItem(name: "full", value: "1")]
-
-        guard let url = comps.url else { return nil }
-
-        var req = URLRequest(url: url)
-        req.setValue("application/json", forHTTPHeaderField: "Accept")
+        guard let req = modelRequest(repoId: repoId),
+              let data = await cache.data(for: req) else {
+            return nil
+        }
 
         do {
-            let (data, response) = try await URLSession.shared.data(for: req)
-            guard let http = response as? HTTPURLResponse,
-                  (200..<300).contains(http.statusCode) else {
-                return nil
-            }
-
             let decoder = JSONDecoder()
             let raw = try decoder.decode(ModelDetailsResponse.self, from: data)
 
@@ -369,28 +380,31 @@ public actor HFMetadataService {
     // MARK: - Private Helper Methods
 
     /// Fetches basic metadata without the full details.
+    ///
+    /// Reads the same `?full=1` response as ``fetchModelDetails(repoId:)``,
+    /// so compatibility checks and VLM detection for one repository share a
+    /// single cached request.
     private func fetchBasicMetadata(repoId: String) async -> ModelMetaResponse? {
+        guard let req = modelRequest(repoId: repoId),
+              let data = await cache.data(for: req) else {
+            return nil
+        }
+        return try? JSONDecoder().decode(ModelMetaResponse.self, from: data)
+    }
+
+    /// The `/api/models/{repo}?full=1` request.
+    private func modelRequest(repoId: String) -> URLRequest? {
         var comps = URLComponents()
         comps.scheme = "https"
         comps.host = "huggingface.co"
         comps.path = "/api/models/\(repoId)"
+        comps.queryItems = [URLQueryItem(name: "full", value: "1")]
 
         guard let url = comps.url else { return nil }
 
         var req = URLRequest(url: url)
         req.setValue("application/json", forHTTPHeaderField: "Accept")
-
-        do {
-            let (data, response) = try await URLSession.shared.data(for: req)
-            guard let http = response as? HTTPURLResponse,
-                  (200..<300).contains(http.statusCode) else {
-                return nil
-            }
-
-            return try JSONDecoder().decode(ModelMetaResponse.self, from: data)
-        } catch {
-            return nil
-        }
+        return req
     }
 
     /// Extracts license identifier from HuggingFace tags.
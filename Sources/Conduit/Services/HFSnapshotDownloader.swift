@@ -0,0 +1,344 @@
+//
+//  HFSnapshotDownloader.swift
+//  Conduit
+//
+//  Downloads HuggingFace repository snapshots with RangedDownloader.
+//
+
+import Foundation
+
+// MARK: - HFSnapshotDownloader
+
+/// Downloads the files of a HuggingFace repository into a local directory.
+///
+/// The repository tree is listed through ``HFMetadataService``, filtered by
+/// glob patterns, and fetched with a ``RangedDownloader``, so large weight
+/// files download over several connections and resume after interruption.
+/// LFS files are checked against the SHA-256 the Hub publishes for them,
+/// using the digest computed while they download.
+///
+/// A manifest in the snapshot directory records each file's object ID and
+/// digest. Later downloads skip files whose object ID is unchanged, and a
+/// complete snapshot is used as is when the Hub cannot be reached.
+///
+/// Files already in the shared Hugging Face Hub cache, such as those fetched
+/// by `huggingface-cli` or `HubClient`, are linked into the snapshot instead
+/// of being downloaded again. The Hub cache names blobs by their LFS SHA-256
+/// or git object ID, so a blob is only adopted when it is exactly the file
+/// being requested.
+internal struct HFSnapshotDownloader: Sendable {
+
+    // MARK: - Snapshot
+
+    /// A downloaded snapshot.
+    struct Snapshot: Sendable {
+        /// The directory holding the snapshot's files.
+        let directory: URL
+
+        /// The snapshot's files, keyed by their path in the repository.
+        let files: [String: Manifest.Entry]
+    }
+
+    // MARK: - Errors
+
+    /// The repository could not be listed and no complete snapshot is on disk.
+    struct RepositoryUnavailable: LocalizedError, Sendable {
+        let repoId: String
+        let revision: String
+
+        var errorDescription: String? {
+            "Cannot list the files of '\(repoId)' at '\(revision)'"
+        }
+    }
+
+    // MARK: - Manifest
+
+    /// What was downloaded into a snapshot directory.
+    struct Manifest: Codable, Hashable, Sendable {
+
+        /// A downloaded file.
+        struct Entry: Codable, Hashable, Sendable {
+            /// The git object ID the file was downloaded at.
+            var oid: String?
+
+            /// Size in bytes.
+            var size: Int64
+
+            /// Lowercase hex SHA-256 of the file.
+            var sha256: String
+
+            /// Whether `url`, or the Hub cache blob it links to, exists at the recorded size.
+            func isOnDisk(at url: URL) -> Bool {
+                let attributes = try? FileManager.default.attributesOfItem(atPath: url.resolvingSymlinksInPath().path)
+                return (attributes?[.size] as? NSNumber)?.int64Value == size
+            }
+        }
+
+        /// The revision the snapshot was downloaded from.
+        var revision: String
+
+        /// The patterns files were matched against.
+        var patterns: [String]
+
+        /// Downloaded files, keyed by their path in the repository.
+        var files: [String: Entry]
+
+        /// The manifest's file name inside the snapshot directory.
+        static let fileName = ".conduit-snapshot.json"
+
+        static func load(from directory: URL) -> Manifest? {
+            guard let data = try? Data(contentsOf: directory.appendingPathComponent(fileName)) else { return nil }
+            return try? JSONDecoder().decode(Manifest.self, from: data)
+        }
+
+        func save(to directory: URL) throws {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.sortedKeys]
+            try encoder.encode(self).write(to: directory.appendingPathComponent(Self.fileName), options: .atomic)
+        }
+
+        /// Whether every recorded file is on disk at its recorded size.
+        func isComplete(in directory: URL) -> Bool {
+            files.allSatisfy { path, entry in
+                entry.isOnDisk(at: directory.appendingPathComponent(path))
+            }
+        }
+    }
+
+    // MARK: - Properties
+
+    /// The engine files are fetched with.
+    let downloader: RangedDownloader
+
+    /// HuggingFace token for private or gated repositories.
+    let token: String?
+
+    /// The Hub the files are fetched from.
+    let endpoint: URL
+
+    /// The Hugging Face Hub cache searched for files before they are
+    /// downloaded, or `nil` to always download.
+    let hubCache: URL?
+
+    // MARK: - Initialization
+
+    /// Creates a snapshot downloader.
+    ///
+    /// - Parameters:
+    ///   - downloader: The engine files are fetched with. Default: ``RangedDownloader/shared``
+    ///   - token: HuggingFace token. Default: `HF_TOKEN` from the environment
+    ///   - endpoint: The Hub to fetch from. Default: `https://huggingface.co`
+    ///   - hubCache: The Hub cache to reuse files from. Default: ``defaultHubCache()``
+    init(
+        downloader: RangedDownloader = .shared,
+        token: String? = HFTokenProvider.auto.token,
+        endpoint: URL = URL(string: "https://huggingface.co")!,
+        hubCache: URL? = HFSnapshotDownloader.defaultHubCache()
+    ) {
+        self.downloader = downloader
+        self.token = token
+        self.endpoint = endpoint
+        self.hubCache = hubCache
+    }
+
+    /// The Hugging Face Hub cache: `HF_HUB_CACHE`, then `HF_HOME/hub`,
+    /// then `~/.cache/huggingface/hub`.
+    static func defaultHubCache(
+        environment: [String: String] = ProcessInfo.processInfo.environment
+    ) -> URL? {
+        if let cache = environment["HF_HUB_CACHE"], !cache.isEmpty {
+            return URL(fileURLWithPath: cache, isDirectory: true)
+        }
+        if let home = environment["HF_HOME"], !home.isEmpty {
+            return URL(fileURLWithPath: home, isDirectory: true).appendingPathComponent("hub", isDirectory: true)
+        }
+        return URL(fileURLWithPath: NSHomeDirectory(), isDirectory: true)
+            .appendingPathComponent(".cache/huggingface/hub", isDirectory: true)
+    }
+
+    /// Where Conduit stores the snapshot of `repoId` by default.
+    ///
+    /// This is the directory ``VLMDetector`` reads model configs from.
+    static func defaultDirectory(for repoId: String) -> URL {
+        let base = FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask).first
+            ?? FileManager.default.temporaryDirectory
+        return base
+            .appendingPathComponent("Conduit", isDirectory: true)
+            .appendingPathComponent("models", isDirectory: true)
+            .appendingPathComponent(repoId.replacingOccurrences(of: "/", with: "_"), isDirectory: true)
+    }
+
+    // MARK: - Download
+
+    /// Downloads the files of `repoId` that match `patterns`.
+    ///
+    /// - Parameters:
+    ///   - repoId: The repository identifier (e.g., "mlx-community/sdxl-turbo").
+    ///   - revision: The branch, tag, or commit to download. Default: `main`
+    ///   - patterns: Glob patterns matched against each file's path and name.
+    ///   - directory: Where to place the files. Default: ``defaultDirectory(for:)``
+    ///   - useLatest: Whether to check the Hub for changes when a complete
+    ///     snapshot of the same revision and patterns is already on disk.
+    ///   - progressHandler: Called with byte progress as files download.
+    /// - Returns: The downloaded snapshot.
+    /// - Throws: ``RepositoryUnavailable`` if the repository cannot be listed
+    ///   and no complete snapshot is on disk, or any error from
+    ///   ``RangedDownloader/download(_:progress:)``.
+    func download(
+        repoId: String,
+        revision: String = "main",
+        matching patterns: [String],
+        to directory: URL? = nil,
+        useLatest: Bool = true,
+        progressHandler: (@Sendable (Foundation.Progress) -> Void)? = nil
+    ) async throws -> Snapshot {
+        let directory = directory ?? Self.defaultDirectory(for: repoId)
+        let previous = Manifest.load(from: directory)
+
+        if !useLatest, let previous,
+           previous.revision == revision, previous.patterns == patterns,
+           previous.isComplete(in: directory) {
+            return Snapshot(directory: directory, files: previous.files)
+        }
+
+        guard let tree = await HFMetadataService.shared.fetchFileTree(
+            repoId: repoId,
+            revision: revision,
+            token: token,
+            maximumAge: useLatest ? 0 : nil
+        ) else {
+            // Offline: a complete earlier snapshot is still usable
+            if let previous, previous.isComplete(in: directory) {
+                return Snapshot(directory: directory, files: previous.files)
+            }
+            throw RepositoryUnavailable(repoId: repoId, revision: revision)
+        }
+
+        let selected = tree.filter { file in
+            file.type != "directory" && Self.isSafePath(file.path) && Self.matches(file.path, patterns: patterns)
+        }
+
+        var manifest = Manifest(revision: revision, patterns: patterns, files: [:])
+        var pending: [(path: String, oid: String?, file: RangedDownloader.File)] = []
+        for entry in selected {
+            let destination = directory.appendingPathComponent(entry.path)
+            if let kept = previous?.files[entry.path],
+               kept.oid != nil, kept.oid == entry.oid,
+               kept.isOnDisk(at: destination) {
+                manifest.files[entry.path] = kept
+                continue
+            }
+            if let adopted = adoptFromHubCache(entry, repoId: repoId, to: destination) {
+                manifest.files[entry.path] = adopted
+                continue
+            }
+            pending.append((entry.path, entry.oid, RangedDownloader.File(
+                url: resolveURL(repoId: repoId, revision: revision, path: entry.path),
+                destination: destination,
+                expectedSize: entry.size == nil && entry.lfs == nil ? nil : entry.effectiveSize,
+                expectedSHA256: entry.lfs?.oid.map(Self.stripAlgorithmPrefix),
+                headers: token.map { ["Authorization": "Bearer \($0)"] } ?? [:]
+            )))
+        }
+
+        let downloaded = try await downloader.download(pending.map(\.file)) { progress in
+            guard let progressHandler else { return }
+            let foundationProgress = Foundation.Progress(totalUnitCount: max(1, progress.totalBytes))
+            foundationProgress.completedUnitCount = progress.completedBytes
+            progressHandler(foundationProgress)
+        }
+
+        for (item, file) in zip(pending, downloaded) {
+            manifest.files[item.path] = Manifest.Entry(oid: item.oid, size: file.size, sha256: file.sha256)
+        }
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        try manifest.save(to: directory)
+        return Snapshot(directory: directory, files: manifest.files)
+    }
+
+    // MARK: - Hub Cache
+
+    /// Links the Hub cache's copy of `file` to `destination`.
+    ///
+    /// The blob is hard-linked, or symlinked when the Hub cache is on another
+    /// volume, so the weights are stored once.
+    ///
+    /// - Returns: The file's manifest entry, or `nil` if the Hub cache does not
+    ///   hold it at the expected size or it could not be linked.
+    func adoptFromHubCache(
+        _ file: HFMetadataService.RepoFile,
+        repoId: String,
+        to destination: URL
+    ) -> Manifest.Entry? {
+        let lfsDigest = file.lfs?.oid.map(Self.stripAlgorithmPrefix)
+        guard let hubCache, let blobName = lfsDigest ?? file.oid, !blobName.isEmpty,
+              blobName.allSatisfy(\.isHexDigit) else {
+            return nil
+        }
+
+        let blob = hubCache
+            .appendingPathComponent("models--" + repoId.replacingOccurrences(of: "/", with: "--"), isDirectory: true)
+            .appendingPathComponent("blobs", isDirectory: true)
+            .appendingPathComponent(blobName)
+        let fileManager = FileManager.default
+        guard let size = (try? fileManager.attributesOfItem(atPath: blob.path))?[.size] as? NSNumber,
+              (file.size == nil && file.lfs == nil) || size.int64Value == file.effectiveSize else {
+            return nil
+        }
+
+        do {
+            try fileManager.createDirectory(
+                at: destination.deletingLastPathComponent(),
+                withIntermediateDirectories: true
+            )
+            // attributesOfItem does not follow links, so this also finds a dangling symlink
+            if (try? fileManager.attributesOfItem(atPath: destination.path)) != nil {
+                try fileManager.removeItem(at: destination)
+            }
+            do {
+                try fileManager.linkItem(at: blob, to: destination)
+            } catch {
+                try fileManager.createSymbolicLink(at: destination, withDestinationURL: blob)
+            }
+        } catch {
+            return nil
+        }
+
+        // LFS blobs are named by their SHA-256; small git blobs are hashed here
+        guard let sha256 = lfsDigest ?? (try? Data(contentsOf: blob)).map(SHA256Digest.hex(of:)) else { return nil }
+        return Manifest.Entry(oid: file.oid, size: size.int64Value, sha256: sha256)
+    }
+
+    // MARK: - Helpers
+
+
+    /// The download URL of `path` at `revision`.
+    private func resolveURL(repoId: String, revision: String, path: String) -> URL {
+        var url = endpoint
+            .appendingPathComponent(repoId)
+            .appendingPathComponent("resolve")
+            .appendingPathComponent(revision)
+        for component in path.split(separator: "/") {
+            url.appendPathComponent(String(component))
+        }
+        return url
+    }
+
+    /// Whether `path` matches any of `patterns`, by full path or file name.
+    static func matches(_ path: String, patterns: [String]) -> Bool {
+        let name = (path as NSString).lastPathComponent
+        return GlobMatcher.compiled(patterns).contains { matcher in
+            matcher.matches(path) || matcher.matches(name)
+        }
+    }
+
+    /// Rejects paths that would escape the snapshot directory.
+    private static func isSafePath(_ path: String) -> Bool {
+        !path.hasPrefix("/") && !path.split(separator: "/").contains("..")
+    }
+
+    /// Drops a `sha256:` prefix from an LFS object ID.
+    private static func stripAlgorithmPrefix(_ oid: String) -> String {
+        oid.hasPrefix("sha256:") ? String(oid.dropFirst("sha256:".count)) : oid
+    }
+}
@@ -47,8 +47,8 @@ import Foundation
 ///   - "llava", "pixtral", "vision", "vlm", "paligemma", etc.
 ///
 /// ## Performance
-/// - Metadata detection: ~100-300ms (network call)
-/// - Config inspection: ~10ms (local file read)
+/// - Metadata detection: ~100-300ms (network call), then cached by ``HFMetadataService``
+/// - Config inspection: ~10ms (local file read), then reused until the file changes
 /// - Name heuristics: <1ms (string matching)
 ///
 /// ## Thread Safety
@@ -132,6 +132,12 @@ public actor VLMDetector {
         "minicpm-v", "phi-3-vision", "mllama", "florence"
     ]
 
+    // MARK: - State
+
+    /// Capabilities read from config.json files, keyed by path and model,
+    /// with the modification date they were read at.
+    private var configCapabilities: [String: (modified: Date, capabilities: ModelCapabilities)] = [:]
+
     // MARK: - Initialization
 
     private init() {}
@@ -265,14 +271,7 @@ public actor VLMDetector {
             return nil
         }
 
-        let configURL = modelPath.appendingPathComponent("config.json")
-
-        guard let data = try? Data(contentsOf: configURL),
-              let config = try? JSONSerialization.jsonObject(with: data) as? [String: Any] else {
-            return nil
-        }
-
-        return analyzeConfig(config: config, repoId: path)
+        return capabilities(fromConfigAt: modelPath.appendingPathComponent("config.json"), repoId: path)
     }
 
     /// Detects capabilities by inspecting config.json from a downloaded model.
@@ -294,14 +293,35 @@ public actor VLMDetector {
             return nil
         }
 
-        let configURL = modelPath.appendingPathComponent("config.json")
+        return capabilities(fromConfigAt: modelPath.appendingPathComponent("config.json"), repoId: repoId)
+    }
+
+    /// Reads and analyzes a config.json, reusing the last result while the
+    /// file's modification date is unchanged.
+    ///
+    /// - Parameters:
+    ///   - configURL: The config.json location.
+    ///   - repoId: The model identifier (repo ID or path) for architecture detection.
+    /// - Returns: Detected capabilities, or `nil` if the config is missing or invalid.
+    private func capabilities(fromConfigAt configURL: URL, repoId: String) -> ModelCapabilities? {
+        guard let attributes = try? FileManager.default.attributesOfItem(atPath: configURL.path),
+              let modified = attributes[.modificationDate] as? Date else {
+            return nil
+        }
+
+        let key = "\(configURL.path)\n\(repoId)"
+        if let cached = configCapabilities[key], cached.modified == modified {
+            return cached.capabilities
+        }
 
         guard let data = try? Data(contentsOf: configURL),
               let config = try? JSONSerialization.jsonObject(with: data) as? [String: Any] else {
             return nil
         }
 
-        return analyzeConfig(config: config, repoId: repoId)
+        let capabilities = analyzeConfig(config: config, repoId: repoId)
+        configCapabilities[key] = (modified, capabilities)
+        return capabilities
     }
 
     /// Analyzes config dictionary for VLM capabilities.
@@ -0,0 +1,450 @@
+// BPETokenizer.swift
+// Conduit
+//
+// Byte-level BPE tokenizer that reads tiktoken rank files.
+
+import Foundation
+
+/// A byte-level byte-pair-encoding tokenizer compatible with tiktoken.
+///
+/// Tokenization follows tiktoken exactly:
+/// 1. The text is split into chunks by the encoding's pre-tokenization pattern.
+/// 2. Each chunk's UTF-8 bytes are merged pairwise, lowest rank first, until
+///    no adjacent pair is in the vocabulary.
+///
+/// The rank file is the `.tiktoken` format: one `<base64 token> <rank>` pair
+/// per line. Pass memory-mapped `Data` so the file is paged in rather than
+/// copied: the vocabulary stays in the file, and an open-addressing hash
+/// table indexes each token's base64 text in place. Lookups base64-encode
+/// the candidate bytes into a stack buffer and compare them with the mapped
+/// text, so no token is ever decoded into a separate pool.
+///
+/// The merge loop works in a scratch buffer reused across chunks, so it
+/// allocates per chunk at most, never per token. Results for short chunks
+/// (common words, whitespace runs, punctuation) are memoized.
+///
+/// ## Usage
+/// ```swift
+/// let tokenizer = try BPETokenizer(
+///     name: "cl100k_base",
+///     rankFile: URL(fileURLWithPath: "cl100k_base.tiktoken"),
+///     pattern: OpenAITokenizerEncoding.cl100kBase.pattern,
+///     specialTokens: ["<|endoftext|>": 100257]
+/// )
+/// let tokens = tokenizer.encode("Hello, world!")
+/// let text = try tokenizer.decode(tokens)
+/// ```
+///
+/// ## Thread Safety
+/// Rank tables are immutable after initialization. The chunk memo is
+/// guarded by an `NSLock` that is held only for dictionary access.
+internal final class BPETokenizer: @unchecked Sendable {
+
+    /// Chunks up to this many UTF-8 bytes are memoized.
+    static let memoizedChunkByteLimit = 64
+
+    /// Memo entries kept before the memo is reset.
+    static let memoCapacity = 32_768
+
+    /// Encoding name, e.g. `cl100k_base`.
+    let name: String
+
+    private let ranks: RankTable
+    private let pattern: NSRegularExpression
+    private let specialTokensByRank: [Int: String]
+
+    private let lock = NSLock()
+    private var memo: [String: [Int]] = [:]
+
+    // MARK: - Initialization
+
+    /// Creates a tokenizer from the contents of a `.tiktoken` rank file.
+    ///
+    /// - Parameters:
+    ///   - name: Encoding name.
+    ///   - rankFileContents: The rank file, ideally memory-mapped.
+    ///   - pattern: Pre-tokenization regular expression.
+    ///   - specialTokens: Special token strings and their ranks.
+    /// - Throws: `AIError.invalidInput` if the rank file or pattern is malformed.
+    init(
+        name: String,
+        rankFileContents: Data,
+        pattern: String,
+        specialTokens: [String: Int] = [:]
+    ) throws {
+        self.name = name
+        self.ranks = try RankTable(tiktokenContents: rankFileContents)
+        do {
+            self.pattern = try NSRegularExpression(pattern: pattern)
+        } catch {
+            throw AIError.invalidInput("Invalid pre-tokenization pattern for \(name): \(error.localizedDescription)")
+        }
+        self.specialTokensByRank = Dictionary(
+            specialTokens.map { ($0.value, $0.key) },
+            uniquingKeysWith: { first, _ in first }
+        )
+    }
+
+    /// Creates a tokenizer by memory-mapping a `.tiktoken` rank file.
+    ///
+    /// - Throws: `AIError.fileError` if the file cannot be read, or
+    ///   `AIError.invalidInput` if it is malformed.
+    convenience init(
+        name: String,
+        rankFile: URL,
+        pattern: String,
+        specialTokens: [String: Int] = [:]
+    ) throws {
+        let contents: Data
+        do {
+            contents = try Data(contentsOf: rankFile, options: .alwaysMapped)
+        } catch {
+            throw AIError.fileError(underlying: SendableError(error))
+        }
+        try self.init(name: name, rankFileContents: contents, pattern: pattern, specialTokens: specialTokens)
+    }
+
+    // MARK: - Encoding
+
+    /// Encodes `text`, treating special-token strings as ordinary text.
+    func encode(_ text: String) -> [Int] {
+        var tokens: [Int] = []
+        tokens.reserveCapacity(text.utf8.count / 3)
+        var scratch: [MergePart] = []
+        forEachChunk(of: text) { chunk in
+            tokens.append(contentsOf: encodeChunk(chunk, scratch: &scratch))
+        }
+        return tokens
+    }
+
+    /// Number of tokens in `text`, without materializing the full token array.
+    func count(_ text: String) -> Int {
+        var total = 0
+        var scratch: [MergePart] = []
+        forEachChunk(of: text) { chunk in
+            total += encodeChunk(chunk, scratch: &scratch).count
+        }
+        return total
+    }
+
+    /// Decodes tokens to text.
+    ///
+    /// Byte sequences that are not valid UTF-8 are replaced with U+FFFD.
+    ///
+    /// - Throws: `AIError.invalidInput` for a token outside the vocabulary.
+    func decode(_ tokens: [Int], skipSpecialTokens: Bool = false) throws -> String {
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(tokens.count * 4)
+
+        for token in tokens {
+            if let special = specialTokensByRank[token] {
+                if !skipSpecialTokens {
+                    bytes.append(contentsOf: special.utf8)
+                }
+            } else if !ranks.appendBytes(forRank: token, to: &bytes) {
+                throw AIError.invalidInput("Token \(token) is not in the \(name) vocabulary")
+            }
+        }
+        return String(decoding: bytes, as: UTF8.self)
+    }
+
+    // MARK: - Pre-tokenization
+
+    private func forEachChunk(of text: String, _ body: (Substring) -> Void) {
+        let utf16Range = NSRange(text.startIndex..<text.endIndex, in: text)
+        pattern.enumerateMatches(in: text, range: utf16Range) { match, _, _ in
+            guard let match, let range = Range(match.range, in: text), !range.isEmpty else { return }
+            body(text[range])
+        }
+    }
+
+    private func withLock<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
+    }
+
+    // MARK: - Byte-Pair Merge
+
+    /// A merge boundary: the byte offset where a part starts and the rank of
+    /// merging it with the next part.
+    private struct MergePart {
+        var start: Int
+        var rank: Int
+    }
+
+    private func encodeChunk(_ chunk: Substring, scratch: inout [MergePart]) -> [Int] {
+        // Only short chunks repeat often enough to be worth memoizing
+        let key = chunk.utf8.count <= Self.memoizedChunkByteLimit ? String(chunk) : nil
+        if let key, let cached = withLock({ memo[key] }) {
+            return cached
+        }
+
+        var chunk = chunk
+        let tokens = chunk.withUTF8 { bytes in
+            mergeBytes(bytes, scratch: &scratch)
+        }
+
+        if let key {
+            withLock {
+                if memo.count >= Self.memoCapacity {
+                    memo.removeAll(keepingCapacity: true)
+                }
+                memo[key] = tokens
+            }
+        }
+        return tokens
+    }
+
+    /// tiktoken's `byte_pair_merge`: repeatedly merges the lowest-ranked
+    /// adjacent pair, updating only the two neighbouring ranks per merge.
+    private func mergeBytes(_ bytes: UnsafeBufferPointer<UInt8>, scratch parts: inout [MergePart]) -> [Int] {
+        if let rank = ranks.rank(of: bytes) {
+            return [rank]
+        }
+
+        let unranked = Int.max
+        parts.removeAll(keepingCapacity: true)
+        parts.reserveCapacity(bytes.count + 1)
+        for start in 0..<(bytes.count - 1) {
+            let pair = UnsafeBufferPointer(rebasing: bytes[start..<(start + 2)])
+            parts.append(MergePart(start: start, rank: ranks.rank(of: pair) ?? unranked))
+        }
+        parts.append(MergePart(start: bytes.count - 1, rank: unranked))
+        parts.append(MergePart(start: bytes.count, rank: unranked))
+
+        // Rank of the bytes spanning parts[index] through parts[index + 2].
+        func mergedRank(at index: Int) -> Int {
+            guard index + 3 < parts.count else { return unranked }
+            let span = UnsafeBufferPointer(rebasing: bytes[parts[index].start..<parts[index + 3].start])
+            return ranks.rank(of: span) ?? unranked
+        }
+
+        while parts.count > 2 {
+            var minIndex = 0
+            var minRank = unranked
+            for index in 0..<(parts.count - 1) where parts[index].rank < minRank {
+                minRank = parts[index].rank
+                minIndex = index
+            }
+            guard minRank != unranked else { break }
+
+            if minIndex > 0 {
+                parts[minIndex - 1].rank = mergedRank(at: minIndex - 1)
+            }
+            parts[minIndex].rank = mergedRank(at: minIndex)
+            parts.remove(at: minIndex + 1)
+        }
+
+        var tokens: [Int] = []
+        tokens.reserveCapacity(parts.count - 1)
+        for index in 0..<(parts.count - 1) {
+            let piece = UnsafeBufferPointer(rebasing: bytes[parts[index].start..<parts[index + 1].start])
+            // Every single byte is in a byte-level vocabulary, so this only
+            // fails for malformed rank files.
+            tokens.append(ranks.rank(of: piece) ?? 0)
+        }
+        return tokens
+    }
+}
+
+// MARK: - RankTable
+
+/// Ranks from a `.tiktoken` file, indexed both ways without copying the tokens.
+///
+/// Each token is kept as the offset and length of its unpadded base64 text
+/// in the rank file's `Data`, which is usually memory-mapped.
+private struct RankTable: Sendable {
+
+    /// The rank file contents.
+    private let contents: Data
+
+    /// Start of each rank's base64 text in `contents`; `-1` for unused ranks.
+    private let offsets: [Int]
+
+    /// Length of each rank's base64 text, without padding.
+    private let lengths: [Int]
+
+    /// Open-addressing table of ranks keyed by base64 text; `-1` is empty.
+    private let slots: [Int]
+    private let mask: Int
+
+    init(tiktokenContents contents: Data) throws {
+        var entries: [(offset: Int, length: Int, rank: Int)] = []
+        entries.reserveCapacity(contents.count / 12)
+
+        try contents.withUnsafeBytes { (raw: UnsafeRawBufferPointer) in
+            let bytes = raw.bindMemory(to: UInt8.self)
+            var lineStart = 0
+            while lineStart < bytes.count {
+                var lineEnd = lineStart
+                while lineEnd < bytes.count, bytes[lineEnd] != UInt8(ascii: "\n") {
+                    lineEnd += 1
+                }
+                defer { lineStart = lineEnd + 1 }
+
+                var end = lineEnd
+                if end > lineStart, bytes[end - 1] == UInt8(ascii: "\r") { end -= 1 }
+                guard end > lineStart else { continue }
+
+                guard let space = (lineStart..<end).first(where: { bytes[$0] == UInt8(ascii: " ") }),
+                      let rank = Self.parseDecimal(bytes[(space + 1)..<end]) else {
+                    throw AIError.invalidInput("Malformed tiktoken rank file line")
+                }
+
+                var textEnd = space
+                while textEnd > lineStart, bytes[textEnd - 1] == UInt8(ascii: "=") {
+                    textEnd -= 1
+                }
+                guard textEnd > lineStart, bytes[lineStart..<textEnd].allSatisfy({ Self.base64Value($0) != nil }) else {
+                    throw AIError.invalidInput("Malformed base64 token in tiktoken rank file")
+                }
+                entries.append((lineStart, textEnd - lineStart, rank))
+            }
+        }
+
+        guard !entries.isEmpty else {
+            throw AIError.invalidInput("Empty tiktoken rank file")
+        }
+
+        let maxRank = entries.map(\.rank).max() ?? 0
+        var offsets = [Int](repeating: -1, count: maxRank + 1)
+        var lengths = [Int](repeating: 0, count: maxRank + 1)
+
+        var capacity = 1
+        while capacity < entries.count * 2 { capacity <<= 1 }
+        var slots = [Int](repeating: -1, count: capacity)
+        let mask = capacity - 1
+
+        contents.withUnsafeBytes { (raw: UnsafeRawBufferPointer) in
+            let bytes = raw.bindMemory(to: UInt8.self)
+            for entry in entries {
+                offsets[entry.rank] = entry.offset
+                lengths[entry.rank] = entry.length
+
+                let key = UnsafeBufferPointer(rebasing: bytes[entry.offset..<(entry.offset + entry.length)])
+                var slot = Self.hash(key) & mask
+                while slots[slot] != -1 {
+                    slot = (slot + 1) & mask
+                }
+                slots[slot] = entry.rank
+            }
+        }
+
+        self.contents = contents
+        self.offsets = offsets
+        self.lengths = lengths
+        self.slots = slots
+        self.mask = mask
+    }
+
+    /// Rank of a token, or `nil` if the bytes are not in the vocabulary.
+    func rank(of bytes: UnsafeBufferPointer<UInt8>) -> Int? {
+        guard !bytes.isEmpty else { return nil }
+        let encodedCount = (bytes.count * 4 + 2) / 3
+
+        return withUnsafeTemporaryAllocation(of: UInt8.self, capacity: encodedCount) { buffer -> Int? in
+            Self.encodeBase64(bytes, into: buffer)
+            let key = UnsafeBufferPointer(buffer)
+            var slot = Self.hash(key) & mask
+            return contents.withUnsafeBytes { (raw: UnsafeRawBufferPointer) -> Int? in
+                while true {
+                    let rank = slots[slot]
+                    if rank == -1 { return nil }
+                    if lengths[rank] == key.count,
+                       memcmp(raw.baseAddress! + offsets[rank], key.baseAddress!, key.count) == 0 {
+                        return rank
+                    }
+                    slot = (slot + 1) & mask
+                }
+            }
+        }
+    }
+
+    /// Appends the bytes of the token with `rank` to `output`.
+    ///
+    /// - Returns: `false` if the rank is unused.
+    func appendBytes(forRank rank: Int, to output: inout [UInt8]) -> Bool {
+        guard offsets.indices.contains(rank), offsets[rank] >= 0 else { return false }
+        let range = offsets[rank]..<(offsets[rank] + lengths[rank])
+        contents.withUnsafeBytes { (raw: UnsafeRawBufferPointer) in
+            Self.decodeBase64(raw.bindMemory(to: UInt8.self)[range], into: &output)
+        }
+        return true
+    }
+
+    // MARK: - Base64
+
+    private static let alphabet = Array("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/".utf8)
+
+    /// Writes the unpadded base64 encoding of `bytes`; `output` holds exactly that many characters.
+    private static func encodeBase64(
+        _ bytes: UnsafeBufferPointer<UInt8>,
+        into output: UnsafeMutableBufferPointer<UInt8>
+    ) {
+        var written = 0
+        var index = 0
+        while index < bytes.count {
+            let remaining = bytes.count - index
+            let first = UInt32(bytes[index])
+            let second = remaining > 1 ? UInt32(bytes[index + 1]) : 0
+            let third = remaining > 2 ? UInt32(bytes[index + 2]) : 0
+            let group = first << 16 | second << 8 | third
+
+            for position in 0..<min(4, remaining + 1) {
+                output[written] = alphabet[Int((group >> UInt32(18 - 6 * position)) & 0x3F)]
+                written += 1
+            }
+            index += 3
+        }
+    }
+
+    /// Appends the decoded bytes of unpadded base64 to `output`.
+    private static func decodeBase64(_ encoded: Slice<UnsafeBufferPointer<UInt8>>, into output: inout [UInt8]) {
+        var accumulator: UInt32 = 0
+        var bits = 0
+
+        for character in encoded {
+            guard let value = base64Value(character) else { return }
+            accumulator = (accumulator << 6) | value
+            bits += 6
+            if bits >= 8 {
+                bits -= 8
+                output.append(UInt8(truncatingIfNeeded: accumulator >> UInt32(bits)))
+            }
+        }
+    }
+
+    private static func base64Value(_ character: UInt8) -> UInt32? {
+        switch character {
+        case UInt8(ascii: "A")...UInt8(ascii: "Z"): return UInt32(character - UInt8(ascii: "A"))
+        case UInt8(ascii: "a")...UInt8(ascii: "z"): return UInt32(character - UInt8(ascii: "a")) + 26
+        case UInt8(ascii: "0")...UInt8(ascii: "9"): return UInt32(character - UInt8(ascii: "0")) + 52
+        case UInt8(ascii: "+"): return 62
+        case UInt8(ascii: "/"): return 63
+        default: return nil
+        }
+    }
+
+    // MARK: - Parsing Helpers
+
+    /// 64-bit FNV-1a.
+    private static func hash(_ bytes: UnsafeBufferPointer<UInt8>) -> Int {
+        var hash: UInt64 = 0xCBF2_9CE4_8422_2325
+        for byte in bytes {
+            hash ^= UInt64(byte)
+            hash = hash &* 0x0000_0100_0000_01B3
+        }
+        return Int(truncatingIfNeeded: hash)
+    }
+
+    private static func parseDecimal(_ digits: Slice<UnsafeBufferPointer<UInt8>>) -> Int? {
+        guard !digits.isEmpty else { return nil }
+        var value = 0
+        for digit in digits {
+            guard digit >= UInt8(ascii: "0"), digit <= UInt8(ascii: "9") else { return nil }
+            value = value * 10 + Int(digit - UInt8(ascii: "0"))
+        }
+        return value
+    }
+}
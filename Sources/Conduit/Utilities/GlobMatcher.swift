@@ -23,9 +23,29 @@ import Foundation
 /// matcher?.matches("config.json") // false
 /// ```
 ///
+/// Patterns of the form `*.ext`, `prefix*` or a plain file name are matched
+/// by comparing strings, without a regular expression. Use
+/// ``compiled(_:)`` to reuse matchers for patterns that are checked often.
+///
 /// - Note: Returns `nil` if the pattern cannot be converted to a valid regex.
 public struct GlobMatcher: Sendable {
-    private let regex: NSRegularExpression
+
+    /// How a pattern is tested.
+    private enum Strategy: @unchecked Sendable {
+        /// The pattern has no wildcards.
+        case literal(String)
+
+        /// The pattern is `*` followed by a literal.
+        case suffix(String)
+
+        /// The pattern is a literal followed by `*`.
+        case prefix(String)
+
+        /// Any other pattern.
+        case regex(NSRegularExpression)
+    }
+
+    private let strategy: Strategy
 
     /// Creates a glob matcher from a wildcard pattern.
     ///
@@ -46,6 +66,20 @@ public struct GlobMatcher: Sendable {
     /// - Parameter pattern: A glob pattern string.
     /// - Returns: A matcher instance, or `nil` if the pattern is invalid.
     public init?(_ pattern: String) {
+        let wildcards = pattern.filter { $0 == "*" || $0 == "?" }
+        if wildcards.isEmpty {
+            strategy = .literal(pattern)
+            return
+        }
+        if wildcards == "*", pattern.hasPrefix("*") {
+            strategy = .suffix(String(pattern.dropFirst()))
+            return
+        }
+        if wildcards == "*", pattern.hasSuffix("*") {
+            strategy = .prefix(String(pattern.dropLast()))
+            return
+        }
+
         var escaped = ""
         for ch in pattern {
             switch ch {
@@ -61,7 +95,7 @@ public struct GlobMatcher: Sendable {
         }
 
         do {
-            regex = try NSRegularExpression(pattern: "^\(escaped)$")
+            strategy = .regex(try NSRegularExpression(pattern: "^\(escaped)$"))
         } catch {
             return nil
         }
@@ -79,7 +113,56 @@ public struct GlobMatcher: Sendable {
     /// matcher.matches("model.safetensors") // false
     /// ```
     public func matches(_ text: String) -> Bool {
-        let range = NSRange(location: 0, length: (text as NSString).length)
-        return regex.firstMatch(in: text, options: [], range: range) != nil
+        switch strategy {
+        case .literal(let literal):
+            return text == literal
+        case .suffix(let suffix):
+            return text.hasSuffix(suffix)
+        case .prefix(let prefix):
+            return text.hasPrefix(prefix)
+        case .regex(let regex):
+            let range = NSRange(location: 0, length: (text as NSString).length)
+            return regex.firstMatch(in: text, options: [], range: range) != nil
+        }
+    }
+
+    // MARK: - Compiled Patterns
+
+    /// Returns matchers for `patterns`, dropping invalid ones.
+    ///
+    /// Each pattern is compiled once per process and reused by later calls,
+    /// so hot paths such as filtering a repository listing do not rebuild
+    /// their regular expressions.
+    public static func compiled(_ patterns: [String]) -> [GlobMatcher] {
+        patterns.compactMap { compiledCache.matcher(for: $0) }
+    }
+
+    private static let compiledCache = CompiledCache()
+
+    /// Compiled matchers keyed by pattern.
+    private final class CompiledCache: @unchecked Sendable {
+        /// Patterns kept before the cache is cleared.
+        private static let limit = 256
+
+        private let lock = NSLock()
+        private var matchers: [String: GlobMatcher?] = [:]
+
+        func matcher(for pattern: String) -> GlobMatcher? {
+            lock.lock()
+            if let cached = matchers[pattern] {
+                lock.unlock()
+                return cached
+            }
+            lock.unlock()
+
+            let matcher = GlobMatcher(pattern)
+            lock.lock()
+            defer { lock.unlock() }
+            if matchers.count >= Self.limit {
+                matchers.removeAll(keepingCapacity: true)
+            }
+            matchers[pattern] = .some(matcher)
+            return matcher
+        }
     }
 }
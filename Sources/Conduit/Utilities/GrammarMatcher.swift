@@ -0,0 +1,604 @@
+// GrammarMatcher.swift
+// Conduit
+//
+// Incremental grammar matching and cached token masks for constrained decoding.
+
+import Foundation
+
+// MARK: - GrammarMatcher
+
+/// Tracks how far a byte sequence has progressed through a ``JSONGrammar``.
+///
+/// Every parse still consistent with the input is kept as a stack of rule
+/// positions, as in llama.cpp's grammar sampler. A rule that finishes with a
+/// reference is popped before the referenced rule is pushed, so
+/// right-recursive repetition keeps stacks flat. Inputs that can be
+/// continued the same way therefore reach the same ``State``, which is what
+/// makes per-state mask caching effective.
+struct GrammarMatcher: Sendable {
+
+    /// A position inside one alternative of a rule.
+    struct Position: Sendable, Hashable {
+        let rule: Int32
+        let alternative: Int32
+        var index: Int32
+    }
+
+    /// The set of live parse stacks. Equal states allow the same continuations.
+    struct State: Sendable, Hashable {
+        fileprivate(set) var stacks: Set<[Position]>
+    }
+
+    /// The grammar being matched.
+    let grammar: JSONGrammar
+
+    /// The parse stacks after the input so far.
+    private(set) var state: State
+
+    /// Creates a matcher positioned before any input.
+    init(grammar: JSONGrammar) {
+        self.grammar = grammar
+        var stacks = Set<[Position]>()
+        var visited = Set<[Position]>()
+        for alternative in grammar.rules[0].alternatives.indices {
+            let start = Position(rule: 0, alternative: Int32(alternative), index: 0)
+            Self.expand([start], grammar: grammar, into: &stacks, visited: &visited)
+        }
+        self.state = State(stacks: stacks)
+    }
+
+    /// Whether the input so far is a complete match.
+    var isComplete: Bool {
+        state.stacks.contains([])
+    }
+
+    /// Whether any byte may follow the input so far.
+    var canContinue: Bool {
+        state.stacks.contains { !$0.isEmpty }
+    }
+
+    /// Every byte that may follow the input so far.
+    var allowedBytes: GrammarByteSet {
+        var result = GrammarByteSet()
+        for stack in state.stacks {
+            switch terminal(of: stack) {
+            case .byte(let byte): result.insert(byte)
+            case .set(let set): result = result.union(set)
+            case .rule, nil: break
+            }
+        }
+        return result
+    }
+
+    /// The next byte, if the grammar allows exactly one and the input could
+    /// not also end here.
+    var forcedByte: UInt8? {
+        guard !isComplete else { return nil }
+        var forced: UInt8?
+        for stack in state.stacks {
+            let byte: UInt8
+            switch terminal(of: stack) {
+            case .byte(let value):
+                byte = value
+            case .set(let set):
+                guard let value = set.singleByte else { return nil }
+                byte = value
+            case .rule, nil:
+                return nil
+            }
+            if let forced, forced != byte {
+                return nil
+            }
+            forced = byte
+        }
+        return forced
+    }
+
+    /// Advances past `byte`.
+    ///
+    /// - Returns: `false`, leaving the matcher unchanged, if the grammar does
+    ///   not allow `byte` here.
+    @discardableResult
+    mutating func accept(_ byte: UInt8) -> Bool {
+        var next = Set<[Position]>()
+        var visited = Set<[Position]>()
+        for stack in state.stacks {
+            let matches: Bool
+            switch terminal(of: stack) {
+            case .byte(let value): matches = value == byte
+            case .set(let set): matches = set.contains(byte)
+            case .rule, nil: matches = false
+            }
+            guard matches else { continue }
+
+            var advanced = stack
+            advanced[advanced.count - 1].index += 1
+            Self.expand(advanced, grammar: grammar, into: &next, visited: &visited)
+        }
+        guard !next.isEmpty else { return false }
+        state.stacks = next
+        return true
+    }
+
+    /// Advances past every byte of `bytes`.
+    ///
+    /// - Returns: `false`, leaving the matcher unchanged, if any byte is rejected.
+    @discardableResult
+    mutating func accept<S: Sequence>(_ bytes: S) -> Bool where S.Element == UInt8 {
+        var copy = self
+        for byte in bytes {
+            guard copy.accept(byte) else { return false }
+        }
+        self = copy
+        return true
+    }
+
+    // MARK: - Expansion
+
+    private func terminal(of stack: [Position]) -> JSONGrammar.Symbol? {
+        guard let top = stack.last else { return nil }
+        return grammar.rules[Int(top.rule)].alternatives[Int(top.alternative)][Int(top.index)]
+    }
+
+    /// Resolves rule references on top of `stack` until every resulting
+    /// stack has a terminal on top or is empty.
+    private static func expand(
+        _ stack: [Position],
+        grammar: JSONGrammar,
+        into result: inout Set<[Position]>,
+        visited: inout Set<[Position]>
+    ) {
+        var stack = stack
+        while visited.insert(stack).inserted {
+            guard let top = stack.last else {
+                result.insert(stack)
+                return
+            }
+            let alternative = grammar.rules[Int(top.rule)].alternatives[Int(top.alternative)]
+            guard Int(top.index) < alternative.count else {
+                stack.removeLast()
+                continue
+            }
+
+            guard case .rule(let rule) = alternative[Int(top.index)] else {
+                result.insert(stack)
+                return
+            }
+            stack[stack.count - 1].index += 1
+            if Int(stack[stack.count - 1].index) == alternative.count {
+                stack.removeLast()
+            }
+            for child in grammar.rules[rule].alternatives.indices {
+                let position = Position(rule: Int32(rule), alternative: Int32(child), index: 0)
+                expand(stack + [position], grammar: grammar, into: &result, visited: &visited)
+            }
+            return
+        }
+    }
+}
+
+// MARK: - GrammarVocabulary
+
+/// The bytes of every token in a tokenizer's vocabulary, arranged as a
+/// prefix trie so a grammar can test all tokens in one walk.
+struct GrammarVocabulary: Sendable {
+
+    /// How a tokenizer's token strings spell bytes.
+    enum PieceEncoding: Sendable, Hashable {
+        /// GPT-2 style byte-level BPE, where bytes map to printable
+        /// characters and a space is spelled `Ġ`.
+        case byteLevel
+
+        /// SentencePiece, where a space is spelled `▁` and raw bytes are
+        /// spelled `<0xNN>`.
+        case sentencePiece
+
+        /// Token strings are the token's text.
+        case plain
+
+        /// Infers the encoding from a vocabulary's token strings.
+        static func detect(_ pieces: [String?]) -> PieceEncoding {
+            if pieces.contains(where: { $0?.unicodeScalars.contains("\u{0120}") == true }) {
+                return .byteLevel
+            }
+            if pieces.contains(where: { $0?.unicodeScalars.contains("\u{2581}") == true }) {
+                return .sentencePiece
+            }
+            return .plain
+        }
+    }
+
+    /// Number of token IDs, including ones that are never allowed.
+    let count: Int
+
+    private let tokenBytes: [[UInt8]]
+
+    // Trie in compressed sparse row form: node n's edges are
+    // edgeStart[n]..<edgeStart[n + 1] and its tokens
+    // tokenStart[n]..<tokenStart[n + 1].
+    private let edgeStart: [Int32]
+    private let edgeBytes: [UInt8]
+    private let edgeTargets: [Int32]
+    private let tokenStart: [Int32]
+    private let nodeTokens: [Int32]
+
+    /// Creates a vocabulary from each token's bytes, indexed by token ID.
+    /// Tokens without bytes are never allowed.
+    init(tokens: [[UInt8]?]) {
+        var children: [[UInt8: Int32]] = [[:]]
+        var tokensAtNode: [[Int32]] = [[]]
+        for (id, bytes) in tokens.enumerated() {
+            guard let bytes, !bytes.isEmpty else { continue }
+            var node = 0
+            for byte in bytes {
+                if let child = children[node][byte] {
+                    node = Int(child)
+                } else {
+                    children.append([:])
+                    tokensAtNode.append([])
+                    children[node][byte] = Int32(children.count - 1)
+                    node = children.count - 1
+                }
+            }
+            tokensAtNode[node].append(Int32(id))
+        }
+
+        var edgeStart: [Int32] = [], edgeBytes: [UInt8] = [], edgeTargets: [Int32] = []
+        var tokenStart: [Int32] = [], nodeTokens: [Int32] = []
+        for node in children.indices {
+            edgeStart.append(Int32(edgeBytes.count))
+            for (byte, child) in children[node].sorted(by: { $0.key < $1.key }) {
+                edgeBytes.append(byte)
+                edgeTargets.append(child)
+            }
+            tokenStart.append(Int32(nodeTokens.count))
+            nodeTokens += tokensAtNode[node]
+        }
+        edgeStart.append(Int32(edgeBytes.count))
+        tokenStart.append(Int32(nodeTokens.count))
+
+        self.count = tokens.count
+        self.tokenBytes = tokens.map { $0 ?? [] }
+        self.edgeStart = edgeStart
+        self.edgeBytes = edgeBytes
+        self.edgeTargets = edgeTargets
+        self.tokenStart = tokenStart
+        self.nodeTokens = nodeTokens
+    }
+
+    /// Creates a vocabulary from a tokenizer's token strings, indexed by
+    /// token ID. Special tokens such as `<|eot_id|>` are never allowed.
+    ///
+    /// - Parameters:
+    ///   - pieces: The token strings, or `nil` for unused IDs.
+    ///   - encoding: How the strings spell bytes. Default: inferred from `pieces`
+    init(pieces: [String?], encoding: PieceEncoding? = nil) {
+        let encoding = encoding ?? .detect(pieces)
+        self.init(tokens: pieces.map { piece in
+            guard let piece, !Self.isSpecial(piece) else { return nil }
+            return Self.bytes(of: piece, encoding: encoding)
+        })
+    }
+
+    /// The bytes a token stands for. Empty for tokens that are never allowed.
+    func bytes(of token: Int) -> [UInt8] {
+        token >= 0 && token < tokenBytes.count ? tokenBytes[token] : []
+    }
+
+    /// The longest token whose bytes start `bytes`, and its length.
+    func longestToken(prefixing bytes: ArraySlice<UInt8>) -> (token: Int, length: Int)? {
+        var node = 0
+        var best: (token: Int, length: Int)?
+        var length = 0
+        for byte in bytes {
+            guard let child = child(of: node, byte: byte) else { break }
+            node = child
+            length += 1
+            let tokens = self.tokens(at: node)
+            if let first = tokens.first {
+                best = (Int(first), length)
+            }
+        }
+        return best
+    }
+
+    // MARK: Trie Access
+
+    /// The root node of the trie.
+    static let root = 0
+
+    /// The edges leaving `node`, as `(byte, child)` pairs in byte order.
+    func children(of node: Int) -> Zip2Sequence<ArraySlice<UInt8>, ArraySlice<Int32>> {
+        let range = Int(edgeStart[node])..<Int(edgeStart[node + 1])
+        return zip(edgeBytes[range], edgeTargets[range])
+    }
+
+    /// The tokens whose bytes end exactly at `node`.
+    func tokens(at node: Int) -> ArraySlice<Int32> {
+        nodeTokens[Int(tokenStart[node])..<Int(tokenStart[node + 1])]
+    }
+
+    private func child(of node: Int, byte: UInt8) -> Int? {
+        for (edge, child) in children(of: node) where edge == byte {
+            return Int(child)
+        }
+        return nil
+    }
+
+    // MARK: Piece Decoding
+
+    private static let specialPieces: Set<String> = ["<s>", "</s>", "<unk>", "<pad>", "<bos>", "<eos>"]
+
+    static func isSpecial(_ piece: String) -> Bool {
+        (piece.hasPrefix("<|") && piece.hasSuffix("|>")) || specialPieces.contains(piece)
+    }
+
+    /// The bytes a token string spells, or `nil` if it is not valid in `encoding`.
+    static func bytes(of piece: String, encoding: PieceEncoding) -> [UInt8]? {
+        switch encoding {
+        case .plain:
+            return Array(piece.utf8)
+        case .sentencePiece:
+            if piece.count == 6, piece.hasPrefix("<0x"), piece.hasSuffix(">"),
+               let byte = UInt8(piece.dropFirst(3).dropLast(), radix: 16) {
+                return [byte]
+            }
+            return Array(piece.replacingOccurrences(of: "\u{2581}", with: " ").utf8)
+        case .byteLevel:
+            var bytes: [UInt8] = []
+            bytes.reserveCapacity(piece.unicodeScalars.count)
+            for scalar in piece.unicodeScalars {
+                guard let byte = byteLevelDecoder[scalar.value] else { return nil }
+                bytes.append(byte)
+            }
+            return bytes
+        }
+    }
+
+    /// Inverse of GPT-2's `bytes_to_unicode` table.
+    private static let byteLevelDecoder: [UInt32: UInt8] = {
+        var printable = Array(33...126) + Array(161...172) + Array(174...255)
+        var scalars = printable.map(UInt32.init)
+        var next: UInt32 = 256
+        for byte in 0..<256 where !printable.contains(byte) {
+            printable.append(byte)
+            scalars.append(next)
+            next += 1
+        }
+        var decoder: [UInt32: UInt8] = [:]
+        for (byte, scalar) in zip(printable, scalars) {
+            decoder[scalar] = UInt8(byte)
+        }
+        return decoder
+    }()
+}
+
+// MARK: - GrammarTokenMasker
+
+/// Computes which tokens of one vocabulary a grammar allows, caching the
+/// result for each matcher state.
+///
+/// A state's mask is found by walking the vocabulary trie with the matcher,
+/// so tokens sharing a prefix share work and subtrees the grammar rejects
+/// are skipped. Matcher states are interned and their byte transitions
+/// memoized, so the walk inside a free-form string, which returns to the
+/// same state after every character, is mostly table lookups. JSON output
+/// revisits few states (inside a string, between members, inside a
+/// number), so after the first tokens most masks are cache hits.
+///
+/// The masker also finds *forced* tokens: where the grammar allows only one
+/// byte at a time, those bytes must follow whatever the model prefers, so
+/// they can be appended without sampling.
+///
+/// Marked `@unchecked Sendable` because all state is guarded by an `NSLock`.
+final class GrammarTokenMasker: @unchecked Sendable {
+
+    /// Interned states are dropped, with their masks, beyond this many.
+    static let maximumStates = 16_384
+
+    /// Cached masks are dropped once they hold this many token IDs in total.
+    static let maximumCachedTokens = 8_000_000
+
+    /// Forced runs longer than this many bytes are split across steps.
+    static let maximumForcedBytes = 512
+
+    private static let unknown: Int32 = -2
+    private static let rejected: Int32 = -1
+
+    let grammar: JSONGrammar
+    let vocabulary: GrammarVocabulary
+
+    private var stateIDs: [GrammarMatcher.State: Int32] = [:]
+    private var matchers: [GrammarMatcher] = []
+    private var transitions: [[Int32]] = []
+    private var masks: [Int32: [Int32]] = [:]
+    private var cachedTokens = 0
+    private var hits = 0
+    private var misses = 0
+    private let lock = NSLock()
+
+    init(grammar: JSONGrammar, vocabulary: GrammarVocabulary) {
+        self.grammar = grammar
+        self.vocabulary = vocabulary
+    }
+
+    /// A matcher positioned before any output.
+    func makeMatcher() -> GrammarMatcher {
+        GrammarMatcher(grammar: grammar)
+    }
+
+    /// Mask lookups served from the cache and computed so far.
+    var statistics: (hits: Int, misses: Int) {
+        withLock { (hits, misses) }
+    }
+
+    /// The tokens whose bytes may follow the matcher's input, in ascending order.
+    ///
+    /// End-of-sequence tokens are not included; allow them when
+    /// `matcher.isComplete`.
+    func allowedTokens(for matcher: GrammarMatcher) -> [Int32] {
+        withLock {
+            if matchers.count >= Self.maximumStates {
+                stateIDs.removeAll()
+                matchers.removeAll()
+                transitions.removeAll()
+                masks.removeAll()
+                cachedTokens = 0
+            }
+
+            let state = intern(matcher)
+            if let mask = masks[state] {
+                hits += 1
+                return mask
+            }
+            misses += 1
+
+            var allowed: [Int32] = []
+            collect(node: GrammarVocabulary.root, state: state, into: &allowed)
+            allowed.sort()
+
+            if cachedTokens + allowed.count > Self.maximumCachedTokens {
+                masks.removeAll()
+                cachedTokens = 0
+            }
+            masks[state] = allowed
+            cachedTokens += allowed.count
+            return allowed
+        }
+    }
+
+    /// Tokens that must come next regardless of what the model would sample.
+    ///
+    /// The bytes the grammar determines one at a time are split greedily into
+    /// the longest vocabulary tokens. Bytes at the end of the run that do not
+    /// complete a token are left for the model.
+    func forcedTokens(after matcher: GrammarMatcher) -> [Int] {
+        var bytes: [UInt8] = []
+        var scan = matcher
+        while bytes.count < Self.maximumForcedBytes, let byte = scan.forcedByte {
+            bytes.append(byte)
+            scan.accept(byte)
+        }
+
+        var tokens: [Int] = []
+        var offset = 0
+        while offset < bytes.count, let match = vocabulary.longestToken(prefixing: bytes[offset...]) {
+            tokens.append(match.token)
+            offset += match.length
+        }
+        return tokens
+    }
+
+    // MARK: - Walk
+
+    // The helpers below run with the lock held.
+
+    private func collect(node: Int, state: Int32, into allowed: inout [Int32]) {
+        for (byte, child) in vocabulary.children(of: node) {
+            let next = transition(from: state, on: byte)
+            guard next != Self.rejected else { continue }
+            allowed += vocabulary.tokens(at: Int(child))
+            collect(node: Int(child), state: next, into: &allowed)
+        }
+    }
+
+    private func transition(from state: Int32, on byte: UInt8) -> Int32 {
+        let known = transitions[Int(state)][Int(byte)]
+        if known != Self.unknown {
+            return known
+        }
+        var matcher = matchers[Int(state)]
+        let next = matcher.accept(byte) ? intern(matcher) : Self.rejected
+        transitions[Int(state)][Int(byte)] = next
+        return next
+    }
+
+    private func intern(_ matcher: GrammarMatcher) -> Int32 {
+        if let id = stateIDs[matcher.state] {
+            return id
+        }
+        let id = Int32(matchers.count)
+        stateIDs[matcher.state] = id
+        matchers.append(matcher)
+        transitions.append(Array(repeating: Self.unknown, count: 256))
+        return id
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
+
+// MARK: - GrammarMaskerStore
+
+/// Keeps vocabularies and maskers alive across requests, so each
+/// tokenizer's vocabulary is decoded once and each grammar's masks are
+/// computed once per tokenizer.
+///
+/// Marked `@unchecked Sendable` because all state is guarded by an `NSLock`.
+final class GrammarMaskerStore: @unchecked Sendable {
+
+    /// The store shared by local providers.
+    static let shared = GrammarMaskerStore()
+
+    private let vocabularyCapacity: Int
+    private let maskerCapacity: Int
+    private var vocabularies: [String: GrammarVocabulary] = [:]
+    private var maskers: [MaskerKey: GrammarTokenMasker] = [:]
+    private let lock = NSLock()
+
+    private struct MaskerKey: Hashable {
+        let vocabulary: String
+        let grammar: JSONGrammar
+    }
+
+    init(vocabularyCapacity: Int = 4, maskerCapacity: Int = 32) {
+        self.vocabularyCapacity = vocabularyCapacity
+        self.maskerCapacity = maskerCapacity
+    }
+
+    /// The masker for `grammar` over the vocabulary identified by `vocabularyID`.
+    ///
+    /// - Parameters:
+    ///   - grammar: The grammar to enforce.
+    ///   - vocabularyID: Identifies the tokenizer, such as the model's cache key.
+    ///   - makeVocabulary: Builds the vocabulary the first time it is needed.
+    func masker(
+        for grammar: JSONGrammar,
+        vocabularyID: String,
+        makeVocabulary: () throws -> GrammarVocabulary
+    ) rethrows -> GrammarTokenMasker {
+        let key = MaskerKey(vocabulary: vocabularyID, grammar: grammar)
+        if let masker = withLock({ maskers[key] }) {
+            return masker
+        }
+
+        let vocabulary = try withLock({ vocabularies[vocabularyID] }) ?? makeVocabulary()
+        let masker = GrammarTokenMasker(grammar: grammar, vocabulary: vocabulary)
+        return withLock {
+            if vocabularies[vocabularyID] == nil {
+                if vocabularies.count >= vocabularyCapacity {
+                    vocabularies.removeAll()
+                    maskers.removeAll()
+                }
+                vocabularies[vocabularyID] = vocabulary
+            }
+            if let existing = maskers[key] {
+                return existing
+            }
+            if maskers.count >= maskerCapacity {
+                maskers.removeAll()
+            }
+            maskers[key] = masker
+            return masker
+        }
+    }
+
+    private func withLock<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
+    }
+}
@@ -0,0 +1,563 @@
+// IncrementalJSONParser.swift
+// Conduit
+//
+// Resumable, push-style JSON parser for streaming model output.
+
+import Foundation
+
+// MARK: - IncrementalJSONParser
+
+/// A resumable JSON parser that keeps its state across streamed chunks.
+///
+/// Unlike ``JsonRepair`` and ``PartialJSONDecoder``, which re-scan the whole
+/// accumulated buffer on every update, this parser consumes each chunk exactly
+/// once. Completed values are materialized into ``GeneratedContent`` as soon as
+/// they close and are never rebuilt; a ``snapshot()`` only re-assembles the
+/// containers along the currently open path, sharing the storage of every
+/// completed value, and ``snapshotIfChanged()`` skips even that when the
+/// chunk changed nothing observable. Parsing a chunk costs time in proportion
+/// to its size. A snapshot copies the direct children of each open container,
+/// so its cost grows with the size of the open containers. It is not bounded
+/// by the chunk size: a long top-level array is copied on every snapshot.
+///
+/// Partial values follow the same conventions as ``JsonRepair``:
+/// - Unterminated strings are reported with the characters received so far.
+/// - Keys without a value yet are omitted.
+/// - Partially received numbers are reported once they parse as a number.
+/// - Partially received literals (`tr`, `nul`) are omitted.
+///
+/// ## Usage
+///
+/// ```swift
+/// var parser = IncrementalJSONParser()
+/// for try await chunk in stream {
+///     parser.feed(chunk)
+///     if let content = parser.snapshotIfChanged() {
+///         render(try T.PartiallyGenerated(content))
+///     }
+/// }
+/// parser.finish()
+/// ```
+internal struct IncrementalJSONParser: Sendable {
+
+    /// Overall parser progress.
+    enum State: Sendable, Equatable {
+        /// More input is expected.
+        case parsing
+        /// A complete top-level value was parsed. Trailing input is ignored.
+        case complete
+        /// The input is not valid JSON. Further input is ignored.
+        case failed
+    }
+
+    // MARK: - Public State
+
+    /// Current parser progress.
+    private(set) var state: State = .parsing
+
+    /// Incremented every time the value returned by ``snapshot()`` may have changed.
+    ///
+    /// Compare revisions across calls to ``feed(_:)`` to skip snapshots for chunks
+    /// that only contained whitespace, keys, or punctuation.
+    private(set) var revision = 0
+
+    /// The ``revision`` at the last ``snapshotIfChanged()``.
+    private var snapshotRevision = 0
+
+    /// Total number of UTF-8 bytes consumed so far.
+    private(set) var consumedByteCount = 0
+
+    /// Maximum nesting depth allowed for objects and arrays.
+    let maximumDepth: Int
+
+    // MARK: - Private State
+
+    private enum Container: Sendable {
+        case object(ObjectBuilder)
+        case array([GeneratedContent])
+    }
+
+    private struct ObjectBuilder: Sendable {
+        var properties: [String: GeneratedContent] = [:]
+        var orderedKeys: [String] = []
+        var pendingKey: String?
+
+        mutating func set(_ value: GeneratedContent, forKey key: String) {
+            if properties.updateValue(value, forKey: key) == nil {
+                orderedKeys.append(key)
+            }
+        }
+
+        func content(including partial: GeneratedContent?) -> GeneratedContent {
+            guard let partial, let pendingKey else {
+                return GeneratedContent(kind: .structure(properties: properties, orderedKeys: orderedKeys))
+            }
+            var properties = properties
+            var orderedKeys = orderedKeys
+            if properties.updateValue(partial, forKey: pendingKey) == nil {
+                orderedKeys.append(pendingKey)
+            }
+            return GeneratedContent(kind: .structure(properties: properties, orderedKeys: orderedKeys))
+        }
+    }
+
+    /// What the parser accepts at the next structural position.
+    private enum Expectation: Sendable {
+        case value
+        case valueOrArrayEnd
+        case keyOrObjectEnd
+        case key
+        case colon
+        case commaOrEnd
+    }
+
+    /// The scalar currently being received, if any.
+    private enum Scalar: Sendable {
+        case none
+        case string(isKey: Bool)
+        case number
+        case literal(expected: [UInt8], matched: Int, value: GeneratedContent)
+    }
+
+    private enum Escape: Sendable {
+        case none
+        case backslash
+        case unicode(value: UInt16, digits: Int)
+    }
+
+    private var stack: [Container] = []
+    private var root: GeneratedContent?
+    private var expectation: Expectation = .value
+    private var scalar: Scalar = .none
+
+    private var stringValue = ""
+    private var escape: Escape = .none
+    private var pendingHighSurrogate: UInt16?
+    private var numberBytes: [UInt8] = []
+
+    // MARK: - Initialization
+
+    init(maximumDepth: Int = 64) {
+        self.maximumDepth = maximumDepth
+    }
+
+    // MARK: - Feeding
+
+    /// Consumes the next chunk of JSON text.
+    mutating func feed(_ chunk: String) {
+        guard state == .parsing, !chunk.isEmpty else { return }
+        var chunk = chunk
+        chunk.withUTF8 { feed(bytes: $0) }
+    }
+
+    /// Consumes the next chunk of UTF-8 encoded JSON text.
+    ///
+    /// Chunks must split the input on Unicode scalar boundaries; every `String`
+    /// chunk from a text stream satisfies this.
+    mutating func feed(bytes: UnsafeBufferPointer<UInt8>) {
+        guard state == .parsing else { return }
+        consumedByteCount += bytes.count
+
+        var index = 0
+        while index < bytes.count, state == .parsing {
+            switch scalar {
+            case .string(let isKey):
+                index = consumeString(bytes, from: index, isKey: isKey)
+
+            case .number:
+                let byte = bytes[index]
+                if Self.isNumberByte(byte) {
+                    numberBytes.append(byte)
+                    revision &+= 1
+                    index += 1
+                } else {
+                    completeNumber()
+                }
+
+            case .literal(let expected, let matched, let value):
+                guard bytes[index] == expected[matched] else {
+                    fail()
+                    return
+                }
+                index += 1
+                if matched + 1 == expected.count {
+                    scalar = .none
+                    completeValue(value)
+                } else {
+                    scalar = .literal(expected: expected, matched: matched + 1, value: value)
+                }
+
+            case .none:
+                consumeStructural(bytes[index])
+                index += 1
+            }
+        }
+    }
+
+    /// Signals end of input, completing a trailing top-level number if present.
+    mutating func finish() {
+        guard state == .parsing else { return }
+        if case .number = scalar, stack.isEmpty {
+            completeNumber()
+        }
+    }
+
+    // MARK: - Snapshot
+
+    /// Returns ``snapshot()`` if the value may have changed since the previous call, otherwise `nil`.
+    ///
+    /// Streaming callers use this instead of comparing snapshots, which would
+    /// cost time proportional to everything parsed so far on every chunk.
+    mutating func snapshotIfChanged() -> GeneratedContent? {
+        guard revision != snapshotRevision else { return nil }
+        snapshotRevision = revision
+        return snapshot()
+    }
+
+    /// The best-effort value parsed so far, or `nil` if no value has started.
+    ///
+    /// Only containers on the open path are re-assembled; completed siblings are
+    /// reused as already-materialized ``GeneratedContent`` values.
+    func snapshot() -> GeneratedContent? {
+        if let root {
+            return root
+        }
+
+        var current = partialScalarContent()
+        for container in stack.reversed() {
+            switch container {
+            case .array(let elements):
+                guard let partial = current else {
+                    current = GeneratedContent(kind: .array(elements))
+                    continue
+                }
+                var elements = elements
+                elements.append(partial)
+                current = GeneratedContent(kind: .array(elements))
+
+            case .object(let builder):
+                current = builder.content(including: current)
+            }
+        }
+        return current
+    }
+
+    // MARK: - Structural Parsing
+
+    private mutating func consumeStructural(_ byte: UInt8) {
+        if Self.isWhitespace(byte) {
+            return
+        }
+
+        switch expectation {
+        case .value, .valueOrArrayEnd:
+            if byte == UInt8(ascii: "]"), expectation == .valueOrArrayEnd {
+                closeContainer(isArray: true)
+            } else {
+                beginValue(byte)
+            }
+
+        case .keyOrObjectEnd, .key:
+            if byte == UInt8(ascii: "\"") {
+                beginString(isKey: true)
+            } else if byte == UInt8(ascii: "}"), expectation == .keyOrObjectEnd {
+                closeContainer(isArray: false)
+            } else {
+                fail()
+            }
+
+        case .colon:
+            if byte == UInt8(ascii: ":") {
+                expectation = .value
+            } else {
+                fail()
+            }
+
+        case .commaOrEnd:
+            switch (byte, stack.last) {
+            case (UInt8(ascii: ","), .object?):
+                expectation = .key
+            case (UInt8(ascii: ","), .array?):
+                expectation = .value
+            case (UInt8(ascii: "}"), .object?):
+                closeContainer(isArray: false)
+            case (UInt8(ascii: "]"), .array?):
+                closeContainer(isArray: true)
+            default:
+                fail()
+            }
+        }
+    }
+
+    private mutating func beginValue(_ byte: UInt8) {
+        switch byte {
+        case UInt8(ascii: "{"):
+            guard stack.count < maximumDepth else { return fail() }
+            stack.append(.object(ObjectBuilder()))
+            expectation = .keyOrObjectEnd
+            revision &+= 1
+
+        case UInt8(ascii: "["):
+            guard stack.count < maximumDepth else { return fail() }
+            stack.append(.array([]))
+            expectation = .valueOrArrayEnd
+            revision &+= 1
+
+        case UInt8(ascii: "\""):
+            beginString(isKey: false)
+            revision &+= 1
+
+        case UInt8(ascii: "-"), UInt8(ascii: "0")...UInt8(ascii: "9"):
+            numberBytes.removeAll(keepingCapacity: true)
+            numberBytes.append(byte)
+            scalar = .number
+            revision &+= 1
+
+        case UInt8(ascii: "t"):
+            scalar = .literal(expected: Array("true".utf8), matched: 1, value: GeneratedContent(kind: .bool(true)))
+
+        case UInt8(ascii: "f"):
+            scalar = .literal(expected: Array("false".utf8), matched: 1, value: GeneratedContent(kind: .bool(false)))
+
+        case UInt8(ascii: "n"):
+            scalar = .literal(expected: Array("null".utf8), matched: 1, value: GeneratedContent(kind: .null))
+
+        default:
+            fail()
+        }
+    }
+
+    private mutating func closeContainer(isArray: Bool) {
+        guard let container = stack.popLast() else { return fail() }
+
+        switch container {
+        case .array(let elements):
+            guard isArray else { return fail() }
+            completeValue(GeneratedContent(kind: .array(elements)))
+        case .object(let builder):
+            guard !isArray, builder.pendingKey == nil else { return fail() }
+            completeValue(builder.content(including: nil))
+        }
+    }
+
+    private mutating func completeValue(_ value: GeneratedContent) {
+        revision &+= 1
+
+        guard let top = stack.popLast() else {
+            root = value
+            state = .complete
+            return
+        }
+
+        switch top {
+        case .array(var elements):
+            elements.append(value)
+            stack.append(.array(elements))
+        case .object(var builder):
+            guard let key = builder.pendingKey else { return fail() }
+            builder.set(value, forKey: key)
+            builder.pendingKey = nil
+            stack.append(.object(builder))
+        }
+        expectation = .commaOrEnd
+    }
+
+    private mutating func fail() {
+        state = .failed
+        scalar = .none
+    }
+
+    // MARK: - Strings
+
+    private mutating func beginString(isKey: Bool) {
+        stringValue = ""
+        escape = .none
+        pendingHighSurrogate = nil
+        scalar = .string(isKey: isKey)
+    }
+
+    /// Consumes string bytes starting at `start` and returns the index of the next unconsumed byte.
+    private mutating func consumeString(_ bytes: UnsafeBufferPointer<UInt8>, from start: Int, isKey: Bool) -> Int {
+        var index = start
+        var runStart = start
+
+        func flushRun(upTo end: Int) {
+            guard end > runStart else { return }
+            flushPendingSurrogate()
+            stringValue += String(decoding: UnsafeBufferPointer(rebasing: bytes[runStart..<end]), as: UTF8.self)
+            if !isKey { revision &+= 1 }
+        }
+
+        while index < bytes.count {
+            let byte = bytes[index]
+
+            switch escape {
+            case .none:
+                if byte == UInt8(ascii: "\"") {
+                    flushRun(upTo: index)
+                    flushPendingSurrogate()
+                    finishString(isKey: isKey)
+                    return index + 1
+                }
+                if byte == UInt8(ascii: "\\") {
+                    flushRun(upTo: index)
+                    escape = .backslash
+                    index += 1
+                    runStart = index
+                    continue
+                }
+                index += 1
+
+            case .backslash:
+                index += 1
+                runStart = index
+                if byte == UInt8(ascii: "u") {
+                    escape = .unicode(value: 0, digits: 0)
+                    continue
+                }
+                escape = .none
+                guard let scalarValue = Self.simpleEscape(byte) else {
+                    fail()
+                    return index
+                }
+                appendScalar(scalarValue, isKey: isKey)
+
+            case .unicode(let value, let digits):
+                index += 1
+                runStart = index
+                guard let digit = Self.hexValue(byte) else {
+                    fail()
+                    return index
+                }
+                let next = value << 4 | UInt16(digit)
+                if digits < 3 {
+                    escape = .unicode(value: next, digits: digits + 1)
+                } else {
+                    escape = .none
+                    appendUTF16(next, isKey: isKey)
+                }
+            }
+        }
+
+        if case .none = escape {
+            flushRun(upTo: index)
+        }
+        return index
+    }
+
+    private mutating func finishString(isKey: Bool) {
+        let value = stringValue
+        stringValue = ""
+        scalar = .none
+
+        if isKey {
+            guard case .object(var builder)? = stack.popLast() else { return fail() }
+            builder.pendingKey = value
+            stack.append(.object(builder))
+            expectation = .colon
+        } else {
+            completeValue(GeneratedContent(kind: .string(value)))
+        }
+    }
+
+    private mutating func appendScalar(_ scalar: Unicode.Scalar, isKey: Bool) {
+        flushPendingSurrogate()
+        stringValue.unicodeScalars.append(scalar)
+        if !isKey { revision &+= 1 }
+    }
+
+    private mutating func appendUTF16(_ unit: UInt16, isKey: Bool) {
+        if UTF16.isLeadSurrogate(unit) {
+            flushPendingSurrogate()
+            pendingHighSurrogate = unit
+            return
+        }
+
+        if UTF16.isTrailSurrogate(unit), let high = pendingHighSurrogate {
+            pendingHighSurrogate = nil
+            let combined = 0x10000 + ((UInt32(high) - 0xD800) << 10) + (UInt32(unit) - 0xDC00)
+            appendScalar(Unicode.Scalar(combined) ?? "\u{FFFD}", isKey: isKey)
+            return
+        }
+
+        appendScalar(Unicode.Scalar(unit) ?? "\u{FFFD}", isKey: isKey)
+    }
+
+    private mutating func flushPendingSurrogate() {
+        guard pendingHighSurrogate != nil else { return }
+        pendingHighSurrogate = nil
+        stringValue.unicodeScalars.append("\u{FFFD}")
+    }
+
+    // MARK: - Numbers
+
+    private mutating func completeNumber() {
+        scalar = .none
+        guard let value = parsedNumber() else { return fail() }
+        completeValue(GeneratedContent(kind: .number(value)))
+    }
+
+    private func parsedNumber() -> Double? {
+        guard let last = numberBytes.last, Self.isDigit(last) else { return nil }
+        return Double(String(decoding: numberBytes, as: UTF8.self))
+    }
+
+    private func partialScalarContent() -> GeneratedContent? {
+        switch scalar {
+        case .string(let isKey):
+            return isKey ? nil : GeneratedContent(kind: .string(stringValue))
+        case .number:
+            return parsedNumber().map { GeneratedContent(kind: .number($0)) }
+        case .literal, .none:
+            return nil
+        }
+    }
+
+    // MARK: - Byte Classes
+
+    private static func isWhitespace(_ byte: UInt8) -> Bool {
+        byte == 0x20 || byte == 0x0A || byte == 0x0D || byte == 0x09
+    }
+
+    private static func isDigit(_ byte: UInt8) -> Bool {
+        byte >= UInt8(ascii: "0") && byte <= UInt8(ascii: "9")
+    }
+
+    private static func isNumberByte(_ byte: UInt8) -> Bool {
+        switch byte {
+        case UInt8(ascii: "0")...UInt8(ascii: "9"),
+             UInt8(ascii: "-"), UInt8(ascii: "+"), UInt8(ascii: "."),
+             UInt8(ascii: "e"), UInt8(ascii: "E"):
+            return true
+        default:
+            return false
+        }
+    }
+
+    private static func hexValue(_ byte: UInt8) -> UInt8? {
+        switch byte {
+        case UInt8(ascii: "0")...UInt8(ascii: "9"):
+            return byte - UInt8(ascii: "0")
+        case UInt8(ascii: "a")...UInt8(ascii: "f"):
+            return byte - UInt8(ascii: "a") + 10
+        case UInt8(ascii: "A")...UInt8(ascii: "F"):
+            return byte - UInt8(ascii: "A") + 10
+        default:
+            return nil
+        }
+    }
+
+    private static func simpleEscape(_ byte: UInt8) -> Unicode.Scalar? {
+        switch byte {
+        case UInt8(ascii: "\""): return "\""
+        case UInt8(ascii: "\\"): return "\\"
+        case UInt8(ascii: "/"): return "/"
+        case UInt8(ascii: "b"): return "\u{08}"
+        case UInt8(ascii: "f"): return "\u{0C}"
+        case UInt8(ascii: "n"): return "\n"
+        case UInt8(ascii: "r"): return "\r"
+        case UInt8(ascii: "t"): return "\t"
+        default: return nil
+        }
+    }
+}
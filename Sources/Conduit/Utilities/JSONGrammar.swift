@@ -0,0 +1,924 @@
+// JSONGrammar.swift
+// Conduit
+//
+// Compiles generation schemas into byte-level grammars for constrained decoding.
+
+import Foundation
+
+// MARK: - GrammarByteSet
+
+/// The bytes one grammar terminal accepts.
+///
+/// ASCII bytes are tracked individually. The bytes of multi-byte UTF-8
+/// characters (`0x80...0xFF`) are either all accepted or all rejected, which
+/// is enough to express classes such as "any character except a quote".
+struct GrammarByteSet: Sendable, Hashable {
+    private var low: UInt64 = 0
+    private var high: UInt64 = 0
+
+    /// Whether every non-ASCII byte is in the set.
+    var includesNonASCII = false
+
+    init() {}
+
+    /// Creates a set of the ASCII bytes in `characters`.
+    init(_ characters: String) {
+        for byte in characters.utf8 where byte < 0x80 {
+            insert(byte)
+        }
+    }
+
+    /// Creates a set of an ASCII byte range.
+    init(_ range: ClosedRange<UInt8>) {
+        for byte in range {
+            insert(byte)
+        }
+    }
+
+    /// Creates a set of an ASCII character range.
+    init(_ range: ClosedRange<Unicode.Scalar>) {
+        let lower = UInt8(truncatingIfNeeded: range.lowerBound.value)
+        let upper = UInt8(truncatingIfNeeded: range.upperBound.value)
+        self.init(lower...upper)
+    }
+
+    func contains(_ byte: UInt8) -> Bool {
+        switch byte {
+        case 0..<64: return low & (1 << UInt64(byte)) != 0
+        case 64..<128: return high & (1 << UInt64(byte - 64)) != 0
+        default: return includesNonASCII
+        }
+    }
+
+    mutating func insert(_ byte: UInt8) {
+        switch byte {
+        case 0..<64: low |= 1 << UInt64(byte)
+        case 64..<128: high |= 1 << UInt64(byte - 64)
+        default: includesNonASCII = true
+        }
+    }
+
+    func union(_ other: GrammarByteSet) -> GrammarByteSet {
+        var result = self
+        result.low |= other.low
+        result.high |= other.high
+        result.includesNonASCII = result.includesNonASCII || other.includesNonASCII
+        return result
+    }
+
+    func subtracting(_ other: GrammarByteSet) -> GrammarByteSet {
+        var result = self
+        result.low &= ~other.low
+        result.high &= ~other.high
+        result.includesNonASCII = includesNonASCII && !other.includesNonASCII
+        return result
+    }
+
+    /// Every byte not in this set.
+    var inverted: GrammarByteSet {
+        var result = self
+        result.low = ~low
+        result.high = ~high
+        result.includesNonASCII = !includesNonASCII
+        return result
+    }
+
+    var isEmpty: Bool {
+        low == 0 && high == 0 && !includesNonASCII
+    }
+
+    /// The set's only byte, if it holds exactly one.
+    var singleByte: UInt8? {
+        guard !includesNonASCII, low.nonzeroBitCount + high.nonzeroBitCount == 1 else { return nil }
+        return low != 0 ? UInt8(low.trailingZeroBitCount) : UInt8(64 + high.trailingZeroBitCount)
+    }
+
+    /// ASCII bytes in the set, in ascending order.
+    var asciiBytes: [UInt8] {
+        (0..<128).map(UInt8.init).filter(contains)
+    }
+
+    /// `0-9`.
+    static let digits = GrammarByteSet("0"..."9")
+
+    /// Characters a JSON string may contain without escaping: everything but
+    /// `"`, `\` and control characters.
+    static let unescapedStringCharacters = GrammarByteSet(0...0x1F)
+        .union(GrammarByteSet("\"\\"))
+        .inverted
+}
+
+// MARK: - JSONGrammar
+
+/// A context-free grammar over UTF-8 bytes that accepts the JSON a
+/// ``GenerationSchema`` describes.
+///
+/// Local providers use the grammar to mask tokens during decoding, so the
+/// model can only produce output that parses and satisfies the schema's
+/// guides:
+/// - Objects list their properties in name order. Optional properties may be
+///   omitted but are never `null`, and no other keys are allowed.
+/// - Arrays honor `minItems` and `maxItems`.
+/// - Strings honor enumerated choices and, when it only uses the supported
+///   regular expression subset, their pattern.
+/// - Numbers honor integer-only guides, a non-negative minimum and small
+///   integer ranges.
+///
+/// Output is compact JSON without insignificant whitespace, which removes
+/// choice points and lets more of the output be forced.
+///
+/// The grammar can be rendered as GBNF for llama.cpp's grammar sampler, or
+/// evaluated directly with a ``GrammarMatcher``.
+struct JSONGrammar: Sendable, Hashable {
+
+    /// One element of a rule alternative.
+    enum Symbol: Sendable, Hashable {
+        /// Exactly this byte.
+        case byte(UInt8)
+
+        /// Any byte in the set.
+        case set(GrammarByteSet)
+
+        /// The rule at this index.
+        case rule(Int)
+    }
+
+    /// A named rule with its alternatives. An empty alternative matches nothing.
+    struct Rule: Sendable, Hashable {
+        var name: String
+        var alternatives: [[Symbol]]
+    }
+
+    /// The grammar's rules. The first rule is the start rule.
+    let rules: [Rule]
+
+    /// The grammar in GBNF notation, with `root` as the start rule.
+    let gbnf: String
+
+    private init(rules: [Rule]) {
+        self.rules = rules
+        self.gbnf = Self.render(rules)
+    }
+
+    /// Compiles the grammar for JSON matching `schema`.
+    init(schema: GenerationSchema) {
+        var builder = Builder(schema: schema)
+        let root = builder.reserve("root")
+        let pattern = builder.value(schema.root)
+        builder.define(root, as: pattern)
+        self.init(rules: builder.rules)
+    }
+
+    /// A grammar that accepts any JSON object.
+    static let anyObject: JSONGrammar = {
+        var builder = Builder(schema: nil)
+        let root = builder.reserve("root")
+        let pattern = builder.anyObject()
+        builder.define(root, as: pattern)
+        return JSONGrammar(rules: builder.rules)
+    }()
+
+    // MARK: - Cache
+
+    /// Grammars compiled so far, keyed by their schema's JSON.
+    private static let cache = JSONGrammarCache()
+
+    /// The grammar that enforces `format`, or `nil` for free-form text.
+    ///
+    /// Compiled grammars are cached by schema, so repeated structured
+    /// requests only compile once.
+    static func compiled(for format: ResponseFormat?) -> JSONGrammar? {
+        switch format {
+        case .jsonObject:
+            return anyObject
+        case .jsonSchema(_, let schema):
+            let key = schema.canonicalJSONString
+            if let cached = cache[key] {
+                return cached
+            }
+            let grammar = JSONGrammar(schema: schema)
+            cache[key] = grammar
+            return grammar
+        case .text, nil:
+            return nil
+        }
+    }
+
+    // MARK: - GBNF
+
+    private static func render(_ rules: [Rule]) -> String {
+        rules.map { rule in
+            let alternatives = rule.alternatives.map { render($0, rules: rules) }
+            return "\(rule.name) ::= " + alternatives.joined(separator: " | ")
+        }.joined(separator: "\n") + "\n"
+    }
+
+    private static func render(_ alternative: [Symbol], rules: [Rule]) -> String {
+        guard !alternative.isEmpty else { return "\"\"" }
+
+        var parts: [String] = []
+        var literal: [UInt8] = []
+        func flush() {
+            if !literal.isEmpty {
+                parts.append(renderLiteral(literal))
+                literal.removeAll()
+            }
+        }
+
+        for symbol in alternative {
+            switch symbol {
+            case .byte(let byte):
+                literal.append(byte)
+            case .set(let set):
+                flush()
+                parts.append(renderClass(set))
+            case .rule(let index):
+                flush()
+                parts.append(rules[index].name)
+            }
+        }
+        flush()
+        return parts.joined(separator: " ")
+    }
+
+    private static func renderLiteral(_ bytes: [UInt8]) -> String {
+        var result = "\""
+        for scalar in String(decoding: bytes, as: UTF8.self).unicodeScalars {
+            switch scalar {
+            case "\"": result += "\\\""
+            case "\\": result += "\\\\"
+            case "\n": result += "\\n"
+            case "\r": result += "\\r"
+            case "\t": result += "\\t"
+            default:
+                if scalar.value < 0x20 || scalar.value == 0x7F {
+                    result += hexEscape(UInt8(scalar.value))
+                } else {
+                    result.unicodeScalars.append(scalar)
+                }
+            }
+        }
+        return result + "\""
+    }
+
+    private static func renderClass(_ set: GrammarByteSet) -> String {
+        // GBNF classes match code points; non-ASCII bytes are all-or-nothing,
+        // which maps onto a negated ASCII class or a plain one.
+        let negated = set.includesNonASCII
+        let members = negated ? set.inverted.asciiBytes : set.asciiBytes
+        guard !members.isEmpty else { return negated ? "[\\x00-\\U0010FFFF]" : "[\\x00]" }
+
+        var result = negated ? "[^" : "["
+        var index = 0
+        while index < members.count {
+            var end = index
+            while end + 1 < members.count, members[end + 1] == members[end] + 1 {
+                end += 1
+            }
+            result += classCharacter(members[index])
+            if end > index {
+                result += "-" + classCharacter(members[end])
+            }
+            index = end + 1
+        }
+        return result + "]"
+    }
+
+    private static func classCharacter(_ byte: UInt8) -> String {
+        let scalar = Unicode.Scalar(byte)
+        if scalar.properties.isAlphabetic || ("0"..."9").contains(scalar) {
+            return String(scalar)
+        }
+        return hexEscape(byte)
+    }
+
+    private static func hexEscape(_ byte: UInt8) -> String {
+        let hex = String(byte, radix: 16, uppercase: true)
+        return "\\x" + (hex.count == 1 ? "0" + hex : hex)
+    }
+}
+
+// MARK: - Patterns
+
+/// The structured form rules are written in before they are flattened into
+/// ``JSONGrammar/Symbol`` alternatives.
+indirect enum JSONGrammarPattern: Sendable, Hashable {
+    case literal([UInt8])
+    case set(GrammarByteSet)
+    case rule(Int)
+    case sequence([JSONGrammarPattern])
+    case choice([JSONGrammarPattern])
+    case repeated(JSONGrammarPattern, min: Int, max: Int?)
+
+    /// Matches nothing.
+    static let empty = JSONGrammarPattern.sequence([])
+
+    static func text(_ string: String) -> JSONGrammarPattern {
+        .literal(Array(string.utf8))
+    }
+
+    static func optional(_ pattern: JSONGrammarPattern) -> JSONGrammarPattern {
+        .choice([pattern, .empty])
+    }
+}
+
+// MARK: - Builder
+
+extension JSONGrammar {
+
+    /// Flattens patterns into rules and compiles schema nodes into patterns.
+    private struct Builder {
+        typealias Pattern = JSONGrammarPattern
+
+        /// Repetitions up to this count are spelled out. Longer required runs
+        /// use doubling rules; longer optional tails are treated as unbounded.
+        static let maximumExpandedRepetitions = 32
+
+        /// Integer ranges up to this size are enumerated exactly.
+        static let maximumEnumeratedRange = 256
+
+        let schema: GenerationSchema?
+        private(set) var rules: [Rule] = []
+        private var names: Set<String> = []
+        private var definitions: [String: Int] = [:]
+        private var shared: [String: Int] = [:]
+
+        init(schema: GenerationSchema?) {
+            self.schema = schema
+        }
+
+        // MARK: Rules
+
+        /// Adds an empty rule so it can be referenced before it is defined.
+        mutating func reserve(_ name: String) -> Int {
+            var base = String(name.lowercased().map { $0.isASCII && ($0.isLetter || $0.isNumber) ? $0 : "-" })
+            if base.isEmpty || base.first == "-" {
+                base = "r" + base
+            }
+            var unique = base
+            var suffix = 1
+            while names.contains(unique) {
+                suffix += 1
+                unique = "\(base)-\(suffix)"
+            }
+            names.insert(unique)
+            rules.append(Rule(name: unique, alternatives: []))
+            return rules.count - 1
+        }
+
+        mutating func define(_ index: Int, as pattern: Pattern) {
+            rules[index].alternatives = alternatives(of: pattern)
+        }
+
+        /// A reference to a new rule matching `pattern`.
+        mutating func rule(_ name: String, _ pattern: Pattern) -> Pattern {
+            let index = reserve(name)
+            define(index, as: pattern)
+            return .rule(index)
+        }
+
+        /// A reference to a rule built once per grammar.
+        private mutating func sharedRule(_ name: String, _ build: (inout Builder) -> Pattern) -> Pattern {
+            if let index = shared[name] {
+                return .rule(index)
+            }
+            let index = reserve(name)
+            shared[name] = index
+            let pattern = build(&self)
+            define(index, as: pattern)
+            return .rule(index)
+        }
+
+        private mutating func alternatives(of pattern: Pattern) -> [[Symbol]] {
+            switch pattern {
+            case .choice(let options):
+                var result: [[Symbol]] = []
+                for option in options {
+                    result += alternatives(of: option)
+                }
+                return result
+            case .repeated(let element, let min, let max):
+                let expanded = expand(element, min: min, max: max)
+                return alternatives(of: expanded)
+            default:
+                return [symbols(of: pattern)]
+            }
+        }
+
+        private mutating func symbols(of pattern: Pattern) -> [Symbol] {
+            switch pattern {
+            case .literal(let bytes):
+                return bytes.map(Symbol.byte)
+            case .set(let set):
+                if let byte = set.singleByte {
+                    return [.byte(byte)]
+                }
+                return [.set(set)]
+            case .rule(let index):
+                return [.rule(index)]
+            case .sequence(let parts):
+                var result: [Symbol] = []
+                for part in parts {
+                    result += symbols(of: part)
+                }
+                return result
+            case .choice(let options):
+                if options.count == 1 {
+                    return symbols(of: options[0])
+                }
+                let index = reserve("alt")
+                define(index, as: pattern)
+                return [.rule(index)]
+            case .repeated(let element, let min, let max):
+                let expanded = expand(element, min: min, max: max)
+                return symbols(of: expanded)
+            }
+        }
+
+        private mutating func expand(_ element: Pattern, min: Int, max: Int?) -> Pattern {
+            let limit = Self.maximumExpandedRepetitions
+            let minimum = Swift.max(min, 0)
+            var parts = minimum <= limit
+                ? Array(repeating: element, count: minimum)
+                : repetitions(of: element, count: minimum)
+
+            if let max, max - minimum <= limit {
+                var tail = Pattern.empty
+                for _ in minimum..<Swift.max(max, minimum) {
+                    tail = .optional(.sequence([element, tail]))
+                }
+                parts.append(tail)
+            } else {
+                let index = reserve("repeat")
+                define(index, as: .optional(.sequence([element, .rule(index)])))
+                parts.append(.rule(index))
+            }
+            return .sequence(parts)
+        }
+
+        /// Exactly `count` copies of `element`, built from rules that each
+        /// double the previous one, so the grammar grows with `log2(count)`.
+        private mutating func repetitions(of element: Pattern, count: Int) -> [Pattern] {
+            var parts: [Pattern] = []
+            var power = rule("item", element)
+            var remaining = count
+            while remaining > 0 {
+                if remaining & 1 == 1 {
+                    parts.append(power)
+                }
+                remaining >>= 1
+                if remaining > 0 {
+                    power = rule("repeat", .sequence([power, power]))
+                }
+            }
+            return parts
+        }
+
+        // MARK: Schema Nodes
+
+        mutating func value(_ node: GenerationSchema.Node) -> Pattern {
+            switch node {
+            case .object(let object):
+                return self.object(object)
+            case .array(let array):
+                return self.array(array)
+            case .string(let string):
+                return self.string(string)
+            case .number(let number):
+                return self.number(number)
+            case .boolean:
+                return .choice([.text("true"), .text("false")])
+            case .anyOf(let members):
+                return .choice(members.map { value($0) })
+            case .ref(let name):
+                if let index = definitions[name] {
+                    return .rule(index)
+                }
+                guard let definition = schema?.definition(named: name) else {
+                    return anyValue()
+                }
+                let index = reserve(name.split(separator: ".").last.map(String.init) ?? name)
+                definitions[name] = index
+                let pattern = value(definition)
+                define(index, as: pattern)
+                return .rule(index)
+            }
+        }
+
+        private mutating func object(_ object: GenerationSchema.ObjectNode) -> Pattern {
+            // Members after position i, given whether a member was already
+            // written (and so the next one needs a comma).
+            var afterFirst = Pattern.empty
+            var atStart = Pattern.empty
+
+            for name in object.properties.keys.sorted().reversed() {
+                guard let node = object.properties[name] else { continue }
+                let memberValue = value(node)
+                let member = rule(name + "-kv", .sequence([.text(Self.quoted(name) + ":"), memberValue]))
+                let withComma = Pattern.sequence([.text(","), member, afterFirst])
+                let first = Pattern.sequence([member, afterFirst])
+
+                if object.required.contains(name) {
+                    atStart = first
+                    afterFirst = withComma
+                } else {
+                    atStart = rule(name + "-first", .choice([first, atStart]))
+                    afterFirst = rule(name + "-rest", .choice([withComma, afterFirst]))
+                }
+            }
+            return .sequence([.text("{"), atStart, .text("}")])
+        }
+
+        private mutating func array(_ array: GenerationSchema.ArrayNode) -> Pattern {
+            let minimum = max(array.minItems ?? 0, 0)
+            if let maximum = array.maxItems, maximum <= 0 {
+                return .text("[]")
+            }
+
+            let items = value(array.items)
+            let item = rule("item", items)
+            let list = Pattern.sequence([
+                item,
+                .repeated(
+                    .sequence([.text(","), item]),
+                    min: max(minimum - 1, 0),
+                    max: array.maxItems.map { $0 - 1 }
+                ),
+            ])
+            return .sequence([.text("["), minimum == 0 ? .optional(list) : list, .text("]")])
+        }
+
+        private mutating func string(_ string: GenerationSchema.StringNode) -> Pattern {
+            if let choices = string.enumChoices, !choices.isEmpty {
+                return .choice(choices.map { .text(Self.quoted($0)) })
+            }
+            if let pattern = string.pattern, let body = JSONGrammarRegex.compile(pattern) {
+                return .sequence([.text("\""), body, .text("\"")])
+            }
+            return anyString()
+        }
+
+        private mutating func number(_ number: GenerationSchema.NumberNode) -> Pattern {
+            // Bounds outside Int, such as 2^63 from `.range(0...Int.max)`, use the unbounded rule
+            if number.integerOnly, let minimum = number.minimum, let maximum = number.maximum,
+               let lower = Int(exactly: minimum.rounded(.up)), let upper = Int(exactly: maximum.rounded(.down)),
+               lower <= upper {
+                let span = upper.subtractingReportingOverflow(lower)
+                if !span.overflow, span.partialValue < Self.maximumEnumeratedRange {
+                    return .choice((lower...upper).map { .text(String($0)) })
+                }
+            }
+
+            let unsigned = (number.minimum ?? -1) >= 0
+            let integer = Pattern.sequence([
+                unsigned ? .empty : .optional(.text("-")),
+                .choice([
+                    .text("0"),
+                    .sequence([.set(GrammarByteSet("1"..."9")), .repeated(.set(.digits), min: 0, max: 15)]),
+                ]),
+            ])
+            if number.integerOnly {
+                return rule(unsigned ? "unsigned-integer" : "integer", integer)
+            }
+            let fraction = Pattern.optional(.sequence([.text("."), .repeated(.set(.digits), min: 1, max: 15)]))
+            return rule(unsigned ? "unsigned-number" : "number", .sequence([integer, fraction]))
+        }
+
+        // MARK: Free-Form JSON
+
+        mutating func anyString() -> Pattern {
+            sharedRule("string") { builder in
+                let escape = Pattern.sequence([
+                    .text("\\"),
+                    .choice([
+                        .set(GrammarByteSet("\"\\/bfnrt")),
+                        .sequence([
+                            .text("u"),
+                            .repeated(.set(GrammarByteSet("0123456789abcdefABCDEF")), min: 4, max: 4),
+                        ]),
+                    ]),
+                ])
+                let character = Pattern.choice([.set(.unescapedStringCharacters), escape])
+                return .sequence([
+                    .text("\""),
+                    builder.rule("string-body", .repeated(character, min: 0, max: nil)),
+                    .text("\""),
+                ])
+            }
+        }
+
+        mutating func anyObject() -> Pattern {
+            sharedRule("object") { builder in
+                let member = Pattern.sequence([builder.anyString(), .text(":"), builder.anyValue()])
+                return .sequence([
+                    .text("{"),
+                    .optional(.sequence([member, .repeated(.sequence([.text(","), member]), min: 0, max: nil)])),
+                    .text("}"),
+                ])
+            }
+        }
+
+        mutating func anyValue() -> Pattern {
+            if let index = shared["value"] {
+                return .rule(index)
+            }
+            let index = reserve("value")
+            shared["value"] = index
+
+            let element = Pattern.rule(index)
+            let array = rule("array", .sequence([
+                .text("["),
+                .optional(.sequence([element, .repeated(.sequence([.text(","), element]), min: 0, max: nil)])),
+                .text("]"),
+            ]))
+            let number = self.number(GenerationSchema.NumberNode(minimum: nil, maximum: nil, integerOnly: false))
+            let object = anyObject()
+            let string = anyString()
+            define(index, as: .choice([
+                object, array, string, number, .text("true"), .text("false"), .text("null"),
+            ]))
+            return element
+        }
+
+        // MARK: Escaping
+
+        /// `string` as a JSON string literal, quotes included.
+        static func quoted(_ string: String) -> String {
+            var result = "\""
+            for scalar in string.unicodeScalars {
+                switch scalar {
+                case "\"": result += "\\\""
+                case "\\": result += "\\\\"
+                case "\n": result += "\\n"
+                case "\r": result += "\\r"
+                case "\t": result += "\\t"
+                default:
+                    if scalar.value < 0x20 {
+                        result += String(format: "\\u%04x", scalar.value)
+                    } else {
+                        result.unicodeScalars.append(scalar)
+                    }
+                }
+            }
+            return result + "\""
+        }
+    }
+}
+
+// MARK: - Regular Expressions
+
+/// Compiles the subset of regular expression syntax that guides commonly
+/// use into a pattern over the characters of a JSON string body.
+///
+/// Supports literals, `.`, character classes, `\d`, `\w`, `\s` and their
+/// negations, groups, alternation, and the `*`, `+`, `?` and `{n,m}`
+/// quantifiers. `^` and `$` are ignored because the whole string must match.
+/// Patterns using anything else (such as backreferences or lookaround)
+/// return `nil`, and the string is left unconstrained.
+///
+/// Characters that JSON requires to be escaped are written in their escaped
+/// form. Classes cannot contain them.
+enum JSONGrammarRegex {
+    typealias Pattern = JSONGrammarPattern
+
+    static func compile(_ pattern: String) -> Pattern? {
+        var parser = Parser(Array(pattern.unicodeScalars))
+        guard let result = parser.alternation(), parser.isAtEnd else { return nil }
+        return result
+    }
+
+    private struct Parser {
+        private let scalars: [Unicode.Scalar]
+        private var index = 0
+
+        init(_ scalars: [Unicode.Scalar]) {
+            self.scalars = scalars
+        }
+
+        var isAtEnd: Bool { index >= scalars.count }
+
+        private var current: Unicode.Scalar? { isAtEnd ? nil : scalars[index] }
+
+        mutating func alternation() -> Pattern? {
+            var options: [Pattern] = []
+            repeat {
+                guard let sequence = sequence() else { return nil }
+                options.append(sequence)
+            } while consume("|")
+            return options.count == 1 ? options[0] : .choice(options)
+        }
+
+        private mutating func sequence() -> Pattern? {
+            var parts: [Pattern] = []
+            while let scalar = current, scalar != "|", scalar != ")" {
+                if scalar == "^" || scalar == "$" {
+                    index += 1
+                    continue
+                }
+                guard let atom = atom(), let quantified = quantifier(atom) else { return nil }
+                parts.append(quantified)
+            }
+            return parts.count == 1 ? parts[0] : .sequence(parts)
+        }
+
+        private mutating func atom() -> Pattern? {
+            guard let scalar = current else { return nil }
+            index += 1
+
+            switch scalar {
+            case "(":
+                if consume("?") {
+                    guard consume(":") else { return nil }
+                }
+                guard let inner = alternation(), consume(")") else { return nil }
+                return inner
+            case "[":
+                return characterClass()
+            case ".":
+                return .set(.unescapedStringCharacters)
+            case "\\":
+                guard let escaped = current else { return nil }
+                index += 1
+                if let set = Self.classEscape(escaped) {
+                    return .set(set)
+                }
+                guard let literal = Self.literalEscape(escaped) else { return nil }
+                return Self.literal(literal)
+            case "*", "+", "?", "{", ")":
+                return nil
+            default:
+                return Self.literal(scalar)
+            }
+        }
+
+        private mutating func quantifier(_ atom: Pattern) -> Pattern? {
+            let result: Pattern
+            if consume("*") {
+                result = .repeated(atom, min: 0, max: nil)
+            } else if consume("+") {
+                result = .repeated(atom, min: 1, max: nil)
+            } else if consume("?") {
+                result = .optional(atom)
+            } else if current == "{" {
+                index += 1
+                guard let minimum = number() else { return nil }
+                var maximum: Int? = minimum
+                if consume(",") {
+                    maximum = number()
+                }
+                guard consume("}"), maximum.map({ $0 >= minimum }) ?? true else { return nil }
+                result = .repeated(atom, min: minimum, max: maximum)
+            } else {
+                return atom
+            }
+            // Lazy and possessive modifiers match the same strings.
+            if !consume("?") {
+                _ = consume("+")
+            }
+            return result
+        }
+
+        private mutating func characterClass() -> Pattern? {
+            let negated = consume("^")
+            var set = GrammarByteSet()
+            var extras: [Unicode.Scalar] = []
+            var isFirst = true
+
+            while let scalar = current, scalar != "]" || isFirst {
+                isFirst = false
+                index += 1
+                var lower = scalar
+                if scalar == "\\" {
+                    guard let escaped = current else { return nil }
+                    index += 1
+                    if let escapedSet = Self.classEscape(escaped) {
+                        set = set.union(escapedSet)
+                        continue
+                    }
+                    guard let literal = Self.literalEscape(escaped) else { return nil }
+                    lower = literal
+                }
+
+                if current == "-", index + 1 < scalars.count, scalars[index + 1] != "]" {
+                    index += 1
+                    guard var upper = current else { return nil }
+                    index += 1
+                    if upper == "\\" {
+                        guard let escaped = current, let literal = Self.literalEscape(escaped) else { return nil }
+                        index += 1
+                        upper = literal
+                    }
+                    guard lower.isASCII, upper.isASCII, lower.value <= upper.value else { return nil }
+                    set = set.union(GrammarByteSet(UInt8(lower.value)...UInt8(upper.value)))
+                } else if lower.isASCII {
+                    set.insert(UInt8(lower.value))
+                } else {
+                    extras.append(lower)
+                }
+            }
+            guard consume("]") else { return nil }
+
+            if negated {
+                // Excluding specific non-ASCII characters is not expressible,
+                // so negated classes accept every non-ASCII character.
+                var inverted = set.inverted
+                inverted.includesNonASCII = true
+                return .set(inverted.subtracting(Self.unsafe))
+            }
+            let safe = set.subtracting(Self.unsafe)
+            let options = (safe.isEmpty ? [] : [Pattern.set(safe)]) + extras.map { Self.literal($0) }
+            guard !options.isEmpty else { return nil }
+            return options.count == 1 ? options[0] : .choice(options)
+        }
+
+        private mutating func number() -> Int? {
+            var digits = ""
+            while let scalar = current, ("0"..."9").contains(scalar) {
+                digits.unicodeScalars.append(scalar)
+                index += 1
+            }
+            return Int(digits)
+        }
+
+        private mutating func consume(_ scalar: Unicode.Scalar) -> Bool {
+            guard current == scalar else { return false }
+            index += 1
+            return true
+        }
+
+        /// Bytes that only appear escaped inside a JSON string.
+        private static let unsafe = GrammarByteSet.unescapedStringCharacters.inverted
+
+        private static let word = GrammarByteSet("a"..."z")
+            .union(GrammarByteSet("A"..."Z"))
+            .union(.digits)
+            .union(GrammarByteSet("_"))
+
+        private static func classEscape(_ scalar: Unicode.Scalar) -> GrammarByteSet? {
+            // Whitespace other than a space must be escaped in JSON strings.
+            let space = GrammarByteSet(" ")
+            switch scalar {
+            case "d": return .digits
+            case "w": return word
+            case "s": return space
+            case "D": return GrammarByteSet.unescapedStringCharacters.subtracting(.digits)
+            case "W": return GrammarByteSet.unescapedStringCharacters.subtracting(word)
+            case "S": return GrammarByteSet.unescapedStringCharacters.subtracting(space)
+            default: return nil
+            }
+        }
+
+        private static func literalEscape(_ scalar: Unicode.Scalar) -> Unicode.Scalar? {
+            switch scalar {
+            case "n": return "\n"
+            case "t": return "\t"
+            case "r": return "\r"
+            default:
+                // Escaped punctuation stands for itself; other escapes are unsupported.
+                let isPunctuation = scalar.isASCII && !scalar.properties.isAlphabetic && !("0"..."9").contains(scalar)
+                return isPunctuation ? scalar : nil
+            }
+        }
+
+        /// A character as it appears inside a JSON string.
+        private static func literal(_ scalar: Unicode.Scalar) -> Pattern {
+            let quoted = JSONGrammar.quotedBody(String(scalar))
+            return .text(quoted)
+        }
+    }
+}
+
+extension JSONGrammar {
+    /// `string` escaped for use inside a JSON string literal, without quotes.
+    static func quotedBody(_ string: String) -> String {
+        String(Builder.quoted(string).dropFirst().dropLast())
+    }
+}
+
+// MARK: - Cache Storage
+
+/// A small lock-protected store of compiled grammars.
+private final class JSONGrammarCache: @unchecked Sendable {
+    private static let capacity = 64
+
+    private var grammars: [String: JSONGrammar] = [:]
+    private let lock = NSLock()
+
+    subscript(key: String) -> JSONGrammar? {
+        get { withLock { grammars[key] } }
+        set {
+            withLock {
+                if grammars.count >= Self.capacity {
+                    grammars.removeAll()
+                }
+                grammars[key] = newValue
+            }
+        }
+    }
+
+    private func withLock<T>(_ body: () -> T) -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return body()
+    }
+}
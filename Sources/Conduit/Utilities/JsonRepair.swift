@@ -77,6 +77,13 @@ public enum JsonRepair {
     /// - Parameter json: The potentially incomplete JSON string
     /// - Returns: A repaired JSON string that should be valid JSON
     public static func repair(_ json: String, maximumDepth: Int = 64) -> String {
+        ConduitTelemetry.increment(.jsonRepairs, source: "json")
+        return ConduitTelemetry.measure(.jsonRepair, source: "json") {
+            repairStructure(json, maximumDepth: maximumDepth)
+        }
+    }
+
+    private static func repairStructure(_ json: String, maximumDepth: Int) -> String {
         let trimmed = json.trimmingCharacters(in: .whitespaces)
         guard !trimmed.isEmpty else { return "{}" }
 
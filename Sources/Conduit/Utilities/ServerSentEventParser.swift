@@ -3,6 +3,11 @@
 //
 // Minimal Server-Sent Events (SSE) parsing utilities. Designed to match the
 // behavior expected by common EventSource implementations.
+//
+// Two modes are provided with identical semantics:
+// - `ServerSentEventParser` ingests already-decoded `String` lines.
+// - `ServerSentEventByteParser` ingests raw UTF-8 chunks from the transport
+//   and emits `data` payloads as `Data` ready for a JSON decoder.
 
 import Foundation
 
@@ -163,3 +168,267 @@ internal struct ServerSentEventParser: Sendable {
         return [event]
     }
 }
+
+// MARK: - Byte Mode
+
+/// A parsed Server-Sent Event whose `data` payload is kept as raw UTF-8 bytes.
+///
+/// Produced by ``ServerSentEventByteParser``. The payload can be handed
+/// directly to `JSONDecoder` without an intermediate `String`.
+internal struct RawServerSentEvent: Sendable, Equatable {
+    private static let doneMarker = Data("[DONE]".utf8)
+
+    /// The event ID (if provided by the server for this event).
+    var id: String?
+
+    /// The event type name (if provided via `event:`; `nil` implies `"message"`).
+    var event: String?
+
+    /// The event data payload bytes (multiple `data:` lines are joined with `\n`).
+    var data: Data
+
+    /// Optional reconnection retry interval (ms) if provided by a `retry:` field.
+    var retry: Int?
+
+    /// Whether the payload is the OpenAI-style `[DONE]` end-of-stream marker.
+    var isDoneMarker: Bool {
+        data == Self.doneMarker
+    }
+
+    /// The payload decoded as UTF-8, replacing invalid sequences.
+    var text: String {
+        String(decoding: data, as: UTF8.self)
+    }
+}
+
+extension ServerSentEvent {
+    /// Creates a string-mode event from a byte-mode event.
+    init(_ raw: RawServerSentEvent) {
+        self.init(id: raw.id, event: raw.event, data: raw.text, retry: raw.retry)
+    }
+}
+
+/// Incremental byte-level parser for Server-Sent Events (SSE).
+///
+/// Feed the parser raw response chunks exactly as they arrive from the
+/// transport. Lines are split in place with ``ByteLineSplitter``, field names
+/// are matched as bytes, and `data` payloads accumulate into a single `Data`
+/// buffer. No `String` is created for `data:` lines.
+///
+/// Semantics match ``ServerSentEventParser`` line for line; the parity tests
+/// exercise both modes against the same inputs.
+internal struct ServerSentEventByteParser: Sendable {
+    private static let colon = UInt8(ascii: ":")
+    private static let space = UInt8(ascii: " ")
+    private static let lineFeed = UInt8(ascii: "\n")
+    private static let carriageReturn = UInt8(ascii: "\r")
+    private static let byteOrderMark: [UInt8] = [0xEF, 0xBB, 0xBF]
+
+    private static let dataField = Array("data".utf8)
+    private static let eventField = Array("event".utf8)
+    private static let idField = Array("id".utf8)
+    private static let retryField = Array("retry".utf8)
+
+    private var splitter = ByteLineSplitter()
+
+    // Current event state
+    private var currentEventId: String?
+    private var currentEventType: String?
+    private var currentData = Data()
+    private var currentRetry: Int?
+    private var sawDataField = false
+
+    // Persistent state (not currently surfaced, but maintained for parity)
+    private var lastEventId: String = ""
+    private var reconnectionTime: Int = 3000
+
+    init() {}
+
+    /// Number of bytes buffered for an incomplete line.
+    var bufferedByteCount: Int {
+        splitter.bufferedByteCount
+    }
+
+    /// Ingests a chunk of raw response bytes and returns any complete events.
+    mutating func ingest<Bytes: Collection>(_ chunk: Bytes) -> [RawServerSentEvent] where Bytes.Element == UInt8 {
+        splitter.append(chunk)
+
+        var events: [RawServerSentEvent] = []
+        while let line = splitter.nextLine() {
+            if let event = ingestLine(line) {
+                events.append(event)
+            }
+        }
+        return events
+    }
+
+    /// Ingests one SSE line (without its trailing newline) and returns the event it completes, if any.
+    mutating func ingestLine(_ line: ArraySlice<UInt8>) -> RawServerSentEvent? {
+        var line = line
+
+        if line.last == Self.carriageReturn {
+            line.removeLast()
+        }
+        if line.starts(with: Self.byteOrderMark) {
+            line.removeFirst(Self.byteOrderMark.count)
+        }
+
+        // Empty line dispatches the event.
+        if line.isEmpty {
+            let event = dispatchIfNeeded()
+            sawDataField = false
+            return event
+        }
+
+        // Comments begin with ":" and are ignored.
+        if line.first == Self.colon {
+            return nil
+        }
+
+        let field: ArraySlice<UInt8>
+        var value: ArraySlice<UInt8>
+        if let colonIndex = line.firstIndex(of: Self.colon) {
+            field = line[..<colonIndex]
+            value = line[line.index(after: colonIndex)...]
+            // If the value begins with a single leading space, discard it (SSE spec).
+            if value.first == Self.space {
+                value.removeFirst()
+            }
+        } else {
+            // No colon: whole line is the field name, value is empty.
+            field = line
+            value = []
+        }
+
+        if field.elementsEqual(Self.dataField) {
+            if !currentData.isEmpty {
+                currentData.append(Self.lineFeed)
+            }
+            currentData.append(contentsOf: value)
+            sawDataField = true
+        } else if field.elementsEqual(Self.eventField) {
+            currentEventType = String(decoding: value, as: UTF8.self)
+        } else if field.elementsEqual(Self.idField) {
+            if !value.contains(0) {
+                let id = String(decoding: value, as: UTF8.self)
+                currentEventId = id
+                lastEventId = id
+            }
+        } else if field.elementsEqual(Self.retryField) {
+            if let milliseconds = Int(String(decoding: value, as: UTF8.self)), milliseconds > 0 {
+                reconnectionTime = milliseconds
+                currentRetry = milliseconds
+            }
+        }
+        // Unknown fields are ignored.
+
+        return nil
+    }
+
+    /// Call at end-of-stream to flush any trailing line and pending event.
+    mutating func finish() -> [RawServerSentEvent] {
+        var events: [RawServerSentEvent] = []
+        if let trailing = splitter.finish(), let event = ingestLine(trailing) {
+            events.append(event)
+        }
+
+        // Match upstream `EventSource.Parser.finish()` semantics: only dispatch if we have
+        // non-empty `data`, or an explicit `id:` / `event:` for this event.
+        guard !currentData.isEmpty || currentEventId != nil || currentEventType != nil else {
+            return events
+        }
+
+        if let event = dispatchIfNeeded() {
+            events.append(event)
+        }
+        sawDataField = false
+        return events
+    }
+
+    // MARK: - Internals
+
+    private mutating func dispatchIfNeeded() -> RawServerSentEvent? {
+        let isDataField = currentData.isEmpty && sawDataField
+        let isRetryOnly =
+            currentData.isEmpty && currentEventId == nil && currentEventType == nil
+            && !isDataField
+
+        defer {
+            // Per spec, `event` and `data` buffers reset after dispatch.
+            currentEventType = nil
+            currentData = Data()
+            currentEventId = nil
+            currentRetry = nil
+        }
+
+        guard !isRetryOnly else { return nil }
+
+        return RawServerSentEvent(
+            id: currentEventId,
+            event: currentEventType,
+            data: currentData,
+            retry: currentRetry
+        )
+    }
+}
+
+// MARK: - Async Event Sequence
+
+/// An async sequence of byte-mode SSE events parsed from a chunked response body.
+///
+/// Enforces ``AsyncLineSequence/maxBufferSize`` for a single unterminated line
+/// and flushes the parser at end of stream.
+internal struct ServerSentEventSequence: AsyncSequence, Sendable {
+    typealias Element = RawServerSentEvent
+
+    private let chunks: URLSessionAsyncChunks
+
+    init(chunks: URLSessionAsyncChunks) {
+        self.chunks = chunks
+    }
+
+    func makeAsyncIterator() -> AsyncIterator {
+        AsyncIterator(chunksIterator: chunks.makeAsyncIterator())
+    }
+
+    struct AsyncIterator: AsyncIteratorProtocol {
+        var chunksIterator: URLSessionAsyncChunks.AsyncIterator
+        var parser = ServerSentEventByteParser()
+        var pending: [RawServerSentEvent] = []
+        var pendingIndex = 0
+        var finished = false
+
+        mutating func next() async throws -> RawServerSentEvent? {
+            while true {
+                if pendingIndex < pending.count {
+                    let event = pending[pendingIndex]
+                    pendingIndex += 1
+                    return event
+                }
+
+                if finished { return nil }
+
+                guard let chunk = try await chunksIterator.next() else {
+                    finished = true
+                    pending = parser.finish()
+                    pendingIndex = 0
+                    continue
+                }
+
+                pending = parser.ingest(chunk)
+                pendingIndex = 0
+
+                if parser.bufferedByteCount >= AsyncLineSequence.maxBufferSize {
+                    throw URLError(.dataLengthExceedsMaximum)
+                }
+            }
+        }
+    }
+}
+
+extension URLSessionAsyncChunks {
+    /// The response body parsed as byte-mode Server-Sent Events.
+    var serverSentEvents: ServerSentEventSequence {
+        ServerSentEventSequence(chunks: self)
+    }
+}
@@ -0,0 +1,236 @@
+// ConduitBenchmark.swift
+// ConduitBenchmark
+//
+// Command-line runner for the V2 runtime benchmark and parity harness.
+//
+// ## Usage
+//
+// ```
+// swift run --traits Llama ConduitBenchmark \
+//     --provider llama --model /models/qwen2.5-0.5b-q4.gguf \
+//     --profile llama-q4 --output .build/benchmarks \
+//     --baseline previous/benchmarks/llama-q4-benchmark.json
+// ```
+//
+// Exits with status 1 when a metric regresses past its threshold relative to
+// `--baseline` (or, with `--require-parity`, when a mode diverges from
+// baseline output), and 2 on invalid arguments.
+
+import Foundation
+import ConduitAdvanced
+
+@main
+struct ConduitBenchmark {
+
+    static func main() async {
+        do {
+            let arguments = try BenchmarkArguments(CommandLine.arguments.dropFirst())
+            let passed = try await run(arguments)
+            exit(passed ? 0 : 1)
+        } catch let error as BenchmarkArguments.ParseError {
+            if !error.message.isEmpty {
+                printError(error.message)
+            }
+            printError(BenchmarkArguments.usage)
+            exit(2)
+        } catch {
+            printError("Benchmark failed: \(error)")
+            exit(1)
+        }
+    }
+
+    private static func run(_ arguments: BenchmarkArguments) async throws -> Bool {
+        let harness = V2RuntimeBenchmarkHarness(outputRoot: arguments.outputRoot, fixedSeed: arguments.seed)
+
+        let benchmark: V2RuntimeBenchmarkArtifact
+        let parity: V2RuntimeParityArtifact
+
+        switch arguments.provider {
+        case "llama":
+            let provider = LlamaProvider()
+            let model = ModelIdentifier.llama(arguments.model)
+            let options = makeOptions(arguments, memoryProbe: .process)
+            benchmark = try await harness.runBenchmark(
+                provider: provider, model: model, profileName: arguments.profile,
+                modes: arguments.modes, options: options
+            )
+            parity = try await harness.runParity(
+                provider: provider, model: model, profileName: arguments.profile,
+                modes: arguments.modes, options: options
+            )
+        #if CONDUIT_TRAIT_MLX && canImport(MLX)
+        case "mlx":
+            let provider = MLXProvider()
+            let model = ModelIdentifier.mlx(arguments.model)
+            let options = makeOptions(arguments, memoryProbe: .mlx)
+            benchmark = try await harness.runBenchmark(
+                provider: provider, model: model, profileName: arguments.profile,
+                modes: arguments.modes, options: options
+            )
+            parity = try await harness.runParity(
+                provider: provider, model: model, profileName: arguments.profile,
+                modes: arguments.modes, options: options
+            )
+        #endif
+        default:
+            throw BenchmarkArguments.ParseError(message: "Unsupported provider '\(arguments.provider)'")
+        }
+
+        printSummary(benchmark: benchmark, parity: parity)
+
+        var passed = true
+        for result in parity.modes where result.matchingRuns < result.totalRuns {
+            printError("Parity: \(result.mode.rawValue) matched \(result.matchingRuns)/\(result.totalRuns) runs")
+            if arguments.requireParity {
+                passed = false
+            }
+        }
+
+        if let baselineURL = arguments.baseline {
+            let current = try V2RuntimeBenchmarkReport.load(from: benchmark.outputPath)
+            let previous = try V2RuntimeBenchmarkReport.load(from: baselineURL)
+            for regression in current.regressions(against: previous) {
+                let percent = String(format: "%.1f%%", regression.change * 100)
+                printError(
+                    "Regression: \(regression.mode.rawValue) \(regression.metric) "
+                        + "\(regression.baseline) -> \(regression.current) (\(percent) worse)"
+                )
+                passed = false
+            }
+        }
+        return passed
+    }
+
+    private static func makeOptions(
+        _ arguments: BenchmarkArguments,
+        memoryProbe: V2RuntimeMemoryProbe
+    ) -> V2RuntimeBenchmarkOptions {
+        var features = ProviderRuntimeFeatureConfiguration()
+        features.speculativeScheduling.draftModel = arguments.draftModel
+        return V2RuntimeBenchmarkOptions(
+            corpus: .seeded(arguments.seed, count: arguments.promptCount),
+            config: .default.temperature(0).maxTokens(arguments.maxTokens).runtimeFeatures(features),
+            warmupRuns: arguments.warmupRuns,
+            parityRuns: arguments.parityRuns,
+            memoryProbe: memoryProbe
+        )
+    }
+
+    private static func printSummary(benchmark: V2RuntimeBenchmarkArtifact, parity: V2RuntimeParityArtifact) {
+        print("mode                 ttft_ms  decode_tok/s  p95_itl_ms  kv_mb    parity")
+        for point in benchmark.results {
+            let parityResult = parity.modes.first { $0.mode == point.mode }
+            let parityText = parityResult.map { "\($0.matchingRuns)/\($0.totalRuns)" } ?? "-"
+            let metrics = String(
+                format: "%8.1f  %12.2f  %10.2f  %7.1f",
+                point.ttftMs,
+                point.decodeTokensPerSecond,
+                point.p95LatencyMs,
+                point.kvMemoryMB
+            )
+            print("\(point.mode.rawValue.padding(toLength: 20, withPad: " ", startingAt: 0)) \(metrics)  \(parityText)")
+        }
+        print("Wrote \(benchmark.outputPath.path)")
+        print("Wrote \(parity.outputPath.path)")
+    }
+
+    private static func printError(_ message: String) {
+        FileHandle.standardError.write(Data((message + "\n").utf8))
+    }
+}
+
+// MARK: - Arguments
+
+private struct BenchmarkArguments {
+    struct ParseError: Error {
+        let message: String
+    }
+
+    static let usage = """
+        Usage: ConduitBenchmark --provider <llama|mlx> --model <id-or-path> [options]
+
+          --profile <name>          Artifact name (default: provider name)
+          --output <dir>            Artifact root (default: .build/benchmarks)
+          --seed <n>                Corpus and sampling seed (default: 42)
+          --modes <a,b,...>         Runtime modes (default: all)
+          --prompts <n>             Corpus size (default: 8)
+          --max-tokens <n>          Tokens per request (default: 128)
+          --warmup <n>              Untimed requests per mode (default: 1)
+          --parity-runs <n>         Parity generations per mode (default: 8)
+          --draft-model <id>        Draft model for the speculative mode
+          --baseline <file>         Previous benchmark JSON to gate regressions against
+          --require-parity          Fail when any mode diverges from baseline output
+        """
+
+    var provider = ""
+    var model = ""
+    var profile = ""
+    var outputRoot = URL(fileURLWithPath: ".build/benchmarks", isDirectory: true)
+    var seed: UInt64 = 42
+    var modes = V2RuntimeMode.allCases
+    var promptCount = 8
+    var maxTokens = 128
+    var warmupRuns = 1
+    var parityRuns = 8
+    var draftModel: String?
+    var baseline: URL?
+    var requireParity = false
+
+    init<Arguments: Collection<String>>(_ arguments: Arguments) throws {
+        var iterator = arguments.makeIterator()
+
+        func value(for flag: String) throws -> String {
+            guard let value = iterator.next() else {
+                throw ParseError(message: "Missing value for \(flag)")
+            }
+            return value
+        }
+
+        func integer(for flag: String) throws -> Int {
+            let text = try value(for: flag)
+            guard let number = Int(text), number >= 0 else {
+                throw ParseError(message: "Invalid value '\(text)' for \(flag)")
+            }
+            return number
+        }
+
+        while let flag = iterator.next() {
+            switch flag {
+            case "--provider": provider = try value(for: flag)
+            case "--model": model = try value(for: flag)
+            case "--profile": profile = try value(for: flag)
+            case "--output": outputRoot = URL(fileURLWithPath: try value(for: flag), isDirectory: true)
+            case "--seed":
+                let text = try value(for: flag)
+                guard let parsed = UInt64(text) else {
+                    throw ParseError(message: "Invalid value '\(text)' for \(flag)")
+                }
+                seed = parsed
+            case "--modes":
+                let names = try value(for: flag).split(separator: ",").map(String.init)
+                modes = try names.map { name in
+                    guard let mode = V2RuntimeMode(rawValue: name) else {
+                        throw ParseError(message: "Unknown mode '\(name)'")
+                    }
+                    return mode
+                }
+            case "--prompts": promptCount = try integer(for: flag)
+            case "--max-tokens": maxTokens = try integer(for: flag)
+            case "--warmup": warmupRuns = try integer(for: flag)
+            case "--parity-runs": parityRuns = try integer(for: flag)
+            case "--draft-model": draftModel = try value(for: flag)
+            case "--baseline": baseline = URL(fileURLWithPath: try value(for: flag))
+            case "--require-parity": requireParity = true
+            case "--help", "-h": throw ParseError(message: "")
+            default: throw ParseError(message: "Unknown argument '\(flag)'")
+            }
+        }
+
+        guard !provider.isEmpty, !model.isEmpty else {
+            throw ParseError(message: "--provider and --model are required")
+        }
+        if profile.isEmpty {
+            profile = provider
+        }
+    }
+}
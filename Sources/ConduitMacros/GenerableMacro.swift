@@ -17,6 +17,8 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
             let description = extractDescription(from: node)
             let properties = extractGuidedProperties(from: structDecl)
 
+            let isGeneric = structDecl.genericParameterClause != nil
+
             return [
                 generateRawContentProperty(),
                 generateMemberwiseInit(properties: properties),
@@ -26,11 +28,12 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
                     description: description,
                     properties: properties
                 ),
-                generateGenerationSchemaProperty(
-                    structName: structName,
-                    description: description,
-                    properties: properties
-                ),
+            ] + generateGenerationSchemaProperty(
+                structName: structName,
+                description: description,
+                properties: properties,
+                isGeneric: isGeneric
+            ) + [
                 generatePartiallyGeneratedStruct(structName: structName, properties: properties),
                 generateAsPartiallyGeneratedMethod(structName: structName),
                 generateInstructionsRepresentationProperty(),
@@ -42,6 +45,8 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
             let description = extractDescription(from: node)
             let cases = extractEnumCases(from: enumDecl)
 
+            let isGeneric = enumDecl.genericParameterClause != nil
+
             return [
                 generateEnumInitFromGeneratedContent(enumName: enumName, cases: cases),
                 generateEnumGeneratedContentProperty(
@@ -49,11 +54,12 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
                     description: description,
                     cases: cases
                 ),
-                generateEnumGenerationSchemaProperty(
-                    enumName: enumName,
-                    description: description,
-                    cases: cases
-                ),
+            ] + generateEnumGenerationSchemaProperty(
+                enumName: enumName,
+                description: description,
+                cases: cases,
+                isGeneric: isGeneric
+            ) + [
                 generateAsPartiallyGeneratedMethodForEnum(enumName: enumName),
                 generateInstructionsRepresentationProperty(),
                 generatePromptRepresentationProperty(),
@@ -716,8 +722,9 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
     private static func generateGenerationSchemaProperty(
         structName: String,
         description: String?,
-        properties: [PropertyInfo]
-    ) -> DeclSyntax {
+        properties: [PropertyInfo],
+        isGeneric: Bool
+    ) -> [DeclSyntax] {
         let propertySchemas = properties.map { prop in
             var guidesArray = "[]"
             if !prop.guides.isEmpty || prop.pattern != nil {
@@ -759,19 +766,51 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
         let escapedSchemaDescription = description.map(escapeSwiftStringLiteralContent(_:))
             ?? "Generated \(structName)"
 
-        return DeclSyntax(
-            stringLiteral: """
-                nonisolated public static var generationSchema: Conduit.GenerationSchema {
-                    return Conduit.GenerationSchema(
-                        type: Self.self,
-                        description: "\(escapedSchemaDescription)",
-                        properties: [\(properties.isEmpty ? "" : "\n            \(propertySchemas)\n        ")]
-                    )
-                }
-                """
+        return generateSchemaDeclarations(
+            """
+            Conduit.GenerationSchema(
+                    type: Self.self,
+                    description: "\(escapedSchemaDescription)",
+                    properties: [\(properties.isEmpty ? "" : "\n            \(propertySchemas)\n        ")]
+                )
+            """,
+            isGeneric: isGeneric
         )
     }
 
+    /// Declares `generationSchema` as `schemaExpression`.
+    ///
+    /// The schema is built once into a static constant, so its encoded JSON
+    /// forms are computed once per type and shared by every request. Generic
+    /// types cannot have static stored properties and rebuild it on access.
+    private static func generateSchemaDeclarations(_ schemaExpression: String, isGeneric: Bool) -> [DeclSyntax] {
+        guard !isGeneric else {
+            return [
+                DeclSyntax(
+                    stringLiteral: """
+                        nonisolated public static var generationSchema: Conduit.GenerationSchema {
+                            return \(schemaExpression)
+                        }
+                        """
+                )
+            ]
+        }
+        return [
+            DeclSyntax(
+                stringLiteral: """
+                    nonisolated private static let _generationSchema: Conduit.GenerationSchema = \(schemaExpression)
+                    """
+            ),
+            DeclSyntax(
+                stringLiteral: """
+                    nonisolated public static var generationSchema: Conduit.GenerationSchema {
+                        return _generationSchema
+                    }
+                    """
+            ),
+        ]
+    }
+
     private static func generateAsPartiallyGeneratedMethod(structName: String) -> DeclSyntax {
         return DeclSyntax(
             stringLiteral: """
@@ -1227,8 +1266,9 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
     private static func generateEnumGenerationSchemaProperty(
         enumName: String,
         description: String?,
-        cases: [EnumCaseInfo]
-    ) -> DeclSyntax {
+        cases: [EnumCaseInfo],
+        isGeneric: Bool
+    ) -> [DeclSyntax] {
         let hasAnyAssociatedValues = cases.contains { $0.hasAssociatedValues }
 
         if hasAnyAssociatedValues {
@@ -1253,19 +1293,18 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
             let escapedSchemaDescription = description.map(escapeSwiftStringLiteralContent(_:))
                 ?? "Generated \(enumName)"
 
-            return DeclSyntax(
-                stringLiteral: """
-                    nonisolated public static var generationSchema: Conduit.GenerationSchema {
-                        return Conduit.GenerationSchema(
-                            type: Self.self,
-                            description: "\(escapedSchemaDescription)",
-                            properties: [
-                                \(caseProperty),
-                                \(valueProperty)
-                            ]
-                        )
-                    }
-                    """
+            return generateSchemaDeclarations(
+                """
+                Conduit.GenerationSchema(
+                        type: Self.self,
+                        description: "\(escapedSchemaDescription)",
+                        properties: [
+                            \(caseProperty),
+                            \(valueProperty)
+                        ]
+                    )
+                """,
+                isGeneric: isGeneric
             )
         } else {
             let caseNames = cases.map { "\"\($0.name)\"" }.joined(separator: ", ")
@@ -1273,16 +1312,15 @@ public struct GenerableMacro: MemberMacro, ExtensionMacro {
             let escapedSchemaDescription = description.map(escapeSwiftStringLiteralContent(_:))
                 ?? "Generated \(enumName)"
 
-            return DeclSyntax(
-                stringLiteral: """
-                    nonisolated public static var generationSchema: Conduit.GenerationSchema {
-                        return Conduit.GenerationSchema(
-                            type: Self.self,
-                            description: "\(escapedSchemaDescription)",
-                            anyOf: [\(caseNames)]
-                        )
-                    }
-                    """
+            return generateSchemaDeclarations(
+                """
+                Conduit.GenerationSchema(
+                        type: Self.self,
+                        description: "\(escapedSchemaDescription)",
+                        anyOf: [\(caseNames)]
+                    )
+                """,
+                isGeneric: isGeneric
             )
         }
     }
@@ -0,0 +1,179 @@
+// MLXModelResidencyTests.swift
+// ConduitTests
+//
+// This file requires the MLX trait to be enabled.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+#if CONDUIT_TRAIT_MLX && canImport(MLX)
+
+@Suite("MLX Model Residency Tests")
+struct MLXModelResidencyTests {
+
+    private let device = DeviceCapabilities(
+        totalRAM: 32_000_000_000,
+        availableRAM: 20_000_000_000,
+        supportsMLX: true,
+        supportsFoundationModels: false
+    )
+
+    private func candidate(
+        _ key: String,
+        gigabytes: Int64,
+        priority: Double,
+        lastAccess: UInt64
+    ) -> MLXResidencyPolicy.Candidate {
+        MLXResidencyPolicy.Candidate(
+            key: key,
+            bytes: gigabytes * 1_000_000_000,
+            priority: priority,
+            lastAccess: lastAccess
+        )
+    }
+
+    // MARK: - Priority
+
+    @Test("Priority weights reload time by size on top of inflation")
+    func priorityWeighting() {
+        let slow = MLXResidencyPolicy.priority(inflation: 0, reloadSeconds: 8, bytes: 2_000_000_000)
+        let fast = MLXResidencyPolicy.priority(inflation: 0, reloadSeconds: 2, bytes: 2_000_000_000)
+        #expect(slow == 4)
+        #expect(fast == 1)
+
+        let inflated = MLXResidencyPolicy.priority(inflation: 10, reloadSeconds: 2, bytes: 2_000_000_000)
+        #expect(inflated == 11)
+
+        // Tiny models are weighted as if they had the minimum size
+        let tiny = MLXResidencyPolicy.priority(inflation: 0, reloadSeconds: 1, bytes: 1_000)
+        #expect(tiny == 4)
+    }
+
+    // MARK: - Victims
+
+    @Test("Lowest priority is evicted first and ties fall back to LRU")
+    func victimOrdering() {
+        let candidates = [
+            candidate("expensive", gigabytes: 2, priority: 5, lastAccess: 1),
+            candidate("cheap-old", gigabytes: 2, priority: 1, lastAccess: 2),
+            candidate("cheap-new", gigabytes: 2, priority: 1, lastAccess: 3),
+        ]
+
+        let victims = MLXResidencyPolicy.victims(among: candidates, countLimit: 1, byteLimit: nil)
+        #expect(victims == ["cheap-old", "cheap-new"])
+    }
+
+    @Test("Byte limits include the model about to load")
+    func victimsForReservation() {
+        let candidates = [
+            candidate("a", gigabytes: 4, priority: 2, lastAccess: 1),
+            candidate("b", gigabytes: 4, priority: 1, lastAccess: 2),
+        ]
+
+        let fits = MLXResidencyPolicy.victims(
+            among: candidates,
+            countLimit: 0,
+            byteLimit: 12_000_000_000,
+            additionalModels: 1,
+            additionalBytes: 4_000_000_000
+        )
+        #expect(fits.isEmpty)
+
+        let tight = MLXResidencyPolicy.victims(
+            among: candidates,
+            countLimit: 0,
+            byteLimit: 10_000_000_000,
+            additionalModels: 1,
+            additionalBytes: 4_000_000_000
+        )
+        #expect(tight == ["b"])
+    }
+
+    @Test("The protected model is never evicted")
+    func protectedModel() {
+        let candidates = [
+            candidate("current", gigabytes: 8, priority: 0, lastAccess: 1),
+            candidate("idle", gigabytes: 8, priority: 3, lastAccess: 2),
+        ]
+
+        let victims = MLXResidencyPolicy.victims(
+            among: candidates,
+            countLimit: 0,
+            byteLimit: 1,
+            protecting: "current"
+        )
+        #expect(victims == ["idle"])
+    }
+
+    // MARK: - Budget and Prefetch
+
+    @Test("Default budget and prefetch gate follow device memory")
+    func deviceDerivedLimits() {
+        #expect(MLXResidencyPolicy.defaultByteBudget(for: device) == 19_200_000_000)
+
+        #expect(MLXResidencyPolicy.canPrefetch(
+            bytes: 4_000_000_000,
+            residentBytes: 8_000_000_000,
+            byteBudget: 19_200_000_000,
+            device: device
+        ))
+
+        // Would exceed the budget
+        #expect(!MLXResidencyPolicy.canPrefetch(
+            bytes: 12_000_000_000,
+            residentBytes: 8_000_000_000,
+            byteBudget: 19_200_000_000,
+            device: device
+        ))
+
+        // Would leave less than 10% of RAM free
+        let busy = DeviceCapabilities(
+            totalRAM: 32_000_000_000,
+            availableRAM: 6_000_000_000,
+            supportsMLX: true,
+            supportsFoundationModels: false
+        )
+        #expect(!MLXResidencyPolicy.canPrefetch(
+            bytes: 4_000_000_000,
+            residentBytes: 0,
+            byteBudget: 19_200_000_000,
+            device: busy
+        ))
+    }
+
+    // MARK: - Cache
+
+    @Test("Empty caches report limits and count pressure events")
+    func cacheStatistics() async {
+        let cache = MLXModelCache(configuration: .lowMemory, device: device)
+
+        let limits = await cache._testing_limits()
+        #expect(limits.countLimit == 1)
+        #expect(limits.totalCostLimit == 4_000_000_000)
+
+        await cache.handleMemoryPressure(.warning)
+        await cache.handleMemoryPressure(.critical)
+        #expect(await cache.checkout("missing") == nil)
+
+        let stats = await cache.residencyStats()
+        #expect(stats.memoryPressureEvents == 2)
+        #expect(stats.misses == 1)
+        #expect(stats.byteBudget == .gigabytes(4))
+        #expect(stats.models.isEmpty)
+    }
+
+    @Test("Unmeasured models are never prefetched")
+    func prefetchRequiresMeasurement() async {
+        let cache = MLXModelCache(device: device)
+        for _ in 0..<3 {
+            await cache.setCurrentModel("a")
+            await cache.setCurrentModel("b")
+        }
+
+        #expect(await cache.prefetchCandidate(after: "a", device: device) == nil)
+        #expect(await cache.residencyStats().byteBudget.bytes == 19_200_000_000)
+    }
+}
+
+#endif // CONDUIT_TRAIT_MLX && canImport(MLX)
@@ -264,6 +264,104 @@ struct TextEmbeddingCacheTests {
         #expect(cache.get(key2)?.shape == [4, 6])
         #expect(cache.get(key3)?.shape == [2, 4, 6])
     }
+
+    // MARK: - Disk Tier
+
+    private func makeDirectory() throws -> URL {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("TextEmbeddingCacheTests-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    @Test("Persisted embeddings survive a new cache instance")
+    func testPersistedAcrossInstances() async throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let embedding = MLXArray((0..<24).map { Float($0) / 2 }, [2, 3, 4])
+        let key = TextEmbeddingCache.CacheKey(prompt: "A lighthouse", negativePrompt: "fog", modelId: "sdxl-turbo")
+        TextEmbeddingCache(directory: directory).put(embedding, forKey: key)
+
+        let restarted = TextEmbeddingCache(directory: directory)
+        let restored = try #require(restarted.get(key))
+        #expect(restored.shape == [2, 3, 4])
+        #expect(restored.dtype == .float32)
+        #expect(restored.asArray(Float.self) == embedding.asArray(Float.self))
+    }
+
+    @Test("Model change keeps persisted embeddings")
+    func testModelChangeKeepsPersisted() async throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let cache = TextEmbeddingCache(directory: directory)
+        let key = cache.makeKey(prompt: "Test prompt", negativePrompt: "", modelId: "model-1")
+        cache.put(MLXArray(0...11, [3, 4]), forKey: key)
+
+        await cache.modelDidChange(to: "model-2")
+        #expect(cache.get(key)?.shape == [3, 4])
+
+        cache.clear()
+        cache.removePersisted()
+        #expect(cache.get(key) == nil)
+    }
+
+    @Test("Persisted files are named by the whole key")
+    func testPersistedFileNames() throws {
+        let cache = TextEmbeddingCache(directory: FileManager.default.temporaryDirectory)
+        let key = cache.makeKey(prompt: "A", negativePrompt: "", modelId: "model-1")
+        let url = try #require(cache.persistedURL(for: key))
+
+        #expect(url.pathExtension == "embedding")
+        #expect(url == cache.persistedURL(for: key))
+        #expect(url != cache.persistedURL(for: cache.makeKey(prompt: "A", negativePrompt: "", modelId: "model-2")))
+        #expect(TextEmbeddingCache().persistedURL(for: key) == nil)
+    }
+
+    @Test("Corrupt persisted files are treated as misses")
+    func testCorruptPersistedFile() async throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let cache = TextEmbeddingCache(directory: directory)
+        let key = cache.makeKey(prompt: "Broken", negativePrompt: "", modelId: "model")
+        let url = try #require(cache.persistedURL(for: key))
+        try Data("CEMB-not-an-embedding".utf8).write(to: url)
+
+        #expect(cache.get(key) == nil)
+        #expect(!FileManager.default.fileExists(atPath: url.path))
+    }
+
+    @Test("Disk tier evicts the oldest files past its limit, down to three quarters of it")
+    func testDiskLimit() async throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        // Each 3x4 float32 embedding persists as 16 + 2 * 8 + 48 = 80 bytes.
+        // The fourth write passes 250 bytes and trims to at most 187.
+        let cache = TextEmbeddingCache(directory: directory, diskLimit: 250)
+        let keys = (1...4).map { cache.makeKey(prompt: "Prompt \($0)", negativePrompt: "", modelId: "model") }
+        for (index, key) in keys.enumerated() {
+            cache.put(MLXArray(Array(repeating: Float(index), count: 12), [3, 4]), forKey: key)
+            let url = try #require(cache.persistedURL(for: key))
+            try FileManager.default.setAttributes(
+                [.modificationDate: Date(timeIntervalSinceNow: Double(index - 10))],
+                ofItemAtPath: url.path
+            )
+        }
+
+        let remaining = keys.filter { key in
+            cache.persistedURL(for: key).map { FileManager.default.fileExists(atPath: $0.path) } ?? false
+        }
+        #expect(remaining == [keys[2], keys[3]])
+
+        // Rewriting an entry replaces its bytes instead of adding to them
+        cache.put(MLXArray(Array(repeating: Float(9), count: 12), [3, 4]), forKey: keys[3])
+        let restarted = TextEmbeddingCache(directory: directory, diskLimit: 250)
+        #expect(restarted.get(keys[2]) != nil)
+        #expect(restarted.get(keys[3])?.asArray(Float.self) == Array(repeating: Float(9), count: 12))
+    }
 }
 
 private extension FileManager {
@@ -1043,4 +1043,429 @@ struct ChatSessionTests {
         let callCount = await provider.generateCallCount
         #expect(callCount == 0)
     }
+
+    @Test("Background warmup finishes before the first message generates")
+    func asyncInitBackgroundWarmup() async throws {
+        let provider = MockTextProvider()
+        await provider.setGenerationDelay(nanoseconds: 20_000_000)
+
+        let session = try await ChatSession(
+            provider: provider,
+            model: .llama3_2_1b,
+            warmup: .background
+        )
+        _ = try await session.send("Hello")
+
+        let calls = await provider.receivedMessagesByGenerateCall
+        #expect(calls.count == 2)
+        #expect(calls.first?.first?.content.textValue.contains("Hi!") == true)
+        #expect(calls.last?.last?.content.textValue == "Hello")
+    }
+
+    @Test("Progressive warmup runs a quick pass first and yields to the first message")
+    func asyncInitProgressiveWarmup() async throws {
+        let provider = MockTextProvider()
+
+        let session = try await ChatSession(
+            provider: provider,
+            model: .llama3_2_1b,
+            warmup: .progressive
+        )
+        _ = try await session.send("Hello")
+
+        let calls = await provider.receivedMessagesByGenerateCall
+        #expect(calls.first?.first?.content.textValue == "Hi")
+        #expect(calls.contains { $0.last?.content.textValue == "Hello" })
+        #expect(WarmupConfig.progressive.mode == .progressive)
+    }
+}
+
+// MARK: - Streaming Tool Tests
+
+/// Records the order of tool and stream events.
+actor StreamEventLog {
+    private(set) var events: [String] = []
+
+    func record(_ event: String) {
+        events.append(event)
+    }
+
+    /// Waits up to a second for `event` to be recorded.
+    func waitFor(_ event: String) async {
+        for _ in 0..<100 where !events.contains(event) {
+            try? await Task.sleep(for: .milliseconds(10))
+        }
+    }
+}
+
+struct SessionLoggingTool: Tool {
+    @Generable
+    struct Arguments {
+        let input: String
+    }
+
+    let name = "session_logging_tool"
+    let description = "Logs when it runs for streaming tool tests."
+    let log: StreamEventLog
+
+    func call(arguments: Arguments) async throws -> String {
+        await log.record("tool")
+        return "Logged: \(arguments.input)"
+    }
+}
+
+/// Streams scripted chunks, one script per request.
+///
+/// Before a round's final chunk it logs `"end"`, first waiting for the
+/// event named by `waitBeforeEnd` if set.
+actor ScriptedStreamProvider: AIProvider, @preconcurrency TextGenerator {
+    typealias Response = GenerationResult
+    typealias StreamChunk = GenerationChunk
+    typealias ModelID = ModelIdentifier
+
+    private var rounds: [[GenerationChunk]]
+    private let log: StreamEventLog
+    private let waitBeforeEnd: String?
+    private(set) var receivedMessages: [[Message]] = []
+
+    init(rounds: [[GenerationChunk]], log: StreamEventLog = StreamEventLog(), waitBeforeEnd: String? = nil) {
+        self.rounds = rounds
+        self.log = log
+        self.waitBeforeEnd = waitBeforeEnd
+    }
+
+    var isAvailable: Bool { true }
+
+    var availabilityStatus: ProviderAvailability {
+        .available
+    }
+
+    func generate(messages: [Message], model: ModelID, config: GenerateConfig) async throws -> GenerationResult {
+        GenerationResult(text: "", tokenCount: 0, generationTime: 0, tokensPerSecond: 0, finishReason: .stop)
+    }
+
+    func stream(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<StreamChunk, Error> {
+        receivedMessages.append(messages)
+        let chunks = rounds.isEmpty ? [GenerationChunk(text: "", isComplete: true)] : rounds.removeFirst()
+        let log = log
+        let waitBeforeEnd = waitBeforeEnd
+
+        return AsyncThrowingStream { continuation in
+            Task {
+                for (index, chunk) in chunks.enumerated() {
+                    if index == chunks.count - 1 {
+                        if let waitBeforeEnd {
+                            await log.waitFor(waitBeforeEnd)
+                        }
+                        await log.record("end")
+                    }
+                    continuation.yield(chunk)
+                }
+                continuation.finish()
+            }
+        }
+    }
+
+    func cancelGeneration() async {
+        // No-op for tests
+    }
+
+    nonisolated func generate(_ prompt: String, model: ModelID, config: GenerateConfig) async throws -> String {
+        try await generate(messages: [.user(prompt)], model: model, config: config).text
+    }
+
+    nonisolated func stream(
+        _ prompt: String,
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<String, Error> {
+        AsyncThrowingStream { continuation in
+            Task {
+                do {
+                    for try await chunk in streamWithMetadata(messages: [.user(prompt)], model: model, config: config) {
+                        continuation.yield(chunk.text)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+        }
+    }
+
+    nonisolated func streamWithMetadata(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        AsyncThrowingStream { continuation in
+            Task {
+                do {
+                    for try await chunk in await self.stream(messages: messages, model: model, config: config) {
+                        continuation.yield(chunk)
+                    }
+                    continuation.finish()
+                } catch {
+                    continuation.finish(throwing: error)
+                }
+            }
+        }
+    }
+}
+
+@Suite("ChatSession Streaming Tool Tests")
+struct ChatSessionStreamingToolTests {
+
+    /// A round that streams `text`, completes `call` mid-stream, and lists it again at the end.
+    private func toolRound(_ text: String, call: Transcript.ToolCall) -> [GenerationChunk] {
+        [
+            GenerationChunk(text: text),
+            GenerationChunk(
+                text: "",
+                partialToolCall: PartialToolCall(
+                    id: call.id,
+                    toolName: call.toolName,
+                    index: 0,
+                    argumentsFragment: "",
+                    partialArguments: call.arguments,
+                    isArgumentsComplete: true
+                )
+            ),
+            GenerationChunk(text: "", isComplete: true, finishReason: .toolCalls, completedToolCalls: [call]),
+        ]
+    }
+
+    private func collect(_ stream: AsyncThrowingStream<String, Error>) async throws -> String {
+        var text = ""
+        for try await token in stream {
+            text += token
+        }
+        return text
+    }
+
+    @Test("stream runs tool calls and continues to the final answer")
+    func streamRunsToolLoop() async throws {
+        let call = try Transcript.ToolCall(
+            id: "stream_tool_1",
+            toolName: "session_echo_tool",
+            argumentsJSON: #"{"input":"Paris"}"#
+        )
+        let provider = ScriptedStreamProvider(rounds: [
+            toolRound("Looking up. ", call: call),
+            [GenerationChunk(text: "It is Paris.", isComplete: true, finishReason: .stop)],
+        ])
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.toolExecutor = ToolExecutor(tools: [SessionEchoTool()])
+
+        let text = try await collect(session.stream("Where?"))
+
+        #expect(text == "Looking up. It is Paris.")
+        #expect(session.messages.map(\.role) == [.user, .assistant, .tool, .assistant])
+        #expect(session.messages[1].metadata?.toolCalls?.map(\.id) == ["stream_tool_1"])
+        #expect(session.messages[2].content.textValue.contains("Echo: Paris"))
+        #expect(session.isGenerating == false)
+
+        // The second request carries the tool result
+        let received = await provider.receivedMessages
+        #expect(received.count == 2)
+        #expect(received.last?.map(\.role) == [.user, .assistant, .tool])
+    }
+
+    @Test("stream starts a tool before the response finishes")
+    func streamStartsToolsEarly() async throws {
+        let log = StreamEventLog()
+        let call = try Transcript.ToolCall(
+            id: "stream_tool_early",
+            toolName: "session_logging_tool",
+            argumentsJSON: #"{"input":"now"}"#
+        )
+        let provider = ScriptedStreamProvider(
+            rounds: [toolRound("Working. ", call: call), [GenerationChunk(text: "Done.", isComplete: true)]],
+            log: log,
+            waitBeforeEnd: "tool"
+        )
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.toolExecutor = ToolExecutor(tools: [SessionLoggingTool(log: log)])
+
+        _ = try await collect(session.stream("Go"))
+
+        #expect(await log.events == ["tool", "end", "end"])
+        #expect(session.messages.filter { $0.role == .tool }.count == 1)
+    }
+
+    @Test("stream throws when tool loop exceeds max rounds")
+    func streamThrowsWhenToolLoopExceedsMaxRounds() async throws {
+        let first = try Transcript.ToolCall(
+            id: "stream_loop_1",
+            toolName: "session_echo_tool",
+            argumentsJSON: #"{"input":"one"}"#
+        )
+        let second = try Transcript.ToolCall(
+            id: "stream_loop_2",
+            toolName: "session_echo_tool",
+            argumentsJSON: #"{"input":"two"}"#
+        )
+        let provider = ScriptedStreamProvider(rounds: [
+            toolRound("One. ", call: first),
+            toolRound("Two. ", call: second),
+        ])
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.toolExecutor = ToolExecutor(tools: [SessionEchoTool()])
+        session.maxToolCallRounds = 1
+
+        await #expect(throws: AIError.self) {
+            _ = try await collect(session.stream("Loop"))
+        }
+
+        #expect(session.messages.isEmpty)
+        #expect(session.isGenerating == false)
+        guard case .invalidInput(let message)? = session.lastError as? AIError else {
+            Issue.record("Expected AIError.invalidInput for loop limit failure")
+            return
+        }
+        #expect(message.contains("maxToolCallRounds"))
+    }
+
+    @Test("stream without a tool executor keeps the text and drops unanswered calls")
+    func streamWithoutExecutor() async throws {
+        let call = try Transcript.ToolCall(
+            id: "stream_no_executor",
+            toolName: "session_echo_tool",
+            argumentsJSON: #"{"input":"x"}"#
+        )
+        let provider = ScriptedStreamProvider(rounds: [
+            toolRound("Calling. ", call: call),
+            [GenerationChunk(text: "Sure."), GenerationChunk(text: "", isComplete: true, finishReason: .stop)],
+        ])
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+
+        let text = try await collect(session.stream("Hi"))
+
+        #expect(text == "Calling. ")
+        #expect(session.messages.map(\.role) == [.user, .assistant])
+        #expect(session.messages[1].metadata?.toolCalls == nil)
+
+        // The next request carries no tool call that lacks a tool result
+        _ = try await collect(session.stream("Again"))
+        let followUp = try #require(await provider.receivedMessages.last)
+        #expect(followUp.allSatisfy { $0.metadata?.toolCalls == nil })
+    }
+}
+
+// MARK: - Context Window Tests
+
+/// Records calls made by context window hooks.
+actor ContextWindowRecorder {
+    private(set) var countedMessages: [Message] = []
+    private(set) var evictedBatches: [[Message]] = []
+
+    func recordCounted(_ messages: [Message]) {
+        countedMessages.append(contentsOf: messages)
+    }
+
+    func recordEvicted(_ messages: [Message]) {
+        evictedBatches.append(messages)
+    }
+}
+
+@Suite("ChatSession Context Window Tests")
+struct ChatSessionContextWindowTests {
+
+    /// 40 characters, estimated at 10 tokens (14 with message overhead).
+    private func turn(_ letter: Character) -> String {
+        String(repeating: letter, count: 40)
+    }
+
+    @Test("Sliding window evicts the oldest turns and keeps the system prompt")
+    func slidingWindowEvictsOldestTurns() async throws {
+        let provider = MockTextProvider()
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.setSystemPrompt("System")
+        session.contextWindow = .slidingWindow(maxTokens: 40)
+
+        // system 5, each user turn 14, each "Mock response" 6
+        _ = try await session.send(turn("a"))
+        _ = try await session.send(turn("b"))
+        #expect(await provider.lastReceivedMessages.count == 4)
+
+        _ = try await session.send(turn("c"))
+        let received = await provider.lastReceivedMessages
+        #expect(received.map(\.content.textValue) == ["System", turn("b"), "Mock response", turn("c")])
+
+        #expect(session.messages.count == 7)
+        #expect(session.messages[1].metadata?.tokenCount == 10)
+    }
+
+    @Test("Summarizing window folds evicted turns into a pinned summary")
+    func summarizingWindow() async throws {
+        let provider = MockTextProvider()
+        let recorder = ContextWindowRecorder()
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.setSystemPrompt("System")
+        // Evicting the first turn leaves 44 tokens; the 5-token summary still fits
+        session.contextWindow = ContextWindowPolicy(maxTokens: 50, overflow: .summarize({ _, evicted in
+            await recorder.recordEvicted(evicted)
+            return .system("summary")
+        }))
+
+        for letter in ["a", "b", "c"] as [Character] {
+            _ = try await session.send(turn(letter))
+        }
+
+        let received = await provider.lastReceivedMessages
+        #expect(received.map(\.content.textValue) == ["System", "summary", turn("b"), "Mock response", turn("c")])
+        #expect(await recorder.evictedBatches.map { $0.map(\.content.textValue) } == [[turn("a"), "Mock response"]])
+        #expect(session.contextSummary?.content.textValue == "summary")
+    }
+
+    @Test("The current turn is sent even when it exceeds the budget")
+    func currentTurnAlwaysSent() async throws {
+        let provider = MockTextProvider()
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.contextWindow = .slidingWindow(maxTokens: 1)
+
+        _ = try await session.send(turn("a"))
+        _ = try await session.send(turn("b"))
+
+        let received = await provider.lastReceivedMessages
+        #expect(received.map(\.content.textValue) == [turn("b")])
+    }
+
+    @Test("Messages are counted once and generated counts are reused")
+    func messagesCountedOnce() async throws {
+        let provider = MockTextProvider()
+        let recorder = ContextWindowRecorder()
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.contextWindow = ContextWindowPolicy(maxTokens: 1_000, tokenCounter: { messages in
+            await recorder.recordCounted(messages)
+            return messages.map { $0.content.textValue.count }
+        })
+
+        _ = try await session.send("first")
+        _ = try await session.send("second")
+        _ = try await session.send("third")
+
+        // Assistant messages carry the generated token count, so only user messages are counted
+        #expect(await recorder.countedMessages.map(\.content.textValue) == ["first", "second", "third"])
+        #expect(session.messages[0].metadata?.tokenCount == 5)
+    }
+
+    @Test("Undo re-anchors the window on the edited history")
+    func undoReanchorsWindow() async throws {
+        let provider = MockTextProvider()
+        let session = try await ChatSession(provider: provider, model: .llama3_2_1b)
+        session.contextWindow = .slidingWindow(maxTokens: 1_000)
+
+        _ = try await session.send(turn("a"))
+        _ = try await session.send(turn("b"))
+        session.undoLastExchange()
+        _ = try await session.send(turn("c"))
+
+        let received = await provider.lastReceivedMessages
+        #expect(received.map(\.content.textValue) == [turn("a"), "Mock response", turn("c")])
+    }
 }
@@ -0,0 +1,136 @@
+// ConduitTransportTests.swift
+// Conduit Tests
+//
+// Tests for the shared HTTP transport: configuration, per-host queueing and gauges.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+@Suite("Conduit Transport Tests")
+struct ConduitTransportTests {
+
+    // MARK: - Configuration
+
+    @Test("Configuration clamps limits and maps to the session")
+    func configurationMapping() {
+        let configuration = ConduitTransport.Configuration(
+            maxConnectionsPerHost: 0,
+            maxConcurrentRequestsPerHost: -3,
+            requestTimeout: 15,
+            resourceTimeout: 90,
+            usesHTTPPipelining: true,
+            additionalHeaders: ["X-Test": "1"]
+        )
+        #expect(configuration.maxConnectionsPerHost == 1)
+        #expect(configuration.maxConcurrentRequestsPerHost == 1)
+
+        let session = configuration.makeSessionConfiguration()
+        #expect(session.httpMaximumConnectionsPerHost == 1)
+        #expect(session.timeoutIntervalForRequest == 15)
+        #expect(session.timeoutIntervalForResource == 90)
+        #expect(session.httpShouldUsePipelining)
+        #expect(session.httpAdditionalHeaders?["X-Test"] as? String == "1")
+    }
+
+    @Test("Proxy settings cover both schemes for HTTP proxies")
+    func proxyDictionary() {
+        let proxy = ConduitTransport.Proxy(host: "proxy.local", port: 3128)
+        #expect(proxy.dictionary["HTTPSProxy"] as? String == "proxy.local")
+        #expect(proxy.dictionary["HTTPPort"] as? Int == 3128)
+
+        let socks = ConduitTransport.Proxy(kind: .socks, host: "socks.local", port: 1080)
+        #expect(socks.dictionary["SOCKSProxy"] as? String == "socks.local")
+        #expect(socks.dictionary["HTTPProxy"] == nil)
+    }
+
+    @Test("Transports compare by identity and resolve to a shared instance")
+    func identity() {
+        let shared = ConduitTransport()
+        #expect(shared == shared)
+        #expect(shared != ConduitTransport())
+        #expect(ConduitTransport.resolve(shared, timeout: 30) === shared)
+
+        let dedicated = ConduitTransport.resolve(nil, timeout: 30)
+        #expect(dedicated.configuration.requestTimeout == 30)
+        #expect(dedicated.configuration.resourceTimeout == 60)
+    }
+
+    // MARK: - Per-Host Slots
+
+    @Test("Requests above the per-host limit queue in order")
+    func perHostQueueing() async throws {
+        let transport = ConduitTransport(configuration: .init(maxConcurrentRequestsPerHost: 1))
+        await transport.acquire("api.example.com")
+        await transport.acquire("other.example.com")
+
+        let order = OrderRecorder()
+        let first = Task {
+            await transport.acquire("api.example.com")
+            await order.append(1)
+        }
+        try await waitUntil { transport.metrics.queuedRequests == 1 }
+        let second = Task {
+            await transport.acquire("api.example.com")
+            await order.append(2)
+        }
+        try await waitUntil { transport.metrics.queuedRequests == 2 }
+
+        let metrics = transport.metrics
+        #expect(metrics.inFlightRequests == 2)
+        #expect(metrics.hosts["api.example.com"] == .init(inFlightRequests: 1, queuedRequests: 2))
+        #expect(metrics.hosts["other.example.com"] == .init(inFlightRequests: 1, queuedRequests: 0))
+
+        transport.release("api.example.com")
+        await first.value
+        transport.release("api.example.com")
+        await second.value
+        #expect(await order.values == [1, 2])
+
+        transport.release("api.example.com")
+        transport.release("other.example.com")
+        #expect(transport.metrics.inFlightRequests == 0)
+        #expect(transport.metrics.hosts.isEmpty)
+        #expect(transport.metrics.completedRequests == 4)
+    }
+
+    @Test("Unlimited transports never queue")
+    func unlimited() async {
+        let transport = ConduitTransport()
+        for _ in 0..<5 {
+            await transport.acquire("api.example.com")
+        }
+        #expect(transport.metrics.inFlightRequests == 5)
+        #expect(transport.metrics.queuedRequests == 0)
+    }
+
+    @Test("Streaming rejects non-HTTP URLs and frees the slot")
+    func streamingReleasesOnFailure() async {
+        let transport = ConduitTransport(configuration: .init(maxConcurrentRequestsPerHost: 1))
+        let request = URLRequest(url: URL(string: "file:///tmp/conduit")!)
+
+        await #expect(throws: URLError.self) {
+            _ = try await transport.asyncBytes(for: request)
+        }
+        #expect(transport.metrics.inFlightRequests == 0)
+    }
+
+    private func waitUntil(_ condition: () -> Bool) async throws {
+        for _ in 0..<200 where !condition() {
+            try await Task.sleep(for: .milliseconds(5))
+        }
+        #expect(condition())
+    }
+}
+
+private actor OrderRecorder {
+    private(set) var values: [Int] = []
+
+    func append(_ value: Int) {
+        values.append(value)
+    }
+}
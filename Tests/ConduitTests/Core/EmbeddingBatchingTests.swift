@@ -0,0 +1,160 @@
+// EmbeddingBatchingTests.swift
+// Conduit Tests
+//
+// Tests for contiguous embedding matrices, batch chunking and micro-batching.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+/// Embeds each text as `[length, index]` and records every batch it receives.
+private actor RecordingEmbeddingGenerator: EmbeddingGenerator {
+    typealias ModelID = TestModelID
+
+    private(set) var batches: [[String]] = []
+
+    func embed(_ text: String, model: TestModelID) async throws -> EmbeddingResult {
+        try await embedBatch([text], model: model)[0]
+    }
+
+    func embedBatch(_ texts: [String], model: TestModelID) async throws -> [EmbeddingResult] {
+        batches.append(texts)
+        return texts.enumerated().map { index, text in
+            EmbeddingResult(vector: [Float(text.count), Float(index)], text: text, model: model.rawValue)
+        }
+    }
+}
+
+@Suite("Embedding Batching Tests")
+struct EmbeddingBatchingTests {
+
+    // MARK: - EmbeddingMatrix
+
+    @Test("Matrix rows are views into contiguous storage")
+    func matrixRows() throws {
+        let matrix = EmbeddingMatrix(
+            storage: [1, 2, 3, 4, 5, 6],
+            dimensions: 3,
+            texts: ["a", "b"],
+            model: "m"
+        )
+
+        #expect(matrix.count == 2)
+        #expect(Array(matrix[1]) == [4, 5, 6])
+        #expect(matrix.result(at: 0) == EmbeddingResult(vector: [1, 2, 3], text: "a", model: "m"))
+        #expect(matrix.map { Array($0) } == [[1, 2, 3], [4, 5, 6]])
+    }
+
+    @Test("Matrix built from results rejects mixed dimensions")
+    func matrixFromResults() throws {
+        let results = [
+            EmbeddingResult(vector: [1, 2], text: "a", model: "m", tokenCount: 1),
+            EmbeddingResult(vector: [3, 4], text: "b", model: "m", tokenCount: 2),
+        ]
+        let matrix = try EmbeddingMatrix(results)
+        #expect(matrix.storage == [1, 2, 3, 4])
+        #expect(matrix.tokenCount == 3)
+        #expect(matrix.results.map(\.text) == ["a", "b"])
+
+        let mixed = results + [EmbeddingResult(vector: [5], text: "c", model: "m")]
+        #expect(throws: AIError.self) { try EmbeddingMatrix(mixed) }
+    }
+
+    // MARK: - Chunking
+
+    @Test("Chunks respect the input limit")
+    func chunksByInputCount() {
+        let policy = EmbeddingBatchPolicy(maxInputsPerRequest: 2)
+        #expect(policy.chunks(for: ["a", "b", "c", "d", "e"]) == [0..<2, 2..<4, 4..<5])
+        #expect(policy.chunks(for: []).isEmpty)
+    }
+
+    @Test("Chunks respect the token budget and keep oversized texts alone")
+    func chunksByTokenBudget() {
+        let policy = EmbeddingBatchPolicy(maxInputsPerRequest: 100, maxTokensPerRequest: 4)
+        let short = String(repeating: "x", count: 8)   // 2 tokens
+        let long = String(repeating: "x", count: 40)   // 10 tokens
+        #expect(policy.chunks(for: [short, short, short, long, short]) == [0..<2, 2..<3, 3..<4, 4..<5])
+    }
+
+    @Test("Chunked execution preserves order and limits concurrency")
+    func chunkedExecution() async throws {
+        let policy = EmbeddingBatchPolicy(maxInputsPerRequest: 2, maxConcurrentRequests: 2)
+        let texts = (0..<7).map { String(repeating: "x", count: $0 + 1) }
+
+        let tracker = ConcurrencyTracker()
+        let matrix = try await policy.embedMatrix(texts, model: "m") { inputs in
+            await tracker.enter()
+            try await Task.sleep(for: .milliseconds(10))
+            await tracker.exit()
+            return (inputs.map { [Float($0.count)] }, inputs.count)
+        }
+
+        #expect(matrix.storage == [1, 2, 3, 4, 5, 6, 7])
+        #expect(matrix.texts == texts)
+        #expect(matrix.tokenCount == 7)
+        #expect(await tracker.peak <= 2)
+    }
+
+    @Test("Chunked execution rejects a short response")
+    func chunkedExecutionCountMismatch() async {
+        let policy = EmbeddingBatchPolicy(maxInputsPerRequest: 4)
+        await #expect(throws: AIError.self) {
+            _ = try await policy.embedMatrix(["a", "b"], model: "m") { _ in ([[1]], nil) }
+        }
+    }
+
+    // MARK: - Micro-batching
+
+    @Test("Concurrent embed calls are merged into one batch")
+    func microBatchMerging() async throws {
+        let provider = RecordingEmbeddingGenerator()
+        let batcher = EmbeddingMicroBatcher(
+            provider: provider,
+            configuration: .init(maxLatency: .milliseconds(50), maxBatchSize: 8)
+        )
+
+        let texts = ["one", "three", "seven", "eight"]
+        let results = try await withThrowingTaskGroup(of: EmbeddingResult.self) { group in
+            for text in texts {
+                group.addTask { try await batcher.embed(text, model: .test) }
+            }
+            return try await group.reduce(into: [EmbeddingResult]()) { $0.append($1) }
+        }
+
+        #expect(await provider.batches.count == 1)
+        #expect(Set(results.map(\.text)) == Set(texts))
+        for result in results {
+            #expect(result.vector.first == Float(result.text.count))
+        }
+    }
+
+    @Test("A full batch is sent without waiting for the window")
+    func microBatchSizeLimit() async throws {
+        let provider = RecordingEmbeddingGenerator()
+        let batcher = EmbeddingMicroBatcher(
+            provider: provider,
+            configuration: .init(maxLatency: .seconds(60), maxBatchSize: 2)
+        )
+
+        async let first = batcher.embed("a", model: .test)
+        async let second = batcher.embed("b", model: .test)
+        _ = try await (first, second)
+
+        #expect(await provider.batches.map(\.count) == [2])
+    }
+}
+
+private actor ConcurrencyTracker {
+    private var active = 0
+    private(set) var peak = 0
+
+    func enter() {
+        active += 1
+        peak = max(peak, active)
+    }
+
+    func exit() {
+        active -= 1
+    }
+}
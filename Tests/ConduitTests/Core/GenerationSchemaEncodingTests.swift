@@ -0,0 +1,83 @@
+// GenerationSchemaEncodingTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Generable(description: "A cached schema fixture")
+private struct EncodingFixture {
+    @Guide(description: "Title", .pattern("^[a-z/]+$"))
+    let title: String
+
+    @Guide(description: "Rating", .range(1...5))
+    let rating: Int
+
+    let tags: [String]?
+}
+
+@Suite("GenerationSchema Encodings")
+struct GenerationSchemaEncodingTests {
+
+    @Test("Macro-generated schemas are built once per type")
+    func macroSchemaIsShared() {
+        let first = EncodingFixture.generationSchema
+        let second = EncodingFixture.generationSchema
+        #expect(first.encodings === second.encodings)
+    }
+
+    @Test("Encoded forms are computed once and shared by copies")
+    func encodingsAreMemoized() {
+        let schema = EncodingFixture.generationSchema
+        let copy = schema
+
+        let data = schema.canonicalJSONData
+        #expect(copy.canonicalJSONData == data)
+        #expect(copy.encodings === schema.encodings)
+        #expect(schema.resolvedForProviders().encodings === copy.resolvedForProviders().encodings)
+    }
+
+    @Test("Resolving a schema does not keep it alive")
+    func resolvedSchemasAreReleased() throws {
+        let inline = #"{"type":"object","properties":{"name":{"type":"string"}},"required":["name"]}"#
+        let referenced = ##"{"$ref":"#/$defs/City","$defs":{"City":\##(inline)}}"##
+
+        for json in [inline, referenced] {
+            weak var box: GenerationSchemaEncodings?
+            do {
+                let schema = try JSONDecoder().decode(GenerationSchema.self, from: Data(json.utf8))
+                box = schema.encodings
+                _ = schema.resolvedForProviders().toJSONSchema()
+                #expect(box != nil)
+            }
+            #expect(box == nil)
+        }
+    }
+
+    @Test("Canonical JSON is compact with sorted keys")
+    func canonicalJSON() throws {
+        let schema = EncodingFixture.generationSchema
+
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.sortedKeys]
+        let expected = String(decoding: try encoder.encode(schema), as: UTF8.self)
+
+        #expect(schema.canonicalJSONString == expected)
+        #expect(schema.toJSONString(prettyPrinted: false) == expected)
+        #expect(!expected.contains("\n"))
+        #expect(schema.toJSONString(prettyPrinted: true).contains("\n"))
+    }
+
+    @Test("Dictionary and resolved forms match fresh encodings")
+    func providerForms() throws {
+        let schema = EncodingFixture.generationSchema
+
+        let fresh = try JSONSerialization.jsonObject(with: JSONEncoder().encode(schema)) as? NSDictionary
+        #expect(NSDictionary(dictionary: schema.toJSONSchema()) == fresh)
+
+        let resolved = schema.resolvedForProviders().toJSONSchema()
+        #expect(resolved["$ref"] == nil)
+        #expect((resolved["properties"] as? [String: Any])?.keys.sorted() == ["rating", "tags", "title"])
+        #expect(resolved["required"] as? [String] == ["rating", "title"])
+    }
+}
@@ -0,0 +1,95 @@
+// MediaCacheTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("MediaCache")
+struct MediaCacheTests {
+
+    private let image = Message.ImageContent(base64Data: "iVBORw0KGgo=", mimeType: "image/png")
+
+    @Test("Prepared payloads are built once per image")
+    func preparedPayloadsAreMemoized() {
+        let cache = MediaCache()
+
+        let first = cache.prepared(image)
+        let second = cache.prepared(Message.ImageContent(base64Data: image.base64Data, mimeType: image.mimeType))
+
+        #expect(first == second)
+        #expect(first.base64Data == image.base64Data)
+        #expect(first.dataURL == "data:image/png;base64,iVBORw0KGgo=")
+        #expect(cache.metrics.misses == 1)
+        #expect(cache.metrics.hits == 1)
+        #expect(cache.metrics.memoryEntries == 1)
+    }
+
+    @Test("Keys cover the MIME type and the data")
+    func keys() {
+        let cache = MediaCache()
+        let key = cache.key(for: image)
+
+        #expect(key.digest.count == 64)
+        #expect(key == cache.key(for: image))
+        #expect(key != cache.key(for: Message.ImageContent(base64Data: image.base64Data, mimeType: "image/jpeg")))
+        #expect(key != cache.key(for: Message.ImageContent(base64Data: "AAAA", mimeType: image.mimeType)))
+    }
+
+    @Test("Memoized keys are not reused for data that only shares a fingerprint")
+    func memoizedKeysCheckTheData() {
+        let cache = MediaCache()
+        // Same length, ends and sampled bytes; only an unsampled byte differs
+        let base = String(repeating: "A", count: 200)
+        var changed = Array(base.utf8)
+        changed[100] = UInt8(ascii: "B")
+        let original = Message.ImageContent(base64Data: base, mimeType: "image/png")
+        let edited = Message.ImageContent(base64Data: String(decoding: changed, as: UTF8.self), mimeType: "image/png")
+
+        let key = cache.key(for: original)
+        #expect(cache.key(for: original) == key)
+        #expect(cache.key(for: edited) != key)
+        #expect(cache.key(for: edited) == MediaCache().key(for: edited))
+    }
+
+    @Test("File references are stored per service")
+    func fileReferences() {
+        let cache = MediaCache()
+        let key = cache.key(for: image)
+
+        cache.setFileReference("file_1", for: image, service: .anthropic)
+        #expect(cache.fileReference(for: key, service: .anthropic) == "file_1")
+        #expect(cache.fileReference(for: key, service: .openAI) == nil)
+        #expect(cache.metrics.fileReferenceHits == 1)
+
+        cache.setFileReference(nil, for: key, service: .anthropic)
+        #expect(cache.fileReference(for: key, service: .anthropic) == nil)
+    }
+
+    @Test("Least recently used payloads are evicted past the entry limit")
+    func eviction() {
+        let cache = MediaCache(configuration: .init(maxEntries: 2))
+        let images = ["AAAA", "BBBB", "CCCC"].map { Message.ImageContent(base64Data: $0) }
+
+        _ = cache.prepared(images[0])
+        _ = cache.prepared(images[1])
+        _ = cache.prepared(images[0])
+        _ = cache.prepared(images[2])
+
+        #expect(cache.metrics.memoryEntries == 2)
+        #expect(cache.metrics.evictions == 1)
+
+        _ = cache.prepared(images[0])
+        #expect(cache.metrics.hits == 2)
+    }
+
+    @Test("Images that cannot be decoded are sent as supplied")
+    func undecodableImagesPassThrough() {
+        let cache = MediaCache(configuration: .init(maxPixelDimension: 16))
+        let prepared = cache.prepared(image)
+
+        #expect(prepared.base64Data == image.base64Data)
+        #expect(prepared.mimeType == image.mimeType)
+        #expect(cache.metrics.downscaledImages == 0)
+    }
+}
@@ -0,0 +1,234 @@
+// RangedDownloaderTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("RangedDownloader")
+struct RangedDownloaderTests {
+
+    // MARK: - Helpers
+
+    private let contents = Data("The quick brown fox jumps over the lazy dog".utf8)
+
+    private func makeDirectory() throws -> URL {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("RangedDownloaderTests-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    private func makeState(segmentSize: Int = 8) -> RangedDownloadState {
+        RangedDownloadState(
+            url: URL(string: "https://example.com/model.safetensors")!,
+            size: Int64(contents.count),
+            etag: "\"abc\"",
+            segmentSize: segmentSize
+        )
+    }
+
+    private func segment(_ index: Int, of state: RangedDownloadState) -> Data {
+        let range = state.range(ofSegment: index)
+        return contents.subdata(in: Int(range.lowerBound)..<Int(range.upperBound))
+    }
+
+    // MARK: - Content-Range
+
+    @Test("Content-Range values are parsed")
+    func contentRange() {
+        let parsed = RangedDownloader.parseContentRange("bytes 0-99/1000")
+        #expect(parsed?.range == 0..<100)
+        #expect(parsed?.total == 1000)
+
+        #expect(RangedDownloader.parseContentRange("bytes */1000")?.range == nil)
+        #expect(RangedDownloader.parseContentRange("bytes */1000")?.total == 1000)
+        #expect(RangedDownloader.parseContentRange("bytes 5-9/*")?.total == nil)
+        #expect(RangedDownloader.parseContentRange("bytes 9-5/10") == nil)
+        #expect(RangedDownloader.parseContentRange("items 0-1/2") == nil)
+    }
+
+    // MARK: - Segments
+
+    @Test("Files are split into fixed-size segments")
+    func segments() {
+        var state = makeState()
+        #expect(state.segmentCount == 6)
+        #expect(state.range(ofSegment: 0) == 0..<8)
+        #expect(state.range(ofSegment: 5) == 40..<43)
+
+        state.completed = [0, 1, 3]
+        #expect(state.firstMissingSegment == 2)
+        #expect(state.completedBytes == 24)
+    }
+
+    // MARK: - Assembly
+
+    @Test("Out-of-order segments are hashed in file order without reading back")
+    func hashesWhileAssembling() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let partial = directory.appendingPathComponent("model.partial")
+        let state = makeState()
+
+        let assembler = try RangedFileAssembler(
+            partialURL: partial,
+            stateURL: directory.appendingPathComponent("model.partial.json"),
+            state: state,
+            bufferLimit: 1024
+        )
+        for index in [3, 1, 0, 5, 2, 4] {
+            try assembler.store(segment(index, of: state), forSegment: index)
+        }
+
+        #expect(try assembler.finish() == SHA256Digest.hex(of: contents))
+        #expect(assembler.bytesReadBack == 0)
+        #expect(try Data(contentsOf: partial) == contents)
+    }
+
+    @Test("Segments beyond the hash buffer are read back from disk")
+    func readsBackPastBufferLimit() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let state = makeState()
+
+        let assembler = try RangedFileAssembler(
+            partialURL: directory.appendingPathComponent("model.partial"),
+            stateURL: directory.appendingPathComponent("model.partial.json"),
+            state: state,
+            bufferLimit: 0
+        )
+        for index in [1, 0, 2, 3, 5, 4] {
+            try assembler.store(segment(index, of: state), forSegment: index)
+        }
+
+        #expect(try assembler.finish() == SHA256Digest.hex(of: contents))
+        #expect(assembler.bytesReadBack == 11)
+    }
+
+    @Test("A partial file resumes from the segments recorded in its sidecar")
+    func resumesFromSidecar() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let partial = directory.appendingPathComponent("model.partial")
+        let sidecar = directory.appendingPathComponent("model.partial.json")
+        let state = makeState()
+
+        // First run stops after three segments
+        do {
+            let assembler = try RangedFileAssembler(
+                partialURL: partial,
+                stateURL: sidecar,
+                state: state,
+                bufferLimit: 1024
+            )
+            for index in [0, 1, 4] {
+                try assembler.store(segment(index, of: state), forSegment: index)
+            }
+            assembler.close()
+        }
+
+        let saved = try #require(RangedDownloadState.load(from: sidecar))
+        #expect(saved.completed == [0, 1, 4])
+        #expect(saved.firstMissingSegment == 2)
+
+        let resumed = try RangedFileAssembler(partialURL: partial, stateURL: sidecar, state: saved, bufferLimit: 1024)
+        #expect(resumed.isCompleted(4))
+        for index in [2, 3, 5] {
+            try resumed.store(segment(index, of: saved), forSegment: index)
+        }
+
+        #expect(try resumed.finish() == SHA256Digest.hex(of: contents))
+        #expect(resumed.bytesReadBack == saved.completedBytes)
+        #expect(try Data(contentsOf: partial) == contents)
+    }
+
+    @Test("Finishing with a missing segment fails")
+    func missingSegmentFails() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let state = makeState()
+
+        let assembler = try RangedFileAssembler(
+            partialURL: directory.appendingPathComponent("model.partial"),
+            stateURL: directory.appendingPathComponent("model.partial.json"),
+            state: state,
+            bufferLimit: 1024
+        )
+        try assembler.store(segment(0, of: state), forSegment: 0)
+        #expect(throws: AIError.self) { try assembler.finish() }
+    }
+
+    // MARK: - Snapshots
+
+    @Test("Snapshot patterns match by path or file name")
+    func snapshotPatterns() {
+        let patterns = ["*.safetensors", "tokenizer*"]
+        #expect(HFSnapshotDownloader.matches("model-00001-of-00002.safetensors", patterns: patterns))
+        #expect(HFSnapshotDownloader.matches("text_encoder/model.safetensors", patterns: patterns))
+        #expect(HFSnapshotDownloader.matches("tokenizer/tokenizer.json", patterns: patterns))
+        #expect(!HFSnapshotDownloader.matches("README.md", patterns: patterns))
+    }
+
+    @Test("Snapshot manifests record files on disk")
+    func snapshotManifest() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        try contents.write(to: directory.appendingPathComponent("config.json"))
+
+        let entry = HFSnapshotDownloader.Manifest.Entry(
+            oid: "1234",
+            size: Int64(contents.count),
+            sha256: SHA256Digest.hex(of: contents)
+        )
+        let manifest = HFSnapshotDownloader.Manifest(
+            revision: "main",
+            patterns: ["*.json"],
+            files: ["config.json": entry]
+        )
+        try manifest.save(to: directory)
+
+        let loaded = try #require(HFSnapshotDownloader.Manifest.load(from: directory))
+        #expect(loaded == manifest)
+        #expect(loaded.isComplete(in: directory))
+
+        try Data("short".utf8).write(to: directory.appendingPathComponent("config.json"))
+        #expect(!loaded.isComplete(in: directory))
+    }
+
+    @Test("Files already in the Hub cache are linked instead of downloaded")
+    func hubCacheAdoption() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let digest = SHA256Digest.hex(of: contents)
+        let blobs = directory.appendingPathComponent("hub/models--org--model/blobs", isDirectory: true)
+        try FileManager.default.createDirectory(at: blobs, withIntermediateDirectories: true)
+        try contents.write(to: blobs.appendingPathComponent(digest))
+
+        let snapshots = HFSnapshotDownloader(hubCache: directory.appendingPathComponent("hub", isDirectory: true))
+        let destination = directory.appendingPathComponent("snapshot/model.safetensors")
+        let weights = HFMetadataService.RepoFile(
+            path: "model.safetensors",
+            type: "file",
+            size: nil,
+            lfs: .init(size: Int64(contents.count), oid: "sha256:\(digest)"),
+            oid: "1234"
+        )
+
+        let entry = try #require(snapshots.adoptFromHubCache(weights, repoId: "org/model", to: destination))
+        #expect(entry.sha256 == digest)
+        #expect(entry.isOnDisk(at: destination))
+        #expect(try Data(contentsOf: destination) == contents)
+
+        // A blob of the wrong size is not the requested file
+        let larger = HFMetadataService.RepoFile(
+            path: "model.safetensors",
+            type: "file",
+            size: nil,
+            lfs: .init(size: Int64(contents.count + 1), oid: digest),
+            oid: "1234"
+        )
+        #expect(snapshots.adoptFromHubCache(larger, repoId: "org/model", to: destination) == nil)
+        #expect(snapshots.adoptFromHubCache(weights, repoId: "org/other", to: destination) == nil)
+    }
+}
@@ -0,0 +1,57 @@
+// RasterImageTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("RasterImage")
+struct RasterImageTests {
+
+    /// A 2x2 image: red, green / blue, white.
+    private let pixels = Data([
+        255, 0, 0, 0, 255, 0,
+        0, 0, 255, 255, 255, 255,
+    ])
+
+    @Test("Rows default to tightly packed RGB")
+    func defaultStride() {
+        let raster = RasterImage(width: 2, height: 2, pixels: pixels)
+        #expect(raster.bytesPerRow == 6)
+        #expect(raster.pixels == pixels)
+    }
+
+    @Test("Padded rows keep their stride")
+    func paddedStride() {
+        var padded = Data()
+        padded.append(pixels.prefix(6))
+        padded.append(contentsOf: [0, 0])
+        padded.append(pixels.suffix(6))
+        padded.append(contentsOf: [0, 0])
+
+        let raster = RasterImage(width: 2, height: 2, bytesPerRow: 8, pixels: padded)
+        #expect(raster.bytesPerRow == 8)
+        #expect(raster.pixels.count == 16)
+    }
+
+    #if canImport(ImageIO) && canImport(CoreGraphics)
+    @Test("Pixels are wrapped as a CGImage and encoded as PNG")
+    func encodesPNG() throws {
+        let raster = RasterImage(width: 2, height: 2, pixels: pixels)
+
+        let cgImage = try #require(raster.cgImage)
+        #expect(cgImage.width == 2)
+        #expect(cgImage.height == 2)
+
+        let image = try raster.generatedImage()
+        #expect(image.format == .png)
+        #expect(image.data.prefix(4) == Data([0x89, 0x50, 0x4E, 0x47]))
+    }
+    #else
+    @Test("PNG encoding is unavailable without ImageIO")
+    func encodingUnavailable() {
+        let raster = RasterImage(width: 2, height: 2, pixels: pixels)
+        #expect(throws: GeneratedImageError.self) { try raster.pngData() }
+    }
+    #endif
+}
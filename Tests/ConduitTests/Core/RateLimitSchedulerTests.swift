@@ -0,0 +1,161 @@
+// RateLimitSchedulerTests.swift
+// Conduit Tests
+//
+// Tests for header-driven request pacing and rate-limit header parsing.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("Rate Limit Scheduler Tests")
+struct RateLimitSchedulerTests {
+
+    // MARK: - Header Parsing
+
+    @Test("OpenAI-style headers fill in limits and reset durations")
+    func openAIHeaders() {
+        let before = Date()
+        let info = RateLimitInfo(headers: [
+            "X-RateLimit-Limit-Requests": "500",
+            "x-ratelimit-remaining-requests": "499",
+            "x-ratelimit-limit-tokens": "30000",
+            "x-ratelimit-remaining-tokens": "29000",
+            "x-ratelimit-reset-requests": "120ms",
+            "x-ratelimit-reset-tokens": "1m30s",
+            "x-request-id": "req_123",
+        ])
+
+        #expect(info.limitRequests == 500)
+        #expect(info.remainingRequests == 499)
+        #expect(info.remainingTokens == 29000)
+        #expect(info.requestId == "req_123")
+        let tokenReset = info.resetTokens?.timeIntervalSince(before) ?? 0
+        #expect(tokenReset >= 89 && tokenReset <= 91)
+    }
+
+    @Test("Durations parse Go-style units")
+    func durations() {
+        #expect(RateLimitInfo.parseDuration("1s") == 1)
+        #expect(RateLimitInfo.parseDuration("20ms") == 0.02)
+        #expect(RateLimitInfo.parseDuration("6m0.5s") == 360.5)
+        #expect(RateLimitInfo.parseDuration("1h2m") == 3720)
+        #expect(RateLimitInfo.parseDuration("2.5") == 2.5)
+        #expect(RateLimitInfo.parseDuration("5x") == nil)
+        #expect(RateLimitInfo.parseDuration("10") == 10)
+    }
+
+    // MARK: - Scheduling
+
+    @Test("Requests pass straight through before any limit is known")
+    func unknownLimits() async throws {
+        let scheduler = RateLimitScheduler()
+        let first = try await scheduler.acquire("gpt-4o", estimatedTokens: 1_000_000)
+        _ = try await scheduler.acquire("gpt-4o")
+
+        let status = await scheduler.status(for: "gpt-4o")
+        #expect(status.remainingRequests == nil)
+        #expect(status.inFlightRequests == 2)
+
+        await scheduler.complete(first, rateLimitInfo: nil, statusCode: 200)
+        #expect(await scheduler.status(for: "gpt-4o").inFlightRequests == 1)
+    }
+
+    @Test("An exhausted budget holds requests until it refills")
+    func waitsForRefill() async throws {
+        let scheduler = RateLimitScheduler()
+        let permit = try await scheduler.acquire("model")
+        await scheduler.complete(
+            permit,
+            rateLimitInfo: RateLimitInfo(limitRequests: 10, remainingRequests: 0, resetRequests: Date() + 0.2),
+            statusCode: 200
+        )
+        #expect(await scheduler.status(for: "model").remainingRequests == 0)
+
+        let start = ContinuousClock.now
+        _ = try await scheduler.acquire("model")
+        #expect(ContinuousClock.now - start >= .milliseconds(10))
+    }
+
+    @Test("A 429 pauses every request for the key")
+    func pausesAfterTooManyRequests() async throws {
+        let scheduler = RateLimitScheduler()
+        let permit = try await scheduler.acquire("model")
+        await scheduler.complete(permit, rateLimitInfo: RateLimitInfo(retryAfter: 0.1), statusCode: 429)
+        #expect(await scheduler.status(for: "model").isPaused)
+
+        let start = ContinuousClock.now
+        _ = try await scheduler.acquire("other")
+        #expect(ContinuousClock.now - start < .milliseconds(50))
+
+        _ = try await scheduler.acquire("model")
+        #expect(ContinuousClock.now - start >= .milliseconds(70))
+    }
+
+    @Test("Batch requests leave the interactive reserve")
+    func interactiveReserve() async throws {
+        let scheduler = RateLimitScheduler(configuration: .init(interactiveReserve: 0.1))
+        let permit = try await scheduler.acquire("model")
+        await scheduler.complete(
+            permit,
+            rateLimitInfo: RateLimitInfo(limitRequests: 10, remainingRequests: 1, resetRequests: Date() + 60),
+            statusCode: 200
+        )
+
+        let batch = Task {
+            try await scheduler.acquire("model", priority: .batch)
+        }
+        try await waitUntil { await scheduler.status(for: "model").queuedRequests == 1 }
+
+        // The last request in the bucket is kept for interactive work
+        _ = try await scheduler.acquire("model", priority: .interactive)
+        #expect(await scheduler.status(for: "model").queuedRequests == 1)
+
+        batch.cancel()
+        await #expect(throws: CancellationError.self) { try await batch.value }
+        #expect(await scheduler.status(for: "model").queuedRequests == 0)
+    }
+
+    @Test("Queued interactive requests go ahead of earlier batch requests")
+    func priorityOrder() async throws {
+        let scheduler = RateLimitScheduler(configuration: .init(interactiveReserve: 0))
+        let permit = try await scheduler.acquire("model")
+        await scheduler.complete(
+            permit,
+            rateLimitInfo: RateLimitInfo(limitRequests: 4, remainingRequests: 0, resetRequests: Date() + 0.4),
+            statusCode: 200
+        )
+
+        let order = PriorityRecorder()
+        let batch = Task {
+            _ = try await scheduler.acquire("model", priority: .batch)
+            await order.append(.batch)
+        }
+        try await waitUntil { await scheduler.status(for: "model").queuedRequests == 1 }
+        let interactive = Task {
+            _ = try await RateLimitScheduler.$priority.withValue(.interactive) {
+                try await scheduler.acquire("model")
+            }
+            await order.append(.interactive)
+        }
+
+        try await batch.value
+        try await interactive.value
+        #expect(await order.values == [.interactive, .batch])
+    }
+
+    private func waitUntil(_ condition: () async -> Bool) async throws {
+        for _ in 0..<200 {
+            if await condition() { return }
+            try await Task.sleep(for: .milliseconds(5))
+        }
+        #expect(await condition())
+    }
+}
+
+private actor PriorityRecorder {
+    private(set) var values: [RateLimitScheduler.Priority] = []
+
+    func append(_ value: RateLimitScheduler.Priority) {
+        values.append(value)
+    }
+}
@@ -0,0 +1,303 @@
+// ResponseCacheTests.swift
+// Conduit Tests
+//
+// Tests for content-addressed response caching, coalescing and replay.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+/// Answers every prompt with `"echo: <last message>"` and counts upstream calls.
+private actor CountingGenerator: TextGenerator, EmbeddingGenerator {
+    typealias ModelID = ModelIdentifier
+
+    private let delay: Duration
+    private(set) var generateCalls = 0
+    private(set) var streamCalls = 0
+    private(set) var embeddedTexts: [String] = []
+
+    init(delay: Duration = .zero) {
+        self.delay = delay
+    }
+
+    func generate(_ prompt: String, model: ModelIdentifier, config: GenerateConfig) async throws -> String {
+        try await generate(messages: [.user(prompt)], model: model, config: config).text
+    }
+
+    func generate(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async throws -> GenerationResult {
+        generateCalls += 1
+        try await Task.sleep(for: delay)
+        return GenerationResult(
+            text: Self.reply(to: messages),
+            tokenCount: 2,
+            generationTime: 0.1,
+            tokensPerSecond: 20,
+            finishReason: .stop
+        )
+    }
+
+    nonisolated func stream(
+        _ prompt: String,
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<String, Error> {
+        AsyncThrowingStream { $0.finish() }
+    }
+
+    nonisolated func streamWithMetadata(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        let words = Self.reply(to: messages).split(separator: " ").map(String.init)
+        let delay = delay
+        return AsyncThrowingStream { continuation in
+            Task {
+                await self.recordStream()
+                try? await Task.sleep(for: delay)
+                for (index, word) in words.enumerated() {
+                    continuation.yield(GenerationChunk(text: index == 0 ? word : " " + word))
+                }
+                continuation.yield(GenerationChunk(text: "", tokenCount: 0, isComplete: true, finishReason: .stop))
+                continuation.finish()
+            }
+        }
+    }
+
+    func embed(_ text: String, model: ModelIdentifier) async throws -> EmbeddingResult {
+        try await embedBatch([text], model: model)[0]
+    }
+
+    func embedBatch(_ texts: [String], model: ModelIdentifier) async throws -> [EmbeddingResult] {
+        embeddedTexts += texts
+        return texts.map { EmbeddingResult(vector: [Float($0.count), 0.5], text: $0, model: model.rawValue) }
+    }
+
+    private func recordStream() {
+        streamCalls += 1
+    }
+
+    private static func reply(to messages: [Message]) -> String {
+        "echo: \(messages.last?.content.textValue ?? "")"
+    }
+}
+
+@Suite("Response Cache Tests")
+struct ResponseCacheTests {
+
+    private let model = ModelIdentifier.openAI("gpt-4o")
+    private let deterministic = GenerateConfig.default.temperature(0)
+
+    // MARK: - Keys
+
+    @Test("SHA-256 digests match published test vectors")
+    func digest() {
+        #expect(SHA256Digest.hex(of: Data()) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")
+
+        var digest = SHA256Digest()
+        digest.update("a")
+        digest.update("bc")
+        #expect(digest.finalize() == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")
+    }
+
+    @Test("Keys depend on content, model and config but not message identity")
+    func keys() throws {
+        let cache = ResponseCache()
+        let first = try #require(cache.key(messages: [.user("Hi")], model: model, config: deterministic))
+        let second = try #require(cache.key(messages: [.user("Hi")], model: model, config: deterministic))
+        #expect(first == second)
+        #expect(first.digest.count == 64)
+
+        #expect(cache.key(messages: [.user("Hello")], model: model, config: deterministic) != first)
+        #expect(cache.key(messages: [.user("Hi")], model: .openAI("gpt-4.1"), config: deterministic) != first)
+        #expect(cache.key(messages: [.user("Hi")], model: model, config: deterministic.maxTokens(10)) != first)
+
+        // Sampled generations are not cached unless a seed pins them
+        let sampled = GenerateConfig.default.temperature(0.7)
+        #expect(cache.key(messages: [.user("Hi")], model: model, config: sampled) == nil)
+        #expect(cache.key(messages: [.user("Hi")], model: model, config: sampled.seed(42)) != nil)
+    }
+
+    // MARK: - Generation
+
+    @Test("Repeated deterministic requests are served from memory")
+    func generationHits() async throws {
+        let base = CountingGenerator()
+        let cached = CachedTextGenerator(base)
+
+        let first = try await cached.generate("Hi", model: model, config: deterministic)
+        let second = try await cached.generate("Hi", model: model, config: deterministic)
+        #expect(first == "echo: Hi")
+        #expect(second == first)
+        #expect(await base.generateCalls == 1)
+
+        let metrics = await cached.cache.metrics
+        #expect(metrics.hits == 1)
+        #expect(metrics.misses == 1)
+        #expect(metrics.memoryEntries == 1)
+        #expect(metrics.memoryBytes > 0)
+
+        _ = try await cached.generate("Hi", model: model, config: .default.temperature(0.8))
+        #expect(await base.generateCalls == 2)
+    }
+
+    @Test("Identical in-flight requests share one upstream call")
+    func coalescing() async throws {
+        let base = CountingGenerator(delay: .milliseconds(50))
+        let cached = CachedTextGenerator(base)
+        let config = deterministic
+
+        async let first = cached.generate("Hi", model: model, config: config)
+        async let second = cached.generate("Hi", model: model, config: config)
+        let results = try await [first, second]
+
+        #expect(results == ["echo: Hi", "echo: Hi"])
+        #expect(await base.generateCalls == 1)
+        #expect(await cached.cache.metrics.coalescedRequests == 1)
+    }
+
+    @Test("Cached results replay as a chunk stream")
+    func streamingReplay() async throws {
+        let base = CountingGenerator()
+        let cached = CachedTextGenerator(base)
+        _ = try await cached.generate("Hi", model: model, config: deterministic)
+
+        var chunks: [GenerationChunk] = []
+        for try await chunk in cached.streamWithMetadata(messages: [.user("Hi")], model: model, config: deterministic) {
+            chunks.append(chunk)
+        }
+
+        #expect(chunks.map(\.text).joined() == "echo: Hi")
+        #expect(chunks.last?.isComplete == true)
+        #expect(chunks.last?.finishReason == .stop)
+        #expect(await base.streamCalls == 0)
+    }
+
+    @Test("Completed streams are stored for later requests")
+    func streamingMissIsStored() async throws {
+        let base = CountingGenerator()
+        let cached = CachedTextGenerator(base)
+
+        var text = ""
+        for try await piece in cached.stream("Hi", model: model, config: deterministic) {
+            text += piece
+        }
+        #expect(text == "echo: Hi")
+
+        let result = try await cached.generate(messages: [.user("Hi")], model: model, config: deterministic)
+        #expect(result.text == "echo: Hi")
+        #expect(result.finishReason == .stop)
+        #expect(await base.generateCalls == 0)
+        #expect(await base.streamCalls == 1)
+    }
+
+    @Test("Identical in-flight streams share one upstream stream")
+    func streamCoalescing() async throws {
+        let base = CountingGenerator(delay: .milliseconds(50))
+        let cached = CachedTextGenerator(base)
+        let model = model, config = deterministic
+
+        @Sendable func collect() async throws -> String {
+            var text = ""
+            for try await piece in cached.stream("Hi", model: model, config: config) {
+                text += piece
+            }
+            return text
+        }
+
+        async let first = collect()
+        async let second = collect()
+        let results = try await [first, second]
+
+        #expect(results == ["echo: Hi", "echo: Hi"])
+        #expect(await base.streamCalls == 1)
+        #expect(await cached.cache.metrics.coalescedRequests == 1)
+
+        // Once the shared stream has ended, a new request is a cache hit
+        _ = try await collect()
+        #expect(await base.streamCalls == 1)
+        #expect(await cached.cache.metrics.hits == 1)
+    }
+
+    // MARK: - Storage
+
+    @Test("Least recently used responses are evicted first")
+    func lruEviction() async throws {
+        let base = CountingGenerator()
+        let cached = CachedTextGenerator(base, cache: ResponseCache(configuration: .init(maxEntries: 2)))
+
+        _ = try await cached.generate("a", model: model, config: deterministic)
+        _ = try await cached.generate("b", model: model, config: deterministic)
+        _ = try await cached.generate("a", model: model, config: deterministic)
+        _ = try await cached.generate("c", model: model, config: deterministic)
+        #expect(await base.generateCalls == 3)
+        #expect(await cached.cache.metrics.evictions == 1)
+
+        // "b" was least recently used, so "a" is still cached
+        _ = try await cached.generate("a", model: model, config: deterministic)
+        #expect(await base.generateCalls == 3)
+        _ = try await cached.generate("b", model: model, config: deterministic)
+        #expect(await base.generateCalls == 4)
+    }
+
+    @Test("The disk store survives a new cache instance")
+    func diskPersistence() async throws {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("conduit-response-cache-\(UUID().uuidString)")
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let configuration = ResponseCache.Configuration.persistent(at: directory)
+        let writer = CachedTextGenerator(CountingGenerator(), cache: ResponseCache(configuration: configuration))
+        _ = try await writer.generate("Hi", model: model, config: deterministic)
+        #expect(await writer.cache.metrics.diskBytes > 0)
+
+        let base = CountingGenerator()
+        let reader = CachedTextGenerator(base, cache: ResponseCache(configuration: configuration))
+        let text = try await reader.generate("Hi", model: model, config: deterministic)
+        #expect(text == "echo: Hi")
+        #expect(await base.generateCalls == 0)
+        #expect(await reader.cache.metrics.hits == 1)
+    }
+
+    @Test("Clearing the cache keeps unrelated files in its directory")
+    func removeAllKeepsForeignFiles() async throws {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("conduit-response-cache-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let foreign = directory.appendingPathComponent("settings.json")
+        try Data("{}".utf8).write(to: foreign)
+
+        let cache = ResponseCache(configuration: .persistent(at: directory))
+        let generator = CachedTextGenerator(CountingGenerator(), cache: cache)
+        _ = try await generator.generate("Hi", model: model, config: deterministic)
+        #expect(await cache.metrics.diskBytes > 0)
+
+        await cache.removeAll()
+        #expect(await cache.metrics.diskBytes == 0)
+        #expect(FileManager.default.fileExists(atPath: foreign.path))
+        let remaining = try FileManager.default.contentsOfDirectory(atPath: directory.path)
+        #expect(remaining == ["settings.json"])
+    }
+
+    // MARK: - Embeddings
+
+    @Test("Batch embeddings only send uncached texts")
+    func embeddingBatches() async throws {
+        let base = CountingGenerator()
+        let embedder = CachedEmbeddingGenerator(base)
+
+        let single = try await embedder.embed("alpha", model: model)
+        let batch = try await embedder.embedBatch(["alpha", "beta", "gamma"], model: model)
+
+        #expect(batch.map(\.text) == ["alpha", "beta", "gamma"])
+        #expect(batch[0] == single)
+        #expect(batch[1].vector == [4, 0.5])
+        #expect(await base.embeddedTexts == ["alpha", "beta", "gamma"])
+        #expect(await embedder.cache.metrics.hits == 1)
+    }
+}
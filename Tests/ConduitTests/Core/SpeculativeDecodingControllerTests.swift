@@ -0,0 +1,154 @@
+// SpeculativeDecodingControllerTests.swift
+// Conduit Tests
+//
+// Tests for speculative decoding draft sizing, verification and auto-disable.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("SpeculativeDecodingController Tests")
+struct SpeculativeDecodingControllerTests {
+
+    private func makeController(
+        _ configuration: ProviderRuntimeFeatureConfiguration.SpeculativeScheduling = .init(enabled: true),
+        maximumDraftAheadTokens: Int = 16,
+        maximumBatchTokens: Int = 512
+    ) -> SpeculativeDecodingController {
+        SpeculativeDecodingController(
+            configuration: configuration,
+            maximumDraftAheadTokens: maximumDraftAheadTokens,
+            maximumBatchTokens: maximumBatchTokens
+        )
+    }
+
+    // MARK: - Verification
+
+    @Test("Fully accepted draft emits a bonus token")
+    func fullyAcceptedDraft() {
+        var sampled: [Int] = []
+        let emitted = SpeculativeDecodingController.verify(draft: [1, 2, 3]) { position in
+            sampled.append(position)
+            return [1, 2, 3, 4][position]
+        }
+
+        #expect(emitted == [1, 2, 3, 4])
+        #expect(sampled == [0, 1, 2, 3])
+    }
+
+    @Test("Verification stops at the first mismatch with the target's token")
+    func rejectedDraft() {
+        var sampled: [Int] = []
+        let emitted = SpeculativeDecodingController.verify(draft: [1, 2, 3]) { position in
+            sampled.append(position)
+            return [1, 9, 3, 4][position]
+        }
+
+        #expect(emitted == [1, 9])
+        #expect(sampled == [0, 1])
+    }
+
+    @Test("Empty draft decodes a single target token")
+    func emptyDraft() {
+        let emitted = SpeculativeDecodingController.verify(draft: [Int]()) { _ in 7 }
+        #expect(emitted == [7])
+    }
+
+    // MARK: - Draft Sizing
+
+    @Test("Draft length honours configuration, capability and batch limits")
+    func draftLengthLimits() {
+        #expect(makeController().draftAheadTokens == SpeculativeDecodingController.defaultDraftAheadTokens)
+        #expect(makeController(.init(enabled: true, draftAheadTokens: 32)).draftAheadTokens == 16)
+        let verificationLimited = makeController(.init(enabled: true, draftAheadTokens: 8, verificationBatchTokens: 4))
+        #expect(verificationLimited.draftAheadTokens == 3)
+        #expect(makeController(.init(enabled: true, draftAheadTokens: 8), maximumBatchTokens: 6).draftAheadTokens == 5)
+    }
+
+    @Test("Draft never exceeds the remaining token budget")
+    func draftLengthRemainingBudget() {
+        let controller = makeController(.init(enabled: true, draftAheadTokens: 8))
+        #expect(controller.draftLength(remainingTokens: 100) == 8)
+        #expect(controller.draftLength(remainingTokens: 3) == 2)
+        #expect(controller.draftLength(remainingTokens: 1) == 0)
+    }
+
+    @Test("A zero draft budget starts disabled")
+    func zeroDraftBudget() {
+        let controller = makeController(.init(enabled: true, draftAheadTokens: 0))
+        #expect(controller.isDrafting == false)
+        #expect(controller.disabledReason == "noDraftBudget")
+        #expect(controller.draftLength(remainingTokens: 100) == 0)
+    }
+
+    // MARK: - Statistics and Auto-disable
+
+    @Test("Rounds accumulate acceptance statistics")
+    func statistics() {
+        var controller = makeController()
+        controller.recordEmittedToken()
+        controller.recordRound(draftedTokens: 4, acceptedTokens: 4)
+        controller.recordRound(draftedTokens: 4, acceptedTokens: 2)
+
+        let statistics = controller.statistics
+        #expect(statistics.rounds == 2)
+        #expect(statistics.draftedTokens == 8)
+        #expect(statistics.acceptedTokens == 6)
+        #expect(statistics.rollbackTokens == 2)
+        #expect(statistics.emittedTokens == 9)
+        #expect(statistics.acceptRate == 0.75)
+    }
+
+    @Test("Exceeding the rollback budget disables drafting")
+    func rollbackBudget() {
+        var controller = makeController(.init(enabled: true, rollbackTokenBudgetPerTurn: 3))
+        #expect(controller.recordRound(draftedTokens: 4, acceptedTokens: 1) == nil)
+        #expect(controller.recordRound(draftedTokens: 4, acceptedTokens: 3) == "rollbackBudgetExceeded")
+        #expect(controller.isDrafting == false)
+        #expect(controller.draftLength(remainingTokens: 100) == 0)
+    }
+
+    @Test("Divergence above the threshold disables drafting after warm-up rounds")
+    func divergenceThreshold() {
+        var controller = makeController(.init(enabled: true, autoDisableDivergenceRate: 0.5))
+        for _ in 1..<SpeculativeDecodingController.minimumRoundsBeforeAutoDisable {
+            #expect(controller.recordRound(draftedTokens: 4, acceptedTokens: 0) == nil)
+        }
+        #expect(controller.recordRound(draftedTokens: 4, acceptedTokens: 0) == "divergenceRateExceeded")
+    }
+
+    @Test("Diagnostics details report accept rate and throughput")
+    func diagnosticsDetails() {
+        var controller = makeController()
+        controller.recordEmittedToken()
+        controller.recordRound(draftedTokens: 4, acceptedTokens: 3)
+
+        let details = controller.diagnosticsDetails(draftModel: "draft.gguf", elapsed: 0.5)
+        #expect(details["draft_model"] == "draft.gguf")
+        #expect(details["accept_rate"] == "0.750")
+        #expect(details["emitted_tokens"] == "5")
+        #expect(details["effective_tokens_per_second"] == "10.00")
+        #expect(details["tokens_per_round"] == "4.00")
+        #expect(details["disabled_reason"] == nil)
+    }
+
+    // MARK: - Configuration
+
+    @Test("Draft model round-trips and is optional when decoding")
+    func draftModelCodable() throws {
+        let original = ProviderRuntimeFeatureConfiguration.SpeculativeScheduling(
+            enabled: true,
+            draftAheadTokens: 4,
+            draftModel: "mlx-community/Llama-3.2-1B-Instruct-4bit"
+        )
+        let data = try JSONEncoder().encode(original)
+        let decoded = try JSONDecoder().decode(ProviderRuntimeFeatureConfiguration.SpeculativeScheduling.self, from: data)
+        #expect(decoded == original)
+
+        let legacy = try JSONDecoder().decode(
+            ProviderRuntimeFeatureConfiguration.SpeculativeScheduling.self,
+            from: Data(#"{"enabled": true, "draftAheadTokens": 4}"#.utf8)
+        )
+        #expect(legacy.draftModel == nil)
+    }
+}
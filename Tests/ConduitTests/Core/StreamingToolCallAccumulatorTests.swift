@@ -0,0 +1,92 @@
+// StreamingToolCallAccumulatorTests.swift
+// Conduit Tests
+//
+// Tests for incremental assembly of streamed tool-call arguments.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("StreamingToolCallAccumulator Tests")
+struct StreamingToolCallAccumulatorTests {
+
+    private func makeAccumulator(maximumArgumentsSize: Int = 100_000) -> StreamingToolCallAccumulator {
+        StreamingToolCallAccumulator(
+            id: "call_1",
+            name: "get_weather",
+            index: 0,
+            maximumArgumentsSize: maximumArgumentsSize
+        )
+    }
+
+    private func properties(_ content: GeneratedContent?) -> [String: GeneratedContent]? {
+        guard case .structure(let properties, _)? = content?.kind else { return nil }
+        return properties
+    }
+
+    @Test("Partial updates carry typed arguments received so far")
+    func partialArguments() {
+        var accumulator = makeAccumulator()
+        accumulator.append(#"{"city": "Par"#)
+
+        let partial = accumulator.partialToolCall
+        #expect(partial.argumentsFragment == #"{"city": "Par"#)
+        #expect(partial.isArgumentsComplete == false)
+        #expect(properties(partial.partialArguments)?["city"]?.kind == .string("Par"))
+
+        accumulator.append(#"is", "days": 3}"#)
+        let complete = accumulator.partialToolCall
+        #expect(complete.isArgumentsComplete)
+        #expect(properties(complete.partialArguments)?["days"]?.kind == .number(3))
+    }
+
+    @Test("Complete arguments finalize without repair")
+    func completeArguments() throws {
+        var accumulator = makeAccumulator()
+        for fragment in ["{\"ci", "ty\":", " \"Paris\"", "}"] {
+            accumulator.append(fragment)
+        }
+
+        let (toolCall, wasRepaired) = try accumulator.makeToolCall()
+        #expect(wasRepaired == false)
+        #expect(toolCall.id == "call_1")
+        #expect(toolCall.toolName == "get_weather")
+        #expect(properties(toolCall.arguments)?["city"]?.kind == .string("Paris"))
+    }
+
+    @Test("Incomplete arguments finalize from parser state")
+    func incompleteArguments() throws {
+        var accumulator = makeAccumulator()
+        accumulator.append(#"{"city": "Paris", "units": "cel"#)
+
+        let (toolCall, wasRepaired) = try accumulator.makeToolCall()
+        #expect(wasRepaired)
+        #expect(properties(toolCall.arguments)?["units"]?.kind == .string("cel"))
+    }
+
+    @Test("Empty arguments finalize as an empty object")
+    func emptyArguments() throws {
+        let (toolCall, wasRepaired) = try makeAccumulator().makeToolCall()
+        #expect(wasRepaired == false)
+        #expect(properties(toolCall.arguments)?.isEmpty == true)
+    }
+
+    @Test("Malformed arguments fall back to JSON repair")
+    func malformedArgumentsFallBack() throws {
+        var accumulator = makeAccumulator()
+        accumulator.append(#"{"city": "Paris",}"#)
+
+        #expect(accumulator.partialToolCall.partialArguments == nil)
+        let toolCall = try accumulator.makeToolCall().toolCall
+        #expect(properties(toolCall.arguments)?["city"]?.kind == .string("Paris"))
+    }
+
+    @Test("Fragments beyond the size limit are truncated")
+    func truncation() {
+        var accumulator = makeAccumulator(maximumArgumentsSize: 8)
+        #expect(accumulator.append(#"{"a": 1"#))
+        #expect(accumulator.append(#", "b": 2}"#) == false)
+        #expect(accumulator.isTruncated)
+        #expect(accumulator.argumentsBuffer == #"{"a": 1,"#)
+    }
+}
@@ -0,0 +1,167 @@
+// TelemetryTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("Telemetry", .serialized)
+struct TelemetryTests {
+
+    // MARK: - TelemetryHistogram
+
+    @Test("Small values get a bucket each and larger values share log buckets")
+    func bucketBoundaries() {
+        for value in Int64(0)..<8 {
+            #expect(TelemetryHistogram.bucket(for: value) == Int(value))
+            #expect(TelemetryHistogram.upperBound(ofBucket: Int(value)) == value)
+        }
+        #expect(TelemetryHistogram.bucket(for: 8) == TelemetryHistogram.bucket(for: 9))
+        #expect(TelemetryHistogram.bucket(for: 10) == TelemetryHistogram.bucket(for: 8) + 1)
+
+        for value: Int64 in [1, 17, 1_000, 123_456, 9_876_543_210] {
+            let upperBound = TelemetryHistogram.upperBound(ofBucket: TelemetryHistogram.bucket(for: value))
+            #expect(upperBound >= value)
+            #expect(Double(upperBound) <= Double(value) * 1.25)
+        }
+    }
+
+    @Test("Quantiles, mean, and extremes track recorded durations")
+    func quantiles() throws {
+        var histogram = TelemetryHistogram()
+        #expect(histogram.p50 == nil)
+        #expect(histogram.mean == nil)
+
+        for milliseconds in 1...100 {
+            histogram.record(.milliseconds(milliseconds))
+        }
+
+        #expect(histogram.count == 100)
+        #expect(histogram.min == .milliseconds(1))
+        #expect(histogram.max == .milliseconds(100))
+        let mean = try #require(histogram.mean)
+        #expect(mean == .microseconds(50_500))
+
+        let p50 = try #require(histogram.p50)
+        #expect(p50 >= .milliseconds(50) && p50 <= .microseconds(62_500))
+        let p99 = try #require(histogram.p99)
+        #expect(p99 >= .milliseconds(99) && p99 <= .milliseconds(100))
+        #expect(histogram.quantile(1) == .milliseconds(100))
+        let p0 = try #require(histogram.quantile(0))
+        #expect(p0 >= .milliseconds(1) && p0 <= .microseconds(1_250))
+    }
+
+    // MARK: - TelemetryHistograms
+
+    @Test("Histograms and counters are kept per source")
+    func perSourceShards() {
+        let histograms = TelemetryHistograms()
+        histograms.record(TelemetryMeasurement(stage: .connect, source: "a", duration: .milliseconds(5)))
+        histograms.record(TelemetryMeasurement(stage: .connect, source: "a", duration: .milliseconds(7)))
+        histograms.record(TelemetryMeasurement(stage: .connect, source: "b", duration: .milliseconds(9)))
+        histograms.increment(.requests, source: "a", by: 2)
+
+        #expect(histograms.summary(of: .connect, source: "a")?.count == 2)
+        #expect(histograms.summary(of: .connect, source: "b")?.count == 1)
+        #expect(histograms.summary(of: .queueWait, source: "a") == nil)
+        #expect(histograms.count(of: .requests, source: "a") == 2)
+        #expect(histograms.count(of: .requests, source: "b") == 0)
+        #expect(Set(histograms.snapshot.keys) == ["a", "b"])
+
+        histograms.reset()
+        #expect(histograms.snapshot.isEmpty)
+    }
+
+    // MARK: - ConduitTelemetry
+
+    @Test("Nothing is recorded while telemetry is off")
+    func offByDefault() {
+        ConduitTelemetry.bootstrap([])
+        #expect(ConduitTelemetry.backend == nil)
+        #expect(TelemetryStream(source: "off") == nil)
+        #expect(TelemetrySpan(.connect, source: "off") == nil)
+        #expect(ConduitTelemetry.measure(.jsonRepair, source: "off") { 42 } == 42)
+    }
+
+    @Test("Streams record time to first token, gaps, and chunk counts")
+    func streamMeasurements() throws {
+        let histograms = TelemetryHistograms()
+        ConduitTelemetry.bootstrap(histograms)
+        defer { ConduitTelemetry.bootstrap([]) }
+
+        let source = "stream-\(UUID().uuidString)"
+        var stream = try #require(TelemetryStream(source: source))
+        for _ in 0..<4 {
+            stream.chunkReceived()
+        }
+        stream.finish()
+
+        #expect(histograms.count(of: .requests, source: source) == 1)
+        #expect(histograms.count(of: .streamedChunks, source: source) == 4)
+        #expect(histograms.summary(of: .timeToFirstToken, source: source)?.count == 1)
+        #expect(histograms.summary(of: .interTokenGap, source: source)?.count == 3)
+        #expect(histograms.summary(of: .generation, source: source)?.count == 1)
+    }
+
+    @Test("Measured stages reach every bootstrapped backend with matching span IDs")
+    func measureAndMultiplex() async throws {
+        let histograms = TelemetryHistograms()
+        let recorder = RecordingBackend()
+        ConduitTelemetry.bootstrap(histograms, recorder)
+        defer { ConduitTelemetry.bootstrap([]) }
+
+        let source = "measure-\(UUID().uuidString)"
+        let value = await ConduitTelemetry.measure(.toolExecution, source: source) { () async -> Int in
+            await Task.yield()
+            return 7
+        }
+        #expect(value == 7)
+        #expect(throws: CancellationError.self) {
+            try ConduitTelemetry.measure(.queueWait, source: source) { throw CancellationError() }
+        }
+
+        #expect(histograms.summary(of: .toolExecution, source: source)?.count == 1)
+        #expect(histograms.summary(of: .queueWait, source: source)?.count == 1)
+
+        let events = recorder.events.filter { $0.source == source }
+        try #require(events.count == 4)
+        #expect(events.map(\.stage) == [.toolExecution, .toolExecution, .queueWait, .queueWait])
+        #expect(events[0].spanID != 0)
+        #expect(events[0].spanID == events[1].spanID)
+        #expect(events[0].began && !events[1].began)
+    }
+}
+
+// MARK: - Test Helpers
+
+private final class RecordingBackend: TelemetryBackend, @unchecked Sendable {
+    struct Event {
+        let stage: TelemetryStage
+        let source: String
+        let spanID: UInt64
+        let began: Bool
+    }
+
+    private let lock = NSLock()
+    private var recorded: [Event] = []
+
+    var events: [Event] {
+        lock.lock()
+        defer { lock.unlock() }
+        return recorded
+    }
+
+    func stageDidBegin(_ stage: TelemetryStage, source: String, spanID: UInt64) {
+        append(Event(stage: stage, source: source, spanID: spanID, began: true))
+    }
+
+    func record(_ measurement: TelemetryMeasurement) {
+        append(Event(stage: measurement.stage, source: measurement.source, spanID: measurement.spanID, began: false))
+    }
+
+    private func append(_ event: Event) {
+        lock.lock()
+        defer { lock.unlock() }
+        recorded.append(event)
+    }
+}
@@ -172,6 +172,43 @@ struct FlakyNonAIErrorTool: Tool {
     }
 }
 
+/// Tracks invocations and peak concurrency for scheduling assertions.
+actor ToolConcurrencyTracker {
+    private var active = 0
+    private(set) var peak = 0
+    private(set) var invocations = 0
+
+    func enter() {
+        active += 1
+        invocations += 1
+        peak = max(peak, active)
+    }
+
+    func exit() {
+        active -= 1
+    }
+}
+
+/// A tool that sleeps briefly and records its concurrency.
+struct TrackedTool: Tool {
+    @Generable
+    struct Arguments {
+        let key: String
+    }
+
+    let name = "tracked_tool"
+    let description = "Records concurrent invocations"
+    let tracker: ToolConcurrencyTracker
+    var delayNanoseconds: UInt64 = 20_000_000
+
+    func call(arguments: Arguments) async throws -> String {
+        await tracker.enter()
+        try await Task.sleep(nanoseconds: delayNanoseconds)
+        await tracker.exit()
+        return "Tracked: \(arguments.key)"
+    }
+}
+
 // MARK: - Test Suite
 
 @Suite("ToolExecutor Tests")
@@ -728,6 +765,182 @@ struct ToolExecutorTests {
         }
     }
 
+    // MARK: - Speculative Validation Tests
+
+    @Suite("Speculative Validation")
+    struct SpeculativeValidationTests {
+
+        private func partial(
+            _ json: String,
+            toolName: String = "another_tool"
+        ) -> PartialToolCall {
+            var accumulator = StreamingToolCallAccumulator(
+                id: "call_1",
+                name: toolName,
+                index: 0,
+                maximumArgumentsSize: 100_000
+            )
+            accumulator.append(json)
+            return accumulator.partialToolCall
+        }
+
+        @Test("Unknown tool is reported before arguments complete")
+        func unknownTool() async {
+            let executor = ToolExecutor(tools: [AnotherMockTool()])
+            let result = await executor.validateArguments(of: partial(#"{"val"#, toolName: "missing"))
+            #expect(result == .toolNotFound)
+        }
+
+        @Test("Incomplete arguments are pending until they decode")
+        func pendingWhileStreaming() async {
+            let executor = ToolExecutor(tools: [AnotherMockTool()])
+
+            #expect(await executor.validateArguments(of: partial(#"{"val"#)) == .pending)
+            #expect(await executor.validateArguments(of: partial(#"{"value": 4"#)) == .valid)
+        }
+
+        @Test("Complete arguments with the wrong shape are invalid")
+        func invalidWhenComplete() async {
+            let executor = ToolExecutor(tools: [AnotherMockTool()])
+            let result = await executor.validateArguments(of: partial(#"{"other": 1}"#))
+
+            guard case .invalid = result else {
+                Issue.record("Expected invalid, got \(result)")
+                return
+            }
+        }
+    }
+
+    // MARK: - Scheduling Tests
+
+    @Suite("Scheduling")
+    struct SchedulingTests {
+
+        private func trackedCalls(_ keys: [String]) throws -> [Transcript.ToolCall] {
+            try keys.enumerated().map { index, key in
+                try Transcript.ToolCall(
+                    id: "call_\(index)",
+                    toolName: "tracked_tool",
+                    argumentsJSON: #"{"key": "\#(key)"}"#
+                )
+            }
+        }
+
+        @Test("Executor-wide limit bounds concurrent calls")
+        func globalConcurrencyLimit() async throws {
+            let tracker = ToolConcurrencyTracker()
+            let executor = ToolExecutor(tools: [TrackedTool(tracker: tracker)])
+            await executor.setMaxConcurrentCalls(2)
+
+            let outputs = try await executor.execute(toolCalls: trackedCalls(["a", "b", "c", "d", "e", "f"]))
+
+            #expect(outputs.map(\.id) == (0..<6).map { "call_\($0)" })
+            #expect(await tracker.peak <= 2)
+            #expect(await tracker.invocations == 6)
+        }
+
+        @Test("Per-tool limit bounds concurrent calls to that tool")
+        func perToolConcurrencyLimit() async throws {
+            let tracker = ToolConcurrencyTracker()
+            let executor = ToolExecutor()
+            await executor.register(TrackedTool(tracker: tracker), options: .init(maxConcurrentCalls: 1))
+
+            _ = try await executor.execute(toolCalls: trackedCalls(["a", "b", "c"]))
+
+            #expect(await tracker.peak == 1)
+        }
+
+        @Test("Identical calls to idempotent tools run once per batch")
+        func coalescesIdempotentCalls() async throws {
+            let tracker = ToolConcurrencyTracker()
+            let executor = ToolExecutor()
+            await executor.register(TrackedTool(tracker: tracker), options: .init(isIdempotent: true))
+
+            let outputs = try await executor.execute(toolCalls: trackedCalls(["a", "a", "b", "a"]))
+
+            #expect(await tracker.invocations == 2)
+            #expect(outputs.map(\.id) == ["call_0", "call_1", "call_2", "call_3"])
+            #expect(outputs.map(\.text) == ["Tracked: a", "Tracked: a", "Tracked: b", "Tracked: a"])
+        }
+
+        @Test("Identical calls to other tools all run")
+        func doesNotCoalesceNonIdempotentCalls() async throws {
+            let tracker = ToolConcurrencyTracker()
+            let executor = ToolExecutor(tools: [TrackedTool(tracker: tracker)])
+
+            _ = try await executor.execute(toolCalls: trackedCalls(["a", "a", "a"]))
+
+            #expect(await tracker.invocations == 3)
+        }
+
+        @Test("Idempotent outputs are reused across batches within the TTL")
+        func resultCache() async throws {
+            let tracker = ToolConcurrencyTracker()
+            let executor = ToolExecutor()
+            await executor.register(
+                TrackedTool(tracker: tracker),
+                options: .init(isIdempotent: true, resultCacheTTL: .seconds(60))
+            )
+
+            _ = try await executor.execute(toolCalls: trackedCalls(["a"]))
+            let second = try await executor.execute(toolCalls: trackedCalls(["a", "b"]))
+            #expect(await tracker.invocations == 2)
+            #expect(second.map(\.text) == ["Tracked: a", "Tracked: b"])
+
+            // Changing options drops the cache
+            await executor.setOptions(.init(isIdempotent: true, resultCacheTTL: .seconds(60)), forTool: "tracked_tool")
+            _ = try await executor.execute(toolCalls: trackedCalls(["a"]))
+            #expect(await tracker.invocations == 3)
+        }
+
+        @Test("Streaming outputs arrive in completion order")
+        func streamingOutputs() async throws {
+            let executor = ToolExecutor(tools: [SlowTool()])
+            let toolCalls = [
+                try Transcript.ToolCall(
+                    id: "slow",
+                    toolName: "slow_tool",
+                    argumentsJSON: #"{"delay": 0.2, "requestID": "A"}"#
+                ),
+                try Transcript.ToolCall(
+                    id: "fast",
+                    toolName: "slow_tool",
+                    argumentsJSON: #"{"delay": 0.01, "requestID": "B"}"#
+                )
+            ]
+
+            var ids: [String] = []
+            for try await output in await executor.outputs(for: toolCalls) {
+                ids.append(output.id)
+            }
+            #expect(ids == ["fast", "slow"])
+        }
+
+        @Test("Retry backoff delays each retry")
+        func retryBackoff() async throws {
+            let recorder = FlakyToolAttemptRecorder()
+            let executor = ToolExecutor(
+                tools: [FlakyRetryableAIErrorTool(failuresBeforeSuccess: 2, recorder: recorder)]
+            )
+            let toolCall = try Transcript.ToolCall(
+                id: "retry_backoff",
+                toolName: "flaky_retryable_ai_error_tool",
+                argumentsJSON: #"{"input":"value"}"#
+            )
+
+            let clock = ContinuousClock()
+            let start = clock.now
+            _ = try await executor.execute(
+                toolCall: toolCall,
+                retryPolicy: .retryableAIErrors(maxAttempts: 3, backoff: .milliseconds(20))
+            )
+
+            // 20 ms before the first retry, 40 ms before the second
+            #expect(clock.now - start >= .milliseconds(60))
+            #expect(await recorder.attemptCount == 3)
+        }
+    }
+
     // MARK: - Edge Cases
 
     @Suite("Edge Cases")
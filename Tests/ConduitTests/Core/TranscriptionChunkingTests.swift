@@ -0,0 +1,215 @@
+// TranscriptionChunkingTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("Transcription Chunking")
+struct TranscriptionChunkingTests {
+
+    // MARK: - Windows
+
+    @Test("Windows overlap and cover the recording")
+    func windowLayout() {
+        let chunking = TranscriptionChunking(windowDuration: 10, overlap: 2)
+        let windows = chunking.windows(forDuration: 25)
+
+        #expect(windows.map(\.start) == [0, 8, 16])
+        #expect(windows.map(\.end) == [10, 18, 25])
+        #expect(windows[0].keptRange.lowerBound == -.infinity)
+        #expect(windows[0].keptRange.upperBound == 9)
+        #expect(windows[1].keptRange == 9..<17)
+        #expect(windows[2].keptRange.upperBound == .infinity)
+    }
+
+    @Test("Short recordings are one window and empty ones none")
+    func shortRecordings() {
+        let chunking = TranscriptionChunking(windowDuration: 30, overlap: 2)
+        #expect(chunking.windows(forDuration: 12).count == 1)
+        #expect(chunking.windows(forDuration: 0).isEmpty)
+    }
+
+    @Test("Overlap is clamped to half a window")
+    func overlapClamp() {
+        let chunking = TranscriptionChunking(windowDuration: 4, overlap: 10, maxConcurrentWindows: 0)
+        #expect(chunking.overlap == 2)
+        #expect(chunking.maxConcurrentWindows == 1)
+    }
+
+    // MARK: - Merging
+
+    @Test("Words are kept by the window containing their midpoint")
+    func mergeAcrossBoundary() {
+        let windows = TranscriptionChunking(windowDuration: 10, overlap: 2).windows(forDuration: 18)
+        var merger = TranscriptionWindowMerger()
+
+        // Cut at 9s: "brown" (8.5-9.25) belongs to the first window
+        let first = merger.segments(from: result(words: [
+            ("quick", 7.0, 7.75), ("brown", 8.5, 9.25), ("fo", 9.5, 10.0),
+        ]), in: windows[0])
+        // Second window times are relative to 8s; it hears "brown" slightly later
+        let second = merger.segments(from: result(words: [
+            ("brown", 0.75, 1.25), ("fox", 1.5, 2.0), ("jumps", 2.25, 2.75),
+        ]), in: windows[1])
+
+        #expect(first.map(\.text) == ["quick brown"])
+        #expect(second.map(\.text) == ["fox jumps"])
+        #expect(second[0].startTime == 9.5)
+        #expect(second[0].words?.last?.endTime == 10.75)
+        #expect((first + second).map(\.id) == [0, 1])
+    }
+
+    @Test("Segments without words are kept by their midpoint")
+    func mergeSegments() {
+        let windows = TranscriptionChunking(windowDuration: 10, overlap: 2).windows(forDuration: 18)
+        var merger = TranscriptionWindowMerger()
+
+        let first = merger.segments(from: TranscriptionResult(text: "a b", segments: [
+            TranscriptionSegment(id: 7, startTime: 0, endTime: 5, text: "a"),
+            TranscriptionSegment(id: 8, startTime: 8, endTime: 10, text: "b"),
+        ], duration: 10, processingTime: 0), in: windows[0])
+        let second = merger.segments(from: TranscriptionResult(text: "b c", segments: [
+            TranscriptionSegment(id: 0, startTime: 0, endTime: 2, text: "b"),
+            TranscriptionSegment(id: 1, startTime: 2, endTime: 6, text: "c"),
+        ], duration: 10, processingTime: 0), in: windows[1])
+
+        #expect(first.map(\.text) == ["a"])
+        #expect(second.map(\.text) == ["b", "c"])
+        #expect(second.map(\.startTime) == [8, 10])
+        #expect((first + second).map(\.id) == [0, 1, 2])
+    }
+
+    // MARK: - WAV Windows
+
+    @Test("WAV windows are standalone files with the requested samples")
+    func wavWindows() throws {
+        let url = try makeWAV(seconds: 10)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let reader = try #require(try WAVWindowReader(url: url))
+        #expect(reader.duration == 10)
+
+        let window = try reader.read(from: 2, to: 3.5)
+        #expect(window.prefix(4) == Data("RIFF".utf8))
+        #expect(window.count == 44 + 3_000)
+        // Samples are the frame index, so the window starts at frame 2000
+        #expect(window[44] == 0xD0 && window[45] == 0x07)
+
+        let tail = try reader.read(from: 9, to: .infinity)
+        #expect(tail.count == 44 + 2_000)
+    }
+
+    @Test("Files that are not WAV are not windowed")
+    func nonWAV() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).mp3")
+        try Data("ID3\u{03}not really audio".utf8).write(to: url)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        #expect(try WAVWindowReader(url: url) == nil)
+    }
+
+    // MARK: - Streaming
+
+    @Test("Streams windows in order with bounded concurrency")
+    func streaming() async throws {
+        let url = try makeWAV(seconds: 25)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let tracker = ConcurrencyTracker()
+        let chunking = TranscriptionChunking(windowDuration: 5, overlap: 1, maxConcurrentWindows: 2)
+        let stream = chunking.stream(audioURL: url) { audio in
+            tracker.begin()
+            defer { tracker.end() }
+            // The first sample of each window is its starting frame
+            let frame = Int(audio[44]) | Int(audio[45]) << 8
+            // Later windows finish first
+            try await Task.sleep(for: .milliseconds(100 - frame / 250))
+            return TranscriptionResult(
+                text: "w",
+                segments: [TranscriptionSegment(id: 0, startTime: 1.5, endTime: 2.5, text: "at \(frame / 1000)")],
+                duration: 5,
+                processingTime: 0
+            )
+        }
+
+        var segments: [TranscriptionSegment] = []
+        for try await segment in stream {
+            segments.append(segment)
+        }
+
+        #expect(segments.map(\.text) == ["at 0", "at 4", "at 8", "at 12", "at 16", "at 20"])
+        #expect(segments.map(\.startTime) == [1.5, 5.5, 9.5, 13.5, 17.5, 21.5])
+        #expect(segments.map(\.id) == Array(0..<6))
+        #expect(tracker.peak <= 2)
+    }
+
+    // MARK: - Helpers
+
+    private func result(words: [(String, TimeInterval, TimeInterval)]) -> TranscriptionResult {
+        let transcribed = words.map { TranscriptionWord(word: $0.0, startTime: $0.1, endTime: $0.2) }
+        let segment = TranscriptionSegment(
+            id: 0,
+            startTime: words.first?.1 ?? 0,
+            endTime: words.last?.2 ?? 0,
+            text: words.map(\.0).joined(separator: " "),
+            words: transcribed
+        )
+        return TranscriptionResult(text: segment.text, segments: [segment], duration: 10, processingTime: 0)
+    }
+
+    /// A 1 kHz, 16-bit mono WAV whose samples count frames.
+    private func makeWAV(seconds: Int) throws -> URL {
+        let frames = seconds * 1_000
+        var data = Data("RIFF".utf8)
+        append(UInt32(36 + frames * 2), to: &data)
+        data.append(contentsOf: Array("WAVEfmt ".utf8))
+        append(UInt32(16), to: &data)
+        append(UInt16(1), to: &data)      // PCM
+        append(UInt16(1), to: &data)      // mono
+        append(UInt32(1_000), to: &data)  // sample rate
+        append(UInt32(2_000), to: &data)  // byte rate
+        append(UInt16(2), to: &data)      // block align
+        append(UInt16(16), to: &data)     // bits per sample
+        data.append(contentsOf: Array("data".utf8))
+        append(UInt32(frames * 2), to: &data)
+        for frame in 0..<frames {
+            append(UInt16(truncatingIfNeeded: frame), to: &data)
+        }
+
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).wav")
+        try data.write(to: url)
+        return url
+    }
+
+    private func append<T: FixedWidthInteger>(_ value: T, to data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+}
+
+// MARK: - Test Helpers
+
+private final class ConcurrencyTracker: @unchecked Sendable {
+    private let lock = NSLock()
+    private var current = 0
+    private var highest = 0
+
+    var peak: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return highest
+    }
+
+    func begin() {
+        lock.lock()
+        defer { lock.unlock() }
+        current += 1
+        highest = max(highest, current)
+    }
+
+    func end() {
+        lock.lock()
+        defer { lock.unlock() }
+        current -= 1
+    }
+}
@@ -41,4 +41,222 @@ struct V2RuntimeBenchmarkHarnessTests {
         #expect(artifact.modes.allSatisfy { $0.matchingRuns == 100 })
         #expect(FileManager.default.fileExists(atPath: artifact.outputPath.path))
     }
+
+    // MARK: - Measured Runs
+
+    @Test("measured benchmark streams the corpus and records latency, throughput and memory")
+    func measuredBenchmark() async throws {
+        let harness = V2RuntimeBenchmarkHarness(outputRoot: makeOutputRoot(), fixedSeed: 7)
+        let corpus = V2RuntimeBenchmarkCorpus.seeded(7, count: 3)
+        let provider = ScriptedBenchmarkGenerator(tokensPerResponse: 5)
+
+        let artifact = try await harness.runBenchmark(
+            provider: provider,
+            model: .test,
+            profileName: "scripted",
+            modes: [.speculative, .baseline],
+            options: V2RuntimeBenchmarkOptions(corpus: corpus, warmupRuns: 1)
+        )
+
+        #expect(artifact.results.map(\.mode) == [.baseline, .speculative])
+        for point in artifact.results {
+            #expect(point.samples == 3)
+            #expect(point.completionTokens == 15)
+            #expect(point.interTokenLatencyHistogram?.sampleCount == 12)
+            #expect(point.ttftMs > 0)
+            #expect(point.decodeTokensPerSecond > 0)
+            #expect(point.p95LatencyMs >= (point.p50InterTokenLatencyMs ?? .infinity))
+            #expect(point.peakGPUMemoryMB == nil)
+        }
+
+        let report = try V2RuntimeBenchmarkReport.load(from: artifact.outputPath)
+        #expect(report.modelID == "test")
+        #expect(report.corpusFingerprint == corpus.fingerprint)
+        #expect(report.results == artifact.results)
+
+        // One warm-up plus three measured requests per mode.
+        let configs = await provider.recorder.configs
+        #expect(configs.count == 8)
+        #expect(configs.allSatisfy { $0.seed == 7 })
+    }
+
+    @Test("each mode enables only its own runtime feature")
+    func modeFeatureIsolation() {
+        var base = ProviderRuntimeFeatureConfiguration()
+        base.kvQuantization = .init(enabled: true, bits: 4)
+        base.speculativeScheduling.draftModel = "draft"
+
+        let baseline = V2RuntimeMode.baseline.runtimeFeatures(base: base)
+        #expect(baseline.kvQuantization.enabled == false)
+        #expect(baseline.kvQuantization.bits == 4)
+        #expect(baseline.speculativeScheduling.enabled == false)
+
+        let speculative = V2RuntimeMode.speculative.runtimeFeatures(base: base)
+        #expect(speculative.speculativeScheduling.enabled == true)
+        #expect(speculative.speculativeScheduling.draftModel == "draft")
+        #expect(speculative.kvQuantization.enabled == false)
+        #expect(speculative.attentionSinks.enabled == false)
+    }
+
+    @Test("measured parity compares every mode against baseline output")
+    func measuredParity() async throws {
+        let harness = V2RuntimeBenchmarkHarness(outputRoot: makeOutputRoot(), fixedSeed: 7)
+        let provider = ScriptedBenchmarkGenerator(tokensPerResponse: 3, divergesWithQuantizedKV: true)
+
+        let artifact = try await harness.runParity(
+            provider: provider,
+            model: .test,
+            profileName: "scripted",
+            modes: [.baseline, .quantizedKV, .speculative],
+            options: V2RuntimeBenchmarkOptions(corpus: .seeded(7, count: 2), parityRuns: 4)
+        )
+
+        let results = Dictionary(uniqueKeysWithValues: artifact.modes.map { ($0.mode, $0) })
+        #expect(results[.baseline]?.matchingRuns == 4)
+        #expect(results[.speculative]?.matchingRuns == 4)
+        #expect(results[.quantizedKV]?.matchingRuns == 0)
+        #expect(results[.quantizedKV]?.firstMismatchPromptIndex == 0)
+        #expect(FileManager.default.fileExists(atPath: artifact.outputPath.path))
+    }
+
+    @Test("empty corpus is rejected")
+    func emptyCorpus() async {
+        let harness = V2RuntimeBenchmarkHarness(outputRoot: makeOutputRoot(), fixedSeed: 7)
+        await #expect(throws: AIError.self) {
+            _ = try await harness.runBenchmark(
+                provider: ScriptedBenchmarkGenerator(tokensPerResponse: 1),
+                model: .test,
+                profileName: "empty",
+                modes: [.baseline],
+                options: V2RuntimeBenchmarkOptions(corpus: V2RuntimeBenchmarkCorpus(prompts: []))
+            )
+        }
+    }
+
+    // MARK: - Measurement Primitives
+
+    @Test("seeded corpus is reproducible and seed-dependent")
+    func seededCorpus() {
+        let first = V2RuntimeBenchmarkCorpus.seeded(42, count: 6)
+        #expect(first == V2RuntimeBenchmarkCorpus.seeded(42, count: 6))
+        #expect(first.prompts.count == 6)
+        #expect(first.fingerprint == V2RuntimeBenchmarkCorpus.seeded(42, count: 6).fingerprint)
+        #expect(first.fingerprint != V2RuntimeBenchmarkCorpus.seeded(43, count: 6).fingerprint)
+    }
+
+    @Test("latency histogram buckets by inclusive upper bound with an overflow bucket")
+    func latencyHistogram() {
+        var histogram = V2RuntimeLatencyHistogram(bucketUpperBoundsMs: [1, 10])
+        for latency in [0.5, 1, 5, 10, 50] {
+            histogram.record(latency)
+        }
+        #expect(histogram.counts == [2, 2, 1])
+        #expect(histogram.sampleCount == 5)
+    }
+
+    @Test("percentile uses nearest rank")
+    func percentile() {
+        let values = (1...20).map(Double.init)
+        #expect(V2RuntimeBenchmarkHarness.percentile(values, 0.5) == 10)
+        #expect(V2RuntimeBenchmarkHarness.percentile(values, 0.95) == 19)
+        #expect(V2RuntimeBenchmarkHarness.percentile([], 0.95) == 0)
+    }
+
+    @Test("regression gate flags metrics past their thresholds")
+    func regressionGate() {
+        func report(ttft: Double, decode: Double) -> V2RuntimeBenchmarkReport {
+            V2RuntimeBenchmarkReport(
+                generatedAt: Date(),
+                fixedSeed: 1,
+                profileName: "gate",
+                results: [
+                    V2RuntimeBenchmarkPoint(
+                        mode: .baseline,
+                        ttftMs: ttft,
+                        decodeTokensPerSecond: decode,
+                        p95LatencyMs: 20,
+                        kvMemoryMB: 100
+                    ),
+                ]
+            )
+        }
+
+        let previous = report(ttft: 100, decode: 50)
+        #expect(report(ttft: 105, decode: 48).regressions(against: previous).isEmpty)
+
+        let regressions = report(ttft: 130, decode: 40).regressions(against: previous)
+        #expect(regressions.map(\.metric) == ["ttftMs", "decodeTokensPerSecond"])
+        #expect(abs(regressions[0].change - 0.3) < 1e-9)
+    }
+
+    private func makeOutputRoot() -> URL {
+        FileManager.default.temporaryDirectory
+            .appendingPathComponent("conduit-benchmark-\(UUID().uuidString)", isDirectory: true)
+    }
+}
+
+// MARK: - Test Doubles
+
+private actor GenerateConfigRecorder {
+    private(set) var configs: [GenerateConfig] = []
+
+    func record(_ config: GenerateConfig) {
+        configs.append(config)
+    }
+}
+
+/// Emits a fixed number of prompt-derived tokens, one chunk per token.
+private struct ScriptedBenchmarkGenerator: TextGenerator {
+    typealias ModelID = TestModelID
+
+    let tokensPerResponse: Int
+    var divergesWithQuantizedKV = false
+    let recorder = GenerateConfigRecorder()
+
+    private func tokens(for prompt: String, config: GenerateConfig) -> [String] {
+        let diverges = divergesWithQuantizedKV && config.runtimeFeatures?.kvQuantization.enabled == true
+        return (0..<tokensPerResponse).map { index in
+            diverges ? "x\(index) " : "\(prompt.count % 97)-\(index) "
+        }
+    }
+
+    func generate(_ prompt: String, model: ModelID, config: GenerateConfig) async throws -> String {
+        await recorder.record(config)
+        return tokens(for: prompt, config: config).joined()
+    }
+
+    func generate(messages: [Message], model: ModelID, config: GenerateConfig) async throws -> GenerationResult {
+        .text(try await generate(messages.last?.content.textValue ?? "", model: model, config: config))
+    }
+
+    func stream(_ prompt: String, model: ModelID, config: GenerateConfig) -> AsyncThrowingStream<String, Error> {
+        let pieces = tokens(for: prompt, config: config)
+        return AsyncThrowingStream { continuation in
+            for piece in pieces {
+                continuation.yield(piece)
+            }
+            continuation.finish()
+        }
+    }
+
+    func streamWithMetadata(
+        messages: [Message],
+        model: ModelID,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        let pieces = tokens(for: messages.last?.content.textValue ?? "", config: config)
+        let recorder = recorder
+        return AsyncThrowingStream { continuation in
+            let task = Task {
+                await recorder.record(config)
+                for piece in pieces {
+                    try? await Task.sleep(for: .milliseconds(1))
+                    continuation.yield(GenerationChunk(text: piece))
+                }
+                continuation.yield(GenerationChunk(text: "", tokenCount: 0, isComplete: true, finishReason: .stop))
+                continuation.finish()
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
 }
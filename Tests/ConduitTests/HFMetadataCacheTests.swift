@@ -0,0 +1,227 @@
+// HFMetadataCacheTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+@Suite("HFMetadataCache")
+struct HFMetadataCacheTests {
+
+    private let url = makeTestURL("https://huggingface.co/api/models/org/model?full=1")
+
+    private func makeCache(
+        server: StubServer,
+        clock: StubClock = StubClock(),
+        directory: URL? = nil
+    ) -> HFMetadataCache {
+        HFMetadataCache(
+            configuration: .init(timeToLive: 60, directory: directory),
+            now: { clock.now },
+            fetch: { try await server.respond(to: $0) }
+        )
+    }
+
+    @Test("Fresh responses are served without a request")
+    func freshHit() async {
+        let server = StubServer(responses: [.ok("v1", etag: "\"a\"")])
+        let cache = makeCache(server: server)
+
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+
+        #expect(server.requests.count == 1)
+        let metrics = await cache.metrics
+        #expect(metrics.hits == 1)
+        #expect(metrics.misses == 1)
+    }
+
+    @Test("Expired responses are revalidated with their ETag")
+    func revalidation() async {
+        let server = StubServer(responses: [.ok("v1", etag: "\"a\""), .notModified])
+        let clock = StubClock()
+        let cache = makeCache(server: server, clock: clock)
+
+        _ = await cache.data(for: URLRequest(url: url))
+        clock.advance(by: 61)
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+
+        #expect(server.requests.count == 2)
+        #expect(server.requests[1].value(forHTTPHeaderField: "If-None-Match") == "\"a\"")
+        #expect(await cache.metrics.revalidations == 1)
+
+        // The 304 renewed the entry
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+        #expect(server.requests.count == 2)
+    }
+
+    @Test("A maximum age of zero always asks the server")
+    func forcedRevalidation() async {
+        let server = StubServer(responses: [.ok("v1", etag: "\"a\""), .ok("v2", etag: "\"b\"")])
+        let cache = makeCache(server: server)
+
+        _ = await cache.data(for: URLRequest(url: url))
+        #expect(await cache.data(for: URLRequest(url: url), maximumAge: 0) == Data("v2".utf8))
+        #expect(server.requests.count == 2)
+    }
+
+    @Test("Expired responses are served when the server is unreachable")
+    func staleOnFailure() async {
+        let server = StubServer(responses: [.ok("v1", etag: nil), .failure])
+        let clock = StubClock()
+        let cache = makeCache(server: server, clock: clock)
+
+        _ = await cache.data(for: URLRequest(url: url))
+        clock.advance(by: 120)
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+    }
+
+    @Test("Error statuses are not cached")
+    func errorStatus() async {
+        let server = StubServer(responses: [.status(404), .ok("v1", etag: nil)])
+        let cache = makeCache(server: server)
+
+        #expect(await cache.data(for: URLRequest(url: url)) == nil)
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+    }
+
+    @Test("Rate limits and server errors serve the stored response; missing resources evict it")
+    func staleOnServerErrors() async {
+        let server = StubServer(responses: [
+            .ok("v1", etag: nil), .status(429), .status(503), .status(404), .status(500),
+        ])
+        let clock = StubClock()
+        let cache = makeCache(server: server, clock: clock)
+
+        _ = await cache.data(for: URLRequest(url: url))
+        clock.advance(by: 120)
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+        #expect(await cache.data(for: URLRequest(url: url)) == Data("v1".utf8))
+        #expect(await cache.data(for: URLRequest(url: url)) == nil)
+        #expect(await cache.data(for: URLRequest(url: url)) == nil)
+        #expect(server.requests.count == 5)
+    }
+
+    @Test("Concurrent identical lookups share one request")
+    func coalescing() async {
+        let server = StubServer(responses: [.ok("v1", etag: nil)], delay: .milliseconds(50))
+        let cache = makeCache(server: server)
+        let request = URLRequest(url: url)
+
+        let bodies = await withTaskGroup(of: Data?.self) { group in
+            for _ in 0..<8 {
+                group.addTask { await cache.data(for: request) }
+            }
+            return await group.reduce(into: []) { $0.append($1) }
+        }
+
+        #expect(bodies.allSatisfy { $0 == Data("v1".utf8) })
+        #expect(server.requests.count == 1)
+        #expect(await cache.metrics.coalescedRequests == 7)
+    }
+
+    @Test("Responses persist across cache instances, except authorized ones")
+    func persistence() async throws {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("HFMetadataCacheTests-\(UUID().uuidString)", isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        var authorized = URLRequest(url: makeTestURL("https://huggingface.co/api/models/org/private"))
+        authorized.setValue("Bearer hf_test", forHTTPHeaderField: "Authorization")
+
+        let firstServer = StubServer(responses: [.ok("v1", etag: nil), .ok("secret", etag: nil)])
+        let first = makeCache(server: firstServer, directory: directory)
+        _ = await first.data(for: URLRequest(url: url))
+        _ = await first.data(for: authorized)
+
+        let server = StubServer(responses: [.ok("secret", etag: nil)])
+        let second = makeCache(server: server, directory: directory)
+        #expect(await second.data(for: URLRequest(url: url)) == Data("v1".utf8))
+        #expect(server.requests.isEmpty)
+
+        #expect(await second.data(for: authorized) == Data("secret".utf8))
+        #expect(server.requests.count == 1)
+    }
+
+    @Test("Keys separate credentials")
+    func keysIncludeAuthorization() {
+        var other = URLRequest(url: url)
+        other.setValue("Bearer hf_other", forHTTPHeaderField: "Authorization")
+        #expect(HFMetadataCache.key(for: URLRequest(url: url)) != HFMetadataCache.key(for: other))
+    }
+}
+
+// MARK: - Test Helpers
+
+private final class StubClock: @unchecked Sendable {
+    private let lock = NSLock()
+    private var current = Date(timeIntervalSince1970: 1_700_000_000)
+
+    var now: Date {
+        lock.lock()
+        defer { lock.unlock() }
+        return current
+    }
+
+    func advance(by seconds: TimeInterval) {
+        lock.lock()
+        defer { lock.unlock() }
+        current += seconds
+    }
+}
+
+private final class StubServer: @unchecked Sendable {
+    enum Response {
+        case ok(String, etag: String?)
+        case notModified
+        case status(Int)
+        case failure
+    }
+
+    private let lock = NSLock()
+    private var responses: [Response]
+    private var received: [URLRequest] = []
+    private let delay: Duration
+
+    init(responses: [Response], delay: Duration = .zero) {
+        self.responses = responses
+        self.delay = delay
+    }
+
+    var requests: [URLRequest] {
+        lock.lock()
+        defer { lock.unlock() }
+        return received
+    }
+
+    func respond(to request: URLRequest) async throws -> (Data, URLResponse) {
+        let response = next(for: request)
+        if delay > .zero {
+            try await Task.sleep(for: delay)
+        }
+        let url = request.url ?? makeTestURL("https://huggingface.co")
+        switch response {
+        case .ok(let body, let etag):
+            let headers = etag.map { ["ETag": $0] } ?? [:]
+            let http = HTTPURLResponse(url: url, statusCode: 200, httpVersion: nil, headerFields: headers)!
+            return (Data(body.utf8), http)
+        case .notModified:
+            return (Data(), HTTPURLResponse(url: url, statusCode: 304, httpVersion: nil, headerFields: nil)!)
+        case .status(let code):
+            return (Data(), HTTPURLResponse(url: url, statusCode: code, httpVersion: nil, headerFields: nil)!)
+        case .failure:
+            throw URLError(.notConnectedToInternet)
+        }
+    }
+
+    private func next(for request: URLRequest) -> Response {
+        lock.lock()
+        defer { lock.unlock() }
+        received.append(request)
+        return responses.isEmpty ? .failure : responses.removeFirst()
+    }
+}
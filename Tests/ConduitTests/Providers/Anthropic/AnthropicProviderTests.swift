@@ -512,6 +512,170 @@ struct AnthropicRequestBuildingTests {
             Issue.record("Expected multipart content with tool_use block")
         }
     }
+
+    @Test("Media cache sends registered images by file ID")
+    func mediaCacheFileReferences() async throws {
+        let media = MediaCache()
+        let provider = AnthropicProvider(apiKey: "sk-ant-test", mediaCache: media)
+        let uploaded = Message.ImageContent(base64Data: "AAAA", mimeType: "image/png")
+        let inline = Message.ImageContent(base64Data: "BBBB", mimeType: "image/png")
+        media.setFileReference("file_123", for: uploaded, service: .anthropic)
+
+        let request = try await provider.buildRequestBody(
+            messages: [Message(role: .user, content: .parts([.image(uploaded), .image(inline)]))],
+            model: .claudeSonnet45,
+            config: .default
+        )
+
+        guard case .multipart(let parts)? = request.messages.first?.content else {
+            Issue.record("Expected multipart content")
+            return
+        }
+        #expect(parts[0].source?.type == "file")
+        #expect(parts[0].source?.fileId == "file_123")
+        #expect(parts[0].source?.data == nil)
+        #expect(parts[1].source?.type == "base64")
+        #expect(parts[1].source?.data == "BBBB")
+        #expect(media.metrics.fileReferenceHits == 1)
+
+        let configuration = AnthropicConfiguration.standard(apiKey: "sk-ant-test").mediaCache(media)
+        #expect(configuration.buildHeaders(for: request)["anthropic-beta"] == AnthropicConfiguration.filesBeta)
+
+        // Inline images alone do not opt into the Files API beta
+        let inlineOnly = try await provider.buildRequestBody(
+            messages: [Message(role: .user, content: .parts([.image(inline)]))],
+            model: .claudeSonnet45,
+            config: .default
+        )
+        #expect(configuration.buildHeaders(for: inlineOnly)["anthropic-beta"] == nil)
+    }
+}
+
+// MARK: - Prompt Caching Tests
+
+@Suite("Anthropic Prompt Caching Tests")
+struct AnthropicPromptCachingTests {
+
+    private let conversation = [
+        Message.system("You are a weather assistant."),
+        Message.user("What is the weather in Paris?"),
+        Message.assistant("It is sunny."),
+        Message.user("And in Berlin?")
+    ]
+
+    private func cacheControl(
+        of message: AnthropicMessagesRequest.MessageContent
+    ) -> AnthropicMessagesRequest.CacheControl? {
+        guard case .multipart(let parts) = message.content else { return nil }
+        return parts.last?.cacheControl
+    }
+
+    private func encodedJSON(_ request: AnthropicMessagesRequest) throws -> String {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .sortedKeys
+        return String(decoding: try encoder.encode(request), as: UTF8.self)
+    }
+
+    @Test("Requests carry no cache markers when caching is disabled")
+    func disabledByDefault() async throws {
+        let provider = AnthropicProvider(apiKey: "sk-ant-test")
+        let request = try await provider.buildRequestBody(
+            messages: conversation,
+            model: .claudeSonnet45,
+            config: .default.tools([AnthropicNoopTool()])
+        )
+
+        #expect(request.systemCacheControl == nil)
+        #expect(request.tools?.last?.cacheControl == nil)
+        #expect(request.messages.allSatisfy { cacheControl(of: $0) == nil })
+
+        let json = try encodedJSON(request)
+        #expect(!json.contains("cache_control"))
+        #expect(json.contains(#""system":"You are a weather assistant.""#))
+    }
+
+    @Test("Automatic caching marks tools, system prompt and history")
+    func automaticBreakpoints() async throws {
+        let config = AnthropicConfiguration.standard(apiKey: "sk-ant-test").promptCaching(.automatic)
+        let provider = AnthropicProvider(configuration: config)
+        let request = try await provider.buildRequestBody(
+            messages: conversation,
+            model: .claudeSonnet45,
+            config: .default.tools([AnthropicNoopTool()])
+        )
+
+        #expect(request.tools?.last?.cacheControl?.type == "ephemeral")
+        #expect(request.systemCacheControl?.type == "ephemeral")
+        #expect(request.messages.map { cacheControl(of: $0) != nil } == [false, true, true])
+
+        let json = try encodedJSON(request)
+        let markers = json.components(separatedBy: "\"cache_control\"").count - 1
+        #expect(markers == AnthropicMessagesRequest.maxCacheBreakpoints)
+        #expect(json.contains(
+            #""system":[{"cache_control":{"type":"ephemeral"},"text":"You are a weather assistant.","type":"text"}]"#
+        ))
+    }
+
+    @Test("Conversation markers respect the breakpoint limit and settings")
+    func conversationOnly() async throws {
+        let caching = AnthropicPromptCaching(cacheTools: false, cacheSystemPrompt: false)
+        let config = AnthropicConfiguration.standard(apiKey: "sk-ant-test").promptCaching(caching)
+        let provider = AnthropicProvider(configuration: config)
+        let request = try await provider.buildRequestBody(
+            messages: [Message.user("Hello")],
+            model: .claudeSonnet45,
+            config: .default.tools([AnthropicNoopTool()])
+        )
+
+        #expect(request.tools?.last?.cacheControl == nil)
+        #expect(request.systemCacheControl == nil)
+        #expect(request.messages.count == 1)
+        #expect(request.messages.first.flatMap(cacheControl(of:)) != nil)
+    }
+
+    @Test("One-hour TTL sets the marker TTL and beta header")
+    func oneHourTTL() async throws {
+        let caching = AnthropicPromptCaching(ttl: .oneHour)
+        let config = AnthropicConfiguration.standard(apiKey: "sk-ant-test").promptCaching(caching)
+        let provider = AnthropicProvider(configuration: config)
+        let request = try await provider.buildRequestBody(
+            messages: conversation,
+            model: .claudeSonnet45,
+            config: .default
+        )
+
+        #expect(request.systemCacheControl?.ttl == "1h")
+        #expect(config.buildHeaders()["anthropic-beta"] == AnthropicPromptCaching.extendedTTLBeta)
+        #expect(AnthropicConfiguration.standard(apiKey: "sk-ant-test").buildHeaders()["anthropic-beta"] == nil)
+    }
+
+    @Test("Cache usage is decoded into UsageStats")
+    func cacheUsage() async throws {
+        let json = """
+            {
+                "id": "msg_123",
+                "type": "message",
+                "role": "assistant",
+                "content": [{"type": "text", "text": "Hi"}],
+                "model": "claude-sonnet-4-5-20250929",
+                "stop_reason": "end_turn",
+                "usage": {
+                    "input_tokens": 12,
+                    "output_tokens": 5,
+                    "cache_creation_input_tokens": 100,
+                    "cache_read_input_tokens": 2048
+                }
+            }
+            """
+        let response = try JSONDecoder().decode(AnthropicMessagesResponse.self, from: Data(json.utf8))
+        let provider = AnthropicProvider(apiKey: "sk-ant-test")
+        let result = try await provider.convertToGenerationResult(response, startTime: Date())
+
+        #expect(result.usage?.promptTokens == 2160)
+        #expect(result.usage?.completionTokens == 5)
+        #expect(result.usage?.cacheReadTokens == 2048)
+        #expect(result.usage?.cacheCreationTokens == 100)
+    }
 }
 
 // MARK: - Response Parsing Tests
@@ -678,7 +842,7 @@ struct AnthropicStreamingEventTests {
     func skipNonDeltaEvents() async throws {
         let provider = AnthropicProvider(apiKey: "sk-ant-test")
         var tokenCount = 0
-        var activeToolCalls: [Int: (id: String, name: String, jsonBuffer: String)] = [:]
+        var activeToolCalls: [Int: StreamingToolCallAccumulator] = [:]
         var completedToolCalls: [Transcript.ToolCall] = []
 
         // message_start should not yield
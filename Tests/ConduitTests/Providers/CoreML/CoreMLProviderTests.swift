@@ -168,6 +168,8 @@ struct CoreMLConfigurationTests {
         #expect(config.toolSpecificationStrategy == .openAIFunction)
         #expect(config.chatTemplate == nil)
         #expect(config.additionalTemplateContext == nil)
+        #expect(config.modelComputeUnits.isEmpty)
+        #expect(config.usesStatefulDecoding)
     }
 
     @Test("CoreML configuration codable round trip")
@@ -199,6 +201,32 @@ struct CoreMLConfigurationTests {
         #expect(config.chatTemplate == nil)
         #expect(config.additionalTemplateContext == nil)
     }
+
+    @Test("Per-model compute units match by path, then file name")
+    func perModelComputeUnits() {
+        let config = CoreMLConfiguration(
+            computeUnits: .cpuAndGPU,
+            modelComputeUnits: [
+                "/models/Draft.mlmodelc": .cpuAndNeuralEngine,
+                "Embedder.mlmodelc": .cpuOnly
+            ]
+        )
+
+        #expect(config.computeUnits(for: URL(fileURLWithPath: "/models/Draft.mlmodelc")) == .cpuAndNeuralEngine)
+        #expect(config.computeUnits(for: URL(fileURLWithPath: "/other/Embedder.mlmodelc")) == .cpuOnly)
+        #expect(config.computeUnits(for: URL(fileURLWithPath: "/models/Main.mlmodelc")) == .cpuAndGPU)
+    }
+
+    @Test("Configurations encoded before per-model settings still decode")
+    func decodesEarlierPayloads() throws {
+        let json = #"{"computeUnits":"all","defaultMaxTokens":128,"promptFormatting":"rolePrefixedText","#
+            + #""toolSpecificationStrategy":"openAIFunction"}"#
+        let decoded = try JSONDecoder().decode(CoreMLConfiguration.self, from: Data(json.utf8))
+
+        #expect(decoded.defaultMaxTokens == 128)
+        #expect(decoded.modelComputeUnits.isEmpty)
+        #expect(decoded.usesStatefulDecoding)
+    }
 }
 #endif
 
@@ -0,0 +1,56 @@
+// CoreMLTokenSamplerTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("CoreML Token Sampler")
+struct CoreMLTokenSamplerTests {
+
+    private let logits: [Float] = [0.5, 3.0, 2.9, -1.0, 1.0]
+
+    @Test("Zero temperature picks the most likely token")
+    func greedy() {
+        var sampler = CoreMLTokenSampler(config: GenerateConfig.default.temperature(0))
+        var scores = logits
+        #expect(sampler.sample(&scores) == 1)
+    }
+
+    @Test("Top-k of one is greedy at any temperature")
+    func topKOne() {
+        var sampler = CoreMLTokenSampler(config: GenerateConfig.default.temperature(1.5).topK(1))
+        for _ in 0..<20 {
+            var scores = logits
+            #expect(sampler.sample(&scores) == 1)
+        }
+    }
+
+    @Test("Sampling stays within the top-k candidates")
+    func topKRestricts() {
+        var sampler = CoreMLTokenSampler(config: GenerateConfig.default.temperature(2).topK(2).seed(7))
+        for _ in 0..<100 {
+            var scores = logits
+            #expect([1, 2].contains(sampler.sample(&scores)))
+        }
+    }
+
+    @Test("A seed makes sampling repeatable")
+    func seeded() {
+        let config = GenerateConfig.default.temperature(1).topP(1).seed(42)
+        var first = CoreMLTokenSampler(config: config)
+        var second = CoreMLTokenSampler(config: config)
+
+        let a = (0..<50).map { _ in var scores = logits; return first.sample(&scores) }
+        let b = (0..<50).map { _ in var scores = logits; return second.sample(&scores) }
+        #expect(a == b)
+        #expect(Set(a).count > 1)
+    }
+
+    @Test("Repetition penalty steers away from seen tokens")
+    func repetitionPenalty() {
+        var sampler = CoreMLTokenSampler(config: GenerateConfig.default.temperature(0).repetitionPenalty(2))
+        var scores = logits
+        #expect(sampler.sample(&scores, previous: [1]) == 2)
+    }
+}
@@ -4,6 +4,14 @@
 import XCTest
 @testable import ConduitAdvanced
 
+#if Llama && canImport(LlamaSwift)
+@Generable
+private struct LlamaSchemaCity {
+    let name: String
+    let population: Int
+}
+#endif
+
 final class LlamaProviderTests: XCTestCase {
 
     // MARK: - LlamaConfiguration
@@ -81,6 +89,42 @@ final class LlamaProviderTests: XCTestCase {
         XCTAssertEqual(decoded.repeatLastTokens, 128)
     }
 
+    func testLlamaConfigurationConcurrentSequences() {
+        XCTAssertEqual(LlamaConfiguration.default.maxConcurrentSequences, 1)
+        XCTAssertEqual(LlamaConfiguration.concurrent.maxConcurrentSequences, 4)
+        XCTAssertEqual(LlamaConfiguration(maxConcurrentSequences: 0).maxConcurrentSequences, 1)
+    }
+
+    func testLlamaConfigurationDecodesWithoutConcurrentSequences() throws {
+        let json = """
+        {
+            "contextSize": 2048,
+            "batchSize": 256,
+            "threadCount": 2,
+            "gpuLayers": 0,
+            "useMemoryMapping": true,
+            "lockMemory": false,
+            "defaultMaxTokens": 128,
+            "repeatLastTokens": -1
+        }
+        """
+
+        let decoded = try JSONDecoder().decode(LlamaConfiguration.self, from: Data(json.utf8))
+
+        XCTAssertEqual(decoded.maxConcurrentSequences, 1)
+        XCTAssertEqual(decoded.contextSize, 2048)
+    }
+
+    func testLlamaConfigurationConcurrentSequencesCodableRoundTrip() throws {
+        let original = LlamaConfiguration(maxConcurrentSequences: 8)
+
+        let data = try JSONEncoder().encode(original)
+        let decoded = try JSONDecoder().decode(LlamaConfiguration.self, from: data)
+
+        XCTAssertEqual(decoded, original)
+        XCTAssertEqual(decoded.maxConcurrentSequences, 8)
+    }
+
     // MARK: - Provider Availability
 
     func testProviderAvailabilityMatchesBuildMode() async {
@@ -229,4 +273,111 @@ final class LlamaProviderTests: XCTestCase {
         await provider.cancelGeneration()
         await provider.cancelGeneration()
     }
+
+    // MARK: - Structured Output
+
+    /// Needs a GGUF model at `CONDUIT_LLAMA_MODEL_PATH`.
+    func testSchemaConstrainedGenerationProducesValidJSON() async throws {
+        #if Llama && canImport(LlamaSwift)
+        guard let modelPath = ProcessInfo.processInfo.environment["CONDUIT_LLAMA_MODEL_PATH"],
+              !modelPath.isEmpty else {
+            throw XCTSkip("Set CONDUIT_LLAMA_MODEL_PATH to a GGUF model to run this test")
+        }
+
+        let provider = LlamaProvider()
+        let config = GenerateConfig.default
+            .temperature(0)
+            .maxTokens(64)
+            .responseFormat(.jsonSchema(name: "city", schema: LlamaSchemaCity.generationSchema))
+        let result = try await provider.generate(
+            messages: [.user("Describe Paris as JSON.")],
+            model: .llama(modelPath),
+            config: config
+        )
+
+        // Every sampled token has to be accepted by the grammar exactly once for the output to parse.
+        let object = try XCTUnwrap(
+            JSONSerialization.jsonObject(with: Data(result.text.utf8)) as? [String: Any],
+            "Expected a JSON object, got \(result.text)"
+        )
+        XCTAssertEqual(Set(object.keys), ["name", "population"])
+        XCTAssertNotNil(object["name"] as? String)
+        XCTAssertNotNil(object["population"] as? Int)
+        #else
+        throw XCTSkip("Requires the Llama trait")
+        #endif
+    }
+
+    // MARK: - Prompt Prefix Cache
+
+    func testPromptCacheMissOnEmptyCache() {
+        let cache = LlamaPromptCache()
+        let plan = cache.plan(for: [1, 2, 3])
+
+        XCTAssertFalse(plan.isHit)
+        XCTAssertEqual(plan.reusedTokenCount, 0)
+        XCTAssertEqual(plan.prefillTokenCount, 3)
+        XCTAssertEqual(plan.evictedTokenCount, 0)
+    }
+
+    func testPromptCacheReusesSharedPrefixAcrossTurns() {
+        var cache = LlamaPromptCache()
+        cache.commit(prompt: [1, 2, 3])
+        cache.append(10)
+        cache.append(11)
+
+        // Next turn: history + assistant reply + new user message.
+        let plan = cache.plan(for: [1, 2, 3, 10, 11, 20, 21])
+
+        XCTAssertTrue(plan.isHit)
+        XCTAssertEqual(plan.reusedTokenCount, 5)
+        XCTAssertEqual(plan.prefillTokenCount, 2)
+        XCTAssertEqual(plan.evictedTokenCount, 0)
+    }
+
+    func testPromptCacheEvictsAfterDivergence() {
+        var cache = LlamaPromptCache()
+        cache.commit(prompt: [1, 2, 3, 4, 5, 6])
+
+        // Undoing the last exchange shares only the first three tokens.
+        let plan = cache.plan(for: [1, 2, 3, 9])
+
+        XCTAssertEqual(plan.reusedTokenCount, 3)
+        XCTAssertEqual(plan.prefillTokenCount, 1)
+        XCTAssertEqual(plan.evictedTokenCount, 3)
+    }
+
+    func testPromptCacheAlwaysLeavesOneTokenToDecode() {
+        var cache = LlamaPromptCache()
+        cache.commit(prompt: [1, 2, 3])
+
+        let plan = cache.plan(for: [1, 2, 3])
+
+        XCTAssertEqual(plan.reusedTokenCount, 2)
+        XCTAssertEqual(plan.prefillTokenCount, 1)
+        XCTAssertEqual(plan.evictedTokenCount, 1)
+    }
+
+    func testPromptCacheHonorsReuseLimit() {
+        var cache = LlamaPromptCache()
+        cache.commit(prompt: [1, 2, 3, 4])
+
+        let disabled = cache.plan(for: [1, 2, 3, 4, 5], maximumReusedTokens: 0)
+        XCTAssertFalse(disabled.isHit)
+        XCTAssertEqual(disabled.evictedTokenCount, 4)
+
+        let capped = cache.plan(for: [1, 2, 3, 4, 5], maximumReusedTokens: 2)
+        XCTAssertEqual(capped.reusedTokenCount, 2)
+        XCTAssertEqual(capped.prefillTokenCount, 3)
+    }
+
+    func testPrefixCacheStatisticsStartEmpty() async {
+        let provider = LlamaProvider()
+        let statistics = await provider.prefixCacheStatistics()
+
+        XCTAssertEqual(statistics, ProviderRuntimePrefixCacheStatistics())
+        XCTAssertEqual(statistics.hitRate, 0)
+        let diagnostics = await provider.runtimeDiagnosticsSnapshot()
+        XCTAssertTrue(diagnostics.isEmpty)
+    }
 }
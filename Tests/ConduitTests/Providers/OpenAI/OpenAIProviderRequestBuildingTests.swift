@@ -279,6 +279,39 @@ struct OpenAIProviderRequestBuildingTests {
         #expect(body["max_tool_calls"] as? Int == 2)
     }
 
+    @Test("Media cache reuses data URLs and sends Responses images by file ID")
+    func mediaCacheImages() throws {
+        let media = MediaCache()
+        var configuration = OpenAIConfiguration.openAI(apiKey: "sk-test")
+        configuration.mediaCache = media
+        let image = Message.ImageContent(base64Data: "AAAA", mimeType: "image/png")
+        let messages = [Message(role: .user, content: .parts([.text("What is this?"), .image(image)]))]
+
+        for _ in 0..<2 {
+            let body = OpenAIProvider(configuration: configuration).buildRequestBody(
+                messages: messages,
+                model: .gpt4o,
+                config: .default,
+                stream: false
+            )
+            #expect(try serializedJSONString(body).contains(#""url":"data:image\/png;base64,AAAA""#))
+        }
+        #expect(media.metrics.misses == 1)
+        #expect(media.metrics.hits == 1)
+
+        media.setFileReference("file-abc", for: image, service: .openAI)
+        let body = OpenAIProvider(configuration: configuration.apiVariant(.responses)).buildRequestBody(
+            messages: messages,
+            model: .gpt4o,
+            config: .default,
+            stream: false,
+            variant: .responses
+        )
+        let json = try serializedJSONString(body)
+        #expect(json.contains(#""file_id":"file-abc""#))
+        #expect(!json.contains("base64,AAAA"))
+    }
+
     private func serializedJSONString(_ body: [String: Any]) throws -> String {
         let data = try JSONSerialization.data(withJSONObject: body, options: [.sortedKeys])
         return try #require(String(data: data, encoding: .utf8))
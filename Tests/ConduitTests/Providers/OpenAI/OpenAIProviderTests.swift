@@ -323,4 +323,98 @@ struct TokenCountIsEstimateTests {
     }
 }
 
+// MARK: - Embedding Tests
+
+@Suite("OpenAI Embedding Tests")
+struct OpenAIEmbeddingTests {
+
+    @Test("Batched response rows are ordered by index")
+    func batchedResponseOrdering() throws {
+        let json = """
+            {
+                "object": "list",
+                "data": [
+                    {"object": "embedding", "index": 1, "embedding": [0.3, 0.4]},
+                    {"object": "embedding", "index": 0, "embedding": [0.1, 0.2]}
+                ],
+                "model": "text-embedding-3-small",
+                "usage": {"prompt_tokens": 9, "total_tokens": 9}
+            }
+            """
+        let parsed = try OpenAIProvider.parseEmbeddingsResponse(Data(json.utf8), expectedCount: 2)
+        #expect(parsed.vectors == [[0.1, 0.2], [0.3, 0.4]])
+        #expect(parsed.tokenCount == 9)
+    }
+
+    @Test("Responses with missing rows are rejected")
+    func batchedResponseCountMismatch() {
+        let json = #"{"data": [{"index": 0, "embedding": [0.1]}]}"#
+        #expect(throws: AIError.self) {
+            try OpenAIProvider.parseEmbeddingsResponse(Data(json.utf8), expectedCount: 2)
+        }
+    }
+
+    @Test("Embedding batch policy defaults to OpenAI limits")
+    func defaultBatchPolicy() {
+        #expect(OpenAIConfiguration.default.embeddingBatchPolicy == .openAI)
+        let policy = EmbeddingBatchPolicy(maxInputsPerRequest: 16)
+        #expect(OpenAIConfiguration.default.embeddingBatchPolicy(policy).embeddingBatchPolicy == policy)
+    }
+}
+
+// MARK: - Tokenizer Tests
+
+@Suite("OpenAI Tokenizer Tests")
+struct OpenAITokenizerTests {
+
+    @Test("Models map to their tiktoken encoding")
+    func encodingForModel() {
+        #expect(OpenAITokenizerEncoding(model: "gpt-4o-mini") == .o200kBase)
+        #expect(OpenAITokenizerEncoding(model: "gpt-5.2-codex") == .o200kBase)
+        #expect(OpenAITokenizerEncoding(model: "o3-mini") == .o200kBase)
+        #expect(OpenAITokenizerEncoding(model: "openai/gpt-4.1") == .o200kBase)
+        #expect(OpenAITokenizerEncoding(model: "gpt-4-turbo") == .cl100kBase)
+        #expect(OpenAITokenizerEncoding(model: "gpt-3.5-turbo") == .cl100kBase)
+        #expect(OpenAITokenizerEncoding(model: "text-embedding-3-small") == .cl100kBase)
+        #expect(OpenAITokenizerEncoding(model: "llama3.2") == nil)
+        #expect(OpenAITokenizerEncoding(model: "o1x") == nil)
+    }
+
+    @Test("Estimate source falls back to estimated counts")
+    func estimateFallback() async throws {
+        let provider = OpenAIProvider(configuration: OpenAIConfiguration.openAI(apiKey: "sk-test").tokenizer(.estimate))
+
+        let count = try await provider.countTokens(in: "Hello, world!", for: .gpt4o)
+        #expect(count.isEstimate)
+        #expect(count.count == 3)
+
+        let messages = try await provider.countTokens(in: [.user("Hello, world!")], for: .gpt4o)
+        #expect(messages.isEstimate)
+        #expect(messages.count == 7)
+
+        await #expect(throws: AIError.self) {
+            _ = try await provider.encode("Hello", for: .gpt4o)
+        }
+    }
+
+    @Test("Rank files are only downloaded when requested")
+    func tokenizerDefaultsToCacheOnly() throws {
+        #expect(OpenAIConfiguration.default.tokenizer == .cached)
+
+        // Configurations encoded without a tokenizer source stay offline too
+        let encoded = try JSONEncoder().encode(OpenAIConfiguration.default)
+        var json = try JSONSerialization.jsonObject(with: encoded) as? [String: Any]
+        json?["tokenizer"] = nil
+        let data = try JSONSerialization.data(withJSONObject: json ?? [:])
+        #expect(try JSONDecoder().decode(OpenAIConfiguration.self, from: data).tokenizer == .cached)
+    }
+
+    @Test("Tokenizer source round-trips through Codable")
+    func tokenizerSourceCodable() throws {
+        let config = OpenAIConfiguration.default.tokenizer(.directory(URL(fileURLWithPath: "/tmp/tiktoken")))
+        let decoded = try JSONDecoder().decode(OpenAIConfiguration.self, from: JSONEncoder().encode(config))
+        #expect(decoded.tokenizer == config.tokenizer)
+    }
+}
+
 #endif // CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
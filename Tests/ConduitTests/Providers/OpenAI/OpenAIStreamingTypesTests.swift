@@ -0,0 +1,101 @@
+// OpenAIStreamingTypesTests.swift
+// Conduit Tests
+//
+// Tests for typed decoding of OpenAI-compatible streaming payloads.
+
+#if CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("OpenAI Streaming Types Tests")
+struct OpenAIStreamingTypesTests {
+
+    private func decodeChunk(_ json: String) throws -> OpenAIChatCompletionChunk {
+        try JSONDecoder().decode(OpenAIChatCompletionChunk.self, from: Data(json.utf8))
+    }
+
+    @Test("Chat chunk decodes content delta and finish reason")
+    func chatChunkContent() throws {
+        let chunk = try decodeChunk(
+            #"{"id":"c1","choices":[{"index":0,"delta":{"content":"Hel"},"finish_reason":null}]}"#
+        )
+
+        #expect(chunk.choices.count == 1)
+        #expect(chunk.choices.first?.delta?.content == "Hel")
+        #expect(chunk.choices.first?.finishReason == nil)
+    }
+
+    @Test("Chat chunk decodes tool call fragments")
+    func chatChunkToolCalls() throws {
+        let chunk = try decodeChunk(
+            #"{"choices":[{"delta":{"tool_calls":[{"index":0,"id":"call_1","function":{"name":"get_weather","arguments":"{\"ci"}}]}}]}"#
+        )
+
+        let toolCall = try #require(chunk.choices.first?.delta?.toolCalls?.first)
+        #expect(toolCall.index == 0)
+        #expect(toolCall.id == "call_1")
+        #expect(toolCall.function?.name == "get_weather")
+        #expect(toolCall.function?.arguments == #"{"ci"#)
+    }
+
+    @Test("Chat chunk decodes reasoning and reasoning details")
+    func chatChunkReasoning() throws {
+        let chunk = try decodeChunk(
+            #"{"choices":[{"delta":{"reasoning":"think","reasoning_details":[{"id":"rd_1","type":"reasoning.text","index":2,"content":"a"}]}}]}"#
+        )
+
+        let delta = try #require(chunk.choices.first?.delta)
+        #expect(delta.reasoning == "think")
+        #expect(delta.reasoningDetails?.first?.id == "rd_1")
+        #expect(delta.reasoningDetails?.first?.index == 2)
+        #expect(delta.reasoningDetails?.first?.format == nil)
+    }
+
+    @Test("Fields with unexpected types are dropped without failing the chunk")
+    func chatChunkIsLenient() throws {
+        let chunk = try decodeChunk(
+            #"{"choices":[{"delta":{"content":42,"reasoning":"ok"},"finish_reason":"stop"}]}"#
+        )
+
+        #expect(chunk.choices.first?.delta?.content == nil)
+        #expect(chunk.choices.first?.delta?.reasoning == "ok")
+        #expect(chunk.choices.first?.finishReason == "stop")
+    }
+
+    @Test("Responses tool call fields decode from nested or top-level placement")
+    func responsesToolCallPlacement() {
+        let provider = OpenAIProvider(configuration: .openAI(apiKey: "sk-test").apiVariant(.responses))
+
+        let nested = provider.decodeResponsesEventData(
+            #"{"type":"response.tool_call.delta","tool_call":{"call_id":"call_1","name":"lookup","arguments_delta":"{\"q\""}}"#
+        )
+        #expect(nested?.kind == .toolCallDelta)
+        #expect(nested?.toolCallID == "call_1")
+        #expect(nested?.toolName == "lookup")
+        #expect(nested?.argumentsFragment == #"{"q""#)
+
+        let topLevel = provider.decodeResponsesEventData(
+            #"{"type":"response.tool_call.created","id":"call_2","name":"search","delta":"{"}"#
+        )
+        #expect(topLevel?.kind == .toolCallCreated)
+        #expect(topLevel?.toolCallID == "call_2")
+        #expect(topLevel?.toolName == "search")
+        #expect(topLevel?.argumentsFragment == "{")
+    }
+
+    @Test("Responses completion falls back to top-level usage")
+    func responsesCompletionUsageFallback() {
+        let provider = OpenAIProvider(configuration: .openAI(apiKey: "sk-test").apiVariant(.responses))
+
+        let event = provider.decodeResponsesEventData(
+            #"{"type":"response.completed","finish_reason":"length","usage":{"prompt_tokens":5,"completion_tokens":9}}"#
+        )
+        #expect(event?.kind == .completed)
+        #expect(event?.finishReason == .maxTokens)
+        #expect(event?.usage?.promptTokens == 5)
+        #expect(event?.usage?.completionTokens == 9)
+    }
+}
+
+#endif // CONDUIT_TRAIT_OPENAI || CONDUIT_TRAIT_OPENROUTER
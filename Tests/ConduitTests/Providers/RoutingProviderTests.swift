@@ -0,0 +1,309 @@
+// RoutingProviderTests.swift
+// Conduit Tests
+//
+// Tests for hedged and failover routing across providers.
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("Routing Provider Tests")
+struct RoutingProviderTests {
+
+    private let model = ModelIdentifier.openAI("routed")
+
+    /// Losers are cancelled in the background; waits up to a second for that to land.
+    private func cancelledRequests(of provider: RoutingMockProvider) async -> Int {
+        for _ in 0..<100 where await provider.cancelledRequests == 0 {
+            try? await Task.sleep(for: .milliseconds(10))
+        }
+        return await provider.cancelledRequests
+    }
+
+    // MARK: - Failover
+
+    @Test("Routable errors fail over to the next backend")
+    func failsOver() async throws {
+        let failing = RoutingMockProvider(error: .serverError(statusCode: 503, message: nil))
+        let healthy = RoutingMockProvider(text: "from healthy")
+        let router = RoutingProvider(
+            backends: [
+                .init(name: "failing", provider: failing, model: model),
+                .init(name: "healthy", provider: healthy, model: model),
+            ],
+            policy: .failoverOnly
+        )
+
+        let text = try await router.generate("Hello", model: model)
+        #expect(text == "from healthy")
+
+        let statistics = await router.statistics()
+        #expect(statistics.map(\.failures) == [1, 0])
+        #expect(statistics[1].averageLatency != nil)
+
+        // The failed backend now goes last
+        _ = try await router.generate("Again", model: model)
+        #expect(await failing.generateCalls == 1)
+        #expect(await healthy.generateCalls == 2)
+    }
+
+    @Test("Input errors are returned without trying other backends")
+    func inputErrorsDoNotFailOver() async {
+        let rejecting = RoutingMockProvider(error: .invalidInput("bad prompt"))
+        let other = RoutingMockProvider()
+        let router = RoutingProvider(backends: [
+            .init(name: "rejecting", provider: rejecting, model: model),
+            .init(name: "other", provider: other, model: model),
+        ])
+
+        await #expect(throws: AIError.self) {
+            _ = try await router.generate("Hello", model: model)
+        }
+        #expect(await other.generateCalls == 0)
+    }
+
+    // MARK: - Latency
+
+    @Test("Measured backends are ordered by average latency")
+    func prefersFasterBackend() async throws {
+        let slow = RoutingMockProvider(delay: .milliseconds(50))
+        let fast = RoutingMockProvider()
+        let router = RoutingProvider(
+            backends: [
+                .init(name: "slow", provider: slow, model: model),
+                .init(name: "fast", provider: fast, model: model),
+            ],
+            policy: .failoverOnly
+        )
+
+        for _ in 0..<3 {
+            _ = try await router.generate("Hello", model: model)
+        }
+        #expect(await slow.generateCalls == 1)
+        #expect(await fast.generateCalls == 2)
+
+        let averages = await router.statistics().compactMap(\.averageLatency)
+        #expect(averages.count == 2)
+        #expect(averages[0] > averages[1])
+    }
+
+    // MARK: - Hedging
+
+    @Test("A slow request is hedged and the loser cancelled")
+    func hedgesSlowRequests() async throws {
+        let stalled = RoutingMockProvider(text: "stalled", delay: .seconds(5))
+        let backup = RoutingMockProvider(text: "backup", delay: .milliseconds(10))
+        let router = RoutingProvider(
+            backends: [
+                .init(name: "stalled", provider: stalled, model: model),
+                .init(name: "backup", provider: backup, model: model),
+            ],
+            policy: .init(hedging: .init(initialDelay: .milliseconds(20)))
+        )
+
+        let start = ContinuousClock.now
+        let text = try await router.generate("Hello", model: model)
+        #expect(text == "backup")
+        #expect(ContinuousClock.now - start < .seconds(2))
+        #expect(await cancelledRequests(of: stalled) == 1)
+        #expect(await stalled.cancelCalls == 0)
+        #expect(await router.statistics().map(\.requests) == [1, 1])
+    }
+
+    @Test("A losing hedge leaves other requests on the same backend running")
+    func loserDoesNotCancelSharedBackend() async throws {
+        let shared = RoutingMockProvider(text: "shared", delay: .milliseconds(200))
+        let backup = RoutingMockProvider(text: "backup", delay: .milliseconds(10))
+        let direct = RoutingProvider(backends: [
+            .init(name: "shared", provider: shared, model: model),
+        ])
+        let hedged = RoutingProvider(
+            backends: [
+                .init(name: "shared", provider: shared, model: model),
+                .init(name: "backup", provider: backup, model: model),
+            ],
+            policy: .init(hedging: .init(initialDelay: .milliseconds(20)))
+        )
+
+        async let first = direct.generate("First", model: model)
+        let second = try await hedged.generate("Second", model: model)
+        #expect(second == "backup")
+        #expect(try await first == "shared")
+        #expect(await cancelledRequests(of: shared) == 1)
+        #expect(await shared.cancelCalls == 0)
+    }
+
+    @Test("The winner returns without waiting for a loser that ignores cancellation")
+    func hedgeDoesNotWaitForLoser() async throws {
+        let stubborn = RoutingMockProvider(text: "stubborn", delay: .seconds(3), ignoresCancellation: true)
+        let backup = RoutingMockProvider(text: "backup", delay: .milliseconds(10))
+        let router = RoutingProvider(
+            backends: [
+                .init(name: "stubborn", provider: stubborn, model: model),
+                .init(name: "backup", provider: backup, model: model),
+            ],
+            policy: .init(hedging: .init(initialDelay: .milliseconds(20)))
+        )
+
+        let start = ContinuousClock.now
+        let text = try await router.generate("Hello", model: model)
+        #expect(text == "backup")
+        #expect(ContinuousClock.now - start < .seconds(1))
+    }
+
+    // MARK: - Streaming
+
+    @Test("Streams commit to the first backend to produce a chunk")
+    func streamCommitsOnFirstChunk() async throws {
+        let stalled = RoutingMockProvider(text: "late words", delay: .seconds(5))
+        let backup = RoutingMockProvider(text: "quick brown fox", delay: .milliseconds(10))
+        let router = RoutingProvider(
+            backends: [
+                .init(name: "stalled", provider: stalled, model: model),
+                .init(name: "backup", provider: backup, model: model),
+            ],
+            policy: .init(hedging: .init(initialDelay: .milliseconds(20)))
+        )
+
+        let start = ContinuousClock.now
+        var words: [String] = []
+        for try await chunk in router.streamWithMetadata(messages: [.user("Hello")], model: model) {
+            if !chunk.text.isEmpty { words.append(chunk.text) }
+        }
+
+        #expect(words == ["quick", "brown", "fox"])
+        #expect(ContinuousClock.now - start < .seconds(2))
+        #expect(await cancelledRequests(of: stalled) == 1)
+        #expect(await stalled.cancelCalls == 0)
+        #expect(await router.statistics()[1].averageTimeToFirstToken != nil)
+    }
+
+    @Test("Streams fail over when a backend errors before its first chunk")
+    func streamFailsOver() async throws {
+        let failing = RoutingMockProvider(error: .networkError(URLError(.timedOut)))
+        let healthy = RoutingMockProvider(text: "ok")
+        let router = RoutingProvider(
+            backends: [
+                .init(name: "failing", provider: failing, model: model),
+                .init(name: "healthy", provider: healthy, model: model),
+            ],
+            policy: .failoverOnly
+        )
+
+        var text = ""
+        for try await piece in router.stream("Hello", model: model) {
+            text += piece
+        }
+        #expect(text == "ok")
+        #expect(await router.statistics().map(\.failures) == [1, 0])
+    }
+}
+
+// MARK: - Mock Provider
+
+private actor RoutingMockProvider: AIProvider, TextGenerator {
+    typealias Response = GenerationResult
+    typealias StreamChunk = GenerationChunk
+    typealias ModelID = ModelIdentifier
+
+    let text: String
+    let delay: Duration
+    let error: AIError?
+    let ignoresCancellation: Bool
+
+    private(set) var generateCalls = 0
+    private(set) var cancelCalls = 0
+    private(set) var cancelledRequests = 0
+
+    init(text: String = "response", delay: Duration = .zero, error: AIError? = nil, ignoresCancellation: Bool = false) {
+        self.text = text
+        self.delay = delay
+        self.error = error
+        self.ignoresCancellation = ignoresCancellation
+    }
+
+    var isAvailable: Bool { true }
+
+    var availabilityStatus: ProviderAvailability { .available }
+
+    /// Like a real provider, aborts every request in flight.
+    func cancelGeneration() async {
+        cancelCalls += 1
+    }
+
+    private func recordCancellation() {
+        cancelledRequests += 1
+    }
+
+    func generate(_ prompt: String, model: ModelIdentifier, config: GenerateConfig) async throws -> String {
+        try await generate(messages: [.user(prompt)], model: model, config: config).text
+    }
+
+    func generate(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async throws -> GenerationResult {
+        generateCalls += 1
+        let cancelsBefore = cancelCalls
+        if ignoresCancellation {
+            let delay = delay
+            await Task.detached { try? await Task.sleep(for: delay) }.value
+        } else {
+            do {
+                try await Task.sleep(for: delay)
+            } catch {
+                recordCancellation()
+                throw error
+            }
+        }
+        if cancelCalls != cancelsBefore { throw AIError.cancelled }
+        if let error { throw error }
+        return GenerationResult(text: text, tokenCount: 1, generationTime: 0, tokensPerSecond: 0, finishReason: .stop)
+    }
+
+    nonisolated func stream(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        streamWithMetadata(messages: messages, model: model, config: config)
+    }
+
+    nonisolated func stream(
+        _ prompt: String,
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<String, Error> {
+        let text = text
+        return AsyncThrowingStream { continuation in
+            continuation.yield(text)
+            continuation.finish()
+        }
+    }
+
+    nonisolated func streamWithMetadata(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        let text = text, delay = delay, error = error
+        return AsyncThrowingStream { continuation in
+            let task = Task {
+                do {
+                    try await Task.sleep(for: delay)
+                    if let error { throw error }
+                    for word in text.split(separator: " ") {
+                        continuation.yield(GenerationChunk(text: String(word)))
+                    }
+                    continuation.yield(GenerationChunk(text: "", isComplete: true, finishReason: .stop))
+                    continuation.finish()
+                } catch {
+                    if error is CancellationError { await self.recordCancellation() }
+                    continuation.finish(throwing: error)
+                }
+            }
+            continuation.onTermination = { _ in task.cancel() }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+// BPETokenizerTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("BPETokenizer")
+struct BPETokenizerTests {
+
+    // MARK: - Helpers
+
+    /// Every single byte at its own rank, then `ab`, `bc` and `abc`.
+    private func makeTokenizer() throws -> BPETokenizer {
+        var lines = (0..<256).map { byte in
+            "\(Data([UInt8(byte)]).base64EncodedString()) \(byte)"
+        }
+        for (index, merge) in ["ab", "bc", "abc"].enumerated() {
+            lines.append("\(Data(merge.utf8).base64EncodedString()) \(256 + index)")
+        }
+
+        return try BPETokenizer(
+            name: "test",
+            rankFileContents: Data(lines.joined(separator: "\n").utf8),
+            pattern: #"\S+|\s+"#,
+            specialTokens: ["<|end|>": 300]
+        )
+    }
+
+    // MARK: - Encoding
+
+    @Test("Lowest-rank pairs merge first")
+    func mergePriority() throws {
+        let tokenizer = try makeTokenizer()
+        #expect(tokenizer.encode("abc") == [258])
+        #expect(tokenizer.encode("bcd") == [257, Int(UInt8(ascii: "d"))])
+        #expect(tokenizer.encode("cab") == [Int(UInt8(ascii: "c")), 256])
+    }
+
+    @Test("Chunks are encoded independently")
+    func pretokenization() throws {
+        let tokenizer = try makeTokenizer()
+        #expect(tokenizer.encode("ab abc") == [256, 32, 258])
+        #expect(tokenizer.encode("") == [])
+    }
+
+    @Test("Count matches encode and memoized chunks are stable")
+    func countMatchesEncode() throws {
+        let tokenizer = try makeTokenizer()
+        let text = "abc ab abc bcd\nab"
+        #expect(tokenizer.count(text) == tokenizer.encode(text).count)
+        #expect(tokenizer.encode(text) == tokenizer.encode(text))
+    }
+
+    // MARK: - Decoding
+
+    @Test("Decode round-trips multi-byte text")
+    func roundTrip() throws {
+        let tokenizer = try makeTokenizer()
+        let text = "abc héllo 👋 bc"
+        #expect(try tokenizer.decode(tokenizer.encode(text)) == text)
+    }
+
+    @Test("Special tokens decode unless skipped")
+    func specialTokens() throws {
+        let tokenizer = try makeTokenizer()
+        #expect(try tokenizer.decode([258, 300]) == "abc<|end|>")
+        #expect(try tokenizer.decode([258, 300], skipSpecialTokens: true) == "abc")
+    }
+
+    @Test("Unknown tokens throw")
+    func unknownToken() throws {
+        let tokenizer = try makeTokenizer()
+        #expect(throws: AIError.self) { try tokenizer.decode([999]) }
+    }
+
+    @Test("Malformed rank files are rejected")
+    func malformedRankFile() {
+        #expect(throws: AIError.self) {
+            try BPETokenizer(
+                name: "bad",
+                rankFileContents: Data("not-a-rank-file".utf8),
+                pattern: ".",
+                specialTokens: [:]
+            )
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// ByteLineSplitterTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("ByteLineSplitter")
+struct ByteLineSplitterTests {
+
+    // MARK: - Helpers
+
+    private func split(_ chunks: [String]) -> [String] {
+        split(bytes: chunks.map { Array($0.utf8) })
+    }
+
+    private func split(bytes chunks: [[UInt8]]) -> [String] {
+        var splitter = ByteLineSplitter()
+        var lines: [String] = []
+
+        for chunk in chunks {
+            splitter.append(chunk)
+            while let line = splitter.nextLine() {
+                lines.append(String(decoding: line, as: UTF8.self))
+            }
+        }
+        if let trailing = splitter.finish() {
+            lines.append(String(decoding: trailing, as: UTF8.self))
+        }
+        return lines
+    }
+
+    // MARK: - Delimiters
+
+    @Test("LF, CR and CRLF delimiters")
+    func delimiters() {
+        #expect(split(["a\nb\rc\r\nd"]) == ["a", "b", "c", "d"])
+    }
+
+    @Test("Blank lines are preserved")
+    func blankLines() {
+        #expect(split(["data: x\n\n"]) == ["data: x", ""])
+        #expect(split(["data: x\r\n\r\n"]) == ["data: x", ""])
+    }
+
+    @Test("CRLF split across chunks is a single delimiter")
+    func crlfAcrossChunks() {
+        #expect(split(["data: x\r", "\n", "\r", "\nnext"]) == ["data: x", "", "next"])
+    }
+
+    @Test("CR followed by a non-LF chunk starts a new line")
+    func crThenOtherChunk() {
+        #expect(split(["a\r", "b\n"]) == ["a", "b"])
+    }
+
+    // MARK: - Chunking
+
+    @Test("Lines spanning many chunks are reassembled")
+    func longLineAcrossChunks() {
+        let line = String(repeating: "x", count: 10_000)
+        let chunks = stride(from: 0, to: line.count, by: 7).map { offset -> String in
+            let start = line.index(line.startIndex, offsetBy: offset)
+            let end = line.index(start, offsetBy: min(7, line.count - offset))
+            return String(line[start..<end])
+        }
+        #expect(split(chunks + ["\nafter\n"]) == [line, "after"])
+    }
+
+    @Test("Byte-at-a-time chunks match a single chunk")
+    func byteAtATime() {
+        let payload = "event: ping\r\ndata: {}\r\n\r\ndata: ok\n\n"
+        let single = split([payload])
+        let perByte = split(bytes: payload.utf8.map { [$0] })
+        #expect(single == perByte)
+    }
+
+    @Test("Trailing bytes are flushed on finish")
+    func trailingFlush() {
+        #expect(split(["data: hello"]) == ["data: hello"])
+        #expect(split(["data: hello\n"]) == ["data: hello"])
+    }
+
+    @Test("Buffered byte count tracks unconsumed bytes")
+    func bufferedByteCount() {
+        var splitter = ByteLineSplitter()
+        splitter.append(Array("line\npartial".utf8))
+        #expect(splitter.nextLine().map { Array($0) } == Array("line".utf8))
+        #expect(splitter.nextLine() == nil)
+        #expect(splitter.bufferedByteCount == "partial".utf8.count)
+    }
+}
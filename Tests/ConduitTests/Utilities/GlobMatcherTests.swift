@@ -0,0 +1,40 @@
+// GlobMatcherTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("GlobMatcher")
+struct GlobMatcherTests {
+
+    @Test("Suffix, prefix and literal patterns match like their regex form", arguments: [
+        ("*.json", "config.json", true),
+        ("*.json", "config.jsonl", false),
+        ("*", "anything", true),
+        ("model-*", "model-00001.safetensors", true),
+        ("model-*", "tokenizer.json", false),
+        ("config.json", "config.json", true),
+        ("config.json", "configXjson", false),
+        ("model-?????.safetensors", "model-00001.safetensors", true),
+        ("model-*-of-*.safetensors", "model-00001-of-00002.safetensors", true),
+        ("model-*-of-*.safetensors", "model.safetensors", false),
+    ])
+    func matching(pattern: String, text: String, expected: Bool) throws {
+        let matcher = try #require(GlobMatcher(pattern))
+        #expect(matcher.matches(text) == expected)
+    }
+
+    @Test("Compiled matchers preserve pattern order and are reused")
+    func compiled() {
+        let patterns = HFMetadataService.mlxFilePatterns
+        let first = GlobMatcher.compiled(patterns)
+        let second = GlobMatcher.compiled(patterns)
+
+        #expect(first.count == patterns.count)
+        #expect(second.count == patterns.count)
+        #expect(first[0].matches("model.safetensors"))
+        #expect(!first[0].matches("config.json"))
+        #expect(second[1].matches("config.json"))
+    }
+}
@@ -0,0 +1,193 @@
+// IncrementalJSONParserTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("IncrementalJSONParser")
+struct IncrementalJSONParserTests {
+
+    // MARK: - Helpers
+
+    private func parse(_ chunks: [String]) -> IncrementalJSONParser {
+        var parser = IncrementalJSONParser()
+        for chunk in chunks {
+            parser.feed(chunk)
+        }
+        return parser
+    }
+
+    private func strict(_ json: String) throws -> GeneratedContent {
+        let value = try JSONSerialization.jsonObject(with: Data(json.utf8), options: [.fragmentsAllowed])
+        return try GeneratedContent.fromJSONValue(value)
+    }
+
+    /// Structural equality that ignores key order (strict parsing goes through a dictionary).
+    private func equivalent(_ lhs: GeneratedContent?, _ rhs: GeneratedContent?) -> Bool {
+        switch (lhs?.kind, rhs?.kind) {
+        case (.structure(let left, let leftKeys)?, .structure(let right, let rightKeys)?):
+            return Set(leftKeys) == Set(rightKeys)
+                && left.keys.allSatisfy { equivalent(left[$0], right[$0]) }
+        case (.array(let left)?, .array(let right)?):
+            return left.count == right.count && zip(left, right).allSatisfy { equivalent($0, $1) }
+        default:
+            return lhs?.kind == rhs?.kind
+        }
+    }
+
+    private func properties(_ content: GeneratedContent?) -> [String: GeneratedContent]? {
+        guard case .structure(let properties, _)? = content?.kind else { return nil }
+        return properties
+    }
+
+    // MARK: - Complete Documents
+
+    @Test("Complete documents match strict parsing", arguments: [
+        #"{"name":"Alice","age":30,"tags":["a","b"],"ok":true,"none":null}"#,
+        #"[1, -2.5, 3e2, {"nested": [[], {}]}]"#,
+        #""plain string""#,
+        #"{"escaped":"line\nbreak \"quoted\" \\ \/ é 😀"}"#,
+        "  {\"spaced\" :\t[ 1 ,2 ]\n}  ",
+    ])
+    func completeDocuments(json: String) throws {
+        let expected = try strict(json)
+        var parser = parse([json])
+        parser.finish()
+
+        #expect(parser.state == .complete)
+        #expect(equivalent(parser.snapshot(), expected))
+    }
+
+    @Test("Byte-at-a-time feeding matches single-chunk feeding")
+    func perCharacterFeeding() throws {
+        let json = #"{"title":"Café ☕️","items":[{"n":1},{"n":22}],"done":false}"#
+        let expected = try strict(json)
+        var parser = parse(json.map { String($0) })
+        parser.finish()
+
+        #expect(parser.state == .complete)
+        #expect(equivalent(parser.snapshot(), expected))
+    }
+
+    @Test("Top-level number completes on finish")
+    func topLevelNumber() {
+        var parser = parse(["12", "34"])
+        #expect(parser.state == .parsing)
+        #expect(parser.snapshot()?.kind == .number(1234))
+
+        parser.finish()
+        #expect(parser.state == .complete)
+        #expect(parser.snapshot()?.kind == .number(1234))
+    }
+
+    @Test("Object keys keep source order")
+    func orderedKeys() {
+        let parser = parse([#"{"b":1,"a":2,"c":3}"#])
+        guard case .structure(_, let orderedKeys)? = parser.snapshot()?.kind else {
+            Issue.record("Expected structure")
+            return
+        }
+        #expect(orderedKeys == ["b", "a", "c"])
+    }
+
+    // MARK: - Partial Documents
+
+    @Test("Unterminated strings report received characters")
+    func partialString() {
+        let parser = parse([#"{"city": "New Yor"#])
+        #expect(properties(parser.snapshot())?["city"]?.kind == .string("New Yor"))
+    }
+
+    @Test("Keys without values are omitted")
+    func pendingKeyOmitted() {
+        let parser = parse([#"{"a": 1, "b"#])
+        #expect(properties(parser.snapshot())?.keys.sorted() == ["a"])
+
+        let afterColon = parse([#"{"a": 1, "b": "#])
+        #expect(properties(afterColon.snapshot())?.keys.sorted() == ["a"])
+    }
+
+    @Test("Partial numbers and literals")
+    func partialNumbersAndLiterals() {
+        #expect(properties(parse([#"{"n": 12"#]).snapshot())?["n"]?.kind == .number(12))
+        #expect(properties(parse([#"{"n": 1."#]).snapshot())?["n"] == nil)
+        #expect(properties(parse([#"{"n": -"#]).snapshot())?["n"] == nil)
+        #expect(properties(parse([#"{"b": tr"#]).snapshot())?["b"] == nil)
+    }
+
+    @Test("Nested partial arrays include the open element")
+    func nestedPartial() {
+        let parser = parse([#"{"items": [{"n": 1}, {"n": 2, "label": "tw"#])
+        guard case .array(let items)? = properties(parser.snapshot())?["items"]?.kind else {
+            Issue.record("Expected array")
+            return
+        }
+        #expect(items.count == 2)
+        #expect(properties(items[1])?["label"]?.kind == .string("tw"))
+    }
+
+    @Test("Escape split across chunks is decoded")
+    func escapeAcrossChunks() {
+        let parser = parse([#"{"s": "a\"#, "u00", #"e9\"#, #"nb"}"#])
+        #expect(parser.state == .complete)
+        #expect(properties(parser.snapshot())?["s"]?.kind == .string("aé\nb"))
+    }
+
+    // MARK: - Revisions and Failure
+
+    @Test("Revision only advances for observable changes")
+    func revisionTracking() {
+        var parser = IncrementalJSONParser()
+        parser.feed(#"{"a": 1"#)
+        let revision = parser.revision
+
+        parser.feed(", ")
+        parser.feed(#""key""#)
+        #expect(parser.revision == revision + 1) // completing the number
+
+        parser.feed(": \"v")
+        #expect(parser.revision > revision + 1)
+    }
+
+    @Test("Snapshots are only rebuilt after observable changes")
+    func snapshotIfChanged() {
+        var parser = IncrementalJSONParser()
+        parser.feed("  ")
+        #expect(parser.snapshotIfChanged() == nil)
+
+        parser.feed(#"{"a": 1"#)
+        #expect(parser.snapshotIfChanged() != nil)
+        #expect(parser.snapshotIfChanged() == nil)
+
+        parser.feed(#", "b""#)
+        #expect(properties(parser.snapshotIfChanged())?["a"]?.kind == .number(1))
+
+        parser.feed(" ")
+        #expect(parser.snapshotIfChanged() == nil)
+    }
+
+    @Test("Invalid input fails and stops consuming")
+    func invalidInput() {
+        var parser = parse(["Sure! {\"a\": 1}"])
+        #expect(parser.state == .failed)
+        parser.feed("}")
+        #expect(parser.state == .failed)
+
+        #expect(parse([#"{"a": 1,}"#]).state == .failed)
+    }
+
+    @Test("Trailing text after a complete value is ignored")
+    func trailingText() {
+        let parser = parse([#"{"a": 1}"#, "\n```"])
+        #expect(parser.state == .complete)
+        #expect(properties(parser.snapshot())?["a"]?.kind == .number(1))
+    }
+
+    @Test("Depth limit is enforced")
+    func depthLimit() {
+        var parser = IncrementalJSONParser(maximumDepth: 2)
+        parser.feed("[[[")
+        #expect(parser.state == .failed)
+    }
+}
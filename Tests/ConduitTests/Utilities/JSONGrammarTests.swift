@@ -0,0 +1,229 @@
+// JSONGrammarTests.swift
+// ConduitTests
+
+import Foundation
+import Testing
+@testable import ConduitAdvanced
+
+@Generable
+private struct GrammarRecipe {
+    @Guide(description: "Difficulty", .anyOf(["easy", "hard"]))
+    let difficulty: String
+
+    @Guide(description: "Servings", .range(1...8))
+    let servings: Int
+
+    @Guide(description: "Steps", .count(1...2))
+    let steps: [String]
+
+    let note: String?
+}
+
+@Generable
+private struct GrammarSlug {
+    @Guide(description: "URL slug", .pattern("^[a-z0-9-]+$"))
+    let slug: String
+}
+
+@Generable
+private struct GrammarLimits {
+    @Guide(description: "Any non-negative count", .range(0...Int.max))
+    let total: Int
+
+    @Guide(description: "At least 40 tags", .minimumCount(40))
+    let tags: [Int]
+}
+
+/// Records the config of every request and claims to decode under a grammar.
+private actor ConstrainedGenerator: TextGenerator, GrammarConstrainedGenerator {
+    typealias ModelID = ModelIdentifier
+
+    private(set) var configs: [GenerateConfig] = []
+
+    func generate(_ prompt: String, model: ModelIdentifier, config: GenerateConfig) async throws -> String {
+        configs.append(config)
+        return #"{"slug":"a-1"}"#
+    }
+
+    func generate(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) async throws -> GenerationResult {
+        .text(try await generate("", model: model, config: config))
+    }
+
+    nonisolated func stream(
+        _ prompt: String,
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<String, Error> {
+        AsyncThrowingStream { $0.finish() }
+    }
+
+    nonisolated func streamWithMetadata(
+        messages: [Message],
+        model: ModelIdentifier,
+        config: GenerateConfig
+    ) -> AsyncThrowingStream<GenerationChunk, Error> {
+        AsyncThrowingStream { $0.finish() }
+    }
+}
+
+@Suite("JSONGrammar")
+struct JSONGrammarTests {
+
+    // MARK: - Helpers
+
+    private func matches(_ json: String, _ grammar: JSONGrammar) -> Bool {
+        var matcher = GrammarMatcher(grammar: grammar)
+        return matcher.accept(Array(json.utf8)) && matcher.isComplete
+    }
+
+    private var recipe: JSONGrammar {
+        JSONGrammar(schema: GrammarRecipe.generationSchema)
+    }
+
+    // MARK: - Schema Compilation
+
+    @Test("Accepts documents that satisfy the schema and its guides")
+    func acceptsValidDocuments() {
+        #expect(matches(#"{"difficulty":"easy","servings":4,"steps":["Mix"]}"#, recipe))
+        #expect(matches(#"{"difficulty":"hard","note":"Hot","servings":8,"steps":["a","b\"c"]}"#, recipe))
+    }
+
+    @Test("Rejects documents that break the schema or its guides")
+    func rejectsInvalidDocuments() {
+        // Enum, range and count guides
+        #expect(!matches(#"{"difficulty":"medium","servings":4,"steps":["Mix"]}"#, recipe))
+        #expect(!matches(#"{"difficulty":"easy","servings":9,"steps":["Mix"]}"#, recipe))
+        #expect(!matches(#"{"difficulty":"easy","servings":4,"steps":[]}"#, recipe))
+        #expect(!matches(#"{"difficulty":"easy","servings":4,"steps":["a","b","c"]}"#, recipe))
+
+        // Missing required members, null optionals and extra whitespace
+        #expect(!matches(#"{"difficulty":"easy","steps":["Mix"]}"#, recipe))
+        #expect(!matches(#"{"difficulty":"easy","note":null,"servings":4,"steps":["Mix"]}"#, recipe))
+        #expect(!matches(#"{ "difficulty":"easy","servings":4,"steps":["Mix"]}"#, recipe))
+    }
+
+    @Test("Bounds beyond Int and long required arrays compile exactly")
+    func extremeGuides() {
+        let grammar = JSONGrammar(schema: GrammarLimits.generationSchema)
+        func document(total: String, tags: Int) -> String {
+            #"{"tags":[\#((0..<tags).map(String.init).joined(separator: ","))],"total":\#(total)}"#
+        }
+
+        #expect(matches(document(total: "9007199254740993", tags: 40), grammar))
+        #expect(matches(document(total: "0", tags: 75), grammar))
+        #expect(!matches(document(total: "0", tags: 39), grammar))
+        #expect(!matches(document(total: "0", tags: 33), grammar))
+        #expect(!matches(document(total: "-1", tags: 40), grammar))
+    }
+
+    @Test("Supported patterns constrain string contents")
+    func patterns() {
+        let grammar = JSONGrammar(schema: GrammarSlug.generationSchema)
+        #expect(matches(#"{"slug":"abc-1"}"#, grammar))
+        #expect(!matches(#"{"slug":"ABC"}"#, grammar))
+        #expect(!matches(#"{"slug":""}"#, grammar))
+
+        #expect(JSONGrammarRegex.compile("(?=a)b") == nil)
+    }
+
+    @Test("The JSON object grammar accepts any object")
+    func anyObject() {
+        let grammar = JSONGrammar.anyObject
+        #expect(matches(#"{"a":[1,-2.5,true,null,{"b":"c\n"}],"d":{}}"#, grammar))
+        #expect(!matches("[1]", grammar))
+        #expect(JSONGrammar.compiled(for: .text) == nil)
+        #expect(JSONGrammar.compiled(for: .jsonObject) == grammar)
+    }
+
+    @Test("GBNF output names the root rule and quotes literals")
+    func gbnf() {
+        let gbnf = recipe.gbnf
+        #expect(gbnf.hasPrefix("root ::= "))
+        #expect(gbnf.contains(#"difficulty-kv ::= "\"difficulty\":""#))
+        #expect(gbnf.contains(#""\"easy\"""#))
+        #expect(gbnf.contains(#"[^\x00-\x1F\x22\x5C]"#))
+    }
+
+    // MARK: - Matching
+
+    @Test("Bytes the grammar determines are forced")
+    func forcedBytes() {
+        var matcher = GrammarMatcher(grammar: recipe)
+        var forced: [UInt8] = []
+        while let byte = matcher.forcedByte {
+            forced.append(byte)
+            matcher.accept(byte)
+        }
+        #expect(String(decoding: forced, as: UTF8.self) == #"{"difficulty":""#)
+        #expect(!matcher.accept(UInt8(ascii: "m")))
+        #expect(matcher.accept(UInt8(ascii: "e")))
+    }
+
+    // MARK: - Token Masks
+
+    @Test("Masks allow only grammatical tokens and are cached per state")
+    func tokenMasks() {
+        let pieces = ["{", "{\"", "difficulty", "\":", "\"", "easy", "hard", "x"]
+        let vocabulary = GrammarVocabulary(pieces: pieces, encoding: .plain)
+        let masker = GrammarTokenMasker(grammar: recipe, vocabulary: vocabulary)
+
+        var matcher = masker.makeMatcher()
+        #expect(masker.allowedTokens(for: matcher) == [0, 1])
+
+        let forced = masker.forcedTokens(after: matcher)
+        #expect(forced == [1, 2, 3, 4])
+        for token in forced {
+            #expect(matcher.accept(vocabulary.bytes(of: token)))
+        }
+
+        #expect(masker.allowedTokens(for: matcher) == [5, 6])
+        #expect(masker.allowedTokens(for: matcher) == [5, 6])
+        #expect(masker.statistics.hits == 1)
+        #expect(masker.statistics.misses == 2)
+    }
+
+    @Test("Token strings decode to bytes by tokenizer family")
+    func pieceDecoding() {
+        #expect(GrammarVocabulary.bytes(of: "\u{0120}hi", encoding: .byteLevel) == Array(" hi".utf8))
+        #expect(GrammarVocabulary.bytes(of: "\u{010A}", encoding: .byteLevel) == [0x0A])
+        #expect(GrammarVocabulary.bytes(of: "\u{2581}hi", encoding: .sentencePiece) == Array(" hi".utf8))
+        #expect(GrammarVocabulary.bytes(of: "<0x0A>", encoding: .sentencePiece) == [0x0A])
+        #expect(GrammarVocabulary.PieceEncoding.detect(["a", "\u{0120}b"]) == .byteLevel)
+
+        let vocabulary = GrammarVocabulary(pieces: ["<|eot_id|>", "a", nil])
+        #expect(vocabulary.bytes(of: 0).isEmpty)
+        #expect(vocabulary.bytes(of: 1) == [UInt8(ascii: "a")])
+    }
+
+    // MARK: - Structured Output
+
+    @Test("Structured requests carry the schema to grammar-constrained generators")
+    func structuredOutputUsesResponseFormat() async throws {
+        let generator = ConstrainedGenerator()
+        let slug = try await generator.generate("Slug", returning: GrammarSlug.self, model: .mlx("test"))
+        #expect(slug.slug == "a-1")
+
+        let configs = await generator.configs
+        guard case .jsonSchema(let name, _)? = configs.first?.responseFormat else {
+            Issue.record("Expected a JSON schema response format")
+            return
+        }
+        #expect(name == "GrammarSlug")
+
+        // An explicit format is left alone
+        _ = try await generator.generate(
+            "Slug",
+            returning: GrammarSlug.self,
+            model: .mlx("test"),
+            config: .default.responseFormat(.jsonObject)
+        )
+        guard case .jsonObject? = await generator.configs.last?.responseFormat else {
+            Issue.record("Expected the caller's response format")
+            return
+        }
+    }
+}
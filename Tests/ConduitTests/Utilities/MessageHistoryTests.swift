@@ -0,0 +1,90 @@
+// MessageHistoryTests.swift
+// ConduitTests
+
+import Testing
+@testable import ConduitAdvanced
+
+@Suite("Message History")
+struct MessageHistoryTests {
+
+    private func messages(_ range: Range<Int>) -> [Message] {
+        range.map { Message.user("m\($0)") }
+    }
+
+    private func texts(_ history: MessageHistory) -> [String] {
+        history.elements.map(\.content.textValue)
+    }
+
+    @Test("Appends across leaf and level boundaries keep order")
+    func appendAcrossBoundaries() {
+        // 32 fills the tail, 1,056 fills the first trie level plus the tail
+        for count in [0, 1, 32, 33, 64, 1_056, 1_057, 2_000] {
+            let expected = messages(0..<count)
+            let history = MessageHistory(expected)
+
+            #expect(history.count == count)
+            #expect(history.elements.map(\.id) == expected.map(\.id))
+            #expect(history.indices.allSatisfy { history[$0].id == expected[$0].id })
+        }
+    }
+
+    @Test("Copies are independent snapshots")
+    func snapshotsAreIndependent() {
+        var history = MessageHistory(messages(0..<40))
+        let snapshot = history
+
+        history.append(.user("new"))
+        history.replace(at: 3, with: .user("replaced"))
+        history.removeLast()
+        history.removeLast()
+
+        #expect(snapshot.count == 40)
+        #expect(snapshot[3].content.textValue == "m3")
+        #expect(snapshot.last?.content.textValue == "m39")
+        #expect(history.count == 39)
+        #expect(history[3].content.textValue == "replaced")
+    }
+
+    @Test("Replace edits trie and tail positions")
+    func replace() {
+        var history = MessageHistory(messages(0..<100))
+        history.replace(at: 5, with: .user("trie"))
+        history.replace(at: 99, with: .user("tail"))
+
+        #expect(history[5].content.textValue == "trie")
+        #expect(history[99].content.textValue == "tail")
+        #expect(history.count == 100)
+    }
+
+    @Test("Removing the last message shrinks back across boundaries")
+    func removeLastAcrossBoundaries() {
+        var history = MessageHistory(messages(0..<1_060))
+        for remaining in stride(from: 1_059, through: 0, by: -1) {
+            history.removeLast()
+            #expect(history.count == remaining)
+            if remaining > 0 {
+                #expect(history.last?.content.textValue == "m\(remaining - 1)")
+            }
+        }
+        #expect(history.isEmpty)
+
+        history.append(contentsOf: messages(0..<40))
+        #expect(texts(history) == messages(0..<40).map(\.content.textValue))
+    }
+
+    @Test("Insert and remove at arbitrary positions")
+    func insertAndRemove() {
+        var history = MessageHistory(messages(0..<50))
+        history.insert(.system("system"), at: 0)
+        #expect(history.count == 51)
+        #expect(history.first?.role == .system)
+        #expect(history[1].content.textValue == "m0")
+
+        history.remove(at: 10)
+        #expect(history.count == 50)
+        #expect(history[10].content.textValue == "m10")
+
+        history.insert(.user("end"), at: history.count)
+        #expect(history.last?.content.textValue == "end")
+    }
+}
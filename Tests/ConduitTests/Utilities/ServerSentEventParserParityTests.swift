@@ -105,9 +105,43 @@ final class ServerSentEventParserParityTests: XCTestCase {
 
         for testCase in cases {
             XCTAssertEqual(parseConduit(testCase.bytes), testCase.expected, "Mismatch for case '\(testCase.name)'")
+            XCTAssertEqual(
+                parseBytes([testCase.bytes]),
+                testCase.expected,
+                "Byte mode mismatch for case '\(testCase.name)'"
+            )
+            XCTAssertEqual(
+                parseBytes(testCase.bytes.map { [$0] }),
+                testCase.expected,
+                "Byte mode (split per byte) mismatch for case '\(testCase.name)'"
+            )
         }
     }
 
+    func testByteModeKeepsDataPayloadAsRawBytes() {
+        var parser = ServerSentEventByteParser()
+
+        let events = parser.ingest(Array("data: {\"a\":1}\n\ndata: [DONE]\n\n".utf8))
+
+        XCTAssertEqual(events.count, 2)
+        XCTAssertEqual(events.first?.data, Data("{\"a\":1}".utf8))
+        XCTAssertEqual(events.first?.isDoneMarker, false)
+        XCTAssertEqual(events.last?.isDoneMarker, true)
+    }
+
+    func testByteModeReassemblesEventsSplitAcrossChunks() {
+        var parser = ServerSentEventByteParser()
+
+        XCTAssertTrue(parser.ingest(Array("event: pi".utf8)).isEmpty)
+        XCTAssertTrue(parser.ingest(Array("ng\r".utf8)).isEmpty)
+        XCTAssertTrue(parser.ingest(Array("\ndata: he".utf8)).isEmpty)
+        let events = parser.ingest(Array("llo\r\n\r\n".utf8))
+
+        XCTAssertEqual(events.map(ServerSentEvent.init), [
+            ServerSentEvent(id: nil, event: "ping", data: "hello", retry: nil)
+        ])
+    }
+
     func testSingleDataEventDispatchesOnBlankLine() {
         var parser = ServerSentEventParser()
 
@@ -233,4 +267,15 @@ final class ServerSentEventParserParityTests: XCTestCase {
         events.append(contentsOf: parser.finish())
         return events
     }
+
+    private func parseBytes(_ chunks: [[UInt8]]) -> [ServerSentEvent] {
+        var parser = ServerSentEventByteParser()
+        var events: [RawServerSentEvent] = []
+
+        for chunk in chunks {
+            events.append(contentsOf: parser.ingest(chunk))
+        }
+        events.append(contentsOf: parser.finish())
+        return events.map(ServerSentEvent.init)
+    }
 }